@@ -21,6 +21,7 @@
  */
 
 #include "TDeckBoard.h"
+#include "../settings/MessageArchive.h"
 
 TDeckBoard::TDeckBoard()
     : _startup_reason(BD_STARTUP_NORMAL)
@@ -166,6 +167,9 @@ const char* TDeckBoard::getManufacturerName() const {
 }
 
 void TDeckBoard::reboot() {
+    // Queued archive saves only exist in RAM
+    MessageArchive::flush();
+
     Serial.println("[BOARD] Rebooting...");
     Serial.flush();
     delay(100);
@@ -220,6 +220,10 @@
 #define PIN_SD_SCK      40      // Shared with display/LoRa SPI bus
 #define PIN_SD_CS       39      // SD card chip select
 
+// SD SPI clock: mount at the safe rate, then tune upwards per card
+#define SD_SPI_FREQ_SAFE    4000000     // Mount and fallback clock
+#define SD_SPI_FREQ_MAX     40000000    // Highest clock tried (APB/2)
+
 // =============================================================================
 // POWER MANAGEMENT
 // =============================================================================
@@ -236,13 +240,13 @@
 // =============================================================================
 
 // Maximum nodes to track
-#define MAX_NODES           64
+#define MAX_NODES           256     // Discovered-node cache (PSRAM, LRU)
 #define MAX_REPEATERS       32
 #define MAX_CHANNELS        8
 
 // Message settings
 #define MAX_MESSAGE_LENGTH  200
-#define MESSAGE_HISTORY     50
+#define MESSAGE_HISTORY     64      // Power of two (ring buffer)
 
 // =============================================================================
 // UI SETTINGS
@@ -23,8 +23,13 @@
  */
 
 #include "audio.h"
+#include "wavdecode.h"
+#include "storage.h"
 #include "../settings/DeviceSettings.h"
 #include <driver/i2s.h>
+#include <esp_heap_caps.h>
+#include <SD.h>
+#include <freertos/queue.h>
 #include <math.h>
 
 // I2S configuration
@@ -35,6 +40,16 @@
 
 // Tone generation
 #define TONE_SAMPLE_RATE 16000
+
+// File streaming
+#define I2S_DMA_SAMPLES       (8 * 256)   // dma_buf_count * dma_buf_len
+#define STREAM_BUFFERS        8           // Decoded buffers (covers main loop stalls)
+#define STREAM_TASK_STACK     4096
+#define STREAM_TASK_CORE      0           // I2S writer only; the loop task reads SD
+#define STREAM_WRITER_PRIO    2
+#define STREAM_POLL_MS        50          // Stop-flag check interval while blocked
+#define STREAM_STOP_WAIT_MS   500
+#define STREAM_END            0xFF        // Queue marker: reader finished
 // Note: PI is already defined in Arduino.h
 
 // Internal state
@@ -44,12 +59,213 @@ static bool muted = false;
 static uint8_t volume = 80;  // 0-100
 static bool currentlyPlaying = false;
 
+// Streaming state (shared between the loop task and the writer task)
+struct StreamBuffer {
+    int16_t* samples;
+    size_t count;
+};
+static Wav::Info streamInfo;
+static Wav::Decoder streamDecoder;
+static File streamFile;                        // Loop task only
+static uint32_t streamRemaining = 0;           // Sample bytes still to read
+static uint8_t* streamRaw = nullptr;
+static StreamBuffer streamBufs[STREAM_BUFFERS];
+static size_t streamBufSamples = 0;
+static QueueHandle_t streamFree = nullptr;     // Buffer indices ready to fill
+static QueueHandle_t streamFilled = nullptr;   // Buffer indices ready for I2S
+static volatile bool streaming = false;
+static volatile bool streamStop = false;
+static volatile bool streamReaderDone = false;
+
 // Recording state
 static int16_t* recordBuffer = nullptr;
 static size_t recordMaxSamples = 0;
 static size_t recordedSamples = 0;
 static bool recording = false;
 
+// =============================================================================
+// FILE STREAMING
+// =============================================================================
+//
+// The loop task and one task on core 0 form a buffered pipeline:
+//   loop task: SD -> raw chunk -> decode -> free buffer -> streamFilled
+//   audio_out: streamFilled -> i2s_write (DMA) -> streamFree
+//
+// The SD card shares its SPI pins with the display and radio. Each has its
+// own SPIClass, so the SPI driver's bus lock does not serialise them, and
+// the display and radio are only safe because the loop task alone drives
+// them. The card is therefore read on the loop task too (Audio::process()),
+// which also owns the File. audio_out touches only I2S, so the loop task
+// can stall for as long as the queued buffers last without a gap.
+
+class FileReader : public Wav::Reader {
+public:
+    explicit FileReader(File& f) : _f(f) {}
+    size_t read(uint8_t* buf, size_t len) override { return _f.read(buf, len); }
+    bool skip(uint32_t len) override { return _f.seek(_f.position() + len); }
+private:
+    File& _f;
+};
+
+static void* allocStreamBuffer(size_t bytes) {
+    void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!p) {
+        p = malloc(bytes);
+    }
+    return p;
+}
+
+/**
+ * Open a WAV file into streamFile and read its header into streamInfo
+ */
+static bool openStream(const char* filename) {
+    Storage::SDLock lock;
+    streamFile = SD.open(filename, FILE_READ);
+    if (!streamFile || streamFile.isDirectory()) {
+        Serial.printf("[AUDIO] playFile: cannot open %s\n", filename);
+        streamFile.close();
+        return false;
+    }
+
+    FileReader reader(streamFile);
+    if (!Wav::parseHeader(reader, streamInfo)) {
+        Serial.printf("[AUDIO] playFile: unsupported WAV %s\n", filename);
+        streamFile.close();
+        return false;
+    }
+
+    // Clamp to the file in case the data chunk size is bogus
+    uint32_t size = streamFile.size();
+    uint32_t avail = size > streamInfo.dataOffset ? size - streamInfo.dataOffset : 0;
+    if (streamInfo.dataSize > avail) streamInfo.dataSize = avail;
+    streamRemaining = streamInfo.dataSize;
+    return true;
+}
+
+static void closeStream() {
+    Storage::SDLock lock;
+    streamFile.close();
+}
+
+/**
+ * Close the file and tell the writer no more buffers are coming
+ */
+static void finishReading() {
+    closeStream();
+
+    // Queue has room for every buffer plus the end marker, so this never blocks.
+    // The writer frees the queues once streamReaderDone is set.
+    uint8_t end = STREAM_END;
+    xQueueSend(streamFilled, &end, 0);
+    streamReaderDone = true;
+}
+
+/**
+ * Read and decode a chunk into every free buffer (loop task)
+ */
+static void fillStreamBuffers() {
+    if (!streaming || streamReaderDone) return;
+    const size_t chunk = streamDecoder.inputChunkSize();
+
+    uint8_t idx;
+    while (!streamStop && streamRemaining > 0 && xQueueReceive(streamFree, &idx, 0) == pdTRUE) {
+        size_t want = streamRemaining < chunk ? streamRemaining : chunk;
+        size_t got;
+        {
+            Storage::SDLock lock;
+            got = streamFile.read(streamRaw, want);
+        }
+        if (got == 0) {
+            streamRemaining = 0;
+            xQueueSend(streamFree, &idx, 0);
+            break;
+        }
+        streamRemaining -= got;
+
+        StreamBuffer& b = streamBufs[idx];
+        b.count = streamDecoder.decode(streamRaw, got, b.samples, streamBufSamples);
+
+        // Volume is read per chunk so changes apply mid-file
+        int32_t scale = volume;
+        for (size_t i = 0; i < b.count; i++) {
+            b.samples[i] = (int16_t)((b.samples[i] * scale) / 100);
+        }
+        xQueueSend(streamFilled, &idx, 0);
+    }
+
+    if (streamStop || streamRemaining == 0) {
+        finishReading();
+    }
+}
+
+static void streamCleanup() {
+    for (int i = 0; i < STREAM_BUFFERS; i++) {
+        free(streamBufs[i].samples);
+        streamBufs[i].samples = nullptr;
+    }
+    free(streamRaw);
+    streamRaw = nullptr;
+    if (streamFree) vQueueDelete(streamFree);
+    if (streamFilled) vQueueDelete(streamFilled);
+    streamFree = nullptr;
+    streamFilled = nullptr;
+}
+
+static void streamWriterTask(void*) {
+    while (true) {
+        uint8_t idx;
+        if (xQueueReceive(streamFilled, &idx, pdMS_TO_TICKS(STREAM_POLL_MS)) != pdTRUE) {
+            if (streamStop) break;
+            continue;
+        }
+        if (idx == STREAM_END) break;
+
+        // Write in pieces so a stop request is seen within one DMA buffer
+        const StreamBuffer& b = streamBufs[idx];
+        size_t off = 0;
+        while (off < b.count && !streamStop) {
+            size_t written = 0;
+            i2s_write(I2S_NUM, b.samples + off, (b.count - off) * sizeof(int16_t),
+                      &written, pdMS_TO_TICKS(STREAM_POLL_MS));
+            off += written / sizeof(int16_t);
+        }
+        xQueueSend(streamFree, &idx, 0);
+    }
+
+    if (streamStop) {
+        i2s_zero_dma_buffer(I2S_NUM);
+    } else {
+        // Push the tail out of the DMA ring before switching clocks
+        static const int16_t silence[256] = {0};
+        for (int i = 0; i < I2S_DMA_SAMPLES / 256; i++) {
+            size_t written;
+            i2s_write(I2S_NUM, silence, sizeof(silence), &written, portMAX_DELAY);
+        }
+    }
+    if (streamInfo.sampleRate != I2S_SAMPLE_RATE) {
+        i2s_set_sample_rates(I2S_NUM, I2S_SAMPLE_RATE);
+    }
+
+    while (!streamReaderDone) vTaskDelay(pdMS_TO_TICKS(5));
+    streamCleanup();
+    Serial.println(streamStop ? "[AUDIO] Playback stopped" : "[AUDIO] Playback finished");
+    streaming = false;
+    vTaskDelete(NULL);
+}
+
+/**
+ * Close the file and wait for the writer task to release I2S
+ */
+static void stopStream() {
+    if (!streaming) return;
+    streamStop = true;
+    if (!streamReaderDone) finishReading();
+    uint32_t start = millis();
+    while (streaming && millis() - start < STREAM_STOP_WAIT_MS) {
+        delay(5);
+    }
+}
+
 namespace Audio {
 
 bool initSpeaker() {
@@ -100,6 +316,7 @@ bool initSpeaker() {
 
 void playTone(uint16_t frequency, uint16_t duration, uint8_t vol) {
     if (!speakerInitialized || muted) return;
+    stopStream();
 
     // Use provided volume or default
     uint8_t effectiveVolume = (vol > 0) ? vol : volume;
@@ -283,6 +500,7 @@ void playAlertTone(AlertTone tone) {
 
 void play(const int16_t* samples, size_t length, AudioSampleRate_t sampleRate) {
     if (!speakerInitialized || muted || !samples || length == 0) return;
+    stopStream();
 
     // Update sample rate if different
     if (sampleRate != I2S_SAMPLE_RATE) {
@@ -312,21 +530,92 @@ void play(const int16_t* samples, size_t length, AudioSampleRate_t sampleRate) {
 }
 
 bool playFile(const char* filename) {
-    // TODO: Implement WAV file playback from SD card
-    // This will be implemented in Phase 2 with wavplayer.cpp
-    Serial.printf("[AUDIO] playFile not yet implemented: %s\n", filename);
-    return false;
+    if (!speakerInitialized || muted || !filename) return false;
+    if (!Storage::isSDAvailable()) {
+        Serial.println("[AUDIO] playFile: no SD card");
+        return false;
+    }
+
+    // Only one stream at a time - a new file replaces the current one
+    stopStream();
+    if (streaming) {
+        Serial.println("[AUDIO] playFile: previous stream did not stop");
+        return false;
+    }
+
+    if (!openStream(filename)) return false;
+
+    streamDecoder.begin(streamInfo);
+    if (streamInfo.format == Wav::WAV_FORMAT_IMA_ADPCM) {
+        streamBufSamples = streamInfo.samplesPerBlock;
+    } else {
+        streamBufSamples = streamDecoder.inputChunkSize() / streamInfo.blockAlign;
+    }
+
+    streamRaw = (uint8_t*)malloc(streamDecoder.inputChunkSize());
+    bool ok = streamRaw != nullptr;
+    for (int i = 0; i < STREAM_BUFFERS; i++) {
+        streamBufs[i].samples = (int16_t*)allocStreamBuffer(streamBufSamples * sizeof(int16_t));
+        streamBufs[i].count = 0;
+        ok = ok && streamBufs[i].samples;
+    }
+    streamFree = xQueueCreate(STREAM_BUFFERS, sizeof(uint8_t));
+    streamFilled = xQueueCreate(STREAM_BUFFERS + 1, sizeof(uint8_t));
+    ok = ok && streamFree && streamFilled;
+    if (!ok) {
+        Serial.println("[AUDIO] playFile: out of memory");
+        closeStream();
+        streamCleanup();
+        return false;
+    }
+    for (uint8_t i = 0; i < STREAM_BUFFERS; i++) {
+        xQueueSend(streamFree, &i, 0);
+    }
+
+    if (streamInfo.sampleRate != I2S_SAMPLE_RATE) {
+        i2s_set_sample_rates(I2S_NUM, streamInfo.sampleRate);
+    }
+
+    streamStop = false;
+    streamReaderDone = false;
+    streaming = true;
+
+    // Fill every buffer before the writer starts draining them
+    fillStreamBuffers();
+
+    if (xTaskCreatePinnedToCore(streamWriterTask, "audio_out", STREAM_TASK_STACK, nullptr,
+                                STREAM_WRITER_PRIO, nullptr, STREAM_TASK_CORE) != pdPASS) {
+        Serial.println("[AUDIO] playFile: task create failed");
+        if (streamInfo.sampleRate != I2S_SAMPLE_RATE) {
+            i2s_set_sample_rates(I2S_NUM, I2S_SAMPLE_RATE);
+        }
+        if (!streamReaderDone) closeStream();
+        streamCleanup();
+        streaming = false;
+        return false;
+    }
+
+    Serial.printf("[AUDIO] Playing %s: %s %u Hz %s, %lu bytes\n", filename,
+                  Wav::formatName(streamInfo), (unsigned)streamInfo.sampleRate,
+                  streamInfo.channels == 2 ? "stereo" : "mono",
+                  (unsigned long)streamInfo.dataSize);
+    return true;
+}
+
+void process() {
+    fillStreamBuffers();
 }
 
 void stop() {
     if (!speakerInitialized) return;
 
+    stopStream();
     i2s_zero_dma_buffer(I2S_NUM);
     currentlyPlaying = false;
 }
 
 bool isPlaying() {
-    return currentlyPlaying;
+    return currentlyPlaying || streaming;
 }
 
 void setVolume(uint8_t vol) {
@@ -339,6 +628,7 @@ uint8_t getVolume() {
 }
 
 void mute() {
+    stopStream();
     muted = true;
     Serial.println("[AUDIO] Muted");
 }
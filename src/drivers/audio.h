@@ -101,13 +101,22 @@ void play(const int16_t* samples, size_t length, AudioSampleRate_t sampleRate =
 
 /**
  * Play audio from SD card
+ * Streams PCM (8/16-bit) or IMA-ADPCM WAV files, mono or stereo; returns
+ * immediately. Any sound already playing is stopped first.
  * @param filename Path to WAV file on SD card
  * @return true if playback started
  */
 bool playFile(const char* filename);
 
 /**
- * Stop current playback
+ * Refill the file stream's buffers from SD - call every main loop pass
+ * The card shares its SPI pins with the display and radio, so it is only
+ * read from the loop task that drives them.
+ */
+void process();
+
+/**
+ * Stop current playback (including a file stream)
  */
 void stop();
 
@@ -27,6 +27,7 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
 #include "../ui/Emoji.h"
+#include "../ui/Font.h"
 
 // T-Deck pins (from LilyGo official)
 #define BOARD_POWERON   10
@@ -257,6 +258,15 @@ void drawRGB565(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w, int16_t
 // EMOJI-AWARE TEXT RENDERING
 // =============================================================================
 
+/**
+ * Font::drawGlyph run callback
+ * fillRect selects the display per run: a glyph page miss reads the SD
+ * card, which shares the SPI bus, so no write transaction is held open.
+ */
+static void fillGlyphRun(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    display->fillRect(x, y, w, h, color);
+}
+
 void drawTextWithEmoji(int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size) {
     if (!displayInitialized || !display || !text) return;
 
@@ -298,12 +308,21 @@ void drawTextWithEmoji(int16_t x, int16_t y, const char* text, uint16_t color, u
                 drawRGB565(cursorX, emojiY, emoji->bitmap, EMOJI_WIDTH, EMOJI_HEIGHT);
                 cursorX += EMOJI_WIDTH;
             } else {
-                // Unknown Unicode character - render placeholder [?]
-                display->setTextColor(color);
-                display->setTextSize(size);
-                display->setCursor(cursorX, y);
-                display->print("[?]");
-                cursorX += 3 * charWidth;
+                uint8_t cp437;
+                int16_t advance = 0;
+                if (Font::toCP437(codepoint, &cp437)) {
+                    // Accented Latin, box drawing etc. from the built-in font
+                    display->drawChar(cursorX, y, cp437, color, color, size);
+                    advance = charWidth;
+                } else {
+                    advance = Font::drawGlyph(cursorX, y, codepoint, color, size, fillGlyphRun);
+                }
+                if (advance == 0) {
+                    // No glyph anywhere - draw a box, same width as textWidth()
+                    display->drawRect(cursorX, y + size, charWidth - size, charHeight - 2 * size, color);
+                    advance = charWidth;
+                }
+                cursorX += advance;
             }
             p += bytes;
         }
@@ -176,7 +176,8 @@ void drawRGB565(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w, int16_t
 /**
  * Draw text with embedded emoji support
  * Parses UTF-8 text and renders emoji as bitmaps inline with text.
- * Unknown Unicode characters are rendered as [?]
+ * Other non-ASCII characters use the built-in CP437 glyphs or a loaded
+ * Unicode font face (see Font); characters with no glyph are drawn as a box.
  *
  * @param x X position
  * @param y Y position
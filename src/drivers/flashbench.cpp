@@ -0,0 +1,188 @@
+/**
+ * MeshBerry Flash Filesystem Benchmark Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ */
+
+#include "flashbench.h"
+#include "storage.h"
+#include "../settings/MessageArchive.h"
+
+// Flat names so the same files work on SPIFFS (no directories)
+static const char* FILL_FILE = "/.bench_fill";
+static const char* READ_FILE = "/.bench_read";
+static const char* LOG_FILE = "/.bench_log";
+static const char* REWRITE_FILE = "/.bench_rw";
+
+// Fill levels to measure at (percent of the partition, 0 = as found)
+static const uint8_t FILL_LEVELS[] = { 0, 50, 75, 90 };
+
+struct OpStats {
+    uint32_t totalUs;
+    uint32_t maxUs;
+    int count;
+
+    void add(uint32_t us) {
+        totalUs += us;
+        if (us > maxUs) maxUs = us;
+        count++;
+    }
+    uint32_t avgUs() const { return count ? totalUs / count : 0; }
+};
+
+static uint8_t s_buffer[FlashBench::BENCH_REWRITE_BYTES];
+
+static bool writeWhole(const char* path, size_t len) {
+    File f = FLASH_FS.open(path, FILE_WRITE);
+    if (!f) return false;
+    size_t written = f.write(s_buffer, len);
+    f.close();
+    return written == len;
+}
+
+/**
+ * Grow the filler file until the partition is `percent` full
+ */
+static bool fillTo(uint8_t percent) {
+    size_t total = Storage::flashTotalBytes();
+    size_t target = total * percent / 100;
+    if (Storage::flashUsedBytes() >= target) return true;
+
+    File f = FLASH_FS.open(FILL_FILE, FILE_APPEND);
+    if (!f) return false;
+    bool ok = true;
+    while (Storage::flashUsedBytes() < target) {
+        if (f.write(s_buffer, FlashBench::BENCH_FILL_CHUNK) != FlashBench::BENCH_FILL_CHUNK) {
+            ok = false;
+            break;
+        }
+        f.flush();
+        yield();
+    }
+    f.close();
+    return ok;
+}
+
+static void printRow(const char* name, const OpStats& s) {
+    Serial.printf("  %-8s avg %8lu us   max %8lu us\n", name,
+                  (unsigned long)s.avgUs(), (unsigned long)s.maxUs);
+}
+
+/**
+ * Remove the test files, remounting first if a mount cycle failed
+ */
+static void cleanUp() {
+    if (!Storage::isFlashAvailable() && !Storage::remountFlash()) {
+        Serial.println("[BENCH] Flash could not be remounted; filler left until next run");
+        return;
+    }
+    FLASH_FS.remove(FILL_FILE);
+    FLASH_FS.remove(READ_FILE);
+    FLASH_FS.remove(LOG_FILE);
+    FLASH_FS.remove(REWRITE_FILE);
+}
+
+/**
+ * Measure each fill level; returns false if it had to stop early
+ */
+static bool runLevels() {
+    for (size_t level = 0; level < sizeof(FILL_LEVELS); level++) {
+        uint8_t percent = FILL_LEVELS[level];
+        uint32_t fillStart = millis();
+        if (!fillTo(percent)) {
+            Serial.printf("[BENCH] Could not fill to %d%%, stopping\n", percent);
+            return false;
+        }
+        uint32_t fillMs = millis() - fillStart;
+
+        OpStats open = {}, append = {}, rewrite = {}, mount = {};
+        char readBuf[64];
+
+        for (int i = 0; i < FlashBench::BENCH_ITERATIONS; i++) {
+            // Open + small read + close of an existing file (settings load path)
+            uint32_t t = micros();
+            File f = FLASH_FS.open(READ_FILE, FILE_READ);
+            if (f) {
+                f.read((uint8_t*)readBuf, sizeof(readBuf));
+                f.close();
+            }
+            open.add(micros() - t);
+
+            // Append a record (message archive path)
+            t = micros();
+            f = FLASH_FS.open(LOG_FILE, FILE_APPEND);
+            if (f) {
+                f.write(s_buffer, FlashBench::BENCH_APPEND_BYTES);
+                f.close();
+            }
+            append.add(micros() - t);
+
+            // Rewrite a whole file (contacts/DM save path)
+            t = micros();
+            writeWhole(REWRITE_FILE, FlashBench::BENCH_REWRITE_BYTES);
+            rewrite.add(micros() - t);
+            yield();
+        }
+
+        for (int i = 0; i < FlashBench::BENCH_MOUNT_CYCLES; i++) {
+            uint32_t t = micros();
+            bool ok = Storage::remountFlash();
+            mount.add(micros() - t);
+            if (!ok) {
+                Serial.println("[BENCH] Remount failed!");
+                return false;
+            }
+        }
+
+        size_t used = Storage::flashUsedBytes();
+        Serial.printf("Fill %u%% (%u KB used, filled in %lu ms):\n",
+                      (unsigned)(used * 100 / Storage::flashTotalBytes()),
+                      (unsigned)(used / 1024), (unsigned long)fillMs);
+        printRow("open", open);
+        printRow("append", append);
+        printRow("rewrite", rewrite);
+        printRow("mount", mount);
+    }
+    return true;
+}
+
+namespace FlashBench {
+
+bool run() {
+    if (!Storage::isFlashAvailable()) {
+        Serial.println("[BENCH] Flash not mounted");
+        return false;
+    }
+
+    // The mount cycles need every flash file closed, and nothing else may
+    // write while the partition is nearly full
+    MessageArchive::flush();
+
+    for (size_t i = 0; i < sizeof(s_buffer); i++) s_buffer[i] = (uint8_t)(i * 31 + 7);
+
+    Serial.printf("\n=== Flash benchmark: %s, %u KB partition ===\n", FLASH_FS_NAME,
+                  (unsigned)(Storage::flashTotalBytes() / 1024));
+
+    uint32_t benchStart = millis();
+    bool ok = writeWhole(READ_FILE, BENCH_REWRITE_BYTES);
+    if (!ok) {
+        Serial.println("[BENCH] Cannot create test file");
+    } else {
+        ok = runLevels();
+    }
+
+    cleanUp();
+    Serial.printf("Benchmark %s in %lu s, test files removed\n", ok ? "finished" : "stopped",
+                  (unsigned long)((millis() - benchStart) / 1000));
+    return ok && Storage::isFlashAvailable();
+}
+
+void removeLeftovers() {
+    if (Storage::isFlashAvailable() && FLASH_FS.exists(FILL_FILE)) {
+        Serial.println("[BENCH] Removing filler left by an interrupted benchmark");
+        cleanUp();
+    }
+}
+
+} // namespace FlashBench
@@ -0,0 +1,44 @@
+/**
+ * MeshBerry Flash Filesystem Benchmark
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * Measures open, append, rewrite and mount latency of the internal flash
+ * filesystem (FLASH_FS) at several fill levels. Build once normally and
+ * once with -DMESHBERRY_FLASH_SPIFFS to compare LittleFS with SPIFFS.
+ */
+
+#ifndef MESHBERRY_FLASHBENCH_H
+#define MESHBERRY_FLASHBENCH_H
+
+#include <Arduino.h>
+
+namespace FlashBench {
+
+constexpr int      BENCH_ITERATIONS     = 20;     // Per operation and fill level
+constexpr int      BENCH_MOUNT_CYCLES   = 3;
+constexpr size_t   BENCH_APPEND_BYTES   = 64;     // One archived message record
+constexpr size_t   BENCH_REWRITE_BYTES  = 4096;   // Typical contacts.json
+constexpr size_t   BENCH_FILL_CHUNK     = 4096;
+
+/**
+ * Run the benchmark and print a table to Serial
+ * Maintenance only: call from the main loop (the CLI), which blocks the
+ * mesh and UI for the whole run. Flushes and closes the message archive,
+ * temporarily fills flash with a filler file and remounts it several
+ * times. The test files are removed and flash remounted on every exit.
+ * Blocks for several seconds up to a few minutes on a slow filesystem.
+ * @return false if flash is not mounted or the run stopped early
+ */
+bool run();
+
+/**
+ * Remove test files left by a run cut short by a reset or power loss
+ * Call once at boot after Storage::init().
+ */
+void removeLeftovers();
+
+} // namespace FlashBench
+
+#endif // MESHBERRY_FLASHBENCH_H
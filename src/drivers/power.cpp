@@ -12,6 +12,7 @@
 #include "display.h"
 #include "keyboard.h"
 #include "config.h"  // For PIN_KB_SDA, PIN_KB_SCL, KB_I2C_FREQ
+#include "../settings/MessageArchive.h"
 #include <Wire.h>
 #include <driver/rtc_io.h>
 #include <esp_sleep.h>
@@ -291,6 +292,9 @@ static void runSleepLoop(uint32_t sleepIntervalSecs, uint32_t minWakeSecs, bool
             break;
         }
 
+        // Commit queued archive saves and close files before power drops
+        MessageArchive::flush();
+
         Serial.printf("[POWER] Sleep cycle (slept %u secs total)\n", totalSleptSecs);
         Serial.flush();
 
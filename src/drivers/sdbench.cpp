@@ -0,0 +1,115 @@
+/**
+ * MeshBerry Storage Throughput Benchmark Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ */
+
+#include "sdbench.h"
+#include "storage.h"
+#include <SD.h>
+
+static const char* SD_BENCH_FILE = "/meshberry/.bench_seq";
+static const char* FLASH_BENCH_FILE = "/.bench_seq";
+
+static uint8_t s_chunk[SDBench::BENCH_CHUNK_BYTES];
+
+static uint32_t kbPerSec(size_t bytes, uint32_t us) {
+    return us ? (uint32_t)((uint64_t)bytes * 1000000ULL / 1024 / us) : 0;
+}
+
+/**
+ * Sequential write, sequential read and record appends on one filesystem
+ */
+static bool benchFS(fs::FS& fs, const char* name, const char* path, size_t bytes) {
+    // Holds off audio streaming for the whole run, so its reads don't skew the numbers
+    Storage::SDLock lock;
+
+    // Sequential write
+    uint32_t t = micros();
+    File f = fs.open(path, FILE_WRITE);
+    if (!f) {
+        Serial.printf("[BENCH] %s: cannot create test file\n", name);
+        return false;
+    }
+    size_t written = 0;
+    while (written < bytes) {
+        if (f.write(s_chunk, sizeof(s_chunk)) != sizeof(s_chunk)) break;
+        written += sizeof(s_chunk);
+    }
+    f.close();
+    uint32_t writeUs = micros() - t;
+
+    // Sequential read
+    t = micros();
+    size_t readBytes = 0;
+    f = fs.open(path, FILE_READ);
+    if (f) {
+        size_t n;
+        while ((n = f.read(s_chunk, sizeof(s_chunk))) > 0) readBytes += n;
+        f.close();
+    }
+    uint32_t readUs = micros() - t;
+
+    // Archive-style appends: open, write one record, close
+    fs.remove(path);
+    uint32_t appendMaxUs = 0;
+    t = micros();
+    for (int i = 0; i < SDBench::BENCH_RECORDS; i++) {
+        uint32_t one = micros();
+        f = fs.open(path, FILE_APPEND);
+        if (f) {
+            f.write(s_chunk, SDBench::BENCH_RECORD_BYTES);
+            f.close();
+        }
+        one = micros() - one;
+        if (one > appendMaxUs) appendMaxUs = one;
+    }
+    uint32_t appendUs = micros() - t;
+    fs.remove(path);
+
+    Serial.printf("  %-6s write %6lu KB/s  read %6lu KB/s  append avg %6lu us max %6lu us\n",
+                  name,
+                  (unsigned long)kbPerSec(written, writeUs),
+                  (unsigned long)kbPerSec(readBytes, readUs),
+                  (unsigned long)(appendUs / SDBench::BENCH_RECORDS),
+                  (unsigned long)appendMaxUs);
+
+    if (written != bytes || readBytes != bytes) {
+        Serial.printf("  %-6s short transfer: wrote %u, read %u of %u bytes\n", name,
+                      (unsigned)written, (unsigned)readBytes, (unsigned)bytes);
+        return false;
+    }
+    return true;
+}
+
+namespace SDBench {
+
+bool run() {
+    if (!Storage::isAvailable()) {
+        Serial.println("[BENCH] No storage mounted");
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof(s_chunk); i++) s_chunk[i] = (uint8_t)(i * 31 + 7);
+
+    Serial.println("\n=== Storage throughput ===");
+    bool ok = true;
+    if (Storage::isSDAvailable()) {
+        Serial.printf("SD at %lu kHz, %u KB sequential:\n",
+                      (unsigned long)(Storage::getSDClock() / 1000),
+                      (unsigned)(BENCH_FILE_BYTES / 1024));
+        if (!benchFS(SD, "SD", SD_BENCH_FILE, BENCH_FILE_BYTES)) {
+            Storage::reportSDError();
+            ok = false;
+        }
+    }
+    if (Storage::isFlashAvailable()) {
+        Serial.printf("%s, %u KB sequential:\n", FLASH_FS_NAME,
+                      (unsigned)(BENCH_FLASH_BYTES / 1024));
+        ok = benchFS(FLASH_FS, "flash", FLASH_BENCH_FILE, BENCH_FLASH_BYTES) && ok;
+    }
+    return ok;
+}
+
+} // namespace SDBench
@@ -0,0 +1,34 @@
+/**
+ * MeshBerry Storage Throughput Benchmark
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * Measures sequential write and read throughput, and archive-sized record
+ * appends, on the SD card at its current (tuned) clock and on internal
+ * flash for comparison.
+ */
+
+#ifndef MESHBERRY_SDBENCH_H
+#define MESHBERRY_SDBENCH_H
+
+#include <Arduino.h>
+
+namespace SDBench {
+
+constexpr size_t   BENCH_FILE_BYTES     = 256 * 1024;  // Sequential test file
+constexpr size_t   BENCH_FLASH_BYTES    = 64 * 1024;   // Smaller on flash (limited space)
+constexpr size_t   BENCH_CHUNK_BYTES    = 4096;
+constexpr size_t   BENCH_RECORD_BYTES   = 224;         // One ArchivedMessage
+constexpr int      BENCH_RECORDS        = 50;
+
+/**
+ * Run the benchmark and print a table to Serial
+ * Blocks for a few seconds; test files are removed afterwards.
+ * @return false if no storage is mounted
+ */
+bool run();
+
+} // namespace SDBench
+
+#endif // MESHBERRY_SDBENCH_H
@@ -8,17 +8,540 @@
 #include "storage.h"
 #include "../config.h"
 #include <SD.h>
-#include <SPIFFS.h>
 #include <SPI.h>
+#include <esp_rom_crc.h>
+#include <freertos/semphr.h>
+#ifndef MESHBERRY_FLASH_SPIFFS
+#include <SPIFFS.h>
+#include <esp_heap_caps.h>
+#endif
 
 // Storage state
 static bool sdAvailable = false;
-static bool spiffsAvailable = false;
+static bool flashAvailable = false;
 static bool initialized = false;
 
 // Use the same SPI bus as display (HSPI)
 static SPIClass* sdSPI = nullptr;
 
+// SD clock state
+static uint32_t sdClock = 0;
+static uint32_t sdErrors = 0;
+static bool sdClockStepped = false;
+
+// Recursive: MessageArchive holds it while calling into Storage
+static SemaphoreHandle_t sdMutex = nullptr;
+
+#ifndef MESHBERRY_FLASH_SPIFFS
+// Flash is still SPIFFS, waiting for an SD card to migrate safely
+static bool flashOnSpiffs = false;
+#endif
+
+#ifndef MESHBERRY_FLASH_SPIFFS
+// =============================================================================
+// SPIFFS -> LITTLEFS MIGRATION
+// =============================================================================
+//
+// Both filesystems live on the same "spiffs" partition, so files are staged
+// in PSRAM and on the SD card before the partition is reformatted. The SD
+// copy is read back before the reformat and survives a power cut
+// mid-migration: its marker file is removed only after every file has been
+// written back. Without an SD card the PSRAM copy would be the only one, so
+// the partition is left as SPIFFS until a boot with a card.
+
+static const char* MIGRATE_DIR = "/meshberry/fsmigrate";
+static const char* MIGRATE_MARKER = "/meshberry/fsmigrate/.pending";
+static const int MIGRATE_MAX_FILES = 64;
+
+struct StagedFile {
+    char path[64];
+    uint8_t* data;
+    size_t len;
+};
+
+enum MigrateResult {
+    MIGRATE_DONE,           // LittleFS mounted with the files
+    MIGRATE_KEPT_SPIFFS,    // Nothing changed, SPIFFS still mounted
+    MIGRATE_FAILED          // Reformat failed; SD copy kept for the next boot
+};
+
+static void stagedPathOnSD(const char* path, char* out, size_t outLen) {
+    snprintf(out, outLen, "%s%s", MIGRATE_DIR, path);
+}
+
+/**
+ * Write a staged file to the SD card and read it back
+ */
+static bool writeSDCopy(const char* sdPath, const uint8_t* data, size_t len) {
+    File f = SD.open(sdPath, FILE_WRITE);
+    if (!f) return false;
+    bool ok = f.write(data, len) == len;
+    f.close();
+    if (!ok) return false;
+
+    f = SD.open(sdPath, FILE_READ);
+    if (!f || f.size() != len) return false;
+    uint8_t buf[512];
+    for (size_t off = 0; off < len && ok; off += sizeof(buf)) {
+        size_t n = len - off < sizeof(buf) ? len - off : sizeof(buf);
+        ok = f.read(buf, n) == n && memcmp(buf, data + off, n) == 0;
+    }
+    f.close();
+    return ok;
+}
+
+/**
+ * Write a file, creating parent directories
+ */
+static bool writeFlashFile(const char* path, const uint8_t* data, size_t len) {
+    File f = LittleFS.open(path, FILE_WRITE, true);
+    if (!f) return false;
+    size_t written = f.write(data, len);
+    f.close();
+    return written == len;
+}
+
+/**
+ * Make parent directories for a path on the SD card
+ */
+static void makeSDParents(const char* path) {
+    char dir[96];
+    strncpy(dir, path, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = '\0';
+    for (char* p = dir + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (!SD.exists(dir)) SD.mkdir(dir);
+        *p = '/';
+    }
+}
+
+/**
+ * Copy files staged on the SD card back to flash (interrupted migration)
+ * Each restored file's staged copy is removed, so a retry only redoes
+ * the ones that failed and never overwrites newer flash data.
+ * @return true if every staged file was restored
+ */
+static bool restoreFromSD(File dir) {
+    size_t prefixLen = strlen(MIGRATE_DIR);
+    bool ok = true;
+    File entry = dir.openNextFile();
+    while (entry) {
+        char sdPath[128];
+        strncpy(sdPath, entry.path(), sizeof(sdPath) - 1);
+        sdPath[sizeof(sdPath) - 1] = '\0';
+
+        if (entry.isDirectory()) {
+            if (!restoreFromSD(entry)) ok = false;
+            entry.close();
+        } else if (strcmp(sdPath, MIGRATE_MARKER) != 0) {
+            const char* flashPath = sdPath + prefixLen;
+            size_t len = entry.size();
+            uint8_t* buf = (uint8_t*)heap_caps_malloc(len ? len : 1, MALLOC_CAP_SPIRAM);
+            bool restored = buf && entry.read(buf, len) == len && writeFlashFile(flashPath, buf, len);
+            free(buf);
+            entry.close();
+            if (restored) {
+                SD.remove(sdPath);
+                Serial.printf("[STORAGE] Restored %s (%u bytes)\n", flashPath, (unsigned)len);
+            } else {
+                ok = false;
+                Serial.printf("[STORAGE] Failed to restore %s\n", flashPath);
+            }
+        } else {
+            entry.close();
+        }
+        entry = dir.openNextFile();
+    }
+    return ok;
+}
+
+static bool removeSDTree(const char* path) {
+    File dir = SD.open(path);
+    if (!dir) return false;
+    if (!dir.isDirectory()) {
+        dir.close();
+        return SD.remove(path);
+    }
+
+    // Removing entries while iterating can skip some, so restart each time
+    File entry = dir.openNextFile();
+    while (entry) {
+        char child[128];
+        strncpy(child, entry.path(), sizeof(child) - 1);
+        child[sizeof(child) - 1] = '\0';
+        entry.close();
+        if (!removeSDTree(child)) break;
+        dir.rewindDirectory();
+        entry = dir.openNextFile();
+    }
+    dir.close();
+    return SD.rmdir(path);
+}
+
+/**
+ * Finish a migration that was interrupted after the reformat
+ */
+static void resumeMigration() {
+    if (!sdAvailable || !SD.exists(MIGRATE_MARKER)) return;
+
+    Serial.println("[STORAGE] Resuming interrupted LittleFS migration from SD");
+    File dir = SD.open(MIGRATE_DIR);
+    if (!dir) return;
+    bool ok = restoreFromSD(dir);
+    dir.close();
+
+    // The SD copy may be the only one left: keep it until all of it is back
+    if (ok) {
+        removeSDTree(MIGRATE_DIR);
+    } else {
+        Serial.println("[STORAGE] Some files not restored; keeping SD copy for next boot");
+    }
+}
+
+/**
+ * Move every SPIFFS file onto a freshly formatted LittleFS
+ * Call with SPIFFS mounted and the SD card available.
+ */
+static MigrateResult migrateFromSPIFFS() {
+    uint32_t start = millis();
+    StagedFile* files = (StagedFile*)heap_caps_calloc(MIGRATE_MAX_FILES, sizeof(StagedFile),
+                                                       MALLOC_CAP_SPIRAM);
+    if (!files) {
+        Serial.println("[STORAGE] Migration aborted: no memory (SPIFFS left intact)");
+        return MIGRATE_KEPT_SPIFFS;
+    }
+
+    // Stage everything in PSRAM (SPIFFS is flat, so the root lists all files)
+    int count = 0;
+    size_t total = 0;
+    bool ok = true;
+    File root = SPIFFS.open("/");
+    File entry = root.openNextFile();
+    while (entry && ok) {
+        if (!entry.isDirectory()) {
+            if (count >= MIGRATE_MAX_FILES) {
+                ok = false;
+            } else {
+                StagedFile& sf = files[count];
+                strncpy(sf.path, entry.path(), sizeof(sf.path) - 1);
+                sf.len = entry.size();
+                sf.data = (uint8_t*)heap_caps_malloc(sf.len ? sf.len : 1, MALLOC_CAP_SPIRAM);
+                if (!sf.data || entry.read(sf.data, sf.len) != sf.len) {
+                    ok = false;
+                }
+                total += sf.len;
+                count++;
+            }
+        }
+        entry.close();
+        entry = root.openNextFile();
+    }
+    root.close();
+
+    // Verified second copy on the SD card in case power fails after the reformat
+    if (ok) {
+        char sdPath[96];
+        for (int i = 0; i < count && ok; i++) {
+            stagedPathOnSD(files[i].path, sdPath, sizeof(sdPath));
+            makeSDParents(sdPath);
+            ok = writeSDCopy(sdPath, files[i].data, files[i].len);
+        }
+        if (ok) {
+            File marker = SD.open(MIGRATE_MARKER, FILE_WRITE);
+            ok = marker;
+            if (marker) marker.close();
+        }
+        if (!ok) removeSDTree(MIGRATE_DIR);
+    }
+
+    if (!ok) {
+        Serial.println("[STORAGE] Migration aborted: could not stage files (SPIFFS left intact)");
+        for (int i = 0; i < count; i++) free(files[i].data);
+        free(files);
+        return MIGRATE_KEPT_SPIFFS;
+    }
+
+    Serial.printf("[STORAGE] Migrating %d files (%u bytes) from SPIFFS to LittleFS...\n",
+                  count, (unsigned)total);
+    SPIFFS.end();
+
+    bool mounted = LittleFS.format() && LittleFS.begin(false);
+    if (mounted) {
+        int failed = 0;
+        char sdPath[96];
+        for (int i = 0; i < count; i++) {
+            if (writeFlashFile(files[i].path, files[i].data, files[i].len)) {
+                // Only failed files keep their SD copy for the next boot
+                stagedPathOnSD(files[i].path, sdPath, sizeof(sdPath));
+                SD.remove(sdPath);
+            } else {
+                Serial.printf("[STORAGE] Failed to migrate %s\n", files[i].path);
+                failed++;
+            }
+        }
+
+        if (failed == 0) {
+            removeSDTree(MIGRATE_DIR);
+            Serial.printf("[STORAGE] Migration complete in %lu ms\n", (unsigned long)(millis() - start));
+        } else {
+            Serial.printf("[STORAGE] %d file(s) not migrated; SD copy kept, retrying next boot\n", failed);
+        }
+    } else {
+        Serial.println("[STORAGE] LittleFS format failed after staging; SD copy kept for next boot");
+    }
+
+    for (int i = 0; i < count; i++) free(files[i].data);
+    free(files);
+    return mounted ? MIGRATE_DONE : MIGRATE_FAILED;
+}
+#endif
+
+/**
+ * Mount internal flash, migrating from SPIFFS on first boot
+ */
+static bool mountFlash() {
+#ifdef MESHBERRY_FLASH_SPIFFS
+    return SPIFFS.begin(true);
+#else
+    if (LittleFS.begin(false)) {
+        resumeMigration();
+        return true;
+    }
+
+    // Not LittleFS yet: migrate existing SPIFFS data, or format a blank partition
+    if (SPIFFS.begin(false)) {
+        // A reformat is only safe with a durable second copy on the card
+        if (!sdAvailable) {
+            Serial.println("[STORAGE] SPIFFS kept: insert an SD card to migrate to LittleFS");
+            flashOnSpiffs = true;
+            return true;
+        }
+        switch (migrateFromSPIFFS()) {
+            case MIGRATE_DONE:
+                return true;
+            case MIGRATE_KEPT_SPIFFS:
+                Serial.println("[STORAGE] SPIFFS kept, retrying migration next boot");
+                flashOnSpiffs = true;
+                return true;
+            case MIGRATE_FAILED:
+                return false;
+        }
+        return false;
+    }
+
+    Serial.println("[STORAGE] No filesystem on flash, formatting LittleFS");
+    if (!LittleFS.begin(true)) return false;
+    resumeMigration();
+    return true;
+#endif
+}
+
+// =============================================================================
+// SD CLOCK TUNING
+// =============================================================================
+
+static const char* SD_CLOCK_FILE = "/meshberry/.sdclock";
+static const char* SD_OLD_TEST_FILE = "/meshberry/.sdtest";    // Written by older probes
+static const uint32_t SD_CLOCK_MAGIC = 0x4D42434C;  // "MBCL"
+static const uint32_t SD_CLOCK_RECHECK = 1 << 0;    // Stepped down after an error
+static const int SD_PROBE_SECTORS = 32;             // Read at each rate
+static const int SD_PROBE_PASSES = 2;
+
+// Rates the ESP32 SPI divider produces exactly from the 80 MHz APB clock
+static const uint32_t SD_CLOCK_STEPS[] = {
+    SD_SPI_FREQ_SAFE, 8000000, 10000000, 16000000, 20000000, 26666666, SD_SPI_FREQ_MAX
+};
+static const int SD_CLOCK_STEP_COUNT = sizeof(SD_CLOCK_STEPS) / sizeof(SD_CLOCK_STEPS[0]);
+
+/**
+ * Saved on the card itself, so each card keeps its own rate
+ */
+struct SDClockRecord {
+    uint32_t magic;
+    uint32_t hz;
+    uint32_t sectors;       // Card size, guards against a cloned file
+    uint32_t flags;         // SD_CLOCK_RECHECK
+    uint32_t crc;
+};
+
+// Probe sectors spread over the card and their CRCs read at the safe clock
+static uint32_t s_probeSector[SD_PROBE_SECTORS];
+static uint32_t s_probeCrc[SD_PROBE_SECTORS];
+
+static uint32_t recordCrc(const SDClockRecord& rec) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&rec, offsetof(SDClockRecord, crc));
+}
+
+static bool loadClockRecord(SDClockRecord& rec) {
+    File f = SD.open(SD_CLOCK_FILE, FILE_READ);
+    if (!f) return false;
+    size_t got = f.read((uint8_t*)&rec, sizeof(rec));
+    f.close();
+    return got == sizeof(rec) && rec.magic == SD_CLOCK_MAGIC && rec.crc == recordCrc(rec);
+}
+
+static bool saveClockRecord(uint32_t hz, uint32_t flags) {
+    SDClockRecord rec;
+    rec.magic = SD_CLOCK_MAGIC;
+    rec.hz = hz;
+    rec.sectors = SD.numSectors();
+    rec.flags = flags;
+    rec.crc = recordCrc(rec);
+
+    File f = SD.open(SD_CLOCK_FILE, FILE_WRITE);
+    if (!f) return false;
+    size_t written = f.write((const uint8_t*)&rec, sizeof(rec));
+    f.close();
+    return written == sizeof(rec);
+}
+
+/**
+ * Read the probe sectors at the current (safe) clock as the reference
+ */
+static bool readProbeReference() {
+    static uint8_t sector[512];
+    uint32_t count = SD.numSectors();
+    if (count == 0) return false;
+
+    for (int i = 0; i < SD_PROBE_SECTORS; i++) {
+        s_probeSector[i] = (uint32_t)((uint64_t)count * i / SD_PROBE_SECTORS);
+        if (!SD.readRAW(sector, s_probeSector[i])) return false;
+        s_probeCrc[i] = esp_rom_crc32_le(0, sector, sizeof(sector));
+    }
+    return true;
+}
+
+/**
+ * Re-read the probe sectors at the current clock and compare CRCs
+ * Reads only: nothing is written to the card at an unverified rate.
+ */
+static bool probeSDClock() {
+    static uint8_t sector[512];
+    for (int pass = 0; pass < SD_PROBE_PASSES; pass++) {
+        for (int i = 0; i < SD_PROBE_SECTORS; i++) {
+            if (!SD.readRAW(sector, s_probeSector[i])) return false;
+            if (esp_rom_crc32_le(0, sector, sizeof(sector)) != s_probeCrc[i]) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Remount the card at a new clock
+ */
+static bool remountSD(uint32_t hz) {
+    SD.end();
+    if (SD.begin(PIN_SD_CS, *sdSPI, hz)) {
+        sdClock = hz;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Get back to the safe clock after a failed rate; drops the card if even that fails
+ */
+static void fallBackToSafeClock() {
+    if (!remountSD(SD_SPI_FREQ_SAFE)) {
+        Serial.println("[STORAGE] SD card lost during clock tuning");
+        sdAvailable = false;
+        sdClock = 0;
+    }
+}
+
+/**
+ * Step the clock up to `ceiling` until a rate fails, settle on the fastest
+ * that passed. Call with the card at SD_SPI_FREQ_SAFE.
+ */
+static bool runClockTune(uint32_t ceiling) {
+    uint32_t start = millis();
+    uint32_t best = SD_SPI_FREQ_SAFE;
+
+    if (!readProbeReference()) {
+        Serial.println("[STORAGE] SD clock: reference read failed, keeping safe rate");
+        saveClockRecord(SD_SPI_FREQ_SAFE, 0);
+        return true;
+    }
+
+    for (int i = 1; i < SD_CLOCK_STEP_COUNT && SD_CLOCK_STEPS[i] <= ceiling; i++) {
+        uint32_t hz = SD_CLOCK_STEPS[i];
+        if (!remountSD(hz) || !probeSDClock()) {
+            Serial.printf("[STORAGE] SD clock %lu kHz failed\n", (unsigned long)(hz / 1000));
+            break;
+        }
+        best = hz;
+    }
+
+    if (sdClock != best && !remountSD(best)) {
+        fallBackToSafeClock();
+        if (!sdAvailable) return false;
+        best = SD_SPI_FREQ_SAFE;
+    }
+
+    saveClockRecord(best, 0);
+    Serial.printf("[STORAGE] SD clock tuned to %lu kHz in %lu ms\n",
+                  (unsigned long)(best / 1000), (unsigned long)(millis() - start));
+    return true;
+}
+
+/**
+ * Move a freshly mounted card to its saved clock, tuning if needed
+ * A saved rate is used as is; only a new card or a rate stepped down after
+ * an error is probed.
+ */
+static void selectSDClock() {
+    sdClock = SD_SPI_FREQ_SAFE;
+    if (SD.exists(SD_OLD_TEST_FILE)) SD.remove(SD_OLD_TEST_FILE);
+
+    SDClockRecord rec;
+    if (!loadClockRecord(rec) || rec.sectors != SD.numSectors() ||
+        rec.hz < SD_SPI_FREQ_SAFE || rec.hz > SD_SPI_FREQ_MAX) {
+        runClockTune(SD_SPI_FREQ_MAX);
+        return;
+    }
+
+    if (rec.flags & SD_CLOCK_RECHECK) {
+        // Never faster than the rate the error stepped down to
+        Serial.printf("[STORAGE] SD clock: rechecking %lu kHz after an error\n",
+                      (unsigned long)(rec.hz / 1000));
+        runClockTune(rec.hz);
+        return;
+    }
+
+    if (rec.hz == SD_SPI_FREQ_SAFE) {
+        Serial.println("[STORAGE] SD clock: saved safe rate");
+        return;
+    }
+    if (remountSD(rec.hz)) {
+        Serial.printf("[STORAGE] SD clock: saved %lu kHz\n", (unsigned long)(rec.hz / 1000));
+        return;
+    }
+    Serial.printf("[STORAGE] SD clock: mount at saved %lu kHz failed, retuning\n",
+                  (unsigned long)(rec.hz / 1000));
+    fallBackToSafeClock();
+    if (sdAvailable) runClockTune(rec.hz);
+}
+
+/**
+ * A read/write failed on the SD card: use one step slower from the next
+ * mount, and probe that rate before trusting it
+ */
+static void noteSDError() {
+    sdErrors++;
+    if (sdClockStepped || sdClock <= SD_SPI_FREQ_SAFE) return;
+    sdClockStepped = true;
+
+    uint32_t slower = SD_SPI_FREQ_SAFE;
+    for (int i = 0; i < SD_CLOCK_STEP_COUNT; i++) {
+        if (SD_CLOCK_STEPS[i] < sdClock) slower = SD_CLOCK_STEPS[i];
+    }
+    bool saved = saveClockRecord(slower, SD_CLOCK_RECHECK);
+    Serial.printf("[STORAGE] SD error at %lu kHz: next mount uses %lu kHz%s\n",
+                  (unsigned long)(sdClock / 1000), (unsigned long)(slower / 1000),
+                  saved ? "" : " (save failed)");
+}
+
 namespace Storage {
 
 bool init() {
@@ -27,6 +550,7 @@ bool init() {
     }
 
     Serial.println("[STORAGE] Initializing storage...");
+    sdMutex = xSemaphoreCreateRecursiveMutex();
 
     // First try SD card
     Serial.println("[STORAGE] Attempting SD card mount...");
@@ -36,7 +560,7 @@ bool init() {
     sdSPI->begin(PIN_SD_SCK, PIN_SD_MISO, PIN_SD_MOSI, PIN_SD_CS);
 
     // Try to mount SD card
-    if (SD.begin(PIN_SD_CS, *sdSPI, 4000000)) {  // 4MHz for compatibility
+    if (SD.begin(PIN_SD_CS, *sdSPI, SD_SPI_FREQ_SAFE)) {  // Safe rate until tuned
         sdAvailable = true;
         uint64_t cardSize = SD.cardSize() / (1024 * 1024);
         Serial.printf("[STORAGE] SD card mounted: %lluMB\n", cardSize);
@@ -51,28 +575,33 @@ bool init() {
         if (!SD.exists("/meshberry/dms")) {
             SD.mkdir("/meshberry/dms");
         }
+        if (!SD.exists("/meshberry/sounds")) {
+            SD.mkdir("/meshberry/sounds");
+        }
+
+        selectSDClock();
     } else {
         Serial.println("[STORAGE] SD card not available");
         sdAvailable = false;
     }
 
-    // SPIFFS should already be initialized by SettingsManager
-    // But check if it's available
-    if (SPIFFS.begin(false)) {  // false = don't format if mount fails
-        spiffsAvailable = true;
-        Serial.printf("[STORAGE] SPIFFS available: %d bytes free\n",
-                      SPIFFS.totalBytes() - SPIFFS.usedBytes());
+    // Internal flash holds settings, contacts and identity
+    uint32_t mountStart = millis();
+    flashAvailable = mountFlash();
+    if (flashAvailable) {
+        Serial.printf("[STORAGE] %s mounted in %lu ms: %u bytes free\n", FLASH_FS_NAME,
+                      (unsigned long)(millis() - mountStart),
+                      (unsigned)(flashTotalBytes() - flashUsedBytes()));
     } else {
-        Serial.println("[STORAGE] SPIFFS not available");
-        spiffsAvailable = false;
+        Serial.printf("[STORAGE] %s not available\n", FLASH_FS_NAME);
     }
 
     initialized = true;
 
     if (sdAvailable) {
         Serial.println("[STORAGE] Using SD card for message storage");
-    } else if (spiffsAvailable) {
-        Serial.println("[STORAGE] Using SPIFFS fallback for message storage");
+    } else if (flashAvailable) {
+        Serial.printf("[STORAGE] Using %s fallback for message storage\n", FLASH_FS_NAME);
     } else {
         Serial.println("[STORAGE] WARNING: No storage available!");
     }
@@ -80,17 +609,98 @@ bool init() {
     return isAvailable();
 }
 
+void lockSD() {
+    if (sdMutex) xSemaphoreTakeRecursive(sdMutex, portMAX_DELAY);
+}
+
+void unlockSD() {
+    if (sdMutex) xSemaphoreGiveRecursive(sdMutex);
+}
+
+#ifndef MESHBERRY_FLASH_SPIFFS
+fs::FS& flashFS() {
+    if (flashOnSpiffs) return SPIFFS;
+    return LittleFS;
+}
+
+const char* flashFSName() {
+    return flashOnSpiffs ? "SPIFFS" : "LittleFS";
+}
+
+size_t flashTotalBytes() {
+    return flashOnSpiffs ? SPIFFS.totalBytes() : LittleFS.totalBytes();
+}
+
+size_t flashUsedBytes() {
+    return flashOnSpiffs ? SPIFFS.usedBytes() : LittleFS.usedBytes();
+}
+
+bool remountFlash() {
+    if (flashOnSpiffs) {
+        SPIFFS.end();
+        flashAvailable = SPIFFS.begin(false);
+    } else {
+        LittleFS.end();
+        flashAvailable = LittleFS.begin(false);
+    }
+    return flashAvailable;
+}
+#else
+size_t flashTotalBytes() {
+    return SPIFFS.totalBytes();
+}
+
+size_t flashUsedBytes() {
+    return SPIFFS.usedBytes();
+}
+
+bool remountFlash() {
+    SPIFFS.end();
+    flashAvailable = SPIFFS.begin(false);
+    return flashAvailable;
+}
+#endif
+
 bool isSDAvailable() {
     return sdAvailable;
 }
 
+bool isFlashAvailable() {
+    return flashAvailable;
+}
+
 bool isAvailable() {
-    return sdAvailable || spiffsAvailable;
+    return sdAvailable || flashAvailable;
+}
+
+uint32_t getSDClock() {
+    return sdAvailable ? sdClock : 0;
+}
+
+bool tuneSDClock() {
+    if (!sdAvailable) return false;
+    SDLock lock;
+    if (sdClock != SD_SPI_FREQ_SAFE) {
+        fallBackToSafeClock();
+        if (!sdAvailable) return false;
+    }
+    sdClockStepped = false;
+    return runClockTune(SD_SPI_FREQ_MAX);
+}
+
+void reportSDError() {
+    if (!sdAvailable) return;
+    SDLock lock;
+    noteSDError();
+}
+
+uint32_t getSDErrorCount() {
+    return sdErrors;
 }
 
 const char* getStorageType() {
     if (sdAvailable) return "SD";
-    if (spiffsAvailable) return "SPIFFS";
+    if (flashAvailable) return FLASH_FS_NAME;
     return "None";
 }
 
@@ -99,14 +709,14 @@ static fs::FS& getFS() {
     if (sdAvailable) {
         return SD;
     }
-    return SPIFFS;
+    return FLASH_FS;
 }
 
 // Helper to build full path with appropriate prefix
 // Uses static buffer to avoid heap fragmentation from String concatenation
 static const char* buildPath(const char* path, char* buffer, size_t bufferSize) {
     // For SD card, files go under /meshberry
-    // For SPIFFS, files go in root (limited space)
+    // For internal flash, files go in root (limited space)
     if (sdAvailable) {
         if (path[0] == '/') {
             snprintf(buffer, bufferSize, "/meshberry%s", path);
@@ -114,7 +724,7 @@ static const char* buildPath(const char* path, char* buffer, size_t bufferSize)
             snprintf(buffer, bufferSize, "/meshberry/%s", path);
         }
     } else {
-        // SPIFFS - use path as-is but ensure it starts with /
+        // Flash - use path as-is but ensure it starts with /
         if (path[0] == '/') {
             snprintf(buffer, bufferSize, "%s", path);
         } else {
@@ -126,12 +736,14 @@ static const char* buildPath(const char* path, char* buffer, size_t bufferSize)
 
 bool writeFile(const char* path, const uint8_t* data, size_t len) {
     if (!isAvailable()) return false;
+    SDLock lock;
 
     char pathBuffer[256];
     const char* fullPath = buildPath(path, pathBuffer, sizeof(pathBuffer));
     File file = getFS().open(fullPath, FILE_WRITE);
     if (!file) {
         Serial.printf("[STORAGE] Failed to open %s for writing\n", fullPath);
+        reportSDError();
         return false;
     }
 
@@ -140,6 +752,7 @@ bool writeFile(const char* path, const uint8_t* data, size_t len) {
 
     if (written != len) {
         Serial.printf("[STORAGE] Write incomplete: %d/%d bytes\n", written, len);
+        reportSDError();
         return false;
     }
 
@@ -148,6 +761,7 @@ bool writeFile(const char* path, const uint8_t* data, size_t len) {
 
 bool appendFile(const char* path, const uint8_t* data, size_t len) {
     if (!isAvailable()) return false;
+    SDLock lock;
 
     char pathBuffer[256];
     const char* fullPath = buildPath(path, pathBuffer, sizeof(pathBuffer));
@@ -157,6 +771,7 @@ bool appendFile(const char* path, const uint8_t* data, size_t len) {
         file = getFS().open(fullPath, FILE_WRITE);
         if (!file) {
             Serial.printf("[STORAGE] Failed to open %s for append\n", fullPath);
+            reportSDError();
             return false;
         }
     }
@@ -166,6 +781,7 @@ bool appendFile(const char* path, const uint8_t* data, size_t len) {
 
     if (written != len) {
         Serial.printf("[STORAGE] Append incomplete: %d/%d bytes\n", written, len);
+        reportSDError();
         return false;
     }
 
@@ -174,6 +790,7 @@ bool appendFile(const char* path, const uint8_t* data, size_t len) {
 
 bool readFile(const char* path, uint8_t* buffer, size_t maxLen, size_t* bytesRead) {
     if (!isAvailable()) return false;
+    SDLock lock;
 
     char pathBuffer[256];
     const char* fullPath = buildPath(path, pathBuffer, sizeof(pathBuffer));
@@ -194,6 +811,7 @@ bool readFile(const char* path, uint8_t* buffer, size_t maxLen, size_t* bytesRea
 
 bool fileExists(const char* path) {
     if (!isAvailable()) return false;
+    SDLock lock;
 
     char pathBuffer[256];
     const char* fullPath = buildPath(path, pathBuffer, sizeof(pathBuffer));
@@ -202,6 +820,7 @@ bool fileExists(const char* path) {
 
 bool deleteFile(const char* path) {
     if (!isAvailable()) return false;
+    SDLock lock;
 
     char pathBuffer[256];
     const char* fullPath = buildPath(path, pathBuffer, sizeof(pathBuffer));
@@ -210,6 +829,7 @@ bool deleteFile(const char* path) {
 
 size_t getFileSize(const char* path) {
     if (!isAvailable()) return 0;
+    SDLock lock;
 
     char pathBuffer[256];
     const char* fullPath = buildPath(path, pathBuffer, sizeof(pathBuffer));
@@ -225,32 +845,40 @@ size_t getFileSize(const char* path) {
 
 bool createDir(const char* path) {
     if (!isAvailable()) return false;
+    SDLock lock;
 
     char pathBuffer[256];
     const char* fullPath = buildPath(path, pathBuffer, sizeof(pathBuffer));
 
-    // SPIFFS doesn't support directories, just return true
     if (!sdAvailable) {
+#ifdef MESHBERRY_FLASH_SPIFFS
+        // SPIFFS doesn't support directories, just return true
         return true;
+#else
+        if (flashOnSpiffs) return true;
+        return FLASH_FS.exists(fullPath) || FLASH_FS.mkdir(fullPath);
+#endif
     }
 
     return SD.mkdir(fullPath);
 }
 
 size_t getAvailableSpace() {
+    SDLock lock;
     if (sdAvailable) {
         return SD.totalBytes() - SD.usedBytes();
-    } else if (spiffsAvailable) {
-        return SPIFFS.totalBytes() - SPIFFS.usedBytes();
+    } else if (flashAvailable) {
+        return flashTotalBytes() - flashUsedBytes();
     }
     return 0;
 }
 
 size_t getTotalSpace() {
+    SDLock lock;
     if (sdAvailable) {
         return SD.totalBytes();
-    } else if (spiffsAvailable) {
-        return SPIFFS.totalBytes();
+    } else if (flashAvailable) {
+        return flashTotalBytes();
     }
     return 0;
 }
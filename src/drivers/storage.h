@@ -4,7 +4,13 @@
  * SPDX-License-Identifier: GPL-3.0-or-later
  * Copyright (C) 2026 NodakMesh (nodakmesh.org)
  *
- * Unified storage abstraction with SD card primary and SPIFFS fallback.
+ * Unified storage abstraction with SD card primary and internal flash fallback.
+ *
+ * Internal flash uses LittleFS. Devices still formatted with SPIFFS are
+ * migrated once at boot, but only with an SD card to hold a second copy;
+ * without one they stay on SPIFFS and retry on a later boot. Build with
+ * -DMESHBERRY_FLASH_SPIFFS to keep the SPIFFS backend (for filesystem
+ * benchmarks or rollback).
  */
 
 #ifndef MESHBERRY_STORAGE_H
@@ -12,22 +18,69 @@
 
 #include <Arduino.h>
 
+#ifdef MESHBERRY_FLASH_SPIFFS
+  #include <SPIFFS.h>
+  #define FLASH_FS       SPIFFS
+  #define FLASH_FS_NAME  "SPIFFS"
+#else
+  #include <LittleFS.h>
+  #include <SPIFFS.h>
+  // LittleFS, or SPIFFS while a migration waits for an SD card
+  #define FLASH_FS       Storage::flashFS()
+  #define FLASH_FS_NAME  Storage::flashFSName()
+#endif
+
 namespace Storage {
 
+#ifndef MESHBERRY_FLASH_SPIFFS
+/**
+ * Filesystem mounted on internal flash (use the FLASH_FS macro)
+ */
+fs::FS& flashFS();
+
+/**
+ * Name of the flash filesystem (use the FLASH_FS_NAME macro)
+ */
+const char* flashFSName();
+#endif
+
+/**
+ * Size of the flash filesystem in bytes
+ */
+size_t flashTotalBytes();
+
+/**
+ * Bytes used on the flash filesystem
+ */
+size_t flashUsedBytes();
+
+/**
+ * Unmount and remount the flash filesystem (benchmarks)
+ * Nothing may hold a flash file open. Marks flash unavailable on failure.
+ * @return true if flash is mounted afterwards
+ */
+bool remountFlash();
+
 /**
  * Initialize storage system
- * Attempts to mount SD card first, falls back to SPIFFS if unavailable
+ * Mounts the SD card and internal flash (migrating SPIFFS to LittleFS on
+ * first boot). Must run before SettingsManager::init().
  * @return true if at least one storage medium is available
  */
 bool init();
 
+/**
+ * Check if internal flash (FLASH_FS) is mounted
+ */
+bool isFlashAvailable();
+
 /**
  * Check if SD card is currently available and mounted
  */
 bool isSDAvailable();
 
 /**
- * Check if any storage is available (SD or SPIFFS)
+ * Check if any storage is available (SD or internal flash)
  */
 bool isAvailable();
 
@@ -36,6 +89,72 @@ bool isAvailable();
  */
 const char* getStorageType();
 
+// =============================================================================
+// SD CLOCK
+// =============================================================================
+//
+// The card is mounted at SD_SPI_FREQ_SAFE, then moved straight to the clock
+// saved on the card by a previous tune. A new card is tuned: sectors spread
+// over the card are read at the safe clock, then the clock is stepped up
+// until a re-read of those sectors fails its CRC compare, and the fastest
+// passing rate is saved. Tuning only reads, nothing is written at an
+// unverified rate. A read or write error at runtime steps the saved rate
+// down one notch, and the next mount probes it before using it.
+
+/**
+ * Current SD SPI clock in Hz (0 if no card)
+ */
+uint32_t getSDClock();
+
+/**
+ * Re-run clock tuning now and save the result
+ * Remounts the card: close every open SD file first.
+ * @return true if the card is mounted afterwards
+ */
+bool tuneSDClock();
+
+/**
+ * Record an SD read/write failure seen outside this driver
+ */
+void reportSDError();
+
+/**
+ * SD errors since boot
+ */
+uint32_t getSDErrorCount();
+
+// =============================================================================
+// SD LOCK
+// =============================================================================
+//
+// Every filesystem call in Storage, MessageArchive, the audio driver and
+// the font loader holds this lock. It is recursive, so a holder can call
+// Storage functions. All of them run on the loop task today; the lock keeps
+// any future background user serialised against them. It does not guard
+// the SPI pins the card shares with the display and radio, so the card must
+// still only be driven from the loop task.
+
+/**
+ * Take the SD lock (blocks; no-op before init())
+ */
+void lockSD();
+
+/**
+ * Release the SD lock
+ */
+void unlockSD();
+
+/**
+ * Holds the SD lock until the end of the scope
+ */
+class SDLock {
+public:
+    SDLock() { lockSD(); }
+    ~SDLock() { unlockSD(); }
+    SDLock(const SDLock&) = delete;
+    SDLock& operator=(const SDLock&) = delete;
+};
+
 /**
  * Write data to file
  * @param path File path (will be prefixed with appropriate root)
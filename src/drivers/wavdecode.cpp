@@ -0,0 +1,242 @@
+/**
+ * MeshBerry WAV Decoder Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "wavdecode.h"
+#include <string.h>
+
+namespace Wav {
+
+// =============================================================================
+// IMA-ADPCM TABLES
+// =============================================================================
+
+static const int8_t IMA_INDEX_TABLE[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const int16_t IMA_STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static inline uint16_t rd16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t rd32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline int16_t imaStep(uint8_t nibble, int32_t& predictor, int& index) {
+    int32_t step = IMA_STEP_TABLE[index];
+    int32_t diff = step >> 3;
+    if (nibble & 1) diff += step >> 2;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 4) diff += step;
+    if (nibble & 8) diff = -diff;
+
+    predictor += diff;
+    if (predictor > 32767) predictor = 32767;
+    else if (predictor < -32768) predictor = -32768;
+
+    index += IMA_INDEX_TABLE[nibble];
+    if (index < 0) index = 0;
+    else if (index > 88) index = 88;
+
+    return (int16_t)predictor;
+}
+
+// =============================================================================
+// HEADER
+// =============================================================================
+
+bool parseHeader(Reader& reader, Info& info) {
+    memset(&info, 0, sizeof(info));
+
+    uint8_t riff[12];
+    if (reader.read(riff, sizeof(riff)) != sizeof(riff)) return false;
+    if (memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) return false;
+
+    uint32_t pos = sizeof(riff);
+    bool haveFmt = false;
+
+    // Walk the chunk list; LIST/fact/etc. are skipped
+    while (true) {
+        uint8_t hdr[8];
+        if (reader.read(hdr, sizeof(hdr)) != sizeof(hdr)) return false;
+        pos += sizeof(hdr);
+        uint32_t size = rd32(hdr + 4);
+
+        if (memcmp(hdr, "fmt ", 4) == 0) {
+            uint8_t fmt[20];
+            if (size < 16) return false;
+            size_t want = size < sizeof(fmt) ? size : sizeof(fmt);
+            if (reader.read(fmt, want) != want) return false;
+
+            info.format = rd16(fmt);
+            info.channels = rd16(fmt + 2);
+            info.sampleRate = rd32(fmt + 4);
+            info.blockAlign = rd16(fmt + 12);
+            info.bitsPerSample = rd16(fmt + 14);
+            if (info.format == WAV_FORMAT_IMA_ADPCM && want >= 20) {
+                info.samplesPerBlock = rd16(fmt + 18);
+            }
+
+            // Chunks are word aligned
+            uint32_t rest = size - want + (size & 1);
+            if (rest && !reader.skip(rest)) return false;
+            pos += size + (size & 1);
+            haveFmt = true;
+        } else if (memcmp(hdr, "data", 4) == 0) {
+            if (!haveFmt) return false;
+            info.dataOffset = pos;
+            info.dataSize = size;
+            break;
+        } else {
+            uint32_t skip = size + (size & 1);
+            if (!reader.skip(skip)) return false;
+            pos += skip;
+        }
+    }
+
+    if (info.channels < 1 || info.channels > 2) return false;
+    if (info.sampleRate < WAV_MIN_SAMPLE_RATE || info.sampleRate > WAV_MAX_SAMPLE_RATE) return false;
+
+    switch (info.format) {
+        case WAV_FORMAT_PCM:
+            if (info.bitsPerSample != 8 && info.bitsPerSample != 16) return false;
+            info.blockAlign = info.channels * (info.bitsPerSample / 8);
+            return true;
+
+        case WAV_FORMAT_IMA_ADPCM:
+            if (info.bitsPerSample != 4) return false;
+            if (info.blockAlign <= 4 * info.channels || info.blockAlign > WAV_MAX_BLOCK_ALIGN) return false;
+            if ((info.blockAlign % (4 * info.channels)) != 0) return false;
+            info.samplesPerBlock = (info.blockAlign - 4 * info.channels) * 2 / info.channels + 1;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+const char* formatName(const Info& info) {
+    switch (info.format) {
+        case WAV_FORMAT_PCM:       return info.bitsPerSample == 8 ? "PCM8" : "PCM16";
+        case WAV_FORMAT_IMA_ADPCM: return "IMA-ADPCM";
+        default:                   return "unknown";
+    }
+}
+
+// =============================================================================
+// DECODER
+// =============================================================================
+
+void Decoder::begin(const Info& info) {
+    _info = info;
+    if (info.format == WAV_FORMAT_IMA_ADPCM) {
+        _chunkBytes = info.blockAlign;
+    } else {
+        // Whole frames only, and never more output than WAV_MAX_CHUNK_SAMPLES
+        size_t frames = WAV_PCM_CHUNK_BYTES / info.blockAlign;
+        if (frames > WAV_MAX_CHUNK_SAMPLES) frames = WAV_MAX_CHUNK_SAMPLES;
+        _chunkBytes = frames * info.blockAlign;
+    }
+}
+
+size_t Decoder::decode(const uint8_t* in, size_t len, int16_t* out, size_t maxOut) {
+    if (_info.format == WAV_FORMAT_IMA_ADPCM) {
+        return decodeAdpcm(in, len, out, maxOut);
+    }
+    return decodePcm(in, len, out, maxOut);
+}
+
+size_t Decoder::decodePcm(const uint8_t* in, size_t len, int16_t* out, size_t maxOut) {
+    size_t frames = len / _info.blockAlign;
+    if (frames > maxOut) frames = maxOut;
+    bool stereo = _info.channels == 2;
+
+    if (_info.bitsPerSample == 8) {
+        // 8-bit WAV is unsigned (multiply, as << of a negative is undefined)
+        for (size_t i = 0; i < frames; i++) {
+            if (stereo) {
+                int32_t l = (int32_t)in[2 * i] - 128;
+                int32_t r = (int32_t)in[2 * i + 1] - 128;
+                out[i] = (int16_t)(((l + r) / 2) * 256);
+            } else {
+                out[i] = (int16_t)(((int32_t)in[i] - 128) * 256);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < frames; i++) {
+            if (stereo) {
+                int32_t l = (int16_t)rd16(in + 4 * i);
+                int32_t r = (int16_t)rd16(in + 4 * i + 2);
+                out[i] = (int16_t)((l + r) / 2);
+            } else {
+                out[i] = (int16_t)rd16(in + 2 * i);
+            }
+        }
+    }
+    return frames;
+}
+
+size_t Decoder::decodeAdpcm(const uint8_t* in, size_t len, int16_t* out, size_t maxOut) {
+    const size_t ch = _info.channels;
+    if (len <= 4 * ch) return 0;
+
+    // A short final block holds fewer 4-byte groups per channel
+    size_t groups = (len - 4 * ch) / (4 * ch);
+    size_t count = groups * 8 + 1;
+    if (count > maxOut) return 0;
+
+    for (size_t c = 0; c < ch; c++) {
+        const uint8_t* hdr = in + 4 * c;
+        int32_t predictor = (int16_t)rd16(hdr);
+        int index = hdr[2] > 88 ? 88 : hdr[2];
+
+        // Header sample, then 8 nibbles (low first) per group, channels interleaved by group
+        int16_t* o = out;
+        int16_t s = (int16_t)predictor;
+        if (c == 0) *o = s; else *o = (int16_t)(((int32_t)*o + s) / 2);
+        o++;
+
+        const uint8_t* data = in + 4 * ch + 4 * c;
+        for (size_t g = 0; g < groups; g++, data += 4 * ch) {
+            for (int b = 0; b < 4; b++) {
+                uint8_t byte = data[b];
+                int16_t lo = imaStep(byte & 0x0F, predictor, index);
+                int16_t hi = imaStep(byte >> 4, predictor, index);
+                if (c == 0) {
+                    o[0] = lo;
+                    o[1] = hi;
+                } else {
+                    o[0] = (int16_t)(((int32_t)o[0] + lo) / 2);
+                    o[1] = (int16_t)(((int32_t)o[1] + hi) / 2);
+                }
+                o += 2;
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace Wav
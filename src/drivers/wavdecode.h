@@ -0,0 +1,121 @@
+/**
+ * MeshBerry WAV Decoder
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * RIFF/WAVE header parsing and chunk decoding of PCM (8/16-bit) and
+ * IMA-ADPCM (format 0x11) to 16-bit mono samples for the speaker.
+ *
+ * The decoder works on fixed input chunks handed to it by the caller,
+ * so a file is streamed without ever being held in RAM. It has no
+ * Arduino or filesystem dependencies and builds on a host as well.
+ */
+
+#ifndef MESHBERRY_WAV_DECODE_H
+#define MESHBERRY_WAV_DECODE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Wav {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr uint16_t WAV_FORMAT_PCM        = 0x0001;
+constexpr uint16_t WAV_FORMAT_IMA_ADPCM  = 0x0011;
+
+constexpr size_t   WAV_PCM_CHUNK_BYTES   = 2048;    // Input per PCM decode step
+constexpr uint16_t WAV_MAX_BLOCK_ALIGN   = 2048;    // Largest ADPCM block accepted
+constexpr uint32_t WAV_MIN_SAMPLE_RATE   = 4000;
+constexpr uint32_t WAV_MAX_SAMPLE_RATE   = 48000;
+
+/**
+ * Output samples needed for any single decode() step
+ * (a full ADPCM block: 8 samples per 4 bytes after a 4 byte header, plus one)
+ */
+constexpr size_t   WAV_MAX_CHUNK_SAMPLES = (WAV_MAX_BLOCK_ALIGN - 4) * 2 + 1;
+
+/**
+ * Stream format from the "fmt " chunk, and the location of "data"
+ */
+struct Info {
+    uint16_t format;
+    uint16_t channels;
+    uint32_t sampleRate;
+    uint16_t bitsPerSample;
+    uint16_t blockAlign;        // Bytes per frame (PCM) or per block (ADPCM)
+    uint16_t samplesPerBlock;   // ADPCM only, per channel
+    uint32_t dataOffset;        // File offset of the first sample byte
+    uint32_t dataSize;          // Bytes of sample data
+};
+
+/**
+ * Sequential byte source for header parsing (file, memory, ...)
+ */
+class Reader {
+public:
+    virtual ~Reader() = default;
+
+    // Read up to len bytes, returns bytes read (0 at end)
+    virtual size_t read(uint8_t* buf, size_t len) = 0;
+
+    // Skip forward len bytes
+    virtual bool skip(uint32_t len) = 0;
+};
+
+// =============================================================================
+// API
+// =============================================================================
+
+/**
+ * Parse the RIFF header up to the start of the data chunk
+ * Leaves the reader positioned on the first sample byte.
+ * @return false if the file is not a WAV this decoder can play
+ */
+bool parseHeader(Reader& reader, Info& info);
+
+/**
+ * Human-readable format name for logs
+ */
+const char* formatName(const Info& info);
+
+/**
+ * Chunk decoder - feed it inputChunkSize() bytes at a time
+ * (the final chunk of a file may be shorter)
+ */
+class Decoder {
+public:
+    void begin(const Info& info);
+
+    /**
+     * Bytes to read for the next decode() step: one ADPCM block, or a
+     * whole number of PCM frames
+     */
+    size_t inputChunkSize() const { return _chunkBytes; }
+
+    /**
+     * Decode one chunk to mono 16-bit samples (stereo is averaged)
+     * @param in Input bytes
+     * @param len Bytes in the chunk
+     * @param out Output buffer
+     * @param maxOut Capacity of out in samples
+     * @return Samples written
+     */
+    size_t decode(const uint8_t* in, size_t len, int16_t* out, size_t maxOut);
+
+private:
+    size_t decodePcm(const uint8_t* in, size_t len, int16_t* out, size_t maxOut);
+    size_t decodeAdpcm(const uint8_t* in, size_t len, int16_t* out, size_t maxOut);
+
+    Info _info;
+    size_t _chunkBytes = 0;
+};
+
+} // namespace Wav
+
+#endif // MESHBERRY_WAV_DECODE_H
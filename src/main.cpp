@@ -26,7 +26,6 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <SPI.h>
-#include <SPIFFS.h>
 #include <driver/gpio.h>
 #include <soc/gpio_reg.h>  // For direct GPIO register read (GPIO 0 workaround)
 #include <esp_task_wdt.h>
@@ -46,13 +45,19 @@
 
 // MeshCore integration
 #include <RadioLib.h>
-#include <helpers/SimpleMeshTables.h>
 #include <helpers/StaticPoolPacketManager.h>
 #include <helpers/radiolib/CustomSX1262.h>
 
 // Mesh application - use our own wrapper for RadioLib 7.x compatibility
 #include "mesh/MeshBerrySX1262Wrapper.h"
+#include "mesh/MeshBerrySeenTable.h"
 #include "mesh/MeshBerryMesh.h"
+#include "mesh/RoutePlanner.h"
+#include "mesh/TimeSync.h"
+#include "mesh/BandSurvey.h"
+#include "mesh/PositionBeacon.h"
+#include "mesh/ForwardLimiter.h"
+#include "mesh/RelayStats.h"
 
 // Settings
 #include "settings/RadioSettings.h"
@@ -62,6 +67,8 @@
 
 // Drivers
 #include "drivers/storage.h"
+#include "drivers/flashbench.h"
+#include "drivers/sdbench.h"
 
 // New UI system
 #include "ui/Theme.h"
@@ -81,7 +88,13 @@
 #include "ui/RepeaterCLIScreen.h"
 #include "ui/DMChatScreen.h"
 #include "ui/DMSettingsScreen.h"
+#include "ui/TopologyScreen.h"
+#include "ui/TraceScreen.h"
+#include "ui/SurveyScreen.h"
+#include "ui/RelayScreen.h"
 #include "ui/BootLogo.h"
+#include "ui/Notifier.h"
+#include "ui/Font.h"
 
 // =============================================================================
 // GLOBAL OBJECTS
@@ -98,7 +111,7 @@ MeshBerrySX1262Wrapper* radioWrapper = nullptr;  // Non-static - accessed by pow
 // Mesh components
 static ESP32RNG rng;
 static ESP32RTCClock rtcClock;
-static SimpleMeshTables meshTables;
+static MeshBerrySeenTable meshTables;
 static StaticPoolPacketManager packetMgr(32);  // Pool size of 32 packets
 MeshBerryMesh* theMesh = nullptr;  // Non-static - accessed by ChatScreen
 
@@ -143,6 +156,10 @@ DMChatScreen dmChatScreen;  // Non-static - accessed by ContactsScreen
 DMSettingsScreen dmSettingsScreen;  // Non-static - accessed by DMChatScreen
 static AboutScreen aboutScreen;
 EmojiPickerScreen emojiPickerScreen;  // Non-static - accessed by ChatScreen
+static TopologyScreen topologyScreen;
+static TraceScreen traceScreen;
+static SurveyScreen surveyScreen;
+static RelayScreen relayScreen;
 
 // CLI state
 static char cmdBuffer[128] = "";
@@ -168,6 +185,10 @@ void onChannelMessage(int channelIdx, const char* senderAndText, uint32_t timest
 void onDMReceived(uint32_t senderId, const char* senderName, const char* text, uint32_t timestamp);
 void onDMDeliveryStatus(uint32_t contactId, uint32_t ack_crc, bool delivered, uint8_t attempts);
 void onChannelRepeat(int channelIdx, uint32_t contentHash, uint8_t repeatCount);
+void onReaction(int channelIdx, uint32_t contactId);
+void onChannelHistoryRecord(int channelIdx, const char* senderAndText, uint32_t timestamp);
+void onTraceComplete(const TraceRoute::Report& report);
+void updateUnreadBadges();
 
 // =============================================================================
 // HELPER FUNCTIONS
@@ -208,6 +229,29 @@ uint32_t makeUnixTime(uint16_t year, uint8_t month, uint8_t day,
     return days * 86400UL + hour * 3600UL + minute * 60UL + second;
 }
 
+/**
+ * Parse a comma-separated list of hex path hashes ("AB,CD,EF")
+ * @return Number of hashes parsed, or 0 if the text is not a hash list
+ */
+int parseHashList(const char* text, uint8_t* out, int maxOut) {
+    int count = 0;
+    const char* p = text;
+    while (*p && count < maxOut) {
+        char* end = nullptr;
+        long value = strtol(p, &end, 16);
+        if (end != p + 2 || value < 0 || value > 0xFF) return 0;
+        out[count++] = (uint8_t)value;
+        if (*end == ',') {
+            p = end + 1;
+        } else if (*end == '\0') {
+            break;
+        } else {
+            return 0;
+        }
+    }
+    return count;
+}
+
 // =============================================================================
 // SETUP
 // =============================================================================
@@ -262,28 +306,27 @@ void setup() {
     Serial.printf("  Wake reason: %s\n", Power::getWakeReasonString());
     Serial.println();
 
-    // Initialize file system
-    if (!SPIFFS.begin(true)) {
-        Serial.println("[INIT] SPIFFS mount failed");
-    } else {
-        Serial.println("[INIT] SPIFFS mounted");
-    }
+    // Initialize storage driver (SD card, internal flash with one-time
+    // SPIFFS -> LittleFS migration)
+    Storage::init();
+    // A benchmark cut short by a reset leaves flash nearly full
+    FlashBench::removeLeftovers();
+    Serial.printf("[INIT] Storage: %s (%d KB free)\n",
+                  Storage::getStorageType(),
+                  Storage::getAvailableSpace() / 1024);
 
-    // Initialize settings manager (loads from SPIFFS or uses defaults)
+    // Initialize settings manager (loads from flash or uses defaults)
     SettingsManager::init();
     RadioSettings& settings = SettingsManager::getRadioSettings();
     Serial.printf("  Region: %s\n", settings.getRegionName());
     Serial.printf("  LoRa Freq: %.3f MHz\n", settings.frequency);
 
-    // Initialize storage driver (SD card with SPIFFS fallback)
-    Storage::init();
-    Serial.printf("[INIT] Storage: %s (%d KB free)\n",
-                  Storage::getStorageType(),
-                  Storage::getAvailableSpace() / 1024);
-
     // Initialize message archive
     MessageArchive::init();
 
+    // Open Unicode font faces (SD, then flash; optional)
+    Font::init();
+
     // Initialize hardware
     initHardware();
 
@@ -351,6 +394,7 @@ void loop() {
 
         if (freeHeap < 5000) {  // Critical low memory (< 5KB)
             Serial.println("[MEM] CRITICAL LOW MEMORY - Forcing restart to prevent crash");
+            MessageArchive::flush();
             Serial.flush();
             delay(1000);
             ESP.restart();
@@ -370,6 +414,18 @@ void loop() {
         }
     }
 
+    // Band survey slice (no-op unless a sweep is running)
+    BandSurvey::process();
+
+    // Refill the speaker stream from SD (no-op unless a file is playing)
+    Audio::process();
+
+    // Group-commit queued archive saves
+    MessageArchive::maintain();
+
+    // One tone/toast/badge update per burst of messages
+    Notifier::process();
+
     // Update GPS and status bar fix indicator
     if (gpsPresent) {
         GPS::update();
@@ -387,13 +443,13 @@ void loop() {
                 // Real GPS time should be year >= 2024
                 if (year >= 2024 && month >= 1 && month <= 12 && day >= 1 && day <= 31) {
                     uint32_t gpsEpoch = makeUnixTime(year, month, day, hour, minute, second);
-                    rtcClock.setCurrentTime(gpsEpoch);
+                    rtcClock.setCurrentTime(gpsEpoch, TIME_SOURCE_GPS);
                     rtcSyncedFromGps = true;
                     Serial.printf("[RTC] Synced from GPS: %u (UTC %04d-%02d-%02d %02d:%02d:%02d)\n",
                                   gpsEpoch, year, month, day, hour, minute, second);
 
                     // Disable GPS after sync if user doesn't want it always on
-                    if (!deviceSettings.gpsEnabled) {
+                    if (!deviceSettings.gpsEnabled && !deviceSettings.posShareEnabled) {
                         GPS::disable();
                         Serial.println("[GPS] Disabled after RTC sync (power save)");
                     }
@@ -401,6 +457,17 @@ void loop() {
             }
         }
 
+        // Position beacon check (sends only when off the dead-reckoned track)
+        if (theMesh && GPS::isEnabled() && GPS::hasFix()) {
+            PositionBeacon::Fix fix;
+            fix.lat = GPS::getLatitude();
+            fix.lon = GPS::getLongitude();
+            fix.speedMps = GPS::getSpeed() / 3.6f;
+            fix.courseDeg = GPS::getCourse();
+            fix.altM = (int16_t)GPS::getAltitude();
+            theMesh->updatePosition(fix, GPS::getHDOP());
+        }
+
         // Update status bar GPS fix status every second
         static uint32_t lastGpsUiUpdate = 0;
         if (millis() - lastGpsUiUpdate > 1000) {
@@ -483,6 +550,8 @@ void loop() {
     uint32_t screenTimeout = 30;
 
     // sleepTimeoutSecs = 0 disables sleep
+    // updatePowerState() blocks inside the sleep loop, so a long call means we just woke
+    uint32_t powerCallStart = millis();
     Power::updatePowerState(
         screenTimeout,
         devicePower.sleepTimeoutSecs,
@@ -490,6 +559,12 @@ void loop() {
         10,  // minWakeSecs - 10 seconds min wake for LoRa processing
         devicePower.wakeOnLoRa
     );
+    if (millis() - powerCallStart > 5000 && theMesh) {
+        // Catch up on channel traffic missed while asleep
+        theMesh->requestHistorySync();
+        // Neighbours may have changed while we slept
+        theMesh->requestDiscovery();
+    }
 
     // Handle serial CLI commands
     handleSerialCLI();
@@ -695,6 +770,9 @@ bool initRadio() {
     radioWrapper = new MeshBerrySX1262Wrapper(*radio, board);
     radioWrapper->begin();
 
+    // Band survey borrows the radio between mesh packets
+    BandSurvey::init(new SX1262SurveyRadio(*radio, *radioWrapper, LORA_FREQ));
+
     Serial.println("[INIT] Radio: OK");
     return true;
 }
@@ -718,6 +796,10 @@ bool initMesh() {
     theMesh->setDMCallback(onDMReceived);
     theMesh->setDeliveryCallback(onDMDeliveryStatus);
     theMesh->setRepeatCallback(onChannelRepeat);
+    theMesh->setReactionCallback(onReaction);
+    theMesh->setHistoryRecordCallback(onChannelHistoryRecord);
+    theMesh->setTraceCallback(onTraceComplete);
+    Notifier::setBadgeCallback(updateUnreadBadges);
 
     // Start theMesh
     if (!theMesh->begin()) {
@@ -728,10 +810,41 @@ bool initMesh() {
     // Set node name
     theMesh->setNodeName("MeshBerry");
 
+    // Channel history reconciliation is opt-in
+    theMesh->setHistorySyncEnabled(SettingsManager::getDeviceSettings().historySyncEnabled);
+
+    // Position beacons are opt-in too
+    DeviceSettings& posSettings = SettingsManager::getDeviceSettings();
+    theMesh->setPositionSharing(posSettings.posShareEnabled, posSettings.posShareChannel,
+                                posSettings.posShareThresholdM);
+
+    // Channel send coalescing is opt-in
+    theMesh->setChannelCoalesceWindow(SettingsManager::getDeviceSettings().chanCoalesceMs);
+
+    // Channel reactions go compact; text is the fallback for mixed meshes
+    theMesh->setReactionForm(SettingsManager::getDeviceSettings().reactForm);
+
+    // Channel auto-resend is opt-in
+    theMesh->setChannelResend(SettingsManager::getDeviceSettings().chanResend);
+
+    // Which nodes graduate from the discovered cache to contacts
+    theMesh->setContactAdmission(SettingsManager::getDeviceSettings().contactAdmit);
+
+    // Per-source relay budgets
+    DeviceSettings& fwdSettings = SettingsManager::getDeviceSettings();
+    ForwardLimiter::setEnabled(fwdSettings.fwdLimitEnabled);
+    ForwardLimiter::setRate(ForwardLimiter::FL_CLASS_ADVERT, fwdSettings.fwdRateAdvert);
+    ForwardLimiter::setRate(ForwardLimiter::FL_CLASS_CHANNEL, fwdSettings.fwdRateChannel);
+    ForwardLimiter::setRate(ForwardLimiter::FL_CLASS_PEER, fwdSettings.fwdRatePeer);
+    ForwardLimiter::setRate(ForwardLimiter::FL_CLASS_OTHER, fwdSettings.fwdRateOther);
+
     // Send initial advertisement
     theMesh->sendAdvertisement();
     lastAdvertTime = millis();
 
+    // Learn direct neighbours now rather than waiting for their adverts
+    theMesh->requestDiscovery(2000);
+
     Serial.println("[INIT] Mesh: OK");
     return true;
 }
@@ -798,6 +911,10 @@ void initUI() {
     Screens.registerScreen(&_repeaterCLIScreen);
     Screens.registerScreen(&aboutScreen);
     Screens.registerScreen(&emojiPickerScreen);
+    Screens.registerScreen(&topologyScreen);
+    Screens.registerScreen(&traceScreen);
+    Screens.registerScreen(&surveyScreen);
+    Screens.registerScreen(&relayScreen);
 
     // Note: repeaterAdminScreen.setMesh() is called after initMesh() in setup()
 
@@ -891,19 +1008,13 @@ void onMessageReceived(const Message& msg) {
     Serial.printf("[MSG] From %08X: %s\n", msg.senderId, msg.text);
 
     // Direct messages (non-channel) are handled here
-    // Note: Channel messages go through onChannelMessage callback instead
-
-    // Play configurable notification sound
-    DeviceSettings& settings = SettingsManager::getDeviceSettings();
-    Audio::playAlertTone(settings.toneMessage);
+    // Note: Channel messages go through onChannelMessage callback instead.
+    // They, and our own sends, also land here with senderId 0 - skip them
+    if (msg.isOutgoing || msg.senderId == 0) return;
 
-    // Show notification in status bar
-    Screens.showStatus("New message!", 3000);
-
-    // Update notification count and badge
-    int unread = MessagesScreen::getUnreadCount();
-    Screens.setNotificationCount(unread);
-    homeScreen.setBadge(HOME_MESSAGES, unread);
+    char sender[12];
+    snprintf(sender, sizeof(sender), "%08X", msg.senderId);
+    Notifier::postDirectMessage(sender);
 }
 
 void onChannelMessage(int channelIdx, const char* senderAndText, uint32_t timestamp, uint8_t hops) {
@@ -912,25 +1023,15 @@ void onChannelMessage(int channelIdx, const char* senderAndText, uint32_t timest
     // Route to MessagesScreen (handles conversation tracking AND forwards to ChatScreen with hops)
     MessagesScreen::onChannelMessage(channelIdx, senderAndText, timestamp, hops);
 
-    // Play configurable notification sound
-    DeviceSettings& settings = SettingsManager::getDeviceSettings();
-    Audio::playAlertTone(settings.toneMessage);
-
-    // Show notification in status bar
-    Screens.showStatus("New message!", 3000);
-
-    // Update notification count and badge
-    int unread = MessagesScreen::getUnreadCount();
-    Screens.setNotificationCount(unread);
-    homeScreen.setBadge(HOME_MESSAGES, unread);
+    // Tone, toast and badges are coalesced per burst
+    Notifier::postChannelMessage(channelIdx);
 }
 
 void onNodeDiscovered(const NodeInfo& node) {
     Serial.printf("[NODE] Discovered: %s (type=%d, RSSI: %d)\n", node.name, node.type, node.rssi);
 
-    // Play configurable connect sound
-    DeviceSettings& settings = SettingsManager::getDeviceSettings();
-    Audio::playAlertTone(settings.toneNodeConnect);
+    // Connect sound, once per burst of adverts
+    Notifier::postNodeDiscovered();
 
     // Note: Contact saving with pubKey is handled in MeshBerryMesh::onAdvertRecv
     // StatusScreen will show updated node count on next draw
@@ -985,25 +1086,13 @@ void onDMReceived(uint32_t senderId, const char* senderName, const char* text, u
     // Save DMs to persist the new message
     SettingsManager::saveDMs();
 
-    // Play configurable notification sound
-    DeviceSettings& settings = SettingsManager::getDeviceSettings();
-    Audio::playAlertTone(settings.toneMessage);
-
     // If DMChatScreen is open for this contact, update it
     if (Screens.getCurrentScreenId() == ScreenId::DM_CHAT) {
         DMChatScreen::addToCurrentChat(senderId, text, timestamp);
     }
 
-    // Show notification
-    char notifyMsg[48];
-    snprintf(notifyMsg, sizeof(notifyMsg), "DM from %s", senderName ? senderName : "Unknown");
-    Screens.showStatus(notifyMsg, 3000);
-
-    // Update notification count - count total unread DMs
-    int unread = dms.getTotalUnreadCount();
-    if (unread > 0) {
-        Screens.setNotificationCount(unread);
-    }
+    // Tone, "DM from" toast and badges are coalesced per burst
+    Notifier::postDirectMessage(senderName);
 }
 
 void onDMDeliveryStatus(uint32_t contactId, uint32_t ack_crc, bool delivered, uint8_t attempts) {
@@ -1043,6 +1132,51 @@ void onChannelRepeat(int channelIdx, uint32_t contentHash, uint8_t repeatCount)
     ChatScreen::updateRepeatCount(channelIdx, contentHash, repeatCount);
 }
 
+void onReaction(int channelIdx, uint32_t contactId) {
+    // Badges are looked up at draw time; just refresh an open chat
+    if (channelIdx >= 0) {
+        ChatScreen::refreshReactions(channelIdx);
+    } else {
+        DMChatScreen::refreshReactions(contactId);
+    }
+}
+
+void onChannelHistoryRecord(int channelIdx, const char* senderAndText, uint32_t timestamp) {
+    Serial.printf("[SYNC] Ch%d recovered: %s\n", channelIdx, senderAndText);
+
+    // Archive and update conversations like a live message, but without
+    // a tone or toast - these are catch-up messages, not new activity
+    MessagesScreen::onChannelMessage(channelIdx, senderAndText, timestamp, 0);
+
+    Notifier::postUnreadChanged();
+}
+
+void updateUnreadBadges() {
+    int unread = MessagesScreen::getUnreadCount();
+    homeScreen.setBadge(HOME_MESSAGES, unread);
+
+    // Status bar counts unread DMs as well
+    unread += SettingsManager::getDMSettings().getTotalUnreadCount();
+    Screens.setNotificationCount(unread);
+}
+
+void onTraceComplete(const TraceRoute::Report& report) {
+    Serial.printf("=== %s report ===\n", report.pingOnly ? "Ping" : "Trace");
+    Serial.println("Hop  Hash  Avg RTT  Min/Max      +Hop   SNR    Loss");
+    int first = report.pingOnly ? report.hopCount - 1 : 0;
+    for (int i = first; i < report.hopCount; i++) {
+        const TraceRoute::HopStats& h = report.hops[i];
+        if (h.received == 0) {
+            Serial.printf("%-4d %02X    *                                   100%% (%d sent)\n",
+                          i + 1, h.hash, h.sent);
+            continue;
+        }
+        Serial.printf("%-4d %02X    %5.0fms  %4u/%-4ums  %5.0fms %5.1f  %3d%%\n",
+                      i + 1, h.hash, h.avgRttMs(), h.rttMinMs, h.rttMaxMs,
+                      report.hopLatencyMs(i), h.avgSnr(), h.lossPercent());
+    }
+}
+
 // =============================================================================
 // SERIAL CLI
 // =============================================================================
@@ -1082,11 +1216,34 @@ void processCommand(const char* cmd) {
         Serial.println("MeshBerry CLI Commands:");
         Serial.println("  help              - Show this help");
         Serial.println("  status            - Show node status");
-        Serial.println("  nodes             - List all known nodes");
+        Serial.println("  nodes             - List contacts");
+        Serial.println("  heard             - List discovered nodes that are not contacts");
+        Serial.println("  add <name>        - Add a discovered node to contacts");
+        Serial.println("  admit [rule on|off] - Contact admission rules (dm|repeaters|adverts)");
         Serial.println("  repeaters         - List known repeaters");
         Serial.println("  advert            - Send advertisement now");
+        Serial.println("  discover          - Find direct neighbours (zero-hop)");
+        Serial.println("  survey            - Show survey results (starts one if none)");
+        Serial.println("  survey <dwell> [passes] - Sweep band noise floor (dwell ms/channel)");
+        Serial.println("  survey stop       - Stop a band survey");
         Serial.println("  name <name>       - Set node name");
         Serial.println("  forward on|off    - Toggle packet forwarding");
+        Serial.println("  sync [on|off|now] - Channel history sync with neighbours");
+        Serial.println("  coalesce [ms|off] - Merge channel lines sent within ms into one packet");
+        Serial.println("  react [text|compact] - Channel reaction form and airtime used");
+        Serial.println("  resend [on|off]   - Resend channel packets nobody was heard relaying");
+        Serial.println("  rxq [on|off|reset] - RX triage lanes and queue wait times");
+        Serial.println("  fastfwd [on|off|reset] - Cut-through flood forwarding and latency saved");
+        Serial.println("  fwdlimit [on|off|reset] - Per-source relay budgets and offenders");
+        Serial.println("  fwdlimit <class> <n> - Relays/min per source (advert|channel|peer|other, 0=off)");
+        Serial.println("  archive [flush]   - Message archive group commit counters");
+        Serial.println("  mute [n]          - List channels / toggle notifications for channel n");
+        Serial.println("  topo [save|clear] - Learned mesh topology (links by path hash)");
+        Serial.println("  relays [save|clear] - Repeaters carrying our channel messages");
+        Serial.println("  route <name>      - Show planned route to a contact");
+        Serial.println("  trace <name|AB,CD> [n] - Traceroute via repeaters (n probes/hop)");
+        Serial.println("  ping <name|AB,CD> [n]  - Ping the last repeater on a path");
+        Serial.println("  trace stop        - Cancel running trace/ping");
         Serial.println();
         Serial.println("Repeater Management:");
         Serial.println("  login <name> <pwd>  - Login to repeater");
@@ -1097,11 +1254,24 @@ void processCommand(const char* cmd) {
         Serial.println("  saved               - List saved credentials");
         Serial.println("  clear contacts      - Delete all contacts");
         Serial.println("  dump contacts       - Show raw contacts.json file");
+        Serial.println("  fsbench             - Benchmark internal flash filesystem");
+        Serial.println("  sdbench             - SD and flash read/write throughput");
+        Serial.println("  sdclock [tune]      - Show SD bus clock / re-run clock tuning");
+        Serial.println("  font                - Unicode font faces and glyph cache stats");
+        Serial.println("  play <file.wav>     - Play a WAV from SD (bare names: /meshberry/sounds)");
+        Serial.println("  play stop           - Stop file playback");
         Serial.println();
         Serial.println("Time Management:");
         Serial.println("  time                - Show current RTC time");
         Serial.println("  time <epoch>        - Set RTC to UNIX timestamp");
         Serial.println("  time sync           - Sync RTC from GPS");
+        Serial.println("  timesync            - Show mesh time sync status and sources");
+        Serial.println("  timesync now|reset  - Run a discipline round / forget sources");
+        Serial.println();
+        Serial.println("Position Sharing:");
+        Serial.println("  share               - Beacon status and tracked teammates");
+        Serial.println("  share on <ch> [m]   - Send beacons on private channel ch, report at m metres error");
+        Serial.println("  share off           - Stop sending beacons");
     }
     // status - Show node info
     else if (strcmp(cmd, "status") == 0) {
@@ -1141,11 +1311,11 @@ void processCommand(const char* cmd) {
         ContactSettings& contacts = SettingsManager::getContactSettings();
 
         if (contacts.numContacts == 0) {
-            Serial.println("No nodes discovered yet.");
+            Serial.println("No contacts yet ('heard' lists discovered nodes).");
             return;
         }
 
-        Serial.printf("=== Known Nodes (%d) ===\n", contacts.numContacts);
+        Serial.printf("=== Contacts (%d) ===\n", contacts.numContacts);
         for (int i = 0; i < contacts.numContacts; i++) {
             const ContactEntry* c = contacts.getContact(i);
             if (!c) continue;
@@ -1164,6 +1334,84 @@ void processCommand(const char* cmd) {
                           c->isFavorite ? " *" : "");
         }
     }
+    // heard - Discovered nodes (peer table) that are not contacts
+    else if (strcmp(cmd, "heard") == 0) {
+        if (!theMesh) return;
+        ContactSettings& contacts = SettingsManager::getContactSettings();
+        int shown = 0;
+        uint32_t now = rtcClock.getCurrentTime();
+
+        Serial.printf("=== Discovered Nodes (%d tracked) ===\n", theMesh->getNodeCount());
+        NodeInfo node;
+        for (int c = theMesh->firstNode(node); c != MeshBerryMesh::NODE_END; c = theMesh->nextNode(c, node)) {
+            if (node.lastHeard == 0 || contacts.findContact(node.id) >= 0) continue;
+
+            char typeChar = '?';
+            switch (node.type) {
+                case NODE_TYPE_CHAT:     typeChar = 'C'; break;
+                case NODE_TYPE_REPEATER: typeChar = 'R'; break;
+                case NODE_TYPE_ROOM:     typeChar = 'S'; break;
+                case NODE_TYPE_SENSOR:   typeChar = 'X'; break;
+                default: break;
+            }
+            uint32_t ago = now > node.lastHeard ? now - node.lastHeard : 0;
+            Serial.printf("[%c] %-16s  ID:%08X  RSSI:%4d  SNR:%.1f  %lum ago\n",
+                          typeChar, node.name, node.id, node.rssi, node.snr,
+                          (unsigned long)(ago / 60));
+            shown++;
+        }
+        if (shown == 0) {
+            Serial.println("  None - every node heard is already a contact.");
+        }
+    }
+    // add <name> - Promote a discovered node to contacts
+    else if (strncmp(cmd, "add ", 4) == 0) {
+        const char* name = cmd + 4;
+        while (*name == ' ') name++;
+
+        NodeInfo node;
+        if (!theMesh || !theMesh->findNodeByName(name, node)) {
+            Serial.printf("No discovered node named '%s'.\n", name);
+            return;
+        }
+        int idx = theMesh->promoteToContact(node.id);
+        if (idx >= 0) {
+            Serial.printf("%s is a contact.\n", node.name);
+        } else {
+            Serial.println("Failed to add contact (key unknown, or all contacts are favorites).");
+        }
+    }
+    // admit - Contact admission rules
+    else if (strcmp(cmd, "admit") == 0 || strncmp(cmd, "admit ", 6) == 0) {
+        DeviceSettings& ds = SettingsManager::getDeviceSettings();
+        if (cmd[5] == ' ') {
+            char rule[12] = "";
+            char state[4] = "";
+            sscanf(cmd + 6, "%11s %3s", rule, state);
+
+            uint8_t bit = 0;
+            if (strcmp(rule, "dm") == 0)             bit = CONTACT_ADMIT_DM_RX;
+            else if (strcmp(rule, "repeaters") == 0) bit = CONTACT_ADMIT_REPEATERS;
+            else if (strcmp(rule, "adverts") == 0)   bit = CONTACT_ADMIT_ADVERTS;
+
+            bool on = strcmp(state, "on") == 0;
+            if (!bit || (!on && strcmp(state, "off") != 0)) {
+                Serial.println("Usage: admit <dm|repeaters|adverts> on|off");
+                return;
+            }
+            ds.contactAdmit = on ? (ds.contactAdmit | bit) : (ds.contactAdmit & ~bit);
+            SettingsManager::saveDeviceSettings();
+            if (theMesh) theMesh->setContactAdmission(ds.contactAdmit);
+        }
+
+        Serial.println("Contacts are added when you pick a node or send it a DM, and when:");
+        Serial.printf("  dm         %-3s  it sends you a DM\n",
+                      (ds.contactAdmit & CONTACT_ADMIT_DM_RX) ? "on" : "off");
+        Serial.printf("  repeaters  %-3s  a repeater advertises\n",
+                      (ds.contactAdmit & CONTACT_ADMIT_REPEATERS) ? "on" : "off");
+        Serial.printf("  adverts    %-3s  any node advertises\n",
+                      (ds.contactAdmit & CONTACT_ADMIT_ADVERTS) ? "on" : "off");
+    }
     // repeaters - List only repeaters
     else if (strcmp(cmd, "repeaters") == 0) {
         ContactSettings& contacts = SettingsManager::getContactSettings();
@@ -1237,6 +1485,445 @@ void processCommand(const char* cmd) {
         }
         Serial.println("Usage: forward on|off");
     }
+    // coalesce - Channel send coalescing
+    else if (strcmp(cmd, "coalesce") == 0) {
+        if (theMesh) {
+            const CoalesceStats& st = theMesh->getCoalesceStats();
+            uint16_t window = theMesh->getChannelCoalesceWindow();
+            if (window) {
+                Serial.printf("Coalescing: %u ms window\n", window);
+            } else {
+                Serial.println("Coalescing: off");
+            }
+            Serial.printf("  %lu messages in %lu packets, %lu on-air bytes saved\n",
+                          (unsigned long)st.messages, (unsigned long)st.packets,
+                          (unsigned long)st.bytesSaved);
+        }
+    }
+    else if (strncmp(cmd, "coalesce ", 9) == 0) {
+        int ms = strcmp(cmd + 9, "off") == 0 ? 0 : atoi(cmd + 9);
+        if (ms < 0 || ms > 10000) {
+            Serial.println("Usage: coalesce <0-10000 ms>|off");
+        } else if (theMesh) {
+            theMesh->setChannelCoalesceWindow((uint16_t)ms);
+            SettingsManager::getDeviceSettings().chanCoalesceMs = theMesh->getChannelCoalesceWindow();
+            SettingsManager::saveDeviceSettings();
+        }
+    }
+    // react - Emoji reaction form and counters
+    else if (strcmp(cmd, "react") == 0) {
+        if (theMesh) {
+            const ReactionStats& st = theMesh->getReactionStats();
+            bool compact = theMesh->getReactionForm() == Reaction::REACT_FORM_COMPACT;
+            Serial.printf("Channel reactions: %s\n", compact ? "compact (MeshBerry only)" : "text (all clients)");
+            Serial.printf("  Sent %lu, received %lu\n",
+                          (unsigned long)st.sent, (unsigned long)st.received);
+            Serial.printf("  Sent %lu on-air bytes, %lu as plain emoji replies\n",
+                          (unsigned long)st.sentAirBytes, (unsigned long)st.plainAirBytes);
+            size_t compactBytes = MeshBerryMesh::compactReactionAirBytes();
+            Serial.printf("  Heard %lu emoji-only replies, %lu bytes (%lu as compact reactions)\n",
+                          (unsigned long)st.emojiReplies, (unsigned long)st.emojiReplyBytes,
+                          (unsigned long)(st.emojiReplies * compactBytes));
+        }
+    }
+    else if (strcmp(cmd, "react text") == 0 || strcmp(cmd, "react compact") == 0) {
+        if (theMesh) {
+            uint8_t form = strcmp(cmd + 6, "compact") == 0 ? Reaction::REACT_FORM_COMPACT
+                                                            : Reaction::REACT_FORM_TEXT;
+            theMesh->setReactionForm(form);
+            SettingsManager::getDeviceSettings().reactForm = form;
+            SettingsManager::saveDeviceSettings();
+            Serial.printf("Channel reactions: %s\n", form ? "compact" : "text");
+        }
+    }
+    // resend - Channel auto-resend
+    else if (strcmp(cmd, "resend") == 0) {
+        if (theMesh) {
+            const ResendStats& st = theMesh->getResendStats();
+            uint32_t watched = st.watched ? st.watched : 1;
+            Serial.printf("Channel auto-resend: %s\n", theMesh->getChannelResend() ? "on" : "off");
+            Serial.printf("  Relay window %lu ms (60-byte packet, current radio settings)\n",
+                          (unsigned long)theMesh->channelResendWindow(60));
+            Serial.printf("  Watched %lu: relayed %lu (%lu%%), resent %lu, rescued %lu (%lu%% with resend)\n",
+                          (unsigned long)st.watched, (unsigned long)st.relayed,
+                          (unsigned long)(st.relayed * 100 / watched),
+                          (unsigned long)st.resent, (unsigned long)st.rescued,
+                          (unsigned long)((st.relayed + st.rescued) * 100 / watched));
+            Serial.printf("  %lu on-air bytes resent, %lu duplicate copies dropped\n",
+                          (unsigned long)st.resendAirBytes, (unsigned long)st.duplicates);
+        }
+    }
+    else if (strcmp(cmd, "resend on") == 0 || strcmp(cmd, "resend off") == 0) {
+        if (theMesh) {
+            bool enable = strcmp(cmd, "resend on") == 0;
+            theMesh->setChannelResend(enable);
+            SettingsManager::getDeviceSettings().chanResend = enable;
+            SettingsManager::saveDeviceSettings();
+        }
+    }
+    // rxq - RX triage lanes
+    else if (strcmp(cmd, "rxq on") == 0 || strcmp(cmd, "rxq off") == 0) {
+        if (theMesh) {
+            bool enable = (strcmp(cmd, "rxq on") == 0);
+            theMesh->setRxTriageEnabled(enable);
+            Serial.printf("RX triage %s.\n", enable ? "ENABLED" : "DISABLED (arrival order)");
+        }
+    }
+    else if (strcmp(cmd, "rxq reset") == 0) {
+        if (theMesh) {
+            theMesh->resetRxLaneStats();
+            Serial.println("RX lane stats reset.");
+        }
+    }
+    else if (strcmp(cmd, "rxq") == 0) {
+        if (theMesh) {
+            static const char* laneNames[RX_LANE_COUNT] = { "local", "forward", "advert" };
+            Serial.printf("=== RX triage: %s ===\n", theMesh->isRxTriageEnabled() ? "ON" : "OFF");
+            Serial.println("  lane     queued bypass  depth  wait avg/max ms  busy avg ms");
+            for (int i = 0; i < RX_LANE_COUNT; i++) {
+                const RxLaneStats& st = theMesh->getRxLaneStats((RxLane)i);
+                uint32_t n = st.processed ? st.processed : 1;
+                Serial.printf("  %-8s %6lu %6lu  %d/%-3d %7lu/%-7lu %9lu\n",
+                              laneNames[i], (unsigned long)st.queued, (unsigned long)st.bypassed,
+                              theMesh->getRxLaneDepth((RxLane)i), st.depthMax,
+                              (unsigned long)(st.waitTotalMs / n), (unsigned long)st.waitMaxMs,
+                              (unsigned long)(st.busyTotalMs / n));
+            }
+        }
+    }
+    // fastfwd - Cut-through flood forwarding
+    else if (strcmp(cmd, "fastfwd on") == 0 || strcmp(cmd, "fastfwd off") == 0) {
+        if (theMesh) {
+            bool enable = (strcmp(cmd, "fastfwd on") == 0);
+            theMesh->setCutThroughEnabled(enable);
+            Serial.printf("Cut-through forwarding %s.\n", enable ? "ENABLED" : "DISABLED");
+        }
+    }
+    else if (strcmp(cmd, "fastfwd reset") == 0) {
+        if (theMesh) {
+            theMesh->resetCutThroughStats();
+            Serial.println("Cut-through stats reset.");
+        }
+    }
+    else if (strcmp(cmd, "fastfwd") == 0) {
+        if (theMesh) {
+            const CutThroughStats& st = theMesh->getCutThroughStats();
+            Serial.printf("=== Cut-through forwarding: %s ===\n",
+                          theMesh->isCutThroughEnabled() ? "ON" : "OFF");
+            Serial.printf("  Relayed:    %lu (dup %lu, pool empty %lu)\n",
+                          (unsigned long)st.relayed, (unsigned long)st.duplicates,
+                          (unsigned long)st.noPacket);
+            Serial.printf("  Normal path reached: %lu\n", (unsigned long)st.suppressed);
+            if (st.suppressed > 0) {
+                Serial.printf("  Latency saved: avg %lu ms, max %lu ms\n",
+                              (unsigned long)(st.savedTotalMs / st.suppressed),
+                              (unsigned long)st.savedMaxMs);
+            }
+        }
+    }
+    // fwdlimit - Per-source relay token buckets
+    else if (strcmp(cmd, "fwdlimit on") == 0 || strcmp(cmd, "fwdlimit off") == 0) {
+        bool enable = (strcmp(cmd, "fwdlimit on") == 0);
+        SettingsManager::getDeviceSettings().fwdLimitEnabled = enable;
+        SettingsManager::saveDeviceSettings();
+        ForwardLimiter::setEnabled(enable);
+        Serial.printf("Relay rate limiting %s.\n", enable ? "ENABLED" : "DISABLED");
+    }
+    else if (strcmp(cmd, "fwdlimit reset") == 0) {
+        ForwardLimiter::resetStats();
+        Serial.println("Relay limit counters reset.");
+    }
+    else if (strncmp(cmd, "fwdlimit ", 9) == 0) {
+        char cls[12] = "";
+        int rate = -1;
+        sscanf(cmd + 9, "%11s %d", cls, &rate);
+
+        DeviceSettings& ds = SettingsManager::getDeviceSettings();
+        uint8_t* setting = nullptr;
+        ForwardLimiter::TrafficClass tc = ForwardLimiter::FL_CLASS_OTHER;
+        if (strcmp(cls, "advert") == 0)       { setting = &ds.fwdRateAdvert;  tc = ForwardLimiter::FL_CLASS_ADVERT; }
+        else if (strcmp(cls, "channel") == 0) { setting = &ds.fwdRateChannel; tc = ForwardLimiter::FL_CLASS_CHANNEL; }
+        else if (strcmp(cls, "peer") == 0)    { setting = &ds.fwdRatePeer;    tc = ForwardLimiter::FL_CLASS_PEER; }
+        else if (strcmp(cls, "other") == 0)   { setting = &ds.fwdRateOther;   tc = ForwardLimiter::FL_CLASS_OTHER; }
+
+        if (!setting || rate < 0 || rate > 255) {
+            Serial.println("Usage: fwdlimit <advert|channel|peer|other> <0-255 per min>");
+        } else {
+            *setting = (uint8_t)rate;
+            SettingsManager::saveDeviceSettings();
+            ForwardLimiter::setRate(tc, (uint8_t)rate);
+            Serial.printf("%s relays: %d per %s per minute%s\n", cls, rate,
+                          tc == ForwardLimiter::FL_CLASS_CHANNEL ? "channel" : "source",
+                          rate == 0 ? " (unlimited)" : "");
+        }
+    }
+    else if (strcmp(cmd, "fwdlimit") == 0) {
+        const ForwardLimiter::Stats& st = ForwardLimiter::getStats();
+        Serial.printf("=== Relay limits: %s, %d sources tracked, %lu recycled ===\n",
+                      ForwardLimiter::isEnabled() ? "ON" : "OFF",
+                      ForwardLimiter::getBucketCount(), (unsigned long)st.evictions);
+        Serial.println("  class    rate/min   passed deferred  dropped");
+        for (int c = 0; c < ForwardLimiter::FL_CLASS_COUNT; c++) {
+            ForwardLimiter::TrafficClass tc = (ForwardLimiter::TrafficClass)c;
+            Serial.printf("  %-8s %8d %8lu %8lu %8lu\n",
+                          ForwardLimiter::className(tc), ForwardLimiter::getRate(tc),
+                          (unsigned long)st.passed[c], (unsigned long)st.deferred[c],
+                          (unsigned long)st.dropped[c]);
+        }
+
+        // Only sources that went over budget are worth listing
+        static const char* sourceKind[] = { "origin", "chan" };
+        for (int i = 0; i < ForwardLimiter::FL_MAX_BUCKETS; i++) {
+            const ForwardLimiter::Bucket* b = ForwardLimiter::getBucketSlot(i);
+            if (!b || (b->deferred == 0 && b->dropped == 0)) continue;
+            Serial.printf("  over: %-6s %02X %-8s passed %lu deferred %lu dropped %lu\n",
+                          sourceKind[b->source], b->hash,
+                          ForwardLimiter::className((ForwardLimiter::TrafficClass)b->cls),
+                          (unsigned long)b->passed, (unsigned long)b->deferred,
+                          (unsigned long)b->dropped);
+        }
+    }
+    // mute [n] - Per-channel notification mute
+    else if (strcmp(cmd, "mute") == 0) {
+        const ChannelSettings& channels = SettingsManager::getChannelSettings();
+        for (int i = 0; i < channels.numChannels; i++) {
+            Serial.printf("  %d: %-20s %s\n", i, channels.channels[i].name,
+                          channels.channels[i].isMuted ? "muted" : "notify");
+        }
+        const Notifier::Stats& st = Notifier::getStats();
+        Serial.printf("Notifications: %lu events in %lu bursts, %lu tones, %lu muted\n",
+                      (unsigned long)st.events, (unsigned long)st.windows,
+                      (unsigned long)st.tones, (unsigned long)st.muted);
+    }
+    else if (strncmp(cmd, "mute ", 5) == 0) {
+        ChannelSettings& channels = SettingsManager::getChannelSettings();
+        int idx = atoi(cmd + 5);
+        if (idx < 0 || idx >= channels.numChannels) {
+            Serial.printf("Usage: mute <0-%d>\n", channels.numChannels - 1);
+        } else {
+            ChannelEntry& ch = channels.channels[idx];
+            ch.isMuted = !ch.isMuted;
+            SettingsManager::save();
+            Serial.printf("%s: %s\n", ch.name, ch.isMuted ? "muted" : "notifications on");
+        }
+    }
+    // archive [flush] - Message archive group commit
+    else if (strcmp(cmd, "archive") == 0 || strcmp(cmd, "archive flush") == 0) {
+        if (strcmp(cmd, "archive flush") == 0) {
+            MessageArchive::flush();
+        }
+        const ArchiveStats& st = MessageArchive::getStats();
+        Serial.printf("=== Archive: %d queued ===\n", MessageArchive::getPendingCount());
+        Serial.printf("  saves %lu in %lu commits (%lu records, %lu header writes)\n",
+                      (unsigned long)st.appends, (unsigned long)st.commits,
+                      (unsigned long)st.recordWrites, (unsigned long)st.headerWrites);
+        Serial.printf("  file opens %lu, rotations %lu, lost %lu\n",
+                      (unsigned long)st.opens, (unsigned long)st.rotations,
+                      (unsigned long)st.dropped);
+    }
+    // sync - Channel history reconciliation
+    else if (strcmp(cmd, "sync on") == 0 || strcmp(cmd, "sync off") == 0) {
+        bool enable = (strcmp(cmd, "sync on") == 0);
+        DeviceSettings& settings = SettingsManager::getDeviceSettings();
+        settings.historySyncEnabled = enable;
+        SettingsManager::saveDeviceSettings();
+        if (theMesh) theMesh->setHistorySyncEnabled(enable);
+        Serial.printf("Channel history sync %s.\n", enable ? "ENABLED" : "DISABLED");
+    }
+    else if (strcmp(cmd, "sync now") == 0) {
+        if (!theMesh || !theMesh->isHistorySyncEnabled()) {
+            Serial.println("History sync is off. Use 'sync on' first.");
+        } else {
+            theMesh->requestHistorySync();
+            Serial.println("History sync scheduled.");
+        }
+    }
+    else if (strncmp(cmd, "sync", 4) == 0) {
+        if (theMesh) {
+            Serial.printf("History sync:  %s\n", theMesh->isHistorySyncEnabled() ? "ON" : "OFF");
+            Serial.printf("Records sent:  %u\n", theMesh->getSyncRecordsSent());
+            Serial.printf("Recovered:     %u\n", theMesh->getSyncRecordsRecovered());
+        }
+        Serial.println("Usage: sync on|off|now");
+    }
+    // discover - Zero-hop neighbour discovery burst
+    else if (strcmp(cmd, "discover") == 0) {
+        if (theMesh) {
+            Serial.printf("Last burst found %d neighbours. Starting new burst...\n",
+                          theMesh->getDiscoveredCount());
+            theMesh->requestDiscovery();
+        }
+    }
+    // survey - Band noise floor and LoRa activity sweep
+    else if (strcmp(cmd, "survey stop") == 0) {
+        BandSurvey::stop();
+    }
+    else if (strcmp(cmd, "survey") == 0 || strncmp(cmd, "survey ", 7) == 0) {
+        const BandSurvey::Result& r = BandSurvey::getResult();
+        if (BandSurvey::isRunning()) {
+            Serial.printf("Survey running: pass %d/%d, channel %d/%d, RX paused %lu ms\n",
+                          r.passDone + 1, r.passes, r.nextChannel + 1, r.channelCount,
+                          (unsigned long)r.pausedMs);
+        } else if (strlen(cmd) > 7) {
+            char* end;
+            uint16_t dwell = (uint16_t)strtoul(cmd + 7, &end, 10);
+            uint8_t passes = (uint8_t)strtoul(end, nullptr, 10);
+            if (!BandSurvey::start(SettingsManager::getRadioSettings(), dwell,
+                                   passes ? passes : 3)) {
+                Serial.println("Cannot survey: radio not ready or no band for this region.");
+            }
+        } else if (r.channelCount > 0 && r.recommended >= 0) {
+            Serial.printf("\n=== Band Survey %.3f-%.3f MHz (%d channels, %d pass%s) ===\n",
+                          r.bandLowMHz, r.bandHighMHz, r.channelCount, r.passDone,
+                          r.passDone == 1 ? "" : "es");
+            for (int i = 0; i < r.channelCount; i++) {
+                const BandSurvey::Channel& c = r.channels[i];
+                if (!c.visits) continue;
+                Serial.printf("  %.3f  floor %6.1f  avg %6.1f  peak %6.1f  CAD %d/%d  score %6.1f%s%s\n",
+                              c.freqMHz, c.floorDbm(), c.avgDbm(), c.peakDbm, c.cadHits, c.visits,
+                              c.score(), i == r.currentChannel ? "  <- mesh" : "",
+                              i == r.recommended ? "  <- best" : "");
+            }
+            Serial.printf("Recommended: %.3f MHz\n", r.channels[r.recommended].freqMHz);
+        } else {
+            if (!BandSurvey::start(SettingsManager::getRadioSettings(),
+                                   BandSurvey::SURVEY_DWELL_DEFAULT_MS, 3)) {
+                Serial.println("Cannot survey: radio not ready or no band for this region.");
+            }
+        }
+    }
+    // relays - Which repeaters carry our channel messages
+    else if (strcmp(cmd, "relays save") == 0) {
+        Serial.println(RelayStats::save() ? "Relay stats saved." : "Failed to save relay stats.");
+    }
+    else if (strcmp(cmd, "relays clear") == 0) {
+        RelayStats::clear();
+        Serial.println("Relay stats cleared.");
+    }
+    else if (strcmp(cmd, "relays") == 0) {
+        const RelayStats::Totals& t = RelayStats::getTotals();
+        uint32_t sent = t.sent ? t.sent : 1;
+        Serial.printf("=== Relays: %lu sent, %lu relayed, %lu copies heard ===\n",
+                      (unsigned long)t.sent, (unsigned long)t.relayed, (unsigned long)t.copies);
+        static RelayStats::Repeater rows[RelayStats::RELAY_MAX_REPEATERS];
+        int count = RelayStats::getRepeaters(rows, RelayStats::RELAY_MAX_REPEATERS);
+        Serial.println("  hash name          cover  1st hop  heard  dup   SNR");
+        for (int i = 0; i < count; i++) {
+            const RelayStats::Repeater& r = rows[i];
+            const Topology::TopoNode* n = Topology::getNode(r.hash);
+            const char* name = (n && (n->flags & Topology::TOPO_NODE_NAMED)) ? n->name : "?";
+            Serial.printf("  %02X   %-12.12s  %4lu%%  %6lu%%  %5u  %3.0f%%  %5.1f\n",
+                          r.hash, name,
+                          (unsigned long)(r.carried * 100 / sent),
+                          (unsigned long)(r.firstHop * 100 / sent),
+                          r.heard, r.duplicateRatio() * 100.0f, r.snr);
+        }
+    }
+    // topo - Passively learned mesh topology
+    else if (strcmp(cmd, "topo save") == 0) {
+        Serial.println(Topology::save() ? "Topology saved." : "Failed to save topology.");
+    }
+    else if (strcmp(cmd, "topo clear") == 0) {
+        Topology::clear();
+        Serial.println("Topology cleared.");
+    }
+    else if (strcmp(cmd, "topo") == 0) {
+        Serial.printf("=== Topology: %d nodes, %d links ===\n",
+                      Topology::getNodeCount(), Topology::getEdgeCount());
+        for (int s = 0; s < Topology::TOPO_EDGE_SLOTS; s++) {
+            const Topology::TopoEdge* e = Topology::getEdgeSlot(s);
+            if (!e) continue;
+            const Topology::TopoNode* a = Topology::getNode(e->a);
+            const Topology::TopoNode* b = Topology::getNode(e->b);
+            if (e->flags & Topology::TOPO_EDGE_MEASURED) {
+                Serial.printf("  %02X %-12.12s <-> %02X %-12.12s ETX %.1f SNR %.1f (%u obs)\n",
+                              e->a, a->name, e->b, b->name, e->etx, e->snr, e->observations);
+            } else {
+                Serial.printf("  %02X %-12.12s <-> %02X %-12.12s ETX ~%.1f (%u obs)\n",
+                              e->a, a->name, e->b, b->name, e->etx, e->observations);
+            }
+        }
+    }
+    // route <name> - Least-cost route planned over the topology
+    else if (strncmp(cmd, "route ", 6) == 0) {
+        const char* name = cmd + 6;
+        while (*name == ' ') name++;
+
+        ContactSettings& contacts = SettingsManager::getContactSettings();
+        int idx = contacts.findContactByName(name);
+        if (idx < 0) {
+            Serial.printf("Contact '%s' not found.\n", name);
+            return;
+        }
+        const ContactEntry* contact = contacts.getContact(idx);
+
+        RoutePlanner::Route route;
+        if (!RoutePlanner::planRoute(contact->pubKey[0], rtcClock.getCurrentTime(), route)) {
+            Serial.printf("No route to %s [%02X] in learned topology.\n",
+                          contact->name, contact->pubKey[0]);
+        } else {
+            Serial.printf("Route to %s [%02X]: ", contact->name, contact->pubKey[0]);
+            if (route.hopCount == 0) Serial.print("direct");
+            for (int i = 0; i < route.hopCount; i++) {
+                Serial.printf("%s%02X", i ? " > " : "", route.hops[i]);
+            }
+            Serial.printf("  (ETX %.1f)\n", route.cost);
+        }
+        Serial.printf("Tree recomputes: %u, last took %u us\n",
+                      RoutePlanner::getRecomputeCount(), RoutePlanner::getLastComputeUs());
+    }
+    // trace / ping - Per-hop latency and loss over TRACE packets
+    else if (strcmp(cmd, "trace stop") == 0) {
+        if (theMesh) theMesh->cancelTrace();
+    }
+    else if (strncmp(cmd, "trace ", 6) == 0 || strncmp(cmd, "ping ", 5) == 0) {
+        bool pingOnly = (cmd[0] == 'p');
+        const char* args = cmd + (pingOnly ? 5 : 6);
+        while (*args == ' ') args++;
+
+        if (!theMesh) {
+            Serial.println("Mesh not running.");
+            return;
+        }
+
+        // Split "<target> [count]"
+        char target[48];
+        strncpy(target, args, sizeof(target) - 1);
+        target[sizeof(target) - 1] = '\0';
+        int probes = pingOnly ? 5 : 3;
+        char* space = strrchr(target, ' ');
+        if (space && atoi(space + 1) > 0) {
+            probes = atoi(space + 1);
+            *space = '\0';
+        }
+
+        uint8_t path[TraceRoute::TRACE_MAX_HOPS];
+        int hops = parseHashList(target, path, TraceRoute::TRACE_MAX_HOPS);
+        if (hops <= 0) {
+            // Contacts first, then nodes only heard over the air
+            ContactSettings& contacts = SettingsManager::getContactSettings();
+            int idx = contacts.findContactByName(target);
+            NodeInfo node;
+            if (idx >= 0) {
+                node.id = contacts.getContact(idx)->id;
+                strlcpy(node.name, contacts.getContact(idx)->name, sizeof(node.name));
+            } else if (!theMesh->findNodeByName(target, node)) {
+                Serial.printf("'%s' is not a known node or hash list (e.g. AB,CD).\n", target);
+                return;
+            }
+            hops = theMesh->buildTracePath(node.id, path, TraceRoute::TRACE_MAX_HOPS);
+            if (hops <= 0) {
+                Serial.printf("No learned or planned route to %s.\n", node.name);
+                return;
+            }
+        }
+
+        if (theMesh->startTrace(path, (uint8_t)hops, (uint8_t)probes, pingOnly)) {
+            Serial.print(pingOnly ? "Pinging via " : "Tracing ");
+            for (int i = 0; i < hops; i++) Serial.printf("%s%02X", i ? " > " : "", path[i]);
+            Serial.println();
+        }
+    }
     // ==========================================================================
     // REPEATER MANAGEMENT COMMANDS
     // ==========================================================================
@@ -1270,9 +1957,14 @@ void processCommand(const char* cmd) {
             return;
         }
 
-        // Find repeater by name
+        // Find repeater by name; logging in to a discovered one adds it
         ContactSettings& contacts = SettingsManager::getContactSettings();
         int idx = contacts.findContactByName(repeaterName);
+        NodeInfo heard;
+        if (idx < 0 && theMesh && theMesh->findNodeByName(repeaterName, heard) &&
+            heard.type == NODE_TYPE_REPEATER) {
+            idx = theMesh->promoteToContact(heard.id);
+        }
         if (idx < 0) {
             Serial.printf("Repeater '%s' not found in contacts.\n", repeaterName);
             return;
@@ -1440,10 +2132,62 @@ void processCommand(const char* cmd) {
         SettingsManager::saveContacts();
         Serial.println("All contacts cleared.");
     }
+    // fsbench - Flash filesystem latency at several fill levels
+    else if (strcmp(cmd, "fsbench") == 0) {
+        Serial.println("Running flash benchmark (mesh paused, may take minutes)...");
+        FlashBench::run();
+    }
+    // sdbench - Storage read/write throughput
+    else if (strcmp(cmd, "sdbench") == 0) {
+        MessageArchive::flush();
+        SDBench::run();
+    }
+    // sdclock [tune] - SD SPI clock auto-tuning
+    else if (strcmp(cmd, "sdclock") == 0) {
+        if (!Storage::isSDAvailable()) {
+            Serial.println("No SD card");
+        } else {
+            Serial.printf("SD clock: %lu kHz, %lu errors since boot\n",
+                          (unsigned long)(Storage::getSDClock() / 1000),
+                          (unsigned long)Storage::getSDErrorCount());
+        }
+    }
+    else if (strcmp(cmd, "sdclock tune") == 0) {
+        // Tuning remounts the card: no archive or WAV file may stay open
+        MessageArchive::flush();
+        Audio::stop();
+        if (Storage::tuneSDClock()) {
+            Serial.printf("SD clock: %lu kHz (saved on card)\n",
+                          (unsigned long)(Storage::getSDClock() / 1000));
+        } else {
+            Serial.println("SD clock tuning failed");
+        }
+    }
+    // font - Unicode font faces and glyph cache
+    else if (strcmp(cmd, "font") == 0) {
+        Serial.println("Unicode font:");
+        Font::printStatus();
+    }
+    // play <file> / play stop - Stream a WAV file from SD
+    else if (strcmp(cmd, "play stop") == 0) {
+        Audio::stop();
+    }
+    else if (strncmp(cmd, "play ", 5) == 0) {
+        const char* name = cmd + 5;
+        char path[96];
+        if (name[0] == '/') {
+            snprintf(path, sizeof(path), "%s", name);
+        } else {
+            snprintf(path, sizeof(path), "/meshberry/sounds/%s", name);
+        }
+        if (!Audio::playFile(path)) {
+            Serial.printf("Cannot play %s (see [AUDIO] log)\n", path);
+        }
+    }
     // dump contacts - Show raw contacts.json file
     else if (strcmp(cmd, "dump contacts") == 0) {
-        if (SPIFFS.exists("/contacts.json")) {
-            File f = SPIFFS.open("/contacts.json", "r");
+        if (FLASH_FS.exists("/contacts.json")) {
+            File f = FLASH_FS.open("/contacts.json", "r");
             if (f) {
                 Serial.printf("[CLI] Contents of /contacts.json (%d bytes):\n", f.size());
                 while (f.available()) {
@@ -1466,6 +2210,53 @@ void processCommand(const char* cmd) {
         uint32_t epoch = rtcClock.getCurrentTime();
         Serial.printf("Current RTC time: %u (UNIX epoch)\n", epoch);
         Serial.printf("GPS sync status: %s\n", rtcSyncedFromGps ? "synced" : "not synced");
+        static const char* sourceNames[] = { "none", "peer", "mesh", "manual", "GPS" };
+        Serial.printf("Time source: %s\n", sourceNames[rtcClock.getSource()]);
+    }
+    // timesync [now|reset] - Mesh time sync status
+    else if (strcmp(cmd, "timesync") == 0 || strncmp(cmd, "timesync ", 9) == 0) {
+        const char* arg = cmd + 8;
+        while (*arg == ' ') arg++;
+
+        if (strcmp(arg, "now") == 0) {
+            if (!TimeSync::disciplineNow()) {
+                Serial.println("No consensus: need 2 agreeing sources or 1 with a position.");
+            }
+        } else if (strcmp(arg, "reset") == 0) {
+            TimeSync::reset();
+            Serial.println("Time sync sources cleared.");
+        } else if (*arg) {
+            Serial.println("Usage: timesync [now|reset]");
+        } else {
+            static const char* sourceNames[] = { "none", "peer", "mesh", "manual", "GPS" };
+            const TimeSync::Status& st = TimeSync::getStatus();
+            Serial.println("\n=== Time Sync ===");
+            Serial.printf("Clock: %u (%s), skew %d ppm, slewing %d ms\n",
+                          rtcClock.getCurrentTime(), sourceNames[rtcClock.getSource()],
+                          rtcClock.getSkewPpm(), rtcClock.getSlewPendingMs());
+            if (st.lastDisciplineAt) {
+                Serial.printf("Last round: %lus ago, offset %d ms +/-%d ms, %d/%d sources%s\n",
+                              (unsigned long)((millis() - st.lastDisciplineAt) / 1000),
+                              st.lastOffsetMs, st.estErrorMs, st.usedCount, st.sourceCount,
+                              st.applied ? "" : " (not applied)");
+            } else {
+                Serial.println("Last round: never");
+            }
+            Serial.printf("Link delay: %d ms, skew fit points: %d\n", st.linkDelayMs, st.skewPoints);
+
+            int count = TimeSync::getSourceCount();
+            for (int i = 0; i < count; i++) {
+                const TimeSync::Source* src = TimeSync::getSource(i);
+                if (!src) break;
+                Serial.printf("  [%02X] %+8lld ms  hops=%d  samples=%d  age=%lus%s%s\n",
+                              src->hash, (long long)TimeSync::sourceOffsetMs(*src),
+                              src->hops, src->samples,
+                              (unsigned long)((millis() - src->seenAt) / 1000),
+                              src->weight >= TimeSync::TS_WEIGHT_PREFERRED ? "  pos" : "",
+                              src->used ? "  *" : "");
+            }
+            if (count == 0) Serial.println("No sources heard yet.");
+        }
     }
     // time sync - Sync from GPS
     else if (strcmp(cmd, "time sync") == 0) {
@@ -1484,7 +2275,7 @@ void processCommand(const char* cmd) {
                     Serial.printf("GPS time not reliable yet (year=%d). Wait for full satellite lock.\n", year);
                 } else {
                     uint32_t gpsEpoch = makeUnixTime(year, month, day, hour, minute, second);
-                    rtcClock.setCurrentTime(gpsEpoch);
+                    rtcClock.setCurrentTime(gpsEpoch, TIME_SOURCE_GPS);
                     rtcSyncedFromGps = true;
                     Serial.printf("RTC synced from GPS: %u (UTC %04d-%02d-%02d %02d:%02d:%02d)\n",
                                   gpsEpoch, year, month, day, hour, minute, second);
@@ -1514,6 +2305,67 @@ void processCommand(const char* cmd) {
             }
         }
     }
+    // share - Position beacon status and teammates
+    else if (strcmp(cmd, "share") == 0) {
+        const PositionBeacon::SenderStats& st = PositionBeacon::getSenderStats();
+        Serial.printf("Sharing:   %s (ch %d, %u m threshold)\n",
+                      theMesh->isPositionSharing() ? "on" : "off",
+                      theMesh->getPositionChannel(), theMesh->getPositionThreshold());
+        Serial.printf("Sent:      %lu reports (%lu key), %lu bytes, %lu checks\n",
+                      (unsigned long)st.reports, (unsigned long)st.keyframes,
+                      (unsigned long)st.bytes, (unsigned long)st.checks);
+        Serial.printf("DR error:  %.0f m now, %.0f m worst since last report\n",
+                      st.lastErrorM, st.maxErrorM);
+
+        int count = PositionBeacon::getTrackCount();
+        Serial.printf("Teammates: %d\n", count);
+        for (int i = 0; i < count; i++) {
+            const PositionBeacon::Track* t = PositionBeacon::getTrack(i);
+            PositionBeacon::Fix p = t->positionAt(millis());
+            char name[32];
+            snprintf(name, sizeof(name), "%08X", t->id);
+            NodeInfo node;
+            if (theMesh->findNode(t->id, node)) {
+                strncpy(name, node.name, sizeof(name) - 1);
+                name[sizeof(name) - 1] = '\0';
+            }
+            Serial.printf("  %-16s %.6f,%.6f %5.1f km/h %3.0f deg  %lus ago, %d hops, %u reports\n",
+                          name, p.lat, p.lon, p.speedMps * 3.6f, p.courseDeg,
+                          (unsigned long)((millis() - t->heardAt) / 1000), t->hops, t->reports);
+        }
+    }
+    else if (strcmp(cmd, "share off") == 0) {
+        DeviceSettings& ds = SettingsManager::getDeviceSettings();
+        ds.posShareEnabled = false;
+        SettingsManager::saveDeviceSettings();
+        theMesh->setPositionSharing(false, ds.posShareChannel, ds.posShareThresholdM);
+    }
+    else if (strncmp(cmd, "share on", 8) == 0) {
+        DeviceSettings& ds = SettingsManager::getDeviceSettings();
+        int ch = ds.posShareChannel;
+        int thresh = ds.posShareThresholdM;
+        sscanf(cmd + 8, "%d %d", &ch, &thresh);
+
+        ChannelSettings& chSettings = SettingsManager::getChannelSettings();
+        if (ch < 0 || ch >= chSettings.numChannels || !chSettings.channels[ch].isActive) {
+            Serial.printf("Channel %d is not active\n", ch);
+        } else if (!chSettings.isPrivate(ch)) {
+            Serial.printf("Channel %d can be read by anyone - use a private channel: share on <ch>\n", ch);
+        } else {
+            ds.posShareEnabled = true;
+            ds.posShareChannel = ch;
+            ds.posShareThresholdM = thresh;
+            theMesh->setPositionSharing(true, ch, thresh);
+            ds.posShareThresholdM = theMesh->getPositionThreshold();
+            SettingsManager::saveDeviceSettings();
+            if (gpsPresent && !GPS::isEnabled()) {
+                GPS::enable();
+            }
+            if (!gpsPresent) {
+                Serial.println("No GPS - beacons will not be sent, teammates are still tracked");
+            }
+        }
+    }
     // Unknown command
     else {
         Serial.printf("Unknown command: %s\n", cmd);
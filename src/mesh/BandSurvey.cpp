@@ -0,0 +1,205 @@
+/**
+ * MeshBerry Band Survey Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "BandSurvey.h"
+#include <string.h>
+
+namespace BandSurvey {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static SurveyRadio* s_radio = nullptr;
+static Result s_result;
+static uint32_t s_lastSliceAt = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static void recommend() {
+    int best = -1;
+    for (int i = 0; i < s_result.channelCount; i++) {
+        if (!s_result.channels[i].visits) continue;
+        if (best < 0 || s_result.channels[i].score() < s_result.channels[best].score()) {
+            best = i;
+        }
+    }
+
+    // Moving the mesh is costly, so only recommend a clear improvement
+    int cur = s_result.currentChannel;
+    if (best >= 0 && cur >= 0 && s_result.channels[cur].visits &&
+        s_result.channels[cur].score() <= s_result.channels[best].score() + SURVEY_KEEP_MARGIN_DB) {
+        best = cur;
+    }
+    s_result.recommended = best;
+}
+
+// =============================================================================
+// API
+// =============================================================================
+
+void init(SurveyRadio* radio) {
+    s_radio = radio;
+    memset(&s_result, 0, sizeof(s_result));
+    s_result.currentChannel = -1;
+    s_result.recommended = -1;
+}
+
+bool getBand(const RadioSettings& settings, float& lowMHz, float& highMHz) {
+    switch (settings.region) {
+        case REGION_US:
+            lowMHz = 902.0f;
+            highMHz = 928.0f;
+            return true;
+
+        case REGION_UK:
+        case REGION_EU:
+            // 869.4-869.65 MHz is the only EU sub-band allowing 500 mW at 10% duty
+            lowMHz = 869.4f;
+            highMHz = 869.65f;
+            return true;
+
+        case REGION_AU:
+            lowMHz = 915.0f;
+            highMHz = 928.0f;
+            return true;
+
+        case REGION_CUSTOM:
+            // No band plan known - survey the neighbourhood of the current frequency
+            lowMHz = settings.frequency - 1.0f;
+            highMHz = settings.frequency + 1.0f;
+            return lowMHz >= 137.0f && highMHz <= 1020.0f;
+
+        default:
+            return false;
+    }
+}
+
+bool start(const RadioSettings& settings, uint16_t dwellMs, uint8_t passes) {
+    if (!s_radio) return false;
+
+    float low, high;
+    if (!getBand(settings, low, high)) return false;
+
+    if (dwellMs < SURVEY_DWELL_MIN_MS) dwellMs = SURVEY_DWELL_MIN_MS;
+    if (dwellMs > SURVEY_DWELL_MAX_MS) dwellMs = SURVEY_DWELL_MAX_MS;
+    if (passes < 1) passes = 1;
+    if (passes > SURVEY_MAX_PASSES) passes = SURVEY_MAX_PASSES;
+
+    // One channel per bandwidth, coarser if the band has more than the chart fits
+    float step = settings.bandwidth / 1000.0f;
+    int count = (int)((high - low) / step);
+    if (count > SURVEY_MAX_CHANNELS) {
+        count = SURVEY_MAX_CHANNELS;
+        step = (high - low) / count;
+    }
+    if (count < 1) return false;
+
+    memset(&s_result, 0, sizeof(s_result));
+    s_result.channelCount = count;
+    s_result.bandLowMHz = low;
+    s_result.bandHighMHz = high;
+    s_result.stepMHz = step;
+    s_result.dwellMs = dwellMs;
+    s_result.passes = passes;
+    s_result.currentChannel = -1;
+    s_result.recommended = -1;
+
+    float home = s_radio->homeFrequency();
+    for (int i = 0; i < count; i++) {
+        Channel& c = s_result.channels[i];
+        c.freqMHz = low + step * (i + 0.5f);
+        c.peakDbm = -200.0f;
+        if (home >= low + step * i && home < low + step * (i + 1)) {
+            s_result.currentChannel = i;
+        }
+    }
+
+    s_result.startedAt = millis();
+    s_result.running = true;
+    s_lastSliceAt = millis();
+
+    Serial.printf("[SURVEY] Sweeping %.3f-%.3f MHz: %d channels, %d ms dwell, %d pass%s\n",
+                  low, high, count, dwellMs, passes, passes == 1 ? "" : "es");
+    return true;
+}
+
+void stop() {
+    if (!s_result.running) return;
+    s_result.running = false;
+    recommend();
+    Serial.println("[SURVEY] Stopped");
+}
+
+void process() {
+    if (!s_result.running || !s_radio) return;
+    if (millis() - s_lastSliceAt < SURVEY_GAP_MS) return;
+
+    // Never cut into a transmission or a packet being received
+    if (!s_radio->canPause()) return;
+
+    Channel& c = s_result.channels[s_result.nextChannel];
+    uint32_t t0 = millis();
+
+    if (s_radio->tune(c.freqMHz)) {
+        float minRssi = 0.0f;
+        uint16_t n = 0;
+        while (millis() - t0 < s_result.dwellMs) {
+            float rssi = s_radio->readRssi();
+            if (n == 0 || rssi < minRssi) minRssi = rssi;
+            if (rssi > c.peakDbm) c.peakDbm = rssi;
+            c.rssiSum += rssi;
+            n++;
+            delayMicroseconds(SURVEY_RSSI_INTERVAL_US);
+        }
+        // CAD only recognises LoRa at our own SF/BW, which is the traffic that matters
+        if (s_radio->detectPreamble()) c.cadHits++;
+
+        if (n > 0) {
+            c.floorSum += minRssi;
+            c.samples += n;
+            c.visits++;
+        }
+    } else {
+        Serial.printf("[SURVEY] Tune to %.3f MHz failed\n", c.freqMHz);
+    }
+
+    s_radio->restore();
+    s_lastSliceAt = millis();
+    s_result.pausedMs += s_lastSliceAt - t0;
+
+    if (++s_result.nextChannel >= s_result.channelCount) {
+        s_result.nextChannel = 0;
+        s_result.passDone++;
+        recommend();
+
+        if (s_result.passDone >= s_result.passes) {
+            s_result.running = false;
+            s_result.complete = true;
+            if (s_result.recommended >= 0) {
+                const Channel& best = s_result.channels[s_result.recommended];
+                Serial.printf("[SURVEY] Done in %lus: recommend %.3f MHz (floor %.1f dBm, CAD %d/%d)\n",
+                              (unsigned long)((millis() - s_result.startedAt) / 1000),
+                              best.freqMHz, best.floorDbm(), best.cadHits, best.visits);
+            }
+        }
+    }
+}
+
+bool isRunning() {
+    return s_result.running;
+}
+
+const Result& getResult() {
+    return s_result;
+}
+
+} // namespace BandSurvey
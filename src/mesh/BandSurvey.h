@@ -0,0 +1,154 @@
+/**
+ * MeshBerry Band Survey
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Sweeps the radio across the allowed band of the configured region and
+ * measures the RSSI noise floor and LoRa activity (CAD) at each channel,
+ * then recommends the quietest frequency.
+ *
+ * The sweep runs in short slices from the main loop: one channel visit
+ * of `dwell` ms, then the radio goes back to the mesh frequency for a
+ * gap, so normal RX is only briefly interrupted. A slice is never taken
+ * while the radio is transmitting or receiving a packet.
+ *
+ * Radio access goes through SurveyRadio so the sweep logic can run
+ * against a mock radio.
+ */
+
+#ifndef MESHBERRY_BAND_SURVEY_H
+#define MESHBERRY_BAND_SURVEY_H
+
+#include <Arduino.h>
+#include "../settings/RadioSettings.h"
+
+namespace BandSurvey {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr int      SURVEY_MAX_CHANNELS    = 104;    // Chart is 312 px wide, 3 px per channel
+constexpr uint16_t SURVEY_DWELL_MIN_MS    = 10;
+constexpr uint16_t SURVEY_DWELL_MAX_MS    = 100;    // Longest single RX interruption
+constexpr uint16_t SURVEY_DWELL_DEFAULT_MS = 40;
+constexpr uint32_t SURVEY_GAP_MS          = 250;    // Mesh RX time between slices
+constexpr uint8_t  SURVEY_MAX_PASSES      = 10;
+constexpr uint32_t SURVEY_RSSI_INTERVAL_US = 1000;  // RSSI sample spacing within a dwell
+constexpr float    SURVEY_KEEP_MARGIN_DB  = 2.0f;   // Keep the current channel unless beaten by this
+
+/**
+ * Radio operations used by the sweep
+ */
+class SurveyRadio {
+public:
+    virtual ~SurveyRadio() = default;
+
+    // Radio is idle in RX (not transmitting or receiving a packet)
+    virtual bool canPause() = 0;
+
+    // Leave mesh RX and listen on a frequency
+    virtual bool tune(float mhz) = 0;
+
+    // Instantaneous RSSI on the tuned frequency (dBm)
+    virtual float readRssi() = 0;
+
+    // Channel activity detection: a LoRa preamble was heard
+    virtual bool detectPreamble() = 0;
+
+    // Return to the mesh frequency and resume RX
+    virtual void restore() = 0;
+
+    // Frequency the mesh runs on (MHz)
+    virtual float homeFrequency() const = 0;
+};
+
+/**
+ * Measurements for one channel
+ */
+struct Channel {
+    float freqMHz;
+    float floorSum;         // Sum of per-visit minimum RSSI
+    float rssiSum;          // Sum of all RSSI samples
+    float peakDbm;
+    uint16_t samples;
+    uint8_t visits;
+    uint8_t cadHits;
+
+    float floorDbm() const { return visits ? floorSum / visits : 0.0f; }
+    float avgDbm() const { return samples ? rssiSum / samples : 0.0f; }
+    float cadRate() const { return visits ? (float)cadHits / visits : 0.0f; }
+
+    /**
+     * Congestion score, lower is better: noise floor, plus bursty energy
+     * above it, plus LoRa traffic heard by CAD
+     */
+    float score() const {
+        return floorDbm() + 2.0f * (avgDbm() - floorDbm()) + 20.0f * cadRate();
+    }
+};
+
+/**
+ * Sweep state and results
+ */
+struct Result {
+    Channel channels[SURVEY_MAX_CHANNELS];
+    int channelCount;
+    float bandLowMHz;
+    float bandHighMHz;
+    float stepMHz;
+    uint16_t dwellMs;
+    uint8_t passes;
+    uint8_t passDone;
+    int nextChannel;        // Next channel to visit in the current pass
+    int currentChannel;     // Channel containing the mesh frequency (-1 if outside)
+    int recommended;        // Best channel (-1 until the first pass completes)
+    uint32_t startedAt;     // millis()
+    uint32_t pausedMs;      // Total time away from the mesh frequency
+    bool running;
+    bool complete;
+};
+
+// =============================================================================
+// API
+// =============================================================================
+
+/**
+ * Attach the radio used for surveys
+ */
+void init(SurveyRadio* radio);
+
+/**
+ * Allowed band for a region (channel centres keep the signal inside it)
+ * @return false if the region has no known band
+ */
+bool getBand(const RadioSettings& settings, float& lowMHz, float& highMHz);
+
+/**
+ * Start a sweep of the configured region's band
+ * @param settings Region and bandwidth
+ * @param dwellMs Listening time per channel visit
+ * @param passes Sweeps to average
+ * @return false if no radio or no band
+ */
+bool start(const RadioSettings& settings, uint16_t dwellMs, uint8_t passes);
+
+/**
+ * Stop a sweep (keeps partial results)
+ */
+void stop();
+
+/**
+ * Run the next slice when due; call from the main loop
+ */
+void process();
+
+bool isRunning();
+const Result& getResult();
+
+} // namespace BandSurvey
+
+#endif // MESHBERRY_BAND_SURVEY_H
@@ -0,0 +1,181 @@
+/**
+ * MeshBerry Forward Limiter Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "ForwardLimiter.h"
+#include <string.h>
+
+namespace ForwardLimiter {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+// One packet in token units: a bucket gains `rate` tokens per ms
+static constexpr int32_t PACKET_COST = 60000;
+
+static bool s_enabled = true;
+static uint8_t s_rates[FL_CLASS_COUNT] = {
+    FL_DEFAULT_RATE_ADVERT,
+    FL_DEFAULT_RATE_CHANNEL,
+    FL_DEFAULT_RATE_PEER,
+    FL_DEFAULT_RATE_OTHER
+};
+static Bucket s_buckets[FL_MAX_BUCKETS];
+static Stats s_stats;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static int32_t burstTokens(TrafficClass cls) {
+    uint8_t burst = s_rates[cls] > FL_MIN_BURST ? s_rates[cls] : FL_MIN_BURST;
+    return (int32_t)burst * PACKET_COST;
+}
+
+static Bucket* findBucket(uint8_t hash, uint8_t source, TrafficClass cls, uint32_t nowMs) {
+    Bucket* freeSlot = nullptr;
+    Bucket* oldest = nullptr;
+
+    for (int i = 0; i < FL_MAX_BUCKETS; i++) {
+        Bucket& b = s_buckets[i];
+        if (!b.active) {
+            if (!freeSlot) freeSlot = &b;
+            continue;
+        }
+        if (b.hash == hash && b.source == source && b.cls == cls) return &b;
+        if (!oldest || (int32_t)(b.refillAt - oldest->refillAt) < 0) oldest = &b;
+    }
+
+    // Recycle the bucket idle longest; a new source starts with a full burst
+    Bucket* b = freeSlot;
+    if (!b) {
+        b = oldest;
+        s_stats.evictions++;
+    }
+    memset(b, 0, sizeof(*b));
+    b->hash = hash;
+    b->source = source;
+    b->cls = cls;
+    b->tokens = burstTokens(cls);
+    b->refillAt = nowMs;
+    b->active = true;
+    return b;
+}
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+void setEnabled(bool enabled) {
+    s_enabled = enabled;
+}
+
+bool isEnabled() {
+    return s_enabled;
+}
+
+void setRate(TrafficClass cls, uint8_t perMinute) {
+    if (cls >= FL_CLASS_COUNT) return;
+    s_rates[cls] = perMinute;
+
+    // Existing buckets may now hold more than the new burst
+    int32_t burst = burstTokens(cls);
+    for (int i = 0; i < FL_MAX_BUCKETS; i++) {
+        if (s_buckets[i].active && s_buckets[i].cls == cls && s_buckets[i].tokens > burst) {
+            s_buckets[i].tokens = burst;
+        }
+    }
+}
+
+uint8_t getRate(TrafficClass cls) {
+    return cls < FL_CLASS_COUNT ? s_rates[cls] : 0;
+}
+
+const char* className(TrafficClass cls) {
+    switch (cls) {
+        case FL_CLASS_ADVERT:  return "advert";
+        case FL_CLASS_CHANNEL: return "channel";
+        case FL_CLASS_PEER:    return "peer";
+        case FL_CLASS_OTHER:   return "other";
+        default:               return "?";
+    }
+}
+
+// =============================================================================
+// API
+// =============================================================================
+
+Verdict check(uint8_t hash, uint8_t source, TrafficClass cls, uint32_t nowMs) {
+    if (cls >= FL_CLASS_COUNT) cls = FL_CLASS_OTHER;
+    if (!s_enabled || s_rates[cls] == 0) {
+        s_stats.passed[cls]++;
+        return FL_PASS;
+    }
+
+    Bucket* b = findBucket(hash, source, cls, nowMs);
+
+    uint32_t elapsed = nowMs - b->refillAt;
+    if (elapsed > FL_MAX_REFILL_MS) elapsed = FL_MAX_REFILL_MS;
+    b->refillAt = nowMs;
+
+    int32_t burst = burstTokens(cls);
+    b->tokens += (int32_t)(elapsed * s_rates[cls]);
+    if (b->tokens > burst) b->tokens = burst;
+
+    Verdict v;
+    if (b->tokens >= PACKET_COST) {
+        v = FL_PASS;
+    } else if (b->tokens - PACKET_COST >= -burst) {
+        // Over budget: borrow up to one more burst, but relay late
+        v = FL_DEFER;
+    } else {
+        v = FL_DROP;
+    }
+
+    if (v != FL_DROP) b->tokens -= PACKET_COST;
+
+    switch (v) {
+        case FL_PASS:  b->passed++;   s_stats.passed[cls]++;   break;
+        case FL_DEFER: b->deferred++; s_stats.deferred[cls]++; break;
+        case FL_DROP:  b->dropped++;  s_stats.dropped[cls]++;  break;
+    }
+    return v;
+}
+
+const Stats& getStats() {
+    return s_stats;
+}
+
+void resetStats() {
+    memset(&s_stats, 0, sizeof(s_stats));
+    for (int i = 0; i < FL_MAX_BUCKETS; i++) {
+        s_buckets[i].passed = 0;
+        s_buckets[i].deferred = 0;
+        s_buckets[i].dropped = 0;
+    }
+}
+
+int getBucketCount() {
+    int n = 0;
+    for (int i = 0; i < FL_MAX_BUCKETS; i++) {
+        if (s_buckets[i].active) n++;
+    }
+    return n;
+}
+
+const Bucket* getBucketSlot(int slot) {
+    if (slot < 0 || slot >= FL_MAX_BUCKETS) return nullptr;
+    return s_buckets[slot].active ? &s_buckets[slot] : nullptr;
+}
+
+void clear() {
+    memset(s_buckets, 0, sizeof(s_buckets));
+}
+
+} // namespace ForwardLimiter
@@ -0,0 +1,135 @@
+/**
+ * MeshBerry Forward Limiter
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Per-source token buckets for floods we relay, so one chatty or
+ * misconfigured node cannot take over our forwarding queue and airtime.
+ *
+ * Buckets are keyed by source hash and traffic class. The source is the
+ * originator's hash for packets that carry it in clear (adverts, peer
+ * datagrams), and the channel hash for channel floods, whose sender is
+ * encrypted. Each class refills at its own rate.
+ * A source over budget first has its relays deferred, using up to one
+ * more burst of debt, and then dropped until the bucket refills.
+ *
+ * No Arduino or MeshCore dependencies; time is passed in.
+ */
+
+#ifndef MESHBERRY_FORWARD_LIMITER_H
+#define MESHBERRY_FORWARD_LIMITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace ForwardLimiter {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+enum TrafficClass : uint8_t {
+    FL_CLASS_ADVERT = 0,    // Node adverts
+    FL_CLASS_CHANNEL,       // GRP_TXT / GRP_DATA
+    FL_CLASS_PEER,          // DMs, requests, responses, paths
+    FL_CLASS_OTHER,         // ACKs and anything else
+    FL_CLASS_COUNT
+};
+
+enum Verdict : uint8_t {
+    FL_PASS = 0,            // Within budget
+    FL_DEFER,               // Over budget: relay late
+    FL_DROP                 // Deeply over budget: don't relay
+};
+
+// How a bucket's hash was obtained
+constexpr uint8_t  FL_SOURCE_ORIGIN      = 0;   // Originator's own hash
+constexpr uint8_t  FL_SOURCE_CHANNEL     = 1;   // Channel hash (shared by its members)
+
+constexpr int      FL_MAX_BUCKETS        = 32;
+constexpr uint8_t  FL_MIN_BURST          = 3;       // Packets, whatever the rate
+constexpr uint32_t FL_DEFER_DELAY_MS     = 2000;    // Added to a deferred relay's delay
+constexpr uint32_t FL_MAX_REFILL_MS      = 10 * 60 * 1000UL;
+
+// Default refill rates, packets per minute per source (0 = unlimited)
+constexpr uint8_t  FL_DEFAULT_RATE_ADVERT  = 2;
+constexpr uint8_t  FL_DEFAULT_RATE_CHANNEL = 30;    // Per channel, all members together
+constexpr uint8_t  FL_DEFAULT_RATE_PEER    = 12;
+constexpr uint8_t  FL_DEFAULT_RATE_OTHER   = 30;
+
+/**
+ * One source's budget for one traffic class
+ */
+struct Bucket {
+    int32_t tokens;         // Packet cost is 60000 (rate/min x ms)
+    uint32_t refillAt;      // millis() tokens were last topped up
+    uint32_t passed;
+    uint32_t deferred;
+    uint32_t dropped;
+    uint8_t hash;
+    uint8_t source;         // FL_SOURCE_*
+    uint8_t cls;            // TrafficClass
+    bool active;
+};
+
+/**
+ * Totals per traffic class
+ */
+struct Stats {
+    uint32_t passed[FL_CLASS_COUNT];
+    uint32_t deferred[FL_CLASS_COUNT];
+    uint32_t dropped[FL_CLASS_COUNT];
+    uint32_t evictions;     // Buckets recycled for a new source
+};
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+void setEnabled(bool enabled);
+bool isEnabled();
+
+/**
+ * Set a class's refill rate (packets per minute per source, 0 = unlimited)
+ * Burst is one minute of traffic, at least FL_MIN_BURST.
+ */
+void setRate(TrafficClass cls, uint8_t perMinute);
+uint8_t getRate(TrafficClass cls);
+
+const char* className(TrafficClass cls);
+
+// =============================================================================
+// API
+// =============================================================================
+
+/**
+ * Charge one relay to a source's bucket
+ * @param hash Source hash
+ * @param source FL_SOURCE_* (how the hash was obtained)
+ * @param cls Traffic class
+ * @param nowMs millis()
+ * @return Verdict; FL_DROP does not consume tokens
+ */
+Verdict check(uint8_t hash, uint8_t source, TrafficClass cls, uint32_t nowMs);
+
+const Stats& getStats();
+void resetStats();
+
+int getBucketCount();
+
+/**
+ * Bucket in table slot 0..FL_MAX_BUCKETS-1, nullptr if the slot is free
+ */
+const Bucket* getBucketSlot(int slot);
+
+/**
+ * Forget all buckets (counters are kept)
+ */
+void clear();
+
+} // namespace ForwardLimiter
+
+#endif // MESHBERRY_FORWARD_LIMITER_H
@@ -0,0 +1,176 @@
+/**
+ * MeshBerry Channel History Sync Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "HistorySync.h"
+#include <string.h>
+
+namespace HistorySync {
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+/**
+ * Load the newest archive entries for a channel
+ * Caller must delete[] the returned buffer
+ */
+static ArchivedMessage* loadRecent(int channelIdx, int& count) {
+    count = 0;
+    ArchivedMessage* buffer = new ArchivedMessage[SYNC_MAX_ITEMS];
+    if (!buffer) {
+        Serial.println("[SYNC] Out of memory loading archive");
+        return nullptr;
+    }
+    count = MessageArchive::loadChannelMessages(channelIdx, buffer, SYNC_MAX_ITEMS);
+    return buffer;
+}
+
+// Double hashing: bit_i = h1 + i * h2 (h2 forced odd so all bits are reachable)
+static inline uint32_t bloomBit(uint32_t key, uint32_t salt, uint8_t i) {
+    key ^= salt * 0x85EBCA6Bu;
+    uint32_t h2 = ((key >> 16) | (key << 16)) * 0x9E3779B1u;
+    h2 |= 1;
+    return (key + i * h2) % (SYNC_BLOOM_BYTES * 8);
+}
+
+// =============================================================================
+// MESSAGE KEYS
+// =============================================================================
+
+uint32_t messageKey(uint32_t timestamp, const char* sender, const char* text) {
+    uint32_t hash = 0x811c9dc5;         // FNV-1a offset basis
+    const uint32_t prime = 0x01000193;  // FNV-1a prime
+
+    for (int i = 0; i < 4; i++) {
+        hash ^= (uint8_t)(timestamp >> (i * 8));
+        hash *= prime;
+    }
+    if (sender) {
+        while (*sender) {
+            hash ^= (uint8_t)*sender++;
+            hash *= prime;
+        }
+    }
+    // Separator so "ab"+"c" and "a"+"bc" differ
+    hash ^= 0xFF;
+    hash *= prime;
+    if (text) {
+        while (*text) {
+            hash ^= (uint8_t)*text++;
+            hash *= prime;
+        }
+    }
+    return hash;
+}
+
+// =============================================================================
+// BLOOM SUMMARY
+// =============================================================================
+
+void bloomAdd(uint8_t* bloom, uint32_t key, uint32_t salt) {
+    for (uint8_t i = 0; i < SYNC_BLOOM_HASHES; i++) {
+        uint32_t bit = bloomBit(key, salt, i);
+        bloom[bit >> 3] |= (1 << (bit & 7));
+    }
+}
+
+bool bloomContains(const uint8_t* bloom, uint32_t key, uint32_t salt) {
+    for (uint8_t i = 0; i < SYNC_BLOOM_HASHES; i++) {
+        uint32_t bit = bloomBit(key, salt, i);
+        if (!(bloom[bit >> 3] & (1 << (bit & 7)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool buildSummary(int channelIdx, uint32_t now, Summary& out) {
+    out.clear();
+    out.since = (now > SYNC_WINDOW_SECS) ? now - SYNC_WINDOW_SECS : 0;
+
+    int count = 0;
+    ArchivedMessage* recent = loadRecent(channelIdx, count);
+    if (!recent) return false;
+
+    for (int i = 0; i < count; i++) {
+        if (recent[i].timestamp < out.since) continue;
+        bloomAdd(out.bloom, messageKey(recent[i]), out.since);
+        if (out.count < 255) out.count++;
+    }
+
+    delete[] recent;
+    return true;
+}
+
+int findMissing(int channelIdx, const Summary& remote, ArchivedMessage* out, int maxOut) {
+    if (!out || maxOut <= 0) return 0;
+
+    int count = 0;
+    ArchivedMessage* recent = loadRecent(channelIdx, count);
+    if (!recent) return 0;
+
+    int found = 0;
+    for (int i = 0; i < count && found < maxOut; i++) {
+        const ArchivedMessage& msg = recent[i];
+        if (msg.timestamp < remote.since) continue;
+
+        // Our own sends are archived with a local timestamp, so their key
+        // never matches the copy neighbours archived from the packet
+        if (msg.isOutgoing) continue;
+
+        // Records that cannot fit one packet are never offered
+        if (strlen(msg.sender) + 2 + strlen(msg.text) > SYNC_MAX_RECORD_TEXT) continue;
+
+        if (!bloomContains(remote.bloom, messageKey(msg), remote.since)) {
+            out[found++] = msg;
+        }
+    }
+
+    delete[] recent;
+    return found;
+}
+
+bool hasMessage(int channelIdx, uint32_t key) {
+    int count = 0;
+    ArchivedMessage* recent = loadRecent(channelIdx, count);
+    if (!recent) return false;
+
+    bool found = false;
+    for (int i = 0; i < count; i++) {
+        if (messageKey(recent[i]) == key) {
+            found = true;
+            break;
+        }
+    }
+
+    delete[] recent;
+    return found;
+}
+
+// =============================================================================
+// WIRE FORMAT
+// =============================================================================
+
+size_t encodeSummary(const Summary& summary, uint8_t* buf, size_t bufLen) {
+    if (!buf || bufLen < SYNC_SUMMARY_LEN) return 0;
+    memcpy(buf, &summary.since, 4);
+    buf[4] = summary.count;
+    memcpy(buf + 5, summary.bloom, SYNC_BLOOM_BYTES);
+    return SYNC_SUMMARY_LEN;
+}
+
+bool decodeSummary(const uint8_t* buf, size_t len, Summary& out) {
+    if (!buf || len < SYNC_SUMMARY_LEN) return false;
+    memcpy(&out.since, buf, 4);
+    out.count = buf[4];
+    memcpy(out.bloom, buf + 5, SYNC_BLOOM_BYTES);
+    return true;
+}
+
+} // namespace HistorySync
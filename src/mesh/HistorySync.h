@@ -0,0 +1,128 @@
+/**
+ * MeshBerry Channel History Sync
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Anti-entropy reconciliation of recent channel history between
+ * neighbouring nodes. Each node periodically sends a zero-hop Bloom
+ * filter summary of the messages in its channel archive; neighbours
+ * reply with only the records the summary does not contain.
+ *
+ * This module holds the set logic (message keys, Bloom summaries and
+ * archive lookups). Packet transport and airtime budgeting live in
+ * MeshBerryMesh.
+ */
+
+#ifndef MESHBERRY_HISTORY_SYNC_H
+#define MESHBERRY_HISTORY_SYNC_H
+
+#include <Arduino.h>
+#include "../settings/MessageArchive.h"
+
+namespace HistorySync {
+
+// =============================================================================
+// PROTOCOL CONSTANTS
+// =============================================================================
+
+// Sync traffic is carried in PAYLOAD_TYPE_GRP_DATA packets on the channel:
+// [4-byte timestamp][1-byte SYNC_TAG][1-byte kind][body]
+constexpr uint8_t SYNC_TAG            = 0xB7;
+constexpr uint8_t SYNC_KIND_SUMMARY   = 0x01;   // body: Summary (see encodeSummary)
+constexpr uint8_t SYNC_KIND_RECORD    = 0x02;   // body: [4-byte msg timestamp]["Sender: text"]
+constexpr size_t  SYNC_HEADER_LEN     = 6;
+
+constexpr size_t  SYNC_BLOOM_BYTES    = 64;     // 512-bit filter
+constexpr uint8_t SYNC_BLOOM_HASHES   = 4;      // ~2% false positives at 48 items
+constexpr int     SYNC_MAX_ITEMS      = 48;     // Newest archive entries covered by a summary
+constexpr uint32_t SYNC_WINDOW_SECS   = 24 * 60 * 60;  // Only reconcile the last day
+
+// Largest "Sender: text" body that still fits a group datagram.
+// Longer messages are not reconciled (a truncated copy would never match).
+constexpr size_t  SYNC_MAX_RECORD_TEXT = 150;
+
+/**
+ * Compact set summary of a channel archive
+ */
+struct Summary {
+    uint32_t since;                     // Oldest timestamp covered
+    uint8_t count;                      // Number of keys inserted
+    uint8_t bloom[SYNC_BLOOM_BYTES];    // Bloom filter bits
+
+    void clear() {
+        since = 0;
+        count = 0;
+        memset(bloom, 0, sizeof(bloom));
+    }
+};
+
+// Encoded summary body: [since(4)][count(1)][bloom]
+constexpr size_t SYNC_SUMMARY_LEN = 4 + 1 + SYNC_BLOOM_BYTES;
+
+// =============================================================================
+// MESSAGE KEYS
+// =============================================================================
+
+/**
+ * Compute a node-independent key for a channel message
+ * Uses FNV-1a over timestamp, sender and text (the local channel index
+ * differs between nodes, so it is deliberately not mixed in).
+ */
+uint32_t messageKey(uint32_t timestamp, const char* sender, const char* text);
+
+/**
+ * Compute the key of an archived message
+ */
+inline uint32_t messageKey(const ArchivedMessage& msg) {
+    return messageKey(msg.timestamp, msg.sender, msg.text);
+}
+
+// =============================================================================
+// BLOOM SUMMARY
+// =============================================================================
+
+/**
+ * Bloom filter of a summary
+ * The salt (the summary's `since`) changes every round, so a key that is a
+ * false positive in one summary is very likely caught by the next.
+ */
+void bloomAdd(uint8_t* bloom, uint32_t key, uint32_t salt);
+bool bloomContains(const uint8_t* bloom, uint32_t key, uint32_t salt);
+
+/**
+ * Build a summary of a channel archive
+ * @param channelIdx Local channel index
+ * @param now Current RTC time (defines the reconciliation window)
+ * @param out Summary to fill
+ * @return true if the archive could be read (summary may be empty)
+ */
+bool buildSummary(int channelIdx, uint32_t now, Summary& out);
+
+/**
+ * Find archived messages the remote summary does not contain
+ * @param channelIdx Local channel index
+ * @param remote Summary received from a neighbour
+ * @param out Buffer for missing messages (oldest first)
+ * @param maxOut Capacity of out
+ * @return Number of messages written to out
+ */
+int findMissing(int channelIdx, const Summary& remote, ArchivedMessage* out, int maxOut);
+
+/**
+ * Check whether the local archive already holds a message
+ */
+bool hasMessage(int channelIdx, uint32_t key);
+
+// =============================================================================
+// WIRE FORMAT
+// =============================================================================
+
+size_t encodeSummary(const Summary& summary, uint8_t* buf, size_t bufLen);
+bool decodeSummary(const uint8_t* buf, size_t len, Summary& out);
+
+} // namespace HistorySync
+
+#endif // MESHBERRY_HISTORY_SYNC_H
@@ -21,19 +21,25 @@
  */
 
 #include "MeshBerryMesh.h"
+#include "RelayStats.h"
+#include "RoutePlanner.h"
+#include "TimeSync.h"
 #include "../settings/SettingsManager.h"
+#include "../ui/Emoji.h"
 #include <Utils.h>
 #include <helpers/AdvertDataHelpers.h>
 #include <helpers/TxtDataHelpers.h>
 #include <Packet.h>
 #include <string.h>
 
+// Peer records the table must not evict
+static bool isContactId(uint32_t id) {
+    return SettingsManager::getContactSettings().findContact(id) >= 0;
+}
+
 MeshBerryMesh::MeshBerryMesh(mesh::Radio& radio, mesh::RNG& rng, mesh::RTCClock& rtc,
-                             SimpleMeshTables& tables, StaticPoolPacketManager& mgr)
+                             MeshBerrySeenTable& tables, StaticPoolPacketManager& mgr)
     : mesh::Mesh(radio, _msClock, rng, rtc, mgr, tables)
-    , _nodeCount(0)
-    , _messageCount(0)
-    , _messageHead(0)
     , _msgCallback(nullptr)
     , _nodeCallback(nullptr)
     , _loginCallback(nullptr)
@@ -42,7 +48,46 @@ MeshBerryMesh::MeshBerryMesh(mesh::Radio& radio, mesh::RNG& rng, mesh::RTCClock&
     , _dmCallback(nullptr)
     , _deliveryCallback(nullptr)
     , _repeatCallback(nullptr)
+    , _reactionCallback(nullptr)
+    , _historyCallback(nullptr)
+    , _traceCallback(nullptr)
+    , _historySyncEnabled(false)
+    , _syncNextSummaryAt(0)
+    , _syncChannelCursor(0)
+    , _syncBudget(SYNC_BUDGET_BYTES)
+    , _syncBudgetWindowStart(0)
+    , _syncRecordsSent(0)
+    , _syncRecordsRecovered(0)
+    , _traceTag(0)
+    , _traceSentAt(0)
+    , _traceDeadline(0)
+    , _traceNextAt(0)
+    , _traceAwaiting(false)
+    , _discoverTag(0)
+    , _discoverNextAt(0)
+    , _discoverReplyWindowAt(0)
+    , _discoverReplies(0)
+    , _discoverBurstLeft(0)
+    , _discoverFound(0)
+    , _rxTriageEnabled(true)
+    , _posShareEnabled(false)
+    , _posChannel(0)
+    , _posThresholdM(PositionBeacon::POS_THRESHOLD_DEFAULT_M)
     , _forwardingEnabled(true)
+    , _seenTable(tables)
+    , _cutRingHead(0)
+    , _cutThroughEnabled(true)
+    , _deferHash(0)
+    , _deferPending(false)
+    , _coalesceWindowMs(0)
+    , _coalesceChannel(-1)
+    , _coalesceLen(0)
+    , _coalesceParts(0)
+    , _coalesceFirstAt(0)
+    , _coalesceDueAt(0)
+    , _coalesceSeparateBytes(0)
+    , _resendEnabled(false)
+    , _reactForm(Reaction::REACT_FORM_COMPACT)
     , _connectedRepeaterId(0)
     , _repeaterPermissions(0)
     , _repeaterConnected(false)
@@ -50,14 +95,22 @@ MeshBerryMesh::MeshBerryMesh(mesh::Radio& radio, mesh::RNG& rng, mesh::RTCClock&
     , _loginStartTime(0)
 {
     strcpy(_nodeName, "MeshBerry");
-    memset(_nodes, 0, sizeof(_nodes));
-    memset(_messages, 0, sizeof(_messages));
     memset(_connectedRepeaterName, 0, sizeof(_connectedRepeaterName));
     memset(_repeaterSharedSecret, 0, sizeof(_repeaterSharedSecret));
-    memset(_dmPeers, 0, sizeof(_dmPeers));
-    memset(_pendingDMs, 0, sizeof(_pendingDMs));
-    memset(_channelStats, 0, sizeof(_channelStats));
+    memset(_rxLanes, 0, sizeof(_rxLanes));
+    memset(_rxLaneStats, 0, sizeof(_rxLaneStats));
+    memset(_cutRing, 0, sizeof(_cutRing));
+    memset(&_cutStats, 0, sizeof(_cutStats));
+    memset(&_coalesceStats, 0, sizeof(_coalesceStats));
+    memset(&_resendStats, 0, sizeof(_resendStats));
+    memset(&_reactStats, 0, sizeof(_reactStats));
+    memset(_syncOut, 0, sizeof(_syncOut));
+    memset(_syncLastSummaryAt, 0, sizeof(_syncLastSummaryAt));
+    _trace.clear();
+    memset(_discoverSeen, 0, sizeof(_discoverSeen));
     _lastMatchedDMPeer = -1;
+    _numPeerMatches = 0;
+    _contactAdmit = CONTACT_ADMIT_DEFAULT;
 }
 
 bool MeshBerryMesh::begin() {
@@ -66,7 +119,14 @@ bool MeshBerryMesh::begin() {
     // Initialize the mesh base class
     mesh::Mesh::begin();
 
-    // Try to load persisted identity from SPIFFS
+    // Peer records must exist before the first packet is processed
+    if (!_peers.begin()) {
+        return false;
+    }
+    // Contacts keep their route and secret however many nodes are heard
+    _peers.setPinned(isContactId);
+
+    // Try to load persisted identity from flash
     if (SettingsManager::loadIdentity(self_id)) {
         Serial.println("[MESH] Loaded existing identity");
     } else {
@@ -76,7 +136,7 @@ bool MeshBerryMesh::begin() {
 
         // Persist for future boots
         if (SettingsManager::saveIdentity(self_id)) {
-            Serial.println("[MESH] Identity saved to SPIFFS");
+            Serial.println("[MESH] Identity saved to flash");
         } else {
             Serial.println("[MESH] WARNING: Failed to save identity!");
         }
@@ -93,14 +153,25 @@ bool MeshBerryMesh::begin() {
     Serial.printf("[MESH] Node ID: %02X%02X%02X%02X (hash[0]=0x%02X for response matching)\n",
                   hash[0], hash[1], hash[2], hash[3], hash[0]);
 
+    // Passive topology graph is keyed by 1-byte path hashes
+    Topology::init(self_id.pub_key[0]);
+    RelayStats::init(self_id.pub_key[0]);
+    Reaction::init();
+
+    // Mesh time discipline of the RTC
+    TimeSync::init(static_cast<ESP32RTCClock*>(getRTCClock()));
+
     Serial.println("[MESH] Mesh network started");
     return true;
 }
 
 void MeshBerryMesh::loop() {
-    // Process mesh events
+    // Process mesh events (received packets are queued by onRecvPacket)
     mesh::Mesh::loop();
 
+    // Handle queued RX by priority lane
+    processRxLanes();
+
     // Check for login timeout (10 seconds)
     if (_pendingLoginAttempt > 0 && (millis() - _loginStartTime > 10000)) {
         Serial.println("[MESH] Login timeout - no response from repeater");
@@ -112,6 +183,29 @@ void MeshBerryMesh::loop() {
 
     // Check for DM delivery timeouts
     checkPendingTimeouts();
+
+    // Send held channel text once its coalescing window closes
+    processChannelCoalesce();
+
+    // Resend channel packets nobody was heard relaying
+    processChannelResend();
+
+    // Channel history reconciliation (no-op unless enabled)
+    processHistorySync();
+
+    // Traceroute/ping probe scheduling
+    processTrace();
+
+    // Neighbour discovery burst
+    processDiscovery();
+
+    // Age out stale topology edges and persist the graph
+    Topology::maintain(getRTCClock()->getCurrentTime());
+    RelayStats::maintain();
+    Reaction::maintain();
+
+    // Slew the RTC and run time-sync discipline rounds
+    TimeSync::maintain();
 }
 
 void MeshBerryMesh::setNodeName(const char* name) {
@@ -162,6 +256,27 @@ bool MeshBerryMesh::sendToChannel(int channelIdx, const char* text) {
         return false;
     }
 
+    // Hold for merging with the next few lines
+    if (_coalesceWindowMs > 0 && queueChannelCoalesce(channelIdx, text)) {
+        return true;
+    }
+
+    // Anything held for another channel goes first, to keep send order
+    flushChannelCoalesce();
+
+    if (!sendChannelText(channelIdx, text)) {
+        return false;
+    }
+
+    // Track this message for repeat counting (use text without sender prefix)
+    trackSentChannelMessage(channelIdx, text);
+    return true;
+}
+
+bool MeshBerryMesh::sendChannelText(int channelIdx, const char* text) {
+    ChannelSettings& chSettings = SettingsManager::getChannelSettings();
+    if (channelIdx < 0 || channelIdx >= chSettings.numChannels) return false;
+
     const ChannelEntry& entry = chSettings.channels[channelIdx];
 
     // Debug: Print channel info for troubleshooting
@@ -217,16 +332,367 @@ bool MeshBerryMesh::sendToChannel(int channelIdx, const char* text) {
         return false;
     }
 
+    // Note which repeaters carry it
+    RelayStats::noteSent(packetHash32(pkt));
+
+    // Watch for a relay, to resend once if none is heard
+    if (_resendEnabled) {
+        watchChannelResend(channelIdx, pkt, payload, totalLen);
+    }
+
     // Send with flood routing
     sendFlood(pkt);
 
-    // Track this message for repeat counting (use text without sender prefix)
+    Serial.printf("[MESH] Sent to channel %s: %s\n", entry.name, text);
+    return true;
+}
+
+// =============================================================================
+// CHANNEL SEND COALESCING
+// =============================================================================
+//
+// People often type three or four short lines in a row. Each would be its
+// own flood with its own header, MAC, AES padding and a full round of
+// repeats. With a window set, sendToChannel() holds the text and appends
+// further lines to the same channel until the window passes with no new
+// line (at most twice the window from the first), the channel changes,
+// or the next line would not fit one packet. The parts share one
+// "Name: " prefix and are joined with COALESCE_SEP; other clients show
+// them as "» " lines of one message.
+
+// On-air bytes of a GRP_TXT flood carrying len plaintext bytes, before
+// any path: header, path length, channel hash, MAC, padded ciphertext
+static size_t channelTxtAirBytes(size_t len) {
+    return 3 + CIPHER_MAC_SIZE + ((len + CIPHER_BLOCK_SIZE - 1) / CIPHER_BLOCK_SIZE) * CIPHER_BLOCK_SIZE;
+}
+
+size_t MeshBerryMesh::channelPrefixLen() const {
+    // Matches the snprintf into 32 bytes in sendChannelText()
+    size_t len = strlen(_nodeName) + 2;
+    return len > 31 ? 31 : len;
+}
+
+void MeshBerryMesh::setChannelCoalesceWindow(uint16_t windowMs) {
+    if (windowMs > COALESCE_MAX_WINDOW_MS) windowMs = COALESCE_MAX_WINDOW_MS;
+    _coalesceWindowMs = windowMs;
+    if (windowMs == 0) {
+        flushChannelCoalesce();
+    }
+    Serial.printf("[COALESCE] Window %u ms%s\n", windowMs, windowMs ? "" : " (off)");
+}
+
+bool MeshBerryMesh::queueChannelCoalesce(int channelIdx, const char* text) {
+    size_t textLen = strlen(text);
+    size_t sepLen = strlen(COALESCE_SEP);
+    size_t fixedLen = 5 + channelPrefixLen();
+
+    // Lines too long for a packet alone, or that would split wrongly on receive
+    if (fixedLen + textLen > CHANNEL_TXT_MAX_PAYLOAD || strstr(text, COALESCE_SEP)) {
+        return false;
+    }
+
+    if (_coalesceChannel >= 0 &&
+        (_coalesceChannel != channelIdx ||
+         fixedLen + _coalesceLen + sepLen + textLen > CHANNEL_TXT_MAX_PAYLOAD)) {
+        flushChannelCoalesce();
+    }
+
+    uint32_t now = millis();
+    if (_coalesceChannel < 0) {
+        _coalesceChannel = channelIdx;
+        _coalesceLen = 0;
+        _coalesceParts = 0;
+        _coalesceFirstAt = now;
+        _coalesceSeparateBytes = 0;
+    } else {
+        memcpy(&_coalesceText[_coalesceLen], COALESCE_SEP, sepLen);
+        _coalesceLen += sepLen;
+    }
+    memcpy(&_coalesceText[_coalesceLen], text, textLen);
+    _coalesceLen += textLen;
+    _coalesceText[_coalesceLen] = '\0';
+    _coalesceParts++;
+    _coalesceSeparateBytes += channelTxtAirBytes(fixedLen + textLen);
+
+    // Wait for another line, but never hold the first one too long
+    _coalesceDueAt = now + _coalesceWindowMs;
+    if ((int32_t)(_coalesceDueAt - (_coalesceFirstAt + 2 * _coalesceWindowMs)) > 0) {
+        _coalesceDueAt = _coalesceFirstAt + 2 * _coalesceWindowMs;
+    }
+
+    // Repeats are matched per part, as if each had been sent alone
     trackSentChannelMessage(channelIdx, text);
+    _coalesceStats.messages++;
+    return true;
+}
 
-    Serial.printf("[MESH] Sent to channel %s: %s\n", entry.name, text);
+void MeshBerryMesh::flushChannelCoalesce() {
+    if (_coalesceChannel < 0) return;
+
+    int channelIdx = _coalesceChannel;
+    _coalesceChannel = -1;
+
+    if (!sendChannelText(channelIdx, _coalesceText)) {
+        Serial.printf("[COALESCE] Failed to send %d held message(s)\n", _coalesceParts);
+        return;
+    }
+
+    _coalesceStats.packets++;
+    size_t merged = channelTxtAirBytes(5 + channelPrefixLen() + _coalesceLen);
+    if (_coalesceSeparateBytes > merged) {
+        _coalesceStats.bytesSaved += _coalesceSeparateBytes - merged;
+    }
+    if (_coalesceParts > 1) {
+        Serial.printf("[COALESCE] %d messages in one packet (%u vs %lu bytes)\n",
+                      _coalesceParts, (unsigned)merged, (unsigned long)_coalesceSeparateBytes);
+    }
+}
+
+void MeshBerryMesh::processChannelCoalesce() {
+    if (_coalesceChannel < 0) return;
+    if ((int32_t)(millis() - _coalesceDueAt) < 0) return;
+    flushChannelCoalesce();
+}
+
+// =============================================================================
+// CHANNEL AUTO-RESEND
+// =============================================================================
+//
+// Repeat tracking already tells us when some node rebroadcasts our channel
+// packet. With resend on, a packet nobody was heard relaying within
+// channelResendWindow() (plus jitter, so neighbours that lost the same
+// collision do not resend in step) goes out once more. The copy is
+// rebuilt from the kept plaintext with the original timestamp, so it
+// encrypts to the same bytes and has the same packet hash: a relay that
+// did forward the first one, out of our earshot, drops it, and receivers
+// that already have it drop it in the seen table. deliverChannelText()
+// also drops a repeat of the same sender and text, for copies the seen
+// table has lost.
+
+void MeshBerryMesh::setChannelResend(bool enabled) {
+    _resendEnabled = enabled;
+    if (!enabled) {
+        _pendingResends.clear();
+    }
+    Serial.printf("[RESEND] Channel auto-resend %s\n", enabled ? "on" : "off");
+}
+
+uint32_t MeshBerryMesh::channelResendWindow(size_t rawLen) {
+    // Our transmission, a relay's random hold (MeshCore waits up to five
+    // half-airtime slots) and the relay's transmission
+    return RESEND_BASE_MS + RESEND_AIRTIME_FACTOR * _radio->getEstAirtimeFor(rawLen);
+}
+
+void MeshBerryMesh::watchChannelResend(int channelIdx, const mesh::Packet* pkt,
+                                       const uint8_t* payload, size_t len) {
+    if (len > sizeof(PendingResend::payload)) return;
+
+    uint32_t airtime = _radio->getEstAirtimeFor(pkt->getRawLength());
+    PendingResend& pending = _pendingResends.at(_pendingResends.acquire(packetHash32(pkt)));
+    pending.dueAt = millis() + RESEND_BASE_MS + RESEND_AIRTIME_FACTOR * airtime +
+                    getRNG()->nextInt(0, RESEND_JITTER_FACTOR * airtime + 1);
+    pending.channelIdx = channelIdx;
+    pending.channelHash = pkt->payload[0];
+    pending.resent = false;
+    pending.payloadLen = len;
+    memcpy(pending.payload, payload, len);
+    _resendStats.watched++;
+}
+
+void MeshBerryMesh::processChannelResend() {
+    if (_pendingResends.size() == 0) return;
+
+    uint32_t now = millis();
+    for (int i = 0; i < MAX_PENDING_RESENDS; i++) {
+        if (!_pendingResends.used(i)) continue;
+        PendingResend& pending = _pendingResends.at(i);
+        if ((int32_t)(now - pending.dueAt) < 0) continue;
+
+        // Resent and still nothing heard: give up
+        if (pending.resent) {
+            _pendingResends.erase(i);
+            continue;
+        }
+
+        mesh::GroupChannel channel;
+        if (!buildGroupChannel(pending.channelIdx, channel)) {
+            _pendingResends.erase(i);
+            continue;
+        }
+        channel.hash[0] = pending.channelHash;
+
+        mesh::Packet* pkt = createGroupDatagram(0x05, channel, pending.payload, pending.payloadLen);
+        if (!pkt) {
+            Serial.println("[RESEND] Failed to create resend packet");
+            _pendingResends.erase(i);
+            continue;
+        }
+        uint32_t window = channelResendWindow(pkt->getRawLength());
+        sendFlood(pkt);
+
+        // Keep watching, to count a relay of the copy as a rescue
+        pending.resent = true;
+        pending.dueAt = now + window;
+        _resendStats.resent++;
+        _resendStats.resendAirBytes += channelTxtAirBytes(pending.payloadLen);
+        Serial.printf("[RESEND] No relay heard on ch=%d, resent (%u bytes)\n",
+                      pending.channelIdx, (unsigned)pending.payloadLen);
+    }
+}
+
+void MeshBerryMesh::noteChannelRelay(uint32_t packetHash) {
+    int slot = _pendingResends.find(packetHash);
+    if (slot == _pendingResends.NONE) return;
+
+    if (_pendingResends.at(slot).resent) {
+        _resendStats.rescued++;
+        Serial.println("[RESEND] Relay heard after resend");
+    } else {
+        _resendStats.relayed++;
+    }
+    _pendingResends.erase(slot);
+}
+
+bool MeshBerryMesh::isDuplicateChannelText(const mesh::Packet* packet, int channelIdx,
+                                           const char* text) {
+    uint32_t now = millis();
+    uint32_t hash = hashChannelMessage(channelIdx, text);
+
+    // Long enough for the sender's resend and its relays to reach us
+    uint32_t window = 2 * channelResendWindow(packet->getRawLength());
+
+    bool created;
+    int slot = _recentChannelText.acquire(hash, &created);
+    uint32_t& heardAt = _recentChannelText.at(slot);
+    if (!created && (now - heardAt) <= window) {
+        _resendStats.duplicates++;
+        Serial.printf("[RESEND] Dropped repeat of ch=%d hash=%08X\n", channelIdx, hash);
+        return true;
+    }
+    heardAt = now;
+    return false;
+}
+
+// =============================================================================
+// EMOJI REACTIONS
+// =============================================================================
+//
+// A reaction names its message by Reaction::refHash() and goes out either
+// as text ("<emoji>^1a2b3c", readable by every client) or as a one-block
+// GRP_DATA datagram. A plain "Name: <emoji>" reply takes two AES blocks
+// once the name passes five characters, so compact is what saves airtime;
+// the text form mostly buys the badge. Text-form reactors are known by a
+// hash of their name, compact ones by node id.
+
+size_t MeshBerryMesh::compactReactionAirBytes() {
+    // GRP_DATA frames exactly like GRP_TXT
+    return channelTxtAirBytes(Reaction::REACT_PAYLOAD_LEN);
+}
+
+bool MeshBerryMesh::sendChannelReaction(int channelIdx, uint32_t ref, uint16_t emoji) {
+    const EmojiEntry* e = Emoji::getByIndex(emoji);
+    if (!e) return false;
+
+    char plain[8];
+    size_t plainLen = Emoji::encodeUTF8(e->codepoint, plain);
+    size_t airBytes;
+    uint32_t reactor;
+
+    if (_reactForm == Reaction::REACT_FORM_COMPACT) {
+        mesh::GroupChannel channel;
+        if (!buildGroupChannel(channelIdx, channel)) return false;
+
+        uint8_t payload[Reaction::REACT_PAYLOAD_LEN];
+        size_t len = Reaction::encodePacket(getRTCClock()->getCurrentTime(), ref, emoji,
+                                            getSelfId(), payload);
+        mesh::Packet* pkt = createGroupDatagram(PAYLOAD_TYPE_GRP_DATA, channel, payload, len);
+        if (!pkt) {
+            Serial.println("[REACT] Failed to create reaction packet");
+            return false;
+        }
+        sendFlood(pkt);
+        airBytes = channelTxtAirBytes(len);
+        reactor = getSelfId();
+    } else {
+        char body[Reaction::REACT_TEXT_MAX];
+        size_t len = Reaction::formatText(ref, emoji, body);
+
+        // Keep send order with anything held for coalescing
+        flushChannelCoalesce();
+        if (!sendChannelText(channelIdx, body)) return false;
+        airBytes = channelTxtAirBytes(5 + channelPrefixLen() + len);
+        reactor = Reaction::refHash(_nodeName, nullptr);
+    }
+
+    _reactStats.sent++;
+    _reactStats.sentAirBytes += airBytes;
+    _reactStats.plainAirBytes += channelTxtAirBytes(5 + channelPrefixLen() + plainLen);
+
+    Reaction::apply(Reaction::channelScope(channelIdx), ref, emoji, reactor);
+    Serial.printf("[REACT] Ch%d :%s: -> %06lX (%s, %u bytes)\n", channelIdx, e->shortcode,
+                  (unsigned long)ref,
+                  _reactForm == Reaction::REACT_FORM_COMPACT ? "compact" : "text",
+                  (unsigned)airBytes);
+    return true;
+}
+
+bool MeshBerryMesh::sendDirectReaction(uint32_t contactId, uint32_t ref, uint16_t emoji) {
+    const EmojiEntry* e = Emoji::getByIndex(emoji);
+    if (!e) return false;
+
+    char body[Reaction::REACT_TEXT_MAX];
+    size_t len = Reaction::formatText(ref, emoji, body);
+    if (!sendDirectMessage(contactId, body)) return false;
+
+    // DMs pad like channel text: header and MAC cancel out of the comparison
+    char plain[8];
+    size_t plainLen = Emoji::encodeUTF8(e->codepoint, plain);
+    _reactStats.sent++;
+    _reactStats.sentAirBytes += channelTxtAirBytes(5 + len);
+    _reactStats.plainAirBytes += channelTxtAirBytes(5 + plainLen);
+
+    Reaction::apply(contactId, ref, emoji, getSelfId());
+    Serial.printf("[REACT] DM %08X :%s: -> %06lX\n", contactId, e->shortcode, (unsigned long)ref);
+    return true;
+}
+
+bool MeshBerryMesh::onReactionText(int channelIdx, uint32_t contactId, const char* sender, const char* text) {
+    uint32_t ref;
+    uint16_t emoji;
+    if (!Reaction::parseText(text, &ref, &emoji)) return false;
+
+    bool changed;
+    if (channelIdx >= 0) {
+        changed = Reaction::apply(Reaction::channelScope(channelIdx), ref, emoji,
+                                  Reaction::refHash(sender, nullptr));
+    } else {
+        changed = Reaction::apply(contactId, ref, emoji, contactId);
+    }
+    _reactStats.received++;
+    Serial.printf("[REACT] %s reacted to %06lX (ch=%d)\n", sender, (unsigned long)ref, channelIdx);
+
+    if (changed && _reactionCallback) {
+        _reactionCallback(channelIdx, channelIdx >= 0 ? 0 : contactId);
+    }
     return true;
 }
 
+void MeshBerryMesh::onReactionPacket(int channelIdx, const uint8_t* data, size_t len) {
+    uint32_t ref, senderId;
+    uint16_t emoji;
+    if (!Reaction::decodePacket(data, len, &ref, &emoji, &senderId)) return;
+    if (senderId == getSelfId()) return;
+
+    bool changed = Reaction::apply(Reaction::channelScope(channelIdx), ref, emoji, senderId);
+    _reactStats.received++;
+    Serial.printf("[REACT] %08X reacted to %06lX (ch=%d, compact)\n",
+                  senderId, (unsigned long)ref, channelIdx);
+
+    if (changed && _reactionCallback) {
+        _reactionCallback(channelIdx, 0);
+    }
+}
+
 void MeshBerryMesh::sendAdvertisement() {
     // Build advertisement using MeshCore's AdvertDataBuilder
     uint8_t app_data[MAX_ADVERT_DATA_SIZE];
@@ -242,51 +708,109 @@ void MeshBerryMesh::sendAdvertisement() {
 }
 
 bool MeshBerryMesh::getNodeInfo(int index, NodeInfo& info) const {
-    if (index < 0 || index >= _nodeCount) return false;
-    info = _nodes[index];
+    if (index < 0) return false;
+    // Index 0 is the most recently heard or used node
+    for (int s = _peers.newest(); s != PeerTable::NONE; s = _peers.older(s)) {
+        if (index-- == 0) {
+            peerToNodeInfo(s, info);
+            return true;
+        }
+    }
+    return false;
+}
+
+int MeshBerryMesh::firstNode(NodeInfo& info) const {
+    int s = _peers.newest();
+    if (s != PeerTable::NONE) peerToNodeInfo(s, info);
+    return s;
+}
+
+int MeshBerryMesh::nextNode(int cursor, NodeInfo& info) const {
+    int s = _peers.older(cursor);
+    if (s != PeerTable::NONE) peerToNodeInfo(s, info);
+    return s;
+}
+
+bool MeshBerryMesh::findNode(uint32_t id, NodeInfo& info) const {
+    int slot = _peers.find(id);
+    if (slot == PeerTable::NONE) return false;
+    peerToNodeInfo(slot, info);
     return true;
 }
 
-bool MeshBerryMesh::getMessage(int index, Message& msg) const {
-    if (index < 0 || index >= _messageCount) return false;
+bool MeshBerryMesh::findNodeByName(const char* namePrefix, NodeInfo& info) const {
+    if (!namePrefix || namePrefix[0] == '\0') return false;
+    size_t prefixLen = strlen(namePrefix);
+    for (int s = _peers.newest(); s != PeerTable::NONE; s = _peers.older(s)) {
+        if (strncasecmp(_peers.cold(s).name, namePrefix, prefixLen) == 0) {
+            peerToNodeInfo(s, info);
+            return true;
+        }
+    }
+    return false;
+}
+
+void MeshBerryMesh::peerToNodeInfo(int slot, NodeInfo& info) const {
+    const PeerHot& h = _peers.hot(slot);
+    const PeerCold& cold = _peers.cold(slot);
+    info.id = h.id;
+    memcpy(info.name, cold.name, sizeof(info.name));
+    info.type = (NodeType)h.type;
+    info.rssi = h.rssi;
+    info.snr = h.snr;
+    info.lastHeard = h.lastHeard;
+    info.hasLocation = (h.flags & PEER_HAS_LOCATION) != 0;
+    info.latitude = cold.latitude;
+    info.longitude = cold.longitude;
+}
+
+int MeshBerryMesh::getPathLen(uint32_t id) const {
+    int slot = _peers.find(id);
+    if (slot == PeerTable::NONE) return -1;
+    const PeerHot& h = _peers.hot(slot);
+    return isPathValid(h.outPathLen, h.pathLearnedAt) ? h.outPathLen : -1;
+}
 
-    // Calculate actual index in circular buffer
-    int actualIndex = (_messageHead - _messageCount + index + MAX_MESSAGES) % MAX_MESSAGES;
-    msg = _messages[actualIndex];
+bool MeshBerryMesh::getMessage(int index, Message& msg) const {
+    if (index < 0 || index >= (int)_messages.size()) return false;
+    msg = _messages[index];
     return true;
 }
 
 void MeshBerryMesh::addMessage(const Message& msg) {
-    _messages[_messageHead] = msg;
-    _messageHead = (_messageHead + 1) % MAX_MESSAGES;
-
-    if (_messageCount < MAX_MESSAGES) {
-        _messageCount++;
-    }
+    _messages.push(msg);
 
     if (_msgCallback) {
         _msgCallback(msg);
     }
 }
 
-void MeshBerryMesh::updateNode(const NodeInfo& node) {
-    // Check if node already exists
-    for (int i = 0; i < _nodeCount; i++) {
-        if (_nodes[i].id == node.id) {
-            _nodes[i] = node;
-            if (_nodeCallback) {
-                _nodeCallback(node);
-            }
-            return;
-        }
+void MeshBerryMesh::updateNode(const NodeInfo& node, const uint8_t* pubKey) {
+    // Find or add the record (evicts the least recently used when full)
+    int slot = acquirePeer(node.id);
+    PeerHot& h = _peers.hot(slot);
+    PeerCold& cold = _peers.cold(slot);
+
+    memcpy(cold.name, node.name, sizeof(cold.name));
+    cold.name[sizeof(cold.name) - 1] = '\0';
+    h.type = node.type;
+    h.rssi = node.rssi;
+    h.snr = node.snr;
+    h.lastHeard = node.lastHeard;
+    h.flags |= PEER_HEARD;
+    if (node.hasLocation) {
+        cold.latitude = node.latitude;
+        cold.longitude = node.longitude;
+        h.flags |= PEER_HAS_LOCATION;
+    } else {
+        h.flags &= ~PEER_HAS_LOCATION;
+    }
+    if (pubKey) {
+        _peers.setKey(slot, pubKey);
     }
 
-    // Add new node
-    if (_nodeCount < MAX_TRACKED_NODES) {
-        _nodes[_nodeCount++] = node;
-        if (_nodeCallback) {
-            _nodeCallback(node);
-        }
+    if (_nodeCallback) {
+        _nodeCallback(node);
     }
 }
 
@@ -369,7 +893,29 @@ void MeshBerryMesh::onAdvertRecv(mesh::Packet* packet, const mesh::Identity& id,
     node.snr = packet->getSNR();
     node.lastHeard = timestamp;
 
-    updateNode(node);
+    updateNode(node, id.pub_key);
+
+    // Time sync: advert timestamps are signed by the sender; nodes that
+    // advertise a position are most likely running on GPS time
+    TimeSync::addSample(id.pub_key[0], timestamp,
+                        packet->isRouteFlood() ? packet->path_len : 0,
+                        node.hasLocation);
+
+    // Topology: advertiser -> repeaters -> us (path excludes the origin)
+    {
+        uint32_t now = getRTCClock()->getCurrentTime();
+        uint8_t chain[MAX_PATH_SIZE + 2];
+        uint8_t chainLen = 0;
+        chain[chainLen++] = id.pub_key[0];
+        if (packet->isRouteFlood()) {
+            for (uint8_t i = 0; i < packet->path_len && i < MAX_PATH_SIZE; i++) {
+                chain[chainLen++] = packet->path[i];
+            }
+        }
+        chain[chainLen++] = self_id.pub_key[0];
+        Topology::observeChain(chain, chainLen, packet->getSNR(), true, now);
+        Topology::observeNode(id.pub_key[0], node.id, node.name, node.type, now);
+    }
 
     // Copy pubKey to local buffer BEFORE any other processing
     // This ensures we have a stable copy that won't be affected by any callbacks
@@ -403,9 +949,19 @@ void MeshBerryMesh::onAdvertRecv(mesh::Packet* packet, const mesh::Identity& id,
                       pubKeyCopy[0], pubKeyCopy[1], pubKeyCopy[2], pubKeyCopy[3],
                       pubKeyCopy[4], pubKeyCopy[5], pubKeyCopy[6], pubKeyCopy[7]);
 
+        // Known contacts are refreshed in place; other nodes stay in the
+        // peer table unless an admission rule lets adverts add them
         ContactSettings& contacts = SettingsManager::getContactSettings();
-        int idx = contacts.addOrUpdateContact(node, pubKeyCopy);
-        SettingsManager::saveContacts();
+        bool changed = false;
+        int idx = contacts.updateContact(node, pubKeyCopy, &changed);
+        if (idx < 0 && ((_contactAdmit & CONTACT_ADMIT_ADVERTS) ||
+                        ((_contactAdmit & CONTACT_ADMIT_REPEATERS) && node.type == NODE_TYPE_REPEATER))) {
+            idx = contacts.addOrUpdateContact(node, pubKeyCopy);
+            changed = (idx >= 0);
+        }
+        if (changed) {
+            SettingsManager::saveContacts();
+        }
 
         // Debug: verify pubKey was saved correctly
         if (idx >= 0) {
@@ -521,7 +1077,258 @@ void MeshBerryMesh::onAnonDataRecv(mesh::Packet* packet, const uint8_t* secret,
     Serial.printf("[MESH] Message from %08X: %s\n", msg.senderId, msg.text);
 }
 
+// =============================================================================
+// RX TRIAGE
+// =============================================================================
+//
+// The dispatcher hands us each packet straight after header parse. Rather
+// than process it in arrival order, it is held (ACTION_MANUAL_HOLD) in one
+// of three lanes and drained from loop():
+//
+//   LOCAL   - ACKs, peer datagrams addressed to us, trace/control replies.
+//             Drained completely every pass.
+//   FORWARD - channel floods and packets we only relay. A few per pass.
+//   ADVERT  - signature verify plus contact save, the most expensive work.
+//             Only when the other lanes are empty, or once one has waited
+//             RX_ADVERT_MAX_WAIT_MS.
+//
+// A full lane falls back to inline processing, so triage never drops.
+
+RxLane MeshBerryMesh::classifyRx(const mesh::Packet* pkt) const {
+    uint8_t type = pkt->getPayloadType();
+
+    if (type == PAYLOAD_TYPE_ADVERT) return RX_LANE_ADVERT;
+
+    // ACKs are tiny and gate DM delivery state; never make them wait
+    if (type == PAYLOAD_TYPE_ACK) return RX_LANE_LOCAL;
+    if (type == PAYLOAD_TYPE_MULTIPART && pkt->payload_len >= 1 &&
+        (pkt->payload[0] & 0x0F) == PAYLOAD_TYPE_ACK) {
+        return RX_LANE_LOCAL;
+    }
+
+    // Direct packets with hops left are relays, whoever they are for
+    bool atDestination = pkt->isRouteFlood() || pkt->path_len == 0;
+
+    // Peer datagrams start with [dest hash][src hash]
+    if (atDestination && pkt->payload_len >= 2 &&
+        (type == PAYLOAD_TYPE_TXT_MSG || type == PAYLOAD_TYPE_REQ ||
+         type == PAYLOAD_TYPE_RESPONSE || type == PAYLOAD_TYPE_PATH ||
+         type == PAYLOAD_TYPE_ANON_REQ) &&
+        self_id.isHashMatch(pkt->payload)) {
+        return RX_LANE_LOCAL;
+    }
+
+    // Our own traceroute probes coming back, and zero-hop discovery
+    if (type == PAYLOAD_TYPE_TRACE && _trace.running) return RX_LANE_LOCAL;
+    if (type == PAYLOAD_TYPE_CONTROL) return RX_LANE_LOCAL;
+
+    return RX_LANE_FORWARD;
+}
+
+void MeshBerryMesh::setRxTriageEnabled(bool enabled) {
+    if (!enabled) {
+        // Nothing may stay held once triage is off
+        for (int lane = 0; lane < RX_LANE_COUNT; lane++) {
+            while (drainRxLane((RxLane)lane)) {}
+        }
+    }
+    _rxTriageEnabled = enabled;
+    Serial.printf("[RXQ] Triage %s\n", enabled ? "enabled" : "disabled");
+}
+
+void MeshBerryMesh::resetRxLaneStats() {
+    memset(_rxLaneStats, 0, sizeof(_rxLaneStats));
+}
+
+bool MeshBerryMesh::hasQueuedRx() const {
+    for (int lane = 0; lane < RX_LANE_COUNT; lane++) {
+        if (_rxLanes[lane].count > 0) return true;
+    }
+    return false;
+}
+
+bool MeshBerryMesh::drainRxLane(RxLane lane) {
+    RxLaneQueue& q = _rxLanes[lane];
+    if (q.count == 0) return false;
+
+    mesh::Packet* pkt = q.pkts[q.head];
+    uint32_t queuedAt = q.queuedAt[q.head];
+    q.head = (q.head + 1) % RX_LANE_DEPTH;
+    q.count--;
+
+    RxLaneStats& st = _rxLaneStats[lane];
+    uint32_t start = millis();
+    uint32_t wait = start - queuedAt;
+    st.waitTotalMs += wait;
+    if (wait > st.waitMaxMs) st.waitMaxMs = wait;
+
+    applyRxAction(pkt, handleRecvPacket(pkt));
+
+    st.busyTotalMs += millis() - start;
+    st.processed++;
+    return true;
+}
+
+void MeshBerryMesh::applyRxAction(mesh::Packet* pkt, mesh::DispatcherAction action) {
+    // Same handling as the dispatcher gives a packet it processed itself
+    if (action == ACTION_RELEASE) {
+        releasePacket(pkt);
+    } else if (action == ACTION_MANUAL_HOLD) {
+        // Handler kept the packet
+    } else {
+        uint8_t priority = (action >> 24) - 1;
+        uint32_t delay = action & 0xFFFFFF;
+        _mgr->queueOutbound(pkt, priority, futureMillis(delay));
+    }
+}
+
+void MeshBerryMesh::processRxLanes() {
+    // Everything addressed to us, however much arrived
+    while (drainRxLane(RX_LANE_LOCAL)) {}
+
+    // Relays and channel traffic, a few per pass so the radio keeps turning
+    for (int i = 0; i < RX_FORWARD_PER_PASS; i++) {
+        if (!drainRxLane(RX_LANE_FORWARD)) break;
+    }
+
+    // One advert per pass when idle, or when the oldest has waited too long
+    const RxLaneQueue& adverts = _rxLanes[RX_LANE_ADVERT];
+    if (adverts.count > 0) {
+        bool idle = _rxLanes[RX_LANE_FORWARD].count == 0;
+        bool overdue = millis() - adverts.queuedAt[adverts.head] >= RX_ADVERT_MAX_WAIT_MS;
+        if (idle || overdue) {
+            drainRxLane(RX_LANE_ADVERT);
+        }
+    }
+}
+
+// =============================================================================
+// CUT-THROUGH FORWARDING
+// =============================================================================
+//
+// MeshCore decides to relay a flood only at the end of Mesh::onRecvPacket(),
+// after filterRecvFloodPacket() decrypt attempts, channel/peer handling and
+// any archive writes, and with triage after the packet has waited its turn.
+// For floods we only relay, the decision needs nothing but the header, so a
+// copy is queued for retransmit as soon as the packet arrives. The original
+// still goes through local processing; when MeshCore reaches its own relay
+// decision, allowPacketForward() finds the packet in the cut-through ring
+// and declines, so it is sent once.
+
+uint32_t MeshBerryMesh::packetHash32(const mesh::Packet* pkt) {
+    // Same hash as the seen table (path excluded, so relays match)
+    uint8_t hash[MAX_HASH_SIZE];
+    pkt->calculatePacketHash(hash);
+    uint32_t h;
+    memcpy(&h, hash, 4);
+    return h;
+}
+
+MeshBerryMesh::CutEntry* MeshBerryMesh::findCutEntry(uint32_t hash) {
+    for (int i = 0; i < CUT_RING_SIZE; i++) {
+        if (_cutRing[i].at != 0 && _cutRing[i].hash == hash) return &_cutRing[i];
+    }
+    return nullptr;
+}
+
+void MeshBerryMesh::cutThrough(mesh::Packet* pkt) {
+    // Same preconditions as MeshCore's routeRecvPacket()
+    if (!_cutThroughEnabled || !_forwardingEnabled) return;
+    if (!pkt->isRouteFlood() || pkt->getPayloadVer() != PAYLOAD_VER_1) return;
+    if (pkt->isMarkedDoNotRetransmit()) return;
+    if (pkt->path_len + PATH_HASH_SIZE > MAX_PATH_SIZE) return;
+
+    // Only types MeshCore relays unconditionally. Adverts are relayed once
+    // their signature verifies, so they take the normal path. ACKs never
+    // reach here: classifyRx() keeps them in the local lane.
+    switch (pkt->getPayloadType()) {
+        case PAYLOAD_TYPE_REQ:
+        case PAYLOAD_TYPE_RESPONSE:
+        case PAYLOAD_TYPE_TXT_MSG:
+        case PAYLOAD_TYPE_PATH:
+        case PAYLOAD_TYPE_ANON_REQ:
+        case PAYLOAD_TYPE_GRP_TXT:
+        case PAYLOAD_TYPE_GRP_DATA:
+            break;
+        default:
+            return;
+    }
+
+    uint32_t hash = packetHash32(pkt);
+    if (findCutEntry(hash)) {
+        _cutStats.duplicates++;
+        return;
+    }
+
+    // Our own floods and anything already processed are in the seen table.
+    // peek() leaves it untouched for MeshCore's own hasSeen() later.
+    if (_seenTable.peek(pkt)) return;
+
+    mesh::Packet* copy = obtainNewPacket();
+    if (!copy) {
+        _cutStats.noPacket++;
+        return;
+    }
+    uint8_t raw[MAX_TRANS_UNIT];
+    uint8_t rawLen = pkt->writeTo(raw);
+    if (!copy->readFrom(raw, rawLen)) {
+        releasePacket(copy);
+        return;
+    }
+
+    // The relay is decided here, so the source's budget is charged here.
+    // A drop is still recorded so the normal path declines it too.
+    bool dropped = limitForward(pkt) == ForwardLimiter::FL_DROP;
+
+    CutEntry& e = _cutRing[_cutRingHead];
+    e.hash = hash;
+    e.at = millis() | 1;    // 0 marks an empty slot
+    e.dropped = dropped;
+    _cutRingHead = (_cutRingHead + 1) % CUT_RING_SIZE;
+
+    if (dropped) {
+        releasePacket(copy);
+        return;
+    }
+
+    // Append our hash and schedule exactly as routeRecvPacket() would
+    copy->path_len += self_id.copyHashTo(&copy->path[copy->path_len]);
+    uint32_t delay = getRetransmitDelay(copy);
+    _mgr->queueOutbound(copy, copy->path_len, futureMillis(delay));
+    _cutStats.relayed++;
+}
+
 mesh::DispatcherAction MeshBerryMesh::onRecvPacket(mesh::Packet* pkt) {
+    RxLane lane = classifyRx(pkt);
+
+    // Only packets we relay; local traffic is left to MeshCore as before
+    if (lane == RX_LANE_FORWARD) {
+        cutThrough(pkt);
+    }
+
+    if (!_rxTriageEnabled) {
+        return handleRecvPacket(pkt);
+    }
+
+    RxLaneQueue& q = _rxLanes[lane];
+    RxLaneStats& st = _rxLaneStats[lane];
+
+    if (q.count >= RX_LANE_DEPTH) {
+        // Lane full: process now rather than drop or starve the packet pool
+        st.bypassed++;
+        return handleRecvPacket(pkt);
+    }
+
+    uint8_t tail = (q.head + q.count) % RX_LANE_DEPTH;
+    q.pkts[tail] = pkt;
+    q.queuedAt[tail] = millis();
+    q.count++;
+    st.queued++;
+    if (q.count > st.depthMax) st.depthMax = q.count;
+    return ACTION_MANUAL_HOLD;
+}
+
+mesh::DispatcherAction MeshBerryMesh::handleRecvPacket(mesh::Packet* pkt) {
     // INTERCEPT: Handle DIRECT-routed ACKs that MeshCore would skip
     // MeshCore's Mesh.cpp (lines 80-90) returns ACTION_RELEASE without calling onAckRecv()
     // for DIRECT ACKs, so we extract the CRC and call it manually
@@ -562,6 +1369,20 @@ mesh::DispatcherAction MeshBerryMesh::onRecvPacket(mesh::Packet* pkt) {
         }
     }
 
+    // Topology: every flood path is a chain of adjacent repeaters ending at us.
+    // Adverts are handled in onAdvertRecv() where the origin is verified.
+    if (pkt->isRouteFlood() && pkt->path_len > 0 &&
+        pkt->getPayloadType() != PAYLOAD_TYPE_ADVERT) {
+        uint8_t chain[MAX_PATH_SIZE + 1];
+        uint8_t chainLen = 0;
+        for (uint8_t i = 0; i < pkt->path_len && i < MAX_PATH_SIZE; i++) {
+            chain[chainLen++] = pkt->path[i];
+        }
+        chain[chainLen++] = self_id.pub_key[0];
+        Topology::observeChain(chain, chainLen, pkt->getSNR(), true,
+                               getRTCClock()->getCurrentTime());
+    }
+
     // Call parent implementation for normal processing (forwarding, etc.)
     return mesh::Mesh::onRecvPacket(pkt);
 }
@@ -573,36 +1394,45 @@ void MeshBerryMesh::onAckRecv(mesh::Packet* packet, uint32_t ack_crc) {
                   ack_crc, routingType, packet->path_len);
 
     // Check if this ACK matches a pending DM
-    for (int i = 0; i < MAX_PENDING_DMS; i++) {
-        if (_pendingDMs[i].active && _pendingDMs[i].ack_crc == ack_crc) {
-            Serial.printf("[DM] Delivery confirmed for contact %08X (attempt %d)\n",
-                          _pendingDMs[i].contactId, _pendingDMs[i].attempts);
-
-            // Learn path from any ACK that has path info (flood or direct)
-            if (packet->path_len > 0) {
-                learnPath(_pendingDMs[i].contactId, packet->path, packet->path_len);
-                Serial.printf("[ROUTE] Learned path from %s ACK: %d hops\n",
-                              packet->isRouteFlood() ? "FLOOD" : "DIRECT",
-                              packet->path_len);
+    int slot = _pendingDMs.find(ack_crc);
+    if (slot != _pendingDMs.NONE) {
+        PendingDM& pending = _pendingDMs.at(slot);
+        Serial.printf("[DM] Delivery confirmed for contact %08X (attempt %d)\n",
+                      pending.contactId, pending.attempts);
+
+        // Learn path from any ACK that has path info (flood or direct)
+        if (packet->path_len > 0) {
+            learnPath(pending.contactId, packet->path, packet->path_len);
+            Serial.printf("[ROUTE] Learned path from %s ACK: %d hops\n",
+                          packet->isRouteFlood() ? "FLOOD" : "DIRECT",
+                          packet->path_len);
+        }
+
+        // First-attempt round trips calibrate the per-link delay for time sync
+        if (pending.attempts == 1) {
+            uint32_t rtt = millis() - pending.sentAt;
+            if (!pending.isFlood) {
+                TimeSync::addRoundTrip(pending.pathLen, rtt);
+            } else if (packet->isRouteFlood()) {
+                TimeSync::addRoundTrip(packet->path_len, rtt);
             }
+        }
 
-            // Mark as inactive and notify UI
-            uint32_t contactId = _pendingDMs[i].contactId;
-            uint8_t attempts = _pendingDMs[i].attempts;
-            _pendingDMs[i].active = false;
+        // Free the slot and notify UI
+        uint32_t contactId = pending.contactId;
+        uint8_t attempts = pending.attempts;
+        _pendingDMs.erase(slot);
 
-            if (_deliveryCallback) {
-                _deliveryCallback(contactId, ack_crc, true, attempts);
-            }
-            return;
+        if (_deliveryCallback) {
+            _deliveryCallback(contactId, ack_crc, true, attempts);
         }
+        return;
     }
 
     // Fallback: Mark corresponding message as delivered (legacy behavior)
-    for (int i = 0; i < _messageCount; i++) {
-        int idx = (_messageHead - 1 - i + MAX_MESSAGES) % MAX_MESSAGES;
-        if (_messages[idx].isOutgoing && !_messages[idx].delivered) {
-            _messages[idx].delivered = true;
+    for (int i = (int)_messages.size() - 1; i >= 0; i--) {
+        if (_messages[i].isOutgoing && !_messages[i].delivered) {
+            _messages[i].delivered = true;
             break;
         }
     }
@@ -676,26 +1506,38 @@ bool MeshBerryMesh::filterRecvFloodPacket(mesh::Packet* packet) {
 
             // Check if this is our own message being repeated
             if (strcmp(senderName, _nodeName) == 0) {
-                // This is our message! Check against tracked messages
-                uint32_t receivedHash = hashChannelMessage(ch, msgText);
-                uint32_t now = millis();
-
-                for (int i = 0; i < MAX_CHANNEL_STATS; i++) {
-                    if (_channelStats[i].active &&
-                        _channelStats[i].channelIdx == ch &&
-                        _channelStats[i].contentHash == receivedHash) {
-
-                        if ((now - _channelStats[i].sentAt) <= CHANNEL_STATS_EXPIRY_MS) {
-                            _channelStats[i].repeatCount++;
+                // Any rebroadcast means the packet is out; no resend needed
+                uint32_t packetHash = packetHash32(packet);
+                noteChannelRelay(packetHash);
+
+                // Credit the repeaters in its path, once per packet
+                RelayStats::observe(packetHash, packet->path, packet->path_len,
+                                    packet->getSNR(), getRTCClock()->getCurrentTime());
+
+                // This is our message! Check each coalesced part against tracked messages
+                char* part = (char*)msgText;
+                while (part) {
+                    char* sep = strstr(part, COALESCE_SEP);
+                    if (sep) *sep = '\0';
+
+                    uint32_t receivedHash = hashChannelMessage(ch, part);
+                    uint32_t now = millis();
+
+                    int slot = _channelStats.find(receivedHash);
+                    if (slot != _channelStats.NONE && _channelStats.at(slot).channelIdx == ch) {
+                        ChannelMsgStats& stats = _channelStats.at(slot);
+                        if ((now - stats.sentAt) <= CHANNEL_STATS_EXPIRY_MS) {
+                            stats.repeatCount++;
                             Serial.printf("[REPEAT] Heard our message repeated! ch=%d, hash=%08X, count=%d\n",
-                                          ch, receivedHash, _channelStats[i].repeatCount);
+                                          ch, receivedHash, stats.repeatCount);
 
                             if (_repeatCallback) {
-                                _repeatCallback(ch, receivedHash, _channelStats[i].repeatCount);
+                                _repeatCallback(ch, receivedHash, stats.repeatCount);
                             }
                         }
-                        break;
                     }
+
+                    part = sep ? sep + strlen(COALESCE_SEP) : nullptr;
                 }
             }
             break;  // Found matching channel, stop searching
@@ -748,23 +1590,85 @@ void MeshBerryMesh::onGroupDataRecv(mesh::Packet* packet, uint8_t type, const me
         // Note: Repeat detection now happens in filterRecvFloodPacket() BEFORE
         // the duplicate filter, so we don't call checkChannelRepeat() here anymore
 
-        // Call channel message callback for UI notification
-        if (_channelMsgCallback && channelIdx >= 0) {
-            // Get hop count from packet path_len (only for flood-routed packets)
-            uint8_t hops = packet->isRouteFlood() ? packet->path_len : 0;
-            _channelMsgCallback(channelIdx, textBuf, timestamp, hops);
-        }
+        // A coalesced packet carries several lines after one sender prefix;
+        // deliver each as its own message
+        if (senderName[0] && strstr(msgText, COALESCE_SEP)) {
+            char partBuf[MAX_MESSAGE_LENGTH];
+            char* part = (char*)msgText;
+            while (part) {
+                char* sep = strstr(part, COALESCE_SEP);
+                if (sep) *sep = '\0';
+                if (*part) {
+                    snprintf(partBuf, sizeof(partBuf), "%s: %s", senderName, part);
+                    deliverChannelText(packet, channelIdx, partBuf, timestamp);
+                }
+                part = sep ? sep + strlen(COALESCE_SEP) : nullptr;
+            }
+        } else {
+            deliverChannelText(packet, channelIdx, textBuf, timestamp);
+        }
+    }
+    // PAYLOAD_TYPE_GRP_DATA carrying history sync traffic
+    else if (type == PAYLOAD_TYPE_GRP_DATA && len > HistorySync::SYNC_HEADER_LEN &&
+             data[4] == HistorySync::SYNC_TAG) {
+        int channelIdx = findChannelByHash(channel.hash[0]);
+        if (channelIdx >= 0) {
+            onHistorySyncData(channelIdx, data, len);
+        }
+    }
+    // PAYLOAD_TYPE_GRP_DATA carrying a position beacon (any channel we hold)
+    else if (type == PAYLOAD_TYPE_GRP_DATA && len >= PositionBeacon::POS_HEADER_LEN &&
+             data[4] == PositionBeacon::POS_TAG) {
+        onPositionReport(packet, data, len);
+    }
+    // PAYLOAD_TYPE_GRP_DATA carrying a compact emoji reaction
+    else if (type == PAYLOAD_TYPE_GRP_DATA && len >= Reaction::REACT_PAYLOAD_LEN &&
+             data[4] == Reaction::REACT_TAG) {
+        int channelIdx = findChannelByHash(channel.hash[0]);
+        if (channelIdx >= 0) {
+            onReactionPacket(channelIdx, data, len);
+        }
+    }
+}
 
-        // Also add to general message history
-        Message msg;
-        memset(&msg, 0, sizeof(msg));
-        msg.timestamp = timestamp;
-        msg.senderId = 0;  // Unknown sender for channel messages
-        strncpy(msg.text, textBuf, sizeof(msg.text) - 1);
-        msg.isOutgoing = false;
-        msg.delivered = true;
-        addMessage(msg);
+void MeshBerryMesh::deliverChannelText(mesh::Packet* packet, int channelIdx,
+                                       const char* text, uint32_t timestamp) {
+    // Same sender and text again: a resend the seen table did not catch
+    if (channelIdx >= 0 && isDuplicateChannelText(packet, channelIdx, text)) return;
+
+    // Reactions become badges, not messages
+    const char* colonPos = strstr(text, ": ");
+    if (colonPos && channelIdx >= 0) {
+        char sender[32];
+        size_t nameLen = colonPos - text;
+        if (nameLen > sizeof(sender) - 1) nameLen = sizeof(sender) - 1;
+        memcpy(sender, text, nameLen);
+        sender[nameLen] = '\0';
+        if (onReactionText(channelIdx, 0, sender, colonPos + 2)) return;
+
+        // What plain emoji replies cost, to compare with reactions
+        if (Reaction::loneEmoji(colonPos + 2) >= 0) {
+            _reactStats.emojiReplies++;
+            _reactStats.emojiReplyBytes += channelTxtAirBytes(5 + strlen(text));
+        }
+    }
+
+    // Call channel message callback for UI notification
+    if (_channelMsgCallback && channelIdx >= 0) {
+        // Get hop count from packet path_len (only for flood-routed packets)
+        uint8_t hops = packet->isRouteFlood() ? packet->path_len : 0;
+        _channelMsgCallback(channelIdx, text, timestamp, hops);
     }
+
+    // Also add to general message history
+    Message msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.timestamp = timestamp;
+    msg.senderId = 0;  // Unknown sender for channel messages
+    strncpy(msg.text, text, sizeof(msg.text) - 1);
+    msg.isOutgoing = false;
+    msg.delivered = true;
+    addMessage(msg);
 }
 
 int MeshBerryMesh::findChannelByHash(uint8_t hash) {
@@ -784,14 +1688,90 @@ bool MeshBerryMesh::allowPacketForward(const mesh::Packet* packet) {
         return true;
     }
 
+    // Already decided by the cut-through path
+    CutEntry* cut = findCutEntry(packetHash32(packet));
+    if (cut) {
+        if (!cut->dropped) {
+            uint32_t saved = millis() - cut->at;
+            _cutStats.suppressed++;
+            _cutStats.savedTotalMs += saved;
+            if (saved > _cutStats.savedMaxMs) _cutStats.savedMaxMs = saved;
+        }
+        cut->at = 0;
+        return false;
+    }
+
     // For FLOOD packets, respect the forwarding setting
-    return _forwardingEnabled;
+    if (!_forwardingEnabled) return false;
+
+    // And the source's budget
+    return limitForward(packet) != ForwardLimiter::FL_DROP;
+}
+
+ForwardLimiter::Verdict MeshBerryMesh::limitForward(const mesh::Packet* pkt) {
+    using namespace ForwardLimiter;
+
+    // Who to charge: the originator, if the packet names it in clear
+    uint8_t type = pkt->getPayloadType();
+    TrafficClass cls;
+    const uint8_t* origin = nullptr;
+    uint8_t source = FL_SOURCE_ORIGIN;
+
+    switch (type) {
+        case PAYLOAD_TYPE_ADVERT:
+            cls = FL_CLASS_ADVERT;
+            if (pkt->payload_len >= 1) origin = &pkt->payload[0];       // Public key
+            break;
+        case PAYLOAD_TYPE_GRP_TXT:
+        case PAYLOAD_TYPE_GRP_DATA:
+            // The sender is encrypted, so the whole channel shares a budget
+            cls = FL_CLASS_CHANNEL;
+            source = FL_SOURCE_CHANNEL;
+            if (pkt->payload_len >= 1) origin = &pkt->payload[0];       // Channel hash
+            break;
+        case PAYLOAD_TYPE_TXT_MSG:
+        case PAYLOAD_TYPE_REQ:
+        case PAYLOAD_TYPE_RESPONSE:
+        case PAYLOAD_TYPE_PATH:
+        case PAYLOAD_TYPE_ANON_REQ:
+            cls = FL_CLASS_PEER;
+            if (pkt->payload_len >= 2) origin = &pkt->payload[1];       // Src hash / public key
+            break;
+        default:
+            cls = FL_CLASS_OTHER;
+            break;
+    }
+
+    // ACKs and unknown types name no source. Charging the first relay or a
+    // shared neighbour bucket would throttle everyone behind it for one
+    // chatty node, so leave them unmetered.
+    if (!origin) return FL_PASS;
+
+    Verdict v = check(origin[0], source, cls, millis());
+
+    if (v == FL_DEFER) {
+        _deferHash = packetHash32(pkt);
+        _deferPending = true;
+    }
+    return v;
+}
+
+uint32_t MeshBerryMesh::getRetransmitDelay(const mesh::Packet* packet) {
+    uint32_t delay = mesh::Mesh::getRetransmitDelay(packet);
+
+    // Over-budget sources go behind everyone else's relays
+    if (_deferPending && packetHash32(packet) == _deferHash) {
+        _deferPending = false;
+        delay += ForwardLimiter::FL_DEFER_DELAY_MS;
+    }
+    return delay;
 }
 
 bool MeshBerryMesh::hasPendingWork() const {
     // Check if there are outbound packets waiting to be sent
     // Uses 0xFFFFFFFF as "now" to get count regardless of timing
-    return _mgr->getOutboundCount(0xFFFFFFFF) > 0;
+    return _mgr->getOutboundCount(0xFFFFFFFF) > 0 || hasQueuedRx() || _coalesceChannel >= 0 ||
+           _pendingResends.size() > 0;
 }
 
 // =============================================================================
@@ -970,101 +1950,63 @@ void MeshBerryMesh::disconnectRepeater() {
 }
 
 int MeshBerryMesh::searchPeersByHash(const uint8_t* hash) {
-    // DEBUG: Log the search (show FULL 8-byte hash)
     Serial.printf("[MESH] searchPeersByHash: looking for hash %02X%02X%02X%02X%02X%02X%02X%02X\n",
                   hash[0], hash[1], hash[2], hash[3],
                   hash[4], hash[5], hash[6], hash[7]);
 
-    // Debug: Show all active DM peers (with FULL 8-byte hash)
-    Serial.println("[MESH] Active DM peers:");
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive) {
-            uint8_t peerHash[8];
-            _dmPeers[i].identity.copyHashTo(peerHash);
-            Serial.printf("[MESH]   DM peer[%d]: contactId=%08X, hash=%02X%02X%02X%02X%02X%02X%02X%02X\n",
-                          i, _dmPeers[i].contactId,
-                          peerHash[0], peerHash[1], peerHash[2], peerHash[3],
-                          peerHash[4], peerHash[5], peerHash[6], peerHash[7]);
-        }
-    }
-
-    // Reset last matched DM peer
+    _numPeerMatches = 0;
     _lastMatchedDMPeer = -1;
 
     // Check if hash matches our connected repeater OR pending login
-    if (_repeaterConnected || _pendingLoginAttempt > 0) {
-        uint8_t expectedHash[8];
-        _repeaterIdentity.copyHashTo(expectedHash);
-        bool matches = _repeaterIdentity.isHashMatch(hash);
-        Serial.printf("[MESH] searchPeersByHash: repeater hash=%02X, match=%d\n",
-                      expectedHash[0], matches);
-
-        if (matches) {
-            Serial.println("[MESH] searchPeersByHash: FOUND repeater match!");
-            return 1;  // Found one matching peer (the repeater)
-        }
+    if ((_repeaterConnected || _pendingLoginAttempt > 0) && _repeaterIdentity.isHashMatch(hash)) {
+        _peerMatches[_numPeerMatches++] = PEER_MATCH_REPEATER;
     }
 
-    // Check DM peers
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive && _dmPeers[i].identity.isHashMatch(hash)) {
-            Serial.printf("[MESH] searchPeersByHash: FOUND DM peer match (slot %d)!\n", i);
-            _lastMatchedDMPeer = i;  // Remember which DM peer matched
-            return 1;
-        }
-    }
-
-    Serial.println("[MESH] searchPeersByHash: no match");
-
-    // NEW: Try to auto-create DM peer from contacts if hash matches
-    Serial.printf("[MESH] No DM peers matched hash %02X%02X%02X%02X - searching contacts\n",
-                  hash[0], hash[1], hash[2], hash[3]);
-
+    // The hash is a single key byte, so a stranger heard more recently can
+    // share it with a contact. Return every candidate and let MeshCore try
+    // each secret until one passes the MAC check: contacts first, then
+    // records with a cached secret, then any other keyed record.
     ContactSettings& contacts = SettingsManager::getContactSettings();
-    for (int i = 0; i < contacts.numContacts && i < ContactSettings::MAX_CONTACTS; i++) {
+    for (int i = 0; i < contacts.numContacts && i < ContactSettings::MAX_CONTACTS &&
+                    _numPeerMatches < MAX_PEER_MATCHES; i++) {
         const ContactEntry* c = contacts.getContact(i);
-        if (!c) continue;
-
-        // Check if this contact's pubKey hash matches
-        mesh::Identity contactIdentity(c->pubKey);
-        if (contactIdentity.isHashMatch(hash)) {
-            Serial.printf("[MESH] Found matching contact: %s (id=%08X)\n", c->name, c->id);
-
-            // Auto-create DM peer for this contact
-            int slot = findOrCreateDMPeer(c->id);
-            if (slot >= 0) {
-                Serial.printf("[MESH] Auto-created DM peer in slot %d\n", slot);
-                _lastMatchedDMPeer = slot;  // Remember which peer we just created
-                return 1;  // Found one matching peer
-            } else {
-                Serial.printf("[MESH] Failed to create DM peer for %s\n", c->name);
-            }
-        }
+        if (!c || !mesh::Identity(c->pubKey).isHashMatch(hash)) continue;
+
+        int slot = findOrCreatePeer(c->id);
+        if (slot >= 0) addPeerMatch(slot);
     }
+    collectPeerMatches(hash, true);
+    collectPeerMatches(hash, false);
 
-    Serial.println("[MESH] No matching contact found in database");
-    return 0;
+    Serial.printf("[MESH] searchPeersByHash: %d candidate(s)\n", _numPeerMatches);
+    return _numPeerMatches;
 }
 
 void MeshBerryMesh::getPeerSharedSecret(uint8_t* dest_secret, int peer_idx) {
-    Serial.printf("[MESH] getPeerSharedSecret: peer_idx=%d, pending=%d, connected=%d, lastDM=%d\n",
-                  peer_idx, _pendingLoginAttempt, _repeaterConnected, _lastMatchedDMPeer);
-
-    // Check if this was a DM peer match (from searchPeersByHash)
-    if (_lastMatchedDMPeer >= 0 && _lastMatchedDMPeer < MAX_DM_PEERS) {
-        memcpy(dest_secret, _dmPeers[_lastMatchedDMPeer].sharedSecret, PUB_KEY_SIZE);
-        Serial.printf("[MESH] getPeerSharedSecret: returning DM peer secret (slot %d)\n", _lastMatchedDMPeer);
-        return;
-    }
+    memset(dest_secret, 0, PUB_KEY_SIZE);
+    int match = (peer_idx >= 0 && peer_idx < _numPeerMatches) ? _peerMatches[peer_idx] : -1;
 
-    // Return shared secret for connected repeater OR pending login
-    if (peer_idx == 0 && (_repeaterConnected || _pendingLoginAttempt > 0)) {
+    if (match == PEER_MATCH_REPEATER) {
+        // Connected repeater or pending login
         memcpy(dest_secret, _repeaterSharedSecret, PUB_KEY_SIZE);
-        Serial.printf("[MESH] getPeerSharedSecret: returning repeater secret %02X%02X%02X%02X...\n",
-                      _repeaterSharedSecret[0], _repeaterSharedSecret[1],
-                      _repeaterSharedSecret[2], _repeaterSharedSecret[3]);
+        Serial.printf("[MESH] getPeerSharedSecret: candidate %d is the repeater\n", peer_idx);
+    } else if (_peers.used(match)) {
+        memcpy(dest_secret, peerSecret(match), PUB_KEY_SIZE);
+        Serial.printf("[MESH] getPeerSharedSecret: candidate %d is peer slot %d (%08X)\n",
+                      peer_idx, match, _peers.hot(match).id);
     } else {
-        Serial.println("[MESH] getPeerSharedSecret: NOT returning secret (conditions not met)");
+        Serial.printf("[MESH] getPeerSharedSecret: no candidate %d\n", peer_idx);
+    }
+}
+
+void MeshBerryMesh::selectPeerMatch(int senderIdx) {
+    _lastMatchedDMPeer = -1;
+    if (senderIdx < 0 || senderIdx >= _numPeerMatches) return;
+
+    int match = _peerMatches[senderIdx];
+    if (match != PEER_MATCH_REPEATER && _peers.used(match)) {
+        _lastMatchedDMPeer = match;
+        _peers.touch(match);
     }
 }
 
@@ -1073,6 +2015,7 @@ bool MeshBerryMesh::onPeerPathRecv(mesh::Packet* packet, int sender_idx, const u
                                     uint8_t* extra, uint8_t extra_len) {
     Serial.printf("[MESH] >>> onPeerPathRecv ENTRY: sender_idx=%d, path_len=%d, extra_type=%02X, extra_len=%d\n",
                   sender_idx, path_len, extra_type, extra_len);
+    selectPeerMatch(sender_idx);
 
     // Check if this is a login response embedded in PATH packet
     if (extra_type == PAYLOAD_TYPE_RESPONSE && _pendingLoginAttempt > 0 && extra_len >= 8) {
@@ -1142,10 +2085,19 @@ bool MeshBerryMesh::onPeerPathRecv(mesh::Packet* packet, int sender_idx, const u
     // Learn the return path from the PATH_RETURN packet
     // The 'path' parameter contains the route TO the sender (from our perspective)
     if (path_len > 0) {
+        // Topology: us -> path hops (links beyond the first are not measured by us)
+        uint8_t chain[MAX_PATH_SIZE + 1];
+        uint8_t chainLen = 0;
+        chain[chainLen++] = self_id.pub_key[0];
+        for (uint8_t i = 0; i < path_len && i < MAX_PATH_SIZE; i++) {
+            chain[chainLen++] = path[i];
+        }
+        Topology::observeChain(chain, chainLen, 0.0f, false, getRTCClock()->getCurrentTime());
+
         // Try to identify who sent this PATH_RETURN and learn their path
         // Check DM peers first
-        if (_lastMatchedDMPeer >= 0 && _lastMatchedDMPeer < MAX_DM_PEERS) {
-            uint32_t contactId = _dmPeers[_lastMatchedDMPeer].contactId;
+        if (_peers.used(_lastMatchedDMPeer)) {
+            uint32_t contactId = _peers.hot(_lastMatchedDMPeer).id;
             learnPath(contactId, path, path_len);
             Serial.printf("[ROUTE] Learned path from PATH_RETURN to peer %08X (%d hops)\n",
                           contactId, path_len);
@@ -1164,6 +2116,7 @@ bool MeshBerryMesh::onPeerPathRecv(mesh::Packet* packet, int sender_idx, const u
 void MeshBerryMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sender_idx,
                                     const uint8_t* secret, uint8_t* data, size_t len) {
     Serial.printf("[MESH] >>> onPeerDataRecv ENTRY: type=%02X, sender_idx=%d, len=%d\n", type, sender_idx, len);
+    selectPeerMatch(sender_idx);
     Serial.print("[MESH] Data (first 16): ");
     for (size_t i = 0; i < 16 && i < len; i++) Serial.printf("%02X", data[i]);
     Serial.println();
@@ -1235,7 +2188,10 @@ void MeshBerryMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sende
     // Handle direct messages from DM peers
     if (type == PAYLOAD_TYPE_TXT_MSG && len > 5 && _lastMatchedDMPeer >= 0) {
         int dmIdx = _lastMatchedDMPeer;
-        if (dmIdx >= 0 && dmIdx < MAX_DM_PEERS && _dmPeers[dmIdx].isActive) {
+        if (_peers.used(dmIdx)) {
+            const PeerHot& peer = _peers.hot(dmIdx);
+            const PeerCold& peerCold = _peers.cold(dmIdx);
+            mesh::Identity peerIdentity(peerCold.pubKey);
             // Parse DM: [4-byte timestamp][1-byte flags][text]
             uint32_t timestamp;
             memcpy(&timestamp, data, 4);
@@ -1252,29 +2208,34 @@ void MeshBerryMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sende
             const char* text = (const char*)&data[5];  // Text at offset 5
             size_t textLen = strlen(text);
 
-            // Get sender name from contacts
+            // Sender name from the peer record
             char senderName[32] = "Unknown";
-            ContactSettings& contacts = SettingsManager::getContactSettings();
-            int contactIdx = contacts.findContact(_dmPeers[dmIdx].contactId);
-            if (contactIdx >= 0) {
-                const ContactEntry* c = contacts.getContact(contactIdx);
-                if (c) strncpy(senderName, c->name, sizeof(senderName) - 1);
-            }
+            if (peerCold.name[0]) strncpy(senderName, peerCold.name, sizeof(senderName) - 1);
 
             Serial.printf("[DM] Received from %s (ID=%08X): \"%s\" (ts=%u)\n",
-                          senderName, _dmPeers[dmIdx].contactId, text, timestamp);
+                          senderName, peer.id, text, timestamp);
 
             // === LEARN PATH FROM FLOOD PACKET ===
             // If the packet came via flood, the packet->path contains the route it took to reach us
             // We can use this as the return path (it will be reversed when sending back)
             if (packet->isRouteFlood() && packet->path_len > 0) {
-                learnPath(_dmPeers[dmIdx].contactId, packet->path, packet->path_len);
+                learnPath(peer.id, packet->path, packet->path_len);
                 Serial.printf("[ROUTE] Learned path from flood DM: %d hops to %s\n",
                               packet->path_len, senderName);
             }
 
-            if (_dmCallback) {
-                _dmCallback(_dmPeers[dmIdx].contactId, senderName, text, timestamp);
+            // DM activity keeps a contact from being replaced, and may
+            // promote a discovered sender to the contact list
+            if (_contactAdmit & CONTACT_ADMIT_DM_RX) {
+                promoteToContact(peer.id);
+            } else {
+                ContactSettings& contacts = SettingsManager::getContactSettings();
+                contacts.touchContact(contacts.findContact(peer.id));
+            }
+
+            // Reactions become badges; the ACK still goes out below
+            if (!onReactionText(-1, peer.id, senderName, text) && _dmCallback) {
+                _dmCallback(peer.id, senderName, text, timestamp);
             }
 
             // === SEND ACK ===
@@ -1295,7 +2256,7 @@ void MeshBerryMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sende
             ackHashLen += textLen;
 
             // Sender's public key (32 bytes)
-            const uint8_t* senderPubKey = _dmPeers[dmIdx].identity.pub_key;
+            const uint8_t* senderPubKey = peerCold.pubKey;
             memcpy(ackHashInput + ackHashLen, senderPubKey, PUB_KEY_SIZE);
             ackHashLen += PUB_KEY_SIZE;
 
@@ -1310,8 +2271,8 @@ void MeshBerryMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sende
             // Send path return with ACK embedded (provides sender with return path)
             if (packet->isRouteFlood()) {
                 mesh::Packet* pathAck = createPathReturn(
-                    _dmPeers[dmIdx].identity,
-                    _dmPeers[dmIdx].sharedSecret,
+                    peerIdentity,
+                    peerSecret(dmIdx),
                     packet->path, packet->path_len,
                     PAYLOAD_TYPE_ACK,
                     (uint8_t*)&ack_hash, 4
@@ -1336,13 +2297,26 @@ void MeshBerryMesh::onPeerDataRecv(mesh::Packet* packet, uint8_t type, int sende
 // DIRECT MESSAGING
 // =============================================================================
 
-int MeshBerryMesh::findOrCreateDMPeer(uint32_t contactId) {
-    // Check if peer already exists
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive && _dmPeers[i].contactId == contactId) {
-            return i;
+int MeshBerryMesh::acquirePeer(uint32_t id) {
+    bool created = false;
+    int slot = _peers.acquire(id, &created);
+    // A new record may have evicted the peer MeshCore is mid-way through
+    if (created) {
+        if (slot == _lastMatchedDMPeer) _lastMatchedDMPeer = -1;
+        for (int i = 0; i < _numPeerMatches; i++) {
+            if (_peerMatches[i] == slot) _peerMatches[i] = -1;
         }
     }
+    return slot;
+}
+
+int MeshBerryMesh::findOrCreatePeer(uint32_t contactId) {
+    // Check if a keyed record already exists
+    int existing = _peers.find(contactId);
+    if (existing != PeerTable::NONE && (_peers.hot(existing).flags & PEER_HAS_KEY)) {
+        _peers.touch(existing);
+        return existing;
+    }
 
     // Look up contact to get public key
     ContactSettings& contacts = SettingsManager::getContactSettings();
@@ -1371,87 +2345,100 @@ int MeshBerryMesh::findOrCreateDMPeer(uint32_t contactId) {
         return -1;
     }
 
-    // Find empty slot
-    int slot = -1;
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (!_dmPeers[i].isActive) { slot = i; break; }
+    // Seed the record from the contact; the secret is computed on first use
+    int slot = acquirePeer(contactId);
+    PeerHot& h = _peers.hot(slot);
+    PeerCold& cold = _peers.cold(slot);
+    if (cold.name[0] == '\0') {
+        strncpy(cold.name, c->name, sizeof(cold.name) - 1);
+        cold.name[sizeof(cold.name) - 1] = '\0';
     }
-    if (slot < 0) {
-        // Evict oldest (slot 0) if full
-        memmove(&_dmPeers[0], &_dmPeers[1], sizeof(DMPeer) * (MAX_DM_PEERS - 1));
-        slot = MAX_DM_PEERS - 1;
-        _dmPeers[slot].isActive = false;
+    if (h.type == NODE_TYPE_UNKNOWN) h.type = c->type;
+    _peers.setKey(slot, c->pubKey);
+
+    Serial.printf("[DM] Peer record [%d] for %s (id=%08X), key %02X%02X%02X%02X..., %s\n",
+                  slot, c->name, contactId,
+                  c->pubKey[0], c->pubKey[1], c->pubKey[2], c->pubKey[3],
+                  isPathValid(h.outPathLen, h.pathLearnedAt) ? "route known" : "no route yet");
+    return slot;
+}
+
+int MeshBerryMesh::promoteToContact(uint32_t id) {
+    ContactSettings& contacts = SettingsManager::getContactSettings();
+    int idx = contacts.findContact(id);
+    if (idx >= 0) {
+        contacts.touchContact(idx);
+        return idx;
     }
 
-    // DEBUG: Show the pubKey BEFORE creating Identity
-    Serial.printf("[DM] About to create Identity for contact %s (id=%08X)\n", c->name, contactId);
-    Serial.printf("[DM]   Contact pubKey (full 32 bytes):\n[DM]   ");
-    for (int i = 0; i < 32; i++) {
-        Serial.printf("%02X", c->pubKey[i]);
-        if (i == 15) Serial.print("\n[DM]   ");
+    int slot = _peers.find(id);
+    if (slot == PeerTable::NONE || !(_peers.hot(slot).flags & PEER_HAS_KEY)) {
+        Serial.printf("[CONTACT] Can't add %08X - key not known\n", id);
+        return -1;
     }
-    Serial.println();
 
-    // Set up identity and compute shared secret via ECDH
-    _dmPeers[slot].contactId = contactId;
-    _dmPeers[slot].identity = mesh::Identity(c->pubKey);
-    self_id.calcSharedSecret(_dmPeers[slot].sharedSecret, c->pubKey);
-    _dmPeers[slot].isActive = true;
+    NodeInfo node;
+    peerToNodeInfo(slot, node);
+    idx = contacts.addOrUpdateContact(node, _peers.cold(slot).pubKey);
+    if (idx >= 0) {
+        SettingsManager::saveContacts();
+        Serial.printf("[CONTACT] Added %s (%08X) to contacts\n", node.name, id);
+    }
+    return idx;
+}
 
-    // DEBUG: Show the full Identity hash (8 bytes, not just 4) and verify against pub_key
-    uint8_t fullHash[8];
-    _dmPeers[slot].identity.copyHashTo(fullHash);
-    Serial.printf("[DM] Created DM peer[%d] for contactId=%08X\n", slot, contactId);
-    Serial.printf("[DM]   Identity hash: %02X%02X%02X%02X%02X%02X%02X%02X\n",
-                  fullHash[0], fullHash[1], fullHash[2], fullHash[3],
-                  fullHash[4], fullHash[5], fullHash[6], fullHash[7]);
-    Serial.printf("[DM]   Identity.pub_key first 8: %02X%02X%02X%02X%02X%02X%02X%02X\n",
-                  _dmPeers[slot].identity.pub_key[0], _dmPeers[slot].identity.pub_key[1],
-                  _dmPeers[slot].identity.pub_key[2], _dmPeers[slot].identity.pub_key[3],
-                  _dmPeers[slot].identity.pub_key[4], _dmPeers[slot].identity.pub_key[5],
-                  _dmPeers[slot].identity.pub_key[6], _dmPeers[slot].identity.pub_key[7]);
-
-    // Initialize path from contact if available
-    if (c->outPathLen >= 0 && isPathValid(c->outPathLen, c->pathLearnedAt)) {
-        memcpy(_dmPeers[slot].outPath, c->outPath, c->outPathLen);
-        _dmPeers[slot].outPathLen = c->outPathLen;
-        _dmPeers[slot].pathLearnedAt = c->pathLearnedAt;
-        Serial.printf("[DM] Created peer entry for %s (slot %d) with existing path (%d hops)\n",
-                      c->name, slot, c->outPathLen);
-    } else {
-        _dmPeers[slot].clearPath();
-        Serial.printf("[DM] Created peer entry for %s (slot %d) - no path yet\n", c->name, slot);
+void MeshBerryMesh::addPeerMatch(int slot) {
+    if (_numPeerMatches >= MAX_PEER_MATCHES) return;
+    for (int i = 0; i < _numPeerMatches; i++) {
+        if (_peerMatches[i] == slot) return;
     }
-    return slot;
+    _peerMatches[_numPeerMatches++] = slot;
 }
 
-int MeshBerryMesh::findDMPeerByHash(const uint8_t* hash) {
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive && _dmPeers[i].identity.isHashMatch(hash)) {
-            return i;
-        }
+void MeshBerryMesh::collectPeerMatches(const uint8_t* hash, bool withSecret) {
+    // Hot records only until the path hash byte matches
+    for (int i = _peers.newest(); i != PeerTable::NONE && _numPeerMatches < MAX_PEER_MATCHES;
+         i = _peers.older(i)) {
+        const PeerHot& h = _peers.hot(i);
+        if (!(h.flags & PEER_HAS_KEY) || h.hashByte != hash[0]) continue;
+        if (((h.flags & PEER_HAS_SECRET) != 0) != withSecret) continue;
+        if (mesh::Identity(_peers.cold(i).pubKey).isHashMatch(hash)) addPeerMatch(i);
     }
-    return -1;
+}
+
+const uint8_t* MeshBerryMesh::peerSecret(int slot) {
+    PeerHot& h = _peers.hot(slot);
+    PeerCold& cold = _peers.cold(slot);
+    if (!(h.flags & PEER_HAS_SECRET)) {
+        self_id.calcSharedSecret(cold.sharedSecret, cold.pubKey);
+        h.flags |= PEER_HAS_SECRET;
+    }
+    return cold.sharedSecret;
 }
 
 bool MeshBerryMesh::sendDirectMessage(uint32_t contactId, const char* text, uint32_t* out_ack_crc) {
     if (!text || strlen(text) == 0) return false;
 
-    // Find or create DM peer entry
+    // Find or create the peer record
     Serial.printf("[DM] sendDirectMessage: contactId=%08X\n", contactId);
 
-    int peerIdx = findOrCreateDMPeer(contactId);
+    int peerIdx = findOrCreatePeer(contactId);
     if (peerIdx < 0) {
         Serial.println("[DM] Failed to create peer entry");
         return false;
     }
 
-    DMPeer& peer = _dmPeers[peerIdx];
+    // Messaging a discovered node is the user choosing it as a contact
+    promoteToContact(contactId);
+
+    PeerHot& peer = _peers.hot(peerIdx);
+    PeerCold& peerCold = _peers.cold(peerIdx);
+    mesh::Identity peerIdentity(peerCold.pubKey);
 
     // Debug: Show the DM peer Identity hash (FULL 8 bytes)
     uint8_t peerHash[8];
-    peer.identity.copyHashTo(peerHash);
-    Serial.printf("[DM] Using DM peer[%d]: contactId=%08X\n", peerIdx, peer.contactId);
+    peerIdentity.copyHashTo(peerHash);
+    Serial.printf("[DM] Using peer[%d]: contactId=%08X\n", peerIdx, peer.id);
     Serial.printf("[DM]   Identity hash: %02X%02X%02X%02X%02X%02X%02X%02X\n",
                   peerHash[0], peerHash[1], peerHash[2], peerHash[3],
                   peerHash[4], peerHash[5], peerHash[6], peerHash[7]);
@@ -1507,12 +2494,9 @@ bool MeshBerryMesh::sendDirectMessage(uint32_t contactId, const char* text, uint
         *out_ack_crc = expected_ack;
     }
 
-    // Find a pending slot for tracking delivery
-    int pendingSlot = findFreePendingSlot();
-
     // Create encrypted datagram using PAYLOAD_TYPE_TXT_MSG (0x02)
-    mesh::Packet* pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, peer.identity,
-                                        peer.sharedSecret, payload, payloadLen);
+    mesh::Packet* pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, peerIdentity,
+                                        peerSecret(peerIdx), payload, payloadLen);
     if (!pkt) {
         Serial.println("[DM] Failed to create packet");
         return false;
@@ -1521,8 +2505,28 @@ bool MeshBerryMesh::sendDirectMessage(uint32_t contactId, const char* text, uint
     // Check if we have a valid path to this peer
     bool useDirect = isPathValid(peer.outPathLen, peer.pathLearnedAt);
 
+    // No learned path: try a route planned over the overheard topology
+    // before falling back to a flood (AUTO routing mode only)
+    RoutePlanner::Route planned;
+    bool usePlanned = false;
+    if (!useDirect) {
+        ContactSettings& contacts = SettingsManager::getContactSettings();
+        int idx = contacts.findContact(contactId);
+        const ContactEntry* c = (idx >= 0) ? contacts.getContact(idx) : nullptr;
+        if (c && c->routingMode == DM_ROUTE_AUTO && !isPlannedRouteHeldOff(contactId)) {
+            usePlanned = RoutePlanner::planRoute(peer.hashByte,
+                                                 getRTCClock()->getCurrentTime(), planned);
+        }
+    }
+
     // Debug output for routing decision
-    if (useDirect) {
+    if (usePlanned) {
+        Serial.printf("[DM] Using PLANNED route (%d hops, ETX %.1f)\n",
+                      planned.hopCount, planned.cost);
+        // A planned route that fails times out into the normal flood retry,
+        // and holds off planning for this contact for a while
+        sendDirect(pkt, planned.hops, planned.hopCount);
+    } else if (useDirect) {
         if (peer.outPathLen == 0) {
             Serial.printf("[DM] Using DIRECT route (direct neighbor, learned %lums ago)\n",
                           millis() - peer.pathLearnedAt);
@@ -1531,7 +2535,7 @@ bool MeshBerryMesh::sendDirectMessage(uint32_t contactId, const char* text, uint
                           peer.outPathLen, millis() - peer.pathLearnedAt);
         }
         // Use direct routing with learned path
-        sendDirect(pkt, peer.outPath, peer.outPathLen);
+        sendDirect(pkt, peerCold.outPath, peer.outPathLen);
     } else {
         if (peer.outPathLen < 0) {
             Serial.printf("[DM] Using FLOOD route (no path learned)\n");
@@ -1543,20 +2547,21 @@ bool MeshBerryMesh::sendDirectMessage(uint32_t contactId, const char* text, uint
     }
 
     // Track pending DM for delivery status
-    if (pendingSlot >= 0) {
-        _pendingDMs[pendingSlot].ack_crc = expected_ack;
-        _pendingDMs[pendingSlot].contactId = contactId;
-        _pendingDMs[pendingSlot].sentAt = millis();
-        // DIRECT timeout: 20s, FLOOD timeout: 20s
-        _pendingDMs[pendingSlot].timeout = millis() + 20000;
-        memcpy(_pendingDMs[pendingSlot].payload, payload, payloadLen);
-        _pendingDMs[pendingSlot].payloadLen = payloadLen;
-        _pendingDMs[pendingSlot].attempts = 1;
-        _pendingDMs[pendingSlot].pathLen = useDirect ? peer.outPathLen : 0;
-        _pendingDMs[pendingSlot].isFlood = !useDirect;
-        _pendingDMs[pendingSlot].active = true;
-        Serial.printf("[DM] Tracking delivery in slot %d (timeout in 20000ms)\n", pendingSlot);
-    }
+    int pendingSlot = acquirePendingSlot(expected_ack);
+    PendingDM& pending = _pendingDMs.at(pendingSlot);
+    pending.ack_crc = expected_ack;
+    pending.contactId = contactId;
+    pending.sentAt = millis();
+    // DIRECT timeout: 20s, FLOOD timeout: 20s
+    pending.timeout = millis() + 20000;
+    memcpy(pending.payload, payload, payloadLen);
+    pending.payloadLen = payloadLen;
+    pending.attempts = 1;
+    pending.pathLen = usePlanned ? planned.hopCount :
+                      (useDirect ? peer.outPathLen : 0);
+    pending.isFlood = !useDirect && !usePlanned;
+    pending.planned = usePlanned;
+    Serial.printf("[DM] Tracking delivery in slot %d (timeout in 20000ms)\n", pendingSlot);
 
     return true;
 }
@@ -1570,28 +2575,14 @@ void MeshBerryMesh::learnPath(uint32_t contactId, const uint8_t* path, uint8_t p
 
     Serial.printf("[ROUTE] Learning path to %08X (%d hops)\n", contactId, pathLen);
 
-    // Update DMPeer if it exists
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive && _dmPeers[i].contactId == contactId) {
-            memcpy(_dmPeers[i].outPath, path, pathLen);
-            _dmPeers[i].outPathLen = pathLen;
-            _dmPeers[i].pathLearnedAt = millis();
-            Serial.printf("[ROUTE] Updated DMPeer slot %d with path\n", i);
-            break;
-        }
+    // One route per peer record
+    int peerIdx = _peers.find(contactId);
+    if (peerIdx == PeerTable::NONE) {
+        peerIdx = findOrCreatePeer(contactId);
     }
-
-    // Also update ContactEntry for persistence
-    ContactSettings& contacts = SettingsManager::getContactSettings();
-    int idx = contacts.findContact(contactId);
-    if (idx >= 0) {
-        ContactEntry* c = contacts.getContact(idx);
-        if (c) {
-            memcpy(c->outPath, path, pathLen);
-            c->outPathLen = pathLen;
-            c->pathLearnedAt = millis();
-            Serial.printf("[ROUTE] Updated contact '%s' with path\n", c->name);
-        }
+    if (peerIdx >= 0) {
+        _peers.setPath(peerIdx, path, pathLen);
+        Serial.printf("[ROUTE] Updated peer slot %d with path\n", peerIdx);
     }
 }
 
@@ -1620,24 +2611,9 @@ bool MeshBerryMesh::isPathValid(int8_t pathLen, uint32_t learnedAt) const {
 void MeshBerryMesh::invalidatePath(uint32_t contactId) {
     Serial.printf("[ROUTE] Invalidating path to %08X\n", contactId);
 
-    // Clear from DMPeer
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive && _dmPeers[i].contactId == contactId) {
-            _dmPeers[i].clearPath();
-            break;
-        }
-    }
-
-    // Clear from ContactEntry
-    ContactSettings& contacts = SettingsManager::getContactSettings();
-    int idx = contacts.findContact(contactId);
-    if (idx >= 0) {
-        ContactEntry* c = contacts.getContact(idx);
-        if (c) {
-            memset(c->outPath, 0, sizeof(c->outPath));
-            c->outPathLen = -1;
-            c->pathLearnedAt = 0;
-        }
+    int peerIdx = _peers.find(contactId);
+    if (peerIdx != PeerTable::NONE) {
+        _peers.clearPath(peerIdx);
     }
 }
 
@@ -1645,61 +2621,43 @@ void MeshBerryMesh::invalidatePath(uint32_t contactId) {
 // PENDING DM MANAGEMENT FOR DELIVERY STATUS
 // =============================================================================
 
-int MeshBerryMesh::findFreePendingSlot() {
-    for (int i = 0; i < MAX_PENDING_DMS; i++) {
-        if (!_pendingDMs[i].active) {
-            return i;
-        }
-    }
-    // Evict oldest (by sentAt time)
-    int oldest = 0;
-    for (int i = 1; i < MAX_PENDING_DMS; i++) {
-        if (_pendingDMs[i].sentAt < _pendingDMs[oldest].sentAt) {
-            oldest = i;
-        }
+int MeshBerryMesh::acquirePendingSlot(uint32_t ack_crc) {
+    // Evicting the least recently sent entry: mark it failed first
+    int victim = _pendingDMs.victim();
+    if (victim != _pendingDMs.NONE && _deliveryCallback) {
+        const PendingDM& old = _pendingDMs.at(victim);
+        _deliveryCallback(old.contactId, old.ack_crc, false, old.attempts);
     }
-    // Mark evicted as failed
-    if (_deliveryCallback) {
-        _deliveryCallback(_pendingDMs[oldest].contactId, _pendingDMs[oldest].ack_crc,
-                          false, _pendingDMs[oldest].attempts);
-    }
-    _pendingDMs[oldest].active = false;
-    return oldest;
+    return _pendingDMs.acquire(ack_crc);
 }
 
 void MeshBerryMesh::retryDMWithFlood(int pendingIdx) {
-    if (pendingIdx < 0 || pendingIdx >= MAX_PENDING_DMS) return;
-    PendingDM& pending = _pendingDMs[pendingIdx];
-    if (!pending.active) return;
+    if (!_pendingDMs.used(pendingIdx)) return;
+    PendingDM& pending = _pendingDMs.at(pendingIdx);
 
     Serial.printf("[DM] Retrying message to %08X via FLOOD (attempt %d)\n",
                   pending.contactId, pending.attempts + 1);
 
-    // Find the DM peer for this contact
-    int peerIdx = -1;
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive && _dmPeers[i].contactId == pending.contactId) {
-            peerIdx = i;
-            break;
-        }
-    }
+    // Find the peer record for this contact
+    int peerIdx = findOrCreatePeer(pending.contactId);
     if (peerIdx < 0) {
         Serial.println("[DM] Peer not found for retry - marking failed");
-        pending.active = false;
+        _pendingDMs.erase(pendingIdx);
         if (_deliveryCallback) {
             _deliveryCallback(pending.contactId, pending.ack_crc, false, pending.attempts);
         }
         return;
     }
 
-    DMPeer& peer = _dmPeers[peerIdx];
+    PeerCold& peerCold = _peers.cold(peerIdx);
+    mesh::Identity peerIdentity(peerCold.pubKey);
 
     // Create new packet with same payload
-    mesh::Packet* pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, peer.identity,
-                                        peer.sharedSecret, pending.payload, pending.payloadLen);
+    mesh::Packet* pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, peerIdentity,
+                                        peerSecret(peerIdx), pending.payload, pending.payloadLen);
     if (!pkt) {
         Serial.println("[DM] Failed to create retry packet");
-        pending.active = false;
+        _pendingDMs.erase(pendingIdx);
         if (_deliveryCallback) {
             _deliveryCallback(pending.contactId, pending.ack_crc, false, pending.attempts);
         }
@@ -1714,6 +2672,7 @@ void MeshBerryMesh::retryDMWithFlood(int pendingIdx) {
     pending.isFlood = true;
     pending.timeout = millis() + 20000;  // 20s timeout for flood
     pending.sentAt = millis();
+    _pendingDMs.touch(pendingIdx);
 
     Serial.printf("[DM] Retry sent via FLOOD (timeout in 20s)\n");
 }
@@ -1738,31 +2697,26 @@ int MeshBerryMesh::calculateMaxRetries(bool isFlood, uint8_t pathLen) {
 }
 
 void MeshBerryMesh::retryDMWithDirect(int pendingIdx) {
-    if (pendingIdx < 0 || pendingIdx >= MAX_PENDING_DMS) return;
-    PendingDM& pending = _pendingDMs[pendingIdx];
-    if (!pending.active) return;
+    if (!_pendingDMs.used(pendingIdx)) return;
+    PendingDM& pending = _pendingDMs.at(pendingIdx);
 
     Serial.printf("[DM] Retrying message to %08X via DIRECT (attempt %d)\n",
                   pending.contactId, pending.attempts + 1);
 
-    // Find the DM peer for this contact
-    int peerIdx = -1;
-    for (int i = 0; i < MAX_DM_PEERS; i++) {
-        if (_dmPeers[i].isActive && _dmPeers[i].contactId == pending.contactId) {
-            peerIdx = i;
-            break;
-        }
-    }
+    // Find the peer record for this contact
+    int peerIdx = findOrCreatePeer(pending.contactId);
     if (peerIdx < 0) {
         Serial.println("[DM] Peer not found for retry - marking failed");
-        pending.active = false;
+        _pendingDMs.erase(pendingIdx);
         if (_deliveryCallback) {
             _deliveryCallback(pending.contactId, pending.ack_crc, false, pending.attempts);
         }
         return;
     }
 
-    DMPeer& peer = _dmPeers[peerIdx];
+    PeerHot& peer = _peers.hot(peerIdx);
+    PeerCold& peerCold = _peers.cold(peerIdx);
+    mesh::Identity peerIdentity(peerCold.pubKey);
 
     // Verify path is still valid
     if (!isPathValid(peer.outPathLen, peer.pathLearnedAt)) {
@@ -1772,11 +2726,11 @@ void MeshBerryMesh::retryDMWithDirect(int pendingIdx) {
     }
 
     // Create new packet with same payload
-    mesh::Packet* pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, peer.identity,
-                                        peer.sharedSecret, pending.payload, pending.payloadLen);
+    mesh::Packet* pkt = createDatagram(PAYLOAD_TYPE_TXT_MSG, peerIdentity,
+                                        peerSecret(peerIdx), pending.payload, pending.payloadLen);
     if (!pkt) {
         Serial.println("[DM] Failed to create retry packet");
-        pending.active = false;
+        _pendingDMs.erase(pendingIdx);
         if (_deliveryCallback) {
             _deliveryCallback(pending.contactId, pending.ack_crc, false, pending.attempts);
         }
@@ -1784,13 +2738,14 @@ void MeshBerryMesh::retryDMWithDirect(int pendingIdx) {
     }
 
     // Send via direct route with same path
-    sendDirect(pkt, peer.outPath, peer.outPathLen);
+    sendDirect(pkt, peerCold.outPath, peer.outPathLen);
 
     // Update tracking
     pending.attempts++;
     pending.isFlood = false;
     pending.timeout = millis() + 10000;  // 10s timeout for direct
     pending.sentAt = millis();
+    _pendingDMs.touch(pendingIdx);
 
     Serial.printf("[DM] Retry sent via DIRECT route (%d hops)\n", peer.outPathLen);
 }
@@ -1799,22 +2754,31 @@ void MeshBerryMesh::checkPendingTimeouts() {
     uint32_t now = millis();
 
     for (int i = 0; i < MAX_PENDING_DMS; i++) {
-        if (!_pendingDMs[i].active) continue;
+        if (!_pendingDMs.used(i)) continue;
+        PendingDM& pending = _pendingDMs.at(i);
+
+        if (now >= pending.timeout) {
+            // The planned route didn't get through; don't keep choosing it
+            if (pending.planned) {
+                pending.planned = false;
+                _plannedFailures.at(_plannedFailures.acquire(pending.contactId)) = now;
+                Serial.printf("[DM] Planned route to %08X failed - holding off %lus\n",
+                              pending.contactId, (unsigned long)(PLANNED_ROUTE_HOLDOFF_MS / 1000));
+            }
 
-        if (now >= _pendingDMs[i].timeout) {
             // Calculate max retries based on routing method and path length
-            int maxRetries = calculateMaxRetries(_pendingDMs[i].isFlood,
-                                                  _pendingDMs[i].pathLen);
+            int maxRetries = calculateMaxRetries(pending.isFlood,
+                                                  pending.pathLen);
 
-            if (_pendingDMs[i].attempts > maxRetries) {
+            if (pending.attempts > maxRetries) {
                 // Max retries reached - mark as failed
                 Serial.printf("[DM] Delivery FAILED for contact %08X after %d attempts (max %d retries)\n",
-                              _pendingDMs[i].contactId, _pendingDMs[i].attempts, maxRetries);
+                              pending.contactId, pending.attempts, maxRetries);
 
-                uint32_t contactId = _pendingDMs[i].contactId;
-                uint32_t ack_crc = _pendingDMs[i].ack_crc;
-                uint8_t attempts = _pendingDMs[i].attempts;
-                _pendingDMs[i].active = false;
+                uint32_t contactId = pending.contactId;
+                uint32_t ack_crc = pending.ack_crc;
+                uint8_t attempts = pending.attempts;
+                _pendingDMs.erase(i);
 
                 // Invalidate path since delivery failed
                 invalidatePath(contactId);
@@ -1824,15 +2788,15 @@ void MeshBerryMesh::checkPendingTimeouts() {
                 }
             } else {
                 // Retry - fallback to FLOOD if DIRECT fails (recipient might not have return path)
-                if (_pendingDMs[i].isFlood) {
+                if (pending.isFlood) {
                     Serial.printf("[DM] Flood timed out for %08X - retry %d/%d\n",
-                                  _pendingDMs[i].contactId, _pendingDMs[i].attempts, maxRetries + 1);
+                                  pending.contactId, pending.attempts, maxRetries + 1);
                     retryDMWithFlood(i);
                 } else {
                     // DIRECT failed - fallback to FLOOD for next attempt
                     Serial.printf("[DM] Direct timed out for %08X - falling back to FLOOD for retry %d/%d\n",
-                                  _pendingDMs[i].contactId, _pendingDMs[i].attempts, maxRetries + 1);
-                    _pendingDMs[i].isFlood = true;  // Switch to FLOOD for retries
+                                  pending.contactId, pending.attempts, maxRetries + 1);
+                    pending.isFlood = true;  // Switch to FLOOD for retries
                     retryDMWithFlood(i);
                 }
             }
@@ -1840,6 +2804,14 @@ void MeshBerryMesh::checkPendingTimeouts() {
     }
 }
 
+bool MeshBerryMesh::isPlannedRouteHeldOff(uint32_t contactId) {
+    int slot = _plannedFailures.find(contactId);
+    if (slot == _plannedFailures.NONE) return false;
+    if (millis() - _plannedFailures.at(slot) < PLANNED_ROUTE_HOLDOFF_MS) return true;
+    _plannedFailures.erase(slot);
+    return false;
+}
+
 // =============================================================================
 // CHANNEL REPEAT TRACKING
 // =============================================================================
@@ -1866,39 +2838,21 @@ uint32_t MeshBerryMesh::hashChannelMessage(int channelIdx, const char* text) {
 }
 
 void MeshBerryMesh::trackSentChannelMessage(int channelIdx, const char* text) {
-    // Clean up expired entries first
+    // Clean up expired entries first (oldest end of the send order)
     uint32_t now = millis();
-    for (int i = 0; i < MAX_CHANNEL_STATS; i++) {
-        if (_channelStats[i].active &&
-            (now - _channelStats[i].sentAt) > CHANNEL_STATS_EXPIRY_MS) {
-            _channelStats[i].active = false;
-        }
-    }
-
-    // Find empty slot or oldest
-    int slot = -1;
-    int oldestSlot = 0;
-    uint32_t oldestTime = UINT32_MAX;
-
-    for (int i = 0; i < MAX_CHANNEL_STATS; i++) {
-        if (!_channelStats[i].active) {
-            slot = i;
-            break;
-        }
-        if (_channelStats[i].sentAt < oldestTime) {
-            oldestTime = _channelStats[i].sentAt;
-            oldestSlot = i;
-        }
+    int oldest;
+    while ((oldest = _channelStats.oldest()) != _channelStats.NONE &&
+           (now - _channelStats.at(oldest).sentAt) > CHANNEL_STATS_EXPIRY_MS) {
+        _channelStats.erase(oldest);
     }
 
-    if (slot < 0) slot = oldestSlot;
-
+    // Take a free slot, or replace the oldest tracked message
     uint32_t contentHash = hashChannelMessage(channelIdx, text);
-    _channelStats[slot].contentHash = contentHash;
-    _channelStats[slot].sentAt = now;
-    _channelStats[slot].channelIdx = channelIdx;
-    _channelStats[slot].repeatCount = 0;
-    _channelStats[slot].active = true;
+    ChannelMsgStats& stats = _channelStats.at(_channelStats.acquire(contentHash));
+    stats.contentHash = contentHash;
+    stats.sentAt = now;
+    stats.channelIdx = channelIdx;
+    stats.repeatCount = 0;
 
     Serial.printf("[CHANNEL] Tracking sent message on ch=%d, hash=%08X\n", channelIdx, contentHash);
 }
@@ -1919,25 +2873,704 @@ void MeshBerryMesh::checkChannelRepeat(int channelIdx, const char* text, const c
     Serial.printf("[REPEAT CHECK] Looking for hash=%08X on ch=%d\n", receivedHash, channelIdx);
 
     // Find matching tracked message by content hash
-    for (int i = 0; i < MAX_CHANNEL_STATS; i++) {
-        if (_channelStats[i].active &&
-            _channelStats[i].channelIdx == channelIdx &&
-            _channelStats[i].contentHash == receivedHash) {
-
-            // Check if not expired
-            if ((now - _channelStats[i].sentAt) > CHANNEL_STATS_EXPIRY_MS) {
-                _channelStats[i].active = false;
-                continue;
+    int slot = _channelStats.find(receivedHash);
+    if (slot == _channelStats.NONE) return;
+    ChannelMsgStats& stats = _channelStats.at(slot);
+    if (stats.channelIdx != channelIdx) return;
+
+    // Check if not expired
+    if ((now - stats.sentAt) > CHANNEL_STATS_EXPIRY_MS) {
+        _channelStats.erase(slot);
+        return;
+    }
+
+    stats.repeatCount++;
+    Serial.printf("[CHANNEL] Heard repeat of our message (ch=%d, hash=%08X, count=%d)\n",
+                  channelIdx, receivedHash, stats.repeatCount);
+
+    if (_repeatCallback) {
+        _repeatCallback(channelIdx, receivedHash, stats.repeatCount);
+    }
+}
+
+// =============================================================================
+// CHANNEL HISTORY SYNC (ANTI-ENTROPY)
+// =============================================================================
+//
+// Opt-in reconciliation of recent channel history with direct neighbours.
+// All sync packets are zero-hop GRP_DATA on the channel itself, so only
+// nodes holding the channel key take part and nothing is re-flooded.
+//
+//   1. Every SYNC_INTERVAL_MS we send a Bloom summary of one channel's
+//      recent archive (round-robin over active channels).
+//   2. A neighbour receiving it queues up to MAX_SYNC_OUT records that the
+//      summary does not contain, each with a random delay, and answers
+//      with its own summary so the exchange converges in both directions.
+//   3. A queued record is dropped if another neighbour is overheard sending
+//      the same one first, so N neighbours do not all answer.
+//
+// Summaries and records draw from one byte budget per window, which bounds
+// sync airtime regardless of neighbour count.
+
+void MeshBerryMesh::setHistorySyncEnabled(bool enabled) {
+    _historySyncEnabled = enabled;
+    if (enabled) {
+        requestHistorySync();
+    } else {
+        memset(_syncOut, 0, sizeof(_syncOut));
+    }
+    Serial.printf("[SYNC] History sync %s\n", enabled ? "enabled" : "disabled");
+}
+
+void MeshBerryMesh::requestHistorySync() {
+    // Short random delay so nodes waking together don't collide
+    _syncNextSummaryAt = millis() + getRNG()->nextInt(2000, 8000);
+}
+
+bool MeshBerryMesh::buildGroupChannel(int channelIdx, mesh::GroupChannel& channel) {
+    ChannelSettings& chSettings = SettingsManager::getChannelSettings();
+    if (channelIdx < 0 || channelIdx >= chSettings.numChannels) return false;
+
+    const ChannelEntry& entry = chSettings.channels[channelIdx];
+    if (!entry.isActive) return false;
+
+    channel.hash[0] = entry.hash;
+    memcpy(channel.secret, entry.secret, sizeof(channel.secret));
+    return true;
+}
+
+bool MeshBerryMesh::consumeSyncBudget(size_t bytes) {
+    uint32_t now = millis();
+    if (now - _syncBudgetWindowStart >= SYNC_BUDGET_WINDOW_MS) {
+        _syncBudgetWindowStart = now;
+        _syncBudget = SYNC_BUDGET_BYTES;
+    }
+
+    // Account for header, path and MAC/padding on top of the payload
+    int32_t cost = (int32_t)bytes + 20;
+    if (_syncBudget < cost) {
+        return false;
+    }
+    _syncBudget -= cost;
+    return true;
+}
+
+void MeshBerryMesh::processHistorySync() {
+    if (!_historySyncEnabled) return;
+
+    uint32_t now = millis();
+
+    // Send at most one due record per loop pass
+    for (int i = 0; i < MAX_SYNC_OUT; i++) {
+        if (_syncOut[i].active && (now - _syncOut[i].queuedAt) >= _syncOut[i].delay) {
+            sendHistoryRecord(_syncOut[i]);
+            _syncOut[i].active = false;
+            break;
+        }
+    }
+
+    // Periodic summary round
+    if ((int32_t)(now - _syncNextSummaryAt) < 0) return;
+
+    ChannelSettings& chSettings = SettingsManager::getChannelSettings();
+    int activeCount = 0;
+    for (int i = 0; i < chSettings.numChannels; i++) {
+        if (chSettings.channels[i].isActive) activeCount++;
+    }
+    if (activeCount == 0) {
+        _syncNextSummaryAt = now + SYNC_INTERVAL_MS;
+        return;
+    }
+
+    // Next active channel after the cursor
+    for (int n = 0; n < chSettings.numChannels; n++) {
+        int ch = (_syncChannelCursor + n) % chSettings.numChannels;
+        if (!chSettings.channels[ch].isActive) continue;
+        _syncChannelCursor = (ch + 1) % chSettings.numChannels;
+        sendHistorySummary(ch, 0);
+        break;
+    }
+
+    // Spread the round over the interval so each channel gets one summary
+    _syncNextSummaryAt = now + SYNC_INTERVAL_MS / activeCount;
+}
+
+bool MeshBerryMesh::sendHistorySummary(int channelIdx, uint32_t delayMs) {
+    mesh::GroupChannel channel;
+    if (!buildGroupChannel(channelIdx, channel)) return false;
+
+    HistorySync::Summary summary;
+    if (!HistorySync::buildSummary(channelIdx, getRTCClock()->getCurrentTime(), summary)) {
+        return false;
+    }
+
+    uint8_t payload[HistorySync::SYNC_HEADER_LEN + HistorySync::SYNC_SUMMARY_LEN];
+    uint32_t timestamp = getRTCClock()->getCurrentTime();
+    memcpy(payload, &timestamp, 4);
+    payload[4] = HistorySync::SYNC_TAG;
+    payload[5] = HistorySync::SYNC_KIND_SUMMARY;
+    size_t bodyLen = HistorySync::encodeSummary(summary, &payload[HistorySync::SYNC_HEADER_LEN],
+                                                sizeof(payload) - HistorySync::SYNC_HEADER_LEN);
+    size_t totalLen = HistorySync::SYNC_HEADER_LEN + bodyLen;
+
+    if (!consumeSyncBudget(totalLen)) {
+        Serial.println("[SYNC] Airtime budget exhausted - summary skipped");
+        return false;
+    }
+
+    mesh::Packet* pkt = createGroupDatagram(PAYLOAD_TYPE_GRP_DATA, channel, payload, totalLen);
+    if (!pkt) {
+        Serial.println("[SYNC] Failed to create summary packet");
+        return false;
+    }
+
+    sendZeroHop(pkt, delayMs);
+    _syncLastSummaryAt[channelIdx] = millis();
+
+    Serial.printf("[SYNC] Summary sent: ch=%d, items=%d, since=%u\n",
+                  channelIdx, summary.count, summary.since);
+    return true;
+}
+
+bool MeshBerryMesh::sendHistoryRecord(SyncOutRecord& rec) {
+    mesh::GroupChannel channel;
+    if (!buildGroupChannel(rec.channelIdx, channel)) return false;
+
+    // [timestamp(4)][tag][kind][msg timestamp(4)]["Sender: text"]
+    uint8_t payload[HistorySync::SYNC_HEADER_LEN + 4 + HistorySync::SYNC_MAX_RECORD_TEXT + 1];
+    uint32_t timestamp = getRTCClock()->getCurrentTime();
+    memcpy(payload, &timestamp, 4);
+    payload[4] = HistorySync::SYNC_TAG;
+    payload[5] = HistorySync::SYNC_KIND_RECORD;
+    memcpy(&payload[6], &rec.msg.timestamp, 4);
+
+    int textLen = snprintf((char*)&payload[10], HistorySync::SYNC_MAX_RECORD_TEXT + 1, "%s: %s",
+                           rec.msg.sender, rec.msg.text);
+    if (textLen <= 0 || (size_t)textLen > HistorySync::SYNC_MAX_RECORD_TEXT) {
+        return false;
+    }
+    size_t totalLen = 10 + textLen;
+
+    if (!consumeSyncBudget(totalLen)) {
+        Serial.println("[SYNC] Airtime budget exhausted - record dropped");
+        return false;
+    }
+
+    mesh::Packet* pkt = createGroupDatagram(PAYLOAD_TYPE_GRP_DATA, channel, payload, totalLen);
+    if (!pkt) {
+        Serial.println("[SYNC] Failed to create record packet");
+        return false;
+    }
+
+    sendZeroHop(pkt);
+    _syncRecordsSent++;
+
+    Serial.printf("[SYNC] Record sent: ch=%d, key=%08X, ts=%u\n",
+                  rec.channelIdx, rec.key, rec.msg.timestamp);
+    return true;
+}
+
+void MeshBerryMesh::queueHistoryRecords(int channelIdx, const HistorySync::Summary& remote) {
+    ArchivedMessage missing[MAX_SYNC_OUT];
+    int count = HistorySync::findMissing(channelIdx, remote, missing, MAX_SYNC_OUT);
+    if (count == 0) return;
+
+    uint32_t now = millis();
+    int queued = 0;
+    for (int m = 0; m < count; m++) {
+        uint32_t key = HistorySync::messageKey(missing[m]);
+
+        // Skip if already queued
+        bool dup = false;
+        int slot = -1;
+        for (int i = 0; i < MAX_SYNC_OUT; i++) {
+            if (_syncOut[i].active) {
+                if (_syncOut[i].key == key && _syncOut[i].channelIdx == channelIdx) dup = true;
+            } else if (slot < 0) {
+                slot = i;
             }
+        }
+        if (dup) continue;
+        if (slot < 0) break;
 
-            _channelStats[i].repeatCount++;
-            Serial.printf("[CHANNEL] Heard repeat of our message (ch=%d, hash=%08X, count=%d)\n",
-                          channelIdx, receivedHash, _channelStats[i].repeatCount);
+        SyncOutRecord& rec = _syncOut[slot];
+        rec.key = key;
+        rec.queuedAt = now;
+        // Stagger records and randomise so other neighbours can be overheard first
+        rec.delay = 500 + queued * 800 + getRNG()->nextInt(0, 2500);
+        rec.channelIdx = channelIdx;
+        rec.msg = missing[m];
+        rec.active = true;
+        queued++;
+    }
+
+    if (queued > 0) {
+        Serial.printf("[SYNC] Neighbour missing %d message(s) on ch=%d, queued %d\n",
+                      count, channelIdx, queued);
+    }
+}
+
+void MeshBerryMesh::onHistorySyncData(int channelIdx, const uint8_t* data, size_t len) {
+    if (!_historySyncEnabled) return;
+
+    uint8_t kind = data[5];
+    const uint8_t* body = &data[HistorySync::SYNC_HEADER_LEN];
+    size_t bodyLen = len - HistorySync::SYNC_HEADER_LEN;
 
-            if (_repeatCallback) {
-                _repeatCallback(channelIdx, receivedHash, _channelStats[i].repeatCount);
+    if (kind == HistorySync::SYNC_KIND_SUMMARY) {
+        HistorySync::Summary remote;
+        if (!HistorySync::decodeSummary(body, bodyLen, remote)) return;
+
+        Serial.printf("[SYNC] Summary received: ch=%d, items=%d\n", channelIdx, remote.count);
+        queueHistoryRecords(channelIdx, remote);
+
+        // Answer with our own summary so the neighbour can fill our gaps too
+        if (millis() - _syncLastSummaryAt[channelIdx] > SYNC_SUMMARY_GAP_MS) {
+            sendHistorySummary(channelIdx, getRNG()->nextInt(1000, 4000));
+        }
+    } else if (kind == HistorySync::SYNC_KIND_RECORD && bodyLen > 4) {
+        uint32_t msgTimestamp;
+        memcpy(&msgTimestamp, body, 4);
+
+        char textBuf[HistorySync::SYNC_MAX_RECORD_TEXT + 1];
+        size_t textLen = bodyLen - 4;
+        if (textLen > HistorySync::SYNC_MAX_RECORD_TEXT) textLen = HistorySync::SYNC_MAX_RECORD_TEXT;
+        memcpy(textBuf, body + 4, textLen);
+        textBuf[textLen] = '\0';
+
+        // Split "Sender: text" the same way the archive stores it
+        char senderName[ARCHIVE_SENDER_LEN] = "";
+        const char* msgText = textBuf;
+        const char* colonPos = strstr(textBuf, ": ");
+        if (colonPos && (size_t)(colonPos - textBuf) < sizeof(senderName)) {
+            size_t nameLen = colonPos - textBuf;
+            memcpy(senderName, textBuf, nameLen);
+            senderName[nameLen] = '\0';
+            msgText = colonPos + 2;
+        }
+        uint32_t key = HistorySync::messageKey(msgTimestamp, senderName, msgText);
+
+        // Someone else answered - drop our copy of the same record
+        for (int i = 0; i < MAX_SYNC_OUT; i++) {
+            if (_syncOut[i].active && _syncOut[i].key == key && _syncOut[i].channelIdx == channelIdx) {
+                _syncOut[i].active = false;
             }
-            return;
         }
+
+        if (HistorySync::hasMessage(channelIdx, key)) return;
+
+        // A recovered reaction becomes a badge, as when heard live
+        if (msgText != textBuf && onReactionText(channelIdx, 0, senderName, msgText)) return;
+
+        _syncRecordsRecovered++;
+        Serial.printf("[SYNC] Recovered message: ch=%d, key=%08X, ts=%u\n",
+                      channelIdx, key, msgTimestamp);
+
+        if (_historyCallback) {
+            _historyCallback(channelIdx, textBuf, msgTimestamp);
+        }
+    }
+}
+
+// =============================================================================
+// MESH TRACEROUTE
+// =============================================================================
+
+bool MeshBerryMesh::startTrace(const uint8_t* path, uint8_t hopCount, uint8_t probesPerHop, bool pingOnly) {
+    if (_trace.running) {
+        Serial.println("[TRACE] Trace already running");
+        return false;
+    }
+    if (!path || hopCount == 0 || hopCount > TraceRoute::TRACE_MAX_HOPS) {
+        Serial.println("[TRACE] Invalid trace path");
+        return false;
+    }
+    if (probesPerHop == 0) probesPerHop = 1;
+    if (probesPerHop > TraceRoute::TRACE_MAX_PROBES) probesPerHop = TraceRoute::TRACE_MAX_PROBES;
+
+    _trace.clear();
+    memcpy(_trace.path, path, hopCount);
+    _trace.hopCount = hopCount;
+    for (uint8_t i = 0; i < hopCount; i++) {
+        _trace.hops[i].hash = path[i];
+    }
+    _trace.probesPerHop = probesPerHop;
+    _trace.pingOnly = pingOnly;
+    _trace.currentDepth = pingOnly ? hopCount : 1;
+    _trace.currentProbe = 0;
+    _trace.running = true;
+
+    _traceAwaiting = false;
+    _traceNextAt = millis();
+
+    Serial.printf("[TRACE] Starting %s over %d hops (%d probes per depth)\n",
+                  pingOnly ? "ping" : "trace", hopCount, probesPerHop);
+    return true;
+}
+
+int MeshBerryMesh::buildTracePath(uint32_t nodeId, uint8_t* out, int maxLen) {
+    if (!out || maxLen <= 0) return -1;
+
+    // Heard nodes already have a keyed record; only contacts need seeding
+    int slot = _peers.find(nodeId);
+    if (slot == PeerTable::NONE || !(_peers.hot(slot).flags & PEER_HAS_KEY)) {
+        slot = findOrCreatePeer(nodeId);
+    }
+    if (slot < 0) return -1;
+    const PeerHot& h = _peers.hot(slot);
+
+    int len = -1;
+    if (isPathValid(h.outPathLen, h.pathLearnedAt) && h.outPathLen <= maxLen) {
+        memcpy(out, _peers.cold(slot).outPath, h.outPathLen);
+        len = h.outPathLen;
+    } else {
+        RoutePlanner::Route route;
+        if (RoutePlanner::planRoute(h.hashByte, getRTCClock()->getCurrentTime(), route) &&
+            route.hopCount <= maxLen) {
+            memcpy(out, route.hops, route.hopCount);
+            len = route.hopCount;
+        }
+    }
+
+    // A repeater target answers the trace itself, so it ends the path
+    if (len >= 0 && h.type == NODE_TYPE_REPEATER && len < maxLen) {
+        out[len++] = h.hashByte;
+    }
+    return (len > 0) ? len : -1;
+}
+
+void MeshBerryMesh::cancelTrace() {
+    if (!_trace.running) return;
+    _trace.running = false;
+    _traceAwaiting = false;
+    Serial.println("[TRACE] Cancelled");
+}
+
+bool MeshBerryMesh::sendTraceProbe() {
+    uint8_t probePath[TraceRoute::TRACE_MAX_PROBE_PATH];
+    uint8_t probeLen = TraceRoute::buildProbePath(_trace.path, _trace.currentDepth, probePath);
+    if (probeLen == 0) return false;
+
+    _traceTag = getRNG()->nextInt(1, 0x7FFFFFFF);
+    mesh::Packet* pkt = createTrace(_traceTag, 0, 0);
+    if (!pkt) {
+        Serial.println("[TRACE] Failed to create trace packet");
+        return false;
+    }
+
+    // The path moves into the payload and every repeater adds an SNR byte
+    uint32_t airtime = _radio->getEstAirtimeFor(pkt->getRawLength() + 2 * probeLen);
+
+    // TRACE packets carry their route in the payload; sendDirect() moves it there
+    sendDirect(pkt, probePath, probeLen);
+
+    TraceRoute::HopStats& hop = _trace.hops[_trace.currentDepth - 1];
+    hop.sent++;
+    _traceSentAt = millis();
+    _traceDeadline = _traceSentAt + TraceRoute::probeTimeoutMs(probeLen, airtime);
+    _traceAwaiting = true;
+    return true;
+}
+
+void MeshBerryMesh::advanceTrace() {
+    _traceAwaiting = false;
+    _trace.currentProbe++;
+    if (_trace.currentProbe >= _trace.probesPerHop) {
+        _trace.currentProbe = 0;
+        _trace.currentDepth++;
+    }
+
+    if (_trace.currentDepth > _trace.hopCount) {
+        _trace.running = false;
+        _trace.complete = true;
+        Serial.println("[TRACE] Complete");
+        if (_traceCallback) {
+            _traceCallback(_trace);
+        }
+        return;
+    }
+
+    // Small jitter so repeated probes do not lock step with other traffic
+    _traceNextAt = millis() + TraceRoute::TRACE_PROBE_GAP_MS + getRNG()->nextInt(0, 250);
+}
+
+void MeshBerryMesh::processTrace() {
+    if (!_trace.running) return;
+
+    uint32_t now = millis();
+    if (_traceAwaiting) {
+        if ((int32_t)(now - _traceDeadline) >= 0) {
+            Serial.printf("[TRACE] Probe to depth %d timed out\n", _trace.currentDepth);
+            advanceTrace();
+        }
+        return;
+    }
+
+    if ((int32_t)(now - _traceNextAt) >= 0) {
+        if (!sendTraceProbe()) {
+            advanceTrace();
+        }
+    }
+}
+
+void MeshBerryMesh::onTraceRecv(mesh::Packet* packet, uint32_t tag, uint32_t auth_code, uint8_t flags,
+                                const uint8_t* path_snrs, const uint8_t* path_hashes, uint8_t path_len) {
+    if (!_trace.running || !_traceAwaiting || tag != _traceTag) return;
+
+    uint32_t rtt = millis() - _traceSentAt;
+    uint8_t depth = _trace.currentDepth;
+    TraceRoute::HopStats& hop = _trace.hops[depth - 1];
+
+    hop.addReply(rtt);
+
+    // Each repeater stamps the SNR (x4) it received the probe at; entry
+    // depth-1 is the outbound link into the deepest hop
+    if (path_snrs && path_len >= depth) {
+        hop.snrSum += (float)(int8_t)path_snrs[depth - 1] / 4.0f;
+    }
+
+    Serial.printf("[TRACE] Depth %d reply: rtt=%ums, hop SNR=%.1f, final SNR=%.1f\n",
+                  depth, rtt,
+                  (path_snrs && path_len >= depth) ? (float)(int8_t)path_snrs[depth - 1] / 4.0f : 0.0f,
+                  packet->getSNR());
+
+    advanceTrace();
+}
+
+// =============================================================================
+// NEIGHBOUR DISCOVERY
+// =============================================================================
+//
+// Uses MeshCore's zero-hop CONTROL discover exchange, which repeater
+// firmware already answers:
+//   request:  [0x80][type filter][tag(4)][since(4)]
+//   response: [0x90 | node type][request SNR x4][tag(4)][public key(32)]
+
+void MeshBerryMesh::requestDiscovery(uint32_t delayMs) {
+    _discoverBurstLeft = DISCOVER_BURST_REQUESTS;
+    _discoverNextAt = millis() + delayMs;
+    _discoverFound = 0;
+    memset(_discoverSeen, 0, sizeof(_discoverSeen));
+}
+
+void MeshBerryMesh::processDiscovery() {
+    if (_discoverBurstLeft == 0) return;
+    if ((int32_t)(millis() - _discoverNextAt) < 0) return;
+
+    sendDiscoverRequest();
+    _discoverBurstLeft--;
+
+    // Next request once every reply slot of this one has passed
+    _discoverNextAt = millis() + DISCOVER_SLOTS * discoverSlotMs() + 500;
+    if (_discoverBurstLeft == 0) {
+        Serial.printf("[DISCOVER] Burst sent, %d neighbours so far\n", _discoverFound);
+    }
+}
+
+void MeshBerryMesh::sendDiscoverRequest() {
+    uint8_t data[10];
+    _discoverTag = getRNG()->nextInt(1, 0x7FFFFFFF);
+    uint32_t since = 0;
+
+    data[0] = DISCOVER_REQ;
+    data[1] = (1 << NODE_TYPE_CHAT) | (1 << NODE_TYPE_REPEATER) |
+              (1 << NODE_TYPE_ROOM) | (1 << NODE_TYPE_SENSOR);
+    memcpy(&data[2], &_discoverTag, 4);
+    memcpy(&data[6], &since, 4);
+
+    mesh::Packet* pkt = createControlData(data, sizeof(data));
+    if (!pkt) {
+        Serial.println("[DISCOVER] Failed to create request");
+        return;
+    }
+    sendZeroHop(pkt);
+    Serial.printf("[DISCOVER] Request sent (tag=%08X)\n", _discoverTag);
+}
+
+void MeshBerryMesh::onControlDataRecv(mesh::Packet* packet) {
+    if (packet->payload_len < 6) return;
+    uint8_t kind = packet->payload[0] & 0xF0;
+
+    if (kind == DISCOVER_RESP) {
+        onDiscoverResponse(packet, packet->payload, packet->payload_len);
+        return;
+    }
+
+    if (kind != DISCOVER_REQ) return;
+
+    // Answer requests that ask for chat nodes, in a random slot so
+    // neighbours answering the same request rarely collide
+    uint8_t filter = packet->payload[1];
+    if (!(filter & (1 << NODE_TYPE_CHAT))) return;
+
+    // Answer every request of a burst, so a reply that collided gets its
+    // second chance, but no more than one burst's worth per window
+    if (_discoverReplies == 0 || millis() - _discoverReplyWindowAt >= DISCOVER_REPLY_WINDOW_MS) {
+        _discoverReplyWindowAt = millis();
+        _discoverReplies = 0;
     }
+    if (_discoverReplies >= DISCOVER_BURST_REQUESTS) return;
+    _discoverReplies++;
+
+    uint8_t data[6 + PUB_KEY_SIZE];
+    data[0] = DISCOVER_RESP | NODE_TYPE_CHAT;
+    data[1] = (uint8_t)packet->_snr;
+    memcpy(&data[2], &packet->payload[2], 4);   // Echo the request tag
+    memcpy(&data[6], self_id.pub_key, PUB_KEY_SIZE);
+
+    mesh::Packet* resp = createControlData(data, sizeof(data));
+    if (resp) {
+        uint32_t slot = getRNG()->nextInt(0, DISCOVER_SLOTS);
+        sendZeroHop(resp, slot * discoverSlotMs());
+    }
+}
+
+uint32_t MeshBerryMesh::discoverSlotMs() {
+    // Replies in neighbouring slots must not overlap. Every node on the
+    // mesh shares the radio settings, so requester and responders agree.
+    return _radio->getEstAirtimeFor(DISCOVER_RESP_RAW_LEN) + DISCOVER_SLOT_GUARD_MS;
+}
+
+void MeshBerryMesh::onDiscoverResponse(mesh::Packet* packet, const uint8_t* data, size_t len) {
+    uint32_t tag;
+    memcpy(&tag, &data[2], 4);
+    if (tag != _discoverTag || len < 6 + 8) return;
+
+    const uint8_t* pubKey = &data[6];
+    uint8_t hash = pubKey[0];
+    NodeType type = (NodeType)(data[0] & 0x0F);
+    float theirSnr = (float)(int8_t)data[1] / 4.0f;
+    float ourSnr = packet->getSNR();
+
+    bool firstReply = !(_discoverSeen[hash >> 3] & (1 << (hash & 7)));
+    _discoverSeen[hash >> 3] |= (1 << (hash & 7));
+    if (firstReply && _discoverFound < 255) _discoverFound++;
+
+    // Direct link; rate it by the weaker direction
+    uint8_t chain[2] = { hash, self_id.pub_key[0] };
+    Topology::observeChain(chain, 2, (theirSnr < ourSnr) ? theirSnr : ourSnr, true,
+                           getRTCClock()->getCurrentTime());
+
+    // Known contacts become single-hop routes; unknown nodes are left to
+    // their next advert, since the response carries no name
+    if (len < 6 + PUB_KEY_SIZE) return;
+
+    ContactSettings& contacts = SettingsManager::getContactSettings();
+    int idx = contacts.findContactByPubKey(pubKey);
+    ContactEntry* c = (idx >= 0) ? contacts.getContact(idx) : nullptr;
+    if (!c) {
+        Serial.printf("[DISCOVER] Unknown neighbour [%02X] type=%d SNR %.1f/%.1f\n",
+                      hash, type, ourSnr, theirSnr);
+        return;
+    }
+
+    c->lastSnr = ourSnr;
+    c->lastHeard = getRTCClock()->getCurrentTime();
+
+    // Refresh the peer record, keeping any advert details (location)
+    NodeInfo node;
+    if (!findNode(c->id, node)) {
+        memset(&node, 0, sizeof(node));
+    }
+    node.id = c->id;
+    strncpy(node.name, c->name, sizeof(node.name) - 1);
+    node.type = c->type;
+    node.rssi = (int16_t)_radio->getLastRSSI();   // Local lane drains in the pass it arrived
+    node.snr = ourSnr;
+    node.lastHeard = c->lastHeard;
+    updateNode(node, pubKey);
+
+    int slot = _peers.find(c->id);
+    const PeerHot& h = _peers.hot(slot);
+    if (!isPathValid(h.outPathLen, h.pathLearnedAt) || h.outPathLen > 0) {
+        _peers.setPath(slot, nullptr, 0);
+    }
+
+    if (firstReply) {
+        Serial.printf("[DISCOVER] Neighbour %s [%02X] SNR %.1f/%.1f - direct route set\n",
+                      c->name, hash, ourSnr, theirSnr);
+    }
+}
+
+// =============================================================================
+// POSITION BEACONS
+// =============================================================================
+//
+// Reports ride on a channel as GRP_DATA so only holders of the channel key
+// can track the team. The send decision (dead reckoning against our own
+// last report) is in PositionBeacon; this layer only frames and floods.
+
+void MeshBerryMesh::setPositionSharing(bool enabled, int channelIdx, uint16_t thresholdM) {
+    if (thresholdM < PositionBeacon::POS_THRESHOLD_MIN_M) thresholdM = PositionBeacon::POS_THRESHOLD_MIN_M;
+    if (thresholdM > PositionBeacon::POS_THRESHOLD_MAX_M) thresholdM = PositionBeacon::POS_THRESHOLD_MAX_M;
+
+    // Anyone can read Public or a #hashtag channel; never broadcast where we are there
+    if (enabled && !SettingsManager::getChannelSettings().isPrivate(channelIdx)) {
+        Serial.printf("[POS] Channel %d is not private - sharing stays off\n", channelIdx);
+        enabled = false;
+    }
+
+    // Start over with a keyframe whenever the configuration changes
+    if (enabled != _posShareEnabled || channelIdx != _posChannel) {
+        PositionBeacon::resetSender();
+    }
+    _posShareEnabled = enabled;
+    _posChannel = channelIdx;
+    _posThresholdM = thresholdM;
+    Serial.printf("[POS] Sharing %s: ch=%d, threshold=%dm\n",
+                  enabled ? "on" : "off", channelIdx, thresholdM);
+}
+
+uint32_t MeshBerryMesh::getSelfId() const {
+    uint8_t hash[MAX_HASH_SIZE];
+    self_id.copyHashTo(hash);
+    uint32_t id;
+    memcpy(&id, hash, sizeof(id));
+    return id;
+}
+
+void MeshBerryMesh::updatePosition(const PositionBeacon::Fix& fix, float hdop) {
+    PositionBeacon::expireTracks(millis());
+    if (!_posShareEnabled || hdop > PositionBeacon::POS_MAX_HDOP) return;
+
+    uint8_t payload[PositionBeacon::POS_MAX_PAYLOAD];
+    size_t len = PositionBeacon::update(fix, millis(), getRTCClock()->getCurrentTime(),
+                                        getSelfId(), _posThresholdM, payload);
+    if (len == 0) return;
+
+    mesh::GroupChannel channel;
+    if (!buildGroupChannel(_posChannel, channel)) {
+        Serial.printf("[POS] Channel %d not active - report dropped\n", _posChannel);
+        return;
+    }
+
+    mesh::Packet* pkt = createGroupDatagram(PAYLOAD_TYPE_GRP_DATA, channel, payload, len);
+    if (!pkt) {
+        Serial.println("[POS] Failed to create report packet");
+        return;
+    }
+    sendFlood(pkt);
+
+    const PositionBeacon::SenderStats& st = PositionBeacon::getSenderStats();
+    Serial.printf("[POS] Report %s sent: %.6f,%.6f %.1fm/s %.0fdeg (err %.0fm, %lu/%lu checks)\n",
+                  len == PositionBeacon::POS_HEADER_LEN + PositionBeacon::POS_FULL_BODY_LEN ? "key" : "delta",
+                  fix.lat, fix.lon, fix.speedMps, fix.courseDeg, st.lastErrorM,
+                  (unsigned long)st.reports, (unsigned long)st.checks);
+}
+
+void MeshBerryMesh::onPositionReport(mesh::Packet* packet, const uint8_t* data, size_t len) {
+    uint32_t senderId;
+    memcpy(&senderId, &data[6], 4);
+    if (senderId == getSelfId()) return;
+
+    uint8_t hops = packet->isRouteFlood() ? packet->path_len : 0;
+    const PositionBeacon::Track* t = PositionBeacon::onReport(data, len, millis(), hops);
+    if (!t) return;
+
+    // The sender id is a claim, not a signature, so the report stays in
+    // the team tracks and never updates the peer table
+
+    Serial.printf("[POS] %08X at %.6f,%.6f %.1fm/s %.0fdeg (%d hops)\n",
+                  senderId, t->report.lat, t->report.lon, t->report.speedMps,
+                  t->report.courseDeg, hops);
 }
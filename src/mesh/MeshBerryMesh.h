@@ -27,73 +27,100 @@
 
 #include <Arduino.h>
 #include <Mesh.h>
-#include <helpers/SimpleMeshTables.h>
+#include "MeshBerrySeenTable.h"
+#include "MeshBerryRTCClock.h"
+#include "NodeType.h"
 #include <helpers/StaticPoolPacketManager.h>
 #include "../config.h"
 #include "../board/TDeckBoard.h"
+#include "HistorySync.h"
+#include "Topology.h"
+#include "TraceRoute.h"
+#include "PositionBeacon.h"
+#include "Reaction.h"
+#include "ForwardLimiter.h"
+#include "PeerTable.h"
+#include "../util/RingBuffer.h"
+#include "../util/LruCache.h"
 
 // Forward declarations
 class MeshBerryRadio;
 
 /**
- * Arduino-compatible millisecond clock for MeshCore
+ * RX triage lanes, highest priority first (see MeshBerryMesh::onRecvPacket)
  */
-class ArduinoMillisClock : public mesh::MillisecondClock {
-public:
-    unsigned long getMillis() override {
-        return millis();
-    }
+enum RxLane : uint8_t {
+    RX_LANE_LOCAL = 0,      // ACKs and packets addressed to us
+    RX_LANE_FORWARD,        // Channel floods and relays
+    RX_LANE_ADVERT,         // Adverts, deferred to idle
+    RX_LANE_COUNT
 };
 
 /**
- * ESP32 RTC clock implementation for MeshCore
+ * Per-lane queueing statistics
  */
-class ESP32RTCClock : public mesh::RTCClock {
-private:
-    uint32_t _epoch_offset;
-    bool _timeIsSet;  // true once clock has been synced from GPS, peer, or manual set
-
-public:
-    // Minimum valid epoch: Jan 1, 2025 (1735689600)
-    static constexpr uint32_t MIN_VALID_EPOCH = 1735689600;
-
-    ESP32RTCClock() : _timeIsSet(false) {
-        // Set a reasonable default epoch (Jan 1, 2025 = 1735689600)
-        // This ensures timestamps are plausible even before syncing from advertisements
-        // The exact time will be synced from received advertisements
-        _epoch_offset = MIN_VALID_EPOCH;
-    }
+struct RxLaneStats {
+    uint32_t queued;        // Packets held in the lane
+    uint32_t bypassed;      // Lane full, processed inline
+    uint32_t processed;     // Drained from the lane
+    uint32_t waitTotalMs;   // Sum of queue wait (arrival to handling)
+    uint32_t waitMaxMs;
+    uint32_t busyTotalMs;   // Sum of handling time
+    uint8_t depthMax;
+};
 
-    void begin() {
-        // Could sync with NTP or GPS here
-    }
+/**
+ * Channel send coalescing counters
+ */
+struct CoalesceStats {
+    uint32_t messages;      // Channel messages queued while coalescing
+    uint32_t packets;       // Packets they went out in
+    uint32_t bytesSaved;    // On-air bytes saved against one packet each
+};
 
-    uint32_t getCurrentTime() override {
-        return (millis() / 1000) + _epoch_offset;
-    }
+/**
+ * Emoji reaction counters
+ */
+struct ReactionStats {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t sentAirBytes;      // On-air bytes of the reactions we sent
+    uint32_t plainAirBytes;     // Same emoji sent as a plain reply instead
+    uint32_t emojiReplies;      // Lone-emoji channel messages heard
+    uint32_t emojiReplyBytes;   // Their on-air bytes
+};
 
-    void setCurrentTime(uint32_t time) override {
-        _epoch_offset = time - (millis() / 1000);
-        _timeIsSet = true;  // Mark as set
-    }
+/**
+ * Channel auto-resend counters
+ */
+struct ResendStats {
+    uint32_t watched;       // Channel packets watched for a relay
+    uint32_t relayed;       // Relay heard within the window
+    uint32_t resent;        // No relay heard, sent once more
+    uint32_t rescued;       // Relay heard only after the resend
+    uint32_t resendAirBytes;    // On-air bytes spent on resends
+    uint32_t duplicates;    // Received copies dropped by sender and text
+};
 
-    /**
-     * Check if time has been set (from GPS, peer, or manual)
-     */
-    bool isTimeSet() const { return _timeIsSet; }
+/**
+ * Cut-through forwarding counters
+ */
+struct CutThroughStats {
+    uint32_t relayed;       // Floods retransmitted from the header alone
+    uint32_t duplicates;    // Copies of an already cut-through flood
+    uint32_t noPacket;      // Pool empty, left to the normal path
+    uint32_t suppressed;    // Normal-path forwards skipped as already sent
+    uint32_t savedTotalMs;  // Sum of (normal-path decision - cut-through) time
+    uint32_t savedMaxMs;
+};
 
-    /**
-     * Try to sync time from a peer timestamp (only if not already set)
-     * @param peerTime Unix timestamp from a peer
-     * @return true if time was synced
-     */
-    bool trySyncFromPeer(uint32_t peerTime) {
-        // Only sync if not already set and peer time is valid
-        if (!_timeIsSet && peerTime > MIN_VALID_EPOCH) {
-            setCurrentTime(peerTime);
-            return true;
-        }
-        return false;
+/**
+ * Arduino-compatible millisecond clock for MeshCore
+ */
+class ArduinoMillisClock : public mesh::MillisecondClock {
+public:
+    unsigned long getMillis() override {
+        return millis();
     }
 };
 
@@ -109,17 +136,6 @@ public:
     }
 };
 
-/**
- * Node types (from MeshCore AdvertDataHelpers.h)
- */
-enum NodeType : uint8_t {
-    NODE_TYPE_UNKNOWN = 0,
-    NODE_TYPE_CHAT = 1,      // Regular chat client
-    NODE_TYPE_REPEATER = 2,  // Repeater/relay node
-    NODE_TYPE_ROOM = 3,      // Room server (bulletin board)
-    NODE_TYPE_SENSOR = 4     // Sensor node
-};
-
 /**
  * Node information structure
  */
@@ -153,7 +169,7 @@ struct Message {
 class MeshBerryMesh : public mesh::Mesh {
 public:
     MeshBerryMesh(mesh::Radio& radio, mesh::RNG& rng, mesh::RTCClock& rtc,
-                  SimpleMeshTables& tables, StaticPoolPacketManager& mgr);
+                  MeshBerrySeenTable& tables, StaticPoolPacketManager& mgr);
 
     /**
      * Initialize the mesh network
@@ -180,6 +196,66 @@ public:
      */
     bool sendToChannel(int channelIdx, const char* text);
 
+    /**
+     * Hold outgoing channel text for windowMs after each message and merge
+     * consecutive messages to the same channel into one packet
+     * @param windowMs Hold window, 0 = send each message immediately
+     */
+    void setChannelCoalesceWindow(uint16_t windowMs);
+    uint16_t getChannelCoalesceWindow() const { return _coalesceWindowMs; }
+
+    /**
+     * Send any held channel text now
+     */
+    void flushChannelCoalesce();
+
+    const CoalesceStats& getCoalesceStats() const { return _coalesceStats; }
+
+    /**
+     * Resend a channel packet once, after a jittered wait, if no node is
+     * heard relaying it within channelResendWindow()
+     */
+    void setChannelResend(bool enabled);
+    bool getChannelResend() const { return _resendEnabled; }
+
+    const ResendStats& getResendStats() const { return _resendStats; }
+
+    /**
+     * How long to wait for a relay of a channel packet, from the current
+     * radio settings
+     * @param rawLen On-air packet length
+     */
+    uint32_t channelResendWindow(size_t rawLen);
+
+    /**
+     * React to a channel message
+     * @param ref Reaction::refHash() of the message's sender and text
+     * @param emoji EMOJI_TABLE index
+     * @return true if sent
+     */
+    bool sendChannelReaction(int channelIdx, uint32_t ref, uint16_t emoji);
+
+    /**
+     * React to a DM (always the text form, which other clients can read)
+     * @param ref Reaction::refHash() of the message text (no sender)
+     * @param emoji EMOJI_TABLE index
+     * @return true if sent
+     */
+    bool sendDirectReaction(uint32_t contactId, uint32_t ref, uint16_t emoji);
+
+    /**
+     * Wire form for channel reactions (Reaction::REACT_FORM_*)
+     */
+    void setReactionForm(uint8_t form) { _reactForm = form; }
+    uint8_t getReactionForm() const { return _reactForm; }
+
+    const ReactionStats& getReactionStats() const { return _reactStats; }
+
+    /**
+     * On-air bytes of a compact reaction
+     */
+    static size_t compactReactionAirBytes();
+
     /**
      * Send advertisement packet
      */
@@ -198,17 +274,68 @@ public:
     /**
      * Get number of known nodes
      */
-    int getNodeCount() const { return _nodeCount; }
+    int getNodeCount() const { return (int)_peers.size(); }
 
     /**
-     * Get node info by index
+     * Get node info by index (0 = most recently heard or used)
+     * Walks the list to the index; use firstNode()/nextNode() to iterate.
      */
     bool getNodeInfo(int index, NodeInfo& info) const;
 
+    static constexpr int NODE_END = PeerTable::NONE;
+
+    /**
+     * Walk known nodes, most recently heard or used first:
+     *   for (int c = firstNode(info); c != NODE_END; c = nextNode(c, info))
+     * Nodes must not be added or used during the walk.
+     * @return Cursor for nextNode(), or NODE_END when there are no more
+     */
+    int firstNode(NodeInfo& info) const;
+    int nextNode(int cursor, NodeInfo& info) const;
+
+    /**
+     * Get node info by node ID
+     * @return false if the node is not tracked
+     */
+    bool findNode(uint32_t id, NodeInfo& info) const;
+
+    /**
+     * Most recently heard node whose name starts with namePrefix
+     * (case-insensitive)
+     * @return false if none matches
+     */
+    bool findNodeByName(const char* namePrefix, NodeInfo& info) const;
+
+    /**
+     * Learned route length to a node
+     * @return Hops (0 = direct neighbour), or -1 if unknown or expired
+     */
+    int getPathLen(uint32_t id) const;
+
+    /**
+     * Invalidate (clear) path to a contact
+     * @param contactId Node ID to clear path for
+     */
+    void invalidatePath(uint32_t contactId);
+
+    /**
+     * Add a discovered node to the persisted contact list (user action or
+     * DM activity); an existing contact is marked recently used
+     * @return Contact index, or -1 if the node's key is unknown or every
+     *         contact is a favorite
+     */
+    int promoteToContact(uint32_t id);
+
+    /**
+     * Which adverts and DMs admit a node as a contact (CONTACT_ADMIT_*)
+     */
+    void setContactAdmission(uint8_t rules) { _contactAdmit = rules; }
+    uint8_t getContactAdmission() const { return _contactAdmit; }
+
     /**
      * Get number of messages
      */
-    int getMessageCount() const { return _messageCount; }
+    int getMessageCount() const { return (int)_messages.size(); }
 
     /**
      * Get message by index
@@ -259,6 +386,15 @@ public:
      */
     bool isForwardingEnabled() const { return _forwardingEnabled; }
 
+    /**
+     * Enable or disable cut-through flood forwarding (relay decision made
+     * from the header before local processing)
+     */
+    void setCutThroughEnabled(bool enabled) { _cutThroughEnabled = enabled; }
+    bool isCutThroughEnabled() const { return _cutThroughEnabled; }
+    const CutThroughStats& getCutThroughStats() const { return _cutStats; }
+    void resetCutThroughStats() { memset(&_cutStats, 0, sizeof(_cutStats)); }
+
     /**
      * Check if there is pending work (outbound packets queued)
      * Used by power management to determine if safe to sleep
@@ -335,6 +471,18 @@ public:
      */
     void setRepeatCallback(RepeatCallback cb) { _repeatCallback = cb; }
 
+    /**
+     * Callback type for a reaction added to a message badge
+     * @param channelIdx Channel index, or -1 for a DM
+     * @param contactId DM contact (0 for channels)
+     */
+    typedef void (*ReactionCallback)(int channelIdx, uint32_t contactId);
+
+    /**
+     * Set reaction callback
+     */
+    void setReactionCallback(ReactionCallback cb) { _reactionCallback = cb; }
+
     // =========================================================================
     // DIRECT MESSAGING
     // =========================================================================
@@ -384,6 +532,140 @@ public:
      */
     uint8_t getRepeaterPermissions() const { return _repeaterPermissions; }
 
+    // =========================================================================
+    // CHANNEL HISTORY SYNC
+    // =========================================================================
+
+    /**
+     * Callback type for a channel message recovered from a neighbour
+     * @param channelIdx Index of the channel (0-7)
+     * @param senderAndText Message text in format "SenderName: message"
+     * @param timestamp Original Unix timestamp of the message
+     */
+    typedef void (*HistoryRecordCallback)(int channelIdx, const char* senderAndText, uint32_t timestamp);
+
+    /**
+     * Set history record callback
+     */
+    void setHistoryRecordCallback(HistoryRecordCallback cb) { _historyCallback = cb; }
+
+    /**
+     * Enable or disable channel history reconciliation (opt-in)
+     */
+    void setHistorySyncEnabled(bool enabled);
+
+    /**
+     * Check if history reconciliation is enabled
+     */
+    bool isHistorySyncEnabled() const { return _historySyncEnabled; }
+
+    /**
+     * Exchange summaries with neighbours soon (e.g. after wake)
+     */
+    void requestHistorySync();
+
+    /**
+     * Sync statistics
+     */
+    uint16_t getSyncRecordsSent() const { return _syncRecordsSent; }
+    uint16_t getSyncRecordsRecovered() const { return _syncRecordsRecovered; }
+
+    // =========================================================================
+    // MESH TRACEROUTE
+    // =========================================================================
+
+    /**
+     * Callback type for a finished trace or ping
+     */
+    typedef void (*TraceCallback)(const TraceRoute::Report& report);
+
+    /**
+     * Set trace completion callback
+     */
+    void setTraceCallback(TraceCallback cb) { _traceCallback = cb; }
+
+    /**
+     * Start a traceroute or ping along a source path of repeaters
+     * @param path Repeater path hashes, nearest first
+     * @param hopCount Number of repeaters (1..TRACE_MAX_HOPS)
+     * @param probesPerHop Probes sent at each depth
+     * @param pingOnly Only probe the full path (ping) instead of every depth
+     * @return true if started (false if busy or invalid)
+     */
+    bool startTrace(const uint8_t* path, uint8_t hopCount, uint8_t probesPerHop, bool pingOnly);
+
+    /**
+     * Build a trace path to a contact or heard node from its learned or
+     * planned route. Repeaters are appended as the final hop; other node
+     * types do not forward TRACE packets, so the path stops at their last
+     * repeater. Does not change the node's recency.
+     * @return Number of hops written, or -1 if no route is known
+     */
+    int buildTracePath(uint32_t nodeId, uint8_t* out, int maxLen);
+
+    void cancelTrace();
+    bool isTraceRunning() const { return _trace.running; }
+    const TraceRoute::Report& getTraceReport() const { return _trace; }
+
+    // =========================================================================
+    // NEIGHBOUR DISCOVERY
+    // =========================================================================
+
+    /**
+     * Start a zero-hop discovery burst (boot, wake, or on demand)
+     * Direct neighbours answer in randomised slots; known contacts that
+     * answer get a direct (0-hop) route straight away.
+     * @param delayMs Delay before the first request
+     */
+    void requestDiscovery(uint32_t delayMs = 0);
+
+    /**
+     * Neighbours that answered the most recent burst
+     */
+    uint8_t getDiscoveredCount() const { return _discoverFound; }
+
+    // =========================================================================
+    // POSITION BEACONS
+    // =========================================================================
+
+    /**
+     * Configure position sharing on a channel
+     * @param enabled Send beacons (receiving is always on)
+     * @param channelIdx Channel the beacons go to
+     * @param thresholdM Dead-reckoning error that triggers a report
+     */
+    void setPositionSharing(bool enabled, int channelIdx, uint16_t thresholdM);
+    bool isPositionSharing() const { return _posShareEnabled; }
+    int getPositionChannel() const { return _posChannel; }
+    uint16_t getPositionThreshold() const { return _posThresholdM; }
+
+    /**
+     * Offer the current GPS fix; a report is sent only when the fix has
+     * drifted from our last report's extrapolation
+     * @param fix Current position, speed (m/s) and course
+     * @param hdop Horizontal dilution of the fix
+     */
+    void updatePosition(const PositionBeacon::Fix& fix, float hdop);
+
+    /**
+     * Our node id as others see it in NodeInfo::id
+     */
+    uint32_t getSelfId() const;
+
+    // =========================================================================
+    // RX TRIAGE
+    // =========================================================================
+
+    /**
+     * Enable or disable RX lanes (disabled = MeshCore arrival order)
+     */
+    void setRxTriageEnabled(bool enabled);
+    bool isRxTriageEnabled() const { return _rxTriageEnabled; }
+
+    const RxLaneStats& getRxLaneStats(RxLane lane) const { return _rxLaneStats[lane]; }
+    uint8_t getRxLaneDepth(RxLane lane) const { return _rxLanes[lane].count; }
+    void resetRxLaneStats();
+
 protected:
     // MeshCore virtual method overrides
     void onAdvertRecv(mesh::Packet* packet, const mesh::Identity& id,
@@ -407,6 +689,16 @@ protected:
     // Enable packet forwarding for mesh relay
     bool allowPacketForward(const mesh::Packet* packet) override;
 
+    // Adds the forward limiter's deferral to a relay's delay
+    uint32_t getRetransmitDelay(const mesh::Packet* packet) override;
+
+    // Zero-hop control packets (neighbour discovery)
+    void onControlDataRecv(mesh::Packet* packet) override;
+
+    // Traceroute probe returned along its out-and-back path
+    void onTraceRecv(mesh::Packet* packet, uint32_t tag, uint32_t auth_code, uint8_t flags,
+                     const uint8_t* path_snrs, const uint8_t* path_hashes, uint8_t path_len) override;
+
     // Peer data handling for CLI responses
     int searchPeersByHash(const uint8_t* hash) override;
     void getPeerSharedSecret(uint8_t* dest_secret, int peer_idx) override;
@@ -417,16 +709,20 @@ private:
     char _nodeName[32];
     ArduinoMillisClock _msClock;
 
-    // Node tracking
-    static const int MAX_TRACKED_NODES = MAX_NODES;
-    NodeInfo _nodes[MAX_TRACKED_NODES];
-    int _nodeCount;
+    // Peer records: identity, secret, route, link stats, advert details
+    PeerTable _peers;
+    int _lastMatchedDMPeer;  // Peer slot of the packet being handled (-1 if none/repeater)
+
+    // Candidates for the last searchPeersByHash(), indexed by MeshCore's peer_idx
+    static const int MAX_PEER_MATCHES = 8;
+    static const int PEER_MATCH_REPEATER = -2;   // -1 marks an evicted candidate
+    int _peerMatches[MAX_PEER_MATCHES];
+    int _numPeerMatches;
+    uint8_t _contactAdmit;   // CONTACT_ADMIT_* rules
 
     // Message history
     static const int MAX_MESSAGES = MESSAGE_HISTORY;
-    Message _messages[MAX_MESSAGES];
-    int _messageCount;
-    int _messageHead;
+    RingBuffer<Message, MAX_MESSAGES> _messages;
 
     // Callbacks
     MessageCallback _msgCallback;
@@ -437,28 +733,9 @@ private:
     DMCallback _dmCallback;
     DeliveryCallback _deliveryCallback;
     RepeatCallback _repeatCallback;
-
-    // DM peer tracking (for decrypting incoming DMs)
-    struct DMPeer {
-        uint32_t contactId;
-        mesh::Identity identity;
-        uint8_t sharedSecret[32];
-        bool isActive;
-
-        // Routing info for direct messaging
-        uint8_t outPath[64];      // Learned path to this peer (max 64 hops)
-        int8_t outPathLen;        // -1 = unknown, 0+ = valid path length
-        uint32_t pathLearnedAt;   // millis() when path was learned
-
-        void clearPath() {
-            memset(outPath, 0, sizeof(outPath));
-            outPathLen = -1;
-            pathLearnedAt = 0;
-        }
-    };
-    static const int MAX_DM_PEERS = 8;
-    DMPeer _dmPeers[MAX_DM_PEERS];
-    int _lastMatchedDMPeer;  // Index of last matched DM peer (-1 if none/repeater)
+    ReactionCallback _reactionCallback;
+    HistoryRecordCallback _historyCallback;
+    TraceCallback _traceCallback;
 
     // Pending DM tracking for delivery status
     struct PendingDM {
@@ -471,10 +748,17 @@ private:
         uint8_t attempts;           // Send attempts
         uint8_t pathLen;            // Path length for dynamic retry calculation
         bool isFlood;               // True if last send was flood
-        bool active;                // Slot in use
+        bool planned;               // Last send used a RoutePlanner route
     };
+    // Keyed by ack_crc, least recently (re)sent evicted first
     static const int MAX_PENDING_DMS = 4;
-    PendingDM _pendingDMs[MAX_PENDING_DMS];
+    LruCache<uint32_t, PendingDM, MAX_PENDING_DMS> _pendingDMs;
+
+    // Contact id -> millis() its planned route last timed out; no planned
+    // route is tried for that contact again until the holdoff passes
+    static const int MAX_PLANNED_FAILURES = 8;
+    static const uint32_t PLANNED_ROUTE_HOLDOFF_MS = 30 * 60 * 1000UL;
+    LruCache<uint32_t, uint32_t, MAX_PLANNED_FAILURES> _plannedFailures;
 
     // Channel message repeat tracking
     struct ChannelMsgStats {
@@ -482,15 +766,144 @@ private:
         uint32_t sentAt;            // millis() when sent (for expiry)
         int channelIdx;             // Which channel
         uint8_t repeatCount;        // Times heard retransmitted
-        bool active;
     };
+    // Keyed by contentHash, in send order (repeats do not touch)
     static const int MAX_CHANNEL_STATS = 8;
     static const uint32_t CHANNEL_STATS_EXPIRY_MS = 60000;  // 60 seconds expiry
-    ChannelMsgStats _channelStats[MAX_CHANNEL_STATS];
+    LruCache<uint32_t, ChannelMsgStats, MAX_CHANNEL_STATS> _channelStats;
+
+    // Channel send coalescing: parts are joined with COALESCE_SEP after a
+    // single "Name: " prefix, and split again by MeshBerry receivers.
+    // Newline, UTF-8 "»", space: printable, so other clients show each
+    // part as a "» " continuation line rather than a control byte.
+    static constexpr const char* COALESCE_SEP = "\n\xC2\xBB ";
+    static const uint16_t COALESCE_MAX_WINDOW_MS = 10000;
+    static const size_t CHANNEL_TXT_MAX_PAYLOAD =
+        MAX_PACKET_PAYLOAD - 1 - CIPHER_MAC_SIZE - (CIPHER_BLOCK_SIZE - 1);
+    uint16_t _coalesceWindowMs;
+    int _coalesceChannel;           // -1 = nothing held
+    char _coalesceText[CHANNEL_TXT_MAX_PAYLOAD + 1];
+    size_t _coalesceLen;
+    uint8_t _coalesceParts;
+    uint32_t _coalesceFirstAt;
+    uint32_t _coalesceDueAt;
+    uint32_t _coalesceSeparateBytes;    // On-air bytes had each part gone alone
+    CoalesceStats _coalesceStats;
+
+    // Channel auto-resend: the plaintext is kept so the copy encrypts to
+    // the same bytes, and relays that forwarded the first one drop it
+    struct PendingResend {
+        uint32_t dueAt;             // millis() to resend, or to give up once resent
+        int channelIdx;
+        uint8_t channelHash;        // As sent, not as stored
+        bool resent;
+        uint8_t payloadLen;
+        uint8_t payload[5 + MAX_MESSAGE_LENGTH];
+    };
+    // Keyed by packet hash, oldest evicted first
+    static const int MAX_PENDING_RESENDS = 4;
+    static const uint32_t RESEND_BASE_MS = 1000;          // Queueing and CAD slack
+    static const uint32_t RESEND_AIRTIME_FACTOR = 5;      // Ours + relay hold + relay's
+    static const uint32_t RESEND_JITTER_FACTOR = 2;       // Up to 2 airtimes extra
+    static const int MAX_RECENT_CHANNEL_TEXT = 16;
+    bool _resendEnabled;
+    LruCache<uint32_t, PendingResend, MAX_PENDING_RESENDS> _pendingResends;
+    // Sender and text hash -> millis() first heard
+    LruCache<uint32_t, uint32_t, MAX_RECENT_CHANNEL_TEXT> _recentChannelText;
+    ResendStats _resendStats;
+
+    // Emoji reactions
+    uint8_t _reactForm;
+    ReactionStats _reactStats;
+
+    // Channel history sync (anti-entropy) state
+    struct SyncOutRecord {
+        uint32_t key;               // HistorySync::messageKey of the record
+        uint32_t queuedAt;          // millis() when queued
+        uint32_t delay;             // Jittered send delay (ms)
+        int channelIdx;             // Local channel index
+        ArchivedMessage msg;        // Record to send
+        bool active;
+    };
+    static const int MAX_SYNC_OUT = 4;                            // Records per exchange
+    static const uint32_t SYNC_INTERVAL_MS = 15 * 60 * 1000;      // Summary round period
+    static const uint32_t SYNC_SUMMARY_GAP_MS = 2 * 60 * 1000;    // Min gap per channel
+    static const int32_t SYNC_BUDGET_BYTES = 1024;                // Airtime budget...
+    static const uint32_t SYNC_BUDGET_WINDOW_MS = 10 * 60 * 1000; // ...per window
+    SyncOutRecord _syncOut[MAX_SYNC_OUT];
+    bool _historySyncEnabled;
+    uint32_t _syncNextSummaryAt;
+    uint32_t _syncLastSummaryAt[MAX_CHANNELS];
+    int _syncChannelCursor;
+    int32_t _syncBudget;
+    uint32_t _syncBudgetWindowStart;
+    uint16_t _syncRecordsSent;
+    uint16_t _syncRecordsRecovered;
+
+    // Traceroute state (one session, one probe in flight)
+    TraceRoute::Report _trace;
+    uint32_t _traceTag;             // Tag of the probe in flight
+    uint32_t _traceSentAt;          // millis() when the probe was sent
+    uint32_t _traceDeadline;        // Probe timeout (millis)
+    uint32_t _traceNextAt;          // Next probe send time (millis)
+    bool _traceAwaiting;            // Probe in flight
+
+    // Neighbour discovery (MeshCore CONTROL discover request/response)
+    static const uint8_t DISCOVER_REQ = 0x80;                     // Upper nibble: control type
+    static const uint8_t DISCOVER_RESP = 0x90;                    // Lower nibble: node type
+    static const uint8_t DISCOVER_SLOTS = 16;                     // Reply slots per request
+    static const uint32_t DISCOVER_SLOT_GUARD_MS = 20;            // Slot = reply airtime + guard
+    static const uint8_t DISCOVER_RESP_RAW_LEN = 2 + 6 + PUB_KEY_SIZE;
+    static const uint8_t DISCOVER_BURST_REQUESTS = 2;             // Second round catches collisions
+    static const uint32_t DISCOVER_REPLY_WINDOW_MS = 10000;       // Our own reply rate limit:
+                                                                  // one burst's worth per window
+    uint32_t _discoverTag;          // Tag of the latest request
+    uint32_t _discoverNextAt;       // Next request time (millis)
+    uint32_t _discoverReplyWindowAt; // Start of our current reply window
+    uint8_t _discoverReplies;       // Replies sent in that window
+    uint8_t _discoverBurstLeft;     // Requests still to send
+    uint8_t _discoverFound;         // Unique responders this burst
+    uint8_t _discoverSeen[32];      // Bitmap of responder hashes this burst
+
+    // RX triage lanes (held packets count against the 32-packet pool)
+    static const uint8_t RX_LANE_DEPTH = 4;
+    static const uint8_t RX_FORWARD_PER_PASS = 2;
+    static const uint32_t RX_ADVERT_MAX_WAIT_MS = 3000;
+    struct RxLaneQueue {
+        mesh::Packet* pkts[RX_LANE_DEPTH];
+        uint32_t queuedAt[RX_LANE_DEPTH];   // millis() at arrival
+        uint8_t head;
+        uint8_t count;
+    };
+    RxLaneQueue _rxLanes[RX_LANE_COUNT];
+    RxLaneStats _rxLaneStats[RX_LANE_COUNT];
+    bool _rxTriageEnabled;
+
+    // Position beacons
+    bool _posShareEnabled;
+    int _posChannel;
+    uint16_t _posThresholdM;
 
     // Forwarding state
     bool _forwardingEnabled;
 
+    // Cut-through forwarding: floods already retransmitted by the fast path
+    static const int CUT_RING_SIZE = 16;
+    struct CutEntry {
+        uint32_t hash;      // First 4 bytes of the MeshCore packet hash
+        uint32_t at;        // millis() when the copy was queued
+        bool dropped;       // Rate limited: no copy was sent
+    };
+    MeshBerrySeenTable& _seenTable;
+    CutEntry _cutRing[CUT_RING_SIZE];
+    uint8_t _cutRingHead;
+    bool _cutThroughEnabled;
+    CutThroughStats _cutStats;
+
+    // Relay deferred by the forward limiter, picked up by getRetransmitDelay()
+    uint32_t _deferHash;
+    bool _deferPending;
+
     // Repeater session state
     uint32_t _connectedRepeaterId;
     char _connectedRepeaterName[32];
@@ -504,15 +917,20 @@ private:
     // Add message to history
     void addMessage(const Message& msg);
 
-    // Add or update node
-    void updateNode(const NodeInfo& node);
+    // Add or update a node's peer record (pubKey may be nullptr)
+    void updateNode(const NodeInfo& node, const uint8_t* pubKey = nullptr);
 
     // Find channel index by hash
     int findChannelByHash(uint8_t hash);
 
-    // DM peer management
-    int findOrCreateDMPeer(uint32_t contactId);
-    int findDMPeerByHash(const uint8_t* hash);
+    // Peer table helpers
+    int acquirePeer(uint32_t id);
+    int findOrCreatePeer(uint32_t contactId);   // Seeds key and name from contacts
+    void addPeerMatch(int slot);
+    void collectPeerMatches(const uint8_t* hash, bool withSecret);  // Keyed records, newest first
+    void selectPeerMatch(int senderIdx);        // Candidate that decrypted the packet
+    const uint8_t* peerSecret(int slot);        // ECDH on first use, then cached
+    void peerToNodeInfo(int slot, NodeInfo& info) const;
 
     // Path management for routing
     static const uint32_t PATH_EXPIRY_MS = 30 * 60 * 1000;  // 30 minutes
@@ -533,23 +951,71 @@ private:
      */
     bool isPathValid(int8_t pathLen, uint32_t learnedAt) const;
 
-    /**
-     * Invalidate (clear) path to a contact
-     * @param contactId Node ID to clear path for
-     */
-    void invalidatePath(uint32_t contactId);
-
     // Pending DM management
-    int findFreePendingSlot();
+    int acquirePendingSlot(uint32_t ack_crc);
     int calculateMaxRetries(bool isFlood, uint8_t pathLen);
     void retryDMWithFlood(int pendingIdx);
     void retryDMWithDirect(int pendingIdx);
     void checkPendingTimeouts();
+    bool isPlannedRouteHeldOff(uint32_t contactId);
 
     // Channel repeat tracking
     void trackSentChannelMessage(int channelIdx, const char* text);
+    bool sendChannelText(int channelIdx, const char* text);
+    bool queueChannelCoalesce(int channelIdx, const char* text);
+    void processChannelCoalesce();
+    void watchChannelResend(int channelIdx, const mesh::Packet* pkt,
+                            const uint8_t* payload, size_t len);
+    void processChannelResend();
+    void noteChannelRelay(uint32_t packetHash);
+    bool isDuplicateChannelText(const mesh::Packet* packet, int channelIdx, const char* text);
+    size_t channelPrefixLen() const;
+    void deliverChannelText(mesh::Packet* packet, int channelIdx, const char* text, uint32_t timestamp);
     void checkChannelRepeat(int channelIdx, const char* text, const char* senderName);
     uint32_t hashChannelMessage(int channelIdx, const char* text);
+
+    // Channel history sync
+    bool buildGroupChannel(int channelIdx, mesh::GroupChannel& channel);
+    bool consumeSyncBudget(size_t bytes);
+    void processHistorySync();
+    bool sendHistorySummary(int channelIdx, uint32_t delayMs);
+    bool sendHistoryRecord(SyncOutRecord& rec);
+    void queueHistoryRecords(int channelIdx, const HistorySync::Summary& remote);
+    void onHistorySyncData(int channelIdx, const uint8_t* data, size_t len);
+
+    // Neighbour discovery
+    void processDiscovery();
+    void sendDiscoverRequest();
+    void onDiscoverResponse(mesh::Packet* packet, const uint8_t* data, size_t len);
+    uint32_t discoverSlotMs();
+
+    // Per-source forward rate limiting
+    ForwardLimiter::Verdict limitForward(const mesh::Packet* pkt);
+
+    // Cut-through forwarding
+    static uint32_t packetHash32(const mesh::Packet* pkt);
+    CutEntry* findCutEntry(uint32_t hash);
+    void cutThrough(mesh::Packet* pkt);
+
+    // RX triage
+    RxLane classifyRx(const mesh::Packet* pkt) const;
+    mesh::DispatcherAction handleRecvPacket(mesh::Packet* pkt);
+    void applyRxAction(mesh::Packet* pkt, mesh::DispatcherAction action);
+    bool drainRxLane(RxLane lane);
+    void processRxLanes();
+    bool hasQueuedRx() const;
+
+    // Emoji reactions
+    bool onReactionText(int channelIdx, uint32_t contactId, const char* sender, const char* text);
+    void onReactionPacket(int channelIdx, const uint8_t* data, size_t len);
+
+    // Position beacons
+    void onPositionReport(mesh::Packet* packet, const uint8_t* data, size_t len);
+
+    // Traceroute
+    void processTrace();
+    bool sendTraceProbe();
+    void advanceTrace();
 };
 
 #endif // MESHBERRY_MESH_H
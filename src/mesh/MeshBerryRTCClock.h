@@ -0,0 +1,200 @@
+/**
+ * MeshBerry RTC Clock
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * MeshCore RTC clock with a disciplined oscillator model, shared by the
+ * mesh and TimeSync. Kept out of MeshBerryMesh.h so TimeSync needs only
+ * this and MeshCore's RTCClock base.
+ */
+
+#ifndef MESHBERRY_RTC_CLOCK_H
+#define MESHBERRY_RTC_CLOCK_H
+
+#include <Arduino.h>
+#include <Mesh.h>
+
+/**
+ * Where the RTC time last came from
+ */
+enum TimeSource : uint8_t {
+    TIME_SOURCE_NONE = 0,    // Default epoch, never synced
+    TIME_SOURCE_PEER,        // First peer timestamp (trySyncFromPeer)
+    TIME_SOURCE_MESH,        // Disciplined by TimeSync from several peers
+    TIME_SOURCE_MANUAL,      // Set from the CLI
+    TIME_SOURCE_GPS          // Set from the GPS receiver
+};
+
+/**
+ * ESP32 RTC clock implementation for MeshCore
+ *
+ * Time is kept in milliseconds as a linear model of the local oscillator:
+ *   epochMs = localMs + offset + (localMs - skewRef) * skewPpm / 1e6
+ * TimeSync estimates offset and skew from the mesh and disciplines the
+ * clock through adjustMs() (slewed) and setSkewPpm().
+ */
+class ESP32RTCClock : public mesh::RTCClock {
+private:
+    int64_t _offsetMs;          // epochMs - localMs at skewRef
+    uint64_t _skewRefMs;        // localMs where the skew term is zero
+    int32_t _skewPpm;           // Oscillator rate correction
+    int32_t _slewPendingMs;     // Correction still to be slewed in
+    uint64_t _lastTickMs;       // localMs of the last slew step
+    uint32_t _lastMillis;       // For extending millis() past its 49-day wrap
+    uint32_t _millisHigh;
+    bool _timeIsSet;  // true once clock has been synced from GPS, peer, or manual set
+    TimeSource _source;
+    TimeSource _setSource;      // Source of the last hard set
+    uint32_t _setAtMillis;      // millis() of the last hard set
+
+public:
+    // Minimum valid epoch: Jan 1, 2025 (1735689600)
+    static constexpr uint32_t MIN_VALID_EPOCH = 1735689600;
+
+    // Corrections larger than this are stepped, smaller ones slewed
+    static constexpr int32_t STEP_THRESHOLD_MS = 2000;
+    // Slew rate: 1 ms of correction per 20 ms of elapsed time (5%)
+    static constexpr uint32_t SLEW_DIVISOR = 20;
+    static constexpr int32_t MAX_SKEW_PPM = 500;
+
+    ESP32RTCClock()
+        : _skewRefMs(0), _skewPpm(0), _slewPendingMs(0), _lastTickMs(0),
+          _lastMillis(0), _millisHigh(0), _timeIsSet(false),
+          _source(TIME_SOURCE_NONE), _setSource(TIME_SOURCE_NONE), _setAtMillis(0) {
+        // Set a reasonable default epoch (Jan 1, 2025 = 1735689600)
+        // This ensures timestamps are plausible even before syncing from advertisements
+        // The exact time will be synced from received advertisements
+        _offsetMs = (int64_t)MIN_VALID_EPOCH * 1000;
+    }
+
+    void begin() {
+        // Could sync with NTP or GPS here
+    }
+
+    /**
+     * Monotonic local milliseconds (millis() extended to 64 bits)
+     */
+    uint64_t localMs() {
+        uint32_t m = millis();
+        if (m < _lastMillis) _millisHigh++;
+        _lastMillis = m;
+        return ((uint64_t)_millisHigh << 32) | m;
+    }
+
+    /**
+     * Current epoch time in milliseconds
+     */
+    uint64_t nowMs() {
+        uint64_t local = localMs();
+        int64_t skew = ((int64_t)(local - _skewRefMs) * _skewPpm) / 1000000;
+        return (uint64_t)((int64_t)local + _offsetMs + skew);
+    }
+
+    uint32_t getCurrentTime() override {
+        return (uint32_t)(nowMs() / 1000);
+    }
+
+    void setCurrentTime(uint32_t time) override {
+        setCurrentTime(time, TIME_SOURCE_MANUAL);
+    }
+
+    /**
+     * Hard-set the clock, recording where the time came from
+     */
+    void setCurrentTime(uint32_t time, TimeSource source) {
+        uint64_t local = localMs();
+        int64_t skew = ((int64_t)(local - _skewRefMs) * _skewPpm) / 1000000;
+        _offsetMs = (int64_t)time * 1000 - (int64_t)local - skew;
+        _slewPendingMs = 0;
+        _timeIsSet = true;  // Mark as set
+        _source = source;
+        _setSource = source;
+        _setAtMillis = millis();
+    }
+
+    /**
+     * Correct the clock by deltaMs: stepped if large, otherwise slewed in
+     * gradually by tick() so time never jumps backwards.
+     * Replaces any correction that is still pending.
+     */
+    void adjustMs(int32_t deltaMs, TimeSource source) {
+        if (deltaMs > STEP_THRESHOLD_MS || deltaMs < -STEP_THRESHOLD_MS) {
+            _offsetMs += deltaMs;
+            _slewPendingMs = 0;
+        } else {
+            _slewPendingMs = deltaMs;
+            _lastTickMs = localMs();
+        }
+        _timeIsSet = true;
+        _source = source;
+    }
+
+    /**
+     * Set the oscillator rate correction (folds the old rate into the offset)
+     */
+    void setSkewPpm(int32_t ppm) {
+        if (ppm > MAX_SKEW_PPM) ppm = MAX_SKEW_PPM;
+        if (ppm < -MAX_SKEW_PPM) ppm = -MAX_SKEW_PPM;
+        uint64_t local = localMs();
+        _offsetMs += ((int64_t)(local - _skewRefMs) * _skewPpm) / 1000000;
+        _skewRefMs = local;
+        _skewPpm = ppm;
+    }
+
+    /**
+     * Apply pending slew; call from the main loop
+     */
+    void tick() {
+        uint64_t local = localMs();
+        uint64_t elapsed = local - _lastTickMs;
+        _lastTickMs = local;
+        if (_slewPendingMs == 0) return;
+
+        int32_t step = (int32_t)(elapsed / SLEW_DIVISOR);
+        if (step == 0) return;
+        if (_slewPendingMs > 0) {
+            if (step > _slewPendingMs) step = _slewPendingMs;
+            _offsetMs += step;
+            _slewPendingMs -= step;
+        } else {
+            if (step > -_slewPendingMs) step = -_slewPendingMs;
+            _offsetMs -= step;
+            _slewPendingMs += step;
+        }
+    }
+
+    /**
+     * Check if time has been set (from GPS, peer, or manual)
+     */
+    bool isTimeSet() const { return _timeIsSet; }
+
+    TimeSource getSource() const { return _source; }
+    // Unlike getSource(), not overwritten by later slews
+    TimeSource getSetSource() const { return _setSource; }
+    int32_t getSkewPpm() const { return _skewPpm; }
+    int32_t getSlewPendingMs() const { return _slewPendingMs; }
+
+    /**
+     * Milliseconds since the clock was last hard-set (GPS, CLI or first peer)
+     */
+    uint32_t msSinceSet() const { return millis() - _setAtMillis; }
+
+    /**
+     * Try to sync time from a peer timestamp (only if not already set)
+     * @param peerTime Unix timestamp from a peer
+     * @return true if time was synced
+     */
+    bool trySyncFromPeer(uint32_t peerTime) {
+        // Only sync if not already set and peer time is valid
+        if (!_timeIsSet && peerTime > MIN_VALID_EPOCH) {
+            setCurrentTime(peerTime, TIME_SOURCE_PEER);
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // MESHBERRY_RTC_CLOCK_H
@@ -27,6 +27,7 @@
 
 #include <helpers/radiolib/CustomSX1262.h>
 #include <helpers/radiolib/RadioLibWrappers.h>
+#include "BandSurvey.h"
 
 /**
  * MeshBerry-specific SX1262 wrapper that avoids accessing private RadioLib members
@@ -66,4 +67,62 @@ public:
     void powerOff() override {
         ((CustomSX1262 *)_radio)->sleep(false);
     }
+
+    /**
+     * Take the radio out of mesh RX (for band survey slices)
+     */
+    void pauseRecv() {
+        idle();
+    }
+
+    /**
+     * Re-arm mesh RX after pauseRecv()
+     */
+    void resumeRecv() {
+        startRecv();
+    }
+};
+
+/**
+ * Band survey access to the SX1262
+ * Borrows the radio from MeshCore for one channel visit at a time.
+ */
+class SX1262SurveyRadio : public BandSurvey::SurveyRadio {
+public:
+    SX1262SurveyRadio(CustomSX1262& radio, MeshBerrySX1262Wrapper& wrapper, float homeMHz)
+        : _radio(radio), _wrapper(wrapper), _homeMHz(homeMHz) { }
+
+    bool canPause() override {
+        return _wrapper.isInRecvMode() && !_wrapper.isReceivingPacket();
+    }
+
+    bool tune(float mhz) override {
+        _wrapper.pauseRecv();
+        if (_radio.setFrequency(mhz) != RADIOLIB_ERR_NONE) return false;
+        return _radio.startReceive() == RADIOLIB_ERR_NONE;
+    }
+
+    float readRssi() override {
+        return _radio.getRSSI(false);
+    }
+
+    bool detectPreamble() override {
+        // scanChannel() leaves the radio in standby
+        return _radio.scanChannel() == RADIOLIB_LORA_DETECTED;
+    }
+
+    void restore() override {
+        _radio.standby();
+        _radio.setFrequency(_homeMHz);
+        _wrapper.resumeRecv();
+    }
+
+    float homeFrequency() const override {
+        return _homeMHz;
+    }
+
+private:
+    CustomSX1262& _radio;
+    MeshBerrySX1262Wrapper& _wrapper;
+    float _homeMHz;
 };
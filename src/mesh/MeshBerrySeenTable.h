@@ -0,0 +1,69 @@
+/**
+ * MeshBerry Seen Table
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * SimpleMeshTables with a read-only lookup. hasSeen() inserts unseen
+ * packets into MeshCore's ring, and undoing that with clear() leaves a
+ * zeroed slot where the oldest entry was evicted. The cut-through path
+ * only needs to ask, so the table mirrors the first 4 bytes of each
+ * packet hash it records, in the same slots, and peek() searches that.
+ */
+
+#pragma once
+
+#include <helpers/SimpleMeshTables.h>
+#include <string.h>
+
+class MeshBerrySeenTable : public SimpleMeshTables {
+public:
+    MeshBerrySeenTable() : _nextIdx(0) {
+        memset(_mirror, 0, sizeof(_mirror));
+    }
+
+    bool hasSeen(const mesh::Packet* packet) override {
+        bool seen = SimpleMeshTables::hasSeen(packet);
+        // ACKs are kept in a separate table and never peeked
+        if (!seen && packet->getPayloadType() != PAYLOAD_TYPE_ACK) {
+            _mirror[_nextIdx] = hash32(packet);
+            _nextIdx = (_nextIdx + 1) % MAX_PACKET_HASHES;
+        }
+        return seen;
+    }
+
+    void clear(const mesh::Packet* packet) override {
+        SimpleMeshTables::clear(packet);
+        if (packet->getPayloadType() == PAYLOAD_TYPE_ACK) return;
+        uint32_t h = hash32(packet);
+        for (int i = 0; i < MAX_PACKET_HASHES; i++) {
+            if (_mirror[i] == h) _mirror[i] = 0;
+        }
+    }
+
+    /**
+     * Whether a non-ACK packet is in the table, without recording it
+     */
+    bool peek(const mesh::Packet* packet) const {
+        uint32_t h = hash32(packet);
+        if (h == 0) return false;   // 0 marks a free slot
+        for (int i = 0; i < MAX_PACKET_HASHES; i++) {
+            if (_mirror[i] == h) return true;
+        }
+        return false;
+    }
+
+private:
+    static uint32_t hash32(const mesh::Packet* packet) {
+        uint8_t hash[MAX_HASH_SIZE];
+        packet->calculatePacketHash(hash);
+        uint32_t h;
+        memcpy(&h, hash, 4);
+        return h;
+    }
+
+    uint32_t _mirror[MAX_PACKET_HASHES];
+    int _nextIdx;
+};
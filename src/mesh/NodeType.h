@@ -0,0 +1,29 @@
+/**
+ * MeshBerry Node Types
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Node types carried in adverts. Kept apart from MeshBerryMesh.h so
+ * modules that only need the type don't pull in MeshCore.
+ */
+
+#ifndef MESHBERRY_NODE_TYPE_H
+#define MESHBERRY_NODE_TYPE_H
+
+#include <Arduino.h>
+
+/**
+ * Node types (from MeshCore AdvertDataHelpers.h)
+ */
+enum NodeType : uint8_t {
+    NODE_TYPE_UNKNOWN = 0,
+    NODE_TYPE_CHAT = 1,      // Regular chat client
+    NODE_TYPE_REPEATER = 2,  // Repeater/relay node
+    NODE_TYPE_ROOM = 3,      // Room server (bulletin board)
+    NODE_TYPE_SENSOR = 4     // Sensor node
+};
+
+#endif // MESHBERRY_NODE_TYPE_H
@@ -0,0 +1,112 @@
+/**
+ * MeshBerry Peer Table Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "PeerTable.h"
+#include <esp_heap_caps.h>
+#include <new>
+#include <string.h>
+
+static void* allocTable(size_t bytes) {
+    void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!p) {
+        p = malloc(bytes);
+    }
+    return p;
+}
+
+bool PeerTable::begin() {
+    if (_hot) return true;
+
+    size_t coldBytes = sizeof(PeerCold) * CAPACITY;
+    void* hotMem = allocTable(sizeof(HotCache));
+    void* orderMem = allocTable(sizeof(EvictOrder));
+    _cold = (PeerCold*)allocTable(coldBytes);
+    if (!hotMem || !orderMem || !_cold) {
+        free(hotMem);
+        free(orderMem);
+        free(_cold);
+        _cold = nullptr;
+        Serial.println("[PEERS] Failed to allocate peer table");
+        return false;
+    }
+    memset(_cold, 0, coldBytes);
+    _hot = new (hotMem) HotCache();
+    _evictOrder = new (orderMem) EvictOrder();
+
+    Serial.printf("[PEERS] Peer table: %d records (%u bytes hot, %u bytes cold)\n",
+                  CAPACITY, (unsigned)(sizeof(HotCache) + sizeof(EvictOrder)), (unsigned)coldBytes);
+    return true;
+}
+
+int PeerTable::evictionVictim() {
+    for (int victim = _evictOrder->oldest(); victim != NONE; victim = _evictOrder->oldest()) {
+        if (!_pinned) return victim;
+        _pinChecks++;
+        if (!_pinned(_hot->at(victim).id)) return victim;
+        // Parked until its next touch, so later evictions don't see it
+        _evictOrder->remove(victim);
+    }
+
+    // Everything is parked. Pins can be dropped without a touch (a contact
+    // deleted), so look once more, oldest first, before taking a pinned one.
+    for (int s = _hot->oldest(); s != NONE; s = _hot->newer(s)) {
+        _pinChecks++;
+        if (!_pinned(_hot->at(s).id)) return s;
+    }
+    return _hot->oldest();
+}
+
+int PeerTable::acquire(uint32_t id, bool* created) {
+    bool isNew = false;
+    if (_hot->find(id) == NONE && _hot->full()) {
+        // Make room ourselves, passing over pinned records
+        int victim = evictionVictim();
+        _hot->erase(victim);
+        _evictOrder->remove(victim);
+        _evictions++;
+    }
+    int slot = _hot->acquire(id, &isNew);
+    _evictOrder->touch(slot);
+
+    if (isNew) {
+        PeerHot& h = _hot->at(slot);
+        memset(&h, 0, sizeof(h));
+        h.id = id;
+        h.outPathLen = -1;
+        memset(&_cold[slot], 0, sizeof(PeerCold));
+    }
+    if (created) *created = isNew;
+    return slot;
+}
+
+void PeerTable::setKey(int slot, const uint8_t* pubKey) {
+    PeerHot& h = _hot->at(slot);
+    PeerCold& c = _cold[slot];
+    if ((h.flags & PEER_HAS_KEY) && memcmp(c.pubKey, pubKey, sizeof(c.pubKey)) == 0) {
+        return;
+    }
+    memcpy(c.pubKey, pubKey, sizeof(c.pubKey));
+    h.hashByte = pubKey[0];
+    h.flags = (h.flags | PEER_HAS_KEY) & ~PEER_HAS_SECRET;
+}
+
+void PeerTable::setPath(int slot, const uint8_t* path, uint8_t pathLen) {
+    if (pathLen > PEER_PATH_MAX) return;
+    PeerHot& h = _hot->at(slot);
+    if (pathLen > 0) memcpy(_cold[slot].outPath, path, pathLen);
+    h.outPathLen = (int8_t)pathLen;
+    h.pathLearnedAt = millis();
+    if (h.pathLearnedAt == 0) h.pathLearnedAt = 1;  // 0 means never learned
+}
+
+void PeerTable::clearPath(int slot) {
+    PeerHot& h = _hot->at(slot);
+    h.outPathLen = -1;
+    h.pathLearnedAt = 0;
+}
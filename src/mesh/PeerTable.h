@@ -0,0 +1,178 @@
+/**
+ * MeshBerry Peer Table
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * One record per known node, keyed by node ID: identity, cached ECDH
+ * secret, learned route, link stats and advert details. Replaces the
+ * separate DM peer list, node list and the route fields that used to be
+ * copied into every ContactEntry.
+ *
+ * Records are split in two parallel arrays sharing a slot index:
+ *   - PeerHot: fields read on every packet, lookup and send (24 bytes,
+ *     packed together so a hash-match scan touches few cache lines)
+ *   - PeerCold: names, keys, secrets and path bytes
+ * Both live in PSRAM, so the table can hold every node heard in a busy
+ * area; it is the "discovered" tier under the persisted contact list.
+ *
+ * Slots are stable for the life of a record, so a slot can be handed to
+ * MeshCore as a peer index. When full, the least recently used record is
+ * evicted; it is rebuilt from contacts or the next advert when needed.
+ * Pinned records (contacts) are skipped, so a busy area's adverts can't
+ * push out a contact's learned route and cached secret.
+ *
+ * Eviction walks its own recency list rather than the cache's. A record
+ * found pinned there is parked: taken off the list until it is next
+ * touched, so each eviction passes over only the pinned records touched
+ * since they were last checked, not every contact.
+ */
+
+#ifndef MESHBERRY_PEER_TABLE_H
+#define MESHBERRY_PEER_TABLE_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "../util/LruCache.h"
+#include "../util/LruList.h"
+
+// Record flags
+constexpr uint8_t PEER_HAS_KEY      = 0x01;     // cold.pubKey is valid
+constexpr uint8_t PEER_HAS_SECRET   = 0x02;     // cold.sharedSecret is computed
+constexpr uint8_t PEER_HAS_LOCATION = 0x04;     // cold.latitude/longitude valid
+constexpr uint8_t PEER_HEARD        = 0x08;     // Heard directly (advert/discover)
+
+constexpr int PEER_PATH_MAX = 64;               // Max learned path length (hops)
+
+/**
+ * Hot record fields
+ */
+struct PeerHot {
+    uint32_t id;                // Node ID (first 4 bytes of public key)
+    uint32_t lastHeard;         // RTC epoch seconds
+    uint32_t pathLearnedAt;     // millis() when the route was set, 0 = never
+    float snr;                  // Last SNR
+    int16_t rssi;               // Last RSSI
+    int8_t outPathLen;          // -1 = unknown, 0 = direct neighbour, N = hops
+    uint8_t hashByte;           // pubKey[0] (path hash), with PEER_HAS_KEY
+    uint8_t type;               // NodeType
+    uint8_t flags;              // PEER_*
+};
+
+/**
+ * Cold record fields
+ */
+struct PeerCold {
+    char name[32];
+    uint8_t pubKey[32];
+    uint8_t sharedSecret[32];
+    uint8_t outPath[PEER_PATH_MAX];
+    float latitude;
+    float longitude;
+};
+
+class PeerTable {
+public:
+    static constexpr int CAPACITY = MAX_NODES;
+    using HotCache = LruCache<uint32_t, PeerHot, CAPACITY>;
+    using EvictOrder = LruList<CAPACITY>;
+    static constexpr int NONE = -1;
+    using PinnedFn = bool (*)(uint32_t id);
+
+    /**
+     * Allocate the records (PSRAM, falling back to internal RAM)
+     * @return false if allocation failed
+     */
+    bool begin();
+
+    /**
+     * Set the check for records eviction should skip (nullptr = none)
+     */
+    void setPinned(PinnedFn pinned) { _pinned = pinned; }
+
+    /**
+     * Slot holding a node ID, or NONE (does not change recency)
+     */
+    int find(uint32_t id) const { return _hot ? _hot->find(id) : NONE; }
+
+    /**
+     * Find or add a record and mark it most recently used
+     * A new record starts blank with an unknown route. When full, the
+     * least recently used unpinned record is evicted and its slot reused.
+     * If every record is pinned, the least recently used one goes.
+     * Amortised O(1): a pinned record is checked once per touch.
+     * @param created Set to true for a new record (may be nullptr)
+     * @return Slot index
+     */
+    int acquire(uint32_t id, bool* created = nullptr);
+
+    /**
+     * Mark a record most recently used (unparks it)
+     */
+    void touch(int slot) {
+        if (!used(slot)) return;
+        _hot->touch(slot);
+        _evictOrder->touch(slot);
+    }
+
+    /**
+     * Drop a record
+     */
+    void erase(int slot) {
+        if (!used(slot)) return;
+        _hot->erase(slot);
+        _evictOrder->remove(slot);
+    }
+
+    bool used(int slot) const { return _hot && _hot->used(slot); }
+
+    PeerHot& hot(int slot) { return _hot->at(slot); }
+    const PeerHot& hot(int slot) const { return _hot->at(slot); }
+    PeerCold& cold(int slot) { return _cold[slot]; }
+    const PeerCold& cold(int slot) const { return _cold[slot]; }
+
+    /**
+     * Set the public key; drops the cached secret if the key changed
+     */
+    void setKey(int slot, const uint8_t* pubKey);
+
+    /**
+     * Store a learned route (pathLen 0 = direct neighbour)
+     */
+    void setPath(int slot, const uint8_t* path, uint8_t pathLen);
+
+    /**
+     * Forget the learned route
+     */
+    void clearPath(int slot);
+
+    // Recency walk: for (int s = newest(); s != NONE; s = older(s))
+    int newest() const { return _hot ? _hot->newest() : NONE; }
+    int older(int slot) const { return _hot->older(slot); }
+
+    size_t size() const { return _hot ? _hot->size() : 0; }
+
+    /**
+     * Evicted records since boot (table pressure)
+     */
+    uint32_t evictions() const { return _evictions; }
+
+    /**
+     * Pinned-check calls made while evicting since boot
+     */
+    uint32_t pinChecks() const { return _pinChecks; }
+
+private:
+    int evictionVictim();
+
+    HotCache* _hot = nullptr;
+    EvictOrder* _evictOrder = nullptr;  // Unparked records, newest first
+    PeerCold* _cold = nullptr;
+    PinnedFn _pinned = nullptr;
+    uint32_t _evictions = 0;
+    uint32_t _pinChecks = 0;
+};
+
+#endif // MESHBERRY_PEER_TABLE_H
@@ -0,0 +1,312 @@
+/**
+ * MeshBerry Position Beacons Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "PositionBeacon.h"
+#include <math.h>
+#include <string.h>
+
+namespace PositionBeacon {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static constexpr double METERS_PER_DEG = 111320.0;
+static constexpr double DEG_TO_RAD_D = 0.017453292519943295;
+
+// Sender: the last report exactly as receivers decoded it
+static Fix s_last;
+static uint32_t s_lastAt = 0;
+static uint32_t s_lastCheckAt = 0;
+static bool s_hasLast = false;
+static double s_keyLat = 0;
+static double s_keyLon = 0;
+static bool s_hasKey = false;
+static uint8_t s_seq = 0;
+static uint8_t s_sinceKey = 0;
+static SenderStats s_stats;
+
+// Receiver
+static Track s_tracks[POS_MAX_TRACKS];
+static int s_trackCount = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static inline void put16(uint8_t* p, int16_t v) { memcpy(p, &v, 2); }
+static inline void put32(uint8_t* p, int32_t v) { memcpy(p, &v, 4); }
+static inline int16_t get16(const uint8_t* p) { int16_t v; memcpy(&v, p, 2); return v; }
+static inline int32_t get32(const uint8_t* p) { int32_t v; memcpy(&v, p, 4); return v; }
+
+static uint8_t encodeSpeed(float mps) {
+    long q = lroundf(mps / POS_SPEED_UNIT_MPS);
+    if (q < 0) q = 0;
+    if (q > 255) q = 255;
+    return (uint8_t)q;
+}
+
+static uint8_t encodeCourse(float deg) {
+    float c = fmodf(deg, 360.0f);
+    if (c < 0) c += 360.0f;
+    return (uint8_t)(lroundf(c / POS_COURSE_UNIT_DEG) & 0xFF);
+}
+
+// =============================================================================
+// GEOMETRY
+// =============================================================================
+
+Fix extrapolate(const Fix& fix, float seconds) {
+    Fix out = fix;
+    if (fix.speedMps <= 0.0f || seconds <= 0.0f) return out;
+
+    double dist = (double)fix.speedMps * seconds;
+    double course = fix.courseDeg * DEG_TO_RAD_D;
+    double cosLat = cos(fix.lat * DEG_TO_RAD_D);
+    if (cosLat < 0.01) cosLat = 0.01;
+
+    out.lat = fix.lat + dist * cos(course) / METERS_PER_DEG;
+    out.lon = fix.lon + dist * sin(course) / (METERS_PER_DEG * cosLat);
+    if (out.lon > 180.0) out.lon -= 360.0;
+    else if (out.lon < -180.0) out.lon += 360.0;
+    return out;
+}
+
+float distanceM(double lat1, double lon1, double lat2, double lon2) {
+    double dLon = lon2 - lon1;
+    if (dLon > 180.0) dLon -= 360.0;
+    else if (dLon < -180.0) dLon += 360.0;
+
+    double x = dLon * cos((lat1 + lat2) * 0.5 * DEG_TO_RAD_D) * METERS_PER_DEG;
+    double y = (lat2 - lat1) * METERS_PER_DEG;
+    return (float)sqrt(x * x + y * y);
+}
+
+// =============================================================================
+// SENDER
+// =============================================================================
+
+void resetSender() {
+    s_hasLast = false;
+    s_hasKey = false;
+    s_sinceKey = 0;
+    s_lastCheckAt = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+size_t update(const Fix& fixIn, uint32_t nowMs, uint32_t epoch, uint32_t selfId,
+              uint16_t thresholdM, uint8_t* out) {
+    if (s_hasLast && nowMs - s_lastCheckAt < POS_CHECK_INTERVAL_MS) return 0;
+    s_lastCheckAt = nowMs;
+
+    Fix fix = fixIn;
+    if (fix.speedMps < POS_STATIONARY_MPS) fix.speedMps = 0.0f;
+    s_stats.checks++;
+
+    bool heartbeat = false;
+    if (s_hasLast) {
+        uint32_t age = nowMs - s_lastAt;
+        uint32_t dt = age < POS_EXTRAPOLATE_MAX_MS ? age : POS_EXTRAPOLATE_MAX_MS;
+        Fix predicted = extrapolate(s_last, dt / 1000.0f);
+        float err = distanceM(predicted.lat, predicted.lon, fix.lat, fix.lon);
+        s_stats.lastErrorM = err;
+
+        heartbeat = age >= POS_HEARTBEAT_MS;
+        if (err <= thresholdM && !heartbeat) {
+            if (err > s_stats.maxErrorM) s_stats.maxErrorM = err;
+            return 0;
+        }
+        // Over threshold, but keep the airtime floor
+        if (age < POS_MIN_INTERVAL_MS) return 0;
+    }
+
+    // Delta against the last keyframe if it fits, else a new keyframe
+    int32_t dLat = 0, dLon = 0;
+    bool full = !s_hasKey || heartbeat || s_sinceKey >= POS_KEYFRAME_EVERY - 1;
+    if (!full) {
+        double dl = fix.lon - s_keyLon;
+        if (dl > 180.0) dl -= 360.0;
+        else if (dl < -180.0) dl += 360.0;
+        dLat = (int32_t)lround((fix.lat - s_keyLat) * POS_DELTA_SCALE);
+        dLon = (int32_t)lround(dl * POS_DELTA_SCALE);
+        full = dLat < INT16_MIN || dLat > INT16_MAX || dLon < INT16_MIN || dLon > INT16_MAX;
+    }
+
+    uint8_t seq = ++s_seq & POS_SEQ_MASK;
+    memcpy(out, &epoch, 4);
+    out[4] = POS_TAG;
+    out[5] = ((full ? POS_KIND_FULL : POS_KIND_DELTA) << 6) | seq;
+    memcpy(&out[6], &selfId, 4);
+
+    uint8_t* body = &out[POS_HEADER_LEN];
+    uint8_t speed = encodeSpeed(fix.speedMps);
+    uint8_t course = encodeCourse(fix.courseDeg);
+    size_t len;
+
+    // Track exactly what receivers will decode, so both sides extrapolate alike
+    Fix sent;
+    sent.speedMps = speed * POS_SPEED_UNIT_MPS;
+    sent.courseDeg = course * POS_COURSE_UNIT_DEG;
+    sent.altM = fix.altM;
+
+    if (full) {
+        int32_t qLat = (int32_t)lround(fix.lat * POS_FULL_SCALE);
+        int32_t qLon = (int32_t)lround(fix.lon * POS_FULL_SCALE);
+        put32(&body[0], qLat);
+        put32(&body[4], qLon);
+        body[8] = speed;
+        body[9] = course;
+        put16(&body[10], fix.altM);
+        len = POS_HEADER_LEN + POS_FULL_BODY_LEN;
+
+        sent.lat = qLat / POS_FULL_SCALE;
+        sent.lon = qLon / POS_FULL_SCALE;
+        s_keyLat = sent.lat;
+        s_keyLon = sent.lon;
+        s_hasKey = true;
+        s_sinceKey = 0;
+        s_stats.keyframes++;
+    } else {
+        put16(&body[0], (int16_t)dLat);
+        put16(&body[2], (int16_t)dLon);
+        body[4] = speed;
+        body[5] = course;
+        len = POS_HEADER_LEN + POS_DELTA_BODY_LEN;
+
+        sent.lat = s_keyLat + dLat / POS_DELTA_SCALE;
+        sent.lon = s_keyLon + dLon / POS_DELTA_SCALE;
+        s_sinceKey++;
+    }
+
+    s_last = sent;
+    s_lastAt = nowMs;
+    s_hasLast = true;
+    s_stats.reports++;
+    s_stats.bytes += len;
+    s_stats.maxErrorM = 0;
+    return len;
+}
+
+const SenderStats& getSenderStats() {
+    return s_stats;
+}
+
+// =============================================================================
+// RECEIVER
+// =============================================================================
+
+Fix Track::positionAt(uint32_t nowMs) const {
+    uint32_t age = nowMs - heardAt;
+    if (age > POS_EXTRAPOLATE_MAX_MS) age = POS_EXTRAPOLATE_MAX_MS;
+    return extrapolate(report, age / 1000.0f);
+}
+
+static Track* findOrAddTrack(uint32_t id) {
+    for (int i = 0; i < s_trackCount; i++) {
+        if (s_tracks[i].id == id) return &s_tracks[i];
+    }
+
+    Track* t;
+    if (s_trackCount < POS_MAX_TRACKS) {
+        t = &s_tracks[s_trackCount++];
+    } else {
+        // Replace the longest-silent teammate
+        t = &s_tracks[0];
+        for (int i = 1; i < s_trackCount; i++) {
+            if (s_tracks[i].heardAt < t->heardAt) t = &s_tracks[i];
+        }
+    }
+    memset(t, 0, sizeof(*t));
+    t->id = id;
+    return t;
+}
+
+const Track* onReport(const uint8_t* data, size_t len, uint32_t nowMs, uint8_t hops) {
+    if (len < POS_HEADER_LEN || data[4] != POS_TAG) return nullptr;
+
+    uint32_t epoch, id;
+    memcpy(&epoch, data, 4);
+    memcpy(&id, &data[6], 4);
+    uint8_t kind = data[5] >> 6;
+    uint8_t seq = data[5] & POS_SEQ_MASK;
+    const uint8_t* body = &data[POS_HEADER_LEN];
+    size_t bodyLen = len - POS_HEADER_LEN;
+
+    if (kind == POS_KIND_FULL && bodyLen >= POS_FULL_BODY_LEN) {
+        Track* t = findOrAddTrack(id);
+        t->report.lat = get32(&body[0]) / POS_FULL_SCALE;
+        t->report.lon = get32(&body[4]) / POS_FULL_SCALE;
+        t->report.speedMps = body[8] * POS_SPEED_UNIT_MPS;
+        t->report.courseDeg = body[9] * POS_COURSE_UNIT_DEG;
+        t->report.altM = get16(&body[10]);
+        t->keyLat = t->report.lat;
+        t->keyLon = t->report.lon;
+        t->keyTime = epoch;
+        t->keySeq = seq;
+        t->hasKey = true;
+        t->heardAt = nowMs;
+        t->reportTime = epoch;
+        t->hops = hops;
+        t->reports++;
+        return t;
+    }
+
+    if (kind == POS_KIND_DELTA && bodyLen >= POS_DELTA_BODY_LEN) {
+        Track* t = nullptr;
+        for (int i = 0; i < s_trackCount; i++) {
+            if (s_tracks[i].id == id) t = &s_tracks[i];
+        }
+        // A delta belongs to the keyframe at most POS_KEYFRAME_EVERY - 1 reports
+        // earlier. If that keyframe was missed, wait for the next one.
+        if (!t || !t->hasKey) return nullptr;
+        uint8_t sinceKey = (seq - t->keySeq) & POS_SEQ_MASK;
+        if (sinceKey == 0 || sinceKey >= POS_KEYFRAME_EVERY) return nullptr;
+        if (epoch - t->keyTime > POS_KEYFRAME_EVERY * (POS_HEARTBEAT_MS / 1000)) return nullptr;
+
+        t->report.lat = t->keyLat + get16(&body[0]) / POS_DELTA_SCALE;
+        t->report.lon = t->keyLon + get16(&body[2]) / POS_DELTA_SCALE;
+        if (t->report.lon > 180.0) t->report.lon -= 360.0;
+        else if (t->report.lon < -180.0) t->report.lon += 360.0;
+        t->report.speedMps = body[4] * POS_SPEED_UNIT_MPS;
+        t->report.courseDeg = body[5] * POS_COURSE_UNIT_DEG;
+        t->heardAt = nowMs;
+        t->reportTime = epoch;
+        t->hops = hops;
+        t->reports++;
+        return t;
+    }
+
+    return nullptr;
+}
+
+void expireTracks(uint32_t nowMs) {
+    int w = 0;
+    for (int i = 0; i < s_trackCount; i++) {
+        if (nowMs - s_tracks[i].heardAt < POS_TRACK_EXPIRY_MS) {
+            if (w != i) s_tracks[w] = s_tracks[i];
+            w++;
+        }
+    }
+    s_trackCount = w;
+}
+
+int getTrackCount() {
+    return s_trackCount;
+}
+
+const Track* getTrack(int index) {
+    if (index < 0 || index >= s_trackCount) return nullptr;
+    return &s_tracks[index];
+}
+
+void clearTracks() {
+    s_trackCount = 0;
+}
+
+} // namespace PositionBeacon
@@ -0,0 +1,177 @@
+/**
+ * MeshBerry Position Beacons
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Compact position reports for tracking moving teammates on a channel.
+ *
+ * The sender dead-reckons its own last report forward (speed and course
+ * from the GPS) and only transmits when the real position has drifted
+ * more than a threshold from that prediction, so a node walking a
+ * straight line at constant speed is silent. Receivers run the same
+ * extrapolation between reports.
+ *
+ * Reports are keyframes (absolute fixed-point lat/lon) or deltas against
+ * the last keyframe. This module holds the encoding, the send decision and
+ * the receive-side track table. Packet transport lives in MeshBerryMesh.
+ */
+
+#ifndef MESHBERRY_POSITION_BEACON_H
+#define MESHBERRY_POSITION_BEACON_H
+
+#include <Arduino.h>
+
+namespace PositionBeacon {
+
+// =============================================================================
+// PROTOCOL CONSTANTS
+// =============================================================================
+
+// Reports are carried in PAYLOAD_TYPE_GRP_DATA packets on the channel:
+// [4-byte timestamp][1-byte POS_TAG][2-bit kind | 6-bit seq][4-byte sender id][body]
+//
+// Channel payloads are AES-padded to 16-byte blocks, so a delta is sized to
+// fill exactly one block and a keyframe two.
+constexpr uint8_t POS_TAG             = 0xB8;
+constexpr uint8_t POS_KIND_FULL       = 0x01;   // body: lat(4) lon(4) speed(1) course(1) alt(2)
+constexpr uint8_t POS_KIND_DELTA      = 0x02;   // body: dlat(2) dlon(2) speed(1) course(1)
+constexpr uint8_t POS_SEQ_MASK        = 0x3F;
+constexpr size_t  POS_HEADER_LEN      = 10;
+constexpr size_t  POS_FULL_BODY_LEN   = 12;
+constexpr size_t  POS_DELTA_BODY_LEN  = 6;
+constexpr size_t  POS_MAX_PAYLOAD     = POS_HEADER_LEN + POS_FULL_BODY_LEN;
+
+// Fixed-point scales
+constexpr double  POS_FULL_SCALE      = 1e6;    // Keyframe: 1e-6 deg (~0.1 m)
+constexpr double  POS_DELTA_SCALE     = 1e5;    // Delta: 1e-5 deg (~1.1 m), +/-0.32 deg range
+constexpr float   POS_SPEED_UNIT_MPS  = 0.5f;   // Speed byte: 0-127 m/s
+constexpr float   POS_COURSE_UNIT_DEG = 360.0f / 256.0f;
+
+// Send policy
+constexpr uint16_t POS_THRESHOLD_DEFAULT_M = 25;    // Max dead-reckoning error before a report
+constexpr uint16_t POS_THRESHOLD_MIN_M     = 15;    // Below this GPS noise alone triggers reports
+constexpr uint16_t POS_THRESHOLD_MAX_M     = 1000;
+constexpr uint32_t POS_CHECK_INTERVAL_MS   = 1000;  // Prediction check rate
+constexpr uint32_t POS_MIN_INTERVAL_MS     = 10 * 1000;        // Airtime floor between reports
+constexpr uint32_t POS_HEARTBEAT_MS        = 15 * 60 * 1000UL; // Report even when on track
+constexpr uint8_t  POS_KEYFRAME_EVERY      = 8;     // Reports per keyframe (deltas find theirs by seq)
+constexpr float    POS_STATIONARY_MPS      = 0.5f;  // Slower is GPS jitter, sent as 0
+constexpr float    POS_MAX_HDOP            = 5.0f;  // Poorer fixes are not reported
+
+// Receive side
+constexpr int      POS_MAX_TRACKS          = 16;
+constexpr uint32_t POS_EXTRAPOLATE_MAX_MS  = 2 * 60 * 1000UL;  // Hold position after this
+constexpr uint32_t POS_TRACK_EXPIRY_MS     = 60 * 60 * 1000UL;
+
+/**
+ * Position with velocity
+ */
+struct Fix {
+    double lat;
+    double lon;
+    float speedMps;
+    float courseDeg;        // True course, 0 = north
+    int16_t altM;
+};
+
+/**
+ * A teammate heard on the beacon channel
+ */
+struct Track {
+    uint32_t id;            // Sender node id (matches NodeInfo::id)
+    Fix report;             // Last reported position and velocity
+    uint32_t heardAt;       // millis() of the last report
+    uint32_t reportTime;    // Sender's epoch seconds
+    double keyLat;          // Last keyframe, base for deltas
+    double keyLon;
+    uint32_t keyTime;       // Keyframe epoch seconds
+    uint8_t keySeq;
+    bool hasKey;
+    uint8_t hops;
+    uint16_t reports;
+
+    /**
+     * Extrapolated position at nowMs
+     */
+    Fix positionAt(uint32_t nowMs) const;
+};
+
+/**
+ * Sender counters
+ */
+struct SenderStats {
+    uint32_t checks;        // Prediction checks with a usable fix
+    uint32_t reports;
+    uint32_t keyframes;
+    uint32_t bytes;         // Payload bytes sent
+    float lastErrorM;       // Prediction error at the last check
+    float maxErrorM;        // Worst error while suppressed
+};
+
+// =============================================================================
+// GEOMETRY
+// =============================================================================
+
+/**
+ * Move a fix along its course for a number of seconds
+ */
+Fix extrapolate(const Fix& fix, float seconds);
+
+/**
+ * Distance between two points (m), equirectangular approximation
+ */
+float distanceM(double lat1, double lon1, double lat2, double lon2);
+
+// =============================================================================
+// SENDER
+// =============================================================================
+
+/**
+ * Forget the last report so the next update sends a keyframe
+ */
+void resetSender();
+
+/**
+ * Check the current fix against the extrapolated last report
+ * @param fix Current GPS fix
+ * @param nowMs millis()
+ * @param epoch Current epoch seconds (report timestamp)
+ * @param selfId Our node id
+ * @param thresholdM Dead-reckoning error that triggers a report
+ * @param out Payload buffer (POS_MAX_PAYLOAD bytes)
+ * @return Payload length to send, 0 if suppressed
+ */
+size_t update(const Fix& fix, uint32_t nowMs, uint32_t epoch, uint32_t selfId,
+              uint16_t thresholdM, uint8_t* out);
+
+const SenderStats& getSenderStats();
+
+// =============================================================================
+// RECEIVER
+// =============================================================================
+
+/**
+ * Apply a received report to the track table
+ * @param data Group datagram payload (starts with the timestamp)
+ * @param len Payload length
+ * @param nowMs millis()
+ * @param hops Flood hops the report travelled
+ * @return Updated track, nullptr if malformed or a delta with no keyframe
+ */
+const Track* onReport(const uint8_t* data, size_t len, uint32_t nowMs, uint8_t hops);
+
+/**
+ * Drop tracks not heard for POS_TRACK_EXPIRY_MS
+ */
+void expireTracks(uint32_t nowMs);
+
+int getTrackCount();
+const Track* getTrack(int index);
+void clearTracks();
+
+} // namespace PositionBeacon
+
+#endif // MESHBERRY_POSITION_BEACON_H
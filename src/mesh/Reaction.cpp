@@ -0,0 +1,341 @@
+/**
+ * MeshBerry Emoji Reactions Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "Reaction.h"
+#include "../drivers/storage.h"
+#include "../ui/Emoji.h"
+#include "../util/LruCache.h"
+#include <esp_heap_caps.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace Reaction {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static constexpr uint32_t FNV_OFFSET = 0x811c9dc5;
+static constexpr uint32_t FNV_PRIME = 0x01000193;
+static constexpr uint32_t VARIATION_SELECTOR = 0xFE0F;   // Emoji presentation
+
+static const char* REACT_FILE = "/reactions.bin";
+static constexpr uint32_t REACT_MAGIC = 0x54434152;        // "RACT"
+static constexpr uint8_t  REACT_FILE_VERSION = 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint16_t reserved;
+};
+
+static constexpr size_t REACT_FILE_MAX = sizeof(FileHeader) + sizeof(Badge) * REACT_MAX_BADGES;
+
+// Keyed by a mix of scope and ref; the badge holds both to confirm a hit
+static LruCache<uint32_t, Badge, REACT_MAX_BADGES> s_badges;
+static bool s_dirty = false;
+static uint32_t s_lastSave = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static inline uint32_t fnvByte(uint32_t hash, uint8_t b) {
+    return (hash ^ b) * FNV_PRIME;
+}
+
+static inline uint32_t badgeKey(uint32_t scope, uint32_t ref) {
+    return (scope * FNV_PRIME) ^ ref;
+}
+
+static uint8_t* allocFileBuffer() {
+    void* p = heap_caps_malloc(REACT_FILE_MAX, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!p) {
+        p = malloc(REACT_FILE_MAX);
+    }
+    return (uint8_t*)p;
+}
+
+static bool load() {
+    if (!Storage::fileExists(REACT_FILE)) return false;
+
+    uint8_t* buf = allocFileBuffer();
+    if (!buf) return false;
+
+    size_t bytesRead = 0;
+    bool ok = Storage::readFile(REACT_FILE, buf, REACT_FILE_MAX, &bytesRead);
+
+    FileHeader header;
+    if (ok && bytesRead >= sizeof(header)) {
+        memcpy(&header, buf, sizeof(header));
+        ok = header.magic == REACT_MAGIC &&
+             header.version == REACT_FILE_VERSION &&
+             header.count <= REACT_MAX_BADGES &&
+             bytesRead >= sizeof(header) + header.count * sizeof(Badge);
+    } else {
+        ok = false;
+    }
+
+    if (ok) {
+        // Saved most recent first; load oldest first to keep that order
+        for (int i = header.count - 1; i >= 0; i--) {
+            Badge b;
+            memcpy(&b, buf + sizeof(header) + i * sizeof(Badge), sizeof(b));
+            s_badges.at(s_badges.acquire(badgeKey(b.scope, b.ref))) = b;
+        }
+        Serial.printf("[REACT] Loaded %d badges\n", header.count);
+    } else {
+        Serial.println("[REACT] Ignoring invalid reactions file");
+    }
+    free(buf);
+    return ok;
+}
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// One table emoji (and an optional variation selector) at the start of
+// text; returns the bytes it spans, 0 if there is none
+static size_t leadingEmoji(const char* text, int* index) {
+    uint32_t cp;
+    int n = Emoji::decodeUTF8(text, &cp);
+    if (n <= 1) return 0;   // Invalid or ASCII
+    int idx = Emoji::indexOf(Emoji::findByCodepoint(cp));
+    if (idx < 0) return 0;
+
+    size_t len = n;
+    n = Emoji::decodeUTF8(text + len, &cp);
+    if (n > 0 && cp == VARIATION_SELECTOR) len += n;
+    *index = idx;
+    return len;
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+void init() {
+    s_badges.clear();
+    load();
+    s_dirty = false;
+    s_lastSave = millis();
+}
+
+void maintain() {
+    uint32_t ms = millis();
+    if (s_dirty && ms - s_lastSave >= REACT_SAVE_MS) {
+        s_lastSave = ms;
+        save();
+    }
+}
+
+bool save() {
+    uint8_t* buf = allocFileBuffer();
+    if (!buf) return false;
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = REACT_MAGIC;
+    header.version = REACT_FILE_VERSION;
+
+    uint8_t* p = buf + sizeof(header);
+    for (int slot = s_badges.newest(); slot != s_badges.NONE; slot = s_badges.older(slot)) {
+        if (s_badges.at(slot).kinds == 0) continue;
+        memcpy(p, &s_badges.at(slot), sizeof(Badge));
+        p += sizeof(Badge);
+        header.count++;
+    }
+    memcpy(buf, &header, sizeof(header));
+
+    bool ok = Storage::writeFile(REACT_FILE, buf, p - buf);
+    free(buf);
+    if (ok) {
+        s_dirty = false;
+    } else {
+        Serial.println("[REACT] Failed to save reactions");
+    }
+    return ok;
+}
+
+// =============================================================================
+// REFERENCES
+// =============================================================================
+
+uint32_t refHash(const char* sender, const char* text) {
+    uint32_t hash = FNV_OFFSET;
+    if (sender) {
+        for (size_t i = 0; i < REACT_SENDER_MAX && sender[i]; i++) {
+            hash = fnvByte(hash, (uint8_t)sender[i]);
+        }
+    }
+    hash = fnvByte(hash, 0);
+    if (text) {
+        while (*text) hash = fnvByte(hash, (uint8_t)*text++);
+    }
+    return hash & REACT_REF_MASK;
+}
+
+// =============================================================================
+// ENCODING
+// =============================================================================
+
+int loneEmoji(const char* text) {
+    if (!text) return -1;
+    int idx;
+    size_t len = leadingEmoji(text, &idx);
+    return (len > 0 && text[len] == '\0') ? idx : -1;
+}
+
+size_t formatText(uint32_t ref, uint16_t emoji, char* out) {
+    const EmojiEntry* e = Emoji::getByIndex(emoji);
+    if (!e) return 0;
+    int n = Emoji::encodeUTF8(e->codepoint, out);
+    n += snprintf(out + n, REACT_TEXT_MAX - n, "%s%06lx",
+                  REACT_TEXT_MARK, (unsigned long)(ref & REACT_REF_MASK));
+    return n;
+}
+
+bool parseText(const char* text, uint32_t* ref, uint16_t* emoji) {
+    if (!text) return false;
+
+    // Cheap reject for ordinary messages: must start with a multi-byte char
+    if ((uint8_t)text[0] < 0xC0) return false;
+
+    int idx;
+    size_t len = leadingEmoji(text, &idx);
+    if (len == 0) return false;
+
+    const char* p = text + len;
+    size_t markLen = strlen(REACT_TEXT_MARK);
+    if (strncmp(p, REACT_TEXT_MARK, markLen) != 0) return false;
+    p += markLen;
+
+    uint32_t r = 0;
+    for (int i = 0; i < 6; i++) {
+        int d = hexDigit(p[i]);
+        if (d < 0) return false;
+        r = (r << 4) | d;
+    }
+    if (p[6] != '\0') return false;
+
+    *ref = r;
+    *emoji = (uint16_t)idx;
+    return true;
+}
+
+size_t encodePacket(uint32_t epoch, uint32_t ref, uint16_t emoji, uint32_t senderId, uint8_t* out) {
+    if (!Emoji::getByIndex(emoji)) return 0;
+    memcpy(out, &epoch, 4);
+    out[4] = REACT_TAG;
+    out[5] = ref & 0xFF;
+    out[6] = (ref >> 8) & 0xFF;
+    out[7] = (ref >> 16) & 0xFF;
+    memcpy(&out[8], &emoji, 2);
+    memcpy(&out[10], &senderId, 4);
+    return REACT_PAYLOAD_LEN;
+}
+
+bool decodePacket(const uint8_t* data, size_t len, uint32_t* ref, uint16_t* emoji, uint32_t* senderId) {
+    if (len < REACT_PAYLOAD_LEN || data[4] != REACT_TAG) return false;
+    uint16_t e;
+    memcpy(&e, &data[8], 2);
+    if (!Emoji::getByIndex(e)) return false;   // Unknown to our table
+
+    *ref = data[5] | ((uint32_t)data[6] << 8) | ((uint32_t)data[7] << 16);
+    *emoji = e;
+    memcpy(senderId, &data[10], 4);
+    return true;
+}
+
+// =============================================================================
+// BADGES
+// =============================================================================
+
+bool apply(uint32_t scope, uint32_t ref, uint16_t emoji, uint32_t reactor) {
+    ref &= REACT_REF_MASK;
+    bool created;
+    int slot = s_badges.acquire(badgeKey(scope, ref), &created);
+    Badge& b = s_badges.at(slot);
+    if (created || b.scope != scope || b.ref != ref) {
+        memset(&b, 0, sizeof(b));
+        b.scope = scope;
+        b.ref = ref;
+    }
+
+    // The same reaction heard again (a resend, or text and compact both)
+    for (int i = 0; i < b.reactors; i++) {
+        if (b.reactor[i] == reactor && b.reactorEmoji[i] == emoji) return false;
+    }
+    s_dirty = true;
+    if (b.reactors < REACT_MAX_REACTORS) {
+        b.reactor[b.reactors] = reactor;
+        b.reactorEmoji[b.reactors] = emoji;
+        b.reactors++;
+    }
+
+    for (int i = 0; i < b.kinds; i++) {
+        if (b.emoji[i] == emoji) {
+            if (b.count[i] < 255) b.count[i]++;
+            return true;
+        }
+    }
+    if (b.kinds < REACT_MAX_KINDS) {
+        b.emoji[b.kinds] = emoji;
+        b.count[b.kinds] = 1;
+        b.kinds++;
+        return true;
+    }
+
+    // Full: a new emoji replaces the least used one it now ties or beats
+    int least = 0;
+    for (int i = 1; i < b.kinds; i++) {
+        if (b.count[i] < b.count[least]) least = i;
+    }
+    if (b.count[least] > 1) return false;
+    b.emoji[least] = emoji;
+    b.count[least] = 1;
+    return true;
+}
+
+const Badge* find(uint32_t scope, uint32_t ref) {
+    ref &= REACT_REF_MASK;
+    int slot = s_badges.find(badgeKey(scope, ref));
+    if (slot == s_badges.NONE) return nullptr;
+    const Badge& b = s_badges.at(slot);
+    if (b.scope != scope || b.ref != ref || b.kinds == 0) return nullptr;
+    return &b;
+}
+
+size_t formatBadge(const Badge& badge, char* out, size_t outLen) {
+    size_t n = 0;
+    out[0] = '\0';
+    for (int i = 0; i < badge.kinds; i++) {
+        const EmojiEntry* e = Emoji::getByIndex(badge.emoji[i]);
+        if (!e || n + 12 >= outLen) continue;
+        if (n > 0) out[n++] = ' ';
+        n += Emoji::encodeUTF8(e->codepoint, out + n);
+        if (badge.count[i] > 1) {
+            n += snprintf(out + n, outLen - n, "%u", badge.count[i]);
+        }
+        out[n] = '\0';
+    }
+    return n;
+}
+
+void clear() {
+    s_badges.clear();
+    s_dirty = true;
+}
+
+} // namespace Reaction
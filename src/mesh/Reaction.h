@@ -0,0 +1,173 @@
+/**
+ * MeshBerry Emoji Reactions
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * A reaction points at an earlier message by a short content hash and
+ * carries one emoji, instead of being a message of its own. Receivers
+ * show it as a badge under the message it refers to.
+ *
+ * Two wire forms:
+ *  - Text: "<emoji>^1a2b3c" as an ordinary channel message or DM. Stock
+ *    clients show it as text (the emoji and the reference), MeshBerry
+ *    turns it into a badge. Always used for DMs.
+ *  - Compact: a GRP_DATA datagram that fits one AES block whatever the
+ *    sender's name. Only MeshBerry decodes it; other clients drop it.
+ *
+ * This module holds the encoding and the badge table. Packet transport
+ * lives in MeshBerryMesh; the chat screens look badges up when drawing.
+ * Reactions are not archived as messages, so the badge table is saved to
+ * storage and reloaded at boot.
+ */
+
+#ifndef MESHBERRY_REACTION_H
+#define MESHBERRY_REACTION_H
+
+#include <Arduino.h>
+
+namespace Reaction {
+
+// =============================================================================
+// PROTOCOL CONSTANTS
+// =============================================================================
+
+// Compact reactions are carried in PAYLOAD_TYPE_GRP_DATA packets on the channel:
+// [4-byte timestamp][1-byte REACT_TAG][3-byte ref][2-byte emoji index][4-byte sender id]
+//
+// 14 bytes, so one 16-byte AES block; the emoji index is into EMOJI_TABLE.
+constexpr uint8_t  REACT_TAG           = 0xB9;
+constexpr size_t   REACT_PAYLOAD_LEN   = 14;
+constexpr uint32_t REACT_REF_MASK      = 0xFFFFFF;  // 24-bit content hash
+constexpr size_t   REACT_SENDER_MAX    = 15;        // Sender chars hashed (ChatScreen keeps 15)
+
+// Text form: UTF-8 emoji, REACT_TEXT_MARK, six lowercase hex digits
+// (no space: "<emoji>^" plus six is 11 bytes, so a DM stays in one block)
+constexpr const char* REACT_TEXT_MARK  = "^";
+constexpr size_t   REACT_TEXT_MAX      = 16;        // 4-byte emoji + FE0F + "^" + 6 + NUL
+
+// Form used for channel reactions (DMs always use text)
+constexpr uint8_t  REACT_FORM_TEXT     = 0;         // Readable by every client
+constexpr uint8_t  REACT_FORM_COMPACT  = 1;         // MeshBerry only, one block
+
+// Badge table
+constexpr int      REACT_MAX_BADGES    = 64;        // Messages with reactions (LRU)
+constexpr int      REACT_MAX_KINDS     = 3;         // Distinct emoji shown per message
+constexpr int      REACT_MAX_REACTORS  = 6;         // (sender, emoji) pairs remembered for dedupe
+constexpr uint32_t REACT_SAVE_MS       = 2 * 60 * 1000UL;   // Save interval when changed
+
+/**
+ * Reactions collected for one message
+ */
+struct Badge {
+    uint32_t scope;                         // channelScope() or DM contact id
+    uint32_t ref;                           // Content hash of the message
+    uint16_t emoji[REACT_MAX_KINDS];        // EMOJI_TABLE indices
+    uint8_t count[REACT_MAX_KINDS];
+    uint8_t kinds;
+    uint32_t reactor[REACT_MAX_REACTORS];   // Who reacted with ...
+    uint16_t reactorEmoji[REACT_MAX_REACTORS];  // ... which emoji
+    uint8_t reactors;
+};
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+/**
+ * Load saved badges
+ */
+void init();
+
+/**
+ * Save when changed, at most every REACT_SAVE_MS
+ */
+void maintain();
+
+bool save();
+
+// =============================================================================
+// REFERENCES
+// =============================================================================
+
+/**
+ * Content hash a reaction uses to name its message
+ * FNV-1a over the sender (first REACT_SENDER_MAX chars), a NUL and the
+ * text, cut to 24 bits. Unlike hashChannelMessage() it leaves out the
+ * channel index, which differs between devices.
+ * @param sender Sender name for channel messages, nullptr for DMs
+ * @param text Message text (without the "Name: " prefix)
+ */
+uint32_t refHash(const char* sender, const char* text);
+
+/**
+ * Badge scope for a channel (DMs use the contact id)
+ */
+inline uint32_t channelScope(int channelIdx) { return 0xFFFFFF00u | (uint8_t)channelIdx; }
+
+// =============================================================================
+// ENCODING
+// =============================================================================
+
+/**
+ * EMOJI_TABLE index of a text that is exactly one emoji
+ * @return Index, or -1 if the text is anything else
+ */
+int loneEmoji(const char* text);
+
+/**
+ * Build the text form
+ * @param out Buffer of at least REACT_TEXT_MAX bytes
+ * @return Length written, 0 if the emoji index is invalid
+ */
+size_t formatText(uint32_t ref, uint16_t emoji, char* out);
+
+/**
+ * Parse the text form
+ * @return true if text is a reaction
+ */
+bool parseText(const char* text, uint32_t* ref, uint16_t* emoji);
+
+/**
+ * Build the compact form
+ * @param out Buffer of at least REACT_PAYLOAD_LEN bytes
+ * @return Payload length, 0 if the emoji index is invalid
+ */
+size_t encodePacket(uint32_t epoch, uint32_t ref, uint16_t emoji, uint32_t senderId, uint8_t* out);
+
+/**
+ * Parse the compact form
+ * @param data Group datagram payload (starts with the timestamp)
+ * @return true if well formed
+ */
+bool decodePacket(const uint8_t* data, size_t len, uint32_t* ref, uint16_t* emoji, uint32_t* senderId);
+
+// =============================================================================
+// BADGES
+// =============================================================================
+
+/**
+ * Record a reaction
+ * @param reactor Node id, or a hash of the sender name for text reactions
+ * @return true if the badge changed (false for a repeat from the same reactor)
+ */
+bool apply(uint32_t scope, uint32_t ref, uint16_t emoji, uint32_t reactor);
+
+/**
+ * Badge for a message, nullptr if nobody has reacted
+ */
+const Badge* find(uint32_t scope, uint32_t ref);
+
+/**
+ * Render a badge as "<emoji><count> ..." for drawTextWithEmoji
+ * @return Length written
+ */
+size_t formatBadge(const Badge& badge, char* out, size_t outLen);
+
+void clear();
+
+} // namespace Reaction
+
+#endif // MESHBERRY_REACTION_H
@@ -0,0 +1,257 @@
+/**
+ * MeshBerry Relay Coverage Statistics Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "RelayStats.h"
+#include "../drivers/storage.h"
+#include "../util/LruCache.h"
+#include <string.h>
+
+namespace RelayStats {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static const char* RELAY_FILE = "/relays.bin";
+static constexpr uint32_t RELAY_MAGIC = 0x59414C52;        // "RLAY"
+static constexpr uint8_t  RELAY_FILE_VERSION = 1;
+static constexpr uint32_t SAVE_INTERVAL_MS = 10 * 60 * 1000;
+static constexpr float    SNR_EWMA_ALPHA = 0.25f;
+
+// Per-packet flags, so each repeater counts once per message
+static constexpr uint8_t SEEN_CARRIED = 0x01;
+static constexpr uint8_t SEEN_FIRST_HOP = 0x02;
+
+struct Tracked {
+    uint32_t sentAt;        // millis()
+    uint8_t copies;
+    uint8_t seenCount;
+    uint8_t seen[RELAY_PATH_SEEN];
+    uint8_t seenFlags[RELAY_PATH_SEEN];
+};
+
+struct FileHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint16_t reserved;
+    Totals totals;
+};
+
+static LruCache<uint8_t, Repeater, RELAY_MAX_REPEATERS> s_repeaters;
+static LruCache<uint32_t, Tracked, RELAY_MAX_TRACKED> s_tracked;
+static Totals s_totals;
+static uint8_t s_selfHash = 0;
+static bool s_dirty = false;
+static uint32_t s_lastSave = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+// Flags slot for a repeater within one packet, nullptr once the list is full
+static uint8_t* seenFlags(Tracked& t, uint8_t hash) {
+    for (int i = 0; i < t.seenCount; i++) {
+        if (t.seen[i] == hash) return &t.seenFlags[i];
+    }
+    if (t.seenCount >= RELAY_PATH_SEEN) return nullptr;
+    t.seen[t.seenCount] = hash;
+    t.seenFlags[t.seenCount] = 0;
+    return &t.seenFlags[t.seenCount++];
+}
+
+static Repeater& repeater(uint8_t hash) {
+    bool created;
+    Repeater& r = s_repeaters.at(s_repeaters.acquire(hash, &created));
+    if (created) {
+        memset(&r, 0, sizeof(r));
+        r.hash = hash;
+    }
+    return r;
+}
+
+static bool load() {
+    if (!Storage::fileExists(RELAY_FILE)) return false;
+
+    static uint8_t buf[sizeof(FileHeader) + sizeof(Repeater) * RELAY_MAX_REPEATERS];
+    size_t bytesRead = 0;
+    bool ok = Storage::readFile(RELAY_FILE, buf, sizeof(buf), &bytesRead);
+
+    FileHeader header;
+    if (ok && bytesRead >= sizeof(header)) {
+        memcpy(&header, buf, sizeof(header));
+        ok = header.magic == RELAY_MAGIC &&
+             header.version == RELAY_FILE_VERSION &&
+             header.count <= RELAY_MAX_REPEATERS &&
+             bytesRead >= sizeof(header) + header.count * sizeof(Repeater);
+    } else {
+        ok = false;
+    }
+
+    if (!ok) {
+        Serial.println("[RELAY] Ignoring invalid relay stats file");
+        return false;
+    }
+
+    // Saved most recent first; load oldest first to keep that order
+    s_totals = header.totals;
+    for (int i = header.count - 1; i >= 0; i--) {
+        Repeater r;
+        memcpy(&r, buf + sizeof(header) + i * sizeof(Repeater), sizeof(r));
+        s_repeaters.at(s_repeaters.acquire(r.hash)) = r;
+    }
+    Serial.printf("[RELAY] Loaded %d repeaters, %lu messages\n",
+                  header.count, (unsigned long)s_totals.sent);
+    return true;
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+void init(uint8_t selfHash) {
+    s_selfHash = selfHash;
+    s_repeaters.clear();
+    s_tracked.clear();
+    memset(&s_totals, 0, sizeof(s_totals));
+    load();
+    s_dirty = false;
+    s_lastSave = millis();
+}
+
+void maintain() {
+    uint32_t ms = millis();
+    if (s_dirty && ms - s_lastSave >= SAVE_INTERVAL_MS) {
+        s_lastSave = ms;
+        save();
+    }
+}
+
+bool save() {
+    static uint8_t buf[sizeof(FileHeader) + sizeof(Repeater) * RELAY_MAX_REPEATERS];
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = RELAY_MAGIC;
+    header.version = RELAY_FILE_VERSION;
+    header.totals = s_totals;
+
+    uint8_t* p = buf + sizeof(header);
+    for (int slot = s_repeaters.newest(); slot != s_repeaters.NONE; slot = s_repeaters.older(slot)) {
+        memcpy(p, &s_repeaters.at(slot), sizeof(Repeater));
+        p += sizeof(Repeater);
+        header.count++;
+    }
+    memcpy(buf, &header, sizeof(header));
+
+    bool ok = Storage::writeFile(RELAY_FILE, buf, p - buf);
+    if (ok) {
+        s_dirty = false;
+        Serial.printf("[RELAY] Saved %d repeaters\n", header.count);
+    } else {
+        Serial.println("[RELAY] Failed to save relay stats");
+    }
+    return ok;
+}
+
+void clear() {
+    s_repeaters.clear();
+    s_tracked.clear();
+    memset(&s_totals, 0, sizeof(s_totals));
+    s_dirty = true;
+}
+
+// =============================================================================
+// OBSERVATIONS
+// =============================================================================
+
+void noteSent(uint32_t packetHash) {
+    bool created;
+    Tracked& t = s_tracked.at(s_tracked.acquire(packetHash, &created));
+    if (!created) return;   // Sent again with the same bytes
+
+    memset(&t, 0, sizeof(t));
+    t.sentAt = millis();
+    s_totals.sent++;
+    s_dirty = true;
+}
+
+bool observe(uint32_t packetHash, const uint8_t* path, uint8_t pathLen, float snr, uint32_t now) {
+    if (pathLen == 0) return false;
+
+    int slot = s_tracked.find(packetHash);
+    if (slot == s_tracked.NONE) return false;
+    Tracked& t = s_tracked.at(slot);
+    if (millis() - t.sentAt > RELAY_TRACK_MS) {
+        s_tracked.erase(slot);
+        return false;
+    }
+
+    bool firstCopy = (t.copies == 0);
+    if (t.copies < 255) t.copies++;
+    s_totals.copies++;
+    if (firstCopy) s_totals.relayed++;
+
+    for (uint8_t i = 0; i < pathLen; i++) {
+        uint8_t hash = path[i];
+        if (hash == s_selfHash) continue;
+
+        Repeater& r = repeater(hash);
+        r.lastSeen = now;
+
+        uint8_t* flags = seenFlags(t, hash);
+        if (flags && !(*flags & SEEN_CARRIED)) {
+            *flags |= SEEN_CARRIED;
+            if (r.carried < 0xFFFF) r.carried++;
+        }
+        if (i == 0 && flags && !(*flags & SEEN_FIRST_HOP)) {
+            *flags |= SEEN_FIRST_HOP;
+            if (r.firstHop < 0xFFFF) r.firstHop++;
+        }
+
+        // The last hop is the node we actually heard
+        if (i == pathLen - 1) {
+            r.snr = r.heard ? r.snr + SNR_EWMA_ALPHA * (snr - r.snr) : snr;
+            if (r.heard < 0xFFFF) {
+                r.heard++;
+                if (firstCopy) r.heardFirst++;
+            }
+        }
+    }
+
+    s_dirty = true;
+    return true;
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+const Totals& getTotals() {
+    return s_totals;
+}
+
+int getRepeaters(Repeater* out, int maxCount) {
+    int count = 0;
+    for (int slot = s_repeaters.newest(); slot != s_repeaters.NONE && count < maxCount;
+         slot = s_repeaters.older(slot)) {
+        // Insertion sort: at most RELAY_MAX_REPEATERS entries
+        const Repeater& r = s_repeaters.at(slot);
+        int i = count++;
+        while (i > 0 && (out[i - 1].carried < r.carried ||
+                         (out[i - 1].carried == r.carried && out[i - 1].heard < r.heard))) {
+            out[i] = out[i - 1];
+            i--;
+        }
+        out[i] = r;
+    }
+    return count;
+}
+
+} // namespace RelayStats
@@ -0,0 +1,119 @@
+/**
+ * MeshBerry Relay Coverage Statistics
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Records which repeaters carry our channel messages. Every rebroadcast
+ * of one of our packets that we overhear carries the path hashes of the
+ * repeaters it went through; those are aggregated per repeater into a
+ * small table:
+ *   - coverage: how many of our messages it carried at all, and how many
+ *     it picked up straight from us (first hop)
+ *   - duplicate overhead: of the copies we heard it transmit, how many
+ *     arrived after we already had one of that message
+ *
+ * Repeaters are keyed by 1-byte path hash, so two whose hashes collide
+ * share an entry. The table is saved to storage periodically.
+ */
+
+#ifndef MESHBERRY_RELAYSTATS_H
+#define MESHBERRY_RELAYSTATS_H
+
+#include <Arduino.h>
+
+namespace RelayStats {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr int      RELAY_MAX_REPEATERS = 32;       // Least recently seen evicted
+constexpr int      RELAY_MAX_TRACKED   = 8;        // Our packets watched at once
+constexpr uint32_t RELAY_TRACK_MS      = 60000;    // Same as repeat tracking
+constexpr int      RELAY_PATH_SEEN     = 12;       // Repeaters remembered per packet
+
+/**
+ * Aggregated counters for one repeater
+ */
+struct Repeater {
+    uint8_t hash;           // Path hash
+    uint8_t reserved;
+    uint16_t carried;       // Our messages with it anywhere in the path
+    uint16_t firstHop;      // ... with it as the first hop
+    uint16_t heard;         // Copies we heard it transmit (last hop)
+    uint16_t heardFirst;    // ... that were the first copy of the message
+    float snr;              // EWMA SNR of the copies heard from it
+    uint32_t lastSeen;      // RTC epoch seconds
+
+    // Share of heard copies that brought nothing new
+    float duplicateRatio() const { return heard ? (float)(heard - heardFirst) / heard : 0.0f; }
+};
+
+/**
+ * Totals over all our channel packets
+ */
+struct Totals {
+    uint32_t sent;          // Channel packets we originated
+    uint32_t relayed;       // ... with at least one rebroadcast heard
+    uint32_t copies;        // Rebroadcasts heard in all
+};
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+/**
+ * Load persisted counters
+ * @param selfHash Our own path hash (never counted as a repeater)
+ */
+void init(uint8_t selfHash);
+
+/**
+ * Save when dirty, at most every few minutes
+ */
+void maintain();
+
+bool save();
+
+/**
+ * Forget all repeaters and totals
+ */
+void clear();
+
+// =============================================================================
+// OBSERVATIONS
+// =============================================================================
+
+/**
+ * Start watching one of our channel packets
+ * @param packetHash Packet hash (path excluded, so rebroadcasts match)
+ */
+void noteSent(uint32_t packetHash);
+
+/**
+ * Record an overheard rebroadcast of one of our packets
+ * @param path Repeater hashes, first hop first
+ * @param snr SNR of the copy, which came from the last hop
+ * @param now RTC epoch seconds
+ * @return false if the packet is not being watched
+ */
+bool observe(uint32_t packetHash, const uint8_t* path, uint8_t pathLen, float snr, uint32_t now);
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+const Totals& getTotals();
+
+/**
+ * Repeaters sorted by messages carried, most first
+ * @return Number written
+ */
+int getRepeaters(Repeater* out, int maxCount);
+
+} // namespace RelayStats
+
+#endif // MESHBERRY_RELAYSTATS_H
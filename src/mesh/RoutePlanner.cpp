@@ -0,0 +1,194 @@
+/**
+ * MeshBerry Route Planner Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "RoutePlanner.h"
+#include "Topology.h"
+#include "NodeType.h"
+#include <string.h>
+
+namespace RoutePlanner {
+
+using namespace Topology;
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static constexpr float COST_INF = 1e9f;
+static constexpr int ADJ_CAPACITY = TOPO_MAX_EDGES * 2;
+
+// Adjacency in compressed-row form, rebuilt from the edge table
+static uint16_t s_adjStart[TOPO_MAX_NODES + 1];
+static uint8_t  s_adjNode[ADJ_CAPACITY];
+static float    s_adjCost[ADJ_CAPACITY];
+
+// Shortest-path tree rooted at self
+static float   s_dist[TOPO_MAX_NODES];
+static int16_t s_prev[TOPO_MAX_NODES];
+static uint8_t s_hopCount[TOPO_MAX_NODES];
+
+static bool s_valid = false;
+static uint32_t s_treeVersion = 0;
+static uint32_t s_treeBuiltAt = 0;
+static uint32_t s_recomputeCount = 0;
+static uint32_t s_lastComputeUs = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+/**
+ * Whether packets can be routed through a vertex
+ * Hashes seen inside paths have forwarded before. Nodes that advertised
+ * themselves as chat/room/sensor clients are only used as endpoints.
+ */
+static bool canTransit(const TopoNode* n) {
+    if (!(n->flags & TOPO_NODE_NAMED)) return true;
+    return n->type == NODE_TYPE_REPEATER || n->type == NODE_TYPE_UNKNOWN;
+}
+
+static void buildAdjacency(uint32_t now) {
+    uint32_t cutoff = (now > ROUTE_EDGE_MAX_AGE_SECS) ? now - ROUTE_EDGE_MAX_AGE_SECS : 0;
+    uint8_t degree[TOPO_MAX_NODES];
+    memset(degree, 0, sizeof(degree));
+
+    for (int s = 0; s < TOPO_EDGE_SLOTS; s++) {
+        const TopoEdge* e = getEdgeSlot(s);
+        if (!e || e->lastSeen < cutoff) continue;
+        if (degree[e->a] < 255) degree[e->a]++;
+        if (degree[e->b] < 255) degree[e->b]++;
+    }
+
+    uint16_t offset = 0;
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        s_adjStart[i] = offset;
+        offset += degree[i];
+    }
+    s_adjStart[TOPO_MAX_NODES] = offset;
+
+    // Second pass fills each row using degree[] as the write cursor
+    for (int i = 0; i < TOPO_MAX_NODES; i++) degree[i] = 0;
+    for (int s = 0; s < TOPO_EDGE_SLOTS; s++) {
+        const TopoEdge* e = getEdgeSlot(s);
+        if (!e || e->lastSeen < cutoff) continue;
+
+        uint16_t ia = s_adjStart[e->a] + degree[e->a];
+        uint16_t ib = s_adjStart[e->b] + degree[e->b];
+        if (ia >= s_adjStart[e->a + 1] || ib >= s_adjStart[e->b + 1]) continue;
+
+        s_adjNode[ia] = e->b;
+        s_adjCost[ia] = e->etx;
+        s_adjNode[ib] = e->a;
+        s_adjCost[ib] = e->etx;
+        degree[e->a]++;
+        degree[e->b]++;
+    }
+}
+
+/**
+ * Hop-bounded Dijkstra from self
+ * With at most 256 vertices a linear min-scan is cheaper than a heap
+ * and needs no allocation.
+ */
+static void computeTree(uint32_t now) {
+    uint32_t start = micros();
+
+    buildAdjacency(now);
+
+    bool done[TOPO_MAX_NODES];
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        s_dist[i] = COST_INF;
+        s_prev[i] = -1;
+        s_hopCount[i] = 0;
+        done[i] = false;
+    }
+
+    uint8_t self = getSelfHash();
+    s_dist[self] = 0.0f;
+
+    for (;;) {
+        int u = -1;
+        float best = COST_INF;
+        for (int i = 0; i < TOPO_MAX_NODES; i++) {
+            if (!done[i] && s_dist[i] < best) {
+                best = s_dist[i];
+                u = i;
+            }
+        }
+        if (u < 0) break;
+        done[u] = true;
+
+        if (u != self && !canTransit(getNode((uint8_t)u))) continue;
+        if (s_hopCount[u] > ROUTE_MAX_HOPS) continue;
+
+        for (uint16_t k = s_adjStart[u]; k < s_adjStart[u + 1]; k++) {
+            uint8_t v = s_adjNode[k];
+            float d = s_dist[u] + s_adjCost[k];
+            if (!done[v] && d < s_dist[v]) {
+                s_dist[v] = d;
+                s_prev[v] = (int16_t)u;
+                s_hopCount[v] = s_hopCount[u] + 1;
+            }
+        }
+    }
+
+    s_lastComputeUs = micros() - start;
+    s_recomputeCount++;
+    s_treeVersion = getVersion();
+    s_treeBuiltAt = millis();
+    s_valid = true;
+}
+
+// =============================================================================
+// PLANNING
+// =============================================================================
+
+bool planRoute(uint8_t destHash, uint32_t now, Route& out) {
+    memset(&out, 0, sizeof(out));
+    if (destHash == getSelfHash() || getEdgeCount() == 0) return false;
+
+    if (!s_valid || s_treeVersion != getVersion() ||
+        millis() - s_treeBuiltAt >= ROUTE_REFRESH_MS) {
+        computeTree(now);
+    }
+
+    if (s_dist[destHash] >= COST_INF || s_dist[destHash] > ROUTE_MAX_COST) return false;
+
+    // hopCount counts links; the path carries only the repeaters between
+    uint8_t intermediates = s_hopCount[destHash] - 1;
+    if (intermediates > ROUTE_MAX_HOPS) return false;
+
+    int v = s_prev[destHash];
+    for (int i = intermediates - 1; i >= 0; i--) {
+        if (v < 0) return false;
+        out.hops[i] = (uint8_t)v;
+        v = s_prev[v];
+    }
+    out.hopCount = intermediates;
+    out.cost = s_dist[destHash];
+    return true;
+}
+
+void invalidate() {
+    s_valid = false;
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+uint32_t getRecomputeCount() {
+    return s_recomputeCount;
+}
+
+uint32_t getLastComputeUs() {
+    return s_lastComputeUs;
+}
+
+} // namespace RoutePlanner
@@ -0,0 +1,74 @@
+/**
+ * MeshBerry Route Planner
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Least-cost source routes over the passively learned topology graph.
+ * A shortest-path tree rooted at this node is computed with Dijkstra
+ * (link cost = ETX) and cached until the topology changes, so a route
+ * lookup is normally just a walk back up the tree.
+ *
+ * Planned routes let a DM go out direct to a contact we have never
+ * exchanged a path with, instead of flooding the first message.
+ */
+
+#ifndef MESHBERRY_ROUTE_PLANNER_H
+#define MESHBERRY_ROUTE_PLANNER_H
+
+#include <Arduino.h>
+
+namespace RoutePlanner {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr int      ROUTE_MAX_HOPS          = 8;             // Intermediate repeaters
+constexpr float    ROUTE_MAX_COST          = 12.0f;         // Total ETX; costlier routes flood instead
+constexpr uint32_t ROUTE_EDGE_MAX_AGE_SECS = 6 * 60 * 60;   // Ignore links not heard recently
+constexpr uint32_t ROUTE_REFRESH_MS        = 60 * 1000;     // Pick up ETX drift on unchanged graphs
+
+/**
+ * Planned source route (intermediate hops only, in send order)
+ */
+struct Route {
+    uint8_t hops[ROUTE_MAX_HOPS];
+    uint8_t hopCount;
+    float cost;                 // Sum of link ETX including the final link
+};
+
+// =============================================================================
+// PLANNING
+// =============================================================================
+
+/**
+ * Plan a route from this node to a vertex
+ * @param destHash Destination path hash (first byte of its public key)
+ * @param now RTC epoch seconds (for link freshness)
+ * @param out Planned route
+ * @return true if a route within ROUTE_MAX_HOPS and ROUTE_MAX_COST exists
+ */
+bool planRoute(uint8_t destHash, uint32_t now, Route& out);
+
+/**
+ * Drop the cached shortest-path tree (next plan recomputes)
+ */
+void invalidate();
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+uint32_t getRecomputeCount();
+
+/**
+ * Duration of the last shortest-path computation in microseconds
+ */
+uint32_t getLastComputeUs();
+
+} // namespace RoutePlanner
+
+#endif // MESHBERRY_ROUTE_PLANNER_H
@@ -0,0 +1,355 @@
+/**
+ * MeshBerry Mesh Time Sync Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "TimeSync.h"
+#include "MeshBerryRTCClock.h"
+#include <math.h>
+#include <string.h>
+
+namespace TimeSync {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static ESP32RTCClock* s_clock = nullptr;
+
+static Source s_sources[TS_MAX_SOURCES];
+static Status s_status;
+static float s_linkDelayMs = TS_LINK_DELAY_DEFAULT_MS;
+static uint32_t s_lastRoundAt = 0;
+
+// Consensus history for the skew fit (reference - oscillator vs oscillator)
+static uint64_t s_histLocal[TS_SKEW_HISTORY];
+static int64_t  s_histRaw[TS_SKEW_HISTORY];
+static int s_histCount = 0;
+static int s_histHead = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static Source* findSource(uint8_t hash, bool create) {
+    Source* freeSlot = nullptr;
+    Source* oldest = nullptr;
+    for (int i = 0; i < TS_MAX_SOURCES; i++) {
+        Source& s = s_sources[i];
+        if (s.active && s.hash == hash) return &s;
+        if (!s.active) {
+            if (!freeSlot) freeSlot = &s;
+        } else if (!oldest || (int32_t)(s.seenAt - oldest->seenAt) < 0) {
+            oldest = &s;
+        }
+    }
+    if (!create) return nullptr;
+
+    Source* slot = freeSlot ? freeSlot : oldest;
+    memset(slot, 0, sizeof(*slot));
+    slot->hash = hash;
+    return slot;
+}
+
+static bool isFresh(const Source& s, uint32_t now) {
+    return s.active && (now - s.seenAt) < TS_SOURCE_MAX_AGE_MS;
+}
+
+/**
+ * Whether a recent GPS or manual set outranks the mesh
+ */
+static bool clockIsAuthoritative() {
+    TimeSource src = s_clock->getSource();
+    uint32_t age = s_clock->msSinceSet();
+    if (src == TIME_SOURCE_GPS) return age < TS_GPS_HOLDOVER_MS;
+    if (src == TIME_SOURCE_MANUAL) return age < TS_MANUAL_HOLDOVER_MS;
+    return false;
+}
+
+/**
+ * Least-squares slope of the consensus history, in ppm
+ * @return false if the history is too short to trust
+ */
+static bool fitSkew(int32_t& ppm) {
+    if (s_histCount < 4) return false;
+
+    int first = (s_histHead - s_histCount + TS_SKEW_HISTORY) % TS_SKEW_HISTORY;
+    int last = (s_histHead - 1 + TS_SKEW_HISTORY) % TS_SKEW_HISTORY;
+    if (s_histLocal[last] - s_histLocal[first] < TS_SKEW_MIN_SPAN_MS) return false;
+
+    // Centre on the first point so doubles keep their precision
+    double sx = 0, sy = 0;
+    for (int i = 0; i < s_histCount; i++) {
+        int k = (first + i) % TS_SKEW_HISTORY;
+        sx += (double)(s_histLocal[k] - s_histLocal[first]);
+        sy += (double)(s_histRaw[k] - s_histRaw[first]);
+    }
+    double mx = sx / s_histCount;
+    double my = sy / s_histCount;
+
+    double sxx = 0, sxy = 0;
+    for (int i = 0; i < s_histCount; i++) {
+        int k = (first + i) % TS_SKEW_HISTORY;
+        double dx = (double)(s_histLocal[k] - s_histLocal[first]) - mx;
+        double dy = (double)(s_histRaw[k] - s_histRaw[first]) - my;
+        sxx += dx * dx;
+        sxy += dx * dy;
+    }
+    if (sxx <= 0) return false;
+
+    ppm = (int32_t)lround(sxy / sxx * 1e6);
+    return true;
+}
+
+static void addSkewPoint(uint64_t local, int64_t raw) {
+    // A consensus that jumped (sources changed clocks) invalidates the fit
+    if (s_histCount > 0) {
+        int last = (s_histHead - 1 + TS_SKEW_HISTORY) % TS_SKEW_HISTORY;
+        int64_t predicted = s_histRaw[last] +
+            (int64_t)(local - s_histLocal[last]) * s_status.skewPpm / 1000000;
+        int64_t diff = raw - predicted;
+        if (diff > TS_FALSETICKER_MS || diff < -TS_FALSETICKER_MS) {
+            Serial.printf("[TIMESYNC] Consensus jumped %lld ms, restarting skew fit\n", (long long)diff);
+            s_histCount = 0;
+        }
+    }
+
+    s_histLocal[s_histHead] = local;
+    s_histRaw[s_histHead] = raw;
+    s_histHead = (s_histHead + 1) % TS_SKEW_HISTORY;
+    if (s_histCount < TS_SKEW_HISTORY) s_histCount++;
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+void init(ESP32RTCClock* clock) {
+    s_clock = clock;
+    reset();
+}
+
+void reset() {
+    memset(s_sources, 0, sizeof(s_sources));
+    memset(&s_status, 0, sizeof(s_status));
+    s_histCount = 0;
+    s_histHead = 0;
+    s_linkDelayMs = TS_LINK_DELAY_DEFAULT_MS;
+    s_status.linkDelayMs = TS_LINK_DELAY_DEFAULT_MS;
+    if (s_clock) s_status.skewPpm = s_clock->getSkewPpm();
+    s_lastRoundAt = millis();
+}
+
+void maintain() {
+    if (!s_clock) return;
+    s_clock->tick();
+
+    uint32_t now = millis();
+    uint32_t interval = s_clock->getSource() == TIME_SOURCE_MESH ?
+                        TS_DISCIPLINE_MS : TS_FAST_DISCIPLINE_MS;
+    if (now - s_lastRoundAt < interval) return;
+    s_lastRoundAt = now;
+    disciplineNow();
+}
+
+bool disciplineNow() {
+    if (!s_clock) return false;
+
+    uint32_t now = millis();
+    uint64_t local = s_clock->localMs();
+    int64_t clockOffset = (int64_t)s_clock->nowMs() - (int64_t)local;
+
+    // Current offset and weight of every fresh source, sorted by offset
+    int64_t offs[TS_MAX_SOURCES];
+    float weights[TS_MAX_SOURCES];
+    int idx[TS_MAX_SOURCES];
+    int n = 0;
+    float totalWeight = 0;
+    for (int i = 0; i < TS_MAX_SOURCES; i++) {
+        Source& s = s_sources[i];
+        s.used = false;
+        if (!isFresh(s, now)) continue;
+
+        int64_t off = sourceOffsetMs(s);
+        float w = (float)s.weight / (1.0f + s.hops);
+        int j = n++;
+        while (j > 0 && offs[j - 1] > off) {
+            offs[j] = offs[j - 1];
+            weights[j] = weights[j - 1];
+            idx[j] = idx[j - 1];
+            j--;
+        }
+        offs[j] = off;
+        weights[j] = w;
+        idx[j] = i;
+        totalWeight += w;
+    }
+    s_status.sourceCount = n;
+    s_status.usedCount = 0;
+    s_status.applied = false;
+    if (n == 0) return false;
+
+    // Weighted median, then drop falsetickers around it
+    int64_t median = offs[n - 1];
+    float cumulative = 0;
+    for (int i = 0; i < n; i++) {
+        cumulative += weights[i];
+        if (cumulative >= totalWeight / 2) {
+            median = offs[i];
+            break;
+        }
+    }
+
+    double sumW = 0, sumX = 0, sumXX = 0;
+    int used = 0;
+    bool anyPreferred = false;
+    for (int i = 0; i < n; i++) {
+        int64_t d = offs[i] - median;
+        if (d > TS_FALSETICKER_MS || d < -TS_FALSETICKER_MS) continue;
+        // Accumulate relative to the median to keep precision
+        sumW += weights[i];
+        sumX += weights[i] * (double)d;
+        sumXX += weights[i] * (double)d * (double)d;
+        s_sources[idx[i]].used = true;
+        if (s_sources[idx[i]].weight >= TS_WEIGHT_PREFERRED) anyPreferred = true;
+        used++;
+    }
+    s_status.usedCount = used;
+
+    // A lone source only counts if it is GPS-equipped
+    if (used < 2 && !anyPreferred) return false;
+
+    double meanRel = sumX / sumW;
+    double variance = sumXX / sumW - meanRel * meanRel;
+    if (variance < 0) variance = 0;
+    int64_t consensus = median + (int64_t)llround(meanRel);
+
+    // Timestamps are whole seconds, so a single sample is good to ~0.3 s at best
+    double stdErr = sqrt((variance + 290.0 * 290.0) / used);
+    s_status.estErrorMs = (int32_t)stdErr;
+    s_status.lastOffsetMs = (consensus > INT32_MAX) ? INT32_MAX :
+                            (consensus < -INT32_MAX) ? -INT32_MAX : (int32_t)consensus;
+    s_status.lastDisciplineAt = now ? now : 1;
+
+    if (clockIsAuthoritative()) {
+        Serial.printf("[TIMESYNC] Mesh offset %d ms from %d sources (not applied, %s holdover)\n",
+                      s_status.lastOffsetMs, used,
+                      s_clock->getSource() == TIME_SOURCE_GPS ? "GPS" : "manual");
+        return true;
+    }
+
+    // How far the mesh may move the clock
+    int64_t limit;
+    if (s_clock->getSetSource() == TIME_SOURCE_GPS) {
+        limit = ESP32RTCClock::STEP_THRESHOLD_MS;   // Slew only, never step
+    } else if (!s_clock->isTimeSet() || s_clock->getSource() == TIME_SOURCE_PEER) {
+        limit = INT64_MAX;                          // Never synced, or one peer's word
+    } else {
+        limit = TS_MAX_CORRECTION_MS;
+    }
+    if (consensus > limit || consensus < -limit) {
+        Serial.printf("[TIMESYNC] Mesh offset %d ms from %d sources rejected (limit %ld ms)\n",
+                      s_status.lastOffsetMs, used, (long)limit);
+        return true;
+    }
+
+    // Discipline the clock
+    if (consensus > 1000000000LL || consensus < -1000000000LL) {
+        s_clock->setCurrentTime((uint32_t)(((int64_t)s_clock->nowMs() + consensus) / 1000),
+                                TIME_SOURCE_MESH);
+    } else if (consensus > TS_DEADBAND_MS || consensus < -TS_DEADBAND_MS ||
+               s_clock->getSource() != TIME_SOURCE_MESH) {
+        s_clock->adjustMs((int32_t)consensus, TIME_SOURCE_MESH);
+    }
+    s_status.applied = true;
+
+    // Skew from the drift of reference time against the raw oscillator
+    addSkewPoint(local, consensus + clockOffset);
+    s_status.skewPoints = s_histCount;
+    int32_t ppm;
+    if (fitSkew(ppm)) {
+        // Each fit spans about an hour of noisy estimates, so smooth it
+        int32_t current = s_clock->getSkewPpm();
+        s_clock->setSkewPpm(current + (ppm - current) / 4);
+        s_status.skewPpm = s_clock->getSkewPpm();
+    }
+
+    Serial.printf("[TIMESYNC] Offset %d ms from %d/%d sources (+/-%d ms), skew %d ppm\n",
+                  s_status.lastOffsetMs, used, n, s_status.estErrorMs, s_status.skewPpm);
+    return true;
+}
+
+// =============================================================================
+// SAMPLES
+// =============================================================================
+
+void addSample(uint8_t hash, uint32_t peerTime, uint8_t hops, bool preferred) {
+    if (!s_clock || peerTime < ESP32RTCClock::MIN_VALID_EPOCH) return;
+
+    // Seconds are truncated, so the send time is mid-second on average,
+    // and the packet spent one link delay per link in flight
+    int64_t refMs = (int64_t)peerTime * 1000 + 500 +
+                    (int64_t)((hops + 1) * s_linkDelayMs);
+    int64_t raw = refMs - (int64_t)s_clock->localMs();
+
+    Source* s = findSource(hash, true);
+    if (s->active) {
+        // Smooth consistent samples; take the new one outright after a jump
+        int64_t prev = sourceOffsetMs(*s) + (int64_t)s_clock->nowMs() - (int64_t)s_clock->localMs();
+        int64_t d = raw - prev;
+        if (d < TS_FALSETICKER_MS && d > -TS_FALSETICKER_MS) {
+            raw = prev + d / 2;
+        }
+    }
+    s->rawOffsetMs = raw;
+    s->seenAt = millis();
+    s->hops = hops;
+    s->weight = preferred ? TS_WEIGHT_PREFERRED : TS_WEIGHT_NORMAL;
+    if (s->samples < 0xFFFF) s->samples++;
+    s->active = true;
+}
+
+void addRoundTrip(uint8_t hops, uint32_t rttMs) {
+    float oneWay = (float)rttMs / (2.0f * (hops + 1));
+    if (oneWay < 20.0f || oneWay > 5000.0f) return;
+    s_linkDelayMs += (oneWay - s_linkDelayMs) / 8.0f;
+    s_status.linkDelayMs = (uint16_t)s_linkDelayMs;
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+const Status& getStatus() {
+    return s_status;
+}
+
+int getSourceCount() {
+    int count = 0;
+    for (int i = 0; i < TS_MAX_SOURCES; i++) {
+        if (s_sources[i].active) count++;
+    }
+    return count;
+}
+
+const Source* getSource(int index) {
+    for (int i = 0; i < TS_MAX_SOURCES; i++) {
+        if (!s_sources[i].active) continue;
+        if (index-- == 0) return &s_sources[i];
+    }
+    return nullptr;
+}
+
+int64_t sourceOffsetMs(const Source& s) {
+    if (!s_clock) return 0;
+    uint64_t local = s_clock->localMs();
+    // Reference time drifts against the oscillator at the applied skew
+    int64_t raw = s.rawOffsetMs + (int64_t)(millis() - s.seenAt) * s_clock->getSkewPpm() / 1000000;
+    return raw + (int64_t)local - (int64_t)s_clock->nowMs();
+}
+
+} // namespace TimeSync
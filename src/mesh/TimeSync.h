@@ -0,0 +1,144 @@
+/**
+ * MeshBerry Mesh Time Sync
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Keeps the RTC close to mesh consensus time after the one-shot sync.
+ *
+ * Every signed advert carries its sender's clock. Each sample is
+ * corrected for flight time (hops x per-link delay, with the per-link
+ * delay learned from DM ACK round trips) and stored per source as the
+ * difference between reference time and our raw oscillator. Periodically
+ * the fresh sources are combined: falsetickers far from the weighted
+ * median are dropped and the rest averaged, with sources that advertise
+ * a position (GPS-equipped) weighted up. The result is slewed into the
+ * clock, and a regression over successive estimates gives the oscillator
+ * skew. A recent local GPS or CLI set is authoritative and is not
+ * disciplined by the mesh until its holdover expires.
+ *
+ * The mesh only steps a clock that was never set or was set from a
+ * single peer. Once synced, a consensus further off than a few minutes
+ * is rejected, and a clock last set from GPS is only ever slewed.
+ */
+
+#ifndef MESHBERRY_TIME_SYNC_H
+#define MESHBERRY_TIME_SYNC_H
+
+#include <Arduino.h>
+
+class ESP32RTCClock;
+
+namespace TimeSync {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr int      TS_MAX_SOURCES          = 32;
+constexpr int      TS_SKEW_HISTORY         = 16;               // Consensus points for skew fit
+constexpr uint32_t TS_SOURCE_MAX_AGE_MS    = 2 * 60 * 60 * 1000UL;
+constexpr uint32_t TS_DISCIPLINE_MS        = 5 * 60 * 1000UL;  // Normal discipline interval
+constexpr uint32_t TS_FAST_DISCIPLINE_MS   = 30 * 1000UL;      // Until first mesh discipline
+constexpr int32_t  TS_FALSETICKER_MS       = 10 * 1000;        // Max distance from the median
+constexpr int32_t  TS_DEADBAND_MS          = 250;              // Smaller offsets are ignored
+constexpr int32_t  TS_MAX_CORRECTION_MS    = 5 * 60 * 1000;    // Larger offsets rejected once synced
+constexpr uint32_t TS_SKEW_MIN_SPAN_MS     = 30 * 60 * 1000UL; // Fit span before skew is applied
+constexpr uint32_t TS_GPS_HOLDOVER_MS      = 6 * 60 * 60 * 1000UL;
+constexpr uint32_t TS_MANUAL_HOLDOVER_MS   = 60 * 60 * 1000UL;
+constexpr uint16_t TS_LINK_DELAY_DEFAULT_MS = 500;
+constexpr uint8_t  TS_WEIGHT_PREFERRED     = 4;                // Source advertises a position
+constexpr uint8_t  TS_WEIGHT_NORMAL        = 1;
+
+/**
+ * One reference source (keyed by path hash)
+ */
+struct Source {
+    int64_t rawOffsetMs;    // Reference epoch ms - local oscillator ms
+    uint32_t seenAt;        // millis() of the last sample
+    uint16_t samples;
+    uint8_t hash;
+    uint8_t hops;           // Hops of the last sample
+    uint8_t weight;
+    bool used;              // Survived the last falseticker check
+    bool active;
+};
+
+/**
+ * Result of the last discipline round
+ */
+struct Status {
+    int32_t lastOffsetMs;       // Consensus minus local clock before correcting
+    int32_t estErrorMs;         // Standard error of the consensus
+    int32_t skewPpm;            // Applied oscillator correction
+    uint32_t lastDisciplineAt;  // millis(), 0 = never
+    uint16_t linkDelayMs;       // Learned one-way per-link delay
+    uint8_t sourceCount;        // Fresh sources
+    uint8_t usedCount;          // Sources in the consensus
+    uint8_t skewPoints;         // Points in the skew fit
+    bool applied;               // Last consensus was applied to the clock
+};
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+/**
+ * Attach the clock to discipline
+ */
+void init(ESP32RTCClock* clock);
+
+/**
+ * Slew the clock and run discipline rounds when due; call from the mesh loop
+ */
+void maintain();
+
+/**
+ * Run a discipline round now
+ * @return true if a consensus was formed
+ */
+bool disciplineNow();
+
+/**
+ * Forget all sources and the skew fit
+ */
+void reset();
+
+// =============================================================================
+// SAMPLES
+// =============================================================================
+
+/**
+ * Record a timestamp heard from a peer (signed advert)
+ * @param hash Source path hash
+ * @param peerTime Sender's epoch seconds
+ * @param hops Repeaters the packet passed through
+ * @param preferred Source advertises a position (likely GPS time)
+ */
+void addSample(uint8_t hash, uint32_t peerTime, uint8_t hops, bool preferred);
+
+/**
+ * Record a DM ACK round trip to refine the per-link delay
+ * @param hops Repeaters each way
+ * @param rttMs Send to ACK
+ */
+void addRoundTrip(uint8_t hops, uint32_t rttMs);
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+const Status& getStatus();
+int getSourceCount();
+const Source* getSource(int index);
+
+/**
+ * Current offset of a source from the local clock (ms, + = source ahead)
+ */
+int64_t sourceOffsetMs(const Source& s);
+
+} // namespace TimeSync
+
+#endif // MESHBERRY_TIME_SYNC_H
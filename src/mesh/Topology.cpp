@@ -0,0 +1,572 @@
+/**
+ * MeshBerry Mesh Topology Service Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "Topology.h"
+#include "../drivers/storage.h"
+#include <esp_heap_caps.h>
+#include <math.h>
+#include <string.h>
+
+namespace Topology {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static const char* TOPO_FILE = "/topology.bin";
+static constexpr uint32_t TOPO_MAGIC = 0x4F504F54;         // "TOPO"
+static constexpr uint8_t  TOPO_FILE_VERSION = 1;
+
+static constexpr uint32_t PRUNE_INTERVAL_MS = 5 * 60 * 1000;
+static constexpr uint32_t SAVE_INTERVAL_MS  = 10 * 60 * 1000;
+
+// SNR range mapped onto link delivery probability for ETX
+static constexpr float SNR_FLOOR_DB = -10.0f;   // p = 0.05 at or below
+static constexpr float SNR_GOOD_DB  = 5.0f;     // p = 1.0 at or above
+static constexpr float SNR_EWMA_ALPHA = 0.25f;
+
+// Layout tuning (world units; the screen scales to fit)
+static constexpr float LAYOUT_K = 40.0f;        // Ideal edge length
+static constexpr float LAYOUT_TEMP_START = 30.0f;
+static constexpr float LAYOUT_TEMP_MIN = 0.5f;
+static constexpr float LAYOUT_COOLING = 0.95f;
+
+struct FileHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t selfHash;
+    uint16_t nodeCount;
+    uint16_t edgeCount;
+    uint16_t reserved;
+};
+
+static TopoNode* s_nodes = nullptr;     // TOPO_MAX_NODES entries, indexed by hash
+static TopoEdge* s_edges = nullptr;     // TOPO_EDGE_SLOTS entries, open addressing
+static float s_dispX[TOPO_MAX_NODES];
+static float s_dispY[TOPO_MAX_NODES];
+
+static uint8_t s_selfHash = 0;
+static int s_nodeCount = 0;
+static int s_edgeCount = 0;
+static uint32_t s_version = 0;
+static uint32_t s_layoutVersion = 0;
+static float s_layoutTemp = LAYOUT_TEMP_START;
+static bool s_dirty = false;
+static uint32_t s_droppedEdges = 0;
+static uint32_t s_lastPrune = 0;
+static uint32_t s_lastSave = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static void* allocTable(size_t bytes) {
+    void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!p) {
+        p = malloc(bytes);
+    }
+    if (p) {
+        memset(p, 0, bytes);
+    }
+    return p;
+}
+
+static inline int edgeHome(uint8_t a, uint8_t b) {
+    uint32_t key = ((uint32_t)a << 8) | b;
+    return (int)((key * 2654435761u) >> 22) & (TOPO_EDGE_SLOTS - 1);
+}
+
+/**
+ * Find the slot holding edge (a, b) or the empty slot where it belongs
+ * Expects a < b. Returns -1 only if the table is completely full.
+ */
+static int probeEdge(uint8_t a, uint8_t b) {
+    int slot = edgeHome(a, b);
+    for (int i = 0; i < TOPO_EDGE_SLOTS; i++) {
+        TopoEdge& e = s_edges[slot];
+        if (!(e.flags & TOPO_EDGE_ACTIVE)) return slot;
+        if (e.a == a && e.b == b) return slot;
+        slot = (slot + 1) & (TOPO_EDGE_SLOTS - 1);
+    }
+    return -1;
+}
+
+static float etxFromSnr(float snr) {
+    float p = (snr - SNR_FLOOR_DB) / (SNR_GOOD_DB - SNR_FLOOR_DB);
+    if (p < 0.05f) p = 0.05f;
+    if (p > 1.0f) p = 1.0f;
+    // Forward and ACK/return direction assumed symmetric
+    float etx = 1.0f / (p * p);
+    return (etx > TOPO_ETX_MAX) ? TOPO_ETX_MAX : etx;
+}
+
+static float etxFromObservations(uint16_t observations) {
+    // Unmeasured links we keep hearing are probably usable
+    return 1.0f + (TOPO_ETX_UNKNOWN - 1.0f) / (1.0f + observations / 4.0f);
+}
+
+static void activateNode(uint8_t hash, uint8_t nearHash, uint32_t now) {
+    TopoNode& n = s_nodes[hash];
+    if (!(n.flags & TOPO_NODE_ACTIVE)) {
+        n.flags |= TOPO_NODE_ACTIVE;
+        n.hash = hash;
+        s_nodeCount++;
+
+        // Seed new vertices next to the node they were seen with so the
+        // layout converges from a sensible position
+        const TopoNode& near = s_nodes[nearHash];
+        float baseX = (near.flags & TOPO_NODE_ACTIVE) ? near.x : 0.0f;
+        float baseY = (near.flags & TOPO_NODE_ACTIVE) ? near.y : 0.0f;
+        n.x = baseX + (float)random(-100, 101) / 10.0f;
+        n.y = baseY + (float)random(-100, 101) / 10.0f;
+    }
+    if (now > n.lastSeen) n.lastSeen = now;
+}
+
+/**
+ * Rebuild the edge table keeping only edges seen since cutoff
+ * Open addressing has no cheap delete, so expiry rehashes survivors.
+ */
+static void rebuild(uint32_t cutoff) {
+    TopoEdge* old = (TopoEdge*)allocTable(sizeof(TopoEdge) * TOPO_EDGE_SLOTS);
+    if (!old) return;
+    memcpy(old, s_edges, sizeof(TopoEdge) * TOPO_EDGE_SLOTS);
+    memset(s_edges, 0, sizeof(TopoEdge) * TOPO_EDGE_SLOTS);
+
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        s_nodes[i].degree = 0;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < TOPO_EDGE_SLOTS; i++) {
+        const TopoEdge& e = old[i];
+        if (!(e.flags & TOPO_EDGE_ACTIVE)) continue;
+        if (e.lastSeen < cutoff) continue;
+        int slot = probeEdge(e.a, e.b);
+        if (slot < 0) break;
+        s_edges[slot] = e;
+        if (s_nodes[e.a].degree < 255) s_nodes[e.a].degree++;
+        if (s_nodes[e.b].degree < 255) s_nodes[e.b].degree++;
+        kept++;
+    }
+    free(old);
+
+    // Vertices left without edges disappear from the graph
+    s_nodeCount = 0;
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        TopoNode& n = s_nodes[i];
+        if (i == s_selfHash) {
+            n.flags |= TOPO_NODE_ACTIVE | TOPO_NODE_SELF;
+        } else if (n.degree == 0) {
+            n.flags &= ~TOPO_NODE_ACTIVE;
+        }
+        if (n.flags & TOPO_NODE_ACTIVE) s_nodeCount++;
+    }
+
+    if (kept != s_edgeCount) {
+        Serial.printf("[TOPO] Pruned %d stale edges (%d remain)\n", s_edgeCount - kept, kept);
+        s_edgeCount = kept;
+        s_version++;
+        s_dirty = true;
+    }
+}
+
+static void resetSelf() {
+    TopoNode& self = s_nodes[s_selfHash];
+    self.flags |= TOPO_NODE_ACTIVE | TOPO_NODE_SELF;
+    self.hash = s_selfHash;
+    self.x = 0.0f;
+    self.y = 0.0f;
+}
+
+static bool load() {
+    if (!Storage::fileExists(TOPO_FILE)) return false;
+
+    const size_t maxLen = sizeof(FileHeader) +
+                          sizeof(TopoNode) * TOPO_MAX_NODES +
+                          sizeof(TopoEdge) * TOPO_MAX_EDGES;
+    uint8_t* buf = (uint8_t*)allocTable(maxLen);
+    if (!buf) return false;
+
+    size_t bytesRead = 0;
+    bool ok = Storage::readFile(TOPO_FILE, buf, maxLen, &bytesRead);
+
+    FileHeader header;
+    if (ok && bytesRead >= sizeof(header)) {
+        memcpy(&header, buf, sizeof(header));
+        ok = header.magic == TOPO_MAGIC &&
+             header.version == TOPO_FILE_VERSION &&
+             header.selfHash == s_selfHash &&
+             header.nodeCount <= TOPO_MAX_NODES &&
+             header.edgeCount <= TOPO_MAX_EDGES &&
+             bytesRead >= sizeof(header) + header.nodeCount * sizeof(TopoNode) +
+                          header.edgeCount * sizeof(TopoEdge);
+    } else {
+        ok = false;
+    }
+
+    if (ok) {
+        const uint8_t* p = buf + sizeof(header);
+        for (int i = 0; i < header.nodeCount; i++, p += sizeof(TopoNode)) {
+            TopoNode n;
+            memcpy(&n, p, sizeof(n));
+            s_nodes[n.hash] = n;
+            s_nodes[n.hash].degree = 0;
+        }
+        for (int i = 0; i < header.edgeCount; i++, p += sizeof(TopoEdge)) {
+            TopoEdge e;
+            memcpy(&e, p, sizeof(e));
+            if (e.a >= e.b) continue;
+            int slot = probeEdge(e.a, e.b);
+            if (slot < 0) break;
+            s_edges[slot] = e;
+            s_nodes[e.a].degree++;
+            s_nodes[e.b].degree++;
+            s_edgeCount++;
+        }
+        Serial.printf("[TOPO] Loaded %d nodes, %d edges\n", header.nodeCount, s_edgeCount);
+    } else {
+        Serial.println("[TOPO] Ignoring invalid topology file");
+    }
+
+    free(buf);
+    return ok;
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+bool init(uint8_t selfHash) {
+    if (!s_nodes) {
+        s_nodes = (TopoNode*)allocTable(sizeof(TopoNode) * TOPO_MAX_NODES);
+        s_edges = (TopoEdge*)allocTable(sizeof(TopoEdge) * TOPO_EDGE_SLOTS);
+        if (!s_nodes || !s_edges) {
+            Serial.println("[TOPO] Out of memory allocating graph");
+            free(s_nodes);
+            free(s_edges);
+            s_nodes = nullptr;
+            s_edges = nullptr;
+            return false;
+        }
+    }
+
+    s_selfHash = selfHash;
+    load();
+    resetSelf();
+
+    s_nodeCount = 0;
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        if (s_nodes[i].flags & TOPO_NODE_ACTIVE) s_nodeCount++;
+    }
+
+    s_lastPrune = millis();
+    s_lastSave = millis();
+    s_version++;
+    return true;
+}
+
+void maintain(uint32_t now) {
+    if (!s_nodes) return;
+
+    uint32_t ms = millis();
+    if (ms - s_lastPrune >= PRUNE_INTERVAL_MS) {
+        s_lastPrune = ms;
+        if (now > TOPO_EDGE_EXPIRY_SECS) {
+            rebuild(now - TOPO_EDGE_EXPIRY_SECS);
+        }
+    }
+
+    if (s_dirty && ms - s_lastSave >= SAVE_INTERVAL_MS) {
+        s_lastSave = ms;
+        save();
+    }
+}
+
+bool save() {
+    if (!s_nodes) return false;
+
+    const size_t maxLen = sizeof(FileHeader) +
+                          sizeof(TopoNode) * TOPO_MAX_NODES +
+                          sizeof(TopoEdge) * TOPO_MAX_EDGES;
+    uint8_t* buf = (uint8_t*)allocTable(maxLen);
+    if (!buf) return false;
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = TOPO_MAGIC;
+    header.version = TOPO_FILE_VERSION;
+    header.selfHash = s_selfHash;
+
+    uint8_t* p = buf + sizeof(header);
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        if (!(s_nodes[i].flags & TOPO_NODE_ACTIVE)) continue;
+        memcpy(p, &s_nodes[i], sizeof(TopoNode));
+        p += sizeof(TopoNode);
+        header.nodeCount++;
+    }
+    for (int i = 0; i < TOPO_EDGE_SLOTS && header.edgeCount < TOPO_MAX_EDGES; i++) {
+        if (!(s_edges[i].flags & TOPO_EDGE_ACTIVE)) continue;
+        memcpy(p, &s_edges[i], sizeof(TopoEdge));
+        p += sizeof(TopoEdge);
+        header.edgeCount++;
+    }
+    memcpy(buf, &header, sizeof(header));
+
+    bool ok = Storage::writeFile(TOPO_FILE, buf, p - buf);
+    free(buf);
+
+    if (ok) {
+        s_dirty = false;
+        Serial.printf("[TOPO] Saved %d nodes, %d edges\n", header.nodeCount, header.edgeCount);
+    } else {
+        Serial.println("[TOPO] Failed to save topology");
+    }
+    return ok;
+}
+
+void clear() {
+    if (!s_nodes) return;
+    memset(s_nodes, 0, sizeof(TopoNode) * TOPO_MAX_NODES);
+    memset(s_edges, 0, sizeof(TopoEdge) * TOPO_EDGE_SLOTS);
+    s_edgeCount = 0;
+    s_nodeCount = 1;
+    resetSelf();
+    s_version++;
+    s_dirty = true;
+}
+
+// =============================================================================
+// OBSERVATIONS
+// =============================================================================
+
+void observeChain(const uint8_t* hops, uint8_t count, float lastSnr, bool measured, uint32_t now) {
+    if (!s_nodes || !hops || count < 2) return;
+
+    for (uint8_t i = 0; i + 1 < count; i++) {
+        uint8_t from = hops[i];
+        uint8_t to = hops[i + 1];
+        if (from == to) continue;   // Hash collision or repeated hop
+
+        uint8_t a = from < to ? from : to;
+        uint8_t b = from < to ? to : from;
+        int slot = probeEdge(a, b);
+        if (slot < 0) continue;
+
+        TopoEdge& e = s_edges[slot];
+        if (!(e.flags & TOPO_EDGE_ACTIVE)) {
+            if (s_edgeCount >= TOPO_MAX_EDGES) {
+                // Full until the next prune; keep refreshing known edges
+                if (s_droppedEdges++ == 0) {
+                    Serial.println("[TOPO] Edge table full, dropping new edges");
+                }
+                continue;
+            }
+            memset(&e, 0, sizeof(e));
+            e.a = a;
+            e.b = b;
+            e.flags = TOPO_EDGE_ACTIVE;
+            e.etx = TOPO_ETX_UNKNOWN;
+            activateNode(from, to, now);
+            activateNode(to, from, now);
+            if (s_nodes[a].degree < 255) s_nodes[a].degree++;
+            if (s_nodes[b].degree < 255) s_nodes[b].degree++;
+            s_edgeCount++;
+            s_version++;
+        } else {
+            activateNode(from, to, now);
+            activateNode(to, from, now);
+        }
+
+        if (e.observations < 0xFFFF) e.observations++;
+        if (now > e.lastSeen) e.lastSeen = now;
+
+        bool lastLink = (i + 2 == count);
+        if (lastLink && measured) {
+            if (e.flags & TOPO_EDGE_MEASURED) {
+                e.snr += SNR_EWMA_ALPHA * (lastSnr - e.snr);
+            } else {
+                e.snr = lastSnr;
+                e.flags |= TOPO_EDGE_MEASURED;
+            }
+            e.etx = etxFromSnr(e.snr);
+        } else if (!(e.flags & TOPO_EDGE_MEASURED)) {
+            e.etx = etxFromObservations(e.observations);
+        }
+    }
+
+    s_dirty = true;
+}
+
+void observeNode(uint8_t hash, uint32_t id, const char* name, uint8_t type, uint32_t now) {
+    if (!s_nodes) return;
+
+    TopoNode& n = s_nodes[hash];
+    n.hash = hash;
+    n.id = id;
+    n.type = type;
+    if (name) {
+        strncpy(n.name, name, sizeof(n.name) - 1);
+        n.name[sizeof(n.name) - 1] = '\0';
+    }
+    n.flags |= TOPO_NODE_NAMED;
+    if (now > n.lastSeen) n.lastSeen = now;
+    s_dirty = true;
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+uint8_t getSelfHash() {
+    return s_selfHash;
+}
+
+int getNodeCount() {
+    return s_nodeCount;
+}
+
+int getEdgeCount() {
+    return s_edgeCount;
+}
+
+uint32_t getVersion() {
+    return s_version;
+}
+
+const TopoNode* getNode(uint8_t hash) {
+    if (!s_nodes) return nullptr;
+    return &s_nodes[hash];
+}
+
+const TopoEdge* getEdgeSlot(int slot) {
+    if (!s_edges || slot < 0 || slot >= TOPO_EDGE_SLOTS) return nullptr;
+    if (!(s_edges[slot].flags & TOPO_EDGE_ACTIVE)) return nullptr;
+    return &s_edges[slot];
+}
+
+const TopoEdge* findEdge(uint8_t a, uint8_t b) {
+    if (!s_edges || a == b) return nullptr;
+    if (a > b) {
+        uint8_t t = a;
+        a = b;
+        b = t;
+    }
+    int slot = probeEdge(a, b);
+    if (slot < 0 || !(s_edges[slot].flags & TOPO_EDGE_ACTIVE)) return nullptr;
+    return &s_edges[slot];
+}
+
+// =============================================================================
+// LAYOUT
+// =============================================================================
+
+float layoutStep(int iterations) {
+    if (!s_nodes) return 0.0f;
+
+    // Reheat whenever the graph changes shape
+    if (s_layoutVersion != s_version) {
+        s_layoutVersion = s_version;
+        s_layoutTemp = LAYOUT_TEMP_START;
+    }
+
+    // Collect active vertices once per call
+    uint8_t active[TOPO_MAX_NODES];
+    int count = 0;
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        if (s_nodes[i].flags & TOPO_NODE_ACTIVE) active[count++] = (uint8_t)i;
+    }
+
+    const float k2 = LAYOUT_K * LAYOUT_K;
+    float energy = 0.0f;
+
+    for (int iter = 0; iter < iterations; iter++) {
+        if (s_layoutTemp < LAYOUT_TEMP_MIN) return 0.0f;
+
+        for (int i = 0; i < count; i++) {
+            s_dispX[active[i]] = 0.0f;
+            s_dispY[active[i]] = 0.0f;
+        }
+
+        // Repulsion between every pair of vertices (Fruchterman-Reingold)
+        for (int i = 0; i < count; i++) {
+            TopoNode& u = s_nodes[active[i]];
+            for (int j = i + 1; j < count; j++) {
+                TopoNode& v = s_nodes[active[j]];
+                float dx = u.x - v.x;
+                float dy = u.y - v.y;
+                float d2 = dx * dx + dy * dy;
+                if (d2 < 0.01f) {
+                    dx = 0.1f * (float)((i + j) % 3 - 1) + 0.05f;
+                    dy = 0.1f;
+                    d2 = dx * dx + dy * dy;
+                }
+                float f = k2 / d2;      // (k^2 / d) applied to unit vector (dx/d)
+                s_dispX[u.hash] += dx * f;
+                s_dispY[u.hash] += dy * f;
+                s_dispX[v.hash] -= dx * f;
+                s_dispY[v.hash] -= dy * f;
+            }
+        }
+
+        // Attraction along edges; lossy links are drawn longer
+        for (int s = 0; s < TOPO_EDGE_SLOTS; s++) {
+            const TopoEdge& e = s_edges[s];
+            if (!(e.flags & TOPO_EDGE_ACTIVE)) continue;
+            TopoNode& u = s_nodes[e.a];
+            TopoNode& v = s_nodes[e.b];
+            float dx = u.x - v.x;
+            float dy = u.y - v.y;
+            float d = sqrtf(dx * dx + dy * dy);
+            if (d < 0.01f) continue;
+            float ideal = LAYOUT_K * sqrtf(e.etx);
+            float f = d * d / ideal;            // d^2 / k
+            s_dispX[e.a] -= dx / d * f;
+            s_dispY[e.a] -= dy / d * f;
+            s_dispX[e.b] += dx / d * f;
+            s_dispY[e.b] += dy / d * f;
+        }
+
+        // Apply displacement limited by temperature; self stays pinned
+        energy = 0.0f;
+        for (int i = 0; i < count; i++) {
+            uint8_t h = active[i];
+            if (h == s_selfHash) continue;
+            float dx = s_dispX[h];
+            float dy = s_dispY[h];
+            float d = sqrtf(dx * dx + dy * dy);
+            if (d < 0.001f) continue;
+            float step = (d < s_layoutTemp) ? d : s_layoutTemp;
+            s_nodes[h].x += dx / d * step;
+            s_nodes[h].y += dy / d * step;
+            energy += step;
+        }
+
+        s_layoutTemp *= LAYOUT_COOLING;
+    }
+
+    return energy;
+}
+
+void getLayoutBounds(float& minX, float& minY, float& maxX, float& maxY) {
+    minX = minY = -LAYOUT_K;
+    maxX = maxY = LAYOUT_K;
+    if (!s_nodes) return;
+
+    for (int i = 0; i < TOPO_MAX_NODES; i++) {
+        const TopoNode& n = s_nodes[i];
+        if (!(n.flags & TOPO_NODE_ACTIVE)) continue;
+        if (n.x < minX) minX = n.x;
+        if (n.y < minY) minY = n.y;
+        if (n.x > maxX) maxX = n.x;
+        if (n.y > maxY) maxY = n.y;
+    }
+}
+
+} // namespace Topology
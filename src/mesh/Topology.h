@@ -0,0 +1,167 @@
+/**
+ * MeshBerry Mesh Topology Service
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Passively builds a graph of node adjacencies from overheard flood
+ * paths, adverts and path returns. Vertices are the 1-byte path hashes
+ * MeshCore puts in packet paths, so the graph has at most 256 vertices
+ * and nodes whose hashes collide share one vertex.
+ *
+ * Edge quality:
+ *   - The last hop of every packet we receive is measured (SNR), and
+ *     its ETX is derived from that SNR.
+ *   - Edges further away are only known to exist; their ETX starts
+ *     pessimistic and improves as the link keeps being overheard.
+ *
+ * The tables live in PSRAM and are saved to storage periodically.
+ */
+
+#ifndef MESHBERRY_TOPOLOGY_H
+#define MESHBERRY_TOPOLOGY_H
+
+#include <Arduino.h>
+
+namespace Topology {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr int      TOPO_MAX_NODES      = 256;          // One per path hash value
+constexpr int      TOPO_EDGE_SLOTS     = 1024;         // Open-addressed, power of two
+constexpr int      TOPO_MAX_EDGES      = 768;          // Keep load factor <= 75%
+constexpr uint32_t TOPO_EDGE_EXPIRY_SECS = 24 * 60 * 60;
+constexpr float    TOPO_ETX_UNKNOWN    = 2.0f;         // First sighting of an unmeasured edge
+constexpr float    TOPO_ETX_MAX        = 10.0f;
+
+// Node flags
+constexpr uint8_t  TOPO_NODE_ACTIVE    = 0x01;
+constexpr uint8_t  TOPO_NODE_SELF      = 0x02;
+constexpr uint8_t  TOPO_NODE_NAMED     = 0x04;         // Name/id known from an advert
+
+// Edge flags
+constexpr uint8_t  TOPO_EDGE_ACTIVE    = 0x01;
+constexpr uint8_t  TOPO_EDGE_MEASURED  = 0x02;         // SNR measured by us
+
+/**
+ * Graph vertex (indexed by path hash)
+ */
+struct TopoNode {
+    uint32_t id;            // Full node ID when known (0 = hash only)
+    char name[16];          // Advertised name (truncated)
+    uint32_t lastSeen;      // RTC epoch seconds
+    uint8_t type;           // NodeType from advert
+    uint8_t flags;          // TOPO_NODE_*
+    uint8_t degree;         // Active edge count (maintained on insert/prune)
+    uint8_t hash;           // Vertex hash (index into node table)
+    float x, y;             // Layout position (world units, self at origin)
+};
+
+/**
+ * Undirected graph edge (a < b)
+ */
+struct TopoEdge {
+    uint8_t a, b;           // Vertex hashes
+    uint8_t flags;          // TOPO_EDGE_*
+    uint8_t reserved;
+    uint16_t observations;  // Times overheard (saturating)
+    float snr;              // EWMA SNR (dB), valid if TOPO_EDGE_MEASURED
+    float etx;              // Expected transmission count estimate
+    uint32_t lastSeen;      // RTC epoch seconds
+};
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+/**
+ * Allocate tables (PSRAM when available) and load persisted graph
+ * @param selfHash Our own path hash
+ */
+bool init(uint8_t selfHash);
+
+/**
+ * Periodic maintenance: ages out stale edges and persists when dirty
+ * @param now RTC epoch seconds
+ */
+void maintain(uint32_t now);
+
+/**
+ * Save graph to storage
+ */
+bool save();
+
+/**
+ * Remove all nodes and edges (keeps self)
+ */
+void clear();
+
+// =============================================================================
+// OBSERVATIONS
+// =============================================================================
+
+/**
+ * Record a chain of adjacent vertices (e.g. flood path + self)
+ * @param hops Vertex hashes in path order
+ * @param count Number of hops
+ * @param lastSnr SNR measured on the final link (only used if measured)
+ * @param measured True if the final link ends at us and lastSnr is valid
+ * @param now RTC epoch seconds
+ */
+void observeChain(const uint8_t* hops, uint8_t count, float lastSnr, bool measured, uint32_t now);
+
+/**
+ * Record identity details for a vertex (from an advert)
+ */
+void observeNode(uint8_t hash, uint32_t id, const char* name, uint8_t type, uint32_t now);
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+uint8_t getSelfHash();
+int getNodeCount();
+int getEdgeCount();
+
+/**
+ * Monotonic counter bumped on every structural change (edge added/removed)
+ * Consumers (layout, route planner) compare it to detect changes.
+ */
+uint32_t getVersion();
+
+const TopoNode* getNode(uint8_t hash);
+
+/**
+ * Edge access by slot (0..TOPO_EDGE_SLOTS-1); returns nullptr for empty slots
+ */
+const TopoEdge* getEdgeSlot(int slot);
+
+/**
+ * Find edge between two vertices
+ */
+const TopoEdge* findEdge(uint8_t a, uint8_t b);
+
+// =============================================================================
+// LAYOUT
+// =============================================================================
+
+/**
+ * Run incremental force-directed layout iterations
+ * Self is pinned at the origin. Cheap enough to call from a screen update.
+ * @param iterations Number of iterations to run
+ * @return Remaining layout energy (0 when settled)
+ */
+float layoutStep(int iterations);
+
+/**
+ * Get bounding box of laid-out active nodes
+ */
+void getLayoutBounds(float& minX, float& minY, float& maxX, float& maxY);
+
+} // namespace Topology
+
+#endif // MESHBERRY_TOPOLOGY_H
@@ -0,0 +1,135 @@
+/**
+ * MeshBerry Mesh Traceroute
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Report types for traceroute/ping over MeshCore TRACE packets.
+ *
+ * A TRACE packet carries its route in the payload and every repeater on
+ * it appends the SNR it received the packet at. Probes are sent out and
+ * back along a path prefix (A, B, A for depth 2), so the final copy is
+ * heard by us and the round trip is timed locally. Probing each depth in
+ * turn, like an IP traceroute, gives per-link latency and loss from the
+ * differences between successive depths. The round trip to depth k adds
+ * the link into hop k in both directions: out after hop k-1's retransmit
+ * delay, back after hop k's. A slow repeater therefore raises the links on
+ * both sides of it.
+ *
+ * Probe transport and scheduling live in MeshBerryMesh.
+ */
+
+#ifndef MESHBERRY_TRACE_ROUTE_H
+#define MESHBERRY_TRACE_ROUTE_H
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace TraceRoute {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr int      TRACE_MAX_HOPS          = 8;      // Repeaters on the traced path
+constexpr int      TRACE_MAX_PROBE_PATH    = TRACE_MAX_HOPS * 2 - 1;
+constexpr uint8_t  TRACE_MAX_PROBES        = 10;     // Probes per depth
+constexpr uint32_t TRACE_TIMEOUT_BASE_MS   = 3000;   // Probe timeout = base + per link
+constexpr uint32_t TRACE_TIMEOUT_LINK_MS   = 1000;   // At least this per link...
+constexpr uint32_t TRACE_TIMEOUT_AIRTIMES  = 3;      // ...or this many probe airtimes
+constexpr uint32_t TRACE_PROBE_GAP_MS      = 500;    // Pause between probes
+
+/**
+ * Statistics for one depth of the trace (probes to hop N and back)
+ */
+struct HopStats {
+    uint8_t hash;           // Path hash of the hop
+    uint8_t sent;
+    uint8_t received;
+    float snrSum;           // SNR the hop stamped for the link into it
+    uint32_t rttSumMs;
+    uint32_t rttMinMs;
+    uint32_t rttMaxMs;
+
+    /**
+     * Record a probe that came back after rttMs
+     */
+    void addReply(uint32_t rttMs) {
+        received++;
+        rttSumMs += rttMs;
+        if (received == 1 || rttMs < rttMinMs) rttMinMs = rttMs;
+        if (rttMs > rttMaxMs) rttMaxMs = rttMs;
+    }
+
+    float avgRttMs() const { return received ? (float)rttSumMs / received : 0.0f; }
+    float avgSnr() const { return received ? snrSum / received : 0.0f; }
+    uint8_t lossPercent() const { return sent ? (uint8_t)(100 * (sent - received) / sent) : 0; }
+};
+
+/**
+ * Trace or ping session state and results
+ */
+struct Report {
+    uint8_t path[TRACE_MAX_HOPS];   // Repeaters to trace, nearest first
+    uint8_t hopCount;
+    HopStats hops[TRACE_MAX_HOPS];  // Per depth (ping only fills the last)
+    uint8_t probesPerHop;
+    uint8_t currentDepth;           // 1-based depth being probed
+    uint8_t currentProbe;
+    bool pingOnly;                  // Only probe the full path
+    bool running;
+    bool complete;
+
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    /**
+     * One-way latency of the link into hop i, averaged over both directions
+     * (difference between depths / 2)
+     */
+    float hopLatencyMs(int i) const {
+        if (i < 0 || i >= hopCount || !hops[i].received) return 0.0f;
+        float prev = 0.0f;
+        if (i > 0) {
+            if (!hops[i - 1].received) return 0.0f;
+            prev = hops[i - 1].avgRttMs();
+        }
+        float delta = (hops[i].avgRttMs() - prev) / 2.0f;
+        return delta > 0.0f ? delta : 0.0f;
+    }
+};
+
+/**
+ * Build the out-and-back probe path for a depth
+ * path[0..depth-1] followed by path[depth-2..0]
+ * @return Probe path length (2 * depth - 1), or 0 if depth is invalid
+ */
+inline uint8_t buildProbePath(const uint8_t* path, uint8_t depth, uint8_t* out) {
+    if (!path || !out || depth == 0 || depth > TRACE_MAX_HOPS) return 0;
+    uint8_t len = 0;
+    for (uint8_t i = 0; i < depth; i++) out[len++] = path[i];
+    for (int i = depth - 2; i >= 0; i--) out[len++] = path[i];
+    return len;
+}
+
+/**
+ * Time to wait for a probe
+ * Each repeater holds a direct packet for up to 1.5 airtimes before
+ * sending it, so at slow radio settings a link takes well over
+ * TRACE_TIMEOUT_LINK_MS.
+ * @param probeLen Probe path length (repeaters visited)
+ * @param airtimeMs Estimated airtime of the probe at its largest
+ */
+inline uint32_t probeTimeoutMs(uint8_t probeLen, uint32_t airtimeMs) {
+    uint32_t perLink = TRACE_TIMEOUT_AIRTIMES * airtimeMs;
+    if (perLink < TRACE_TIMEOUT_LINK_MS) perLink = TRACE_TIMEOUT_LINK_MS;
+    // probeLen repeaters plus the final link back to us
+    return TRACE_TIMEOUT_BASE_MS + perLink * (probeLen + 1);
+}
+
+} // namespace TraceRoute
+
+#endif // MESHBERRY_TRACE_ROUTE_H
@@ -119,6 +119,14 @@ int ChannelSettings::findChannel(const char* name) const {
     return -1;
 }
 
+bool ChannelSettings::isPrivate(int idx) const {
+    if (idx <= 0 || idx >= numChannels) return false;
+    const ChannelEntry& ch = channels[idx];
+    if (!ch.isActive || ch.isHashtag) return false;
+    return ch.secretLen != channels[0].secretLen ||
+           memcmp(ch.secret, channels[0].secret, ch.secretLen) != 0;
+}
+
 bool ChannelSettings::isValid() const {
     if (magic != CHANNEL_MAGIC) return false;
     if (numChannels > MAX_CHANNELS) return false;
@@ -32,6 +32,7 @@ struct ChannelEntry {
     uint8_t hash;            // 1-byte channel hash for packet matching
     bool isHashtag;          // True if key was derived from name
     bool isActive;           // Channel is in use
+    bool isMuted;            // No tone or toast for new messages
 
     void clear() {
         memset(name, 0, sizeof(name));
@@ -40,6 +41,7 @@ struct ChannelEntry {
         hash = 0;
         isHashtag = false;
         isActive = false;
+        isMuted = false;
     }
 };
 
@@ -88,6 +90,13 @@ struct ChannelSettings {
      */
     int findChannel(const char* name) const;
 
+    /**
+     * Whether only holders of a shared key can read a channel
+     * (not Public, not a #hashtag derived from its name, not the Public key)
+     * @param idx Channel index
+     */
+    bool isPrivate(int idx) const;
+
     /**
      * Validate settings
      * @return true if valid
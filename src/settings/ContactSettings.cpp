@@ -10,6 +10,14 @@
 #include "ContactSettings.h"
 #include <string.h>
 
+// Public key present (adverts without one leave it all zeros)
+static bool isKeySet(const uint8_t* pubKey) {
+    for (int i = 0; i < 32; i++) {
+        if (pubKey[i] != 0) return true;
+    }
+    return false;
+}
+
 int ContactSettings::addOrUpdateContact(const NodeInfo& node) {
     // First, check if contact already exists
     int existingIdx = findContact(node.id);
@@ -24,45 +32,26 @@ int ContactSettings::addOrUpdateContact(const NodeInfo& node) {
         contact.lastSnr = node.snr;
         contact.lastHeard = node.lastHeard;
         // Keep: favorite status, pubKey, savedPassword (preserved automatically)
+        touchContact(existingIdx);
         return existingIdx;
     }
 
-    // Add new contact
+    // Take the next free entry, or replace the least recently used
+    // non-favorite once full
+    int idx = numContacts;
     if (numContacts >= MAX_CONTACTS) {
-        // Find oldest non-favorite contact to replace
-        int oldestIdx = -1;
-        uint32_t oldestTime = UINT32_MAX;
-
-        for (int i = 0; i < MAX_CONTACTS; i++) {
-            if (!contacts[i].isFavorite && contacts[i].lastHeard < oldestTime) {
-                oldestTime = contacts[i].lastHeard;
-                oldestIdx = i;
-            }
-        }
-
-        if (oldestIdx < 0) {
+        idx = recency.oldest();
+        if (idx < 0) {
             // All contacts are favorites, can't add
             return -1;
         }
-
-        // Replace oldest contact
-        ContactEntry& contact = contacts[oldestIdx];
-        contact.id = node.id;
-        strncpy(contact.name, node.name, sizeof(contact.name) - 1);
-        contact.name[sizeof(contact.name) - 1] = '\0';
-        contact.type = node.type;
-        contact.lastRssi = node.rssi;
-        contact.lastSnr = node.snr;
-        contact.lastHeard = node.lastHeard;
-        contact.isFavorite = false;
-        contact.isActive = true;
-        memset(contact.pubKey, 0, sizeof(contact.pubKey));  // Clear old pubKey
-        contact.savedPassword[0] = '\0';  // Clear old password
-        return oldestIdx;
+        Serial.printf("[CONTACT] List full, replacing %s\n", contacts[idx].name);
+    } else {
+        numContacts++;
     }
 
-    // Add to end
-    ContactEntry& contact = contacts[numContacts];
+    ContactEntry& contact = contacts[idx];
+    contact.clear();  // Drops the old pubKey, password and routing
     contact.id = node.id;
     strncpy(contact.name, node.name, sizeof(contact.name) - 1);
     contact.name[sizeof(contact.name) - 1] = '\0';
@@ -70,69 +59,89 @@ int ContactSettings::addOrUpdateContact(const NodeInfo& node) {
     contact.lastRssi = node.rssi;
     contact.lastSnr = node.snr;
     contact.lastHeard = node.lastHeard;
-    contact.isFavorite = false;
     contact.isActive = true;
-    memset(contact.pubKey, 0, sizeof(contact.pubKey));  // Initialize pubKey to zeros
-    contact.savedPassword[0] = '\0';  // Initialize password to empty
-
-    return numContacts++;
+    recency.touch(idx);
+    return idx;
 }
 
 int ContactSettings::addOrUpdateContact(const NodeInfo& node, const uint8_t* pubKey) {
-    // First, try to find existing contact by pubKey (most reliable for repeaters)
-    // This prevents duplicates when the same device sends adverts with varying IDs
-    int existingIdx = -1;
-    if (pubKey != nullptr) {
-        existingIdx = findContactByPubKey(pubKey);
-        if (existingIdx >= 0) {
-            // Found by pubKey - update existing contact and fix ID if different
-            ContactEntry& contact = contacts[existingIdx];
-            if (contact.id != node.id) {
-                Serial.printf("[CONTACT] Fixing ID mismatch for %s: was %08X, now %08X\n",
-                              contact.name, contact.id, node.id);
-                contact.id = node.id;  // Update to latest ID
-            }
-            // Update contact info
-            strncpy(contact.name, node.name, sizeof(contact.name) - 1);
-            contact.name[sizeof(contact.name) - 1] = '\0';
-            contact.type = node.type;
-            contact.lastRssi = node.rssi;
-            contact.lastSnr = node.snr;
-            contact.lastHeard = node.lastHeard;
-            Serial.printf("[CONTACT] Updated existing contact by pubKey: %s (idx=%d)\n",
-                          contact.name, existingIdx);
-            return existingIdx;
-        }
+    // Existing contact (by pubKey, then ID)?
+    int idx = updateContact(node, pubKey);
+    if (idx >= 0) return idx;
+
+    idx = addOrUpdateContact(node);
+    if (idx >= 0 && pubKey != nullptr && isKeySet(pubKey)) {
+        memcpy(contacts[idx].pubKey, pubKey, 32);
+        Serial.printf("[CONTACT] Added %s (idx=%d), pubKey %02X%02X%02X%02X...\n",
+                      contacts[idx].name, idx, pubKey[0], pubKey[1], pubKey[2], pubKey[3]);
     }
+    return idx;
+}
 
-    // Not found by pubKey, use normal ID-based lookup
-    int idx = addOrUpdateContact(node);
-    if (idx >= 0 && pubKey != nullptr) {
-        // Debug: log incoming pubKey
-        Serial.print("[CONTACT] Incoming pubKey: ");
-        for (int i = 0; i < 8; i++) Serial.printf("%02X", pubKey[i]);
-        Serial.println("...");
-
-        // Only update pubKey if it's non-zero (valid key from advertisement)
-        bool hasValidKey = false;
-        for (int i = 0; i < 32; i++) {
-            if (pubKey[i] != 0) {
-                hasValidKey = true;
-                break;
-            }
-        }
-        if (hasValidKey) {
-            memcpy(contacts[idx].pubKey, pubKey, 32);
+int ContactSettings::updateContact(const NodeInfo& node, const uint8_t* pubKey, bool* changed) {
+    if (changed) *changed = false;
 
-            // Debug: verify what was stored
-            Serial.print("[CONTACT] Stored pubKey: ");
-            for (int i = 0; i < 8; i++) Serial.printf("%02X", contacts[idx].pubKey[i]);
-            Serial.printf("... at idx=%d\n", idx);
-        }
+    // Try the public key first (most reliable for repeaters); this
+    // prevents duplicates when the same device sends adverts with varying IDs
+    bool keyValid = pubKey != nullptr && isKeySet(pubKey);
+    int idx = keyValid ? findContactByPubKey(pubKey) : -1;
+    if (idx < 0) idx = findContact(node.id);
+    if (idx < 0) return -1;
+
+    ContactEntry& contact = contacts[idx];
+    bool dirty = false;
+    if (contact.id != node.id) {
+        Serial.printf("[CONTACT] Fixing ID mismatch for %s: was %08X, now %08X\n",
+                      contact.name, contact.id, node.id);
+        contact.id = node.id;  // Update to latest ID
+        dirty = true;
     }
+    if (keyValid && memcmp(contact.pubKey, pubKey, 32) != 0) {
+        memcpy(contact.pubKey, pubKey, 32);
+        dirty = true;
+    }
+    if (contact.type != node.type ||
+        strncmp(contact.name, node.name, sizeof(contact.name) - 1) != 0) {
+        strncpy(contact.name, node.name, sizeof(contact.name) - 1);
+        contact.name[sizeof(contact.name) - 1] = '\0';
+        contact.type = node.type;
+        dirty = true;
+    }
+
+    // Link stats change on every advert; they are not worth a flash write
+    contact.lastRssi = node.rssi;
+    contact.lastSnr = node.snr;
+    contact.lastHeard = node.lastHeard;
+    touchContact(idx);
+
+    if (changed) *changed = dirty;
     return idx;
 }
 
+void ContactSettings::touchContact(int idx) {
+    if (idx < 0 || idx >= numContacts || !contacts[idx].isActive) return;
+    if (contacts[idx].isFavorite) return;  // Favorites are never replaced
+    recency.touch(idx);
+}
+
+void ContactSettings::rebuildRecency() {
+    recency.clear();
+
+    // Insert oldest first so the most recently heard ends up newest
+    bool placed[MAX_CONTACTS] = {};
+    for (;;) {
+        int next = -1;
+        for (int i = 0; i < numContacts; i++) {
+            const ContactEntry& c = contacts[i];
+            if (placed[i] || !c.isActive || c.isFavorite) continue;
+            if (next < 0 || c.lastHeard < contacts[next].lastHeard) next = i;
+        }
+        if (next < 0) break;
+        placed[next] = true;
+        recency.touch(next);
+    }
+}
+
 bool ContactSettings::savePassword(int idx, const char* password) {
     if (idx < 0 || idx >= numContacts || !contacts[idx].isActive) {
         return false;
@@ -168,6 +177,8 @@ bool ContactSettings::removeContact(int idx) {
     contacts[numContacts - 1].clear();
     numContacts--;
 
+    // Indices above idx moved down
+    rebuildRecency();
     return true;
 }
 
@@ -181,17 +192,7 @@ int ContactSettings::findContact(uint32_t id) const {
 }
 
 int ContactSettings::findContactByPubKey(const uint8_t* pubKey) const {
-    if (!pubKey) return -1;
-
-    // Check if pubKey is all zeros (invalid)
-    bool hasValidKey = false;
-    for (int i = 0; i < 32; i++) {
-        if (pubKey[i] != 0) {
-            hasValidKey = true;
-            break;
-        }
-    }
-    if (!hasValidKey) return -1;
+    if (!pubKey || !isKeySet(pubKey)) return -1;
 
     // Search for matching public key
     for (int i = 0; i < numContacts; i++) {
@@ -259,5 +260,10 @@ bool ContactSettings::toggleFavorite(int idx) {
         return false;
     }
     contacts[idx].isFavorite = !contacts[idx].isFavorite;
+    if (contacts[idx].isFavorite) {
+        recency.remove(idx);
+    } else {
+        recency.touch(idx);
+    }
     return true;
 }
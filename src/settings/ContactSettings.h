@@ -6,8 +6,11 @@
  *
  * This file is part of MeshBerry.
  *
- * Persistent storage for discovered contacts/nodes.
- * Separates repeaters from regular chat nodes.
+ * Persistent contact list: the small tier above the mesh peer table.
+ * Every advertising node lands in the peer table (PSRAM, LRU); a node
+ * becomes a contact only when the admission rules allow it (user action,
+ * DM activity, or the optional advert rules below). Separates repeaters
+ * from regular chat nodes.
  */
 
 #ifndef MESHBERRY_CONTACT_SETTINGS_H
@@ -15,6 +18,18 @@
 
 #include <Arduino.h>
 #include "../mesh/MeshBerryMesh.h"
+#include "../util/LruList.h"
+
+// =============================================================================
+// ADMISSION RULES
+// =============================================================================
+
+// Which events add a node to the contact list (DeviceSettings::contactAdmit)
+// Choosing a node in the Contacts screen and sending it a DM always do.
+constexpr uint8_t CONTACT_ADMIT_DM_RX     = 0x01;   // It sends us a DM
+constexpr uint8_t CONTACT_ADMIT_REPEATERS = 0x02;   // Any repeater advert
+constexpr uint8_t CONTACT_ADMIT_ADVERTS   = 0x04;   // Any advert (pre-tiering behaviour)
+constexpr uint8_t CONTACT_ADMIT_DEFAULT   = CONTACT_ADMIT_DM_RX;
 
 // =============================================================================
 // DM ROUTING MODE
@@ -43,10 +58,7 @@ struct ContactEntry {
     uint8_t pubKey[32];     // Full public key (for repeater login)
     char savedPassword[16]; // Saved admin password (empty = not saved)
 
-    // Routing info - learned paths for direct routing
-    uint8_t outPath[64];    // Learned path to this contact (max 64 hops)
-    int8_t outPathLen;      // -1 = unknown, 0+ = valid path length
-    uint32_t pathLearnedAt; // millis() when path was learned
+    // Learned routes live in the mesh peer table (MeshBerryMesh::getPathLen)
 
     // DM routing preferences
     DMRoutingMode routingMode;  // How to route DMs to this contact
@@ -64,10 +76,6 @@ struct ContactEntry {
         isActive = false;
         memset(pubKey, 0, sizeof(pubKey));
         savedPassword[0] = '\0';
-        // Clear routing info
-        memset(outPath, 0, sizeof(outPath));
-        outPathLen = -1;  // Unknown path
-        pathLearnedAt = 0;
         // Clear DM routing preferences
         routingMode = DM_ROUTE_AUTO;
         memset(manualPath, 0, sizeof(manualPath));
@@ -91,6 +99,10 @@ struct ContactSettings {
     int numContacts;
     uint32_t magic;
 
+    // Non-favorite contacts, most recently heard or used first (not
+    // persisted). The oldest is the one a new contact replaces when full.
+    LruList<MAX_CONTACTS> recency;
+
     // Initialize with empty contact list
     void setDefaults() {
         for (int i = 0; i < MAX_CONTACTS; i++) {
@@ -98,14 +110,28 @@ struct ContactSettings {
         }
         numContacts = 0;
         magic = CONTACT_MAGIC;
+        recency.clear();
     }
 
     // Add or update contact from NodeInfo
+    // When full, replaces the least recently used non-favorite (O(1))
     int addOrUpdateContact(const NodeInfo& node);
 
     // Add or update contact with public key
     int addOrUpdateContact(const NodeInfo& node, const uint8_t* pubKey);
 
+    // Refresh an existing contact from an advert; never adds one
+    // @param changed Set to true if a persisted field other than the
+    //        link stats changed (name, type, id) (may be nullptr)
+    // @return Contact index, or -1 if the node is not a contact
+    int updateContact(const NodeInfo& node, const uint8_t* pubKey, bool* changed = nullptr);
+
+    // Mark a contact most recently used (heard, messaged)
+    void touchContact(int idx);
+
+    // Rebuild the recency order from lastHeard (after load or removal)
+    void rebuildRecency();
+
     // Save password for a contact
     bool savePassword(int idx, const char* password);
 
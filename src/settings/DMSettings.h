@@ -14,6 +14,7 @@
 
 #include <Arduino.h>
 #include "../config.h"
+#include "../util/RingBuffer.h"
 
 // =============================================================================
 // DM DELIVERY STATUS
@@ -56,22 +57,19 @@ struct DMConversation {
     static constexpr int MAX_MESSAGES_PER_CONV = 32;
 
     uint32_t contactId;
-    DMMessage messages[MAX_MESSAGES_PER_CONV];
-    int messageCount;
-    int messageHead;        // Circular buffer head
+    RingBuffer<DMMessage, MAX_MESSAGES_PER_CONV> messages;  // Same layout as the old array + count + head
     uint32_t lastTimestamp;
     int unreadCount;
     bool isActive;
 
     void clear() {
         contactId = 0;
-        messageCount = 0;
-        messageHead = 0;
+        messages.clear();
         lastTimestamp = 0;
         unreadCount = 0;
         isActive = false;
         for (int i = 0; i < MAX_MESSAGES_PER_CONV; i++) {
-            messages[i].clear();
+            messages.storage()[i].clear();
         }
     }
 
@@ -80,26 +78,20 @@ struct DMConversation {
     void addMessage(const char* text, bool outgoing, uint32_t timestamp, uint32_t ack_crc = 0) {
         if (!text) return;
 
-        // Add to circular buffer
-        int idx = messageHead;
-        messages[idx].timestamp = timestamp;
-        strncpy(messages[idx].text, text, MAX_MESSAGE_LENGTH - 1);
-        messages[idx].text[MAX_MESSAGE_LENGTH - 1] = '\0';
-        messages[idx].isOutgoing = outgoing;
-        messages[idx].delivered = !outgoing;  // Incoming are delivered, outgoing need ACK
-        messages[idx].ack_crc = ack_crc;
+        // Add to circular buffer (overwrites the oldest when full)
+        DMMessage& msg = messages.pushSlot();
+        msg.timestamp = timestamp;
+        strncpy(msg.text, text, MAX_MESSAGE_LENGTH - 1);
+        msg.text[MAX_MESSAGE_LENGTH - 1] = '\0';
+        msg.isOutgoing = outgoing;
+        msg.delivered = !outgoing;  // Incoming are delivered, outgoing need ACK
+        msg.ack_crc = ack_crc;
 
         // Set initial status
         if (outgoing) {
-            messages[idx].status = DM_STATUS_SENDING;
+            msg.status = DM_STATUS_SENDING;
         } else {
-            messages[idx].status = DM_STATUS_DELIVERED;  // Incoming = delivered to us
-        }
-
-        // Advance head
-        messageHead = (messageHead + 1) % MAX_MESSAGES_PER_CONV;
-        if (messageCount < MAX_MESSAGES_PER_CONV) {
-            messageCount++;
+            msg.status = DM_STATUS_DELIVERED;  // Incoming = delivered to us
         }
 
         // Update metadata
@@ -109,27 +101,24 @@ struct DMConversation {
         }
     }
 
+    // Number of messages held (at most MAX_MESSAGES_PER_CONV)
+    int messageCount() const { return (int)messages.size(); }
+
     // Get message by index (0 = oldest in buffer)
     const DMMessage* getMessage(int index) const {
-        if (index < 0 || index >= messageCount) return nullptr;
-
-        // Calculate actual array index accounting for circular buffer
-        int start = (messageHead - messageCount + MAX_MESSAGES_PER_CONV) % MAX_MESSAGES_PER_CONV;
-        int actualIdx = (start + index) % MAX_MESSAGES_PER_CONV;
-        return &messages[actualIdx];
+        if (index < 0 || index >= messageCount()) return nullptr;
+        return &messages[index];
     }
 
     // Get mutable message by index (for updating delivery status)
     DMMessage* getMessageMutable(int index) {
-        if (index < 0 || index >= messageCount) return nullptr;
-        int start = (messageHead - messageCount + MAX_MESSAGES_PER_CONV) % MAX_MESSAGES_PER_CONV;
-        int actualIdx = (start + index) % MAX_MESSAGES_PER_CONV;
-        return &messages[actualIdx];
+        if (index < 0 || index >= messageCount()) return nullptr;
+        return &messages[index];
     }
 
     // Update delivery status by ACK CRC
     bool updateDeliveryStatus(uint32_t ack_crc, DMDeliveryStatus newStatus) {
-        for (int i = 0; i < messageCount; i++) {
+        for (int i = 0; i < messageCount(); i++) {
             DMMessage* msg = getMessageMutable(i);
             if (msg && msg->isOutgoing && msg->ack_crc == ack_crc) {
                 msg->status = newStatus;
@@ -146,6 +135,12 @@ struct DMConversation {
     }
 };
 
+// dms.bin is read back as raw bytes: the ring must keep the layout of the
+// messages[32] / messageCount / messageHead fields it replaced
+static_assert(sizeof(RingBuffer<DMMessage, DMConversation::MAX_MESSAGES_PER_CONV>) ==
+              sizeof(DMMessage) * DMConversation::MAX_MESSAGES_PER_CONV + 2 * sizeof(int),
+              "DMConversation message ring layout changed");
+
 // =============================================================================
 // DM SETTINGS
 // =============================================================================
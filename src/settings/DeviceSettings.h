@@ -13,6 +13,7 @@
 #define MESHBERRY_DEVICE_SETTINGS_H
 
 #include <Arduino.h>
+#include "../mesh/PositionBeacon.h"
 
 /**
  * Alert tone options
@@ -76,7 +77,22 @@ struct DeviceSettings {
     AlertTone toneSent = TONE_CHIRP;            // Message sent confirmation
     AlertTone toneError = TONE_DESCENDING;      // Error occurred
 
-    uint8_t reserved[4] = {0};          // Future expansion (reduced from 8)
+    // Mesh settings
+    bool historySyncEnabled = false;    // Reconcile missed channel messages with neighbours (opt-in)
+    bool posShareEnabled = false;       // Send position beacons (opt-in, needs GPS)
+    uint8_t posShareChannel = 0;        // Private channel the beacons go to (0 = none chosen)
+    uint16_t posShareThresholdM = PositionBeacon::POS_THRESHOLD_DEFAULT_M;  // Dead-reckoning error before a new report
+    bool fwdLimitEnabled = true;        // Per-source token buckets on relayed floods
+    uint8_t fwdRateAdvert = 2;          // Relays per source per minute, 0 = unlimited
+    uint8_t fwdRateChannel = 30;        // Per channel
+    uint8_t fwdRatePeer = 12;
+    uint8_t fwdRateOther = 30;
+    uint16_t chanCoalesceMs = 0;        // Merge channel lines sent within this window (0 = off)
+    uint8_t contactAdmit = 0x01;        // CONTACT_ADMIT_* rules (default: DMs received)
+    uint8_t reactForm = 1;              // Channel reactions: 1 = compact (one block), 0 = text (all clients)
+    bool chanResend = false;            // Resend channel packets nobody was heard relaying
+
+    uint8_t reserved[1] = {0};          // Future expansion (reduced from 8)
 
     void setDefaults() {
         magic = DEVICE_MAGIC;
@@ -98,6 +114,21 @@ struct DeviceSettings {
         toneSent = TONE_CHIRP;
         toneError = TONE_DESCENDING;
 
+        // Mesh defaults
+        historySyncEnabled = false;
+        posShareEnabled = false;
+        posShareChannel = 0;
+        posShareThresholdM = PositionBeacon::POS_THRESHOLD_DEFAULT_M;
+        fwdLimitEnabled = true;
+        fwdRateAdvert = 2;
+        fwdRateChannel = 30;
+        fwdRatePeer = 12;
+        fwdRateOther = 30;
+        chanCoalesceMs = 0;
+        contactAdmit = 0x01;
+        reactForm = 1;
+        chanResend = false;
+
         memset(reserved, 0, sizeof(reserved));
     }
 
@@ -11,7 +11,6 @@
 #include "../drivers/storage.h"
 #include <string.h>
 #include <SD.h>
-#include <SPIFFS.h>
 
 // Path templates
 static const char* CHANNEL_PATH_FMT = "/channels/ch%d.bin";
@@ -20,12 +19,12 @@ static const char* DM_PATH_FMT = "/dms/dm_%08X.bin";
 // Buffer for path building
 static char pathBuffer[48];
 
-// Helper to get the appropriate filesystem (SD or SPIFFS)
+// Helper to get the appropriate filesystem (SD or internal flash)
 static fs::FS& getFS() {
     if (Storage::isSDAvailable()) {
         return SD;
     }
-    return SPIFFS;
+    return FLASH_FS;
 }
 
 // Helper to build full path with appropriate prefix
@@ -38,7 +37,7 @@ static const char* buildFullPath(const char* path, char* buffer, size_t bufferSi
             snprintf(buffer, bufferSize, "/meshberry/%s", path);
         }
     } else {
-        // SPIFFS: use path as-is but ensure it starts with /
+        // Flash: use path as-is but ensure it starts with /
         if (path[0] == '/') {
             snprintf(buffer, bufferSize, "%s", path);
         } else {
@@ -119,119 +118,261 @@ static bool createArchive(const char* path) {
     return writeHeader(path, header);
 }
 
+// =========================================================================
+// GROUP COMMIT
+// =========================================================================
+//
+// Appends are queued in RAM and committed per file as a batch: records
+// are written at the slot after the committed count, flushed, then the
+// header count is rewritten once and flushed. A few archives are kept
+// open (LRU) so a busy conversation is not reopened per message.
+//
+// Crash safety: a queued message is lost if the device resets before its
+// commit (up to ARCHIVE_COMMIT_DELAY_MS, or until the next read/sleep).
+// A reset mid-commit leaves records past the header count; they are
+// ignored on load and overwritten by the next commit, so the archive is
+// never left inconsistent - the batch is simply not there.
+
+struct OpenArchive {
+    char path[32];              // Relative path (key)
+    File file;
+    ArchiveHeader header;       // Committed header
+    uint32_t lastUsed;          // millis()
+    bool used;
+};
+
+struct PendingAppend {
+    char path[32];
+    ArchivedMessage msg;
+};
+
+static OpenArchive s_open[ARCHIVE_OPEN_FILES];
+static PendingAppend s_pending[ARCHIVE_PENDING_MAX];
+static int s_pendingCount = 0;
+static uint32_t s_pendingSince = 0;
+static ArchiveStats s_stats;
+
+static void closeArchive(OpenArchive& a) {
+    if (!a.used) return;
+    a.file.close();
+    a.used = false;
+}
+
+static OpenArchive* findOpen(const char* path) {
+    for (int i = 0; i < ARCHIVE_OPEN_FILES; i++) {
+        if (s_open[i].used && strcmp(s_open[i].path, path) == 0) return &s_open[i];
+    }
+    return nullptr;
+}
+
+static void closePath(const char* path) {
+    OpenArchive* a = findOpen(path);
+    if (a) closeArchive(*a);
+}
+
 /**
- * Append a message to an archive file, handling rotation if needed
- * OPTIMIZED: Uses seek operations to avoid heap allocations
+ * Get an open handle for an archive, creating the file if needed
+ * Evicts the least recently used handle when all are in use.
  */
-static bool appendMessage(const char* path, const ArchivedMessage& msg) {
+static OpenArchive* openArchive(const char* path) {
+    OpenArchive* a = findOpen(path);
+    if (a) {
+        a->lastUsed = millis();
+        return a;
+    }
+
+    for (int i = 0; i < ARCHIVE_OPEN_FILES; i++) {
+        if (!s_open[i].used) { a = &s_open[i]; break; }
+        if (!a || (int32_t)(s_open[i].lastUsed - a->lastUsed) < 0) a = &s_open[i];
+    }
+    closeArchive(*a);
+
     char fullPath[256];
     buildFullPath(path, fullPath, sizeof(fullPath));
 
-    ArchiveHeader header;
-
-    // Check if file exists and read header
     File file = getFS().open(fullPath, "r+");  // Read-write mode
     if (!file) {
         // File doesn't exist, create new archive
         if (!createArchive(path)) {
             Serial.printf("[ARCHIVE] Failed to create %s\n", path);
-            return false;
+            return nullptr;
         }
-        // Open newly created file
         file = getFS().open(fullPath, "r+");
         if (!file) {
-            return false;
-        }
-        header.magic = ARCHIVE_MAGIC;
-        header.version = ARCHIVE_VERSION;
-        header.messageCount = 0;
-        header.reserved = 0;
-    } else {
-        // Read existing header
-        file.read((uint8_t*)&header, sizeof(ArchiveHeader));
-
-        if (header.magic != ARCHIVE_MAGIC) {
-            file.close();
-            Serial.printf("[ARCHIVE] Invalid header in %s\n", path);
-            return false;
+            return nullptr;
         }
     }
 
-    // Check if we need to rotate (remove oldest messages)
-    if (header.messageCount >= MAX_ARCHIVED_MESSAGES) {
-        file.close();  // Close before rotation
+    if (file.read((uint8_t*)&a->header, sizeof(ArchiveHeader)) != sizeof(ArchiveHeader) ||
+        a->header.magic != ARCHIVE_MAGIC) {
+        file.close();
+        Serial.printf("[ARCHIVE] Invalid header in %s\n", path);
+        return nullptr;
+    }
 
-        // Rotation still needs heap allocation, but happens much less frequently (every 100 messages)
-        // TODO: Optimize rotation in future if needed
-        ArchivedMessage* buffer = new ArchivedMessage[MAX_ARCHIVED_MESSAGES];
-        if (!buffer) {
-            Serial.println("[ARCHIVE] Out of memory for rotation");
-            return false;
-        }
+    strncpy(a->path, path, sizeof(a->path) - 1);
+    a->path[sizeof(a->path) - 1] = '\0';
+    a->file = file;
+    a->lastUsed = millis();
+    a->used = true;
+    s_stats.opens++;
+    return a;
+}
 
-        // Reopen and read messages
-        file = getFS().open(fullPath, "r");
-        if (!file) {
-            delete[] buffer;
-            return false;
-        }
+/**
+ * Drop the oldest messages so `incoming` more fit
+ * Rotation still needs heap allocation, but happens rarely (every ~10 messages past 100)
+ */
+static bool rotateArchive(OpenArchive& a, int incoming) {
+    char path[32];
+    strcpy(path, a.path);
+    uint32_t count = a.header.messageCount;
+    closeArchive(a);
 
-        file.seek(sizeof(ArchiveHeader));  // Skip header
-        size_t messagesRead = file.read((uint8_t*)buffer, header.messageCount * sizeof(ArchivedMessage));
-        file.close();
+    char fullPath[256];
+    buildFullPath(path, fullPath, sizeof(fullPath));
 
-        if (messagesRead != header.messageCount * sizeof(ArchivedMessage)) {
-            delete[] buffer;
-            Serial.println("[ARCHIVE] Failed to read messages for rotation");
-            return false;
-        }
+    ArchivedMessage* buffer = new ArchivedMessage[MAX_ARCHIVED_MESSAGES];
+    if (!buffer) {
+        Serial.println("[ARCHIVE] Out of memory for rotation");
+        return false;
+    }
 
-        // Keep last (MAX_ARCHIVED_MESSAGES - 10) messages to make room
-        int keepCount = MAX_ARCHIVED_MESSAGES - 10;
-        int skipCount = header.messageCount - keepCount;
+    File file = getFS().open(fullPath, "r");
+    if (!file) {
+        delete[] buffer;
+        return false;
+    }
+    if (count > MAX_ARCHIVED_MESSAGES) count = MAX_ARCHIVED_MESSAGES;
+    file.seek(sizeof(ArchiveHeader));  // Skip header
+    size_t messagesRead = file.read((uint8_t*)buffer, count * sizeof(ArchivedMessage));
+    file.close();
 
-        // Rewrite file with rotated messages
-        header.messageCount = keepCount;
-        header.reserved = 0;
+    if (messagesRead != count * sizeof(ArchivedMessage)) {
+        delete[] buffer;
+        Serial.println("[ARCHIVE] Failed to read messages for rotation");
+        return false;
+    }
 
-        file = getFS().open(fullPath, "w");  // Overwrite mode
-        if (!file) {
-            delete[] buffer;
-            return false;
-        }
+    // Keep the newest, leaving at least 10 free slots after this batch
+    int keepCount = MAX_ARCHIVED_MESSAGES - 10 - incoming;
+    if (keepCount > (int)count) keepCount = count;
+    if (keepCount < 0) keepCount = 0;
+    int skipCount = count - keepCount;
 
-        // Write header
-        file.write((uint8_t*)&header, sizeof(ArchiveHeader));
-        // Write kept messages
-        file.write((uint8_t*)&buffer[skipCount], keepCount * sizeof(ArchivedMessage));
-        file.close();
+    ArchiveHeader header;
+    header.magic = ARCHIVE_MAGIC;
+    header.version = ARCHIVE_VERSION;
+    header.messageCount = keepCount;
+    header.reserved = 0;
 
+    file = getFS().open(fullPath, "w");  // Overwrite mode
+    if (!file) {
         delete[] buffer;
+        return false;
+    }
+    file.write((uint8_t*)&header, sizeof(ArchiveHeader));
+    file.write((uint8_t*)&buffer[skipCount], keepCount * sizeof(ArchivedMessage));
+    file.close();
 
-        // Reopen for appending new message
-        file = getFS().open(fullPath, "r+");
-        if (!file) {
-            return false;
+    delete[] buffer;
+    s_stats.rotations++;
+    return true;
+}
+
+/**
+ * Commit every queued message for one archive in a single batch
+ */
+static bool commitPath(const char* pathIn) {
+    char path[32];
+    strncpy(path, pathIn, sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+
+    int incoming = 0;
+    for (int i = 0; i < s_pendingCount; i++) {
+        if (strcmp(s_pending[i].path, path) == 0) incoming++;
+    }
+    if (incoming == 0) return true;
+
+    bool ok = false;
+    OpenArchive* a = openArchive(path);
+    if (a && a->header.messageCount + incoming > MAX_ARCHIVED_MESSAGES) {
+        a = rotateArchive(*a, incoming) ? openArchive(path) : nullptr;
+    }
+
+    if (a) {
+        // Write after the committed records; anything beyond them is an
+        // interrupted earlier batch and is overwritten
+        a->file.seek(sizeof(ArchiveHeader) + a->header.messageCount * sizeof(ArchivedMessage), SeekSet);
+
+        ok = true;
+        for (int i = 0; i < s_pendingCount && ok; i++) {
+            if (strcmp(s_pending[i].path, path) != 0) continue;
+            ok = a->file.write((uint8_t*)&s_pending[i].msg, sizeof(ArchivedMessage)) == sizeof(ArchivedMessage);
+            s_stats.recordWrites++;
+        }
+        a->file.flush();
+
+        // Records first, then the count that makes them visible
+        if (ok) {
+            a->header.messageCount += incoming;
+            a->file.seek(0, SeekSet);
+            a->file.write((uint8_t*)&a->header, sizeof(ArchiveHeader));
+            a->file.flush();
+            s_stats.headerWrites++;
+            s_stats.commits++;
+        } else {
+            Serial.printf("[ARCHIVE] Failed to append to %s\n", path);
+            Storage::reportSDError();
+            closeArchive(*a);
         }
-        file.read((uint8_t*)&header, sizeof(ArchiveHeader));
     }
 
-    // Append new message to end of file
-    file.seek(0, SeekEnd);
-    size_t written = file.write((uint8_t*)&msg, sizeof(ArchivedMessage));
+    // Drop this file's entries whether or not they were written
+    int w = 0;
+    for (int i = 0; i < s_pendingCount; i++) {
+        if (strcmp(s_pending[i].path, path) == 0) continue;
+        if (w != i) s_pending[w] = s_pending[i];
+        w++;
+    }
+    s_pendingCount = w;
+    if (!ok) s_stats.dropped += incoming;
+    return ok;
+}
 
-    if (written != sizeof(ArchivedMessage)) {
-        file.close();
-        Serial.printf("[ARCHIVE] Failed to append to %s\n", path);
-        return false;
+static void commitAll() {
+    while (s_pendingCount > 0) {
+        commitPath(s_pending[0].path);
     }
+}
 
-    // Update header count (in-place, NO heap allocation)
-    header.messageCount++;
-    file.seek(0, SeekSet);  // Go to start of file
-    file.write((uint8_t*)&header, sizeof(ArchiveHeader));
+static int pendingFor(const char* path) {
+    int n = 0;
+    for (int i = 0; i < s_pendingCount; i++) {
+        if (strcmp(s_pending[i].path, path) == 0) n++;
+    }
+    return n;
+}
 
-    file.close();
+/**
+ * Queue a message for the next group commit
+ */
+static bool appendMessage(const char* path, const ArchivedMessage& msg) {
+    if (strlen(path) >= sizeof(s_pending[0].path)) {
+        return false;
+    }
+    if (s_pendingCount >= ARCHIVE_PENDING_MAX) {
+        Storage::SDLock lock;
+        commitAll();
+    }
+    if (s_pendingCount == 0) {
+        s_pendingSince = millis();
+    }
+
+    PendingAppend& p = s_pending[s_pendingCount++];
+    strcpy(p.path, path);
+    p.msg = msg;
+    s_stats.appends++;
     return true;
 }
 
@@ -241,6 +382,12 @@ static bool appendMessage(const char* path, const ArchivedMessage& msg) {
  * @return Number of messages loaded
  */
 static int loadMessages(const char* path, ArchivedMessage* buffer, int maxCount) {
+    Storage::SDLock lock;
+
+    // Readers see queued messages, through a fresh handle
+    commitPath(path);
+    closePath(path);
+
     char fullPath[256];
     buildFullPath(path, fullPath, sizeof(fullPath));
 
@@ -296,17 +443,37 @@ static int loadMessages(const char* path, ArchivedMessage* buffer, int maxCount)
  * Get message count from archive
  */
 static int getMessageCount(const char* path) {
+    // Count queued messages too, without forcing a commit
+    int count = pendingFor(path);
+    OpenArchive* a = findOpen(path);
+    if (a) {
+        return a->header.messageCount + count;
+    }
+
+    Storage::SDLock lock;
     ArchiveHeader header;
-    if (!readHeader(path, header)) {
-        return 0;
+    if (readHeader(path, header)) {
+        count += header.messageCount;
     }
-    return header.messageCount;
+    return count;
 }
 
 /**
  * Clear archive file
  */
 static bool clearArchive(const char* path) {
+    // Queued messages go with the file
+    int w = 0;
+    for (int i = 0; i < s_pendingCount; i++) {
+        if (strcmp(s_pending[i].path, path) == 0) continue;
+        if (w != i) s_pending[w] = s_pending[i];
+        w++;
+    }
+    s_pendingCount = w;
+
+    Storage::SDLock lock;
+    closePath(path);
+
     if (!Storage::fileExists(path)) {
         return true;  // Nothing to clear
     }
@@ -398,6 +565,8 @@ int getTotalMessageCount() {
 
 size_t getStorageUsed() {
     size_t total = 0;
+    Storage::SDLock lock;
+    commitAll();
 
     // Sum up channel file sizes
     for (int i = 0; i < 8; i++) {
@@ -413,4 +582,40 @@ size_t getStorageUsed() {
     return total;
 }
 
+// =========================================================================
+// COMMIT CONTROL
+// =========================================================================
+
+void maintain() {
+    uint32_t now = millis();
+    if (s_pendingCount > 0 && now - s_pendingSince >= ARCHIVE_COMMIT_DELAY_MS) {
+        Storage::SDLock lock;
+        commitAll();
+    }
+
+    // Don't hold handles on a quiet archive
+    for (int i = 0; i < ARCHIVE_OPEN_FILES; i++) {
+        if (s_open[i].used && now - s_open[i].lastUsed >= ARCHIVE_IDLE_CLOSE_MS) {
+            Storage::SDLock lock;
+            closeArchive(s_open[i]);
+        }
+    }
+}
+
+void flush() {
+    Storage::SDLock lock;
+    commitAll();
+    for (int i = 0; i < ARCHIVE_OPEN_FILES; i++) {
+        closeArchive(s_open[i]);
+    }
+}
+
+int getPendingCount() {
+    return s_pendingCount;
+}
+
+const ArchiveStats& getStats() {
+    return s_stats;
+}
+
 } // namespace MessageArchive
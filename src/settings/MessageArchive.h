@@ -5,6 +5,12 @@
  * Copyright (C) 2026 NodakMesh (nodakmesh.org)
  *
  * Persistent storage for channel and DM messages.
+ *
+ * Saves are queued and committed per file in batches (one header update
+ * per batch) through a small cache of open files. A queued message is
+ * lost if the device resets before the batch is committed; committed
+ * messages are never damaged by an interrupted commit. See
+ * MessageArchive.cpp for details.
  */
 
 #ifndef MESHBERRY_MESSAGE_ARCHIVE_H
@@ -19,6 +25,12 @@
 #define ARCHIVE_SENDER_LEN      16
 #define ARCHIVE_TEXT_LEN        200
 
+// Group commit
+#define ARCHIVE_OPEN_FILES      3           // Archives kept open (LRU)
+#define ARCHIVE_PENDING_MAX     16          // Queued saves before a forced commit
+#define ARCHIVE_COMMIT_DELAY_MS 2000        // Max time a save stays queued
+#define ARCHIVE_IDLE_CLOSE_MS   30000       // Close handles unused this long
+
 /**
  * Archived message structure
  * Fixed size for easy binary storage
@@ -53,6 +65,19 @@ struct ArchiveHeader {
 
 // Size: 16 bytes
 
+/**
+ * Group commit counters
+ */
+struct ArchiveStats {
+    uint32_t appends;           // Messages saved
+    uint32_t commits;           // Batches committed
+    uint32_t recordWrites;      // Records written
+    uint32_t headerWrites;      // Header updates
+    uint32_t opens;             // Files opened
+    uint32_t rotations;         // Files trimmed to make room
+    uint32_t dropped;           // Queued messages lost to a failed write
+};
+
 namespace MessageArchive {
 
 /**
@@ -136,6 +161,29 @@ int getTotalMessageCount();
  */
 size_t getStorageUsed();
 
+// =========================================================================
+// COMMIT CONTROL
+// =========================================================================
+
+/**
+ * Commit queued saves older than ARCHIVE_COMMIT_DELAY_MS and close idle
+ * files. Call from the main loop.
+ */
+void maintain();
+
+/**
+ * Commit all queued saves and close every file
+ * Call before sleep, power-off or removing the SD card.
+ */
+void flush();
+
+/**
+ * Number of saves waiting to be committed
+ */
+int getPendingCount();
+
+const ArchiveStats& getStats();
+
 } // namespace MessageArchive
 
 #endif // MESHBERRY_MESSAGE_ARCHIVE_H
@@ -9,7 +9,7 @@
 
 #include "SettingsManager.h"
 #include "../crypto/ChannelCrypto.h"
-#include <SPIFFS.h>
+#include "../drivers/storage.h"
 #include <ArduinoJson.h>
 
 // Settings file paths
@@ -83,12 +83,12 @@ bool init() {
 }
 
 bool load() {
-    if (!SPIFFS.exists(SETTINGS_FILE)) {
+    if (!FLASH_FS.exists(SETTINGS_FILE)) {
         Serial.println("[SETTINGS] Settings file not found");
         return false;
     }
 
-    File file = SPIFFS.open(SETTINGS_FILE, "r");
+    File file = FLASH_FS.open(SETTINGS_FILE, "r");
     if (!file) {
         Serial.println("[SETTINGS] Failed to open settings file");
         return false;
@@ -136,7 +136,7 @@ bool load() {
 }
 
 bool save() {
-    File file = SPIFFS.open(SETTINGS_FILE, "w");
+    File file = FLASH_FS.open(SETTINGS_FILE, "w");
     if (!file) {
         Serial.println("[SETTINGS] Failed to create settings file");
         return false;
@@ -169,12 +169,12 @@ bool save() {
 }
 
 static bool loadChannels() {
-    if (!SPIFFS.exists(CHANNELS_FILE)) {
+    if (!FLASH_FS.exists(CHANNELS_FILE)) {
         Serial.println("[SETTINGS] Channels file not found");
         return false;
     }
 
-    File file = SPIFFS.open(CHANNELS_FILE, "r");
+    File file = FLASH_FS.open(CHANNELS_FILE, "r");
     if (!file) {
         Serial.println("[SETTINGS] Failed to open channels file");
         return false;
@@ -211,6 +211,7 @@ static bool loadChannels() {
         entry.hash = ch["hash"] | 0;
         entry.isHashtag = ch["isHashtag"] | false;
         entry.isActive = ch["isActive"] | false;
+        entry.isMuted = ch["isMuted"] | false;
 
         // Decode base64 secret
         const char* secretB64 = ch["secret"] | "";
@@ -251,7 +252,7 @@ static bool loadChannels() {
 }
 
 static bool saveChannels() {
-    File file = SPIFFS.open(CHANNELS_FILE, "w");
+    File file = FLASH_FS.open(CHANNELS_FILE, "w");
     if (!file) {
         Serial.println("[SETTINGS] Failed to create channels file");
         return false;
@@ -272,6 +273,7 @@ static bool saveChannels() {
         ch["hash"] = entry.hash;
         ch["isHashtag"] = entry.isHashtag;
         ch["isActive"] = entry.isActive;
+        ch["isMuted"] = entry.isMuted;
 
         // Encode secret as base64
         char secretB64[64];
@@ -334,14 +336,14 @@ static bool loadContacts() {
     Serial.println("[SETTINGS] >>> loadContacts() entry");
     Serial.flush();
 
-    if (!SPIFFS.exists(CONTACTS_FILE)) {
+    if (!FLASH_FS.exists(CONTACTS_FILE)) {
         Serial.println("[SETTINGS] Contacts file not found");
         return false;
     }
 
     Serial.println("[SETTINGS] Contacts file exists, opening...");
 
-    File file = SPIFFS.open(CONTACTS_FILE, "r");
+    File file = FLASH_FS.open(CONTACTS_FILE, "r");
     if (!file) {
         Serial.println("[SETTINGS] Failed to open contacts file");
         return false;
@@ -415,6 +417,7 @@ static bool loadContacts() {
         return false;
     }
 
+    contactSettings.rebuildRecency();
     Serial.printf("[SETTINGS] Loaded %d contacts\n", contactSettings.numContacts);
     return true;
 }
@@ -429,7 +432,7 @@ static bool saveContactsInternal() {
                       i, e.name, e.pubKey[0], e.pubKey[1], e.pubKey[2], e.pubKey[3]);
     }
 
-    File file = SPIFFS.open(CONTACTS_FILE, "w");
+    File file = FLASH_FS.open(CONTACTS_FILE, "w");
     if (!file) {
         Serial.println("[SETTINGS] Failed to create contacts file");
         return false;
@@ -479,8 +482,8 @@ static bool saveContactsInternal() {
     Serial.printf("[SETTINGS] Contacts saved (%d bytes written)\n", bytesWritten);
 
     // Verify file was written correctly
-    if (SPIFFS.exists(CONTACTS_FILE)) {
-        File verify = SPIFFS.open(CONTACTS_FILE, "r");
+    if (FLASH_FS.exists(CONTACTS_FILE)) {
+        File verify = FLASH_FS.open(CONTACTS_FILE, "r");
         if (verify) {
             Serial.printf("[SETTINGS] Verified: contacts.json size=%d bytes\n", verify.size());
             verify.close();
@@ -542,12 +545,12 @@ void setTxPower(uint8_t dbm) {
 // =============================================================================
 
 static bool loadDMs() {
-    if (!SPIFFS.exists(DMS_FILE)) {
+    if (!FLASH_FS.exists(DMS_FILE)) {
         Serial.println("[SETTINGS] DMs file not found");
         return false;
     }
 
-    File file = SPIFFS.open(DMS_FILE, "r");
+    File file = FLASH_FS.open(DMS_FILE, "r");
     if (!file) {
         Serial.println("[SETTINGS] Failed to open DMs file");
         return false;
@@ -582,7 +585,7 @@ static bool loadDMs() {
 }
 
 static bool saveDMsInternal() {
-    File file = SPIFFS.open(DMS_FILE, "w");
+    File file = FLASH_FS.open(DMS_FILE, "w");
     if (!file) {
         Serial.println("[SETTINGS] Failed to create DMs file");
         return false;
@@ -605,12 +608,12 @@ static bool saveDMsInternal() {
 // =============================================================================
 
 static bool loadDevice() {
-    if (!SPIFFS.exists(DEVICE_FILE)) {
+    if (!FLASH_FS.exists(DEVICE_FILE)) {
         Serial.println("[SETTINGS] Device file not found");
         return false;
     }
 
-    File file = SPIFFS.open(DEVICE_FILE, "r");
+    File file = FLASH_FS.open(DEVICE_FILE, "r");
     if (!file) {
         Serial.println("[SETTINGS] Failed to open device file");
         return false;
@@ -657,6 +660,21 @@ static bool loadDevice() {
     deviceSettings.toneSent = (AlertTone)(doc["toneSent"] | (uint8_t)TONE_CHIRP);
     deviceSettings.toneError = (AlertTone)(doc["toneError"] | (uint8_t)TONE_DESCENDING);
 
+    // Mesh settings
+    deviceSettings.historySyncEnabled = doc["historySyncEnabled"] | false;
+    deviceSettings.posShareEnabled = doc["posShareEnabled"] | false;
+    deviceSettings.posShareChannel = doc["posShareChannel"] | 0;
+    deviceSettings.posShareThresholdM = doc["posShareThresholdM"] | PositionBeacon::POS_THRESHOLD_DEFAULT_M;
+    deviceSettings.fwdLimitEnabled = doc["fwdLimitEnabled"] | true;
+    deviceSettings.fwdRateAdvert = doc["fwdRateAdvert"] | 2;
+    deviceSettings.fwdRateChannel = doc["fwdRateChannel"] | 30;
+    deviceSettings.fwdRatePeer = doc["fwdRatePeer"] | 12;
+    deviceSettings.fwdRateOther = doc["fwdRateOther"] | 30;
+    deviceSettings.chanCoalesceMs = doc["chanCoalesceMs"] | 0;
+    deviceSettings.contactAdmit = doc["contactAdmit"] | CONTACT_ADMIT_DEFAULT;
+    deviceSettings.reactForm = doc["reactForm"] | 1;
+    deviceSettings.chanResend = doc["chanResend"] | false;
+
     Serial.printf("[SETTINGS] Device settings loaded: gpsEnabled=%d, gpsRtcSync=%d, deepSleep=%d, vol=%d\n",
                   deviceSettings.gpsEnabled, deviceSettings.gpsRtcSyncEnabled,
                   deviceSettings.useDeepSleep, deviceSettings.audioVolume);
@@ -664,7 +682,7 @@ static bool loadDevice() {
 }
 
 static bool saveDeviceInternal() {
-    File file = SPIFFS.open(DEVICE_FILE, "w");
+    File file = FLASH_FS.open(DEVICE_FILE, "w");
     if (!file) {
         Serial.println("[SETTINGS] Failed to create device file");
         return false;
@@ -697,6 +715,21 @@ static bool saveDeviceInternal() {
     doc["toneSent"] = (uint8_t)deviceSettings.toneSent;
     doc["toneError"] = (uint8_t)deviceSettings.toneError;
 
+    // Mesh settings
+    doc["historySyncEnabled"] = deviceSettings.historySyncEnabled;
+    doc["posShareEnabled"] = deviceSettings.posShareEnabled;
+    doc["posShareChannel"] = deviceSettings.posShareChannel;
+    doc["posShareThresholdM"] = deviceSettings.posShareThresholdM;
+    doc["fwdLimitEnabled"] = deviceSettings.fwdLimitEnabled;
+    doc["fwdRateAdvert"] = deviceSettings.fwdRateAdvert;
+    doc["fwdRateChannel"] = deviceSettings.fwdRateChannel;
+    doc["fwdRatePeer"] = deviceSettings.fwdRatePeer;
+    doc["fwdRateOther"] = deviceSettings.fwdRateOther;
+    doc["chanCoalesceMs"] = deviceSettings.chanCoalesceMs;
+    doc["contactAdmit"] = deviceSettings.contactAdmit;
+    doc["reactForm"] = deviceSettings.reactForm;
+    doc["chanResend"] = deviceSettings.chanResend;
+
     if (serializeJson(doc, file) == 0) {
         Serial.println("[SETTINGS] Failed to write device settings");
         file.close();
@@ -713,12 +746,12 @@ static bool saveDeviceInternal() {
 // =============================================================================
 
 bool loadIdentity(mesh::LocalIdentity& identity) {
-    if (!SPIFFS.exists(IDENTITY_FILE)) {
+    if (!FLASH_FS.exists(IDENTITY_FILE)) {
         Serial.println("[SETTINGS] Identity file not found");
         return false;
     }
 
-    File file = SPIFFS.open(IDENTITY_FILE, "r");
+    File file = FLASH_FS.open(IDENTITY_FILE, "r");
     if (!file) {
         Serial.println("[SETTINGS] Failed to open identity file");
         return false;
@@ -741,12 +774,12 @@ bool loadIdentity(mesh::LocalIdentity& identity) {
     }
 
     identity.readFrom(buffer, 96);
-    Serial.println("[SETTINGS] Identity loaded from SPIFFS");
+    Serial.println("[SETTINGS] Identity loaded from flash");
     return true;
 }
 
 bool saveIdentity(mesh::LocalIdentity& identity) {
-    File file = SPIFFS.open(IDENTITY_FILE, "w");
+    File file = FLASH_FS.open(IDENTITY_FILE, "w");
     if (!file) {
         Serial.println("[SETTINGS] Failed to create identity file");
         return false;
@@ -763,12 +796,12 @@ bool saveIdentity(mesh::LocalIdentity& identity) {
         return false;
     }
 
-    Serial.println("[SETTINGS] Identity saved to SPIFFS");
+    Serial.println("[SETTINGS] Identity saved to flash");
     return true;
 }
 
 bool hasIdentity() {
-    return SPIFFS.exists(IDENTITY_FILE);
+    return FLASH_FS.exists(IDENTITY_FILE);
 }
 
 } // namespace SettingsManager
@@ -6,7 +6,7 @@
  *
  * This file is part of MeshBerry.
  *
- * Manages persistent storage of settings to SPIFFS.
+ * Manages persistent storage of settings to flash.
  */
 
 #ifndef MESHBERRY_SETTINGS_MANAGER_H
@@ -24,19 +24,19 @@ namespace SettingsManager {
 
 /**
  * Initialize the settings manager
- * Must be called after SPIFFS is mounted
+ * Must be called after Storage::init() has mounted flash
  * @return true if settings loaded successfully, false if using defaults
  */
 bool init();
 
 /**
- * Load settings from SPIFFS
+ * Load settings from flash
  * @return true if loaded, false if file missing or corrupt (defaults applied)
  */
 bool load();
 
 /**
- * Save current settings to SPIFFS
+ * Save current settings to flash
  * @return true if saved successfully
  */
 bool save();
@@ -72,32 +72,32 @@ DMSettings& getDMSettings();
 DeviceSettings& getDeviceSettings();
 
 /**
- * Save device settings to SPIFFS
+ * Save device settings to flash
  * Call this after modifying device settings
  */
 bool saveDeviceSettings();
 
 /**
- * Save DMs to SPIFFS
+ * Save DMs to flash
  * Call this after sending/receiving DMs
  */
 bool saveDMs();
 
 /**
- * Save contacts to SPIFFS
+ * Save contacts to flash
  * Call this after modifying contacts
  */
 bool saveContacts();
 
 /**
- * Load node identity from SPIFFS
+ * Load node identity from flash
  * @param identity Reference to LocalIdentity to populate
  * @return true if loaded successfully, false if no identity file exists
  */
 bool loadIdentity(mesh::LocalIdentity& identity);
 
 /**
- * Save node identity to SPIFFS
+ * Save node identity to flash
  * @param identity The LocalIdentity to persist
  * @return true if saved successfully
  */
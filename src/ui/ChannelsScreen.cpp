@@ -95,12 +95,12 @@ void ChannelsScreen::buildChannelList() {
             strcpy(_secondaryStrings[count], "No messages");
         }
 
-        // Build list item - all channels shown equally
+        // Build list item - muted channels get a dimmed icon
         _channelItems[count] = {
             _primaryStrings[count],
             _secondaryStrings[count],
             Icons::CHANNEL_ICON,
-            Theme::ACCENT,
+            ch.isMuted ? Theme::TEXT_DISABLED : Theme::ACCENT,
             false,  // No indicator
             Theme::ACCENT,
             (void*)(intptr_t)i  // Store original index
@@ -324,6 +324,13 @@ bool ChannelsScreen::handleListInput(const InputData& input) {
         return true;
     }
 
+    // M key: Mute/unmute notifications for the selected channel
+    if (input.event == InputEvent::KEY_PRESS &&
+        (input.keyChar == 'm' || input.keyChar == 'M')) {
+        toggleMuteSelected();
+        return true;
+    }
+
     // Let list view handle up/down
     if (_listView.handleTrackball(
             input.event == InputEvent::TRACKBALL_UP,
@@ -581,6 +588,20 @@ void ChannelsScreen::startDeleteChannel() {
     requestRedraw();
 }
 
+void ChannelsScreen::toggleMuteSelected() {
+    if (_selectedIndex < 0 || _selectedIndex >= _listView.getItemCount()) return;
+
+    ChannelSettings& channels = SettingsManager::getChannelSettings();
+    int channelIdx = (int)(intptr_t)_channelItems[_selectedIndex].userData;
+    ChannelEntry& ch = channels.channels[channelIdx];
+    ch.isMuted = !ch.isMuted;
+    SettingsManager::save();
+
+    Screens.showStatus(ch.isMuted ? "Channel muted" : "Channel unmuted", 1500);
+    buildChannelList();
+    requestRedraw();
+}
+
 void ChannelsScreen::createHashtagChannel() {
     ChannelSettings& channels = SettingsManager::getChannelSettings();
     // Add # prefix - addHashtagChannel expects the name to start with #
@@ -79,6 +79,7 @@ private:
     void openSelectedChannel();
     void startAddChannel();
     void startDeleteChannel();
+    void toggleMuteSelected();
     void createHashtagChannel();
     void createPskChannel();
     void confirmDelete();
@@ -15,6 +15,7 @@
 #include "../settings/SettingsManager.h"
 #include "../settings/MessageArchive.h"
 #include "../mesh/MeshBerryMesh.h"
+#include "../mesh/Reaction.h"
 #include <Arduino.h>
 #include <stdio.h>
 #include <string.h>
@@ -45,7 +46,14 @@ void ChatScreen::onEnter() {
     _instance = this;
 
     // Check if returning from emoji picker with a selection
-    if (emojiPickerScreen.wasEmojiSelected()) {
+    if (_reacting) {
+        // Picked (or cancelled) a reaction - conversation stays as it was
+        char emoji[32];
+        if (emojiPickerScreen.getSelectedEmoji(emoji)) {
+            sendReaction(emoji);
+        }
+        _reacting = false;
+    } else if (emojiPickerScreen.wasEmojiSelected()) {
         char emoji[32];  // Buffer for :shortcode: format
         if (emojiPickerScreen.getSelectedEmoji(emoji)) {
             // Append emoji shortcode to input buffer
@@ -60,7 +68,7 @@ void ChatScreen::onEnter() {
         _inputMode = true;
     } else {
         // Fresh entry - ALWAYS reset state (channel may have changed)
-        _messageCount = 0;
+        _messages.clear();
         _scrollOffset = 0;
         _inputBuffer[0] = '\0';
         _inputPos = 0;
@@ -71,22 +79,20 @@ void ChatScreen::onEnter() {
         if (archived) {
             int count = MessageArchive::loadChannelMessages(_channelIdx, archived, MAX_CHAT_MESSAGES);
             for (int i = 0; i < count; i++) {
-                // Add directly to array without re-saving
-                if (_messageCount < MAX_CHAT_MESSAGES) {
-                    ChatMessage& msg = _messages[_messageCount++];
-                    strncpy(msg.sender, archived[i].sender, sizeof(msg.sender) - 1);
-                    msg.sender[sizeof(msg.sender) - 1] = '\0';
-                    strncpy(msg.text, archived[i].text, sizeof(msg.text) - 1);
-                    msg.text[sizeof(msg.text) - 1] = '\0';
-                    msg.timestamp = archived[i].timestamp;
-                    msg.isOutgoing = archived[i].isOutgoing;
-                    msg.contentHash = 0;   // No hash for archived messages
-                    msg.repeatCount = 0;
-                    msg.hops = 0;          // No hop info in archive
-                }
+                // Add directly to the ring without re-saving
+                ChatMessage& msg = _messages.pushSlot();
+                strncpy(msg.sender, archived[i].sender, sizeof(msg.sender) - 1);
+                msg.sender[sizeof(msg.sender) - 1] = '\0';
+                strncpy(msg.text, archived[i].text, sizeof(msg.text) - 1);
+                msg.text[sizeof(msg.text) - 1] = '\0';
+                msg.timestamp = archived[i].timestamp;
+                msg.isOutgoing = archived[i].isOutgoing;
+                msg.contentHash = 0;   // No hash for archived messages
+                msg.repeatCount = 0;
+                msg.hops = 0;          // No hop info in archive
             }
             delete[] archived;
-            Serial.printf("[CHAT] Loaded %d messages for channel %d\n", _messageCount, _channelIdx);
+            Serial.printf("[CHAT] Loaded %d messages for channel %d\n", (int)_messages.size(), _channelIdx);
         }
     }
 
@@ -105,7 +111,8 @@ void ChatScreen::configureSoftKeys() {
     if (_inputMode) {
         SoftKeyBar::setLabels("Emoji", "Send", "Cancel");
     } else {
-        SoftKeyBar::setLabels("Type", nullptr, "Back");
+        // Same layout as DMChatScreen: React on the left, Type until there is a message
+        SoftKeyBar::setLabels(_messages.empty() ? "Type" : "React", nullptr, "Back");
     }
 }
 
@@ -137,7 +144,8 @@ void ChatScreen::drawMessages(bool fullRedraw) {
     // Clear message area
     Display::fillRect(0, msgY, Theme::SCREEN_WIDTH, msgHeight, Theme::BG_PRIMARY);
 
-    if (_messageCount == 0) {
+    _reactTarget = -1;
+    if (_messages.empty()) {
         Display::drawTextCentered(0, msgY + msgHeight / 2 - 12,
                                   Theme::SCREEN_WIDTH,
                                   "No messages yet", Theme::TEXT_SECONDARY, 1);
@@ -149,11 +157,12 @@ void ChatScreen::drawMessages(bool fullRedraw) {
 
     // Calculate visible messages - estimate ~40px per bubble average
     int estVisibleMsgs = msgHeight / 40;
-    int displayStartIdx = _messageCount - estVisibleMsgs - _scrollOffset;
+    int displayStartIdx = (int)_messages.size() - estVisibleMsgs - _scrollOffset;
     if (displayStartIdx < 0) displayStartIdx = 0;
 
     int16_t y = msgY + 4;
-    for (int i = displayStartIdx; i < _messageCount && y < maxY - 20; i++) {
+    int16_t targetY = 0, targetH = 0;
+    for (int i = displayStartIdx; i < (int)_messages.size() && y < maxY - 20; i++) {
         const ChatMessage& msg = _messages[i];
 
         // Calculate bubble dimensions
@@ -164,13 +173,14 @@ void ChatScreen::drawMessages(bool fullRedraw) {
 
         // Wrap text to fit bubble
         char wrappedLines[4][64];
-        int lineCount = Theme::wrapText(msg.text, maxBubbleWidth - bubblePadding * 2, 1, wrappedLines, 4);
+        int16_t lineWidths[4];
+        int lineCount = Theme::wrapText(msg.text, maxBubbleWidth - bubblePadding * 2, 1,
+                                        wrappedLines, 4, lineWidths);
 
         // Calculate actual text width (use longest line)
         int16_t maxLineWidth = 0;
         for (int ln = 0; ln < lineCount; ln++) {
-            int16_t lineWidth = Theme::getTextWidth(wrappedLines[ln], 1);
-            if (lineWidth > maxLineWidth) maxLineWidth = lineWidth;
+            if (lineWidths[ln] > maxLineWidth) maxLineWidth = lineWidths[ln];
         }
 
         // Bubble dimensions
@@ -211,6 +221,9 @@ void ChatScreen::drawMessages(bool fullRedraw) {
             textY += 10;
         }
 
+        _reactTarget = i;
+        targetY = y;
+        targetH = bubbleHeight;
         y += bubbleHeight + 2;
 
         // Show metadata below bubble (small, subtle)
@@ -227,9 +240,15 @@ void ChatScreen::drawMessages(bool fullRedraw) {
             y += 8;
         }
 
+        y = drawReactions(msg, y, bubbleMargin);
         y += 4;  // Gap between messages
     }
 
+    // Mark the message React applies to
+    if (_reactTarget >= 0 && !_inputMode) {
+        Display::fillRect(2, targetY + 2, 2, targetH - 4, Theme::ACCENT_PRIMARY);
+    }
+
     // Scroll indicators
     if (_scrollOffset > 0) {
         Display::drawBitmap(Theme::SCREEN_WIDTH - 12, msgY + 2,
@@ -241,6 +260,21 @@ void ChatScreen::drawMessages(bool fullRedraw) {
     }
 }
 
+int16_t ChatScreen::drawReactions(const ChatMessage& msg, int16_t y, int16_t margin) {
+    const Reaction::Badge* badge = Reaction::find(Reaction::channelScope(_channelIdx),
+                                                  Reaction::refHash(msg.sender, msg.text));
+    if (!badge) return y;
+
+    char text[48];
+    Reaction::formatBadge(*badge, text, sizeof(text));
+    int16_t x = margin;
+    if (msg.isOutgoing) {
+        x = Theme::SCREEN_WIDTH - margin - Emoji::textWidth(text, 1);
+    }
+    Display::drawTextWithEmoji(x, y, text, Theme::TEXT_SECONDARY, 1);
+    return y + 13;
+}
+
 void ChatScreen::drawInputBar() {
     int16_t inputY = Theme::SOFTKEY_BAR_Y - 28;
 
@@ -274,7 +308,7 @@ void ChatScreen::drawInputBar() {
 
         // Cursor (blinking)
         if (_inputMode && (millis() / 500) % 2 == 0) {
-            int16_t cursorX = fieldX + 6 + strlen(displayText) * 6;
+            int16_t cursorX = fieldX + 6 + Emoji::textWidth(displayText, 1);
             if (cursorX < fieldX + fieldW - 6) {
                 Display::drawVLine(cursorX, fieldY + 4, fieldH - 8, Theme::ACCENT_PRIMARY);
             }
@@ -307,12 +341,12 @@ bool ChatScreen::handleInput(const InputData& input) {
                     Screens.navigateTo(ScreenId::EMOJI_PICKER);
                 }
             } else {
-                // Normal mode: Type | (none) | Back
+                // Normal mode: React (Type if empty) | (none) | Back
                 if (tx >= 214) {
                     // Right soft key = Back
                     Screens.goBack();
-                } else if (tx < 107) {
-                    // Left soft key = Type (enter input mode)
+                } else if (tx < 107 && !startReaction()) {
+                    // Left soft key = React, or Type with nothing to react to
                     _inputMode = true;
                     configureSoftKeys();
                     SoftKeyBar::redraw();
@@ -380,6 +414,10 @@ bool ChatScreen::handleInput(const InputData& input) {
         // Normal mode
         switch (input.event) {
             case InputEvent::SOFTKEY_LEFT:
+                // React to the bottom message (scroll to pick another)
+                if (startReaction()) return true;
+                // Nothing to react to yet - same as Type
+                // fall through
             case InputEvent::TRACKBALL_CLICK:
                 // Enter input mode
                 _inputMode = true;
@@ -396,7 +434,7 @@ bool ChatScreen::handleInput(const InputData& input) {
 
             case InputEvent::TRACKBALL_UP:
                 // Scroll up
-                if (_scrollOffset < _messageCount - getVisibleMessageCount()) {
+                if (_scrollOffset < (int)_messages.size() - getVisibleMessageCount()) {
                     _scrollOffset++;
                     requestRedraw();
                 }
@@ -451,8 +489,8 @@ void ChatScreen::sendMessage() {
         addMessage(theMesh->getNodeName(), _inputBuffer, millis() / 1000, true, 0);
 
         // Store the content hash in the most recently added message
-        if (_messageCount > 0) {
-            _messages[_messageCount - 1].contentHash = contentHash;
+        if (!_messages.empty()) {
+            _messages.back().contentHash = contentHash;
         }
     }
 
@@ -469,17 +507,37 @@ void ChatScreen::clearInput() {
     _inputPos = 0;
 }
 
-void ChatScreen::addMessage(const char* sender, const char* text, uint32_t timestamp, bool isOutgoing, uint8_t hops) {
-    // Shift messages if full
-    if (_messageCount >= MAX_CHAT_MESSAGES) {
-        for (int i = 0; i < MAX_CHAT_MESSAGES - 1; i++) {
-            _messages[i] = _messages[i + 1];
-        }
-        _messageCount = MAX_CHAT_MESSAGES - 1;
+bool ChatScreen::startReaction() {
+    if (_reactTarget < 0 || _reactTarget >= (int)_messages.size()) return false;
+    const ChatMessage& msg = _messages[_reactTarget];
+    _reactRef = Reaction::refHash(msg.sender, msg.text);
+    _reacting = true;
+    Screens.navigateTo(ScreenId::EMOJI_PICKER);
+    return true;
+}
+
+void ChatScreen::sendReaction(const char* shortcode) {
+    if (!theMesh) return;
+
+    // Picker hands back ":name:"
+    char name[32];
+    strncpy(name, shortcode[0] == ':' ? shortcode + 1 : shortcode, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    char* colon = strchr(name, ':');
+    if (colon) *colon = '\0';
+
+    int emoji = Emoji::indexOf(Emoji::findByShortcode(name));
+    if (emoji < 0) return;
+
+    if (!theMesh->sendChannelReaction(_channelIdx, _reactRef, (uint16_t)emoji)) {
+        Screens.showStatus("Reaction failed", 1500);
     }
+    requestRedraw();
+}
 
-    // Add new message
-    ChatMessage& msg = _messages[_messageCount++];
+void ChatScreen::addMessage(const char* sender, const char* text, uint32_t timestamp, bool isOutgoing, uint8_t hops) {
+    // Add new message (overwrites the oldest when full)
+    ChatMessage& msg = _messages.pushSlot();
     strncpy(msg.sender, sender, sizeof(msg.sender) - 1);
     msg.sender[sizeof(msg.sender) - 1] = '\0';
     strncpy(msg.text, text, sizeof(msg.text) - 1);
@@ -490,6 +548,12 @@ void ChatScreen::addMessage(const char* sender, const char* text, uint32_t times
     msg.repeatCount = 0;
     msg.hops = hops;
 
+    // First message: React becomes available
+    if (_messages.size() == 1) {
+        configureSoftKeys();
+        SoftKeyBar::redraw();
+    }
+
     // Persist outgoing messages to archive
     // Incoming messages are saved by MessagesScreen::onChannelMessage()
     if (isOutgoing) {
@@ -548,7 +612,7 @@ void ChatScreen::updateRepeatCount(int channelIdx, uint32_t contentHash, uint8_t
     if (!_instance || _instance->_channelIdx != channelIdx) return;
 
     // Search for message with matching hash (search from newest)
-    for (int i = _instance->_messageCount - 1; i >= 0; i--) {
+    for (int i = (int)_instance->_messages.size() - 1; i >= 0; i--) {
         ChatMessage& msg = _instance->_messages[i];
         if (msg.isOutgoing && msg.contentHash == contentHash) {
             msg.repeatCount = repeatCount;
@@ -559,6 +623,12 @@ void ChatScreen::updateRepeatCount(int channelIdx, uint32_t contentHash, uint8_t
     }
 }
 
+void ChatScreen::refreshReactions(int channelIdx) {
+    if (_instance && _instance->_channelIdx == channelIdx) {
+        _instance->requestRedraw();
+    }
+}
+
 uint32_t ChatScreen::hashMessage(int channelIdx, const char* text) {
     // FNV-1a hash - must match MeshBerryMesh::hashChannelMessage()
     uint32_t hash = 0x811c9dc5;  // FNV-1a offset basis
@@ -12,6 +12,7 @@
 
 #include "Screen.h"
 #include "ScreenManager.h"
+#include "../util/RingBuffer.h"
 
 class ChatScreen : public Screen {
 public:
@@ -65,6 +66,12 @@ public:
      */
     static void updateRepeatCount(int channelIdx, uint32_t contentHash, uint8_t repeatCount);
 
+    /**
+     * Redraw reaction badges (called when a reaction arrives)
+     * @param channelIdx Channel index
+     */
+    static void refreshReactions(int channelIdx);
+
     /**
      * Parse "SenderName: message" format (public for callback use)
      */
@@ -86,9 +93,11 @@ private:
         uint8_t hops;            // Hop count (incoming only, 0 = unknown)
         bool isOutgoing;
     };
-    ChatMessage _messages[MAX_CHAT_MESSAGES];
-    int _messageCount = 0;
+    RingBuffer<ChatMessage, MAX_CHAT_MESSAGES> _messages;  // Oldest first, drops oldest when full
     int _scrollOffset = 0;  // For scrolling through messages
+    int _reactTarget = -1;  // Bottom message on screen, what React applies to
+    uint32_t _reactRef = 0; // Its Reaction::refHash(), taken when React is pressed
+    bool _reacting = false; // Emoji picker open for a reaction
 
     // Text input buffer
     char _inputBuffer[128];
@@ -98,11 +107,14 @@ private:
     // Drawing helpers
     void drawMessages(bool fullRedraw);
     void drawInputBar();
+    int16_t drawReactions(const ChatMessage& msg, int16_t y, int16_t margin);
     int getVisibleMessageCount() const;
 
     // Message handling
     void sendMessage();
     void clearInput();
+    bool startReaction();
+    void sendReaction(const char* shortcode);
 
     // Compute content hash for repeat tracking
     static uint32_t hashMessage(int channelIdx, const char* text);
@@ -19,6 +19,7 @@
 // Forward declaration - defined in main.cpp
 extern RepeaterAdminScreen repeaterAdminScreen;
 extern DMChatScreen dmChatScreen;
+extern MeshBerryMesh* theMesh;
 
 ContactsScreen::ContactsScreen() {
     _listView.setBounds(0, Theme::CONTENT_Y + 30, Theme::SCREEN_WIDTH, Theme::CONTENT_HEIGHT - 30);
@@ -31,7 +32,14 @@ void ContactsScreen::onEnter() {
 }
 
 void ContactsScreen::configureSoftKeys() {
-    SoftKeyBar::setLabels("Fav", "View", "Back");
+    bool discovered = _contactCount > 0 && selectedUserData() <= discoveredData(0);
+    SoftKeyBar::setLabels(discovered ? "Add" : "Fav", "View", "Back");
+}
+
+int ContactsScreen::selectedUserData() const {
+    int idx = _listView.getSelectedIndex();
+    if (idx < 0 || idx >= _contactCount) return -1;
+    return (int)(intptr_t)_contactItems[idx].userData;
 }
 
 void ContactsScreen::formatTimeAgo(uint32_t timestamp, char* buf, size_t bufSize) {
@@ -154,7 +162,7 @@ void ContactsScreen::buildContactList() {
         _contactCount++;
 
         // Add favorite contacts first
-        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_CONTACTS; i++) {
+        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_ITEMS; i++) {
             const ContactEntry* c = contacts.getContact(i);
             if (!c || !c->isActive) continue;
             if (c->type == NODE_TYPE_REPEATER) continue;
@@ -163,7 +171,7 @@ void ContactsScreen::buildContactList() {
         }
 
         // Add non-favorite contacts
-        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_CONTACTS; i++) {
+        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_ITEMS; i++) {
             const ContactEntry* c = contacts.getContact(i);
             if (!c || !c->isActive) continue;
             if (c->type == NODE_TYPE_REPEATER) continue;
@@ -190,7 +198,7 @@ void ContactsScreen::buildContactList() {
         _contactCount++;
 
         // Add favorite repeaters first
-        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_CONTACTS; i++) {
+        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_ITEMS; i++) {
             const ContactEntry* c = contacts.getContact(i);
             if (!c || !c->isActive) continue;
             if (c->type != NODE_TYPE_REPEATER) continue;
@@ -199,7 +207,7 @@ void ContactsScreen::buildContactList() {
         }
 
         // Add non-favorite repeaters
-        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_CONTACTS; i++) {
+        for (int i = 0; i < contacts.numContacts && _contactCount < MAX_ITEMS; i++) {
             const ContactEntry* c = contacts.getContact(i);
             if (!c || !c->isActive) continue;
             if (c->type != NODE_TYPE_REPEATER) continue;
@@ -208,9 +216,96 @@ void ContactsScreen::buildContactList() {
         }
     }
 
+    addDiscoveredToList();
+
     _listView.setItems(_contactItems, _contactCount);
 }
 
+void ContactsScreen::addDiscoveredToList() {
+    _discoveredCount = 0;
+    _discoveredHeaderIdx = -1;
+    if (!theMesh || _contactCount + 2 > MAX_ITEMS) return;
+
+    // Nodes heard over the air (newest first) that are not contacts
+    ContactSettings& contacts = SettingsManager::getContactSettings();
+    int headerIdx = _contactCount++;
+    NodeInfo node;
+    for (int c = theMesh->firstNode(node); c != MeshBerryMesh::NODE_END; c = theMesh->nextNode(c, node)) {
+        if (_discoveredCount >= MAX_DISCOVERED || _contactCount >= MAX_ITEMS) break;
+        if (node.lastHeard == 0 || contacts.findContact(node.id) >= 0) continue;
+
+        strncpy(_primaryStrings[_contactCount], node.name, sizeof(_primaryStrings[0]) - 1);
+        _primaryStrings[_contactCount][sizeof(_primaryStrings[0]) - 1] = '\0';
+
+        const char* typeStr = "Chat";
+        const uint8_t* icon = Icons::CONTACTS_ICON;
+        switch (node.type) {
+            case NODE_TYPE_REPEATER:
+                typeStr = "Repeater";
+                icon = Icons::REPEATER_ICON;
+                break;
+            case NODE_TYPE_ROOM:   typeStr = "Room"; break;
+            case NODE_TYPE_SENSOR: typeStr = "Sensor"; break;
+            default: break;
+        }
+        snprintf(_secondaryStrings[_contactCount], sizeof(_secondaryStrings[0]),
+                 "%s | %ddBm | not saved", typeStr, node.rssi);
+
+        _discoveredIds[_discoveredCount] = node.id;
+        _discoveredTypes[_discoveredCount] = node.type;
+        _contactItems[_contactCount] = {
+            _primaryStrings[_contactCount],
+            _secondaryStrings[_contactCount],
+            icon,
+            Theme::GRAY_LIGHT,
+            false,
+            0,
+            (void*)(intptr_t)discoveredData(_discoveredCount)
+        };
+        _discoveredCount++;
+        _contactCount++;
+    }
+
+    if (_discoveredCount == 0) {
+        _contactCount--;  // Drop the unused header
+        return;
+    }
+
+    _discoveredHeaderIdx = headerIdx;
+    snprintf(_primaryStrings[headerIdx], sizeof(_primaryStrings[0]),
+             "-- Discovered (%d) --", _discoveredCount);
+    _secondaryStrings[headerIdx][0] = '\0';
+    _contactItems[headerIdx] = {
+        _primaryStrings[headerIdx],
+        nullptr,
+        nullptr,
+        Theme::GRAY_LIGHT,
+        false,
+        0,
+        (void*)(intptr_t)-1
+    };
+}
+
+void ContactsScreen::onLeftSoftKey() {
+    if (_contactCount == 0) return;
+    int userData = selectedUserData();
+
+    if (userData >= 0) {
+        ContactSettings& contacts = SettingsManager::getContactSettings();
+        contacts.toggleFavorite(userData);
+        SettingsManager::saveContacts();
+    } else if (userData <= discoveredData(0) && theMesh) {
+        // Promote to the persisted contact list
+        theMesh->promoteToContact(_discoveredIds[discoveredIndex(userData)]);
+    } else {
+        return;  // Header
+    }
+
+    buildContactList();  // Rebuild to re-sort
+    configureSoftKeys();
+    requestRedraw();
+}
+
 void ContactsScreen::draw(bool fullRedraw) {
     if (fullRedraw) {
         Display::fillRect(0, Theme::CONTENT_Y,
@@ -243,18 +338,9 @@ void ContactsScreen::draw(bool fullRedraw) {
 
 bool ContactsScreen::handleInput(const InputData& input) {
     // Left soft key: "Fav" - toggle favorite on selected contact
+    // ("Add" on a discovered node)
     if (input.event == InputEvent::SOFTKEY_LEFT) {
-        if (_contactCount > 0) {
-            int idx = _listView.getSelectedIndex();
-            int originalIdx = (int)(intptr_t)_contactItems[idx].userData;
-            if (originalIdx >= 0) {  // Not a header
-                ContactSettings& contacts = SettingsManager::getContactSettings();
-                contacts.toggleFavorite(originalIdx);
-                SettingsManager::saveContacts();
-                buildContactList();  // Rebuild to re-sort
-                requestRedraw();
-            }
-        }
+        onLeftSoftKey();
         return true;
     }
 
@@ -293,6 +379,7 @@ bool ContactsScreen::handleInput(const InputData& input) {
                 _listView.setSelectedIndex(idx - 1);
             }
         }
+        configureSoftKeys();
         requestRedraw();
         return true;
     }
@@ -313,18 +400,8 @@ bool ContactsScreen::handleInput(const InputData& input) {
                     onContactSelected(_listView.getSelectedIndex());
                 }
             } else {
-                // Left soft key = Fav toggle
-                if (_contactCount > 0) {
-                    int idx = _listView.getSelectedIndex();
-                    int originalIdx = (int)(intptr_t)_contactItems[idx].userData;
-                    if (originalIdx >= 0) {
-                        ContactSettings& contacts = SettingsManager::getContactSettings();
-                        contacts.toggleFavorite(originalIdx);
-                        SettingsManager::saveContacts();
-                        buildContactList();
-                        requestRedraw();
-                    }
-                }
+                // Left soft key = Fav toggle / Add
+                onLeftSoftKey();
             }
             return true;
         }
@@ -338,6 +415,7 @@ bool ContactsScreen::handleInput(const InputData& input) {
                 int userData = (int)(intptr_t)_contactItems[itemIndex].userData;
                 if (userData != -1) {
                     _listView.setSelectedIndex(itemIndex);
+                    configureSoftKeys();
                     onContactSelected(itemIndex);  // Open directly on tap
                 }
             }
@@ -358,6 +436,19 @@ void ContactsScreen::onContactSelected(int index) {
     if (originalIdx == -1) return;
 
     ContactSettings& contacts = SettingsManager::getContactSettings();
+    if (originalIdx <= discoveredData(0)) {
+        int d = discoveredIndex(originalIdx);
+        if (_discoveredTypes[d] != NODE_TYPE_REPEATER) {
+            // Chat with a discovered node; the first DM sent adds it
+            dmChatScreen.setContact(_discoveredIds[d], _primaryStrings[index]);
+            Screens.navigateTo(ScreenId::DM_CHAT);
+            return;
+        }
+        // Repeater admin keeps its saved password in the contact entry
+        if (!theMesh) return;
+        originalIdx = theMesh->promoteToContact(_discoveredIds[d]);
+    }
+
     const ContactEntry* contact = contacts.getContact(originalIdx);
     if (!contact) return;
 
@@ -4,7 +4,8 @@
  * SPDX-License-Identifier: GPL-3.0-or-later
  * Copyright (C) 2026 NodakMesh (nodakmesh.org)
  *
- * Node and repeater contact list with BlackBerry style
+ * Node and repeater contact list with BlackBerry style, followed by
+ * recently heard nodes that are not contacts yet
  */
 
 #ifndef MESHBERRY_CONTACTSSCREEN_H
@@ -41,6 +42,15 @@ private:
     // Helper functions for building list with favorites sorted to top
     void addRepeaterToList(const ContactEntry* c, int originalIdx);
     void addContactToList(const ContactEntry* c, int originalIdx);
+    void addDiscoveredToList();
+
+    // Left soft key: toggle favorite, or add a discovered node
+    void onLeftSoftKey();
+
+    // Discovered-node list position encoded in ListItem::userData
+    static int discoveredData(int i) { return -2 - i; }
+    static int discoveredIndex(int userData) { return -2 - userData; }
+    int selectedUserData() const;
 
     // Handle contact selection
     void onContactSelected(int index);
@@ -51,14 +61,22 @@ private:
     // List view
     ListView _listView;
     static constexpr int MAX_CONTACTS = 32;
-    ListItem _contactItems[MAX_CONTACTS];
-    char _primaryStrings[MAX_CONTACTS][32];  // Increased for section headers
-    char _secondaryStrings[MAX_CONTACTS][32];
+    static constexpr int MAX_DISCOVERED = 20;   // Most recently heard
+    static constexpr int MAX_ITEMS = MAX_CONTACTS + MAX_DISCOVERED + 3;  // + headers
+    ListItem _contactItems[MAX_ITEMS];
+    char _primaryStrings[MAX_ITEMS][32];  // Increased for section headers
+    char _secondaryStrings[MAX_ITEMS][32];
     int _contactCount = 0;
 
+    // Discovered nodes shown below the contacts
+    uint32_t _discoveredIds[MAX_DISCOVERED];
+    uint8_t _discoveredTypes[MAX_DISCOVERED];
+    int _discoveredCount = 0;
+
     // Section tracking
     int _repeaterHeaderIdx = -1;
     int _contactsHeaderIdx = -1;
+    int _discoveredHeaderIdx = -1;
     int _repeaterCount = 0;
     int _regularContactCount = 0;
 };
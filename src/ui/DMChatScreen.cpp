@@ -16,6 +16,7 @@
 #include "../settings/SettingsManager.h"
 #include "../settings/MessageArchive.h"
 #include "../mesh/MeshBerryMesh.h"
+#include "../mesh/Reaction.h"
 #include <Arduino.h>
 #include <stdio.h>
 #include <string.h>
@@ -46,7 +47,14 @@ void DMChatScreen::onEnter() {
     _instance = this;
 
     // Check if returning from emoji picker with a selection
-    if (emojiPickerScreen.wasEmojiSelected()) {
+    if (_reacting) {
+        // Picked (or cancelled) a reaction
+        char emoji[32];
+        if (emojiPickerScreen.getSelectedEmoji(emoji)) {
+            sendReaction(emoji);
+        }
+        _reacting = false;
+    } else if (emojiPickerScreen.wasEmojiSelected()) {
         char emoji[32];  // Buffer for :shortcode: format
         if (emojiPickerScreen.getSelectedEmoji(emoji)) {
             // Append emoji shortcode to input buffer
@@ -98,7 +106,7 @@ void DMChatScreen::configureSoftKeys() {
     if (_inputMode) {
         SoftKeyBar::setLabels("Emoji", "Send", "Cancel");
     } else {
-        SoftKeyBar::setLabels("Type", "Route", "Back");
+        SoftKeyBar::setLabels(hasMessages() ? "React" : "Type", "Route", "Back");
     }
 }
 
@@ -132,6 +140,7 @@ void DMChatScreen::drawMessages(bool fullRedraw) {
 
     // Clear message area
     Display::fillRect(0, msgY, Theme::SCREEN_WIDTH, msgHeight, Theme::BG_PRIMARY);
+    _reactTarget = -1;
 
     // Get conversation from DMSettings
     DMSettings& dms = SettingsManager::getDMSettings();
@@ -148,7 +157,7 @@ void DMChatScreen::drawMessages(bool fullRedraw) {
     }
 
     const DMConversation* conv = dms.getConversation(convIdx);
-    if (!conv || conv->messageCount == 0) {
+    if (!conv || conv->messageCount() == 0) {
         Display::drawTextCentered(0, msgY + msgHeight / 2 - 8,
                                   Theme::SCREEN_WIDTH,
                                   "No messages yet", Theme::TEXT_SECONDARY, 1);
@@ -167,23 +176,25 @@ void DMChatScreen::drawMessages(bool fullRedraw) {
 
     // Estimate visible messages with wrapping
     int estVisibleMsgs = msgHeight / 35;
-    int displayStartIdx = conv->messageCount - estVisibleMsgs - _scrollOffset;
+    int displayStartIdx = conv->messageCount() - estVisibleMsgs - _scrollOffset;
     if (displayStartIdx < 0) displayStartIdx = 0;
 
     int16_t y = msgY + 4;
-    for (int i = displayStartIdx; i < conv->messageCount && y < maxY - 20; i++) {
+    int16_t targetY = 0, targetH = 0;
+    for (int i = displayStartIdx; i < conv->messageCount() && y < maxY - 20; i++) {
         const DMMessage* msg = conv->getMessage(i);
         if (!msg) continue;
 
         // Wrap text for bubble width calculation
         char wrappedLines[4][64];
-        int lineCount = Theme::wrapText(msg->text, maxBubbleWidth - bubblePadding * 2, 1, wrappedLines, 4);
+        int16_t lineWidths[4];
+        int lineCount = Theme::wrapText(msg->text, maxBubbleWidth - bubblePadding * 2, 1,
+                                        wrappedLines, 4, lineWidths);
 
         // Calculate bubble dimensions
         int16_t maxLineWidth = 0;
         for (int ln = 0; ln < lineCount; ln++) {
-            int16_t w = strlen(wrappedLines[ln]) * 6;
-            if (w > maxLineWidth) maxLineWidth = w;
+            if (lineWidths[ln] > maxLineWidth) maxLineWidth = lineWidths[ln];
         }
         int16_t bubbleWidth = maxLineWidth + bubblePadding * 2;
         if (bubbleWidth < 40) bubbleWidth = 40;
@@ -219,6 +230,10 @@ void DMChatScreen::drawMessages(bool fullRedraw) {
             textY += lineHeight;
         }
 
+        _reactTarget = i;
+        targetY = y;
+        targetH = bubbleHeight;
+
         // Status indicator for outgoing messages (small text below bubble)
         if (msg->isOutgoing && msg->status != DM_STATUS_SENDING) {
             const char* statusStr = "";
@@ -235,7 +250,14 @@ void DMChatScreen::drawMessages(bool fullRedraw) {
             }
         }
 
-        y += bubbleHeight + bubbleGap;
+        y += bubbleHeight + 1;
+        y = drawReactions(*msg, y, bubbleMargin);
+        y += bubbleGap - 1;
+    }
+
+    // Mark the message React applies to
+    if (_reactTarget >= 0 && !_inputMode) {
+        Display::fillRect(2, targetY + 2, 2, targetH - 4, Theme::ACCENT_PRIMARY);
     }
 
     // Scroll indicators
@@ -249,6 +271,20 @@ void DMChatScreen::drawMessages(bool fullRedraw) {
     }
 }
 
+int16_t DMChatScreen::drawReactions(const DMMessage& msg, int16_t y, int16_t margin) {
+    const Reaction::Badge* badge = Reaction::find(_contactId, Reaction::refHash(nullptr, msg.text));
+    if (!badge) return y;
+
+    char text[48];
+    Reaction::formatBadge(*badge, text, sizeof(text));
+    int16_t x = margin;
+    if (msg.isOutgoing) {
+        x = Theme::SCREEN_WIDTH - margin - Emoji::textWidth(text, 1);
+    }
+    Display::drawTextWithEmoji(x, y, text, Theme::TEXT_SECONDARY, 1);
+    return y + 13;
+}
+
 void DMChatScreen::drawInputBar() {
     int16_t inputY = Theme::SOFTKEY_BAR_Y - 28;
 
@@ -280,7 +316,7 @@ void DMChatScreen::drawInputBar() {
 
         // Cursor (blinking)
         if (_inputMode && (millis() / 500) % 2 == 0) {
-            int16_t cursorX = fieldX + 4 + strlen(displayText) * 6;
+            int16_t cursorX = fieldX + 4 + Emoji::textWidth(displayText, 1);
             if (cursorX < fieldX + fieldW - 4) {
                 Display::drawVLine(cursorX, fieldY + 4, fieldH - 8, Theme::TEXT_PRIMARY);
             }
@@ -313,7 +349,7 @@ bool DMChatScreen::handleInput(const InputData& input) {
                     Screens.navigateTo(ScreenId::EMOJI_PICKER);
                 }
             } else {
-                // Normal mode: Type | Route | Back
+                // Normal mode: React (Type if empty) | Route | Back
                 if (tx >= 214) {
                     // Right soft key = Back
                     Screens.goBack();
@@ -321,8 +357,8 @@ bool DMChatScreen::handleInput(const InputData& input) {
                     // Center soft key = Route settings
                     dmSettingsScreen.setContact(_contactId);
                     Screens.navigateTo(ScreenId::DM_SETTINGS);
-                } else {
-                    // Left soft key = Type (enter input mode)
+                } else if (!startReaction()) {
+                    // Left soft key = React, or Type with nothing to react to
                     _inputMode = true;
                     configureSoftKeys();
                     SoftKeyBar::redraw();
@@ -390,6 +426,10 @@ bool DMChatScreen::handleInput(const InputData& input) {
         // Normal mode
         switch (input.event) {
             case InputEvent::SOFTKEY_LEFT:
+                // React to the bottom message (scroll to pick another)
+                if (startReaction()) return true;
+                // Nothing to react to yet - same as Type
+                // fall through
             case InputEvent::TRACKBALL_CLICK:
                 // Enter input mode
                 _inputMode = true;
@@ -417,7 +457,7 @@ bool DMChatScreen::handleInput(const InputData& input) {
                     int convIdx = dms.findConversation(_contactId);
                     if (convIdx >= 0) {
                         const DMConversation* conv = dms.getConversation(convIdx);
-                        if (conv && _scrollOffset < conv->messageCount - getVisibleMessageCount()) {
+                        if (conv && _scrollOffset < conv->messageCount() - getVisibleMessageCount()) {
                             _scrollOffset++;
                             requestRedraw();
                         }
@@ -454,6 +494,12 @@ bool DMChatScreen::handleInput(const InputData& input) {
     return false;
 }
 
+bool DMChatScreen::hasMessages() const {
+    DMSettings& dms = SettingsManager::getDMSettings();
+    const DMConversation* conv = dms.getConversation(dms.findConversation(_contactId));
+    return conv && conv->messageCount() > 0;
+}
+
 int DMChatScreen::getVisibleMessageCount() const {
     int16_t msgHeight = Theme::CONTENT_HEIGHT - 26 - 28;
     return msgHeight / 12;
@@ -505,10 +551,48 @@ void DMChatScreen::clearInput() {
     _inputPos = 0;
 }
 
+bool DMChatScreen::startReaction() {
+    if (_reactTarget < 0) return false;
+
+    DMSettings& dms = SettingsManager::getDMSettings();
+    const DMConversation* conv = dms.getConversation(dms.findConversation(_contactId));
+    const DMMessage* msg = conv ? conv->getMessage(_reactTarget) : nullptr;
+    if (!msg) return false;
+
+    // Messages may arrive while the picker is open, so keep the hash, not the index
+    _reactRef = Reaction::refHash(nullptr, msg->text);
+    _reacting = true;
+    Screens.navigateTo(ScreenId::EMOJI_PICKER);
+    return true;
+}
+
+void DMChatScreen::sendReaction(const char* shortcode) {
+    if (!theMesh) return;
+
+    // Picker hands back ":name:"
+    char name[32];
+    strncpy(name, shortcode[0] == ':' ? shortcode + 1 : shortcode, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    char* colon = strchr(name, ':');
+    if (colon) *colon = '\0';
+
+    int emoji = Emoji::indexOf(Emoji::findByShortcode(name));
+    if (emoji < 0) return;
+
+    if (!theMesh->sendDirectReaction(_contactId, _reactRef, (uint16_t)emoji)) {
+        Screens.showStatus("Reaction failed", 1500);
+    }
+    requestRedraw();
+}
+
 void DMChatScreen::onMessageReceived(const char* text, uint32_t timestamp) {
     // Message already stored in DMSettings by the callback
     // Just need to refresh display and scroll to bottom
     _scrollOffset = 0;
+    if (!_inputMode) {
+        configureSoftKeys();  // First message makes React available
+        SoftKeyBar::redraw();
+    }
     requestRedraw();
 }
 
@@ -517,3 +601,9 @@ void DMChatScreen::addToCurrentChat(uint32_t contactId, const char* text, uint32
         _instance->onMessageReceived(text, timestamp);
     }
 }
+
+void DMChatScreen::refreshReactions(uint32_t contactId) {
+    if (_instance && _instance->_contactId == contactId) {
+        _instance->requestRedraw();
+    }
+}
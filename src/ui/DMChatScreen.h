@@ -14,6 +14,9 @@
 #include "Screen.h"
 #include "ScreenManager.h"
 
+// Forward declaration
+struct DMMessage;
+
 class DMChatScreen : public Screen {
 public:
     DMChatScreen() = default;
@@ -49,12 +52,20 @@ public:
      */
     static void addToCurrentChat(uint32_t contactId, const char* text, uint32_t timestamp);
 
+    /**
+     * Redraw reaction badges (called when a reaction arrives)
+     */
+    static void refreshReactions(uint32_t contactId);
+
 private:
     uint32_t _contactId = 0;
     char _contactName[32];
 
     // Scroll position in conversation
     int _scrollOffset = 0;
+    int _reactTarget = -1;      // Bottom message on screen, what React applies to
+    uint32_t _reactRef = 0;     // Its Reaction::refHash(), taken when React is pressed
+    bool _reacting = false;     // Emoji picker open for a reaction
 
     // Text input buffer
     char _inputBuffer[128];
@@ -64,11 +75,15 @@ private:
     // Drawing helpers
     void drawMessages(bool fullRedraw);
     void drawInputBar();
+    int16_t drawReactions(const DMMessage& msg, int16_t y, int16_t margin);
+    bool hasMessages() const;
     int getVisibleMessageCount() const;
 
     // Message handling
     void sendMessage();
     void clearInput();
+    bool startReaction();
+    void sendReaction(const char* shortcode);
 
     // Singleton instance pointer for static callback
     static DMChatScreen* _instance;
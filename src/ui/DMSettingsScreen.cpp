@@ -14,6 +14,8 @@
 #include <stdio.h>
 #include <string.h>
 
+extern MeshBerryMesh* theMesh;
+
 DMSettingsScreen::DMSettingsScreen() {
     memset(_contactName, 0, sizeof(_contactName));
     memset(_menuItems, 0, sizeof(_menuItems));
@@ -97,8 +99,9 @@ void DMSettingsScreen::buildMenu() {
     _menuItemCount++;
 
     // Item 1: Current Path Info
-    if (c->outPathLen >= 0) {
-        snprintf(_valueStrings[1], sizeof(_valueStrings[1]), "%d hops", c->outPathLen);
+    int pathLen = theMesh ? theMesh->getPathLen(c->id) : -1;
+    if (pathLen >= 0) {
+        snprintf(_valueStrings[1], sizeof(_valueStrings[1]), "%d hops", pathLen);
     } else {
         snprintf(_valueStrings[1], sizeof(_valueStrings[1]), "Unknown");
     }
@@ -107,14 +110,14 @@ void DMSettingsScreen::buildMenu() {
         _valueStrings[1],
         Icons::REPEATER_ICON,
         Theme::GREEN,
-        c->outPathLen >= 0,
+        pathLen >= 0,
         Theme::GREEN,
         nullptr
     };
     _menuItemCount++;
 
     // Item 2: Clear Learned Path (only if path exists)
-    if (c->outPathLen >= 0) {
+    if (pathLen >= 0) {
         _menuItems[2] = {
             "Clear Path",
             "Force re-learn",
@@ -250,11 +253,9 @@ void DMSettingsScreen::onItemSelected(int index) {
     else if (index == 1) {
         // Learned path - just info, no action
     }
-    else if (index == 2 && c->outPathLen >= 0) {
+    else if (index == 2 && theMesh && theMesh->getPathLen(c->id) >= 0) {
         // Clear learned path
-        memset(c->outPath, 0, sizeof(c->outPath));
-        c->outPathLen = -1;
-        c->pathLearnedAt = 0;
+        theMesh->invalidatePath(c->id);
         Serial.printf("[DM] Cleared learned path for %s\n", c->name);
         buildMenu();
         requestRedraw();
@@ -6,11 +6,18 @@
  */
 
 #include "Emoji.h"
+#include "Font.h"
 #include <string.h>
+#include <stdlib.h>
 
-// Include the generated emoji bitmap data (353 emoji)
+// Include the generated emoji bitmap data (1013 emoji)
 #include "EmojiData.h"
 
+// Table indices sorted by codepoint and by shortcode, built on first lookup
+static uint16_t s_byCodepoint[EMOJI_COUNT];
+static uint16_t s_byShortcode[EMOJI_COUNT];
+static bool s_indexBuilt = false;
+
 // Category names
 static const char* CATEGORY_NAMES[] = {
     "Faces",
@@ -80,6 +87,35 @@ int decodeUTF8(const char* str, uint32_t* codepoint) {
     return 0;  // Invalid
 }
 
+size_t asciiSpan(const char* str) {
+    if (!str) return 0;
+    const char* p = str;
+
+    // Bytewise up to word alignment
+    while (((uintptr_t)p & (sizeof(size_t) - 1)) != 0) {
+        uint8_t c = (uint8_t)*p;
+        if (c == 0 || c >= 0x80) return p - str;
+        p++;
+    }
+
+    // A word at a time while every byte is 0x01-0x7F: subtracting 1 from
+    // each byte sets its high bit only for 0x00, and OR-ing in the word
+    // catches bytes >= 0x80. An aligned load never crosses into another
+    // page, so reading past the terminator within its word is safe.
+    const size_t ones = (size_t)-1 / 0xFF;
+    const size_t highs = ones * 0x80;
+    for (;;) {
+        size_t w;
+        memcpy(&w, p, sizeof(w));
+        if (((w - ones) | w) & highs) break;
+        p += sizeof(w);
+    }
+
+    // Locate the stopping byte within the last word
+    while (*p && (uint8_t)*p < 0x80) p++;
+    return p - str;
+}
+
 int encodeUTF8(uint32_t codepoint, char* buf) {
     if (codepoint < 0x80) {
         buf[0] = (char)codepoint;
@@ -114,6 +150,11 @@ int utf8Length(const char* str) {
     int count = 0;
     const char* p = str;
     while (*p) {
+        size_t ascii = asciiSpan(p);
+        count += ascii;
+        p += ascii;
+        if (!*p) break;
+
         uint32_t cp;
         int bytes = decodeUTF8(p, &cp);
         if (bytes == 0) {
@@ -130,21 +171,68 @@ int utf8Length(const char* str) {
 // EMOJI LOOKUP IMPLEMENTATION
 // =========================================================================
 
-const EmojiEntry* findByCodepoint(uint32_t codepoint) {
+// Ties keep table order, so duplicate codepoints resolve to the first entry
+static int compareCodepoint(const void* a, const void* b) {
+    uint16_t ia = *(const uint16_t*)a;
+    uint16_t ib = *(const uint16_t*)b;
+    uint32_t ca = EMOJI_TABLE[ia].codepoint;
+    uint32_t cb = EMOJI_TABLE[ib].codepoint;
+    if (ca != cb) return ca < cb ? -1 : 1;
+    return (int)ia - (int)ib;
+}
+
+static int compareShortcode(const void* a, const void* b) {
+    uint16_t ia = *(const uint16_t*)a;
+    uint16_t ib = *(const uint16_t*)b;
+    int c = strcmp(EMOJI_TABLE[ia].shortcode, EMOJI_TABLE[ib].shortcode);
+    return c ? c : (int)ia - (int)ib;
+}
+
+static void buildIndex() {
+    if (s_indexBuilt) return;
     for (int i = 0; i < EMOJI_COUNT; i++) {
-        if (EMOJI_TABLE[i].codepoint == codepoint) {
-            return &EMOJI_TABLE[i];
+        s_byCodepoint[i] = (uint16_t)i;
+        s_byShortcode[i] = (uint16_t)i;
+    }
+    qsort(s_byCodepoint, EMOJI_COUNT, sizeof(uint16_t), compareCodepoint);
+    qsort(s_byShortcode, EMOJI_COUNT, sizeof(uint16_t), compareShortcode);
+    s_indexBuilt = true;
+}
+
+const EmojiEntry* findByCodepoint(uint32_t codepoint) {
+    buildIndex();
+    // Lower bound: first (lowest table index) entry with this codepoint
+    int lo = 0;
+    int hi = EMOJI_COUNT;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (EMOJI_TABLE[s_byCodepoint[mid]].codepoint < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
+    if (lo < EMOJI_COUNT && EMOJI_TABLE[s_byCodepoint[lo]].codepoint == codepoint) {
+        return &EMOJI_TABLE[s_byCodepoint[lo]];
+    }
     return nullptr;
 }
 
 const EmojiEntry* findByShortcode(const char* shortcode) {
     if (!shortcode) return nullptr;
 
-    for (int i = 0; i < EMOJI_COUNT; i++) {
-        if (strcmp(EMOJI_TABLE[i].shortcode, shortcode) == 0) {
-            return &EMOJI_TABLE[i];
+    buildIndex();
+    int lo = 0;
+    int hi = EMOJI_COUNT - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        const EmojiEntry& e = EMOJI_TABLE[s_byShortcode[mid]];
+        int c = strcmp(e.shortcode, shortcode);
+        if (c == 0) return &e;
+        if (c < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
         }
     }
     return nullptr;
@@ -155,6 +243,10 @@ const EmojiEntry* getByIndex(int index) {
     return &EMOJI_TABLE[index];
 }
 
+int indexOf(const EmojiEntry* entry) {
+    return entry ? (int)(entry - EMOJI_TABLE) : -1;
+}
+
 int getCount() {
     return EMOJI_COUNT;
 }
@@ -190,83 +282,105 @@ const char* getCategoryName(EmojiCategory category) {
 // TEXT PROCESSING IMPLEMENTATION
 // =========================================================================
 
-int16_t textWidth(const char* text, uint8_t textSize) {
-    if (!text) return 0;
+int16_t charWidth(uint32_t codepoint, uint8_t textSize) {
+    if (codepoint < 0x80) return 6 * textSize;
+    if (findByCodepoint(codepoint)) return EMOJI_WIDTH;
+    // CP437 or font face advance (box if missing)
+    return Font::charWidth(codepoint, textSize);
+}
 
-    int16_t width = 0;
-    int16_t charWidth = 6 * textSize;  // Default font width
+size_t fitText(const char* text, uint8_t textSize, int16_t maxWidth, int16_t* width) {
+    int16_t w = 0;
     const char* p = text;
+    int16_t asciiWidth = 6 * textSize;
+
+    while (p && *p) {
+        // ASCII runs: whole run fits, or only part of it does
+        size_t ascii = asciiSpan(p);
+        if (ascii > 0) {
+            int16_t room = (maxWidth - w) / asciiWidth;
+            if (room < 0) room = 0;
+            if ((size_t)room < ascii) {
+                p += room;
+                w += room * asciiWidth;
+                break;
+            }
+            p += ascii;
+            w += ascii * asciiWidth;
+            continue;
+        }
 
-    while (*p) {
         uint32_t cp;
         int bytes = decodeUTF8(p, &cp);
-
-        if (bytes == 0) {
-            // Invalid byte, skip
-            p++;
-            width += charWidth;
-        } else if (bytes == 1) {
-            // ASCII character
-            width += charWidth;
-            p++;
-        } else {
-            // Multi-byte character
-            if (findByCodepoint(cp)) {
-                // Known emoji
-                width += EMOJI_WIDTH;
-            } else {
-                // Unknown Unicode, render as [?]
-                width += 3 * charWidth;
-            }
-            p += bytes;
-        }
+        // Invalid bytes take one cell, as in textWidth()
+        int16_t cw = bytes ? charWidth(cp, textSize) : asciiWidth;
+        if (w + cw > maxWidth) break;
+        w += cw;
+        p += bytes ? bytes : 1;
     }
 
+    if (width) *width = w;
+    return p ? (size_t)(p - text) : 0;
+}
+
+int16_t textWidth(const char* text, uint8_t textSize) {
+    int16_t width = 0;
+    fitText(text, textSize, INT16_MAX, &width);
     return width;
 }
 
 void convertShortcodes(char* text, size_t maxLen) {
     if (!text || maxLen < 2) return;
 
-    char result[256];
-    size_t resultPos = 0;
+    // In place, one pass. Every shortcode (1+ chars plus two colons) is at
+    // least as long as its UTF-8 encoding, so the write position never
+    // passes the read position.
+    char* out = text;
     const char* p = text;
 
-    while (*p && resultPos < sizeof(result) - 5) {
-        if (*p == ':') {
-            // Look for closing colon
-            const char* end = strchr(p + 1, ':');
-            if (end && (end - p) < 32) {
-                // Extract shortcode
-                char shortcode[32];
-                size_t len = end - p - 1;
-                strncpy(shortcode, p + 1, len);
-                shortcode[len] = '\0';
-
-                // Look up emoji
-                const EmojiEntry* emoji = findByShortcode(shortcode);
-                if (emoji) {
-                    // Encode codepoint as UTF-8
-                    char utf8[5];
-                    int bytes = encodeUTF8(emoji->codepoint, utf8);
-                    if (bytes > 0 && resultPos + bytes < sizeof(result) - 1) {
-                        memcpy(result + resultPos, utf8, bytes);
-                        resultPos += bytes;
-                    }
-                    p = end + 1;
-                    continue;
-                }
+    while (*p) {
+        // Copy up to the next colon (strchr scans a word at a time)
+        const char* colon = strchr(p, ':');
+        size_t run = colon ? (size_t)(colon - p) : strlen(p);
+        if (out != p) memmove(out, p, run);
+        out += run;
+        p += run;
+        if (!colon) break;
+
+        // Shortcode names are [a-z0-9_]; stop at the first other byte
+        const char* name = p + 1;
+        const char* end = name;
+        while (end - name < 31 &&
+               ((*end >= 'a' && *end <= 'z') || (*end >= '0' && *end <= '9') || *end == '_')) {
+            end++;
+        }
+
+        if (*end == ':' && end > name) {
+            char shortcode[32];
+            size_t len = end - name;
+            memcpy(shortcode, name, len);
+            shortcode[len] = '\0';
+
+            const EmojiEntry* emoji = findByShortcode(shortcode);
+            char utf8[5];
+            int bytes = emoji ? encodeUTF8(emoji->codepoint, utf8) : 0;
+            if (bytes > 0 && (size_t)bytes <= len + 2) {
+                memcpy(out, utf8, bytes);
+                out += bytes;
+                p = end + 1;
+                continue;
             }
         }
 
-        // Copy character as-is
-        result[resultPos++] = *p++;
+        // Not a shortcode: keep the colon and name; the byte that ended
+        // the name (possibly another colon) is examined next
+        size_t keep = end - p;
+        if (out != p) memmove(out, p, keep);
+        out += keep;
+        p = end;
     }
 
-    result[resultPos] = '\0';
-
-    // Copy back to original buffer
-    strncpy(text, result, maxLen - 1);
+    *out = '\0';
     text[maxLen - 1] = '\0';
 }
 
@@ -58,6 +58,13 @@ namespace Emoji {
  */
 int decodeUTF8(const char* str, uint32_t* codepoint);
 
+/**
+ * Count leading ASCII bytes (0x01-0x7F), checking a word at a time
+ * @param str Input string
+ * @return Bytes before the first NUL or non-ASCII byte
+ */
+size_t asciiSpan(const char* str);
+
 /**
  * Encode a Unicode codepoint to UTF-8
  * @param codepoint Unicode codepoint to encode
@@ -98,6 +105,13 @@ const EmojiEntry* findByShortcode(const char* shortcode);
  */
 const EmojiEntry* getByIndex(int index);
 
+/**
+ * Get the table index of an entry
+ * @param entry Entry from findByCodepoint/findByShortcode/getByIndex
+ * @return Index, or -1 for nullptr
+ */
+int indexOf(const EmojiEntry* entry);
+
 /**
  * Get total number of emoji
  */
@@ -128,6 +142,24 @@ const char* getCategoryName(EmojiCategory category);
 // TEXT PROCESSING
 // =========================================================================
 
+/**
+ * Pixel width of one codepoint as drawn by Display::drawTextWithEmoji
+ * @param codepoint Unicode codepoint
+ * @param textSize Text size (1 or 2)
+ */
+int16_t charWidth(uint32_t codepoint, uint8_t textSize);
+
+/**
+ * Measure text up to a width limit in one pass
+ * Never splits a UTF-8 sequence.
+ * @param text UTF-8 text string
+ * @param textSize Text size (1 or 2)
+ * @param maxWidth Width limit in pixels
+ * @param width Output: width of the part that fits (may be nullptr)
+ * @return Number of bytes that fit
+ */
+size_t fitText(const char* text, uint8_t textSize, int16_t maxWidth, int16_t* width);
+
 /**
  * Calculate pixel width of text with emoji
  * @param text UTF-8 text string
@@ -138,7 +170,8 @@ int16_t textWidth(const char* text, uint8_t textSize);
 
 /**
  * Convert shortcodes in text to UTF-8 emoji
- * Replaces :shortcode: patterns with actual emoji bytes
+ * Replaces :shortcode: patterns with actual emoji bytes, in place and in
+ * a single pass (the text never grows)
  * @param text Text buffer (modified in place)
  * @param maxLen Maximum buffer length
  */
@@ -0,0 +1,260 @@
+/**
+ * MeshBerry Unicode Font Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "Font.h"
+#include "GlyphCache.h"
+#include "../drivers/storage.h"
+#include <SD.h>
+#include <esp_heap_caps.h>
+
+namespace Font {
+
+// =============================================================================
+// CP437 (built-in font, cp437(true) is set by Display::init)
+// =============================================================================
+
+// Unicode code point of each CP437 byte 0x80-0xFF
+static const uint16_t CP437_HIGH[128] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+struct FaceFile {
+    fs::FS* fs;
+    char path[48];
+    int id;                 // GlyphCache face, -1 if not loaded
+};
+
+static FaceFile s_small = { nullptr, "", -1 };     // 8 px
+static FaceFile s_large = { nullptr, "", -1 };     // 16 px
+
+// CP437 bytes 0x80-0xFF ordered by codepoint, for binary search
+static uint8_t s_cp437Sorted[128];
+static bool s_cp437Built = false;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static void* allocPsram(size_t len) {
+    void* p = heap_caps_malloc(len, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!p) {
+        p = malloc(len);
+    }
+    return p;
+}
+
+/**
+ * GlyphCache read callback
+ * Opens the file per call: misses are rare, and no handle is left open
+ * across an SD remount or clock change.
+ */
+static bool readFace(void* ctx, uint32_t offset, void* buf, size_t len) {
+    FaceFile* ff = (FaceFile*)ctx;
+    Storage::SDLock lock;
+    File f = ff->fs->open(ff->path, FILE_READ);
+    if (!f) return false;
+    bool ok = f.seek(offset) && f.read((uint8_t*)buf, len) == len;
+    f.close();
+    return ok;
+}
+
+static void openFaceFile(FaceFile& ff, const char* name, uint8_t expectHeight) {
+    Storage::SDLock lock;
+    struct Candidate { fs::FS* fs; bool available; const char* dir; };
+    const Candidate candidates[] = {
+        { &SD, Storage::isSDAvailable(), FONT_SD_DIR },
+        { &FLASH_FS, Storage::isFlashAvailable(), FONT_FLASH_DIR },
+    };
+
+    for (const Candidate& c : candidates) {
+        if (!c.available) continue;
+        snprintf(ff.path, sizeof(ff.path), "%s/%s", c.dir, name);
+        if (!c.fs->exists(ff.path)) continue;
+
+        ff.fs = c.fs;
+        ff.id = GlyphCache::openFace(readFace, &ff);
+        if (ff.id >= 0 && GlyphCache::faceHeight(ff.id) != expectHeight) {
+            Serial.printf("[FONT] %s: height %u, expected %u\n", ff.path,
+                          GlyphCache::faceHeight(ff.id), expectHeight);
+            GlyphCache::closeFace(ff.id);
+            ff.id = -1;
+        }
+        if (ff.id >= 0) {
+            Serial.printf("[FONT] %s: %lu glyphs, %u ranges, %u bytes of tables\n",
+                          ff.path, (unsigned long)GlyphCache::faceGlyphCount(ff.id),
+                          GlyphCache::faceRangeCount(ff.id),
+                          (unsigned)GlyphCache::faceTableBytes(ff.id));
+            return;
+        }
+        Serial.printf("[FONT] %s: invalid font file\n", ff.path);
+    }
+    ff.path[0] = '\0';
+}
+
+/**
+ * Face and integer scale for a text size, so glyph height x scale equals
+ * the built-in cell height. Prefers the taller face (less upscaling).
+ */
+static int faceFor(uint32_t cp, uint8_t size, uint8_t* scale) {
+    int16_t cell = BUILTIN_CHAR_HEIGHT * size;
+    const FaceFile* order[] = { &s_large, &s_small };
+    for (const FaceFile* ff : order) {
+        if (ff->id < 0) continue;
+        uint8_t h = GlyphCache::faceHeight(ff->id);
+        if (h > cell || cell % h != 0) continue;
+        if (GlyphCache::advance(ff->id, cp) == 0) continue;
+        *scale = cell / h;
+        return ff->id;
+    }
+    return -1;
+}
+
+// =============================================================================
+// API
+// =============================================================================
+
+void init() {
+    GlyphCache::setAllocator(allocPsram, free);
+    openFaceFile(s_small, FONT_FILE_SMALL, 8);
+    openFaceFile(s_large, FONT_FILE_LARGE, 16);
+    if (!isLoaded()) {
+        Serial.println("[FONT] No font files, using built-in CP437 only");
+    }
+}
+
+bool toCP437(uint32_t cp, uint8_t* out) {
+    if (cp < 0xA0 || cp > 0x25A0) return false;
+
+    if (!s_cp437Built) {
+        // Insertion sort of 128 entries, once
+        for (int i = 0; i < 128; i++) {
+            int j = i;
+            while (j > 0 && CP437_HIGH[s_cp437Sorted[j - 1] - 0x80] > CP437_HIGH[i]) {
+                s_cp437Sorted[j] = s_cp437Sorted[j - 1];
+                j--;
+            }
+            s_cp437Sorted[j] = (uint8_t)(0x80 + i);
+        }
+        s_cp437Built = true;
+    }
+
+    int lo = 0;
+    int hi = 127;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        uint16_t midCp = CP437_HIGH[s_cp437Sorted[mid] - 0x80];
+        if (midCp == cp) {
+            *out = s_cp437Sorted[mid];
+            return true;
+        }
+        if (midCp < cp) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return false;
+}
+
+GlyphSource lookup(uint32_t cp, uint8_t size) {
+    uint8_t b;
+    if (toCP437(cp, &b)) return GlyphSource::BUILTIN;
+    uint8_t scale;
+    if (faceFor(cp, size, &scale) >= 0) return GlyphSource::FACE;
+    return GlyphSource::MISSING;
+}
+
+int16_t charWidth(uint32_t cp, uint8_t size) {
+    uint8_t b;
+    if (toCP437(cp, &b)) return BUILTIN_CHAR_WIDTH * size;
+    uint8_t scale;
+    int face = faceFor(cp, size, &scale);
+    if (face >= 0) return GlyphCache::advance(face, cp) * scale;
+    return BUILTIN_CHAR_WIDTH * size;
+}
+
+int16_t drawGlyph(int16_t x, int16_t y, uint32_t cp, uint16_t color, uint8_t size, RunFn drawRun) {
+    uint8_t scale;
+    int face = faceFor(cp, size, &scale);
+    GlyphCache::Glyph g;
+    if (face < 0 || !drawRun || !GlyphCache::getGlyph(face, cp, g)) return 0;
+
+    // Bits are packed continuously across rows; draw each row as runs
+    uint32_t bit = 0;
+    for (int row = 0; row < g.height; row++) {
+        int runStart = -1;
+        for (int col = 0; col <= g.width; col++) {
+            bool on = false;
+            if (col < g.width) {
+                on = g.bits[bit >> 3] & (0x80 >> (bit & 7));
+                bit++;
+            }
+            if (on && runStart < 0) {
+                runStart = col;
+            } else if (!on && runStart >= 0) {
+                drawRun(x + runStart * scale, y + row * scale,
+                        (col - runStart) * scale, scale, color);
+                runStart = -1;
+            }
+        }
+    }
+    return g.width * scale;
+}
+
+bool isLoaded() {
+    return s_small.id >= 0 || s_large.id >= 0;
+}
+
+void printStatus() {
+    const FaceFile* faces[] = { &s_small, &s_large };
+    for (const FaceFile* ff : faces) {
+        if (ff->id < 0) continue;
+        Serial.printf("  %-28s %2u px  %5lu glyphs  %4u B tables\n", ff->path,
+                      GlyphCache::faceHeight(ff->id),
+                      (unsigned long)GlyphCache::faceGlyphCount(ff->id),
+                      (unsigned)GlyphCache::faceTableBytes(ff->id));
+    }
+    if (!isLoaded()) {
+        Serial.printf("  No faces (put %s and %s in %s)\n",
+                      FONT_FILE_SMALL, FONT_FILE_LARGE, FONT_SD_DIR);
+        return;
+    }
+
+    const GlyphCache::Stats& st = GlyphCache::getStats();
+    uint32_t lookups = st.hits + st.misses;
+    Serial.printf("  Cache: %d/%d pages, %u KB PSRAM\n", GlyphCache::cachedPages(),
+                  GlyphCache::CACHE_PAGES, (unsigned)(GlyphCache::cacheBytes() / 1024));
+    Serial.printf("  Lookups %lu, hit rate %lu%%, loads %lu, evictions %lu, "
+                  "read %lu B, errors %lu\n",
+                  (unsigned long)lookups,
+                  (unsigned long)(lookups ? st.hits * 100 / lookups : 0),
+                  (unsigned long)st.misses, (unsigned long)st.evictions,
+                  (unsigned long)st.bytesRead, (unsigned long)st.failures);
+}
+
+} // namespace Font
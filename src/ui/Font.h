@@ -0,0 +1,88 @@
+/**
+ * MeshBerry Unicode Font
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Glyph lookup for non-ASCII text, in two tiers:
+ *   1. Characters in the display's built-in CP437 font (accented Latin,
+ *      some Greek, box drawing) are drawn with it at no extra cost.
+ *   2. Everything else comes from MBF faces on the SD card or internal
+ *      flash (see GlyphCache), with bitmaps paged into PSRAM on demand.
+ *
+ * Widths come from the advance tables only, so wrapping and centering
+ * never read a bitmap.
+ */
+
+#ifndef MESHBERRY_FONT_H
+#define MESHBERRY_FONT_H
+
+#include <Arduino.h>
+
+namespace Font {
+
+// Face files, tried on SD first and then on internal flash
+constexpr const char* FONT_SD_DIR        = "/meshberry/fonts";
+constexpr const char* FONT_FLASH_DIR     = "/fonts";
+constexpr const char* FONT_FILE_SMALL    = "unicode8.mbf";     // Size 1 text
+constexpr const char* FONT_FILE_LARGE    = "unicode16.mbf";    // Size 2 text
+
+// Built-in font cell (Adafruit GFX classic font)
+constexpr int16_t  BUILTIN_CHAR_WIDTH    = 6;
+constexpr int16_t  BUILTIN_CHAR_HEIGHT   = 8;
+
+/**
+ * How a code point is drawn
+ */
+enum class GlyphSource : uint8_t {
+    BUILTIN,        // CP437 byte in the built-in font
+    FACE,           // Bitmap from a loaded face
+    MISSING         // Not available; drawn as a box
+};
+
+/**
+ * Open the font faces (call after Storage::init)
+ * Missing files are not an error; text falls back to CP437 and boxes.
+ */
+void init();
+
+/**
+ * Map a code point to the built-in CP437 font
+ * @return true and the byte to draw if the font has it
+ */
+bool toCP437(uint32_t cp, uint8_t* out);
+
+/**
+ * Decide how a non-ASCII code point is drawn at a text size
+ */
+GlyphSource lookup(uint32_t cp, uint8_t size);
+
+/**
+ * Advance of a non-ASCII code point in pixels (no bitmap access)
+ */
+int16_t charWidth(uint32_t cp, uint8_t size);
+
+/**
+ * Draw a face glyph
+ * @param drawRun Called for each horizontal run of set pixels, already
+ *                scaled to the text size
+ * @return Advance in pixels, or 0 if the glyph could not be loaded
+ */
+typedef void (*RunFn)(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+int16_t drawGlyph(int16_t x, int16_t y, uint32_t cp, uint16_t color, uint8_t size, RunFn drawRun);
+
+/**
+ * Check if any face is loaded
+ */
+bool isLoaded();
+
+/**
+ * Print loaded faces and cache statistics to Serial
+ */
+void printStatus();
+
+} // namespace Font
+
+#endif // MESHBERRY_FONT_H
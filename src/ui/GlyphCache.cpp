@@ -0,0 +1,334 @@
+/**
+ * MeshBerry Glyph Cache Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "GlyphCache.h"
+#include <stdlib.h>
+#include <string.h>
+
+namespace GlyphCache {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+struct Face {
+    FileHeader header;
+    RangeEntry* ranges;
+    uint32_t* advBase;      // Index of each range's first advance
+    uint8_t* advances;
+    uint32_t advanceCount;
+    ReadFn read;
+    void* ctx;
+    bool used;
+};
+
+struct Page {
+    uint8_t* data;          // PAGE_MAX_BYTES, allocated on first use
+    uint16_t offsets[MBF_RANGE_GLYPHS];
+    uint32_t lastUse;
+    uint16_t range;
+    int8_t face;            // -1 = free
+};
+
+static void* defaultAlloc(size_t len) { return malloc(len); }
+static void defaultFree(void* ptr) { free(ptr); }
+
+static AllocFn s_alloc = defaultAlloc;
+static FreeFn s_free = defaultFree;
+
+static Face s_faces[MAX_FACES];
+static Page s_pages[CACHE_PAGES] = {};
+static bool s_pagesInit = false;
+static uint8_t* s_scratch = nullptr;    // Compressed range being read
+static uint32_t s_useClock = 0;
+static Stats s_stats;
+
+// Ranges are stored as-is when coding would not shrink them
+static constexpr size_t SCRATCH_BYTES = PAGE_MAX_BYTES;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static void initPages() {
+    if (s_pagesInit) return;
+    for (int i = 0; i < CACHE_PAGES; i++) {
+        s_pages[i].face = -1;
+    }
+    s_pagesInit = true;
+}
+
+static Face* getFace(int face) {
+    if (face < 0 || face >= MAX_FACES || !s_faces[face].used) return nullptr;
+    return &s_faces[face];
+}
+
+static size_t glyphBytes(uint8_t width, uint8_t height) {
+    return ((size_t)width * height + 7) / 8;
+}
+
+/**
+ * Range holding a code point, -1 if none (ranges are sorted by firstCp)
+ */
+static int findRange(const Face& f, uint32_t cp) {
+    int lo = 0;
+    int hi = (int)f.header.rangeCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        const RangeEntry& r = f.ranges[mid];
+        if (cp < r.firstCp) {
+            hi = mid - 1;
+        } else if (cp >= r.firstCp + r.count) {
+            lo = mid + 1;
+        } else {
+            return mid;
+        }
+    }
+    return -1;
+}
+
+static void freeFace(Face& f) {
+    if (f.ranges) s_free(f.ranges);
+    if (f.advBase) s_free(f.advBase);
+    if (f.advances) s_free(f.advances);
+    memset(&f, 0, sizeof(f));
+}
+
+/**
+ * Read, decompress and index one range into a page
+ */
+static bool loadPage(Page& page, int faceId, int rangeIdx) {
+    Face& f = s_faces[faceId];
+    const RangeEntry& r = f.ranges[rangeIdx];
+
+    if (r.rawSize > PAGE_MAX_BYTES || r.packedSize > SCRATCH_BYTES) return false;
+    if (!page.data) {
+        page.data = (uint8_t*)s_alloc(PAGE_MAX_BYTES);
+        if (!page.data) return false;
+    }
+    if (!s_scratch) {
+        s_scratch = (uint8_t*)s_alloc(SCRATCH_BYTES);
+        if (!s_scratch) return false;
+    }
+
+    if (!f.read(f.ctx, r.dataOffset, s_scratch, r.packedSize)) return false;
+    s_stats.bytesRead += r.packedSize;
+    if (r.packedSize == r.rawSize) {
+        memcpy(page.data, s_scratch, r.rawSize);
+    } else if (!decompress(s_scratch, r.packedSize, page.data, r.rawSize)) {
+        return false;
+    }
+
+    // Glyph offsets follow from the advances
+    const uint8_t* adv = f.advances + f.advBase[rangeIdx];
+    uint32_t offset = 0;
+    for (int i = 0; i < r.count; i++) {
+        page.offsets[i] = (uint16_t)offset;
+        offset += glyphBytes(adv[i], f.header.height);
+    }
+    if (offset != r.rawSize) return false;
+
+    page.face = (int8_t)faceId;
+    page.range = (uint16_t)rangeIdx;
+    return true;
+}
+
+// =============================================================================
+// API
+// =============================================================================
+
+void setAllocator(AllocFn alloc, FreeFn release) {
+    s_alloc = alloc ? alloc : defaultAlloc;
+    s_free = release ? release : defaultFree;
+}
+
+int openFace(ReadFn read, void* ctx) {
+    initPages();
+
+    int id = -1;
+    for (int i = 0; i < MAX_FACES; i++) {
+        if (!s_faces[i].used) { id = i; break; }
+    }
+    if (id < 0 || !read) return -1;
+
+    Face& f = s_faces[id];
+    memset(&f, 0, sizeof(f));
+    if (!read(ctx, 0, &f.header, sizeof(FileHeader)) ||
+        f.header.magic != MBF_MAGIC ||
+        f.header.height == 0 || f.header.height > MBF_MAX_HEIGHT ||
+        f.header.rangeCount == 0) {
+        return -1;
+    }
+
+    uint16_t n = f.header.rangeCount;
+    f.ranges = (RangeEntry*)s_alloc(n * sizeof(RangeEntry));
+    f.advBase = (uint32_t*)s_alloc(n * sizeof(uint32_t));
+    if (!f.ranges || !f.advBase ||
+        !read(ctx, sizeof(FileHeader), f.ranges, n * sizeof(RangeEntry))) {
+        freeFace(f);
+        return -1;
+    }
+
+    uint32_t total = 0;
+    for (int i = 0; i < n; i++) {
+        const RangeEntry& r = f.ranges[i];
+        bool sorted = i == 0 || r.firstCp >= f.ranges[i - 1].firstCp + f.ranges[i - 1].count;
+        if (r.count == 0 || r.count > MBF_RANGE_GLYPHS || !sorted) {
+            freeFace(f);
+            return -1;
+        }
+        f.advBase[i] = total;
+        total += r.count;
+    }
+
+    f.advances = (uint8_t*)s_alloc(total);
+    uint32_t advOffset = sizeof(FileHeader) + n * sizeof(RangeEntry);
+    if (!f.advances || !read(ctx, advOffset, f.advances, total)) {
+        freeFace(f);
+        return -1;
+    }
+    for (uint32_t i = 0; i < total; i++) {
+        if (f.advances[i] > MBF_MAX_ADVANCE) {
+            freeFace(f);
+            return -1;
+        }
+    }
+
+    f.advanceCount = total;
+    f.read = read;
+    f.ctx = ctx;
+    f.used = true;
+    return id;
+}
+
+void closeFace(int face) {
+    Face* f = getFace(face);
+    if (!f) return;
+    for (int i = 0; i < CACHE_PAGES; i++) {
+        if (s_pages[i].face == face) s_pages[i].face = -1;
+    }
+    freeFace(*f);
+}
+
+uint8_t faceHeight(int face) {
+    Face* f = getFace(face);
+    return f ? f->header.height : 0;
+}
+
+uint32_t faceGlyphCount(int face) {
+    Face* f = getFace(face);
+    return f ? f->header.glyphCount : 0;
+}
+
+uint16_t faceRangeCount(int face) {
+    Face* f = getFace(face);
+    return f ? f->header.rangeCount : 0;
+}
+
+size_t faceTableBytes(int face) {
+    Face* f = getFace(face);
+    if (!f) return 0;
+    return f->header.rangeCount * (sizeof(RangeEntry) + sizeof(uint32_t)) + f->advanceCount;
+}
+
+uint8_t advance(int face, uint32_t cp) {
+    Face* f = getFace(face);
+    if (!f) return 0;
+    int r = findRange(*f, cp);
+    if (r < 0) return 0;
+    return f->advances[f->advBase[r] + (cp - f->ranges[r].firstCp)];
+}
+
+bool getGlyph(int face, uint32_t cp, Glyph& out) {
+    Face* f = getFace(face);
+    if (!f) return false;
+    int r = findRange(*f, cp);
+    if (r < 0) return false;
+    uint32_t idx = cp - f->ranges[r].firstCp;
+    uint8_t width = f->advances[f->advBase[r] + idx];
+    if (width == 0) return false;
+
+    Page* page = nullptr;
+    Page* victim = nullptr;
+    for (int i = 0; i < CACHE_PAGES; i++) {
+        Page& p = s_pages[i];
+        if (p.face == face && p.range == r) { page = &p; break; }
+        if (!victim || (victim->face >= 0 && (p.face < 0 || p.lastUse < victim->lastUse))) {
+            victim = &p;
+        }
+    }
+
+    if (page) {
+        s_stats.hits++;
+    } else {
+        if (victim->face >= 0) s_stats.evictions++;
+        victim->face = -1;
+        if (!loadPage(*victim, face, r)) {
+            s_stats.failures++;
+            return false;
+        }
+        s_stats.misses++;
+        page = victim;
+    }
+
+    page->lastUse = ++s_useClock;
+    out.bits = page->data + page->offsets[idx];
+    out.width = width;
+    out.height = f->header.height;
+    return true;
+}
+
+bool decompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outLen) {
+    size_t o = 0;
+    for (size_t i = 0; i < inLen; i++) {
+        if (in[i] != 0) {
+            if (o >= outLen) return false;
+            out[o++] = in[i];
+            continue;
+        }
+        if (++i >= inLen) return false;
+        size_t run = in[i];
+        if (run == 0 || o + run > outLen) return false;
+        memset(out + o, 0, run);
+        o += run;
+    }
+    return o == outLen;
+}
+
+const Stats& getStats() {
+    return s_stats;
+}
+
+void resetStats() {
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+int cachedPages() {
+    int n = 0;
+    for (int i = 0; i < CACHE_PAGES; i++) {
+        if (s_pagesInit && s_pages[i].face >= 0) n++;
+    }
+    return n;
+}
+
+size_t cacheBytes() {
+    size_t bytes = s_scratch ? SCRATCH_BYTES : 0;
+    for (int i = 0; i < CACHE_PAGES; i++) {
+        if (s_pages[i].data) bytes += PAGE_MAX_BYTES;
+    }
+    return bytes;
+}
+
+void flushCache() {
+    for (int i = 0; i < CACHE_PAGES; i++) {
+        s_pages[i].face = -1;
+    }
+}
+
+} // namespace GlyphCache
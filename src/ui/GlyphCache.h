@@ -0,0 +1,158 @@
+/**
+ * MeshBerry Glyph Cache
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Bitmap font faces in the MBF format (tools/generate_font.py), loaded
+ * on demand into a small page cache.
+ *
+ * A face covers Unicode in ranges of up to 128 code points. At open only
+ * the range table and the per-glyph advances are read, so text can be
+ * measured without touching a bitmap. A range's bitmaps are read and
+ * expanded into a cache page the first time one of its glyphs is drawn;
+ * the least recently used page is recycled when the cache is full.
+ *
+ * No Arduino or filesystem dependencies: file access and memory come
+ * from caller-supplied functions, so the same code runs on a host.
+ */
+
+#ifndef MESHBERRY_GLYPH_CACHE_H
+#define MESHBERRY_GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace GlyphCache {
+
+// =============================================================================
+// FILE FORMAT
+// =============================================================================
+//
+// [FileHeader][RangeEntry x rangeCount][advances][range data...]
+//
+// advances: one byte per code point of every range, in range order
+//           (0 = no glyph). The bitmap width equals the advance.
+// range data: zero-run compressed (0x00 <n> = n zero bytes, any other
+//           byte is literal), or stored as-is when that is not smaller
+//           (packedSize == rawSize). Expanded, it is each present glyph's
+//           bitmap in code point order: width x height bits, row-major,
+//           MSB first, each glyph starting on a byte boundary.
+
+constexpr uint32_t MBF_MAGIC          = 0x3146424D;   // "MBF1"
+constexpr int      MBF_RANGE_GLYPHS   = 128;
+constexpr uint8_t  MBF_MAX_HEIGHT     = 16;
+constexpr uint8_t  MBF_MAX_ADVANCE    = 16;
+
+struct FileHeader {
+    uint32_t magic;
+    uint8_t height;         // Pixel rows per glyph
+    uint8_t flags;          // Reserved, 0
+    uint16_t rangeCount;
+    uint32_t glyphCount;
+    uint32_t reserved;
+};
+
+struct RangeEntry {
+    uint32_t firstCp;
+    uint32_t dataOffset;    // From start of file
+    uint16_t packedSize;
+    uint16_t rawSize;
+    uint8_t count;          // Code points in range (1-128)
+    uint8_t reserved[3];
+};
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr int      MAX_FACES          = 2;
+constexpr int      CACHE_PAGES        = 24;
+constexpr size_t   PAGE_MAX_BYTES     = MBF_RANGE_GLYPHS * MBF_MAX_ADVANCE * MBF_MAX_HEIGHT / 8;
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+typedef bool (*ReadFn)(void* ctx, uint32_t offset, void* buf, size_t len);
+typedef void* (*AllocFn)(size_t len);
+typedef void (*FreeFn)(void* ptr);
+
+/**
+ * A glyph bitmap, valid until the next getGlyph() call
+ */
+struct Glyph {
+    const uint8_t* bits;    // width x height bits, row-major, MSB first
+    uint8_t width;
+    uint8_t height;
+};
+
+struct Stats {
+    uint32_t hits;          // getGlyph() served from cache
+    uint32_t misses;        // Page loaded
+    uint32_t evictions;     // Page recycled for another range
+    uint32_t bytesRead;     // Compressed bytes read from the file
+    uint32_t failures;      // Read or decompress errors
+};
+
+// =============================================================================
+// API
+// =============================================================================
+
+/**
+ * Memory for tables and cache pages (default malloc/free)
+ */
+void setAllocator(AllocFn alloc, FreeFn release);
+
+/**
+ * Read a face's header, range table and advances
+ * @param read Reads `len` bytes at `offset`; called again on page misses
+ * @param ctx Passed to read
+ * @return Face id, or -1 if the file is invalid or no slot is free
+ */
+int openFace(ReadFn read, void* ctx);
+void closeFace(int face);
+
+uint8_t faceHeight(int face);
+uint32_t faceGlyphCount(int face);
+uint16_t faceRangeCount(int face);
+
+/**
+ * RAM held for a face's range table and advances
+ */
+size_t faceTableBytes(int face);
+
+/**
+ * Advance of a code point in pixels, 0 if the face has no glyph
+ * Table lookup only; never reads the file.
+ */
+uint8_t advance(int face, uint32_t cp);
+
+/**
+ * Get a glyph bitmap, loading its range into the cache on a miss
+ * @return false if the face has no glyph or the page could not be loaded
+ */
+bool getGlyph(int face, uint32_t cp, Glyph& out);
+
+/**
+ * Zero-run decompression used by the format
+ * @return true if `in` expanded to exactly `outLen` bytes
+ */
+bool decompress(const uint8_t* in, size_t inLen, uint8_t* out, size_t outLen);
+
+const Stats& getStats();
+void resetStats();
+
+int cachedPages();
+size_t cacheBytes();
+
+/**
+ * Drop all cached pages (faces stay open)
+ */
+void flushCache();
+
+} // namespace GlyphCache
+
+#endif // MESHBERRY_GLYPH_CACHE_H
@@ -10,12 +10,19 @@
 #include "../drivers/display.h"
 #include "../drivers/gps.h"
 #include "../drivers/keyboard.h"
+#include "../mesh/MeshBerryMesh.h"
+#include "../mesh/PositionBeacon.h"
+#include "../settings/SettingsManager.h"
 #include <Arduino.h>
 #include <stdio.h>
 #include <string.h>
 
 // External gpsPresent flag from main.cpp
 extern bool gpsPresent;
+extern MeshBerryMesh* theMesh;
+
+// Teammate rows that fit above the soft key bar
+static const int TEAM_MAX_ROWS = 9;
 
 void GpsScreen::onEnter() {
     _lastUpdate = 0;  // Force full redraw
@@ -23,7 +30,37 @@ void GpsScreen::onEnter() {
 }
 
 void GpsScreen::configureSoftKeys() {
-    SoftKeyBar::setLabels(nullptr, nullptr, "Back");
+    bool sharing = theMesh && theMesh->isPositionSharing();
+    SoftKeyBar::setLabels(_teamView ? "GPS" : "Team", sharing ? "Unshare" : "Share", "Back");
+}
+
+void GpsScreen::toggleView() {
+    _teamView = !_teamView;
+    _lastUpdate = 0;
+    _lastTeamDraw = 0;
+    configureSoftKeys();
+    requestRedraw();
+}
+
+void GpsScreen::toggleSharing() {
+    if (!theMesh) return;
+
+    DeviceSettings& ds = SettingsManager::getDeviceSettings();
+    bool enable = !theMesh->isPositionSharing();
+    if (enable && !SettingsManager::getChannelSettings().isPrivate(ds.posShareChannel)) {
+        Screens.showStatus("Set a private channel first: share on <ch>", 2500);
+        return;
+    }
+    ds.posShareEnabled = enable;
+    theMesh->setPositionSharing(ds.posShareEnabled, ds.posShareChannel, ds.posShareThresholdM);
+    SettingsManager::saveDeviceSettings();
+
+    // Beacons need a fix, so keep the receiver running while sharing
+    if (ds.posShareEnabled && gpsPresent && !GPS::isEnabled()) {
+        GPS::enable();
+    }
+    configureSoftKeys();
+    requestRedraw();
 }
 
 void GpsScreen::formatLatitude(double lat, char* buf, size_t bufSize) {
@@ -199,6 +236,61 @@ void GpsScreen::drawGpsData() {
     }
 }
 
+void GpsScreen::drawTeam() {
+    int16_t y = Theme::CONTENT_Y + 36;
+    char buf[48];
+    uint32_t now = millis();
+    bool haveFix = gpsPresent && GPS::hasFix();
+
+    int count = PositionBeacon::getTrackCount();
+    if (count == 0) {
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 80, Theme::SCREEN_WIDTH,
+                                  "No teammates heard", Theme::TEXT_SECONDARY, 1);
+        snprintf(buf, sizeof(buf), "Beacons on channel %d", theMesh ? theMesh->getPositionChannel() : 0);
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 96, Theme::SCREEN_WIDTH,
+                                  buf, Theme::GRAY_LIGHT, 1);
+        return;
+    }
+
+    for (int i = 0; i < count && i < TEAM_MAX_ROWS; i++) {
+        const PositionBeacon::Track* t = PositionBeacon::getTrack(i);
+        PositionBeacon::Fix p = t->positionAt(now);
+        uint32_t age = now - t->heardAt;
+
+        // Name from the node list, else the id
+        char name[16];
+        snprintf(name, sizeof(name), "%08X", t->id);
+        NodeInfo node;
+        if (theMesh && theMesh->findNode(t->id, node)) {
+            strncpy(name, node.name, sizeof(name) - 1);
+            name[sizeof(name) - 1] = '\0';
+        }
+
+        // Held (no longer extrapolated) positions are greyed out
+        uint16_t color = age > PositionBeacon::POS_EXTRAPOLATE_MAX_MS ? Theme::GRAY_LIGHT : Theme::WHITE;
+        Display::drawText(8, y, name, color, 1);
+
+        if (haveFix) {
+            double dist = GPS::distanceTo(p.lat, p.lon);
+            int bearing = (int)(GPS::bearingTo(p.lat, p.lon) + 0.5) % 360;
+            if (dist < 1000) {
+                snprintf(buf, sizeof(buf), "%4.0fm %03d", dist, bearing);
+            } else {
+                snprintf(buf, sizeof(buf), "%4.1fkm %03d", dist / 1000.0, bearing);
+            }
+        } else {
+            snprintf(buf, sizeof(buf), "%.4f,%.4f", p.lat, p.lon);
+        }
+        Display::drawText(110, y, buf, color, 1);
+
+        formatFixAge(age, buf, sizeof(buf));
+        char right[24];
+        snprintf(right, sizeof(right), "%.0fkm/h %s", p.speedMps * 3.6f, buf);
+        Display::drawTextRight(Theme::SCREEN_WIDTH - 8, y, right, Theme::TEXT_SECONDARY, 1);
+        y += 18;
+    }
+}
+
 void GpsScreen::draw(bool fullRedraw) {
     // Always clear content area on full redraw
     if (fullRedraw) {
@@ -207,12 +299,30 @@ void GpsScreen::draw(bool fullRedraw) {
                           Theme::BG_PRIMARY);
 
         // Title
-        Display::drawText(12, Theme::CONTENT_Y + 8, "GPS", Theme::ACCENT, 2);
+        Display::drawText(12, Theme::CONTENT_Y + 8, _teamView ? "Team" : "GPS", Theme::ACCENT, 2);
+        if (theMesh && theMesh->isPositionSharing()) {
+            Display::drawTextRight(Theme::SCREEN_WIDTH - 12, Theme::CONTENT_Y + 12,
+                                   "Sharing", Theme::GREEN, 1);
+        }
 
         // Divider below title
         Display::drawHLine(12, Theme::CONTENT_Y + 30, Theme::SCREEN_WIDTH - 24, Theme::DIVIDER);
     }
 
+    // Teammates are tracked with or without our own GPS; extrapolated
+    // positions move, so refresh once a second
+    if (_teamView) {
+        if (fullRedraw || millis() - _lastTeamDraw > 1000) {
+            if (gpsPresent) GPS::update();
+            Display::fillRect(0, Theme::CONTENT_Y + 32,
+                              Theme::SCREEN_WIDTH, Theme::CONTENT_HEIGHT - 32,
+                              Theme::BG_PRIMARY);
+            drawTeam();
+            _lastTeamDraw = millis();
+        }
+        return;
+    }
+
     // Handle different states
     if (!gpsPresent) {
         if (fullRedraw) {
@@ -267,31 +377,39 @@ void GpsScreen::draw(bool fullRedraw) {
 }
 
 bool GpsScreen::handleInput(const InputData& input) {
+    // Treat backspace as back since this screen has no text input
+    bool isBackKey = (input.event == InputEvent::KEY_PRESS && input.keyCode == KEY_BACKSPACE);
+    bool goBack = isBackKey ||
+                  input.event == InputEvent::BACK ||
+                  input.event == InputEvent::SOFTKEY_RIGHT ||
+                  input.event == InputEvent::TRACKBALL_LEFT;
+    bool view = input.event == InputEvent::SOFTKEY_LEFT;
+    bool share = input.event == InputEvent::SOFTKEY_CENTER;
+
     // Handle touch tap for soft keys
     if (input.event == InputEvent::TOUCH_TAP) {
-        int16_t ty = input.touchY;
-        int16_t tx = input.touchX;
-
-        // Soft key bar touch (Y >= 210)
-        if (ty >= Theme::SOFTKEY_BAR_Y) {
-            if (tx >= 214) {
-                // Right soft key = Back
-                Screens.goBack();
-            }
-            return true;
+        if (input.touchY < Theme::SOFTKEY_BAR_Y) return true;
+        if (input.touchX >= 214) {
+            goBack = true;
+        } else if (input.touchX >= 107) {
+            share = true;
+        } else {
+            view = true;
         }
-        return true;
     }
 
-    // Treat backspace as back since this screen has no text input
-    bool isBackKey = (input.event == InputEvent::KEY_PRESS && input.keyCode == KEY_BACKSPACE);
-    if (input.event == InputEvent::BACK ||
-        input.event == InputEvent::SOFTKEY_RIGHT ||
-        input.event == InputEvent::TRACKBALL_LEFT ||
-        isBackKey) {
+    if (goBack) {
         Screens.goBack();
         return true;
     }
+    if (view) {
+        toggleView();
+        return true;
+    }
+    if (share) {
+        toggleSharing();
+        return true;
+    }
 
     return false;
 }
@@ -23,10 +23,14 @@ public:
     void onExit() override {}
     void draw(bool fullRedraw) override;
     bool handleInput(const InputData& input) override;
-    const char* getTitle() const override { return "GPS"; }
+    const char* getTitle() const override { return _teamView ? "Team" : "GPS"; }
     void configureSoftKeys() override;
 
 private:
+    // Teammate list (position beacons) instead of our own fix
+    bool _teamView = false;
+    uint32_t _lastTeamDraw = 0;
+
     // Cached display values to detect changes for partial redraw
     double _lastLat = 0;
     double _lastLon = 0;
@@ -44,6 +48,9 @@ private:
     void drawNoGps();
     void drawAcquiring();
     void drawGpsData();
+    void drawTeam();
+    void toggleView();
+    void toggleSharing();
 
     // Format helpers
     void formatLatitude(double lat, char* buf, size_t bufSize);
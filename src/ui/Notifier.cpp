@@ -0,0 +1,197 @@
+/**
+ * MeshBerry Notifier Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "Notifier.h"
+#include "ScreenManager.h"
+#include "../drivers/audio.h"
+#include "../settings/SettingsManager.h"
+#include <string.h>
+
+namespace Notifier {
+
+// =============================================================================
+// PRIVATE STATE
+// =============================================================================
+
+static void (*s_badgeCallback)() = nullptr;
+
+// Current window
+static bool s_open = false;
+static uint32_t s_firstAt = 0;
+static uint32_t s_lastAt = 0;
+static uint16_t s_channelCount[MAX_CHANNELS];   // Unmuted channel messages
+static uint16_t s_dmCount = 0;
+static char s_dmSender[24];
+static bool s_dmManySenders = false;
+static uint16_t s_nodeCount = 0;
+
+static Stats s_stats;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static void touch() {
+    uint32_t now = millis();
+    if (!s_open) {
+        s_open = true;
+        s_firstAt = now;
+    }
+    s_lastAt = now;
+    s_stats.events++;
+}
+
+static void channelLabel(int idx, char* out, size_t outSize) {
+    const ChannelSettings& channels = SettingsManager::getChannelSettings();
+    if (idx < 0 || idx >= channels.numChannels) {
+        snprintf(out, outSize, "channel %d", idx);
+        return;
+    }
+    snprintf(out, outSize, "%s", channels.channels[idx].name);
+}
+
+/**
+ * Build the toast for the window, false if there is nothing to show
+ */
+static bool buildSummary(char* out, size_t outSize) {
+    int chanTotal = 0;
+    int chanDistinct = 0;
+    int lastChan = -1;
+    for (int i = 0; i < MAX_CHANNELS; i++) {
+        if (s_channelCount[i] == 0) continue;
+        chanTotal += s_channelCount[i];
+        chanDistinct++;
+        lastChan = i;
+    }
+
+    if (s_dmCount > 0 && chanTotal > 0) {
+        snprintf(out, outSize, "%d DM%s, %d channel msg%s",
+                 s_dmCount, s_dmCount == 1 ? "" : "s",
+                 chanTotal, chanTotal == 1 ? "" : "s");
+    } else if (s_dmCount == 1) {
+        snprintf(out, outSize, "DM from %s", s_dmSender);
+    } else if (s_dmCount > 1) {
+        if (s_dmManySenders) {
+            snprintf(out, outSize, "%d new DMs", s_dmCount);
+        } else {
+            snprintf(out, outSize, "%d DMs from %s", s_dmCount, s_dmSender);
+        }
+    } else if (chanDistinct == 1) {
+        char label[40];
+        channelLabel(lastChan, label, sizeof(label));
+        if (chanTotal == 1) {
+            snprintf(out, outSize, "New in %s", label);
+        } else {
+            snprintf(out, outSize, "%d new in %s", chanTotal, label);
+        }
+    } else if (chanDistinct > 1) {
+        snprintf(out, outSize, "%d new in %d channels", chanTotal, chanDistinct);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static void emit() {
+    if (!s_open) return;
+
+    char summary[48];
+    bool audible = buildSummary(summary, sizeof(summary));
+
+    // One tone per window: messages win over node discovery
+    DeviceSettings& settings = SettingsManager::getDeviceSettings();
+    if (audible) {
+        Audio::playAlertTone(settings.toneMessage);
+        Screens.showStatus(summary, NOTIFY_TOAST_MS);
+        s_stats.tones++;
+        Serial.printf("[NOTIFY] %s\n", summary);
+    } else if (s_nodeCount > 0) {
+        Audio::playAlertTone(settings.toneNodeConnect);
+        s_stats.tones++;
+    }
+
+    if (s_badgeCallback) {
+        s_badgeCallback();
+    }
+
+    memset(s_channelCount, 0, sizeof(s_channelCount));
+    s_dmCount = 0;
+    s_dmSender[0] = '\0';
+    s_dmManySenders = false;
+    s_nodeCount = 0;
+    s_open = false;
+    s_stats.windows++;
+}
+
+// =============================================================================
+// API
+// =============================================================================
+
+void setBadgeCallback(void (*callback)()) {
+    s_badgeCallback = callback;
+}
+
+void postChannelMessage(int channelIdx) {
+    touch();
+
+    const ChannelSettings& channels = SettingsManager::getChannelSettings();
+    if (channelIdx >= 0 && channelIdx < channels.numChannels &&
+        channels.channels[channelIdx].isMuted) {
+        s_stats.muted++;
+        return;
+    }
+    if (channelIdx >= 0 && channelIdx < MAX_CHANNELS) {
+        s_channelCount[channelIdx]++;
+    }
+}
+
+void postDirectMessage(const char* senderName) {
+    touch();
+
+    const char* name = senderName ? senderName : "Unknown";
+    if (s_dmCount == 0) {
+        strncpy(s_dmSender, name, sizeof(s_dmSender) - 1);
+        s_dmSender[sizeof(s_dmSender) - 1] = '\0';
+    } else if (strncmp(s_dmSender, name, sizeof(s_dmSender) - 1) != 0) {
+        s_dmManySenders = true;
+    }
+    s_dmCount++;
+}
+
+void postNodeDiscovered() {
+    touch();
+    s_nodeCount++;
+}
+
+void postUnreadChanged() {
+    touch();
+}
+
+void process() {
+    if (!s_open) return;
+
+    uint32_t now = millis();
+    if (now - s_lastAt >= NOTIFY_QUIET_MS || now - s_firstAt >= NOTIFY_MAX_WAIT_MS) {
+        emit();
+    }
+}
+
+void flush() {
+    emit();
+}
+
+bool hasPending() {
+    return s_open;
+}
+
+const Stats& getStats() {
+    return s_stats;
+}
+
+} // namespace Notifier
@@ -0,0 +1,91 @@
+/**
+ * MeshBerry Notifier
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Coalesces message notifications. Mesh callbacks post events here
+ * instead of playing a tone and updating badges themselves; events that
+ * arrive close together are gathered into a window, and the window is
+ * emitted as one tone, one status toast summarising it ("5 new in #ops")
+ * and one badge update. A catch-up burst of 20 messages costs one
+ * blocking tone instead of 20.
+ *
+ * Muted channels still count towards unread badges but never sound a
+ * tone or show a toast.
+ */
+
+#ifndef MESHBERRY_NOTIFIER_H
+#define MESHBERRY_NOTIFIER_H
+
+#include <Arduino.h>
+
+namespace Notifier {
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+constexpr uint32_t NOTIFY_QUIET_MS     = 600;   // Emit after this long with no new event
+constexpr uint32_t NOTIFY_MAX_WAIT_MS  = 2500;  // Emit at most this long after the first event
+constexpr uint32_t NOTIFY_TOAST_MS     = 3000;  // Status toast duration
+
+/**
+ * Counters
+ */
+struct Stats {
+    uint32_t events;        // Events posted
+    uint32_t windows;       // Windows emitted
+    uint32_t tones;         // Tones played
+    uint32_t muted;         // Events from muted channels
+};
+
+// =============================================================================
+// API
+// =============================================================================
+
+/**
+ * Set the function that refreshes unread badges (called once per window)
+ */
+void setBadgeCallback(void (*callback)());
+
+/**
+ * A live message arrived on a channel
+ */
+void postChannelMessage(int channelIdx);
+
+/**
+ * A direct message arrived
+ * @param senderName Display name, nullptr if unknown
+ */
+void postDirectMessage(const char* senderName);
+
+/**
+ * A new node was discovered (tone only, no toast)
+ */
+void postNodeDiscovered();
+
+/**
+ * Unread counts changed without new activity (badge only)
+ */
+void postUnreadChanged();
+
+/**
+ * Emit the window when it is due. Call from the main loop.
+ */
+void process();
+
+/**
+ * Emit any pending window now
+ */
+void flush();
+
+bool hasPending();
+
+const Stats& getStats();
+
+} // namespace Notifier
+
+#endif // MESHBERRY_NOTIFIER_H
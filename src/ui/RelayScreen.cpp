@@ -0,0 +1,178 @@
+/**
+ * MeshBerry Relay Coverage Screen Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ */
+
+#include "RelayScreen.h"
+#include "SoftKeyBar.h"
+#include "../drivers/display.h"
+#include "../drivers/keyboard.h"
+#include "../mesh/Topology.h"
+#include <stdio.h>
+
+uint32_t RelayScreen::statsProgress() {
+    const RelayStats::Totals& t = RelayStats::getTotals();
+    return t.sent * 65536 + t.copies;
+}
+
+void RelayScreen::onEnter() {
+    _scroll = 0;
+    _confirmReset = false;
+    reload();
+    requestRedraw();
+}
+
+void RelayScreen::configureSoftKeys() {
+    SoftKeyBar::setLabels(_confirmReset ? "Confirm" : "Reset", nullptr, "Back");
+}
+
+void RelayScreen::reload() {
+    _rowCount = RelayStats::getRepeaters(_rows, RelayStats::RELAY_MAX_REPEATERS);
+    if (_scroll > _rowCount - VISIBLE_ROWS) _scroll = _rowCount - VISIBLE_ROWS;
+    if (_scroll < 0) _scroll = 0;
+    _lastProgress = statsProgress();
+}
+
+void RelayScreen::update(uint32_t deltaMs) {
+    if (statsProgress() == _lastProgress) return;
+    reload();
+    requestRedraw();
+}
+
+void RelayScreen::draw(bool fullRedraw) {
+    const RelayStats::Totals& t = RelayStats::getTotals();
+    char buf[64];
+
+    Display::fillRect(0, Theme::CONTENT_Y, Theme::SCREEN_WIDTH, Theme::CONTENT_HEIGHT, Theme::BG_PRIMARY);
+    Display::drawText(12, Theme::CONTENT_Y + 4, "Relay Coverage", Theme::ACCENT, 2);
+
+    snprintf(buf, sizeof(buf), "%lu sent  %lu%% relayed", (unsigned long)t.sent,
+             (unsigned long)(t.sent ? t.relayed * 100 / t.sent : 0));
+    Display::drawTextRight(Theme::SCREEN_WIDTH - 8, Theme::CONTENT_Y + 10, buf, Theme::TEXT_SECONDARY, 1);
+    Display::drawHLine(12, Theme::CONTENT_Y + 26, Theme::SCREEN_WIDTH - 24, Theme::DIVIDER);
+
+    if (_rowCount == 0) {
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 70, Theme::SCREEN_WIDTH,
+                                  "No relays of our messages heard yet", Theme::TEXT_SECONDARY, 1);
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 86, Theme::SCREEN_WIDTH,
+                                  "Send on a channel to collect stats", Theme::TEXT_SECONDARY, 1);
+        return;
+    }
+
+    // Copies beyond the first of each message
+    snprintf(buf, sizeof(buf), "%lu copies heard, %lu%% duplicate",
+             (unsigned long)t.copies,
+             (unsigned long)(t.copies ? (t.copies - t.relayed) * 100 / t.copies : 0));
+    Display::drawText(8, Theme::CONTENT_Y + 32, buf, Theme::WHITE, 1);
+
+    drawTable();
+}
+
+void RelayScreen::drawTable() {
+    const RelayStats::Totals& t = RelayStats::getTotals();
+    uint32_t sent = t.sent ? t.sent : 1;
+    char buf[32];
+    int16_t y = TABLE_Y;
+
+    Display::drawText(8, y, "Repeater", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(120, y, "Cover", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(164, y, "1st", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(200, y, "Heard", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(244, y, "Dup", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(282, y, "SNR", Theme::TEXT_SECONDARY, 1);
+    y += ROW_HEIGHT;
+
+    for (int i = _scroll; i < _rowCount && i < _scroll + VISIBLE_ROWS; i++, y += ROW_HEIGHT) {
+        const RelayStats::Repeater& r = _rows[i];
+        const Topology::TopoNode* node = Topology::getNode(r.hash);
+        const char* name = (node && (node->flags & Topology::TOPO_NODE_NAMED)) ? node->name : "";
+
+        snprintf(buf, sizeof(buf), "%02X %.10s", r.hash, name);
+        Display::drawText(8, y, buf, Theme::WHITE, 1);
+
+        uint32_t cover = r.carried * 100 / sent;
+        snprintf(buf, sizeof(buf), "%lu%%", (unsigned long)cover);
+        Display::drawText(120, y, buf, cover >= 50 ? Theme::GREEN : Theme::WHITE, 1);
+
+        snprintf(buf, sizeof(buf), "%lu%%", (unsigned long)(r.firstHop * 100 / sent));
+        Display::drawText(164, y, buf, Theme::WHITE, 1);
+
+        if (r.heard == 0) {
+            Display::drawText(200, y, "-", Theme::GRAY_LIGHT, 1);
+            continue;
+        }
+
+        snprintf(buf, sizeof(buf), "%u", r.heard);
+        Display::drawText(200, y, buf, Theme::WHITE, 1);
+
+        float dup = r.duplicateRatio();
+        snprintf(buf, sizeof(buf), "%.0f%%", dup * 100.0f);
+        Display::drawText(244, y, buf, dup > 0.5f ? Theme::YELLOW : Theme::WHITE, 1);
+
+        snprintf(buf, sizeof(buf), "%.0f", r.snr);
+        Display::drawText(282, y, buf, Theme::WHITE, 1);
+    }
+
+    // More rows above or below
+    if (_scroll > 0) {
+        Display::fillTriangle(312, TABLE_Y + ROW_HEIGHT + 6, 308, TABLE_Y + ROW_HEIGHT + 10,
+                              316, TABLE_Y + ROW_HEIGHT + 10, Theme::TEXT_SECONDARY);
+    }
+    if (_scroll + VISIBLE_ROWS < _rowCount) {
+        Display::fillTriangle(312, y - 4, 308, y - 8, 316, y - 8, Theme::TEXT_SECONDARY);
+    }
+}
+
+bool RelayScreen::handleInput(const InputData& input) {
+    bool isBackKey = (input.event == InputEvent::KEY_PRESS && input.keyCode == KEY_BACKSPACE);
+    bool goBack = isBackKey || input.event == InputEvent::BACK || input.event == InputEvent::SOFTKEY_RIGHT;
+    bool reset = input.event == InputEvent::SOFTKEY_LEFT;
+
+    // Map soft key bar touches onto the same actions
+    if (input.event == InputEvent::TOUCH_TAP) {
+        if (input.touchY < Theme::SOFTKEY_BAR_Y) return true;
+        if (input.touchX >= 214) {
+            goBack = true;
+        } else if (input.touchX < 107) {
+            reset = true;
+        }
+    }
+
+    // Reset needs a second press; anything else cancels it
+    if (_confirmReset && !reset) {
+        _confirmReset = false;
+        configureSoftKeys();
+    }
+
+    if (goBack) {
+        Screens.goBack();
+        return true;
+    }
+    if (reset) {
+        if (_confirmReset) {
+            RelayStats::clear();
+            _confirmReset = false;
+            _scroll = 0;
+            reload();
+            requestRedraw();
+        } else {
+            _confirmReset = true;
+        }
+        configureSoftKeys();
+        return true;
+    }
+
+    if (input.event == InputEvent::TRACKBALL_UP && _scroll > 0) {
+        _scroll--;
+        requestRedraw();
+        return true;
+    }
+    if (input.event == InputEvent::TRACKBALL_DOWN && _scroll + VISIBLE_ROWS < _rowCount) {
+        _scroll++;
+        requestRedraw();
+        return true;
+    }
+    return false;
+}
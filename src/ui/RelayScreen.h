@@ -0,0 +1,51 @@
+/**
+ * MeshBerry Relay Coverage Screen
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * Which repeaters carry our channel messages, with coverage and
+ * duplicate overhead per repeater
+ */
+
+#ifndef MESHBERRY_RELAYSCREEN_H
+#define MESHBERRY_RELAYSCREEN_H
+
+#include "Screen.h"
+#include "ScreenManager.h"
+#include "../mesh/RelayStats.h"
+
+class RelayScreen : public Screen {
+public:
+    RelayScreen() = default;
+    ~RelayScreen() override = default;
+
+    ScreenId getId() const override { return ScreenId::RELAYS; }
+    void onEnter() override;
+    void onExit() override {}
+    void draw(bool fullRedraw) override;
+    bool handleInput(const InputData& input) override;
+    void update(uint32_t deltaMs) override;
+    const char* getTitle() const override { return "Relay Coverage"; }
+    void configureSoftKeys() override;
+
+private:
+    void reload();
+    void drawTable();
+
+    // Totals fingerprint so update() only redraws on change
+    static uint32_t statsProgress();
+
+    static constexpr int16_t TABLE_Y = Theme::CONTENT_Y + 48;
+    static constexpr int16_t ROW_HEIGHT = 14;
+    static constexpr int VISIBLE_ROWS = (Theme::CONTENT_HEIGHT - 62) / ROW_HEIGHT;
+
+    RelayStats::Repeater _rows[RelayStats::RELAY_MAX_REPEATERS];
+    int _rowCount = 0;
+    int _scroll = 0;
+    bool _confirmReset = false;
+
+    uint32_t _lastProgress = 0;
+};
+
+#endif // MESHBERRY_RELAYSCREEN_H
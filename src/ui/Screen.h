@@ -79,7 +79,11 @@ enum class ScreenId {
     CHANNELS,
     GPS,
     ABOUT,
-    EMOJI_PICKER    // Emoji selection screen
+    EMOJI_PICKER,   // Emoji selection screen
+    TOPOLOGY,       // Mesh topology graph
+    TRACE,          // Traceroute/ping diagnostics
+    SURVEY,         // Band survey spectrum
+    RELAYS          // Relay coverage per repeater
 };
 
 /**
@@ -167,7 +167,7 @@ private:
     void drawScreen(bool fullRedraw);
 
     // Registered screens
-    static constexpr int MAX_SCREENS = 16;
+    static constexpr int MAX_SCREENS = 24;
     Screen* _screens[MAX_SCREENS] = { nullptr };
     int _screenCount = 0;
 
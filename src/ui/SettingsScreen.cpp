@@ -42,6 +42,7 @@ const char* SettingsScreen::getTitle() const {
         case SETTINGS_GPS:     return "GPS Settings";
         case SETTINGS_POWER:   return "Sleep Mode";
         case SETTINGS_AUDIO:   return "Audio";
+        case SETTINGS_DIAGNOSTICS: return "Diagnostics";
         case SETTINGS_ABOUT:   return "About";
         default:               return "Settings";
     }
@@ -52,6 +53,8 @@ void SettingsScreen::configureSoftKeys() {
         SoftKeyBar::setLabels("<", "OK", ">");
     } else if (_currentLevel == SETTINGS_MAIN) {
         SoftKeyBar::setLabels(nullptr, "Select", "Back");
+    } else if (_currentLevel == SETTINGS_DIAGNOSTICS) {
+        SoftKeyBar::setLabels(nullptr, "Open", "Back");
     } else if (_currentLevel == SETTINGS_GPS || _currentLevel == SETTINGS_POWER || _currentLevel == SETTINGS_AUDIO) {
         SoftKeyBar::setLabels(nullptr, "Toggle", "Back");
     } else {
@@ -75,8 +78,9 @@ void SettingsScreen::buildMenu() {
             _menuItems[4] = { "GPS", "Power, RTC sync options", Icons::GPS_ICON, Theme::ACCENT, false, 0, nullptr };
             _menuItems[5] = { "Power", "Sleep timeout, wake sources", Icons::SETTINGS_ICON, Theme::ACCENT, false, 0, nullptr };
             _menuItems[6] = { "Audio", "Volume, notification tones", Icons::SETTINGS_ICON, Theme::ACCENT, false, 0, nullptr };
-            _menuItems[7] = { "About", "Version, licenses", Icons::INFO_ICON, Theme::ACCENT, false, 0, nullptr };
-            _menuItemCount = 8;
+            _menuItems[7] = { "Diagnostics", "Mesh topology, link tools", Icons::INFO_ICON, Theme::ACCENT, false, 0, nullptr };
+            _menuItems[8] = { "About", "Version, licenses", Icons::INFO_ICON, Theme::ACCENT, false, 0, nullptr };
+            _menuItemCount = 9;
             break;
 
         case SETTINGS_RADIO:
@@ -225,6 +229,14 @@ void SettingsScreen::buildMenu() {
             break;
         }
 
+        case SETTINGS_DIAGNOSTICS:
+            _menuItems[0] = { "Mesh Topology", "Graph of overheard links", nullptr, Theme::ACCENT, false, 0, nullptr };
+            _menuItems[1] = { "Traceroute", "Per-hop latency and loss", nullptr, Theme::ACCENT, false, 0, nullptr };
+            _menuItems[2] = { "Band Survey", "Noise floor across the band", nullptr, Theme::ACCENT, false, 0, nullptr };
+            _menuItems[3] = { "Relay Coverage", "Repeaters carrying our messages", nullptr, Theme::ACCENT, false, 0, nullptr };
+            _menuItemCount = 4;
+            break;
+
         case SETTINGS_ABOUT:
             _menuItems[0] = { "Version", MESHBERRY_VERSION, nullptr, Theme::ACCENT, false, 0, nullptr };
             _menuItems[1] = { "License", "GPL-3.0-or-later", nullptr, Theme::ACCENT, false, 0, nullptr };
@@ -467,13 +479,23 @@ void SettingsScreen::onItemSelected(int index) {
                 case 4: _currentLevel = SETTINGS_GPS; break;
                 case 5: _currentLevel = SETTINGS_POWER; break;
                 case 6: _currentLevel = SETTINGS_AUDIO; break;
-                case 7: _currentLevel = SETTINGS_ABOUT; break;
+                case 7: _currentLevel = SETTINGS_DIAGNOSTICS; break;
+                case 8: _currentLevel = SETTINGS_ABOUT; break;
             }
             buildMenu();
             configureSoftKeys();
             requestRedraw();
             break;
 
+        case SETTINGS_DIAGNOSTICS:
+            switch (index) {
+                case 0: Screens.navigateTo(ScreenId::TOPOLOGY); break;
+                case 1: Screens.navigateTo(ScreenId::TRACE); break;
+                case 2: Screens.navigateTo(ScreenId::SURVEY); break;
+                case 3: Screens.navigateTo(ScreenId::RELAYS); break;
+            }
+            break;
+
         case SETTINGS_RADIO:
             // Enter editing mode for this item
             _editingIndex = index;
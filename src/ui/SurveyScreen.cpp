@@ -0,0 +1,206 @@
+/**
+ * MeshBerry Band Survey Screen Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ */
+
+#include "SurveyScreen.h"
+#include "SoftKeyBar.h"
+#include "../drivers/display.h"
+#include "../drivers/keyboard.h"
+#include "../mesh/BandSurvey.h"
+#include "../settings/SettingsManager.h"
+#include <stdio.h>
+
+static const uint16_t DWELL_OPTIONS[] = { 20, 40, 100 };
+static const int DWELL_OPTION_COUNT = sizeof(DWELL_OPTIONS) / sizeof(DWELL_OPTIONS[0]);
+
+// Progress fingerprint so update() only redraws on change
+static uint32_t surveyProgress() {
+    const BandSurvey::Result& r = BandSurvey::getResult();
+    return (uint32_t)r.passDone * 1024 + r.nextChannel * 2 + (r.running ? 1 : 0);
+}
+
+void SurveyScreen::onEnter() {
+    _lastProgress = surveyProgress();
+    requestRedraw();
+}
+
+void SurveyScreen::configureSoftKeys() {
+    SoftKeyBar::setLabels("Dwell", BandSurvey::isRunning() ? "Stop" : "Start", "Back");
+}
+
+void SurveyScreen::toggleSurvey() {
+    if (BandSurvey::isRunning()) {
+        BandSurvey::stop();
+    } else if (!BandSurvey::start(SettingsManager::getRadioSettings(),
+                                  DWELL_OPTIONS[_dwellIndex], PASSES)) {
+        Serial.println("[SURVEY] Cannot start: no radio or no band for this region");
+    }
+    _lastProgress = surveyProgress();
+    configureSoftKeys();
+    requestRedraw();
+}
+
+void SurveyScreen::cycleDwell() {
+    _dwellIndex = (_dwellIndex + 1) % DWELL_OPTION_COUNT;
+    requestRedraw();
+}
+
+void SurveyScreen::update(uint32_t deltaMs) {
+    uint32_t progress = surveyProgress();
+    if (progress == _lastProgress) return;
+
+    // Throttle chart redraws while sweeping; always show the final state
+    bool finished = !BandSurvey::isRunning();
+    if (!finished && millis() - _lastRedrawAt < REDRAW_INTERVAL_MS) return;
+
+    _lastProgress = progress;
+    if (finished) configureSoftKeys();
+    requestRedraw();
+}
+
+void SurveyScreen::draw(bool fullRedraw) {
+    _lastRedrawAt = millis();
+    const BandSurvey::Result& r = BandSurvey::getResult();
+    char buf[64];
+
+    Display::fillRect(0, Theme::CONTENT_Y, Theme::SCREEN_WIDTH, Theme::CONTENT_HEIGHT, Theme::BG_PRIMARY);
+    Display::drawText(12, Theme::CONTENT_Y + 4, "Band Survey", Theme::ACCENT, 2);
+
+    RadioSettings& radio = SettingsManager::getRadioSettings();
+    if (r.running) {
+        snprintf(buf, sizeof(buf), "Pass %d/%d  ch %d/%d", r.passDone + 1, r.passes,
+                 r.nextChannel + 1, r.channelCount);
+    } else {
+        snprintf(buf, sizeof(buf), "%s  dwell %dms", radio.getRegionName(), DWELL_OPTIONS[_dwellIndex]);
+    }
+    Display::drawTextRight(Theme::SCREEN_WIDTH - 8, Theme::CONTENT_Y + 10, buf, Theme::TEXT_SECONDARY, 1);
+    Display::drawHLine(12, Theme::CONTENT_Y + 26, Theme::SCREEN_WIDTH - 24, Theme::DIVIDER);
+
+    if (r.channelCount == 0) {
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 70, Theme::SCREEN_WIDTH,
+                                  "Start to sweep the region's band", Theme::TEXT_SECONDARY, 1);
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 86, Theme::SCREEN_WIDTH,
+                                  "Mesh RX pauses briefly per channel", Theme::TEXT_SECONDARY, 1);
+        return;
+    }
+
+    drawChart();
+    drawSummary();
+}
+
+void SurveyScreen::drawChart() {
+    const BandSurvey::Result& r = BandSurvey::getResult();
+    char buf[32];
+
+    int16_t barWidth = CHART_WIDTH / r.channelCount;
+    if (barWidth < 1) barWidth = 1;
+    int16_t x0 = CHART_X + (CHART_WIDTH - barWidth * r.channelCount) / 2;
+    int16_t base = CHART_Y + CHART_HEIGHT;
+
+    // Grid every 20 dB
+    for (float dbm = -120.0f; dbm <= CHART_MAX_DBM; dbm += 20.0f) {
+        int16_t y = base - (int16_t)((dbm - CHART_MIN_DBM) * CHART_HEIGHT / (CHART_MAX_DBM - CHART_MIN_DBM));
+        Display::drawHLine(CHART_X, y, CHART_WIDTH, Theme::DIVIDER);
+        snprintf(buf, sizeof(buf), "%.0f", dbm);
+        Display::drawText(CHART_X, y - 9, buf, Theme::TEXT_SECONDARY, 1);
+    }
+
+    for (int i = 0; i < r.channelCount; i++) {
+        const BandSurvey::Channel& c = r.channels[i];
+        int16_t x = x0 + i * barWidth;
+        if (!c.visits) continue;
+
+        float level = c.floorDbm();
+        if (level < CHART_MIN_DBM) level = CHART_MIN_DBM;
+        if (level > CHART_MAX_DBM) level = CHART_MAX_DBM;
+        int16_t h = (int16_t)((level - CHART_MIN_DBM) * CHART_HEIGHT / (CHART_MAX_DBM - CHART_MIN_DBM));
+        uint16_t color = c.cadHits ? Theme::RED : (i == r.recommended ? Theme::GREEN : Theme::ACCENT);
+        Display::fillRect(x, base - h, barWidth > 1 ? barWidth - 1 : 1, h, color);
+
+        // Peak energy marker above the floor bar
+        float peak = c.peakDbm;
+        if (peak > level && peak <= CHART_MAX_DBM) {
+            int16_t py = base - (int16_t)((peak - CHART_MIN_DBM) * CHART_HEIGHT / (CHART_MAX_DBM - CHART_MIN_DBM));
+            Display::drawHLine(x, py, barWidth > 1 ? barWidth - 1 : 1, Theme::YELLOW);
+        }
+    }
+
+    // Mesh frequency and recommendation markers under the axis
+    if (r.currentChannel >= 0) {
+        int16_t x = x0 + r.currentChannel * barWidth + barWidth / 2;
+        Display::fillTriangle(x, base + 2, x - 3, base + 7, x + 3, base + 7, Theme::WHITE);
+    }
+    if (r.recommended >= 0 && r.recommended != r.currentChannel) {
+        int16_t x = x0 + r.recommended * barWidth + barWidth / 2;
+        Display::fillTriangle(x, base + 2, x - 3, base + 7, x + 3, base + 7, Theme::GREEN);
+    }
+
+    snprintf(buf, sizeof(buf), "%.3f", r.bandLowMHz);
+    Display::drawText(CHART_X, base + 9, buf, Theme::TEXT_SECONDARY, 1);
+    snprintf(buf, sizeof(buf), "%.3f MHz", r.bandHighMHz);
+    Display::drawTextRight(CHART_X + CHART_WIDTH, base + 9, buf, Theme::TEXT_SECONDARY, 1);
+}
+
+void SurveyScreen::drawSummary() {
+    const BandSurvey::Result& r = BandSurvey::getResult();
+    char buf[64];
+    int16_t y = CHART_Y + CHART_HEIGHT + 22;
+
+    if (r.currentChannel >= 0 && r.channels[r.currentChannel].visits) {
+        const BandSurvey::Channel& c = r.channels[r.currentChannel];
+        snprintf(buf, sizeof(buf), "Now  %.3f  %.0f dBm  CAD %d/%d",
+                 c.freqMHz, c.floorDbm(), c.cadHits, c.visits);
+        Display::drawText(8, y, buf, Theme::WHITE, 1);
+    }
+    y += 12;
+
+    if (r.recommended >= 0) {
+        const BandSurvey::Channel& c = r.channels[r.recommended];
+        if (r.recommended == r.currentChannel) {
+            snprintf(buf, sizeof(buf), "Best: keep current frequency");
+        } else {
+            snprintf(buf, sizeof(buf), "Best %.3f  %.0f dBm  CAD %d/%d",
+                     c.freqMHz, c.floorDbm(), c.cadHits, c.visits);
+        }
+        Display::drawText(8, y, buf, Theme::GREEN, 1);
+    } else if (r.running) {
+        Display::drawText(8, y, "Sweeping...", Theme::ACCENT, 1);
+    }
+}
+
+bool SurveyScreen::handleInput(const InputData& input) {
+    bool isBackKey = (input.event == InputEvent::KEY_PRESS && input.keyCode == KEY_BACKSPACE);
+    bool goBack = isBackKey || input.event == InputEvent::BACK || input.event == InputEvent::SOFTKEY_RIGHT;
+    bool dwell = input.event == InputEvent::SOFTKEY_LEFT;
+    bool toggle = input.event == InputEvent::SOFTKEY_CENTER || input.event == InputEvent::TRACKBALL_CLICK;
+
+    // Map soft key bar touches onto the same actions
+    if (input.event == InputEvent::TOUCH_TAP) {
+        if (input.touchY < Theme::SOFTKEY_BAR_Y) return true;
+        if (input.touchX >= 214) {
+            goBack = true;
+        } else if (input.touchX >= 107) {
+            toggle = true;
+        } else {
+            dwell = true;
+        }
+    }
+
+    if (goBack) {
+        // A running sweep keeps going in the background
+        Screens.goBack();
+        return true;
+    }
+    if (toggle) {
+        toggleSurvey();
+        return true;
+    }
+    if (dwell) {
+        if (!BandSurvey::isRunning()) cycleDwell();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,52 @@
+/**
+ * MeshBerry Band Survey Screen
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * Spectrum chart of noise floor and LoRa activity across the region's band
+ */
+
+#ifndef MESHBERRY_SURVEYSCREEN_H
+#define MESHBERRY_SURVEYSCREEN_H
+
+#include "Screen.h"
+#include "ScreenManager.h"
+
+class SurveyScreen : public Screen {
+public:
+    SurveyScreen() = default;
+    ~SurveyScreen() override = default;
+
+    ScreenId getId() const override { return ScreenId::SURVEY; }
+    void onEnter() override;
+    void onExit() override {}
+    void draw(bool fullRedraw) override;
+    bool handleInput(const InputData& input) override;
+    void update(uint32_t deltaMs) override;
+    const char* getTitle() const override { return "Band Survey"; }
+    void configureSoftKeys() override;
+
+private:
+    void toggleSurvey();
+    void cycleDwell();
+
+    void drawChart();
+    void drawSummary();
+
+    static constexpr int16_t CHART_X = 4;
+    static constexpr int16_t CHART_WIDTH = Theme::SCREEN_WIDTH - 8;
+    static constexpr int16_t CHART_Y = Theme::CONTENT_Y + 44;
+    static constexpr int16_t CHART_HEIGHT = 96;
+    static constexpr float CHART_MIN_DBM = -135.0f;
+    static constexpr float CHART_MAX_DBM = -75.0f;
+    static constexpr uint32_t REDRAW_INTERVAL_MS = 500;
+    static constexpr uint8_t PASSES = 3;
+
+    int _dwellIndex = 1;    // Index into the dwell options (ms per channel visit)
+
+    uint32_t _lastProgress = 0;
+    uint32_t _lastRedrawAt = 0;
+};
+
+#endif // MESHBERRY_SURVEYSCREEN_H
@@ -94,7 +94,7 @@ const char* truncateText(const char* text, int16_t maxWidth, uint8_t size) {
 }
 
 int wrapText(const char* text, int16_t maxWidth, uint8_t size,
-             char lines[][64], int maxLines) {
+             char lines[][64], int maxLines, int16_t* lineWidths) {
     if (!text || maxWidth < 30 || maxLines < 1) return 0;
 
     int lineCount = 0;
@@ -104,22 +104,39 @@ int wrapText(const char* text, int16_t maxWidth, uint8_t size,
     int16_t charWidth = (size >= 2) ? CHAR_WIDTH_L : CHAR_WIDTH_S;
 
     while (*p && lineCount < maxLines) {
-        // Find end of word (space or null)
+        // Measure the word (up to a space or null) in the same pass that
+        // finds its end. The bytes kept stop at the line buffer size and
+        // never split a UTF-8 sequence.
         const char* wordEnd = p;
-        while (*wordEnd && *wordEnd != ' ') wordEnd++;
-
-        // Calculate word width
-        int wordLen = wordEnd - p;
-        char wordBuf[64];
-        if (wordLen >= 64) wordLen = 63;
-        strncpy(wordBuf, p, wordLen);
-        wordBuf[wordLen] = '\0';
-        int16_t wordWidth = Emoji::textWidth(wordBuf, size);
+        int16_t wordWidth = 0;
+        int keepLen = 0;
+        int16_t keepWidth = 0;
+        while (*wordEnd && *wordEnd != ' ') {
+            uint8_t c = (uint8_t)*wordEnd;
+            int bytes = 1;
+            int16_t cw = charWidth;
+            if (c >= 0x80) {
+                uint32_t cp;
+                bytes = Emoji::decodeUTF8(wordEnd, &cp);
+                if (bytes == 0) {
+                    bytes = 1;
+                } else {
+                    cw = Emoji::charWidth(cp, size);
+                }
+            }
+            wordEnd += bytes;
+            wordWidth += cw;
+            if (wordEnd - p <= 62) {
+                keepLen = wordEnd - p;
+                keepWidth = wordWidth;
+            }
+        }
 
         // Would word fit on current line?
         if (linePos > 0 && lineWidth + charWidth + wordWidth > maxWidth) {
             // Finish current line, start new
             lines[lineCount][linePos] = '\0';
+            if (lineWidths) lineWidths[lineCount] = lineWidth;
             lineCount++;
             linePos = 0;
             lineWidth = 0;
@@ -133,10 +150,23 @@ int wrapText(const char* text, int16_t maxWidth, uint8_t size,
         }
 
         // Add word (truncate if single word too long)
-        for (int i = 0; i < wordLen && linePos < 62; i++) {
-            lines[lineCount][linePos++] = p[i];
+        if (linePos + keepLen > 62) {
+            keepLen = 0;
+            keepWidth = 0;
+            for (const char* q = p; q < wordEnd; ) {
+                uint32_t cp;
+                int bytes = Emoji::decodeUTF8(q, &cp);
+                int16_t cw = bytes ? Emoji::charWidth(cp, size) : charWidth;
+                if (bytes == 0) bytes = 1;
+                if (linePos + keepLen + bytes > 62) break;
+                keepLen += bytes;
+                keepWidth += cw;
+                q += bytes;
+            }
         }
-        lineWidth += wordWidth;
+        memcpy(&lines[lineCount][linePos], p, keepLen);
+        linePos += keepLen;
+        lineWidth += keepWidth;
 
         // Move past word and space
         p = wordEnd;
@@ -146,6 +176,7 @@ int wrapText(const char* text, int16_t maxWidth, uint8_t size,
     // Finish last line
     if (linePos > 0 && lineCount < maxLines) {
         lines[lineCount][linePos] = '\0';
+        if (lineWidths) lineWidths[lineCount] = lineWidth;
         lineCount++;
     }
 
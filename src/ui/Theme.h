@@ -240,16 +240,17 @@ const char* truncateText(const char* text, int16_t maxWidth, uint8_t size = FONT
 
 /**
  * Word-wrap text into lines that fit within maxWidth
- * Uses emoji-aware width calculation for accurate wrapping
+ * Measures and wraps in one pass with emoji-aware widths
  * @param text Input text to wrap
  * @param maxWidth Maximum pixel width per line
  * @param size Font size (1 or 2)
  * @param lines Output array of line buffers (each 64 chars)
  * @param maxLines Maximum number of lines to output
+ * @param lineWidths Optional output: pixel width of each line
  * @return Number of lines produced
  */
 int wrapText(const char* text, int16_t maxWidth, uint8_t size,
-             char lines[][64], int maxLines);
+             char lines[][64], int maxLines, int16_t* lineWidths = nullptr);
 
 } // namespace Theme
 
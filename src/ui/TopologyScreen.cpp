@@ -0,0 +1,223 @@
+/**
+ * MeshBerry Topology Screen Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ */
+
+#include "TopologyScreen.h"
+#include "SoftKeyBar.h"
+#include "../drivers/display.h"
+#include "../drivers/keyboard.h"
+#include "../mesh/Topology.h"
+#include "../mesh/MeshBerryMesh.h"
+#include <stdio.h>
+
+// Edge colour thresholds (ETX)
+static constexpr float ETX_GOOD = 1.5f;
+static constexpr float ETX_FAIR = 3.0f;
+
+static uint16_t etxColor(float etx) {
+    if (etx < ETX_GOOD) return Theme::GREEN;
+    if (etx < ETX_FAIR) return Theme::YELLOW;
+    return Theme::RED;
+}
+
+void TopologyScreen::onEnter() {
+    _layoutAccumMs = 0;
+    _drawnVersion = Topology::getVersion();
+    // Settle the existing layout a bit before the first frame
+    Topology::layoutStep(10);
+    requestRedraw();
+}
+
+void TopologyScreen::configureSoftKeys() {
+    SoftKeyBar::setLabels("Prev", "Next", "Back");
+}
+
+void TopologyScreen::update(uint32_t deltaMs) {
+    _layoutAccumMs += deltaMs;
+    if (_layoutAccumMs < LAYOUT_INTERVAL_MS) return;
+    _layoutAccumMs = 0;
+
+    // Incremental layout: a couple of iterations per tick keeps the UI responsive
+    float energy = Topology::layoutStep(2);
+    if (energy > 0.0f || _drawnVersion != Topology::getVersion()) {
+        _drawnVersion = Topology::getVersion();
+        requestRedraw();
+    }
+}
+
+void TopologyScreen::draw(bool fullRedraw) {
+    // Node positions move every frame, so always repaint the graph area
+    Display::fillRect(0, Theme::CONTENT_Y,
+                      Theme::SCREEN_WIDTH, Theme::CONTENT_HEIGHT,
+                      Theme::BG_PRIMARY);
+
+    if (Topology::getEdgeCount() == 0) {
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 70,
+                                  Theme::SCREEN_WIDTH,
+                                  "No links heard yet", Theme::TEXT_SECONDARY, 2);
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 100,
+                                  Theme::SCREEN_WIDTH,
+                                  "Graph builds from overheard paths", Theme::GRAY_LIGHT, 1);
+        return;
+    }
+
+    // Fit the layout into the graph area
+    float minX, minY, maxX, maxY;
+    Topology::getLayoutBounds(minX, minY, maxX, maxY);
+    const int16_t margin = 8;
+    float spanX = maxX - minX;
+    float spanY = maxY - minY;
+    float scaleX = (Theme::SCREEN_WIDTH - 2 * margin) / spanX;
+    float scaleY = (GRAPH_HEIGHT - 2 * margin) / spanY;
+    float scale = (scaleX < scaleY) ? scaleX : scaleY;
+    float offX = margin + ((Theme::SCREEN_WIDTH - 2 * margin) - spanX * scale) / 2;
+    float offY = GRAPH_Y + margin + ((GRAPH_HEIGHT - 2 * margin) - spanY * scale) / 2;
+
+    auto toScreenX = [&](float x) { return (int16_t)(offX + (x - minX) * scale); };
+    auto toScreenY = [&](float y) { return (int16_t)(offY + (y - minY) * scale); };
+
+    // Edges first so nodes are drawn on top
+    for (int s = 0; s < Topology::TOPO_EDGE_SLOTS; s++) {
+        const Topology::TopoEdge* e = Topology::getEdgeSlot(s);
+        if (!e) continue;
+        const Topology::TopoNode* a = Topology::getNode(e->a);
+        const Topology::TopoNode* b = Topology::getNode(e->b);
+        uint16_t color = etxColor(e->etx);
+        if (_selected >= 0 && e->a != _selected && e->b != _selected) {
+            color = Theme::DIVIDER;
+        }
+        Display::drawLine(toScreenX(a->x), toScreenY(a->y),
+                          toScreenX(b->x), toScreenY(b->y), color);
+    }
+
+    uint8_t selfHash = Topology::getSelfHash();
+    for (int i = 0; i < Topology::TOPO_MAX_NODES; i++) {
+        const Topology::TopoNode* n = Topology::getNode((uint8_t)i);
+        if (!(n->flags & Topology::TOPO_NODE_ACTIVE)) continue;
+
+        int16_t x = toScreenX(n->x);
+        int16_t y = toScreenY(n->y);
+        int16_t r = (n->type == NODE_TYPE_REPEATER) ? 4 : 3;
+        uint16_t color = Theme::GRAY_LIGHT;
+        if (i == selfHash) {
+            color = Theme::ACCENT;
+            r = 5;
+        } else if (n->flags & Topology::TOPO_NODE_NAMED) {
+            color = Theme::WHITE;
+        }
+        Display::fillCircle(x, y, r, color);
+
+        if (i == _selected) {
+            Display::drawCircle(x, y, r + 3, Theme::ACCENT);
+        }
+    }
+
+    drawFooter();
+}
+
+void TopologyScreen::drawFooter() {
+    char buf[64];
+
+    Display::drawHLine(0, FOOTER_Y, Theme::SCREEN_WIDTH, Theme::DIVIDER);
+
+    if (_selected < 0) {
+        snprintf(buf, sizeof(buf), "%d nodes, %d links",
+                 Topology::getNodeCount(), Topology::getEdgeCount());
+        Display::drawText(8, FOOTER_Y + 8, buf, Theme::TEXT_SECONDARY, 1);
+        return;
+    }
+
+    const Topology::TopoNode* n = Topology::getNode((uint8_t)_selected);
+
+    // Best link of the selected node
+    const Topology::TopoEdge* best = nullptr;
+    for (int s = 0; s < Topology::TOPO_EDGE_SLOTS; s++) {
+        const Topology::TopoEdge* e = Topology::getEdgeSlot(s);
+        if (!e || (e->a != _selected && e->b != _selected)) continue;
+        if (!best || e->etx < best->etx) best = e;
+    }
+
+    const char* name = (n->flags & Topology::TOPO_NODE_NAMED) ? n->name : "?";
+    if (_selected == Topology::getSelfHash()) name = "This node";
+
+    if (best && (best->flags & Topology::TOPO_EDGE_MEASURED)) {
+        snprintf(buf, sizeof(buf), "%.12s [%02X] deg %d  ETX %.1f  %.1fdB",
+                 name, _selected, n->degree, best->etx, best->snr);
+    } else if (best) {
+        snprintf(buf, sizeof(buf), "%.12s [%02X] deg %d  ETX ~%.1f",
+                 name, _selected, n->degree, best->etx);
+    } else {
+        snprintf(buf, sizeof(buf), "%.12s [%02X] no links", name, _selected);
+    }
+    Display::drawText(8, FOOTER_Y + 8, buf, Theme::WHITE, 1);
+}
+
+void TopologyScreen::selectNext(int direction) {
+    int start = (_selected < 0) ? (direction > 0 ? -1 : Topology::TOPO_MAX_NODES) : _selected;
+    for (int step = 1; step <= Topology::TOPO_MAX_NODES; step++) {
+        int h = start + direction * step;
+        if (h < 0 || h >= Topology::TOPO_MAX_NODES) {
+            // Walked off the end: clear selection (shows graph summary)
+            _selected = -1;
+            requestRedraw();
+            return;
+        }
+        const Topology::TopoNode* n = Topology::getNode((uint8_t)h);
+        if (n && (n->flags & Topology::TOPO_NODE_ACTIVE)) {
+            _selected = h;
+            requestRedraw();
+            return;
+        }
+    }
+}
+
+bool TopologyScreen::handleInput(const InputData& input) {
+    // Handle touch tap for soft keys
+    if (input.event == InputEvent::TOUCH_TAP) {
+        int16_t ty = input.touchY;
+        int16_t tx = input.touchX;
+
+        if (ty >= Theme::SOFTKEY_BAR_Y) {
+            if (tx < 107) {
+                selectNext(-1);
+            } else if (tx < 214) {
+                selectNext(1);
+            } else {
+                Screens.goBack();
+            }
+        }
+        return true;
+    }
+
+    // Treat backspace as back since this screen has no text input
+    bool isBackKey = (input.event == InputEvent::KEY_PRESS && input.keyCode == KEY_BACKSPACE);
+    if (isBackKey) {
+        Screens.goBack();
+        return true;
+    }
+
+    switch (input.event) {
+        case InputEvent::TRACKBALL_UP:
+        case InputEvent::SOFTKEY_LEFT:
+            selectNext(-1);
+            return true;
+
+        case InputEvent::TRACKBALL_DOWN:
+        case InputEvent::SOFTKEY_CENTER:
+        case InputEvent::TRACKBALL_CLICK:
+            selectNext(1);
+            return true;
+
+        case InputEvent::BACK:
+        case InputEvent::SOFTKEY_RIGHT:
+        case InputEvent::TRACKBALL_LEFT:
+            Screens.goBack();
+            return true;
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,47 @@
+/**
+ * MeshBerry Topology Screen
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * Force-directed graph of the passively learned mesh topology
+ */
+
+#ifndef MESHBERRY_TOPOLOGYSCREEN_H
+#define MESHBERRY_TOPOLOGYSCREEN_H
+
+#include "Screen.h"
+#include "ScreenManager.h"
+
+class TopologyScreen : public Screen {
+public:
+    TopologyScreen() = default;
+    ~TopologyScreen() override = default;
+
+    ScreenId getId() const override { return ScreenId::TOPOLOGY; }
+    void onEnter() override;
+    void onExit() override {}
+    void draw(bool fullRedraw) override;
+    bool handleInput(const InputData& input) override;
+    void update(uint32_t deltaMs) override;
+    const char* getTitle() const override { return "Topology"; }
+    void configureSoftKeys() override;
+
+private:
+    // Cycle selection through active vertices in hash order
+    void selectNext(int direction);
+
+    // Draw selected node details below the graph
+    void drawFooter();
+
+    static constexpr int16_t GRAPH_Y = Theme::CONTENT_Y + 2;
+    static constexpr int16_t GRAPH_HEIGHT = Theme::CONTENT_HEIGHT - 28;
+    static constexpr int16_t FOOTER_Y = GRAPH_Y + GRAPH_HEIGHT + 2;
+    static constexpr uint32_t LAYOUT_INTERVAL_MS = 100;
+
+    int _selected = -1;             // Selected vertex hash, -1 = none
+    uint32_t _layoutAccumMs = 0;
+    uint32_t _drawnVersion = 0;
+};
+
+#endif // MESHBERRY_TOPOLOGYSCREEN_H
@@ -0,0 +1,283 @@
+/**
+ * MeshBerry Trace Screen Implementation
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ */
+
+#include "TraceScreen.h"
+#include "SoftKeyBar.h"
+#include "Icons.h"
+#include "../drivers/display.h"
+#include "../drivers/keyboard.h"
+#include "../mesh/MeshBerryMesh.h"
+#include "../mesh/Topology.h"
+#include "../settings/SettingsManager.h"
+#include <stdio.h>
+
+// External mesh instance from main.cpp
+extern MeshBerryMesh* theMesh;
+
+TraceScreen::TraceScreen() {
+    _listView.setBounds(0, Theme::CONTENT_Y + 30, Theme::SCREEN_WIDTH, Theme::CONTENT_HEIGHT - 30);
+    _listView.setItemHeight(40);
+}
+
+void TraceScreen::onEnter() {
+    // Return to live results if a trace is still running
+    if (theMesh && theMesh->isTraceRunning()) {
+        _mode = Mode::RESULTS;
+    } else {
+        _mode = Mode::SELECT_TARGET;
+        buildTargets();
+    }
+    _lastProgress = reportProgress();
+    requestRedraw();
+}
+
+void TraceScreen::configureSoftKeys() {
+    if (_mode == Mode::SELECT_TARGET) {
+        SoftKeyBar::setLabels("Ping", "Trace", "Back");
+    } else if (theMesh && theMesh->isTraceRunning()) {
+        SoftKeyBar::setLabels(nullptr, "Stop", "Back");
+    } else {
+        SoftKeyBar::setLabels("Ping", "Trace", "Back");
+    }
+}
+
+void TraceScreen::addTarget(uint32_t id, const char* name, uint8_t hash) {
+    int n = _targetCount;
+    strncpy(_targetNames[n], name, sizeof(_targetNames[n]) - 1);
+    _targetNames[n][sizeof(_targetNames[n]) - 1] = '\0';
+    _targetIds[n] = id;
+
+    uint8_t path[TraceRoute::TRACE_MAX_HOPS];
+    int hops = theMesh ? theMesh->buildTracePath(id, path, TraceRoute::TRACE_MAX_HOPS) : -1;
+    if (hops > 0) {
+        snprintf(_targetInfo[n], sizeof(_targetInfo[n]), "[%02X] %d hop%s",
+                 hash, hops, hops == 1 ? "" : "s");
+    } else {
+        snprintf(_targetInfo[n], sizeof(_targetInfo[n]), "[%02X] no route", hash);
+    }
+
+    _targetItems[n] = { _targetNames[n], _targetInfo[n], Icons::CONTACTS_ICON,
+                        hops > 0 ? Theme::GREEN : Theme::GRAY_LIGHT, false, 0, nullptr };
+    _targetCount++;
+}
+
+void TraceScreen::buildTargets() {
+    ContactSettings& contacts = SettingsManager::getContactSettings();
+    int indices[MAX_TARGETS];
+    int count = contacts.getContactsByType(NODE_TYPE_REPEATER, indices, MAX_TARGETS);
+
+    // Saved repeaters first
+    _targetCount = 0;
+    for (int i = 0; i < count; i++) {
+        const ContactEntry* c = contacts.getContact(indices[i]);
+        if (c) addTarget(c->id, c->name, c->pubKey[0]);
+    }
+
+    // Then repeaters heard over the air, newest first. Repeaters are not
+    // admitted as contacts by default, so this is usually the whole list.
+    if (theMesh) {
+        NodeInfo node;
+        for (int c = theMesh->firstNode(node); c != MeshBerryMesh::NODE_END && _targetCount < MAX_TARGETS;
+             c = theMesh->nextNode(c, node)) {
+            if (node.type != NODE_TYPE_REPEATER || node.lastHeard == 0) continue;
+            if (contacts.findContact(node.id) >= 0) continue;
+            // Node IDs are the first key bytes, little-endian
+            addTarget(node.id, node.name, (uint8_t)(node.id & 0xFF));
+        }
+    }
+
+    _listView.setItems(_targetItems, _targetCount);
+    _listView.setSelectedIndex(0);
+}
+
+void TraceScreen::startProbe(bool pingOnly) {
+    if (!theMesh) return;
+
+    if (_mode == Mode::SELECT_TARGET) {
+        _selectedTarget = _listView.getSelectedIndex();
+    }
+    if (_selectedTarget < 0 || _selectedTarget >= _targetCount) return;
+
+    uint8_t path[TraceRoute::TRACE_MAX_HOPS];
+    int hops = theMesh->buildTracePath(_targetIds[_selectedTarget], path, TraceRoute::TRACE_MAX_HOPS);
+    if (hops <= 0) {
+        Serial.printf("[TRACE] No route to %s\n", _targetNames[_selectedTarget]);
+        return;
+    }
+
+    if (theMesh->startTrace(path, (uint8_t)hops, pingOnly ? PING_PROBES : TRACE_PROBES, pingOnly)) {
+        _mode = Mode::RESULTS;
+        _lastProgress = reportProgress();
+        configureSoftKeys();
+        requestRedraw();
+    }
+}
+
+uint32_t TraceScreen::reportProgress() const {
+    if (!theMesh) return 0;
+    const TraceRoute::Report& r = theMesh->getTraceReport();
+    uint32_t progress = r.running ? 1 : 0;
+    for (int i = 0; i < r.hopCount; i++) {
+        progress += (uint32_t)r.hops[i].sent * 256 + r.hops[i].received * 2;
+    }
+    return progress;
+}
+
+void TraceScreen::update(uint32_t deltaMs) {
+    if (_mode != Mode::RESULTS) return;
+
+    uint32_t progress = reportProgress();
+    if (progress != _lastProgress) {
+        _lastProgress = progress;
+        configureSoftKeys();
+        requestRedraw();
+    }
+}
+
+void TraceScreen::draw(bool fullRedraw) {
+    if (fullRedraw || _mode == Mode::RESULTS) {
+        Display::fillRect(0, Theme::CONTENT_Y,
+                          Theme::SCREEN_WIDTH, Theme::CONTENT_HEIGHT,
+                          Theme::BG_PRIMARY);
+
+        const char* title = (_mode == Mode::RESULTS && _selectedTarget >= 0)
+                            ? _targetNames[_selectedTarget] : "Traceroute";
+        Display::drawText(12, Theme::CONTENT_Y + 4, title, Theme::ACCENT, 2);
+        Display::drawHLine(12, Theme::CONTENT_Y + 26, Theme::SCREEN_WIDTH - 24, Theme::DIVIDER);
+    }
+
+    if (_mode == Mode::RESULTS) {
+        drawResults();
+        return;
+    }
+
+    if (_targetCount == 0) {
+        Display::drawTextCentered(0, Theme::CONTENT_Y + 80, Theme::SCREEN_WIDTH,
+                                  "No repeaters heard yet", Theme::TEXT_SECONDARY, 1);
+        return;
+    }
+    _listView.draw(fullRedraw);
+}
+
+void TraceScreen::drawResults() {
+    if (!theMesh) return;
+    const TraceRoute::Report& r = theMesh->getTraceReport();
+    char buf[64];
+    int16_t y = Theme::CONTENT_Y + 32;
+    const int16_t lineHeight = 16;
+
+    Display::drawText(8, y, "Hop", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(100, y, "RTT", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(160, y, "+Hop", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(212, y, "SNR", Theme::TEXT_SECONDARY, 1);
+    Display::drawText(262, y, "Loss", Theme::TEXT_SECONDARY, 1);
+    y += lineHeight;
+
+    int first = r.pingOnly ? r.hopCount - 1 : 0;
+    for (int i = first; i < r.hopCount; i++) {
+        const TraceRoute::HopStats& h = r.hops[i];
+        const Topology::TopoNode* node = Topology::getNode(h.hash);
+        const char* name = (node && (node->flags & Topology::TOPO_NODE_NAMED)) ? node->name : "";
+
+        snprintf(buf, sizeof(buf), "%d %02X %.6s", i + 1, h.hash, name);
+        Display::drawText(8, y, buf, Theme::WHITE, 1);
+
+        if (h.sent == 0) {
+            Display::drawText(100, y, (r.running && r.currentDepth == i + 1) ? "..." : "-",
+                              Theme::GRAY_LIGHT, 1);
+        } else if (h.received == 0) {
+            Display::drawText(100, y, "*", Theme::RED, 1);
+            Display::drawText(262, y, "100%", Theme::RED, 1);
+        } else {
+            snprintf(buf, sizeof(buf), "%.0fms", h.avgRttMs());
+            Display::drawText(100, y, buf, Theme::WHITE, 1);
+
+            if (!r.pingOnly) {
+                snprintf(buf, sizeof(buf), "%.0f", r.hopLatencyMs(i));
+                Display::drawText(160, y, buf, Theme::WHITE, 1);
+            }
+
+            float snr = h.avgSnr();
+            snprintf(buf, sizeof(buf), "%.1f", snr);
+            Display::drawText(212, y, buf, snr >= 0.0f ? Theme::GREEN : Theme::YELLOW, 1);
+
+            uint8_t loss = h.lossPercent();
+            snprintf(buf, sizeof(buf), "%d%%", loss);
+            Display::drawText(262, y, buf, loss == 0 ? Theme::GREEN : (loss < 50 ? Theme::YELLOW : Theme::RED), 1);
+        }
+        y += lineHeight;
+    }
+
+    y += 4;
+    if (r.running) {
+        snprintf(buf, sizeof(buf), "%s depth %d, probe %d/%d",
+                 r.pingOnly ? "Pinging" : "Tracing",
+                 r.currentDepth, r.currentProbe + 1, r.probesPerHop);
+        Display::drawText(8, y, buf, Theme::ACCENT, 1);
+    } else if (r.complete) {
+        Display::drawText(8, y, "Done. +Hop = one-way latency of link into hop", Theme::TEXT_SECONDARY, 1);
+    } else {
+        Display::drawText(8, y, "Stopped", Theme::YELLOW, 1);
+    }
+}
+
+bool TraceScreen::handleInput(const InputData& input) {
+    bool isBackKey = (input.event == InputEvent::KEY_PRESS && input.keyCode == KEY_BACKSPACE);
+    bool goBack = isBackKey || input.event == InputEvent::BACK || input.event == InputEvent::SOFTKEY_RIGHT;
+    bool ping = input.event == InputEvent::SOFTKEY_LEFT;
+    bool trace = input.event == InputEvent::SOFTKEY_CENTER || input.event == InputEvent::TRACKBALL_CLICK;
+
+    // Map soft key bar touches onto the same actions
+    if (input.event == InputEvent::TOUCH_TAP) {
+        if (input.touchY < Theme::SOFTKEY_BAR_Y) return true;
+        if (input.touchX >= 214) {
+            goBack = true;
+        } else if (input.touchX >= 107) {
+            trace = true;
+        } else {
+            ping = true;
+        }
+    }
+
+    if (goBack) {
+        if (_mode == Mode::RESULTS) {
+            // Leave results; a running trace keeps going in the background
+            _mode = Mode::SELECT_TARGET;
+            buildTargets();
+            if (_selectedTarget >= 0) _listView.setSelectedIndex(_selectedTarget);
+            configureSoftKeys();
+            requestRedraw();
+        } else {
+            Screens.goBack();
+        }
+        return true;
+    }
+
+    if (_mode == Mode::RESULTS && theMesh && theMesh->isTraceRunning()) {
+        if (trace) {
+            theMesh->cancelTrace();
+            configureSoftKeys();
+            requestRedraw();
+        }
+        return true;
+    }
+
+    if (ping || trace) {
+        startProbe(ping);
+        return true;
+    }
+
+    if (_mode == Mode::SELECT_TARGET &&
+        _listView.handleTrackball(input.event == InputEvent::TRACKBALL_UP,
+                                  input.event == InputEvent::TRACKBALL_DOWN,
+                                  false, false, false)) {
+        requestRedraw();
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,63 @@
+/**
+ * MeshBerry Trace Screen
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * Traceroute/ping diagnostics to repeaters with per-hop results
+ */
+
+#ifndef MESHBERRY_TRACESCREEN_H
+#define MESHBERRY_TRACESCREEN_H
+
+#include "Screen.h"
+#include "ScreenManager.h"
+#include "ListView.h"
+#include "../mesh/TraceRoute.h"
+
+class TraceScreen : public Screen {
+public:
+    TraceScreen();
+    ~TraceScreen() override = default;
+
+    ScreenId getId() const override { return ScreenId::TRACE; }
+    void onEnter() override;
+    void onExit() override {}
+    void draw(bool fullRedraw) override;
+    bool handleInput(const InputData& input) override;
+    void update(uint32_t deltaMs) override;
+    const char* getTitle() const override { return "Traceroute"; }
+    void configureSoftKeys() override;
+
+private:
+    enum class Mode { SELECT_TARGET, RESULTS };
+
+    // Rebuild repeater target list: contacts, then the peer table
+    void buildTargets();
+    void addTarget(uint32_t id, const char* name, uint8_t hash);
+
+    // Start a trace/ping to the selected target
+    void startProbe(bool pingOnly);
+
+    void drawResults();
+
+    // Progress fingerprint so update() only redraws on change
+    uint32_t reportProgress() const;
+
+    Mode _mode = Mode::SELECT_TARGET;
+
+    ListView _listView;
+    static constexpr int MAX_TARGETS = 16;
+    static constexpr uint8_t TRACE_PROBES = 3;
+    static constexpr uint8_t PING_PROBES = 10;
+    ListItem _targetItems[MAX_TARGETS];
+    char _targetNames[MAX_TARGETS][32];
+    char _targetInfo[MAX_TARGETS][32];
+    uint32_t _targetIds[MAX_TARGETS];
+    int _targetCount = 0;
+    int _selectedTarget = -1;
+
+    uint32_t _lastProgress = 0;
+};
+
+#endif // MESHBERRY_TRACESCREEN_H
@@ -0,0 +1,145 @@
+/**
+ * MeshBerry Flat Hash Map
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Fixed-capacity open-addressing map for integer keys (node ids, hashes,
+ * ACK CRCs). Linear probing from a multiplicative hash; erase shifts the
+ * following entries back instead of leaving tombstones, so lookups stay
+ * short however many inserts and erases have happened. No allocation.
+ *
+ * Size N for about twice the entries you expect: probes grow quickly
+ * past 75% load, and insert() fails once all N slots are used.
+ */
+
+#ifndef MESHBERRY_FLAT_HASH_MAP_H
+#define MESHBERRY_FLAT_HASH_MAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+template <typename K, typename V, size_t N>
+class FlatHashMap {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "FlatHashMap capacity must be a power of two");
+    static_assert(N <= 65536, "FlatHashMap capacity too large");
+    static constexpr uint32_t MASK = N - 1;
+
+    static constexpr int log2(size_t n) { return n <= 1 ? 0 : 1 + log2(n / 2); }
+    static constexpr int SHIFT = 32 - log2(N);
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    /**
+     * Look up a key
+     * @return Pointer to the value, or nullptr if absent
+     */
+    V* find(K key) {
+        int s = findSlot(key);
+        return s >= 0 ? &_values[s] : nullptr;
+    }
+    const V* find(K key) const {
+        int s = findSlot(key);
+        return s >= 0 ? &_values[s] : nullptr;
+    }
+
+    bool contains(K key) const { return findSlot(key) >= 0; }
+
+    /**
+     * Insert or overwrite a key
+     * @return Pointer to the stored value, or nullptr if the map is full
+     */
+    V* put(K key, const V& value) {
+        V* v = insert(key);
+        if (v) *v = value;
+        return v;
+    }
+
+    /**
+     * Find a key, adding it (value default-constructed) if absent
+     * @param created Set to true if the key was added (may be nullptr)
+     * @return Pointer to the value, or nullptr if the map is full
+     */
+    V* insert(K key, bool* created = nullptr) {
+        if (created) *created = false;
+        uint32_t i = home(key);
+        for (size_t probe = 0; probe < N; probe++, i = (i + 1) & MASK) {
+            if (!_used[i]) {
+                _used[i] = true;
+                _keys[i] = key;
+                _values[i] = V();
+                _size++;
+                if (created) *created = true;
+                return &_values[i];
+            }
+            if (_keys[i] == key) return &_values[i];
+        }
+        return nullptr;
+    }
+
+    /**
+     * Remove a key
+     * @return false if it was absent
+     */
+    bool erase(K key) {
+        int s = findSlot(key);
+        if (s < 0) return false;
+
+        // Backward-shift: move later entries of the probe run into the
+        // hole when the hole lies between their home slot and their slot
+        uint32_t hole = (uint32_t)s;
+        uint32_t i = hole;
+        for (size_t step = 1; step < N; step++) {
+            i = (i + 1) & MASK;
+            if (!_used[i]) break;
+            uint32_t h = home(_keys[i]);
+            bool movable = (hole <= i) ? (h <= hole || h > i) : (h <= hole && h > i);
+            if (movable) {
+                _keys[hole] = _keys[i];
+                _values[hole] = _values[i];
+                hole = i;
+            }
+        }
+        _used[hole] = false;
+        _size--;
+        return true;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    void clear() {
+        for (size_t i = 0; i < N; i++) _used[i] = false;
+        _size = 0;
+    }
+
+    // Slot iteration (unordered): for (i < CAPACITY) if (slotUsed(i)) ...
+    bool slotUsed(size_t i) const { return _used[i]; }
+    K keyAt(size_t i) const { return _keys[i]; }
+    V& valueAt(size_t i) { return _values[i]; }
+    const V& valueAt(size_t i) const { return _values[i]; }
+
+private:
+    static uint32_t home(K key) {
+        return ((uint32_t)key * 0x9E3779B1u) >> SHIFT;
+    }
+
+    int findSlot(K key) const {
+        uint32_t i = home(key);
+        for (size_t probe = 0; probe < N; probe++, i = (i + 1) & MASK) {
+            if (!_used[i]) return -1;
+            if (_keys[i] == key) return (int)i;
+        }
+        return -1;
+    }
+
+    K _keys[N];
+    V _values[N];
+    bool _used[N] = {};
+    size_t _size = 0;
+};
+
+#endif // MESHBERRY_FLAT_HASH_MAP_H
@@ -0,0 +1,117 @@
+/**
+ * MeshBerry LRU Cache
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Fixed set of N slots keyed by an integer, combining a FlatHashMap
+ * (key -> slot) with an LruList (recency order). Lookup, insert, erase,
+ * touch and eviction of the least recently used entry are O(1), and a
+ * slot keeps its index for as long as it holds the same key, so indices
+ * can be handed to code that stores them. No allocation.
+ */
+
+#ifndef MESHBERRY_LRU_CACHE_H
+#define MESHBERRY_LRU_CACHE_H
+
+#include "FlatHashMap.h"
+#include "LruList.h"
+
+namespace LruCacheDetail {
+constexpr size_t indexSize(size_t n) {
+    // Power of two at least twice n (load factor <= 50%)
+    return n <= 1 ? 2 : 2 * indexSize((n + 1) / 2);
+}
+}
+
+template <typename K, typename T, size_t N>
+class LruCache {
+public:
+    static constexpr int NONE = LruList<N>::NONE;
+    static constexpr size_t CAPACITY = N;
+
+    /**
+     * Slot holding a key, or NONE (does not change recency)
+     */
+    int find(K key) const {
+        const uint16_t* s = _index.find(key);
+        return s ? (int)*s : NONE;
+    }
+
+    /**
+     * Slot that acquire() of a new key would evict, or NONE if a slot is free
+     * Lets the caller finish with the old entry before it is overwritten.
+     */
+    int victim() const {
+        return _order.freeSlot() != NONE ? NONE : _order.oldest();
+    }
+
+    /**
+     * Find or add a key and mark it most recently used
+     * A new key takes a free slot or evicts the least recently used one;
+     * its value is left as it was (the caller initialises it).
+     * @param created Set to true for a new key (may be nullptr)
+     * @return Slot index
+     */
+    int acquire(K key, bool* created = nullptr) {
+        int slot = find(key);
+        if (created) *created = (slot == NONE);
+        if (slot == NONE) {
+            slot = _order.freeSlot();
+            if (slot == NONE) {
+                slot = _order.oldest();
+                _index.erase(_keys[slot]);
+            }
+            _keys[slot] = key;
+            _index.put(key, (uint16_t)slot);
+        }
+        _order.touch(slot);
+        return slot;
+    }
+
+    /**
+     * Mark a slot most recently used
+     */
+    void touch(int slot) {
+        if (used(slot)) _order.touch(slot);
+    }
+
+    /**
+     * Free a slot
+     */
+    void erase(int slot) {
+        if (!used(slot)) return;
+        _index.erase(_keys[slot]);
+        _order.remove(slot);
+    }
+
+    bool used(int slot) const { return _order.contains(slot); }
+
+    T& at(int slot) { return _items[slot]; }
+    const T& at(int slot) const { return _items[slot]; }
+    K keyAt(int slot) const { return _keys[slot]; }
+
+    // Recency walk: for (int s = newest(); s != NONE; s = older(s))
+    int newest() const { return _order.newest(); }
+    int oldest() const { return _order.oldest(); }
+    int older(int slot) const { return _order.older(slot); }
+    int newer(int slot) const { return _order.newer(slot); }
+
+    size_t size() const { return _order.size(); }
+    bool full() const { return _order.full(); }
+
+    void clear() {
+        _index.clear();
+        _order.clear();
+    }
+
+private:
+    T _items[N];
+    K _keys[N];
+    FlatHashMap<K, uint16_t, LruCacheDetail::indexSize(N)> _index;
+    LruList<N> _order;
+};
+
+#endif // MESHBERRY_LRU_CACHE_H
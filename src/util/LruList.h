@@ -0,0 +1,130 @@
+/**
+ * MeshBerry LRU List
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Recency order over the slots of a caller-owned array. Each slot has
+ * its own prev/next link and sits on either the in-use list (newest
+ * first) or the free list, so touching, removing, finding the least
+ * recently used slot and finding a free slot are all O(1). Slots never
+ * move, so indices handed out stay valid. No allocation.
+ */
+
+#ifndef MESHBERRY_LRU_LIST_H
+#define MESHBERRY_LRU_LIST_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+template <size_t N>
+class LruList {
+    static_assert(N > 0 && N < 0xFFFF, "LruList size out of range");
+
+public:
+    static constexpr int NONE = -1;
+
+    LruList() { clear(); }
+
+    /**
+     * Free every slot
+     */
+    void clear() {
+        _used = List();
+        _free = List();
+        _size = 0;
+        for (size_t i = 0; i < N; i++) {
+            _linked[i] = false;
+            pushBack(_free, (uint16_t)i);
+        }
+    }
+
+    /**
+     * Mark a slot most recently used, taking it off the free list if needed
+     */
+    void touch(int slot) {
+        if (slot < 0 || (size_t)slot >= N) return;
+        if (_linked[slot]) {
+            if (_used.head == slot) return;
+            unlink(_used, slot);
+        } else {
+            unlink(_free, slot);
+            _linked[slot] = true;
+            _size++;
+        }
+        pushFront(_used, (uint16_t)slot);
+    }
+
+    /**
+     * Return a slot to the free list
+     */
+    void remove(int slot) {
+        if (slot < 0 || (size_t)slot >= N || !_linked[slot]) return;
+        unlink(_used, slot);
+        _linked[slot] = false;
+        _size--;
+        pushBack(_free, (uint16_t)slot);
+    }
+
+    bool contains(int slot) const {
+        return slot >= 0 && (size_t)slot < N && _linked[slot];
+    }
+
+    // Most and least recently used slots, NONE if empty
+    int newest() const { return toIndex(_used.head); }
+    int oldest() const { return toIndex(_used.tail); }
+
+    // Walk from newest to oldest (or back); NONE at the end
+    int older(int slot) const { return toIndex(_next[slot]); }
+    int newer(int slot) const { return toIndex(_prev[slot]); }
+
+    /**
+     * A slot not in use, or NONE if all are
+     */
+    int freeSlot() const { return toIndex(_free.head); }
+
+    size_t size() const { return _size; }
+    bool full() const { return _size == N; }
+
+private:
+    static constexpr uint16_t END = 0xFFFF;
+
+    struct List {
+        uint16_t head = END;
+        uint16_t tail = END;
+    };
+
+    static int toIndex(uint16_t link) { return link == END ? NONE : (int)link; }
+
+    void pushFront(List& l, uint16_t slot) {
+        _prev[slot] = END;
+        _next[slot] = l.head;
+        if (l.head != END) _prev[l.head] = slot; else l.tail = slot;
+        l.head = slot;
+    }
+
+    void pushBack(List& l, uint16_t slot) {
+        _next[slot] = END;
+        _prev[slot] = l.tail;
+        if (l.tail != END) _next[l.tail] = slot; else l.head = slot;
+        l.tail = slot;
+    }
+
+    void unlink(List& l, int slot) {
+        uint16_t p = _prev[slot];
+        uint16_t n = _next[slot];
+        if (p != END) _next[p] = n; else l.head = n;
+        if (n != END) _prev[n] = p; else l.tail = p;
+    }
+
+    uint16_t _prev[N];
+    uint16_t _next[N];
+    bool _linked[N];
+    List _used;
+    List _free;
+    size_t _size;
+};
+
+#endif // MESHBERRY_LRU_LIST_H
@@ -0,0 +1,87 @@
+/**
+ * MeshBerry Ring Buffer
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Fixed-capacity FIFO that overwrites its oldest element when full.
+ * The capacity is a power of two, so wrapping is a mask rather than a
+ * division. No allocation; the storage is the object itself.
+ *
+ * Memory layout is items, count, head (next write position). It matches
+ * the messages/messageCount/messageHead fields DMConversation persisted
+ * before it used this class, so dms.bin files stay readable.
+ */
+
+#ifndef MESHBERRY_RING_BUFFER_H
+#define MESHBERRY_RING_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+template <typename T, size_t N>
+class RingBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+    static constexpr uint32_t MASK = N - 1;
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    /**
+     * Append an element, dropping the oldest if full
+     * @return The stored element
+     */
+    T& push(const T& item) {
+        T& slot = pushSlot();
+        slot = item;
+        return slot;
+    }
+
+    /**
+     * Claim the next slot (dropping the oldest if full) for in-place fill
+     * The slot still holds whatever was there before.
+     */
+    T& pushSlot() {
+        T& slot = _items[_head & MASK];
+        _head = (_head + 1) & MASK;
+        if ((size_t)_count < N) _count++;
+        return slot;
+    }
+
+    /**
+     * Remove the oldest element
+     * @return false if empty
+     */
+    bool popFront() {
+        if (_count == 0) return false;
+        _count--;
+        return true;
+    }
+
+    // Index 0 is the oldest element, size() - 1 the newest
+    T& operator[](size_t i) { return _items[(_head - _count + i) & MASK]; }
+    const T& operator[](size_t i) const { return _items[(_head - _count + i) & MASK]; }
+
+    T& front() { return (*this)[0]; }
+    T& back() { return _items[(_head - 1) & MASK]; }
+    const T& back() const { return _items[(_head - 1) & MASK]; }
+
+    size_t size() const { return (size_t)_count; }
+    bool empty() const { return _count == 0; }
+    bool full() const { return (size_t)_count == N; }
+    void clear() { _count = 0; _head = 0; }
+
+    /**
+     * Direct access to the backing array (for bulk reset)
+     */
+    T* storage() { return _items; }
+
+private:
+    T _items[N];
+    int32_t _count = 0;
+    int32_t _head = 0;
+};
+
+#endif // MESHBERRY_RING_BUFFER_H
@@ -0,0 +1,77 @@
+/**
+ * MeshBerry Small Vector
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Fixed-capacity vector: a count plus inline storage for N elements.
+ * push() reports failure instead of growing. No allocation.
+ */
+
+#ifndef MESHBERRY_SMALL_VECTOR_H
+#define MESHBERRY_SMALL_VECTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector capacity must be non-zero");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    /**
+     * Append an element
+     * @return The stored element, or nullptr if full
+     */
+    T* push(const T& item) {
+        if (_size >= N) return nullptr;
+        _items[_size] = item;
+        return &_items[_size++];
+    }
+
+    /**
+     * Remove an element, keeping the order of the rest (O(n))
+     */
+    void erase(size_t i) {
+        if (i >= _size) return;
+        for (size_t j = i + 1; j < _size; j++) {
+            _items[j - 1] = _items[j];
+        }
+        _size--;
+    }
+
+    /**
+     * Remove an element by moving the last one into its place (O(1))
+     */
+    void swapErase(size_t i) {
+        if (i >= _size) return;
+        _items[i] = _items[_size - 1];
+        _size--;
+    }
+
+    void popBack() { if (_size > 0) _size--; }
+
+    T& operator[](size_t i) { return _items[i]; }
+    const T& operator[](size_t i) const { return _items[i]; }
+    T& back() { return _items[_size - 1]; }
+
+    T* begin() { return _items; }
+    T* end() { return _items + _size; }
+    const T* begin() const { return _items; }
+    const T* end() const { return _items + _size; }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == N; }
+    void clear() { _size = 0; }
+
+private:
+    T _items[N];
+    size_t _size = 0;
+};
+
+#endif // MESHBERRY_SMALL_VECTOR_H
@@ -0,0 +1,296 @@
+#!/usr/bin/env python3
+"""
+Generate MBF bitmap font files for MeshBerry's Unicode text rendering
+
+Reads GNU Unifont .hex files (8x16 / 16x16 glyphs, no dependencies) or a
+TrueType font (requires Pillow) and writes an MBF face for
+src/ui/GlyphCache. Copy the output to the SD card as
+/meshberry/fonts/unicode8.mbf (size 1 text) and unicode16.mbf (size 2).
+
+Usage:
+  python3 generate_font.py --hex unifont.hex --height 16 -o unicode16.mbf
+  python3 generate_font.py --hex unifont.hex --height 8 -o unicode8.mbf
+  python3 generate_font.py --ttf DejaVuSans.ttf --height 8 -o unicode8.mbf
+
+Unifont glyphs are used as-is for height 16. For height 8 they are
+reduced 2:1 vertically (and horizontally for 16-wide glyphs), then
+trimmed to a proportional advance.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x3146424D          # "MBF1"
+RANGE_GLYPHS = 128
+MAX_ADVANCE = 16
+
+# Scripts seen from other mesh clients; ASCII is drawn by the built-in font
+DEFAULT_RANGES = [
+    (0x00A0, 0x024F),   # Latin-1 Supplement, Latin Extended-A/B
+    (0x0370, 0x03FF),   # Greek
+    (0x0400, 0x052F),   # Cyrillic (+ Supplement)
+    (0x0590, 0x05FF),   # Hebrew
+    (0x0600, 0x06FF),   # Arabic
+    (0x0E00, 0x0E7F),   # Thai
+    (0x1E00, 0x1EFF),   # Latin Extended Additional (Vietnamese)
+    (0x2000, 0x206F),   # General Punctuation
+    (0x20A0, 0x20CF),   # Currency
+    (0x2100, 0x218F),   # Letterlike, Number Forms
+    (0x2190, 0x21FF),   # Arrows
+    (0x2200, 0x22FF),   # Math Operators
+    (0x2500, 0x25FF),   # Box Drawing, Blocks, Geometric Shapes
+    (0x3000, 0x30FF),   # CJK Punctuation, Hiragana, Katakana
+    (0x4E00, 0x9FFF),   # CJK Unified Ideographs
+    (0xAC00, 0xD7A3),   # Hangul Syllables
+    (0xFF00, 0xFFEF),   # Halfwidth and Fullwidth Forms
+]
+
+
+def parse_ranges(text):
+    ranges = []
+    for part in text.split(","):
+        lo, _, hi = part.partition("-")
+        ranges.append((int(lo, 16), int(hi or lo, 16)))
+    return ranges
+
+
+def in_ranges(cp, ranges):
+    return any(lo <= cp <= hi for lo, hi in ranges)
+
+
+# =============================================================================
+# GLYPH SOURCES -> {cp: (width, [row bitmasks, MSB = left])}
+# =============================================================================
+
+def load_hex(path, ranges):
+    glyphs = {}
+    with open(path) as f:
+        for line in f:
+            cp_text, _, bits = line.strip().partition(":")
+            if not bits:
+                continue
+            cp = int(cp_text, 16)
+            if not in_ranges(cp, ranges):
+                continue
+            width = 8 if len(bits) == 32 else 16
+            step = width // 4
+            rows = [int(bits[i:i + step], 16) for i in range(0, len(bits), step)]
+            glyphs[cp] = (width, rows)
+    return glyphs
+
+
+def load_ttf(path, height, ranges):
+    from PIL import Image, ImageDraw, ImageFont
+    # Largest size whose ascent and descent fit the cell (one row of slack)
+    size = height
+    while True:
+        font = ImageFont.truetype(path, size)
+        ascent, descent = font.getmetrics()
+        if ascent + descent <= height + 1 or size <= 4:
+            break
+        size -= 1
+    baseline = min(ascent, height - 1)
+
+    # Unmapped code points render as .notdef; use a private-use one as reference
+    notdef = font.getmask(chr(0x10FFFD))
+    notdef = (notdef.size, bytes(notdef))
+
+    glyphs = {}
+    for lo, hi in ranges:
+        for cp in range(lo, hi + 1):
+            ch = chr(cp)
+            mask = font.getmask(ch)
+            if (mask.size, bytes(mask)) == notdef:
+                continue
+            if mask.getbbox() is None and not ch.isspace():
+                continue
+            img = Image.new("1", (MAX_ADVANCE * 2, height * 2), 0)
+            ImageDraw.Draw(img).text((0, baseline), ch, font=font, fill=1, anchor="ls")
+            rows = []
+            for y in range(height):
+                mask = 0
+                for x in range(MAX_ADVANCE):
+                    if img.getpixel((x, y)):
+                        mask |= 1 << (MAX_ADVANCE - 1 - x)
+                rows.append(mask)
+            glyphs[cp] = (MAX_ADVANCE, rows)
+    return glyphs
+
+
+def halve(width, rows, horizontal):
+    """2:1 reduction: a pixel is set if any source pixel under it is"""
+    out = []
+    for y in range(0, len(rows), 2):
+        row = rows[y] | (rows[y + 1] if y + 1 < len(rows) else 0)
+        if horizontal:
+            reduced = 0
+            for x in range(width // 2):
+                if (row >> (width - 2 - 2 * x)) & 3:
+                    reduced |= 1 << (width // 2 - 1 - x)
+            row = reduced
+        out.append(row)
+    return (width // 2 if horizontal else width), out
+
+
+def trim(width, rows, height):
+    """Crop empty columns, keep one column of spacing on the right"""
+    ink = 0
+    for row in rows:
+        ink |= row
+    if ink == 0:
+        # Space-like: keep a narrow advance
+        return max(2, width // 3), [0] * height
+    left = 0
+    while not (ink >> (width - 1 - left)) & 1:
+        left += 1
+    right = 0
+    while not (ink >> right) & 1:
+        right += 1
+    new_width = width - left - right + 1
+    shift = right - 1
+    if new_width > MAX_ADVANCE:
+        # Ink fills the cell: no room for a spacing column
+        new_width -= 1
+        shift = right
+    out = []
+    for row in rows:
+        row = row >> shift if shift >= 0 else row << -shift
+        out.append(row & ((1 << new_width) - 1))
+    return new_width, out
+
+
+def fit(glyphs, height, proportional):
+    fitted = {}
+    for cp, (width, rows) in glyphs.items():
+        src_height = len(rows)
+        while src_height > height:
+            width, rows = halve(width, rows, horizontal=width > 8)
+            src_height = len(rows)
+        rows = (rows + [0] * height)[:height]
+        if proportional:
+            width, rows = trim(width, rows, height)
+        fitted[cp] = (width, rows)
+    return fitted
+
+
+# =============================================================================
+# MBF WRITER
+# =============================================================================
+
+def pack_glyph(width, rows):
+    bits = 0
+    nbits = 0
+    out = bytearray()
+    for row in rows:
+        for x in range(width):
+            bits = (bits << 1) | ((row >> (width - 1 - x)) & 1)
+            nbits += 1
+            if nbits == 8:
+                out.append(bits)
+                bits = nbits = 0
+    if nbits:
+        out.append(bits << (8 - nbits))
+    return bytes(out)
+
+
+def compress(raw):
+    """Zero-run coding; dense ranges are stored as-is (packed == raw size)"""
+    out = bytearray()
+    i = 0
+    while i < len(raw):
+        if raw[i] != 0:
+            out.append(raw[i])
+            i += 1
+            continue
+        run = 0
+        while i < len(raw) and raw[i] == 0 and run < 255:
+            run += 1
+            i += 1
+        out += bytes((0, run))
+    return bytes(out) if len(out) < len(raw) else bytes(raw)
+
+
+def build_ranges(glyphs):
+    """Split present code points into runs of at most 128"""
+    cps = sorted(glyphs)
+    ranges = []
+    start = None
+    for cp in cps:
+        if start is None:
+            start = prev = cp
+            continue
+        # Bridge small gaps; a missing code point costs one advance byte
+        if cp - start >= RANGE_GLYPHS or cp - prev > 8:
+            ranges.append((start, prev - start + 1))
+            start = cp
+        prev = cp
+    if start is not None:
+        ranges.append((start, prev - start + 1))
+    return ranges
+
+
+def write_mbf(path, glyphs, height):
+    ranges = build_ranges(glyphs)
+    advances = bytearray()
+    blobs = []
+    for first, count in ranges:
+        raw = bytearray()
+        for cp in range(first, first + count):
+            if cp in glyphs:
+                width, rows = glyphs[cp]
+                advances.append(width)
+                raw += pack_glyph(width, rows)
+            else:
+                advances.append(0)
+        blobs.append((bytes(raw), compress(bytes(raw))))
+
+    header_size = 16 + 16 * len(ranges)
+    offset = header_size + len(advances)
+    table = bytearray()
+    for (first, count), (raw, packed) in zip(ranges, blobs):
+        if len(raw) > 0xFFFF or len(packed) > 0xFFFF:
+            sys.exit("range too large")
+        table += struct.pack("<IIHHB3x", first, offset, len(packed), len(raw), count)
+        offset += len(packed)
+
+    with open(path, "wb") as f:
+        f.write(struct.pack("<IBBHII", MAGIC, height, 0, len(ranges), len(glyphs), 0))
+        f.write(table)
+        f.write(advances)
+        for _, packed in blobs:
+            f.write(packed)
+
+    raw_total = sum(len(r) for r, _ in blobs)
+    packed_total = sum(len(p) for _, p in blobs)
+    print(f"{path}: {len(glyphs)} glyphs, {len(ranges)} ranges, height {height}, "
+          f"bitmaps {raw_total} -> {packed_total} bytes, file {offset} bytes",
+          file=sys.stderr)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--hex", help="GNU Unifont .hex file")
+    src.add_argument("--ttf", help="TrueType font (needs Pillow)")
+    ap.add_argument("--height", type=int, choices=(8, 16), required=True)
+    ap.add_argument("--ranges", help="Comma-separated hex ranges, e.g. 00A0-024F,0400-04FF")
+    ap.add_argument("--fixed", action="store_true", help="Keep full cell widths (no trimming)")
+    ap.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    ranges = parse_ranges(args.ranges) if args.ranges else DEFAULT_RANGES
+    if args.hex:
+        glyphs = load_hex(args.hex, ranges)
+    else:
+        glyphs = load_ttf(args.ttf, args.height, ranges)
+
+    # Unifont 16-row glyphs are already cell-aligned at height 16
+    proportional = not args.fixed and (args.ttf or args.height < 16)
+    glyphs = fit(glyphs, args.height, proportional)
+    write_mbf(args.output, glyphs, args.height)
+
+
+if __name__ == "__main__":
+    main()
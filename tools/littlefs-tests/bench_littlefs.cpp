@@ -0,0 +1,129 @@
+/**
+ * MeshBerry LittleFS benchmarks (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * The fsbench operations (src/drivers/flashbench.cpp) run on LittleFS's
+ * RAM block device at the same fill levels. Wall time on a host says
+ * nothing about the T-Deck's flash, so this counts block device reads,
+ * programs and erases per operation and turns them into an estimate with
+ * typical datasheet timings for the 16 MB QIO NOR flash. Use it to compare
+ * LittleFS configurations or versions; fsbench on the device is the
+ * measurement.
+ */
+
+#include "ramflash.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Same workload as flashbench.h
+static const int    BENCH_ITERATIONS    = 20;
+static const int    BENCH_MOUNT_CYCLES  = 3;
+static const size_t BENCH_APPEND_BYTES  = 64;
+static const size_t BENCH_REWRITE_BYTES = 4096;
+static const int    FILL_LEVELS[] = { 0, 50, 75, 90 };
+
+// Typical NOR timings: 4 KB sector erase, 256 B page program, QIO read
+static const double ERASE_MS = 45.0;
+static const double PAGE_PROG_MS = 0.7;
+static const double READ_MB_PER_S = 40.0;
+
+struct OpCost {
+    FlashCounters total;
+    int count;
+
+    void add(const FlashCounters& c) {
+        total.reads += c.reads;
+        total.readBytes += c.readBytes;
+        total.progs += c.progs;
+        total.progBytes += c.progBytes;
+        total.erases += c.erases;
+        count++;
+    }
+
+    double estimateMs() const {
+        if (!count) return 0;
+        double ms = total.erases * ERASE_MS +
+                    (total.progBytes / 256.0) * PAGE_PROG_MS +
+                    total.readBytes / (READ_MB_PER_S * 1000.0);
+        return ms / count;
+    }
+};
+
+static void printRow(const char* name, const OpCost& c) {
+    double n = c.count ? c.count : 1;
+    printf("  %-8s %7.1f reads %8.0f B   %6.1f progs %7.0f B   %5.2f erases   ~%7.2f ms\n",
+           name, c.total.reads / n, c.total.readBytes / n, c.total.progs / n,
+           c.total.progBytes / n, c.total.erases / n, c.estimateMs());
+}
+
+int main() {
+    static uint8_t buffer[BENCH_REWRITE_BYTES];
+    for (size_t i = 0; i < sizeof(buffer); i++) buffer[i] = (uint8_t)(i * 31 + 7);
+
+    RamFlash flash;
+    if (flash.format() || flash.mount()) {
+        printf("format/mount failed\n");
+        return EXIT_FAILURE;
+    }
+    printf("LittleFS %d.%d on lfs_rambd: %u x %u B blocks, cache %u, lookahead %u\n",
+           LFS_VERSION_MAJOR, LFS_VERSION_MINOR, (unsigned)FLASH_BLOCK_COUNT,
+           (unsigned)FLASH_BLOCK_SIZE, (unsigned)FLASH_CACHE_SIZE, (unsigned)FLASH_LOOKAHEAD);
+    printf("Estimates: %.0f ms/erase, %.1f ms/256 B page, %.0f MB/s read\n\n",
+           ERASE_MS, PAGE_PROG_MS, READ_MB_PER_S);
+
+    writeWhole(&flash.lfs, "/.bench_read", buffer, BENCH_REWRITE_BYTES, MODE_WRITE);
+
+    for (int percent : FILL_LEVELS) {
+        if (!fillTo(&flash.lfs, "/.bench_fill", percent)) {
+            printf("Could not fill to %d%%\n", percent);
+            return EXIT_FAILURE;
+        }
+
+        OpCost open = {}, append = {}, rewrite = {}, mount = {};
+        uint8_t readBuf[64];
+
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            flash.resetCounters();
+            lfs_file_t f;
+            if (lfs_file_open(&flash.lfs, &f, "/.bench_read", MODE_READ) == 0) {
+                lfs_file_read(&flash.lfs, &f, readBuf, sizeof(readBuf));
+                lfs_file_close(&flash.lfs, &f);
+            }
+            open.add(flash.counters);
+
+            flash.resetCounters();
+            writeWhole(&flash.lfs, "/.bench_log", buffer, BENCH_APPEND_BYTES, MODE_APPEND);
+            append.add(flash.counters);
+
+            flash.resetCounters();
+            writeWhole(&flash.lfs, "/.bench_rw", buffer, BENCH_REWRITE_BYTES, MODE_WRITE);
+            rewrite.add(flash.counters);
+        }
+
+        for (int i = 0; i < BENCH_MOUNT_CYCLES; i++) {
+            flash.unmount();
+            flash.resetCounters();
+            if (flash.mount()) {
+                printf("Remount failed\n");
+                return EXIT_FAILURE;
+            }
+            mount.add(flash.counters);
+        }
+
+        lfs_ssize_t used = lfs_fs_size(&flash.lfs);
+        printf("Fill %d%% (%ld of %u blocks):\n", (int)(used * 100 / FLASH_BLOCK_COUNT),
+               (long)used, (unsigned)FLASH_BLOCK_COUNT);
+        printRow("open", open);
+        printRow("append", append);
+        printRow("rewrite", rewrite);
+        printRow("mount", mount);
+    }
+
+    flash.unmount();
+    return EXIT_SUCCESS;
+}
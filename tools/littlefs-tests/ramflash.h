@@ -0,0 +1,224 @@
+/**
+ * MeshBerry LittleFS host tests: RAM flash
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * LittleFS on its RAM block device (lfs_rambd), sized and configured like
+ * the T-Deck's "spiffs" partition under the Arduino-ESP32 LittleFS driver.
+ * Every block device call goes through a counter, so tests and benchmarks
+ * can see how many reads, programs and erases an operation costs. A power
+ * cut can be injected after a set number of programs and erases: that
+ * call and every later one fails without touching the image.
+ */
+
+#ifndef MESHBERRY_RAMFLASH_H
+#define MESHBERRY_RAMFLASH_H
+
+extern "C" {
+#include "lfs.h"
+#include "bd/lfs_rambd.h"
+}
+
+#include <cstring>
+#include <vector>
+
+// default_16MB.csv: spiffs partition, 0x360000 bytes
+static const lfs_size_t FLASH_BLOCK_SIZE  = 4096;
+static const lfs_size_t FLASH_BLOCK_COUNT = 0x360000 / FLASH_BLOCK_SIZE;
+
+// esp_littlefs defaults (CONFIG_LITTLEFS_*)
+static const lfs_size_t FLASH_RW_SIZE     = 128;
+static const lfs_size_t FLASH_CACHE_SIZE  = 512;
+static const lfs_size_t FLASH_LOOKAHEAD   = 128;
+static const int32_t    FLASH_CYCLES      = 512;
+
+struct FlashCounters {
+    uint32_t reads;
+    uint64_t readBytes;
+    uint32_t progs;
+    uint64_t progBytes;
+    uint32_t erases;
+};
+
+class RamFlash {
+public:
+    RamFlash() {
+        memset(&_cfg, 0, sizeof(_cfg));
+        _cfg.context = this;
+        _cfg.read = readCb;
+        _cfg.prog = progCb;
+        _cfg.erase = eraseCb;
+        _cfg.sync = syncCb;
+        _cfg.read_size = FLASH_RW_SIZE;
+        _cfg.prog_size = FLASH_RW_SIZE;
+        _cfg.block_size = FLASH_BLOCK_SIZE;
+        _cfg.block_count = FLASH_BLOCK_COUNT;
+        _cfg.block_cycles = FLASH_CYCLES;
+        _cfg.cache_size = FLASH_CACHE_SIZE;
+        _cfg.lookahead_size = FLASH_LOOKAHEAD;
+
+        // lfs_rambd reads its own state from cfg->context
+        memset(&_bdcfg, 0, sizeof(_bdcfg));
+        _bdcfg.read_size = FLASH_RW_SIZE;
+        _bdcfg.prog_size = FLASH_RW_SIZE;
+        _bdcfg.erase_size = FLASH_BLOCK_SIZE;
+        _bdcfg.erase_count = FLASH_BLOCK_COUNT;
+        _bdCfg = _cfg;
+        _bdCfg.context = &_bd;
+        lfs_rambd_create(&_bdCfg, &_bdcfg);
+        resetCounters();
+    }
+
+    ~RamFlash() {
+        if (_mounted) lfs_unmount(&lfs);
+        lfs_rambd_destroy(&_bdCfg);
+    }
+
+    int format() { return lfs_format(&lfs, &_cfg); }
+
+    int mount() {
+        int err = lfs_mount(&lfs, &_cfg);
+        _mounted = err == 0;
+        return err;
+    }
+
+    int unmount() {
+        _mounted = false;
+        return lfs_unmount(&lfs);
+    }
+
+    /**
+     * Drop the mount as a reset would. lfs_unmount() only frees the
+     * caches, so nothing pending reaches the image.
+     */
+    void powerOff() {
+        if (_mounted) lfs_unmount(&lfs);
+        _mounted = false;
+        _cutAfter = -1;
+    }
+
+    /**
+     * Fail every program/erase from the nth one on (0 = the next one)
+     */
+    void cutPowerAfter(int n) { _cutAfter = n; _writes = 0; }
+    bool powerCut() const { return _cutAfter >= 0 && _writes > _cutAfter; }
+
+    std::vector<uint8_t> snapshot() const {
+        const uint8_t* p = _bd.buffer;
+        return std::vector<uint8_t>(p, p + FLASH_BLOCK_SIZE * FLASH_BLOCK_COUNT);
+    }
+
+    void restore(const std::vector<uint8_t>& image) {
+        memcpy(_bd.buffer, image.data(), image.size());
+    }
+
+    void resetCounters() { memset(&counters, 0, sizeof(counters)); }
+
+    lfs_t lfs;
+    FlashCounters counters;
+
+private:
+    static RamFlash* self(const struct lfs_config* c) { return (RamFlash*)c->context; }
+
+    bool allowWrite() {
+        if (_cutAfter < 0) return true;
+        return _writes++ < _cutAfter;
+    }
+
+    static int readCb(const struct lfs_config* c, lfs_block_t block, lfs_off_t off,
+                      void* buffer, lfs_size_t size) {
+        RamFlash* f = self(c);
+        f->counters.reads++;
+        f->counters.readBytes += size;
+        return lfs_rambd_read(&f->_bdCfg, block, off, buffer, size);
+    }
+
+    static int progCb(const struct lfs_config* c, lfs_block_t block, lfs_off_t off,
+                      const void* buffer, lfs_size_t size) {
+        RamFlash* f = self(c);
+        if (!f->allowWrite()) return LFS_ERR_IO;
+        f->counters.progs++;
+        f->counters.progBytes += size;
+        return lfs_rambd_prog(&f->_bdCfg, block, off, buffer, size);
+    }
+
+    static int eraseCb(const struct lfs_config* c, lfs_block_t block) {
+        RamFlash* f = self(c);
+        if (!f->allowWrite()) return LFS_ERR_IO;
+        f->counters.erases++;
+        return lfs_rambd_erase(&f->_bdCfg, block);
+    }
+
+    static int syncCb(const struct lfs_config* c) {
+        return lfs_rambd_sync(&self(c)->_bdCfg);
+    }
+
+    struct lfs_config _cfg;       // What LittleFS sees (counting callbacks)
+    struct lfs_config _bdCfg;     // What lfs_rambd sees (context = _bd)
+    struct lfs_rambd_config _bdcfg;
+    lfs_rambd_t _bd;
+    bool _mounted = false;
+    int _cutAfter = -1;
+    int _writes = 0;
+};
+
+// Arduino-ESP32 "w", "a" and "r" modes as the LittleFS driver maps them
+static const int MODE_WRITE  = LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC;
+static const int MODE_APPEND = LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND;
+static const int MODE_READ   = LFS_O_RDONLY;
+
+/**
+ * Open, write and close, as Storage/SettingsManager do for a whole file
+ */
+static int writeWhole(lfs_t* lfs, const char* path, const uint8_t* data, size_t len, int mode) {
+    lfs_file_t f;
+    int err = lfs_file_open(lfs, &f, path, mode);
+    if (err) return err;
+    lfs_ssize_t n = lfs_file_write(lfs, &f, data, len);
+    int closeErr = lfs_file_close(lfs, &f);
+    if (n < 0) return (int)n;
+    if ((size_t)n != len) return LFS_ERR_NOSPC;
+    return closeErr;
+}
+
+/**
+ * Read a whole file (empty vector and false if it can't be opened)
+ */
+static bool readWhole(lfs_t* lfs, const char* path, std::vector<uint8_t>& out) {
+    out.clear();
+    lfs_file_t f;
+    if (lfs_file_open(lfs, &f, path, MODE_READ)) return false;
+    uint8_t buf[256];
+    lfs_ssize_t n;
+    while ((n = lfs_file_read(lfs, &f, buf, sizeof(buf))) > 0) {
+        out.insert(out.end(), buf, buf + n);
+    }
+    lfs_file_close(lfs, &f);
+    return n == 0;
+}
+
+/**
+ * Grow a filler file until `percent` of the blocks are in use
+ */
+static bool fillTo(lfs_t* lfs, const char* path, int percent) {
+    lfs_ssize_t used = lfs_fs_size(lfs);
+    lfs_ssize_t target = (lfs_ssize_t)FLASH_BLOCK_COUNT * percent / 100;
+    if (used < 0) return false;
+    if (used >= target) return true;
+
+    lfs_file_t f;
+    if (lfs_file_open(lfs, &f, path, MODE_APPEND)) return false;
+    static uint8_t chunk[FLASH_BLOCK_SIZE];
+    memset(chunk, 0xA5, sizeof(chunk));
+    bool ok = true;
+    while (ok && lfs_fs_size(lfs) < target) {
+        ok = lfs_file_write(lfs, &f, chunk, sizeof(chunk)) == (lfs_ssize_t)sizeof(chunk) &&
+             lfs_file_sync(lfs, &f) == 0;
+    }
+    return lfs_file_close(lfs, &f) == 0 && ok;
+}
+
+#endif // MESHBERRY_RAMFLASH_H
@@ -0,0 +1,254 @@
+/**
+ * MeshBerry LittleFS tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Checks the LittleFS behaviour the firmware relies on after the move off
+ * SPIFFS, on LittleFS's RAM block device with the T-Deck partition
+ * geometry (see ramflash.h): whole-file saves survive a power cut at any
+ * point, archive appends never tear a record, saves keep working when the
+ * partition is 90% full, and the directory layout the migration writes can
+ * be created and listed.
+ */
+
+#include "ramflash.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+static const size_t CONTACTS_BYTES = 4096;   // Typical contacts.json
+static const size_t RECORD_BYTES = 224;      // One ArchivedMessage
+
+static std::vector<uint8_t> pattern(size_t len, uint8_t seed) {
+    std::vector<uint8_t> v(len);
+    for (size_t i = 0; i < len; i++) v[i] = (uint8_t)(i * 31 + seed);
+    return v;
+}
+
+// =============================================================================
+// POWER CUTS
+// =============================================================================
+
+/**
+ * Cut power at every program/erase of a contacts.json rewrite. After each
+ * cut the file must read back whole: either the old or the new contents.
+ */
+static void testRewritePowerCut() {
+    RamFlash flash;
+    CHECK(flash.format() == 0);
+    CHECK(flash.mount() == 0);
+
+    std::vector<uint8_t> oldData = pattern(CONTACTS_BYTES, 1);
+    std::vector<uint8_t> newData = pattern(CONTACTS_BYTES, 2);
+    CHECK(writeWhole(&flash.lfs, "/contacts.json", oldData.data(), oldData.size(), MODE_WRITE) == 0);
+    CHECK(flash.unmount() == 0);
+    std::vector<uint8_t> before = flash.snapshot();
+
+    int cuts = 0, sawOld = 0, sawNew = 0;
+    for (int cut = 0; cut < 1000; cut++) {
+        flash.restore(before);
+        CHECK(flash.mount() == 0);
+        flash.cutPowerAfter(cut);
+        int err = writeWhole(&flash.lfs, "/contacts.json", newData.data(), newData.size(), MODE_WRITE);
+        bool wasCut = flash.powerCut();
+        flash.powerOff();
+
+        CHECK(flash.mount() == 0);
+        std::vector<uint8_t> got;
+        CHECK(readWhole(&flash.lfs, "/contacts.json", got));
+        if (got == oldData) sawOld++;
+        else if (got == newData) sawNew++;
+        else CHECK(!"contacts.json torn by a power cut");
+        CHECK(flash.unmount() == 0);
+
+        if (!wasCut) {
+            CHECK(err == 0);
+            CHECK(got == newData);
+            break;
+        }
+        cuts++;
+    }
+
+    CHECK(cuts > 0);
+    CHECK(sawOld > 0);
+    CHECK(sawNew > 0);
+}
+
+/**
+ * Cut power at every write of a run of archive appends. The file must
+ * hold a whole number of records, each one intact and in order.
+ */
+static void testAppendPowerCut() {
+    static const int APPENDS = 8;
+    RamFlash flash;
+    CHECK(flash.format() == 0);
+    std::vector<uint8_t> empty = flash.snapshot();
+
+    for (int cut = 0; cut < 1000; cut++) {
+        flash.restore(empty);
+        CHECK(flash.mount() == 0);
+        flash.cutPowerAfter(cut);
+        for (int i = 0; i < APPENDS && !flash.powerCut(); i++) {
+            std::vector<uint8_t> rec = pattern(RECORD_BYTES, (uint8_t)i);
+            writeWhole(&flash.lfs, "/archive.bin", rec.data(), rec.size(), MODE_APPEND);
+        }
+        bool wasCut = flash.powerCut();
+        flash.powerOff();
+
+        CHECK(flash.mount() == 0);
+        std::vector<uint8_t> got;
+        readWhole(&flash.lfs, "/archive.bin", got);
+        CHECK(got.size() % RECORD_BYTES == 0);
+        for (size_t r = 0; r < got.size() / RECORD_BYTES; r++) {
+            std::vector<uint8_t> rec = pattern(RECORD_BYTES, (uint8_t)r);
+            CHECK(memcmp(&got[r * RECORD_BYTES], rec.data(), RECORD_BYTES) == 0);
+        }
+        CHECK(flash.unmount() == 0);
+
+        if (!wasCut) {
+            CHECK(got.size() == APPENDS * RECORD_BYTES);
+            break;
+        }
+    }
+}
+
+// =============================================================================
+// FULL PARTITION
+// =============================================================================
+
+/**
+ * Fill to 90%, then save contacts.json many times over, enough to cycle
+ * the free blocks and make LittleFS relocate its metadata
+ */
+static void testRewriteWhenFull() {
+    RamFlash flash;
+    CHECK(flash.format() == 0);
+    CHECK(flash.mount() == 0);
+    CHECK(fillTo(&flash.lfs, "/.fill", 90));
+    CHECK(lfs_fs_size(&flash.lfs) >= (lfs_ssize_t)FLASH_BLOCK_COUNT * 90 / 100);
+
+    std::vector<uint8_t> last;
+    for (int i = 0; i < 2000; i++) {
+        last = pattern(CONTACTS_BYTES, (uint8_t)i);
+        int err = writeWhole(&flash.lfs, "/contacts.json", last.data(), last.size(), MODE_WRITE);
+        CHECK(err == 0);
+        if (err) break;
+    }
+    CHECK(flash.unmount() == 0);
+
+    CHECK(flash.mount() == 0);
+    std::vector<uint8_t> got;
+    CHECK(readWhole(&flash.lfs, "/contacts.json", got));
+    CHECK(got == last);
+    CHECK(lfs_remove(&flash.lfs, "/.fill") == 0);
+    CHECK(flash.unmount() == 0);
+}
+
+/**
+ * A save that doesn't fit must fail cleanly and leave the old file
+ */
+static void testRewriteNoSpace() {
+    RamFlash flash;
+    CHECK(flash.format() == 0);
+    CHECK(flash.mount() == 0);
+    std::vector<uint8_t> oldData = pattern(CONTACTS_BYTES, 3);
+    CHECK(writeWhole(&flash.lfs, "/contacts.json", oldData.data(), oldData.size(), MODE_WRITE) == 0);
+    CHECK(fillTo(&flash.lfs, "/.fill", 100));
+
+    std::vector<uint8_t> big = pattern(64 * 1024, 4);
+    CHECK(writeWhole(&flash.lfs, "/contacts.json", big.data(), big.size(), MODE_WRITE) != 0);
+    CHECK(flash.unmount() == 0);
+
+    CHECK(flash.mount() == 0);
+    std::vector<uint8_t> got;
+    CHECK(readWhole(&flash.lfs, "/contacts.json", got));
+    CHECK(got == oldData);
+    CHECK(flash.unmount() == 0);
+}
+
+// =============================================================================
+// DIRECTORIES
+// =============================================================================
+
+/**
+ * The migrated layout: real directories, listed back in full
+ */
+static void testDirectories() {
+    RamFlash flash;
+    CHECK(flash.format() == 0);
+    CHECK(flash.mount() == 0);
+    CHECK(lfs_mkdir(&flash.lfs, "/meshberry") == 0);
+    CHECK(lfs_mkdir(&flash.lfs, "/meshberry/archive") == 0);
+    CHECK(lfs_mkdir(&flash.lfs, "/meshberry") == LFS_ERR_EXIST);
+
+    static const int FILES = 40;
+    char path[64];
+    for (int i = 0; i < FILES; i++) {
+        snprintf(path, sizeof(path), "/meshberry/archive/%08x.bin", i * 0x01010101);
+        std::vector<uint8_t> rec = pattern(RECORD_BYTES, (uint8_t)i);
+        CHECK(writeWhole(&flash.lfs, path, rec.data(), rec.size(), MODE_WRITE) == 0);
+    }
+    CHECK(flash.unmount() == 0);
+
+    CHECK(flash.mount() == 0);
+    lfs_dir_t dir;
+    struct lfs_info info;
+    int files = 0;
+    CHECK(lfs_dir_open(&flash.lfs, &dir, "/meshberry/archive") == 0);
+    while (lfs_dir_read(&flash.lfs, &dir, &info) > 0) {
+        if (info.type == LFS_TYPE_REG) {
+            CHECK(info.size == RECORD_BYTES);
+            files++;
+        }
+    }
+    CHECK(lfs_dir_close(&flash.lfs, &dir) == 0);
+    CHECK(files == FILES);
+
+    // A missing parent is an error, not an implicit create as on SPIFFS
+    std::vector<uint8_t> rec = pattern(RECORD_BYTES, 0);
+    CHECK(writeWhole(&flash.lfs, "/missing/x.bin", rec.data(), rec.size(), MODE_WRITE) == LFS_ERR_NOENT);
+    CHECK(flash.unmount() == 0);
+}
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"Rewrite power cut",           testRewritePowerCut},
+    {"Append power cut",            testAppendPowerCut},
+    {"Rewrite at 90% full",         testRewriteWhenFull},
+    {"Rewrite without space",       testRewriteNoSpace},
+    {"Directories",                 testDirectories},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
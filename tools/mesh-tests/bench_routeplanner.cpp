@@ -0,0 +1,134 @@
+/**
+ * MeshBerry route planner benchmark (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Learns graphs from the flood paths of synthetic meshes of up to a
+ * thousand nodes (synthmesh.h), then plans a route to every vertex with
+ * src/mesh/RoutePlanner.cpp. Times a full shortest-path recompute and a
+ * plan from the cached tree, checks that every route follows learned
+ * edges, and counts the routes that exist in the real mesh rather than
+ * through vertices that merge colliding hashes. Host numbers only show how the cost grows; the ESP32-S3 is much
+ * slower in absolute terms.
+ */
+
+#include "mesh/RoutePlanner.h"
+#include "synthmesh.h"
+
+#include <chrono>
+#include <cstdio>
+
+static const int SIZES[] = { 64, 256, 1000 };
+static const int PACKETS_PER_NODE = 4;
+static const uint32_t NOW = 1790000000;
+
+static double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Whether each link of self -> hops -> dest is a learned edge
+ */
+static bool followsEdges(const RoutePlanner::Route& route, uint8_t dest) {
+    uint8_t prev = Topology::getSelfHash();
+    for (int i = 0; i < route.hopCount; i++) {
+        if (!Topology::findEdge(prev, route.hops[i])) return false;
+        prev = route.hops[i];
+    }
+    return Topology::findEdge(prev, dest) != nullptr;
+}
+
+/**
+ * Whether some chain of real neighbours carries the route's hashes
+ */
+static bool existsInMesh(const SynthMesh& mesh, const RoutePlanner::Route& route, uint8_t dest) {
+    std::vector<bool> at(mesh.hash.size(), false);
+    at[0] = true;
+    for (int i = 0; i <= route.hopCount; i++) {
+        uint8_t want = (i < route.hopCount) ? route.hops[i] : dest;
+        std::vector<bool> next(mesh.hash.size(), false);
+        bool any = false;
+        for (size_t n = 0; n < at.size(); n++) {
+            if (!at[n]) continue;
+            for (int m : mesh.neighbours[n]) {
+                if (mesh.hash[m] == want) {
+                    next[m] = true;
+                    any = true;
+                }
+            }
+        }
+        if (!any) return false;
+        at.swap(next);
+    }
+    return true;
+}
+
+static bool runSize(int nodes) {
+    std::mt19937 rng(nodes);
+    SynthMesh mesh(nodes, rng);
+
+    Topology::clear();
+    int packets = nodes * PACKETS_PER_NODE;
+    feedFloods(mesh, packets, NOW, rng);
+    uint32_t now = NOW + packets;
+
+    std::vector<uint8_t> dests;
+    for (int h = 0; h < Topology::TOPO_MAX_NODES; h++) {
+        const Topology::TopoNode* n = Topology::getNode((uint8_t)h);
+        if ((n->flags & Topology::TOPO_NODE_ACTIVE) && h != Topology::getSelfHash()) {
+            dests.push_back((uint8_t)h);
+        }
+    }
+
+    // Full recompute for every destination
+    RoutePlanner::Route route;
+    auto start = std::chrono::steady_clock::now();
+    for (uint8_t dest : dests) {
+        RoutePlanner::invalidate();
+        RoutePlanner::planRoute(dest, now, route);
+    }
+    double recomputeUs = elapsedUs(start) / dests.size();
+
+    // Plans from the cached tree
+    int found = 0, totalHops = 0, maxHops = 0, broken = 0, real = 0;
+    float totalCost = 0.0f;
+    start = std::chrono::steady_clock::now();
+    for (uint8_t dest : dests) {
+        if (!RoutePlanner::planRoute(dest, now, route)) continue;
+        found++;
+        totalHops += route.hopCount;
+        totalCost += route.cost;
+        if (route.hopCount > maxHops) maxHops = route.hopCount;
+        if (!followsEdges(route, dest)) broken++;
+    }
+    double cachedUs = elapsedUs(start) / dests.size();
+
+    for (uint8_t dest : dests) {
+        if (RoutePlanner::planRoute(dest, now, route) && existsInMesh(mesh, route, dest)) real++;
+    }
+
+    printf("%5d nodes: %3zu vertices, %3d edges, routes to %3d (%d%%), %.1f repeaters avg, %d max,"
+           " cost %.1f avg\n",
+           nodes, dests.size(), Topology::getEdgeCount(), found,
+           (int)(100 * found / dests.size()), found ? (double)totalHops / found : 0.0, maxHops,
+           found ? totalCost / found : 0.0f);
+    printf("      recompute %6.1f us   cached plan %5.2f us   in the real mesh %d%%"
+           "   off learned edges %d\n",
+           recomputeUs, cachedUs, found ? 100 * real / found : 0, broken);
+    return broken == 0;
+}
+
+int main() {
+    if (!Topology::init(SELF_HASH)) {
+        printf("Topology::init failed\n");
+        return 1;
+    }
+    printf("Route planner benchmark: %d flood paths per node, mean degree %.0f\n\n",
+           PACKETS_PER_NODE, MEAN_DEGREE);
+    bool ok = true;
+    for (int nodes : SIZES) ok = runSize(nodes) && ok;
+    return ok ? 0 : 1;
+}
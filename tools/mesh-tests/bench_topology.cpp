@@ -0,0 +1,69 @@
+/**
+ * MeshBerry topology benchmark (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Feeds src/mesh/Topology.cpp the flood paths of synthetic meshes of up
+ * to a thousand nodes and times path observation and the force-directed
+ * layout (meshes from synthmesh.h). Host numbers only show how the cost
+ * grows; the ESP32-S3 is much slower in absolute terms.
+ */
+
+#include "mesh/Topology.h"
+#include "synthmesh.h"
+
+#include <chrono>
+#include <cstdio>
+
+static const int SIZES[] = { 64, 256, 1000 };
+static const int PACKETS_PER_NODE = 4;
+static const uint32_t NOW = 1790000000;
+
+static double elapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void runSize(int nodes) {
+    std::mt19937 rng(nodes);
+    SynthMesh mesh(nodes, rng);
+
+    int maxHops = 0;
+    for (int h : mesh.hops) {
+        if (h < MAX_PATH && h > maxHops) maxHops = h;
+    }
+
+    Topology::clear();
+    int packets = nodes * PACKETS_PER_NODE;
+    auto start = std::chrono::steady_clock::now();
+    int reachable = feedFloods(mesh, packets, NOW, rng);
+    double observeUs = elapsedUs(start);
+
+    int vertices = Topology::getNodeCount();
+    int edges = Topology::getEdgeCount();
+
+    start = std::chrono::steady_clock::now();
+    int iterations = 0;
+    while (Topology::layoutStep(1) > 0.0f && iterations < 1000) iterations++;
+    double layoutUs = elapsedUs(start);
+
+    printf("%5d nodes, %3d reachable, up to %2d hops: %3d vertices, %3d edges%s\n",
+           nodes, reachable, maxHops, vertices, edges,
+           edges >= Topology::TOPO_MAX_EDGES ? " (table full)" : "");
+    printf("      observe %5.2f us/path   layout %d iterations, %6.1f us/iteration (%d pairs)\n",
+           observeUs / packets, iterations, layoutUs / (iterations + 1),
+           vertices * (vertices - 1) / 2);
+}
+
+int main() {
+    if (!Topology::init(SELF_HASH)) {
+        printf("Topology::init failed\n");
+        return 1;
+    }
+    printf("Topology benchmark: %d flood paths per node, mean degree %.0f\n\n",
+           PACKETS_PER_NODE, MEAN_DEGREE);
+    for (int nodes : SIZES) runSize(nodes);
+    return 0;
+}
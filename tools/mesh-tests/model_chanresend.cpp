@@ -0,0 +1,118 @@
+/**
+ * MeshBerry channel auto-resend model (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Monte Carlo model of the delivery and airtime trade-off behind `resend on`
+ * (dev-docs/changes/20261018-channel-auto-resend.md). The sender has a few
+ * relays in range:
+ *
+ *   - each of our transmissions reaches each relay with probability pOut
+ *   - a relay that hears a packet it has not seen before floods it, which
+ *     delivers the message and costs FLOOD_TX transmissions downstream
+ *   - we hear each relay's rebroadcast with probability pBack
+ *   - if we hear none, the packet is sent once more
+ *
+ * "Identical" resends the same bytes, so relays that already flooded the
+ * first copy drop it as seen. "Fresh" gives the copy a new timestamp, so
+ * every relay that hears it floods again. The seed is fixed, so the table
+ * is the same on every run.
+ */
+
+#include <cstdio>
+#include <random>
+
+static const int MESSAGES = 200000;          // Per row
+static const double FLOOD_TX = 3.0;          // Downstream transmissions per flood
+static const int MAX_RELAYS = 3;
+static const unsigned SEED = 7;
+
+static const double P_OUT[] = { 0.5, 0.7, 0.9 };
+static const double P_BACK[] = { 0.6, 0.9 };
+
+struct RowStats {
+    double delivered[3];     // Off, identical, fresh
+    double tx[3];
+    double resent;
+};
+
+static std::mt19937 s_rng(SEED);
+static std::uniform_real_distribution<double> s_uniform(0.0, 1.0);
+
+static bool chance(double p) {
+    return s_uniform(s_rng) < p;
+}
+
+static RowStats runRow(int relays, double pOut, double pBack) {
+    RowStats row = {};
+
+    for (int m = 0; m < MESSAGES; m++) {
+        // First transmission
+        bool flooded[MAX_RELAYS] = {};
+        int floods = 0;
+        int heard = 0;
+        for (int r = 0; r < relays; r++) {
+            if (!chance(pOut)) continue;
+            flooded[r] = true;
+            floods++;
+            if (chance(pBack)) heard++;
+        }
+        bool delivered = floods > 0;
+        double tx = 1 + floods * FLOOD_TX;
+
+        row.delivered[0] += delivered;
+        row.tx[0] += tx;
+
+        if (heard > 0) {
+            // A relay was heard in time, no resend
+            for (int mode = 1; mode < 3; mode++) {
+                row.delivered[mode] += delivered;
+                row.tx[mode] += tx;
+            }
+            continue;
+        }
+
+        // Nothing heard: send once more
+        row.resent++;
+        int newFloods = 0;      // Relays that had not flooded the first copy
+        int allFloods = 0;      // Every relay that hears the copy
+        for (int r = 0; r < relays; r++) {
+            if (!chance(pOut)) continue;
+            if (!flooded[r]) newFloods++;
+            allFloods++;
+        }
+        row.delivered[1] += delivered || newFloods > 0;
+        row.tx[1] += tx + 1 + newFloods * FLOOD_TX;
+        row.delivered[2] += delivered || allFloods > 0;
+        row.tx[2] += tx + 1 + allFloods * FLOOD_TX;
+    }
+
+    for (int mode = 0; mode < 3; mode++) {
+        row.delivered[mode] /= MESSAGES;
+        row.tx[mode] /= MESSAGES;
+    }
+    row.resent /= MESSAGES;
+    return row;
+}
+
+int main() {
+    printf("%d messages per row, %.0f transmissions per downstream flood\n\n",
+           MESSAGES, FLOOD_TX);
+    printf("relays pOut pBack | delivery off  ident  fresh | tx/msg off  ident  fresh | resent\n");
+
+    for (int relays = 1; relays <= MAX_RELAYS; relays++) {
+        for (double pOut : P_OUT) {
+            for (double pBack : P_BACK) {
+                RowStats row = runRow(relays, pOut, pBack);
+                printf("%6d %4.1f %5.1f | %12.3f %6.3f %6.3f | %10.2f %6.2f %6.2f | %5.1f%%\n",
+                       relays, pOut, pBack,
+                       row.delivered[0], row.delivered[1], row.delivered[2],
+                       row.tx[0], row.tx[1], row.tx[2], 100 * row.resent);
+            }
+        }
+    }
+    return 0;
+}
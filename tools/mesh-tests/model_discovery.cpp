@@ -0,0 +1,113 @@
+/**
+ * MeshBerry neighbour discovery slotting model (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Monte Carlo model of the discovery burst's reply slots
+ * (dev-docs/changes/20261018-neighbour-discovery.md). N MeshBerry
+ * neighbours hear every request at the same moment and each answers in a
+ * random one of DISCOVER_SLOTS slots:
+ *
+ *   - a reply lasts one airtime (Semtech formula, 40-byte response)
+ *   - two replies that overlap in time are both lost (no capture, no
+ *     listen-before-talk, so this is the worst case)
+ *   - a neighbour is found if any of its replies in the burst gets through
+ *
+ * "150 ms, 1 reply" is the first version: fixed 150 ms slots, and a 10 s
+ * reply rate limit that made neighbours ignore the burst's second request.
+ * "airtime, 2 replies" is the current one: slots one reply airtime plus a
+ * guard long, and up to one reply per request of a burst. Repeaters pick
+ * their own reply delay and are not modelled. The seed is fixed, so the
+ * table is the same on every run.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+static const int BURSTS = 100000;           // Per cell
+static const int SLOTS = 16;                // DISCOVER_SLOTS
+static const int REQUESTS = 2;              // DISCOVER_BURST_REQUESTS
+static const double OLD_SLOT_MS = 150.0;
+static const double GUARD_MS = 20.0;        // DISCOVER_SLOT_GUARD_MS
+static const int RESP_LEN = 40;             // Header, path length, 38-byte response
+static const int MAX_NEIGHBOURS = 16;
+static const unsigned SEED = 11;
+
+static const int NEIGHBOURS[] = { 2, 4, 7, 10, 16 };
+
+struct Radio {
+    const char* name;
+    int sf;
+    double bwKhz;
+};
+
+static const Radio RADIOS[] = {
+    { "SF7/62.5", 7, 62.5 },
+    { "SF10/250", 10, 250.0 },
+    { "SF11/250", 11, 250.0 },
+};
+
+static std::mt19937 s_rng(SEED);
+
+/**
+ * LoRa time on air (Semtech AN1200.13), 4/5 coding, explicit header,
+ * CRC on, 16-symbol preamble as in config.h
+ */
+static double airtimeMs(int sf, double bwKhz, int bytes) {
+    double tsym = (double)(1 << sf) / bwKhz;
+    int de = tsym > 16.0 ? 1 : 0;
+    double num = 8.0 * bytes - 4.0 * sf + 28 + 16;
+    double payloadSyms = 8 + std::max(std::ceil(num / (4.0 * (sf - 2 * de))) * 5, 0.0);
+    return (16 + 4.25 + payloadSyms) * tsym;
+}
+
+/**
+ * Share of neighbours not found by one burst
+ */
+static double missRate(int neighbours, double slotMs, double airtime, int replies) {
+    std::uniform_int_distribution<int> slotOf(0, SLOTS - 1);
+    long missed = 0;
+
+    for (int b = 0; b < BURSTS; b++) {
+        bool found[MAX_NEIGHBOURS] = {};
+        for (int r = 0; r < replies; r++) {
+            double start[MAX_NEIGHBOURS];
+            for (int n = 0; n < neighbours; n++) start[n] = slotOf(s_rng) * slotMs;
+            for (int n = 0; n < neighbours; n++) {
+                bool clear = true;
+                for (int m = 0; m < neighbours && clear; m++) {
+                    if (m != n && std::fabs(start[n] - start[m]) < airtime) clear = false;
+                }
+                if (clear) found[n] = true;
+            }
+        }
+        for (int n = 0; n < neighbours; n++) missed += !found[n];
+    }
+    return (double)missed / ((double)BURSTS * neighbours);
+}
+
+int main() {
+    printf("%d bursts per cell, %d slots, %d-byte replies, overlapping replies lost\n\n",
+           BURSTS, SLOTS, RESP_LEN);
+
+    for (const Radio& radio : RADIOS) {
+        double airtime = airtimeMs(radio.sf, radio.bwKhz, RESP_LEN);
+        double slot = airtime + GUARD_MS;
+        printf("%s: reply airtime %.0f ms, slot %.0f ms, burst %.1f s\n",
+               radio.name, airtime, slot, REQUESTS * (SLOTS * slot + 500) / 1000.0);
+        printf("  neighbours | missed: 150 ms, 1 reply | airtime, 1 reply | airtime, 2 replies\n");
+        for (int n : NEIGHBOURS) {
+            printf("  %10d | %22.1f%% | %15.1f%% | %17.1f%%\n", n,
+                   100 * missRate(n, OLD_SLOT_MS, airtime, 1),
+                   100 * missRate(n, slot, airtime, 1),
+                   100 * missRate(n, slot, airtime, REQUESTS));
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+/**
+ * MeshBerry mesh tests: Arduino shim (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#include "Arduino.h"
+#include <cstdarg>
+
+static uint64_t s_nowUs = 0;
+
+uint32_t millis() { return (uint32_t)(s_nowUs / 1000); }
+uint32_t micros() { return (uint32_t)s_nowUs; }
+void delay(uint32_t ms) { s_nowUs += (uint64_t)ms * 1000; }
+void delayMicroseconds(uint32_t us) { s_nowUs += us; }
+void yield() {}
+
+long random(long min, long max) {
+    static uint32_t state = 12345;
+    if (max <= min) return min;
+    state = state * 1103515245u + 12345u;
+    return min + (long)((state >> 8) % (uint32_t)(max - min));
+}
+
+void hostSetMicros(uint64_t us) { s_nowUs = us; }
+void hostAdvanceMicros(uint64_t us) { s_nowUs += us; }
+
+HostSerial Serial;
+
+static bool verbose() {
+    static int v = -1;
+    if (v < 0) v = getenv("MESH_TESTS_VERBOSE") ? 1 : 0;
+    return v == 1;
+}
+
+int HostSerial::printf(const char* fmt, ...) {
+    if (!verbose()) return 0;
+    va_list args;
+    va_start(args, fmt);
+    int n = vprintf(fmt, args);
+    va_end(args);
+    return n;
+}
+
+void HostSerial::print(const char* s) {
+    if (verbose()) fputs(s, stdout);
+}
+
+void HostSerial::println(const char* s) {
+    if (verbose()) puts(s);
+}
@@ -0,0 +1,47 @@
+/**
+ * MeshBerry mesh tests: Arduino shim (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Just enough of Arduino.h for the mesh modules under test. Time comes from
+ * a virtual clock that only moves when a test advances it or code under
+ * test delays, so runs are deterministic and instant. Serial output is
+ * discarded unless MESH_TESTS_VERBOSE is set in the environment.
+ */
+
+#ifndef MESHBERRY_TESTS_ARDUINO_H
+#define MESHBERRY_TESTS_ARDUINO_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Arduino's random(min, max): min inclusive, max exclusive. Fixed seed.
+long random(long min, long max);
+
+// Virtual clock control for tests
+void hostSetMicros(uint64_t us);
+void hostAdvanceMicros(uint64_t us);
+inline void hostAdvanceMillis(uint32_t ms) { hostAdvanceMicros((uint64_t)ms * 1000); }
+
+class HostSerial {
+public:
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+    void print(const char* s);
+    void println(const char* s = "");
+};
+
+extern HostSerial Serial;
+
+#endif // MESHBERRY_TESTS_ARDUINO_H
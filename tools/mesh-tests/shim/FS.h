@@ -0,0 +1,20 @@
+/**
+ * MeshBerry mesh tests: FS shim (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Only the type drivers/storage.h names. Modules under test reach storage
+ * through the Storage:: calls, which each test defines in memory.
+ */
+
+#ifndef MESHBERRY_TESTS_FS_H
+#define MESHBERRY_TESTS_FS_H
+
+namespace fs {
+class FS {};
+}
+
+#endif // MESHBERRY_TESTS_FS_H
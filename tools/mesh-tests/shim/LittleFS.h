@@ -0,0 +1,15 @@
+/**
+ * MeshBerry mesh tests: LittleFS shim (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ */
+
+#ifndef MESHBERRY_TESTS_LITTLEFS_H
+#define MESHBERRY_TESTS_LITTLEFS_H
+
+#include <FS.h>
+
+#endif // MESHBERRY_TESTS_LITTLEFS_H
@@ -0,0 +1,30 @@
+/**
+ * MeshBerry mesh tests: MeshCore shim (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * The MeshCore base classes the modules under test derive from, reduced
+ * to the members they use. MeshCore itself is fetched by PlatformIO and
+ * is not available to a host build.
+ */
+
+#ifndef MESHBERRY_TESTS_MESH_H
+#define MESHBERRY_TESTS_MESH_H
+
+#include <Arduino.h>
+
+namespace mesh {
+
+class RTCClock {
+public:
+    virtual ~RTCClock() = default;
+    virtual uint32_t getCurrentTime() = 0;
+    virtual void setCurrentTime(uint32_t time) = 0;
+};
+
+} // namespace mesh
+
+#endif // MESHBERRY_TESTS_MESH_H
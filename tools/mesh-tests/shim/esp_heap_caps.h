@@ -0,0 +1,25 @@
+/**
+ * MeshBerry mesh tests: ESP-IDF heap shim (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * The host has one heap, so capability allocations are plain malloc().
+ */
+
+#ifndef MESHBERRY_TESTS_ESP_HEAP_CAPS_H
+#define MESHBERRY_TESTS_ESP_HEAP_CAPS_H
+
+#include <cstdlib>
+
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_8BIT     (1 << 2)
+
+inline void* heap_caps_malloc(size_t size, unsigned caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+#endif // MESHBERRY_TESTS_ESP_HEAP_CAPS_H
@@ -0,0 +1,120 @@
+/**
+ * MeshBerry mesh tests: synthetic meshes (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Random geometric meshes for the topology and route planner benchmarks.
+ * Nodes are placed at random with about MEAN_DEGREE neighbours each and
+ * get random 1-byte path hashes, so larger meshes fold onto at most 256
+ * vertices the way they do on the device.
+ */
+
+#ifndef MESHBERRY_TESTS_SYNTHMESH_H
+#define MESHBERRY_TESTS_SYNTHMESH_H
+
+#include "mesh/Topology.h"
+#include "drivers/storage.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+static const int MAX_PATH = 64;             // MeshCore path limit
+static const double MEAN_DEGREE = 6.0;
+static const uint8_t SELF_HASH = 0x42;
+
+// Topology's storage calls; nothing is loaded or persisted
+namespace Storage {
+bool fileExists(const char*) { return false; }
+bool readFile(const char*, uint8_t*, size_t, size_t*) { return false; }
+bool writeFile(const char*, const uint8_t*, size_t) { return true; }
+}
+
+/**
+ * Random geometric mesh: node 0 is us, radio range 1
+ */
+struct SynthMesh {
+    std::vector<double> x, y;
+    std::vector<uint8_t> hash;
+    std::vector<std::vector<int>> neighbours;
+    std::vector<int> hops;                  // Hop distance to us, -1 if unreachable
+
+    SynthMesh(int nodes, std::mt19937& rng) {
+        double side = sqrt(nodes * M_PI / MEAN_DEGREE);
+        std::uniform_real_distribution<double> pos(0.0, side);
+        for (int i = 0; i < nodes; i++) {
+            x.push_back(i == 0 ? side / 2 : pos(rng));
+            y.push_back(i == 0 ? side / 2 : pos(rng));
+            hash.push_back(i == 0 ? SELF_HASH : (uint8_t)rng());
+        }
+
+        neighbours.resize(nodes);
+        for (int i = 0; i < nodes; i++) {
+            for (int j = i + 1; j < nodes; j++) {
+                double dx = x[i] - x[j], dy = y[i] - y[j];
+                if (dx * dx + dy * dy <= 1.0) {
+                    neighbours[i].push_back(j);
+                    neighbours[j].push_back(i);
+                }
+            }
+        }
+
+        // Breadth-first hop counts from us
+        hops.assign(nodes, -1);
+        std::vector<int> queue(1, 0);
+        hops[0] = 0;
+        for (size_t q = 0; q < queue.size(); q++) {
+            for (int n : neighbours[queue[q]]) {
+                if (hops[n] >= 0) continue;
+                hops[n] = hops[queue[q]] + 1;
+                queue.push_back(n);
+            }
+        }
+    }
+
+    /**
+     * Path hashes of a flood from `origin` that reached us along a random
+     * shortest path, ending with our own hash
+     */
+    int floodPath(int origin, std::mt19937& rng, uint8_t* out) const {
+        int len = 0;
+        int node = origin;
+        while (node != 0 && len < MAX_PATH) {
+            out[len++] = hash[node];
+            std::vector<int> closer;
+            for (int n : neighbours[node]) {
+                if (hops[n] == hops[node] - 1) closer.push_back(n);
+            }
+            node = closer[rng() % closer.size()];
+        }
+        out[len++] = hash[0];
+        return len;
+    }
+};
+
+/**
+ * Feed Topology `packets` flood paths from random reachable origins
+ * @return Number of reachable nodes
+ */
+static int feedFloods(const SynthMesh& mesh, int packets, uint32_t now, std::mt19937& rng) {
+    std::vector<int> reachable;
+    for (size_t i = 1; i < mesh.hops.size(); i++) {
+        if (mesh.hops[i] > 0 && mesh.hops[i] < MAX_PATH) reachable.push_back((int)i);
+    }
+    if (reachable.empty()) return 0;
+
+    std::normal_distribution<float> snr(0.0f, 4.0f);
+    uint8_t path[MAX_PATH + 1];
+    for (int p = 0; p < packets; p++) {
+        int origin = reachable[rng() % reachable.size()];
+        int len = mesh.floodPath(origin, rng, path);
+        Topology::observeChain(path, (uint8_t)len, snr(rng), true, now + p);
+    }
+    return (int)reachable.size();
+}
+
+#endif // MESHBERRY_TESTS_SYNTHMESH_H
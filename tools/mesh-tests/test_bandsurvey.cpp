@@ -0,0 +1,301 @@
+/**
+ * MeshBerry band survey tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Drives src/mesh/BandSurvey.cpp against a mock SurveyRadio with a
+ * scripted spectrum: a quiet band with a CAD-busy mesh channel, a
+ * channel with bursty interference and one clearly quieter channel. The
+ * main loop is stepped 1 ms at a time on the virtual clock.
+ */
+
+#include "mesh/BandSurvey.h"
+
+#include <random>
+#include <vector>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+using namespace BandSurvey;
+
+// =============================================================================
+// MOCK RADIO
+// =============================================================================
+
+struct ChannelModel {
+    float floorDbm;
+    float burstDbm;         // Level of interference bursts
+    float burstChance;      // Per RSSI sample
+    float cadChance;        // Per CAD
+};
+
+class MockRadio : public SurveyRadio {
+public:
+    explicit MockRadio(float homeMHz, float lowMHz, float stepMHz)
+        : home(homeMHz), low(lowMHz), step(stepMHz), rng(1234) {}
+
+    bool canPause() override { return !busy; }
+
+    bool tune(float mhz) override {
+        CHECK(!busy);
+        CHECK(!away);
+        tunes++;
+        away = true;
+        tunedAt = millis();
+        tuned = mhz;
+        return !(failFreq > 0 && fabsf(mhz - failFreq) < step / 2);
+    }
+
+    float readRssi() override {
+        const ChannelModel& m = model(tuned);
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+        if (u(rng) < m.burstChance) return m.burstDbm;
+        return m.floorDbm + u(rng) * 3.0f;
+    }
+
+    bool detectPreamble() override {
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+        return u(rng) < model(tuned).cadChance;
+    }
+
+    void restore() override {
+        CHECK(away);
+        away = false;
+        restores++;
+        uint32_t pause = millis() - tunedAt;
+        if (pause > longestPause) longestPause = pause;
+    }
+
+    float homeFrequency() const override { return home; }
+
+    ChannelModel& channel(int i) {
+        if ((int)models.size() <= i) models.resize(i + 1, quiet);
+        return models[i];
+    }
+
+    const ChannelModel& model(float mhz) {
+        int i = (int)((mhz - low) / step);
+        if (i < 0 || i >= (int)models.size()) return quiet;
+        return models[i];
+    }
+
+    float home, low, step;
+    std::mt19937 rng;
+    ChannelModel quiet = { -120.0f, 0.0f, 0.0f, 0.0f };
+    std::vector<ChannelModel> models;
+    bool busy = false;
+    bool away = false;
+    float tuned = 0;
+    float failFreq = 0;
+    uint32_t tunedAt = 0;
+    uint32_t longestPause = 0;
+    int tunes = 0;
+    int restores = 0;
+};
+
+static RadioSettings usSettings() {
+    RadioSettings s;
+    s.setDefaults();
+    return s;
+}
+
+/**
+ * Step the main loop until the sweep ends or `maxMs` passes
+ */
+static uint32_t runSweep(MockRadio& radio, uint32_t maxMs, int busyEveryMs = 0) {
+    uint32_t start = millis();
+    while (isRunning() && millis() - start < maxMs) {
+        if (busyEveryMs) radio.busy = (millis() / busyEveryMs) % 2 == 1;
+        process();
+        hostAdvanceMillis(1);
+    }
+    return millis() - start;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+static void testBandPlans() {
+    RadioSettings s = usSettings();
+    float low, high;
+
+    CHECK(getBand(s, low, high) && low == 902.0f && high == 928.0f);
+    s.setRegionPreset(REGION_EU);
+    CHECK(getBand(s, low, high) && low == 869.4f && high == 869.65f);
+    s.setRegionPreset(REGION_AU);
+    CHECK(getBand(s, low, high) && low == 915.0f && high == 928.0f);
+
+    s.region = REGION_CUSTOM;
+    s.frequency = 433.5f;
+    CHECK(getBand(s, low, high) && low == 432.5f && high == 434.5f);
+    s.frequency = 1020.5f;
+    CHECK(!getBand(s, low, high));
+
+    // US: 416 channels of 62.5 kHz, capped at the chart width
+    MockRadio radio(910.525f, 902.0f, 0.25f);
+    init(&radio);
+    CHECK(start(usSettings(), 40, 1));
+    const Result& r = getResult();
+    CHECK(r.channelCount == SURVEY_MAX_CHANNELS);
+    CHECK(fabsf(r.stepMHz - 0.25f) < 1e-4f);
+    CHECK(r.currentChannel == 34);
+    CHECK(r.channels[0].freqMHz > 902.0f);
+    CHECK(r.channels[r.channelCount - 1].freqMHz < 928.0f);
+    stop();
+
+    // EU sub-band: 4 channels of 62.5 kHz
+    s.setRegionPreset(REGION_EU);
+    CHECK(start(s, 40, 1));
+    CHECK(getResult().channelCount == 4);
+    stop();
+
+    // Dwell and passes are clamped
+    CHECK(start(usSettings(), 1, 0));
+    CHECK(getResult().dwellMs == SURVEY_DWELL_MIN_MS);
+    CHECK(getResult().passes == 1);
+    stop();
+    CHECK(start(usSettings(), 5000, 200));
+    CHECK(getResult().dwellMs == SURVEY_DWELL_MAX_MS);
+    CHECK(getResult().passes == SURVEY_MAX_PASSES);
+    stop();
+
+    init(nullptr);
+    CHECK(!start(usSettings(), 40, 1));
+}
+
+static void testRecommendation() {
+    MockRadio radio(910.525f, 902.0f, 0.25f);
+    radio.channel(34) = { -118.0f, -90.0f, 0.02f, 0.6f };   // Busy mesh channel
+    radio.channel(60) = { -126.0f, -80.0f, 0.3f, 0.0f };    // Quiet floor, loud bursts
+    radio.channel(80) = { -127.0f, 0.0f, 0.0f, 0.0f };      // Quietest
+    init(&radio);
+
+    CHECK(start(usSettings(), 40, 3));
+    runSweep(radio, 10 * 60 * 1000);
+    const Result& r = getResult();
+
+    CHECK(!r.running && r.complete);
+    CHECK(r.passDone == 3);
+    CHECK(r.recommended == 80);
+    CHECK(r.channels[34].cadHits > 0);
+    CHECK(r.channels[60].peakDbm == -80.0f);
+    CHECK(r.channels[60].score() > r.channels[80].score());
+    for (int i = 0; i < r.channelCount; i++) CHECK(r.channels[i].visits == 3);
+
+    // Mesh RX is interrupted for at most one dwell plus the CAD at a time
+    CHECK(radio.tunes == radio.restores);
+    CHECK(radio.longestPause <= 41);
+    uint32_t total = millis() - r.startedAt;
+    printf("(RX paused %.1f of %.1f s) ", r.pausedMs / 1000.0, total / 1000.0);
+    CHECK(r.pausedMs < total / 5);
+}
+
+static void testKeepCurrent() {
+    // Another channel is better, but by less than the keep margin
+    MockRadio radio(910.525f, 902.0f, 0.25f);
+    radio.quiet = { -115.0f, 0.0f, 0.0f, 0.0f };
+    radio.channel(34) = { -120.0f, 0.0f, 0.0f, 0.0f };
+    radio.channel(70) = { -120.5f, 0.0f, 0.0f, 0.0f };
+    init(&radio);
+
+    CHECK(start(usSettings(), 20, 1));
+    runSweep(radio, 5 * 60 * 1000);
+    CHECK(getResult().recommended == 34);
+
+    // Clearly better: move
+    radio.channel(70).floorDbm = -126.0f;
+    CHECK(start(usSettings(), 20, 1));
+    runSweep(radio, 5 * 60 * 1000);
+    CHECK(getResult().recommended == 70);
+}
+
+static void testBusyRadio() {
+    MockRadio radio(910.525f, 902.0f, 0.25f);
+    init(&radio);
+    CHECK(start(usSettings(), 20, 1));
+
+    // Never paused while busy: MockRadio::tune() checks
+    radio.busy = true;
+    runSweep(radio, 10 * 1000);
+    CHECK(radio.tunes == 0);
+    CHECK(getResult().nextChannel == 0);
+
+    // Busy half the time: the sweep still completes, just later
+    uint32_t took = runSweep(radio, 10 * 60 * 1000, 300);
+    CHECK(getResult().complete);
+    CHECK(took > (uint32_t)SURVEY_MAX_CHANNELS * SURVEY_GAP_MS);
+    CHECK(radio.tunes == SURVEY_MAX_CHANNELS);
+}
+
+static void testTuneFailure() {
+    MockRadio radio(910.525f, 902.0f, 0.25f);
+    radio.failFreq = 902.0f + 0.25f * 10.5f;
+    init(&radio);
+    CHECK(start(usSettings(), 20, 2));
+    runSweep(radio, 10 * 60 * 1000);
+
+    const Result& r = getResult();
+    CHECK(r.complete);
+    CHECK(r.channels[10].visits == 0);
+    CHECK(r.recommended != 10);
+    CHECK(radio.tunes == radio.restores);
+}
+
+static void testStop() {
+    MockRadio radio(910.525f, 902.0f, 0.25f);
+    radio.channel(5) = { -130.0f, 0.0f, 0.0f, 0.0f };
+    init(&radio);
+    CHECK(start(usSettings(), 20, 1));
+
+    // About 20 channels in, then stop
+    runSweep(radio, 20 * SURVEY_GAP_MS + 100);
+    stop();
+    const Result& r = getResult();
+    CHECK(!r.running && !r.complete);
+    CHECK(r.nextChannel > 5 && r.nextChannel < 30);
+    CHECK(r.recommended == 5);
+    CHECK(r.channels[r.channelCount - 1].visits == 0);
+}
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"Band plans",                  testBandPlans},
+    {"Recommendation",              testRecommendation},
+    {"Keep current channel",        testKeepCurrent},
+    {"Busy radio",                  testBusyRadio},
+    {"Tune failure",                testTuneFailure},
+    {"Stop",                        testStop},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
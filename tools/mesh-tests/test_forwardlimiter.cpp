@@ -0,0 +1,233 @@
+/**
+ * MeshBerry forward limiter tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Drives src/mesh/ForwardLimiter.cpp directly with scripted traffic: an
+ * abusive source among normal ones, a burst, a busy channel next to a
+ * quiet one, bucket recycling and the configuration calls. The limiter
+ * takes time as an argument, so no clock is needed.
+ */
+
+#include "mesh/ForwardLimiter.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+using namespace ForwardLimiter;
+
+static void reset() {
+    clear();
+    resetStats();
+    setEnabled(true);
+    setRate(FL_CLASS_ADVERT, FL_DEFAULT_RATE_ADVERT);
+    setRate(FL_CLASS_CHANNEL, FL_DEFAULT_RATE_CHANNEL);
+    setRate(FL_CLASS_PEER, FL_DEFAULT_RATE_PEER);
+    setRate(FL_CLASS_OTHER, FL_DEFAULT_RATE_OTHER);
+}
+
+struct Tally {
+    int passed = 0, deferred = 0, dropped = 0;
+
+    void add(Verdict v) {
+        if (v == FL_PASS) passed++;
+        else if (v == FL_DEFER) deferred++;
+        else dropped++;
+    }
+    int relayed() const { return passed + deferred; }
+};
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+/**
+ * An abuser at 60/min among 8 normal sources at 3/min, for 30 minutes
+ */
+static void testFairness() {
+    reset();
+    static const int MINUTES = 30;
+    Tally abuser, normal;
+
+    for (uint32_t t = 0; t < MINUTES * 60000u; t += 1000) {
+        abuser.add(check(0xAB, FL_SOURCE_ORIGIN, FL_CLASS_PEER, t));
+        if (t % 20000 == 0) {
+            for (uint8_t n = 1; n <= 8; n++) {
+                normal.add(check(n, FL_SOURCE_ORIGIN, FL_CLASS_PEER, t + n));
+            }
+        }
+    }
+
+    printf("(abuser %d/%d/%d) ", abuser.passed, abuser.deferred, abuser.dropped);
+    CHECK(normal.passed == 8 * 3 * MINUTES);
+    CHECK(normal.deferred == 0 && normal.dropped == 0);
+
+    // Refill plus the first burst plus one burst of debt
+    int budget = FL_DEFAULT_RATE_PEER * MINUTES + 2 * FL_DEFAULT_RATE_PEER;
+    CHECK(abuser.relayed() >= budget - 2 && abuser.relayed() <= budget);
+    CHECK(abuser.dropped == 60 * MINUTES - abuser.relayed());
+
+    const Stats& st = getStats();
+    CHECK((int)st.passed[FL_CLASS_PEER] == abuser.passed + normal.passed);
+    CHECK((int)st.dropped[FL_CLASS_PEER] == abuser.dropped);
+}
+
+/**
+ * A burst is passed, then deferred, then dropped; dropping costs nothing
+ */
+static void testBurst() {
+    reset();
+    Tally burst;
+    for (int i = 0; i < 30; i++) burst.add(check(7, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 1000));
+    CHECK(burst.passed == FL_DEFAULT_RATE_PEER);
+    CHECK(burst.deferred == FL_DEFAULT_RATE_PEER);
+    CHECK(burst.dropped == 30 - 2 * FL_DEFAULT_RATE_PEER);
+
+    // One packet of refill (60 s / rate) brings the debt back above the line
+    uint32_t perPacket = 60000 / FL_DEFAULT_RATE_PEER;
+    CHECK(check(7, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 1000 + perPacket - 1) == FL_DROP);
+    CHECK(check(7, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 1000 + perPacket) == FL_DEFER);
+
+    // Long idle: back to a full burst, never more
+    Tally later;
+    for (int i = 0; i < 30; i++) later.add(check(7, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 60 * 60000));
+    CHECK(later.passed == FL_DEFAULT_RATE_PEER);
+}
+
+/**
+ * Channel floods share one bucket per channel hash
+ */
+static void testChannels() {
+    reset();
+    Tally busy, quiet;
+
+    // A busy channel at 120/min and a quiet one at 10/min, for 10 minutes
+    for (uint32_t t = 0; t < 10 * 60000u; t += 500) {
+        busy.add(check(0x11, FL_SOURCE_CHANNEL, FL_CLASS_CHANNEL, t));
+        if (t % 6000 == 0) quiet.add(check(0x22, FL_SOURCE_CHANNEL, FL_CLASS_CHANNEL, t + 1));
+    }
+    CHECK(quiet.passed == 100 && quiet.relayed() == 100);
+    int budget = FL_DEFAULT_RATE_CHANNEL * 10 + 2 * FL_DEFAULT_RATE_CHANNEL;
+    CHECK(busy.relayed() >= budget - 2 && busy.relayed() <= budget);
+    CHECK(busy.dropped > 0);
+
+    // A channel hash and an originator hash with the same value are separate
+    CHECK(check(0x11, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 10 * 60000) == FL_PASS);
+    CHECK(getBucketCount() == 3);
+    CHECK(getStats().dropped[FL_CLASS_CHANNEL] == (uint32_t)busy.dropped);
+}
+
+/**
+ * More sources than buckets: the idle ones are recycled
+ */
+static void testRecycling() {
+    reset();
+    for (int i = 0; i < 64; i++) {
+        CHECK(check((uint8_t)i, FL_SOURCE_ORIGIN, FL_CLASS_ADVERT, 1000 + i) == FL_PASS);
+    }
+    CHECK(getBucketCount() == FL_MAX_BUCKETS);
+    CHECK(getStats().evictions == 64 - FL_MAX_BUCKETS);
+
+    // The newest 32 are still tracked: their third advert in a burst of 4 passes,
+    // the fourth is deferred
+    for (int i = 32; i < 64; i++) {
+        check((uint8_t)i, FL_SOURCE_ORIGIN, FL_CLASS_ADVERT, 2000);
+        check((uint8_t)i, FL_SOURCE_ORIGIN, FL_CLASS_ADVERT, 2000);
+        CHECK(check((uint8_t)i, FL_SOURCE_ORIGIN, FL_CLASS_ADVERT, 2000) == FL_DEFER);
+    }
+    CHECK(getStats().evictions == 64 - FL_MAX_BUCKETS);
+
+    int seen = 0;
+    for (int s = 0; s < FL_MAX_BUCKETS; s++) {
+        const Bucket* b = getBucketSlot(s);
+        if (b && b->hash >= 32) seen++;
+    }
+    CHECK(seen == FL_MAX_BUCKETS);
+    CHECK(getBucketSlot(-1) == nullptr && getBucketSlot(FL_MAX_BUCKETS) == nullptr);
+}
+
+static void testConfiguration() {
+    reset();
+
+    // Disabled: everything passes and is counted, no buckets
+    setEnabled(false);
+    CHECK(!isEnabled());
+    for (int i = 0; i < 50; i++) CHECK(check(1, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 0) == FL_PASS);
+    CHECK(getBucketCount() == 0);
+    CHECK(getStats().passed[FL_CLASS_PEER] == 50);
+    setEnabled(true);
+
+    // Rate 0: unlimited
+    setRate(FL_CLASS_OTHER, 0);
+    for (int i = 0; i < 50; i++) CHECK(check(1, FL_SOURCE_ORIGIN, FL_CLASS_OTHER, 0) == FL_PASS);
+    CHECK(getRate(FL_CLASS_OTHER) == 0);
+
+    // Minimum burst, whatever the rate
+    setRate(FL_CLASS_ADVERT, 1);
+    Tally t;
+    for (int i = 0; i < 3; i++) t.add(check(9, FL_SOURCE_ORIGIN, FL_CLASS_ADVERT, 0));
+    CHECK(t.passed == FL_MIN_BURST);
+
+    // Lowering a rate trims buckets holding more than the new burst
+    reset();
+    check(5, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 0);
+    setRate(FL_CLASS_PEER, 4);
+    Tally trimmed;
+    for (int i = 0; i < 6; i++) trimmed.add(check(5, FL_SOURCE_ORIGIN, FL_CLASS_PEER, 0));
+    CHECK(trimmed.passed == 4);
+    CHECK(trimmed.deferred == 2);
+
+    // Out-of-range classes count as "other"
+    reset();
+    CHECK(check(1, FL_SOURCE_ORIGIN, (TrafficClass)99, 0) == FL_PASS);
+    CHECK(getStats().passed[FL_CLASS_OTHER] == 1);
+    CHECK(getRate((TrafficClass)99) == 0);
+
+    // clear() forgets buckets and keeps counters
+    clear();
+    CHECK(getBucketCount() == 0);
+    CHECK(getStats().passed[FL_CLASS_OTHER] == 1);
+}
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"Fairness",                    testFairness},
+    {"Burst",                       testBurst},
+    {"Channels",                    testChannels},
+    {"Recycling",                   testRecycling},
+    {"Configuration",               testConfiguration},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,384 @@
+/**
+ * MeshBerry channel history sync tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Builds src/mesh/HistorySync.cpp against an in-memory channel archive,
+ * one per simulated node. The convergence test replays the exchange that
+ * MeshBerryMesh runs over the air (summaries, up to MAX_SYNC_OUT records
+ * per neighbour, overheard records cancelled, reply summaries) on a line
+ * of zero-hop neighbours, with the same airtime budget. Packet loss and
+ * the transport itself are not modelled.
+ */
+
+#include "mesh/HistorySync.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+using namespace HistorySync;
+
+// Values from MeshBerryMesh.h
+static const int MAX_SYNC_OUT = 4;
+static const int BUDGET_BYTES_PER_ROUND = 1024 * 15 / 10;   // 1024 per 10 min, 15 min rounds
+static const int PACKET_OVERHEAD = 20;
+
+static const uint32_t NOW = 1790000000;     // RTC time of the tests
+
+// =============================================================================
+// IN-MEMORY ARCHIVE
+// =============================================================================
+
+// One archive per channel index, in append order like the archive files
+static std::vector<ArchivedMessage> s_archives[8];
+
+namespace MessageArchive {
+
+int loadChannelMessages(int channelIdx, ArchivedMessage* buffer, int maxCount) {
+    const std::vector<ArchivedMessage>& archive = s_archives[channelIdx];
+    int count = std::min((int)archive.size(), maxCount);
+    std::copy(archive.end() - count, archive.end(), buffer);
+    return count;
+}
+
+} // namespace MessageArchive
+
+static ArchivedMessage makeMessage(uint32_t timestamp, const char* sender, const char* text) {
+    ArchivedMessage msg;
+    msg.clear();
+    msg.timestamp = timestamp;
+    snprintf(msg.sender, sizeof(msg.sender), "%s", sender);
+    snprintf(msg.text, sizeof(msg.text), "%s", text);
+    return msg;
+}
+
+static void clearArchives() {
+    for (std::vector<ArchivedMessage>& archive : s_archives) archive.clear();
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+static void testKeys() {
+    uint32_t key = messageKey(NOW, "Alice", "hello");
+    CHECK(key == messageKey(NOW, "Alice", "hello"));
+    CHECK(key != messageKey(NOW + 1, "Alice", "hello"));
+    CHECK(key != messageKey(NOW, "Alice", "hello!"));
+    CHECK(messageKey(NOW, "ab", "c") != messageKey(NOW, "a", "bc"));
+    CHECK(messageKey(NOW, nullptr, nullptr) == messageKey(NOW, "", ""));
+
+    ArchivedMessage msg = makeMessage(NOW, "Alice", "hello");
+    CHECK(messageKey(msg) == key);
+}
+
+static void testWireFormat() {
+    clearArchives();
+    for (int i = 0; i < 10; i++) {
+        char text[16];
+        snprintf(text, sizeof(text), "msg %d", i);
+        s_archives[0].push_back(makeMessage(NOW - 600 + i, "Bob", text));
+    }
+
+    Summary summary;
+    CHECK(buildSummary(0, NOW, summary));
+    CHECK(summary.count == 10);
+    CHECK(summary.since == NOW - SYNC_WINDOW_SECS);
+
+    uint8_t buf[SYNC_SUMMARY_LEN];
+    CHECK(encodeSummary(summary, buf, sizeof(buf) - 1) == 0);
+    CHECK(encodeSummary(summary, buf, sizeof(buf)) == SYNC_SUMMARY_LEN);
+
+    Summary decoded;
+    CHECK(!decodeSummary(buf, sizeof(buf) - 1, decoded));
+    CHECK(decodeSummary(buf, sizeof(buf), decoded));
+    CHECK(decoded.since == summary.since);
+    CHECK(decoded.count == summary.count);
+    CHECK(memcmp(decoded.bloom, summary.bloom, SYNC_BLOOM_BYTES) == 0);
+
+    // Our own archive has nothing the summary lacks
+    ArchivedMessage out[MAX_SYNC_OUT];
+    CHECK(findMissing(0, decoded, out, MAX_SYNC_OUT) == 0);
+    CHECK(hasMessage(0, messageKey(s_archives[0][3])));
+    CHECK(!hasMessage(0, messageKey(NOW, "Bob", "msg 3")));
+}
+
+/**
+ * Measured false-positive rate of a full 48-key summary
+ */
+static void testBloom() {
+    std::mt19937 rng(11);
+    uint8_t bloom[SYNC_BLOOM_BYTES] = {};
+    std::set<uint32_t> inserted;
+    for (int i = 0; i < SYNC_MAX_ITEMS; i++) {
+        uint32_t key = rng();
+        inserted.insert(key);
+        bloomAdd(bloom, key, NOW);
+    }
+    for (uint32_t key : inserted) CHECK(bloomContains(bloom, key, NOW));
+
+    static const int PROBES = 200000;
+    std::vector<uint32_t> falsePositives;
+    for (int i = 0; i < PROBES; i++) {
+        uint32_t key = rng();
+        if (!inserted.count(key) && bloomContains(bloom, key, NOW)) falsePositives.push_back(key);
+    }
+    double rate = 100.0 * falsePositives.size() / PROBES;
+    printf("(%.1f%% false positives) ", rate);
+    CHECK(rate < 4.0);
+
+    // The next round's summary, with a new salt, catches nearly all of them
+    uint8_t next[SYNC_BLOOM_BYTES] = {};
+    for (uint32_t key : inserted) bloomAdd(next, key, NOW + 900);
+    int again = 0;
+    for (uint32_t key : falsePositives) {
+        if (bloomContains(next, key, NOW + 900)) again++;
+    }
+    CHECK(again * 10 < (int)falsePositives.size());
+}
+
+/**
+ * Records the remote may lack but must not be offered
+ */
+static void testLimits() {
+    clearArchives();
+    char longText[SYNC_MAX_RECORD_TEXT];
+    memset(longText, 'x', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+
+    s_archives[0].push_back(makeMessage(NOW - SYNC_WINDOW_SECS - 60, "Old", "too old"));
+    ArchivedMessage own = makeMessage(NOW - 50, "Me", "own send");
+    own.isOutgoing = 1;
+    s_archives[0].push_back(own);
+    s_archives[0].push_back(makeMessage(NOW - 40, "Long", longText));
+    for (int i = 0; i < 6; i++) {
+        char text[24];
+        snprintf(text, sizeof(text), "fits %d", i);
+        s_archives[0].push_back(makeMessage(NOW - 30 + i, "Ok", text));
+    }
+
+    Summary empty;
+    empty.clear();
+    empty.since = NOW - SYNC_WINDOW_SECS;
+
+    ArchivedMessage out[8];
+    int found = findMissing(0, empty, out, 8);
+    CHECK(found == 6);
+    for (int i = 0; i < found; i++) CHECK(strcmp(out[i].sender, "Ok") == 0);
+    CHECK(findMissing(0, empty, out, 3) == 3);
+    CHECK(strcmp(out[0].text, "fits 0") == 0);
+    CHECK(findMissing(0, empty, nullptr, 3) == 0);
+
+    // Only the newest SYNC_MAX_ITEMS entries are summarised
+    clearArchives();
+    for (int i = 0; i < SYNC_MAX_ITEMS + 10; i++) {
+        char text[16];
+        snprintf(text, sizeof(text), "n %d", i);
+        s_archives[0].push_back(makeMessage(NOW - 1000 + i, "Bob", text));
+    }
+    Summary summary;
+    CHECK(buildSummary(0, NOW, summary));
+    CHECK(summary.count == SYNC_MAX_ITEMS);
+    CHECK(!hasMessage(0, messageKey(s_archives[0][0])));
+}
+
+// =============================================================================
+// CONVERGENCE
+// =============================================================================
+
+/**
+ * Node n is channel archive n, neighbours n - 1 and n + 1
+ */
+struct SyncSim {
+    int nodes;
+    int budget[8];
+    bool sentSummary[8];
+    int records;
+    uint32_t now;
+    std::mt19937 rng;
+
+    SyncSim(int n, unsigned seed) : nodes(n), records(0), now(NOW), rng(seed) {}
+
+    bool spend(int node, int bytes) {
+        if (budget[node] < bytes) return false;
+        budget[node] -= bytes;
+        return true;
+    }
+
+    /**
+     * A record from `from` is heard by its neighbours, who archive it
+     * through the callback if it is new to them
+     */
+    void broadcastRecord(int from, const ArchivedMessage& msg) {
+        uint32_t key = messageKey(msg);
+        for (int n = from - 1; n <= from + 1; n += 2) {
+            if (n < 0 || n >= nodes) continue;
+            if (!hasMessage(n, key)) s_archives[n].push_back(msg);
+        }
+    }
+
+    /**
+     * `from` sends a summary; neighbours answer with what it lacks and
+     * queue their own summary as a reply
+     */
+    void sendSummary(int from, std::vector<int>& replies) {
+        if (!spend(from, SYNC_HEADER_LEN + SYNC_SUMMARY_LEN + PACKET_OVERHEAD)) return;
+
+        Summary summary;
+        buildSummary(from, now, summary);
+
+        // Neighbours answer after random delays; a record overheard from
+        // the other neighbour cancels the same queued record
+        int order[2] = { from - 1, from + 1 };
+        if (rng() & 1) std::swap(order[0], order[1]);
+        std::set<uint32_t> heard;
+        for (int n : order) {
+            if (n < 0 || n >= nodes) continue;
+            ArchivedMessage missing[MAX_SYNC_OUT];
+            int count = findMissing(n, summary, missing, MAX_SYNC_OUT);
+            for (int m = 0; m < count; m++) {
+                uint32_t key = messageKey(missing[m]);
+                if (heard.count(key)) continue;
+                int len = 10 + strlen(missing[m].sender) + 2 + strlen(missing[m].text);
+                if (!spend(n, len + PACKET_OVERHEAD)) break;
+                heard.insert(key);
+                records++;
+                broadcastRecord(n, missing[m]);
+            }
+            if (!sentSummary[n]) replies.push_back(n);
+        }
+    }
+
+    /**
+     * One 15-minute round: every node sends its periodic summary, or an
+     * earlier reply to a neighbour's
+     */
+    void runRound() {
+        now += 15 * 60;
+        for (int n = 0; n < nodes; n++) {
+            budget[n] = BUDGET_BYTES_PER_ROUND;
+            sentSummary[n] = false;
+        }
+        std::vector<int> periodic;
+        for (int n = 0; n < nodes; n++) periodic.push_back(n);
+        std::shuffle(periodic.begin(), periodic.end(), rng);
+
+        for (int start : periodic) {
+            if (sentSummary[start]) continue;
+            std::vector<int> pending(1, start);
+            while (!pending.empty()) {
+                int from = pending.front();
+                pending.erase(pending.begin());
+                if (sentSummary[from]) continue;
+                sentSummary[from] = true;    // At most one summary per round
+                sendSummary(from, pending);
+            }
+        }
+    }
+
+    bool converged(int messages) const {
+        for (int n = 0; n < nodes; n++) {
+            if ((int)s_archives[n].size() < messages) return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * Six nodes in a line each heard 70% of 40 channel messages from senders
+ * outside the line. Count the rounds until every node has all 40.
+ */
+static void testConvergence() {
+    static const int NODES = 6;
+    static const int MESSAGES = 40;
+    static const int SEEDS = 20;
+    int worstRounds = 0, totalRounds = 0, maxRecords = 0;
+    int extra = 0;
+
+    for (unsigned seed = 1; seed <= SEEDS; seed++) {
+        clearArchives();
+        SyncSim sim(NODES, seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        for (int m = 0; m < MESSAGES; m++) {
+            char sender[16], text[48];
+            snprintf(sender, sizeof(sender), "Far%d", (int)(sim.rng() % 5));
+            snprintf(text, sizeof(text), "message %d from the far side", m);
+            ArchivedMessage msg = makeMessage(NOW - 3600 + m * 60, sender, text);
+            bool anyone = false;
+            for (int n = 0; n < NODES; n++) {
+                if (uniform(sim.rng) < 0.7) {
+                    s_archives[n].push_back(msg);
+                    anyone = true;
+                }
+            }
+            if (!anyone) s_archives[sim.rng() % NODES].push_back(msg);
+        }
+
+        int rounds = 0;
+        while (!sim.converged(MESSAGES) && rounds < 20) {
+            sim.runRound();
+            rounds++;
+        }
+        CHECK(sim.converged(MESSAGES));
+        for (int n = 0; n < NODES; n++) {
+            if ((int)s_archives[n].size() > MESSAGES) extra++;
+        }
+
+        worstRounds = std::max(worstRounds, rounds);
+        totalRounds += rounds;
+        maxRecords = std::max(maxRecords, sim.records);
+    }
+
+    printf("(rounds avg %.1f, worst %d, at most %d records) ", (double)totalRounds / SEEDS,
+           worstRounds, maxRecords);
+    CHECK(extra == 0);
+    CHECK(worstRounds <= 6);
+}
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"Message keys",                testKeys},
+    {"Wire format",                 testWireFormat},
+    {"Bloom summary",               testBloom},
+    {"Offer limits",                testLimits},
+    {"Convergence",                 testConvergence},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/**
+ * MeshBerry peer table tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Drives src/mesh/PeerTable.cpp directly: eviction order, key and route
+ * fields, and eviction with most of the table pinned, counting how many
+ * pinned records the evictions have to check.
+ */
+
+#include "mesh/PeerTable.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+static const int CAP = PeerTable::CAPACITY;
+
+// Pinned IDs (stand-in for the contact list)
+static const uint32_t PIN_RANGE = 1024;
+static bool s_pinned[PIN_RANGE];
+
+static bool isPinned(uint32_t id) {
+    return id < PIN_RANGE && s_pinned[id];
+}
+
+// One table per test; the records are never freed, as on the device
+static PeerTable s_tables[4];
+static int s_nextTable = 0;
+
+static PeerTable* newTable(bool withPins) {
+    PeerTable* t = &s_tables[s_nextTable++];
+    CHECK(t->begin());
+    for (uint32_t i = 0; i < PIN_RANGE; i++) s_pinned[i] = false;
+    t->setPinned(withPins ? isPinned : nullptr);
+    return t;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+static void testEviction() {
+    // Calls before begin() see an empty table
+    PeerTable idle;
+    CHECK(idle.find(1) == PeerTable::NONE && idle.newest() == PeerTable::NONE);
+    CHECK(idle.size() == 0 && !idle.used(0));
+    idle.touch(0);
+    idle.erase(0);
+
+    PeerTable* t = newTable(false);
+    bool created = false;
+    for (uint32_t id = 1; id <= (uint32_t)CAP + 44; id++) {
+        int slot = t->acquire(id, &created);
+        CHECK(created);
+        CHECK(t->hot(slot).id == id && t->hot(slot).outPathLen == -1);
+    }
+    CHECK((int)t->size() == CAP);
+    CHECK(t->evictions() == 44);
+    CHECK(t->find(44) == PeerTable::NONE);
+    CHECK(t->find(45) != PeerTable::NONE);
+
+    // Touching the oldest protects it; the next oldest goes instead
+    t->touch(t->find(45));
+    t->acquire(5000);
+    CHECK(t->find(45) != PeerTable::NONE);
+    CHECK(t->find(46) == PeerTable::NONE);
+
+    // Existing records are found, not recreated
+    t->acquire(45, &created);
+    CHECK(!created);
+
+    // An erased record's slot is free again, so nothing is evicted
+    t->erase(t->find(47));
+    t->acquire(5001);
+    CHECK(t->evictions() == 45);
+}
+
+static void testKeyAndRoute() {
+    PeerTable* t = newTable(false);
+    int slot = t->acquire(7);
+
+    uint8_t key[32];
+    for (int i = 0; i < 32; i++) key[i] = (uint8_t)(0xA0 + i);
+    t->setKey(slot, key);
+    CHECK(t->hot(slot).hashByte == 0xA0);
+    t->hot(slot).flags |= PEER_HAS_SECRET;
+
+    // Same key keeps the secret, a new key drops it
+    t->setKey(slot, key);
+    CHECK(t->hot(slot).flags & PEER_HAS_SECRET);
+    key[5] ^= 1;
+    t->setKey(slot, key);
+    CHECK(!(t->hot(slot).flags & PEER_HAS_SECRET));
+    CHECK(t->hot(slot).flags & PEER_HAS_KEY);
+
+    const uint8_t path[3] = { 0x11, 0x22, 0x33 };
+    t->setPath(slot, path, 3);
+    CHECK(t->hot(slot).outPathLen == 3 && t->hot(slot).pathLearnedAt != 0);
+    CHECK(t->cold(slot).outPath[2] == 0x33);
+    t->setPath(slot, path, 0);
+    CHECK(t->hot(slot).outPathLen == 0);
+    t->clearPath(slot);
+    CHECK(t->hot(slot).outPathLen == -1 && t->hot(slot).pathLearnedAt == 0);
+}
+
+/**
+ * 200 of 256 records pinned, then 10000 new nodes heard
+ */
+static void testPinnedCost() {
+    PeerTable* t = newTable(true);
+    static const uint32_t PINNED = 200;
+    for (uint32_t id = 0; id < PINNED; id++) {
+        s_pinned[id] = true;
+        t->acquire(id);
+    }
+
+    static const uint32_t HEARD = 10000;
+    for (uint32_t i = 0; i < HEARD; i++) {
+        t->acquire(PIN_RANGE + i);
+        // A few contacts stay active, so they are checked again
+        if (i % 100 == 0) t->touch(t->find(i / 100 % PINNED));
+    }
+
+    bool allKept = true;
+    for (uint32_t id = 0; id < PINNED; id++) {
+        if (t->find(id) == PeerTable::NONE) allKept = false;
+    }
+    CHECK(allKept);
+    CHECK(t->evictions() == HEARD - (CAP - PINNED));
+
+    // Each pinned record is checked once, plus once per touch
+    printf("(%lu pin checks for %lu evictions) ", (unsigned long)t->pinChecks(),
+           (unsigned long)t->evictions());
+    CHECK(t->pinChecks() <= t->evictions() + PINNED + HEARD / 100);
+}
+
+/**
+ * A pin dropped without a touch, and a table that is all pinned
+ */
+static void testAllPinned() {
+    PeerTable* t = newTable(true);
+    for (uint32_t id = 0; id < (uint32_t)CAP; id++) {
+        s_pinned[id] = true;
+        t->acquire(id);
+    }
+
+    // Every record pinned: the least recently used one goes
+    s_pinned[300] = true;
+    t->acquire(300);
+    CHECK(t->find(0) == PeerTable::NONE);
+    CHECK(t->find(300) != PeerTable::NONE);
+
+    // Unpinned without a touch (a contact deleted): it is still found
+    s_pinned[100] = false;
+    s_pinned[301] = true;
+    t->acquire(301);
+    CHECK(t->find(100) == PeerTable::NONE);
+    CHECK(t->find(1) != PeerTable::NONE && t->find(300) != PeerTable::NONE);
+}
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"Eviction",                    testEviction},
+    {"KeyAndRoute",                 testKeyAndRoute},
+    {"PinnedCost",                  testPinnedCost},
+    {"AllPinned",                   testAllPinned},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
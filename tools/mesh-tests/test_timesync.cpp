@@ -0,0 +1,320 @@
+/**
+ * MeshBerry time sync tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Runs src/mesh/TimeSync.cpp with the real ESP32RTCClock on the virtual
+ * clock. Peers advert about every 30 s over 0-2 hops with jittered link delay,
+ * one of them a minute off, and our oscillator runs 40 ppm slow. The
+ * estimator has to converge on true time and learn the skew, and the
+ * authority rules for GPS, manual and already-synced clocks must hold.
+ */
+
+#include "mesh/TimeSync.h"
+#include "mesh/MeshBerryRTCClock.h"
+
+#include <random>
+#include <vector>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+static const double START_EPOCH_MS = 1760000000000.0;
+static const double OSC_PPM = -40.0;                 // Local oscillator slow
+static const uint32_t STEP_MS = 100;
+
+// =============================================================================
+// SIMULATED MESH
+// =============================================================================
+
+struct Peer {
+    uint8_t hash;
+    uint8_t hops;
+    double clockOffsetMs;   // Peer clock minus true time
+    bool preferred;
+    uint32_t nextAdvertAt;  // Local millis()
+};
+
+class SimMesh {
+public:
+    explicit SimMesh(uint32_t seed) : rng(seed) { startLocalMs = millis(); }
+
+    double trueMs() const {
+        // Local time runs slow by OSC_PPM, so true time runs ahead of it
+        double local = (double)(millis() - startLocalMs);
+        return START_EPOCH_MS + local / (1.0 + OSC_PPM * 1e-6);
+    }
+
+    void addPeer(uint8_t hash, uint8_t hops, double offsetMs, bool preferred = false) {
+        Peer p = { hash, hops, offsetMs, preferred, millis() + (uint32_t)(peers.size() * 5000) };
+        peers.push_back(p);
+    }
+
+    /**
+     * Deliver due adverts and run the mesh loop for `ms`
+     */
+    void run(uint32_t ms, ESP32RTCClock& clock) {
+        for (uint32_t t = 0; t < ms; t += STEP_MS) {
+            for (Peer& p : peers) {
+                if ((int32_t)(millis() - p.nextAdvertAt) < 0) continue;
+                // Jittered, or the whole-second truncation error drifts
+                // slowly with our skew instead of averaging out
+                std::uniform_int_distribution<uint32_t> interval(25000, 35000);
+                p.nextAdvertAt += interval(rng);
+
+                // Sent one link delay per link ago, 500 +/- 200 ms each
+                std::uniform_real_distribution<double> link(300.0, 700.0);
+                double flight = 0;
+                for (int l = 0; l <= p.hops; l++) flight += link(rng);
+                double sentPeerMs = trueMs() - flight + p.clockOffsetMs;
+                uint32_t peerTime = (uint32_t)(sentPeerMs / 1000.0);
+
+                clock.trySyncFromPeer(peerTime);
+                TimeSync::addSample(p.hash, peerTime, p.hops, p.preferred);
+            }
+            TimeSync::maintain();
+            hostAdvanceMillis(STEP_MS);
+        }
+    }
+
+    double errorMs(ESP32RTCClock& clock) const {
+        return (double)clock.nowMs() - trueMs();
+    }
+
+    std::mt19937 rng;
+    std::vector<Peer> peers;
+    uint32_t startLocalMs;
+};
+
+/**
+ * Largest clock error over `ms` of running
+ */
+static double worstError(SimMesh& sim, ESP32RTCClock& clock, uint32_t ms) {
+    double worst = 0;
+    for (uint32_t t = 0; t < ms; t += 10000) {
+        sim.run(10000, clock);
+        double e = fabs(sim.errorMs(clock));
+        if (e > worst) worst = e;
+    }
+    return worst;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+static void testConvergeAgreeing() {
+    hostSetMicros(1000000);
+    ESP32RTCClock clock;
+    TimeSync::init(&clock);
+    SimMesh sim(1);
+    for (uint8_t i = 0; i < 4; i++) sim.addPeer(0x10 + i, i % 3, 0.0);
+    sim.addPeer(0x66, 1, 60000.0);      // A minute off
+
+    // An hour to settle, then four hours measured
+    sim.run(60 * 60 * 1000, clock);
+    double worst = 0, skewSum = 0;
+    int skewCount = 0;
+    for (int i = 0; i < 24; i++) {
+        double w = worstError(sim, clock, 10 * 60 * 1000);
+        if (w > worst) worst = w;
+        skewSum += TimeSync::getStatus().skewPpm;
+        skewCount++;
+    }
+    double meanSkew = skewSum / skewCount;
+    printf("(worst %.0f ms, skew %.0f ppm) ", worst, meanSkew);
+
+    const TimeSync::Status& st = TimeSync::getStatus();
+    CHECK(clock.getSource() == TIME_SOURCE_MESH);
+    // Offsets inside the deadband are left alone on purpose
+    CHECK(worst < TimeSync::TS_DEADBAND_MS + 100);
+    CHECK(meanSkew > -OSC_PPM - 10 && meanSkew < -OSC_PPM + 10);
+    CHECK(st.sourceCount == 5);
+    CHECK(st.usedCount == 4);
+    CHECK(st.skewPoints >= 4);
+
+    for (int i = 0; i < TimeSync::getSourceCount(); i++) {
+        const TimeSync::Source* s = TimeSync::getSource(i);
+        CHECK(s->used == (s->hash != 0x66));
+    }
+}
+
+static void testConvergeSpread() {
+    hostSetMicros(1000000);
+    ESP32RTCClock clock;
+    TimeSync::init(&clock);
+    SimMesh sim(2);
+    sim.addPeer(0x10, 0, -600.0);
+    sim.addPeer(0x11, 1, -300.0);
+    sim.addPeer(0x12, 2, 0.0);
+    sim.addPeer(0x13, 0, 300.0);
+    sim.addPeer(0x14, 1, 600.0);
+    sim.addPeer(0x66, 1, 60000.0);
+
+    sim.run(60 * 60 * 1000, clock);
+    double worst = worstError(sim, clock, 20 * 60 * 1000);
+    printf("(worst %.0f ms) ", worst);
+    CHECK(worst < 500.0);
+    CHECK(TimeSync::getStatus().usedCount == 5);
+}
+
+static void testGpsHoldover() {
+    hostSetMicros(1000000);
+    ESP32RTCClock clock;
+    TimeSync::init(&clock);
+    SimMesh sim(3);
+    for (uint8_t i = 0; i < 4; i++) sim.addPeer(0x20 + i, 0, 20000.0);    // Mesh 20 s fast
+
+    clock.setCurrentTime((uint32_t)(sim.trueMs() / 1000), TIME_SOURCE_GPS);
+    sim.run(60 * 60 * 1000, clock);
+
+    // Inside the holdover the mesh is measured but not applied
+    const TimeSync::Status& st = TimeSync::getStatus();
+    CHECK(clock.getSource() == TIME_SOURCE_GPS);
+    CHECK(!st.applied);
+    CHECK(st.lastOffsetMs > 18000 && st.lastOffsetMs < 22000);
+    CHECK(fabs(sim.errorMs(clock)) < 1500.0);
+
+    // After it, a GPS-set clock is only ever slewed: 20 s is refused
+    sim.run(TimeSync::TS_GPS_HOLDOVER_MS, clock);
+    CHECK(!TimeSync::getStatus().applied);
+    CHECK(fabs(sim.errorMs(clock)) < 3000.0);
+}
+
+static void testSyncedLimit() {
+    hostSetMicros(1000000);
+    ESP32RTCClock clock;
+    TimeSync::init(&clock);
+    SimMesh sim(4);
+    for (uint8_t i = 0; i < 3; i++) sim.addPeer(0x30 + i, 0, 0.0);
+    sim.run(10 * 60 * 1000, clock);
+    CHECK(clock.getSource() == TIME_SOURCE_MESH);
+
+    // The whole mesh jumps 10 minutes: beyond what a synced clock accepts
+    for (Peer& p : sim.peers) p.clockOffsetMs = 10 * 60 * 1000.0;
+    sim.run(40 * 60 * 1000, clock);
+    CHECK(!TimeSync::getStatus().applied);
+    CHECK(fabs(sim.errorMs(clock)) < 1000.0);
+
+    // Never synced: the mesh may step it any distance
+    hostSetMicros(1000000);
+    ESP32RTCClock fresh;
+    TimeSync::init(&fresh);
+    SimMesh sim2(5);
+    for (uint8_t i = 0; i < 3; i++) sim2.addPeer(0x40 + i, 0, 0.0);
+    for (uint8_t i = 0; i < 3; i++) {
+        TimeSync::addSample(0x40 + i, (uint32_t)(sim2.trueMs() / 1000), 0, false);
+    }
+    CHECK(TimeSync::disciplineNow());
+    CHECK(TimeSync::getStatus().applied);
+    CHECK(fabs(sim2.errorMs(fresh)) < 1500.0);
+}
+
+static void testLoneSource() {
+    hostSetMicros(1000000);
+    ESP32RTCClock clock;
+    TimeSync::init(&clock);
+    uint32_t now = (uint32_t)(START_EPOCH_MS / 1000);
+
+    // One ordinary peer is not a consensus
+    TimeSync::addSample(0x01, now, 0, false);
+    CHECK(!TimeSync::disciplineNow());
+    CHECK(TimeSync::getStatus().sourceCount == 1);
+
+    // One GPS-equipped peer is
+    TimeSync::addSample(0x02, now, 0, true);
+    CHECK(TimeSync::disciplineNow());
+
+    // Timestamps before MIN_VALID_EPOCH are ignored
+    TimeSync::addSample(0x03, 1000, 0, false);
+    CHECK(TimeSync::getSourceCount() == 2);
+
+    // Sources go stale after TS_SOURCE_MAX_AGE_MS
+    hostAdvanceMillis(TimeSync::TS_SOURCE_MAX_AGE_MS);
+    CHECK(!TimeSync::disciplineNow());
+    CHECK(TimeSync::getStatus().sourceCount == 0);
+}
+
+static void testLinkDelay() {
+    hostSetMicros(1000000);
+    ESP32RTCClock clock;
+    TimeSync::init(&clock);
+    CHECK(TimeSync::getStatus().linkDelayMs == TimeSync::TS_LINK_DELAY_DEFAULT_MS);
+
+    // 2 hops each way, 1.2 s round trip: 200 ms per link
+    for (int i = 0; i < 60; i++) TimeSync::addRoundTrip(2, 1200);
+    CHECK(TimeSync::getStatus().linkDelayMs >= 199 && TimeSync::getStatus().linkDelayMs <= 201);
+
+    // Implausible round trips are ignored
+    TimeSync::addRoundTrip(0, 10);
+    TimeSync::addRoundTrip(0, 20000);
+    CHECK(TimeSync::getStatus().linkDelayMs >= 199 && TimeSync::getStatus().linkDelayMs <= 201);
+}
+
+static void testSourceTable() {
+    hostSetMicros(1000000);
+    ESP32RTCClock clock;
+    TimeSync::init(&clock);
+    uint32_t now = (uint32_t)(START_EPOCH_MS / 1000);
+
+    for (int i = 0; i < TimeSync::TS_MAX_SOURCES + 8; i++) {
+        TimeSync::addSample((uint8_t)i, now, 0, false);
+        hostAdvanceMillis(100);
+    }
+    CHECK(TimeSync::getSourceCount() == TimeSync::TS_MAX_SOURCES);
+
+    // The oldest were recycled
+    bool oldSeen = false, newSeen = false;
+    for (int i = 0; i < TimeSync::getSourceCount(); i++) {
+        uint8_t h = TimeSync::getSource(i)->hash;
+        if (h < 8) oldSeen = true;
+        if (h == TimeSync::TS_MAX_SOURCES + 7) newSeen = true;
+    }
+    CHECK(!oldSeen && newSeen);
+    CHECK(TimeSync::getSource(TimeSync::TS_MAX_SOURCES) == nullptr);
+
+    TimeSync::reset();
+    CHECK(TimeSync::getSourceCount() == 0);
+}
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"Converge, peers agree",       testConvergeAgreeing},
+    {"Converge, peers spread",      testConvergeSpread},
+    {"GPS holdover",                testGpsHoldover},
+    {"Synced clock limit",          testSyncedLimit},
+    {"Lone source",                 testLoneSource},
+    {"Link delay",                  testLinkDelay},
+    {"Source table",                testSourceTable},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,301 @@
+/**
+ * MeshBerry traceroute tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Runs src/mesh/TraceRoute.h against a simulated chain of repeaters. Each
+ * link costs one airtime (Semtech SX126x formula) and may lose the packet;
+ * each repeater holds a direct packet for U(0, 1.5 airtimes) before
+ * sending it, like a stock MeshCore repeater (direct_tx_delay_factor 0.3).
+ * The simulator fills a Report the way MeshBerryMesh does and the tests
+ * check what the trace screen shows: loss per depth, per-link latency, a
+ * slow repeater, and that the probe timeout covers real round trips at
+ * fast and at slow radio settings.
+ */
+
+#include "mesh/TraceRoute.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+using namespace TraceRoute;
+
+// TRACE packet without its path: header, path length, tag, auth code, flags
+static const int TRACE_BASE_LEN = 11;
+static const uint8_t CHAIN_HASHES[TRACE_MAX_HOPS] = { 0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0xF6, 0x17, 0x28 };
+
+/**
+ * LoRa time on air (Semtech AN1200.13), 4/5 coding, explicit header,
+ * CRC on, 16-symbol preamble as in config.h
+ */
+static double airtimeMs(int sf, double bwKhz, int bytes) {
+    double tsym = (double)(1 << sf) / bwKhz;
+    int de = tsym > 16.0 ? 1 : 0;
+    double num = 8.0 * bytes - 4.0 * sf + 28 + 16;
+    double payloadSyms = 8 + std::max(std::ceil(num / (4.0 * (sf - 2 * de))) * 5, 0.0);
+    return (16 + 4.25 + payloadSyms) * tsym;
+}
+
+struct Radio {
+    int sf;
+    double bwKhz;
+};
+
+/**
+ * A line of repeaters, nearest first
+ */
+struct Chain {
+    Radio radio;
+    int hops;
+    double linkLoss = 0.0;          // Per transmission
+    double extraHoldMs[TRACE_MAX_HOPS] = {};
+
+    Chain(Radio r, int n) : radio(r), hops(n) {}
+
+    /**
+     * Send one probe to the given depth and back
+     * @return Round trip in ms, or -1 if a link lost it
+     */
+    double probe(int depth, std::mt19937& rng) const {
+        uint8_t probePath[TRACE_MAX_PROBE_PATH];
+        uint8_t probeLen = buildProbePath(CHAIN_HASHES, depth, probePath);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        // Repeaters visited in order: 0..depth-1 then depth-2..0
+        double rtt = 0.0;
+        for (int link = 0; link <= probeLen; link++) {
+            if (link > 0) {
+                int idx = link <= depth ? link - 1 : 2 * depth - 1 - link;
+                // Each repeater so far has added its SNR byte
+                double a = airtimeMs(radio.sf, radio.bwKhz, TRACE_BASE_LEN + probeLen + link);
+                rtt += unit(rng) * 1.5 * a + extraHoldMs[idx];
+            }
+            if (unit(rng) < linkLoss) return -1.0;
+            rtt += airtimeMs(radio.sf, radio.bwKhz, TRACE_BASE_LEN + probeLen + link);
+        }
+        return rtt;
+    }
+
+    /**
+     * Probe every depth like a full trace
+     */
+    void trace(Report& r, uint8_t probes, std::mt19937& rng) const {
+        r.clear();
+        r.hopCount = hops;
+        r.probesPerHop = probes;
+        memcpy(r.path, CHAIN_HASHES, hops);
+        for (int d = 1; d <= hops; d++) {
+            HopStats& hop = r.hops[d - 1];
+            hop.hash = r.path[d - 1];
+            for (int p = 0; p < probes; p++) {
+                hop.sent++;
+                double rtt = probe(d, rng);
+                if (rtt >= 0.0) hop.addReply((uint32_t)rtt);
+            }
+        }
+        r.complete = true;
+    }
+};
+
+static const Radio FAST = { 7, 62.5 };
+static const Radio SLOW = { 12, 125.0 };
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+static void testProbePath() {
+    uint8_t out[TRACE_MAX_PROBE_PATH];
+    CHECK(buildProbePath(CHAIN_HASHES, 1, out) == 1);
+    CHECK(out[0] == 0xA1);
+
+    CHECK(buildProbePath(CHAIN_HASHES, 3, out) == 5);
+    const uint8_t expect[5] = { 0xA1, 0xB2, 0xC3, 0xB2, 0xA1 };
+    CHECK(memcmp(out, expect, 5) == 0);
+
+    CHECK(buildProbePath(CHAIN_HASHES, TRACE_MAX_HOPS, out) == TRACE_MAX_PROBE_PATH);
+    CHECK(buildProbePath(CHAIN_HASHES, 0, out) == 0);
+    CHECK(buildProbePath(CHAIN_HASHES, TRACE_MAX_HOPS + 1, out) == 0);
+    CHECK(buildProbePath(nullptr, 2, out) == 0);
+}
+
+static void testHopStats() {
+    HopStats hop;
+    memset(&hop, 0, sizeof(hop));
+    hop.sent = 4;
+    hop.addReply(300);
+    hop.addReply(100);
+    hop.addReply(200);
+    CHECK(hop.received == 3);
+    CHECK(hop.rttMinMs == 100 && hop.rttMaxMs == 300);
+    CHECK(std::fabs(hop.avgRttMs() - 200.0f) < 0.01f);
+    CHECK(hop.lossPercent() == 25);
+
+    memset(&hop, 0, sizeof(hop));
+    CHECK(hop.avgRttMs() == 0.0f && hop.lossPercent() == 0);
+}
+
+/**
+ * Loss at depth d compounds over its 2d links
+ */
+static void testLossPerDepth() {
+    std::mt19937 rng(1);
+    Chain chain(FAST, 4);
+    chain.linkLoss = 0.05;
+    Report r;
+    chain.trace(r, 250, rng);
+
+    printf("(loss");
+    for (int i = 0; i < r.hopCount; i++) {
+        int links = 2 * (i + 1);
+        double expect = 100.0 * (1.0 - std::pow(1.0 - chain.linkLoss, links));
+        printf(" %d%%", r.hops[i].lossPercent());
+        CHECK(std::fabs(r.hops[i].lossPercent() - expect) < 7.0);
+    }
+    printf(") ");
+    CHECK(r.hops[3].lossPercent() > r.hops[0].lossPercent());
+}
+
+/**
+ * Mean round trip to a depth: every link's airtime plus the mean hold
+ * (0.75 airtimes) of every repeater visited
+ */
+static double meanRttMs(const Radio& radio, int depth) {
+    int probeLen = 2 * depth - 1;
+    double rtt = 0.0;
+    for (int link = 0; link <= probeLen; link++) {
+        double a = airtimeMs(radio.sf, radio.bwKhz, TRACE_BASE_LEN + probeLen + link);
+        rtt += link > 0 ? 1.75 * a : a;
+    }
+    return rtt;
+}
+
+/**
+ * +Hop for hop k is about one airtime plus the mean hold of hops k-1 and k
+ */
+static void testLinkLatency() {
+    std::mt19937 rng(2);
+    Chain chain(FAST, 5);
+    Report r;
+    chain.trace(r, 250, rng);
+
+    for (int i = 0; i < r.hopCount; i++) {
+        double prev = i > 0 ? meanRttMs(FAST, i) : 0.0;
+        double expect = (meanRttMs(FAST, i + 1) - prev) / 2.0;
+        CHECK(std::fabs(r.hopLatencyMs(i) - expect) < 0.1 * expect);
+    }
+    printf("(+Hop 1 %.0f ms, +Hop 2 %.0f ms) ", r.hopLatencyMs(0), r.hopLatencyMs(1));
+    CHECK(r.hopLatencyMs(-1) == 0.0f && r.hopLatencyMs(r.hopCount) == 0.0f);
+}
+
+/**
+ * A repeater that holds packets 2 s longer shows on the links either side
+ */
+static void testSlowRepeater() {
+    std::mt19937 rng(3);
+    Chain normal(FAST, 5);
+    Chain slow(FAST, 5);
+    slow.extraHoldMs[2] = 2000.0;
+
+    Report base, r;
+    normal.trace(base, 250, rng);
+    slow.trace(r, 250, rng);
+
+    for (int i = 0; i < r.hopCount; i++) {
+        float extra = r.hopLatencyMs(i) - base.hopLatencyMs(i);
+        if (i == 2 || i == 3) CHECK(std::fabs(extra - 1000.0f) < 150.0f);
+        else CHECK(std::fabs(extra) < 150.0f);
+    }
+    printf("(+Hop 3 and 4 up %.0f/%.0f ms) ",
+           r.hopLatencyMs(2) - base.hopLatencyMs(2), r.hopLatencyMs(3) - base.hopLatencyMs(3));
+}
+
+/**
+ * The timeout covers the 99th percentile round trip at every depth
+ */
+static void checkTimeout(const Radio& radio, const char* label) {
+    std::mt19937 rng(4);
+    Chain chain(radio, TRACE_MAX_HOPS);
+    static const int PROBES = 2000;
+
+    double worstP99 = 0.0;
+    uint32_t worstTimeout = 0;
+    bool oldCovered = true;
+    for (int d = 1; d <= TRACE_MAX_HOPS; d++) {
+        std::vector<double> rtts;
+        for (int p = 0; p < PROBES; p++) rtts.push_back(chain.probe(d, rng));
+        std::sort(rtts.begin(), rtts.end());
+        double p99 = rtts[PROBES * 99 / 100];
+
+        // What sendTraceProbe() passes: the largest the probe gets
+        uint8_t probeLen = 2 * d - 1;
+        uint32_t airtime = (uint32_t)airtimeMs(radio.sf, radio.bwKhz, TRACE_BASE_LEN + 2 * probeLen);
+        uint32_t timeout = probeTimeoutMs(probeLen, airtime);
+        CHECK(p99 < timeout);
+
+        if (TRACE_TIMEOUT_BASE_MS + TRACE_TIMEOUT_LINK_MS * (probeLen + 1) < p99) oldCovered = false;
+        worstP99 = p99;
+        worstTimeout = timeout;
+    }
+    printf("(%s depth 8: p99 %.1f s, timeout %.1f s%s) ", label, worstP99 / 1000.0,
+           worstTimeout / 1000.0, oldCovered ? "" : ", 1 s/link short");
+}
+
+static void testTimeoutFast() {
+    checkTimeout(FAST, "SF7/62.5");
+    // Fast settings keep the 1 s per link floor
+    CHECK(probeTimeoutMs(15, 100) == TRACE_TIMEOUT_BASE_MS + 16 * TRACE_TIMEOUT_LINK_MS);
+}
+
+static void testTimeoutSlow() {
+    checkTimeout(SLOW, "SF12/125");
+}
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"ProbePath",                   testProbePath},
+    {"HopStats",                    testHopStats},
+    {"LossPerDepth",                testLossPerDepth},
+    {"LinkLatency",                 testLinkLatency},
+    {"SlowRepeater",                testSlowRepeater},
+    {"TimeoutFast",                 testTimeoutFast},
+    {"TimeoutSlow",                 testTimeoutSlow},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,256 @@
+/**
+ * MeshBerry util container benchmarks (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Times the containers in src/util against the fixed-array code they
+ * replaced. Record sizes mirror the firmware structs. Host numbers only show the relative cost; the ESP32-S3 is
+ * much slower in absolute terms.
+ */
+
+#include "util/FlatHashMap.h"
+#include "util/LruCache.h"
+#include "util/RingBuffer.h"
+#include "util/SmallVector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+// Stand-ins with the same size as the firmware records
+struct NodeRecord {
+    uint32_t id;
+    char name[32];
+    int type;
+    int16_t rssi;
+    float snr;
+    uint32_t lastHeard;
+    bool hasLocation;
+    float lat, lon;
+};
+
+struct ChatRecord {
+    char sender[16];
+    char text[128];
+    uint32_t timestamp;
+    uint32_t hash;
+    uint8_t repeatCount;
+    uint8_t hops;
+    bool outgoing;
+};
+
+struct PeerRecord {
+    uint32_t contactId;
+    uint8_t pubKey[32];
+    uint8_t secret[32];
+    bool isActive;
+    uint8_t path[64];
+    int8_t pathLen;
+    uint32_t lastUsed;
+};
+
+static const int ITERATIONS = 2000000;
+static const int QUERY_COUNT = 1024;     // Power of two, indexed by mask
+
+// Keeps the optimiser from dropping the loops
+static volatile uint32_t s_sink;
+
+typedef std::chrono::steady_clock BenchClock;
+
+// Nanoseconds per iteration of a loop body run `n` times by `fn`
+template <typename Fn>
+static double nsPerOp(Fn fn, int n) {
+    BenchClock::time_point start = BenchClock::now();
+    fn();
+    std::chrono::duration<double, std::nano> elapsed = BenchClock::now() - start;
+    return elapsed.count() / n;
+}
+
+static void report(const char* name, double before, double after) {
+    printf("%-48s %8.1f ns %8.1f ns\n", name, before, after);
+}
+
+// =============================================================================
+// BENCHMARKS
+// =============================================================================
+
+static void benchNodeLookup(std::mt19937& rng) {
+    static NodeRecord array[64];
+    static SmallVector<NodeRecord, 64> nodes;
+    static FlatHashMap<uint32_t, uint8_t, 128> index;
+    uint32_t ids[64];
+    for (int i = 0; i < 64; i++) {
+        ids[i] = rng();
+        memset(&array[i], 0, sizeof(NodeRecord));
+        array[i].id = ids[i];
+        nodes.push(array[i]);
+        index.put(ids[i], (uint8_t)i);
+    }
+    uint32_t queries[QUERY_COUNT];
+    for (uint32_t& q : queries) q = ids[rng() % 64];
+
+    double scan = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            uint32_t id = queries[k & (QUERY_COUNT - 1)];
+            for (int i = 0; i < 64; i++) {
+                if (array[i].id == id) { s_sink += i; break; }
+            }
+        }
+    }, ITERATIONS);
+    double map = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            const uint8_t* i = index.find(queries[k & (QUERY_COUNT - 1)]);
+            s_sink += nodes[*i].id;
+        }
+    }, ITERATIONS);
+    report("Node lookup by id (64 nodes)", scan, map);
+}
+
+static void benchChatAdd() {
+    static ChatRecord array[32];
+    static RingBuffer<ChatRecord, 32> ring;
+    for (int i = 0; i < 32; i++) ring.pushSlot();
+    const int n = ITERATIONS / 10;
+
+    double shift = nsPerOp([&] {
+        for (int k = 0; k < n; k++) {
+            for (int i = 0; i < 31; i++) array[i] = array[i + 1];
+            array[31].timestamp = k;
+            s_sink += array[0].timestamp;
+        }
+    }, n);
+    double ringAdd = nsPerOp([&] {
+        for (int k = 0; k < n; k++) {
+            ChatRecord& m = ring.pushSlot();
+            m.timestamp = k;
+            s_sink += ring[0].timestamp;
+        }
+    }, n);
+    report("Chat message add when full (32 messages)", shift, ringAdd);
+}
+
+static void benchHistoryIndex() {
+    static ChatRecord array[50];
+    static RingBuffer<ChatRecord, 64> ring;
+    for (int i = 0; i < 64; i++) ring.pushSlot();
+    volatile int head = 17;
+    const int count = 50;
+
+    double modulo = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            int i = k % count;
+            s_sink += array[(head - count + i + count) % count].timestamp;
+        }
+    }, ITERATIONS);
+    double mask = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            s_sink += ring[k & 63].timestamp;
+        }
+    }, ITERATIONS);
+    report("History index (% 50 vs & 63)", modulo, mask);
+}
+
+static void benchPeers(std::mt19937& rng) {
+    static PeerRecord array[8];
+    static LruCache<uint32_t, PeerRecord, 8> cache;
+
+    double memmoveInsert = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            int slot = -1;
+            for (int i = 0; i < 8; i++) {
+                if (!array[i].isActive) { slot = i; break; }
+            }
+            if (slot < 0) {
+                memmove(&array[0], &array[1], sizeof(PeerRecord) * 7);
+                slot = 7;
+            }
+            array[slot].contactId = k;
+            array[slot].isActive = true;
+            s_sink += slot;
+        }
+    }, ITERATIONS);
+    double lruInsert = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            int slot = cache.acquire(k);
+            cache.at(slot).contactId = k;
+            s_sink += slot;
+        }
+    }, ITERATIONS);
+    report("DM peer insert with eviction (8 peers)", memmoveInsert, lruInsert);
+
+    // Both tables now hold the last eight contact ids
+    uint32_t queries[QUERY_COUNT];
+    for (uint32_t& q : queries) q = ITERATIONS - 1 - (rng() % 8);
+
+    double scan = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            uint32_t id = queries[k & (QUERY_COUNT - 1)];
+            for (int i = 0; i < 8; i++) {
+                if (array[i].isActive && array[i].contactId == id) { s_sink += i; break; }
+            }
+        }
+    }, ITERATIONS);
+    double lruFind = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS; k++) {
+            s_sink += cache.find(queries[k & (QUERY_COUNT - 1)]);
+        }
+    }, ITERATIONS);
+    report("DM peer lookup by contact (8 peers)", scan, lruFind);
+}
+
+static void benchMapChurn(std::mt19937& rng) {
+    // Insert/erase churn at 50% load: probe runs must not grow over time
+    static FlatHashMap<uint32_t, uint32_t, 256> map;
+    uint32_t live[128];
+    for (int i = 0; i < 128; i++) {
+        live[i] = rng();
+        map.put(live[i], i);
+    }
+
+    double early = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS / 10; k++) {
+            int i = k & 127;
+            map.erase(live[i]);
+            live[i] = rng();
+            map.put(live[i], k);
+        }
+    }, ITERATIONS / 10);
+    for (int k = 0; k < ITERATIONS; k++) {
+        int i = k & 127;
+        map.erase(live[i]);
+        live[i] = rng();
+        map.put(live[i], k);
+    }
+    double late = nsPerOp([&] {
+        for (int k = 0; k < ITERATIONS / 10; k++) {
+            int i = k & 127;
+            map.erase(live[i]);
+            live[i] = rng();
+            map.put(live[i], k);
+        }
+    }, ITERATIONS / 10);
+    report("Map erase+insert, first vs after 2M (50% load)", early, late);
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main() {
+    std::mt19937 rng(7);
+
+    printf("%-48s %11s %11s\n", "Operation", "Before", "After");
+    benchNodeLookup(rng);
+    benchChatAdd();
+    benchHistoryIndex();
+    benchPeers(rng);
+    benchMapChurn(rng);
+
+    printf("\nsizeof LruCache<uint32_t, PeerRecord, 8>: %zu (array %zu)\n",
+           sizeof(LruCache<uint32_t, PeerRecord, 8>), sizeof(PeerRecord) * 8);
+    return 0;
+}
@@ -0,0 +1,529 @@
+/**
+ * MeshBerry util container tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Unit tests for the header-only containers in src/util. They have no
+ * Arduino dependencies, so they build with a host compiler; see the
+ * Makefile in this directory. Each container gets targeted cases for its
+ * edge behaviour, then a long random run checked against a std:: model.
+ */
+
+#include "util/FlatHashMap.h"
+#include "util/LruCache.h"
+#include "util/LruList.h"
+#include "util/RingBuffer.h"
+#include "util/SmallVector.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+static const int RANDOM_OPS = 100000;
+
+// =============================================================================
+// FLATHASHMAP
+// =============================================================================
+
+// Same hash as FlatHashMap::home() for a 16-slot map
+static uint32_t home16(uint32_t key) {
+    return (key * 0x9E3779B1u) >> 28;
+}
+
+// The first `count` keys from `start` up whose home slot is `slot`
+static std::vector<uint32_t> keysWithHome(uint32_t slot, int count, uint32_t start = 1) {
+    std::vector<uint32_t> keys;
+    for (uint32_t k = start; (int)keys.size() < count; k++) {
+        if (home16(k) == slot) keys.push_back(k);
+    }
+    return keys;
+}
+
+// Slot holding a key, found by iterating slots rather than find()
+static int slotOf(const FlatHashMap<uint32_t, int, 16>& m, uint32_t key) {
+    for (size_t i = 0; i < 16; i++) {
+        if (m.slotUsed(i) && m.keyAt(i) == key) return (int)i;
+    }
+    return -1;
+}
+
+static void testFlatHashMapBasics() {
+    FlatHashMap<uint32_t, int, 16> m;
+    CHECK(m.empty());
+    CHECK(m.find(7) == nullptr);
+    CHECK(!m.erase(7));
+
+    bool created = false;
+    int* v = m.insert(7, &created);
+    CHECK(v && created && *v == 0);
+    *v = 70;
+    v = m.insert(7, &created);
+    CHECK(v && !created && *v == 70);
+
+    CHECK(m.put(7, 71) && *m.find(7) == 71);
+    CHECK(m.size() == 1);
+    CHECK(m.erase(7) && m.empty() && !m.contains(7));
+
+    // Every slot can be used; the 17th key is refused
+    for (uint32_t k = 0; k < 16; k++) CHECK(m.put(k * 977, (int)k) != nullptr);
+    CHECK(m.size() == 16);
+    CHECK(m.put(99999, 0) == nullptr);
+    for (uint32_t k = 0; k < 16; k++) CHECK(m.find(k * 977) && *m.find(k * 977) == (int)k);
+
+    m.clear();
+    CHECK(m.empty() && m.find(0) == nullptr);
+}
+
+static void testFlatHashMapBackwardShift() {
+    // Three keys with the same home fill a probe run; erasing the first
+    // must pull the other two back so there is no hole before them
+    {
+        FlatHashMap<uint32_t, int, 16> m;
+        std::vector<uint32_t> k = keysWithHome(5, 3);
+        for (int i = 0; i < 3; i++) m.put(k[i], i);
+        CHECK(slotOf(m, k[0]) == 5 && slotOf(m, k[1]) == 6 && slotOf(m, k[2]) == 7);
+
+        CHECK(m.erase(k[0]));
+        CHECK(slotOf(m, k[1]) == 5 && slotOf(m, k[2]) == 6);
+        CHECK(!m.slotUsed(7));
+        CHECK(m.find(k[1]) && *m.find(k[1]) == 1);
+        CHECK(m.find(k[2]) && *m.find(k[2]) == 2);
+    }
+
+    // A key at its own home in the middle of the run must not move
+    {
+        FlatHashMap<uint32_t, int, 16> m;
+        std::vector<uint32_t> a = keysWithHome(5, 2);
+        std::vector<uint32_t> b = keysWithHome(7, 1);
+        m.put(a[0], 0);     // slot 5
+        m.put(a[1], 1);     // slot 6
+        m.put(b[0], 2);     // slot 7, its home
+        CHECK(m.erase(a[0]));
+        CHECK(slotOf(m, a[1]) == 5);
+        CHECK(slotOf(m, b[0]) == 7);
+        CHECK(!m.slotUsed(6));
+    }
+
+    // A key displaced past its home moves back, but not before it
+    {
+        FlatHashMap<uint32_t, int, 16> m;
+        std::vector<uint32_t> a = keysWithHome(5, 2);
+        std::vector<uint32_t> b = keysWithHome(6, 1);
+        m.put(a[0], 0);     // slot 5
+        m.put(a[1], 1);     // slot 6
+        m.put(b[0], 2);     // home 6, displaced to 7
+        CHECK(m.erase(a[0]));
+        CHECK(slotOf(m, a[1]) == 5);
+        CHECK(slotOf(m, b[0]) == 6);
+        CHECK(!m.slotUsed(7));
+    }
+
+    // A probe run that wraps from the last slot to the first
+    {
+        FlatHashMap<uint32_t, int, 16> m;
+        std::vector<uint32_t> k = keysWithHome(15, 3);
+        for (int i = 0; i < 3; i++) m.put(k[i], i);
+        CHECK(slotOf(m, k[0]) == 15 && slotOf(m, k[1]) == 0 && slotOf(m, k[2]) == 1);
+
+        CHECK(m.erase(k[0]));
+        CHECK(slotOf(m, k[1]) == 15 && slotOf(m, k[2]) == 0);
+        CHECK(!m.slotUsed(1));
+
+        CHECK(m.erase(k[1]));
+        CHECK(slotOf(m, k[2]) == 15);
+        CHECK(m.size() == 1);
+    }
+
+    // A key at home 0 after a wrapped run is not moved behind its home
+    {
+        FlatHashMap<uint32_t, int, 16> m;
+        std::vector<uint32_t> a = keysWithHome(15, 2);
+        std::vector<uint32_t> z = keysWithHome(0, 1);
+        m.put(a[0], 0);     // slot 15
+        m.put(a[1], 1);     // slot 0
+        m.put(z[0], 2);     // home 0, displaced to 1
+        CHECK(m.erase(a[1]));
+        CHECK(slotOf(m, a[0]) == 15);
+        CHECK(slotOf(m, z[0]) == 0);
+        CHECK(!m.slotUsed(1));
+    }
+}
+
+static void testFlatHashMapRandom() {
+    std::mt19937 rng(1);
+
+    // Sparse keys
+    {
+        FlatHashMap<uint32_t, int, 64> m;
+        std::map<uint32_t, int> ref;
+        for (int i = 0; i < RANDOM_OPS; i++) {
+            uint32_t k = rng() % 100;
+            switch (rng() % 3) {
+            case 0:
+                if (ref.size() < 64 || ref.count(k)) {
+                    CHECK(m.put(k, i) != nullptr);
+                    ref[k] = i;
+                } else {
+                    CHECK(m.put(k, i) == nullptr);
+                }
+                break;
+            case 1:
+                CHECK(m.erase(k) == (ref.erase(k) > 0));
+                break;
+            default: {
+                int* v = m.find(k);
+                auto it = ref.find(k);
+                CHECK((v != nullptr) == (it != ref.end()));
+                if (v && it != ref.end()) CHECK(*v == it->second);
+            }
+            }
+            CHECK(m.size() == ref.size());
+        }
+    }
+
+    // Clustered keys, filled to capacity, so runs are long and wrap
+    {
+        FlatHashMap<uint32_t, int, 16> m;
+        std::map<uint32_t, int> ref;
+        for (int i = 0; i < RANDOM_OPS; i++) {
+            uint32_t k = (rng() % 24) * 16;
+            if (rng() % 2) {
+                if (ref.size() < 16 || ref.count(k)) {
+                    m.put(k, i);
+                    ref[k] = i;
+                }
+            } else {
+                m.erase(k);
+                ref.erase(k);
+            }
+            for (auto& p : ref) {
+                const int* v = m.find(p.first);
+                CHECK(v && *v == p.second);
+            }
+            CHECK(m.size() == ref.size());
+        }
+    }
+}
+
+// =============================================================================
+// RINGBUFFER
+// =============================================================================
+
+static void testRingBufferWraparound() {
+    RingBuffer<int, 8> r;
+    CHECK(r.empty() && !r.full());
+    CHECK(!r.popFront());
+
+    for (int i = 0; i < 8; i++) r.push(i);
+    CHECK(r.full() && r.size() == 8);
+    CHECK(r.front() == 0 && r.back() == 7);
+
+    // Three more overwrite the three oldest
+    for (int i = 8; i < 11; i++) r.push(i);
+    CHECK(r.size() == 8);
+    for (size_t i = 0; i < r.size(); i++) CHECK(r[i] == (int)i + 3);
+    CHECK(r.front() == 3 && r.back() == 10);
+
+    // Pop from the front across the wrap point
+    for (int i = 0; i < 6; i++) CHECK(r.popFront());
+    CHECK(r.size() == 2 && r[0] == 9 && r[1] == 10);
+
+    // Refill past the end again; head keeps wrapping
+    for (int i = 11; i < 30; i++) r.push(i);
+    CHECK(r.size() == 8);
+    for (size_t i = 0; i < r.size(); i++) CHECK(r[i] == (int)i + 22);
+
+    // pushSlot() claims the slot of the oldest element once full
+    int& slot = r.pushSlot();
+    CHECK(slot == 22);
+    slot = 30;
+    CHECK(r.front() == 23 && r.back() == 30);
+
+    r.clear();
+    CHECK(r.empty());
+    r.push(1);
+    CHECK(r.size() == 1 && r.front() == 1 && r.back() == 1);
+}
+
+static void testRingBufferRandom() {
+    std::mt19937 rng(2);
+    RingBuffer<int, 8> r;
+    std::deque<int> ref;
+    for (int i = 0; i < RANDOM_OPS; i++) {
+        if (rng() % 3 < 2) {
+            r.push(i);
+            ref.push_back(i);
+            if (ref.size() > 8) ref.pop_front();
+        } else {
+            bool popped = r.popFront();
+            CHECK(popped == !ref.empty());
+            if (!ref.empty()) ref.pop_front();
+        }
+        CHECK(r.size() == ref.size());
+        for (size_t k = 0; k < ref.size(); k++) CHECK(r[k] == ref[k]);
+        if (!ref.empty()) CHECK(r.back() == ref.back());
+    }
+}
+
+// =============================================================================
+// LRULIST
+// =============================================================================
+
+// Slots from newest to oldest
+static std::vector<int> usedOrder(const LruList<4>& l) {
+    std::vector<int> out;
+    for (int s = l.newest(); s != l.NONE; s = l.older(s)) out.push_back(s);
+    return out;
+}
+
+static void testLruList() {
+    LruList<4> l;
+    CHECK(l.size() == 0 && l.newest() == l.NONE && l.oldest() == l.NONE);
+    CHECK(l.freeSlot() == 0);
+
+    l.touch(2);
+    l.touch(0);
+    l.touch(3);
+    CHECK((usedOrder(l) == std::vector<int>{3, 0, 2}));
+    CHECK(l.oldest() == 2 && l.freeSlot() == 1);
+
+    // Touching moves to the front; touching the newest is a no-op
+    l.touch(2);
+    CHECK((usedOrder(l) == std::vector<int>{2, 3, 0}));
+    l.touch(2);
+    CHECK((usedOrder(l) == std::vector<int>{2, 3, 0}));
+
+    // Backwards walk matches
+    std::vector<int> back;
+    for (int s = l.oldest(); s != l.NONE; s = l.newer(s)) back.push_back(s);
+    CHECK((back == std::vector<int>{0, 3, 2}));
+
+    l.touch(1);
+    CHECK(l.full() && l.freeSlot() == l.NONE);
+
+    // Removing from the middle keeps the rest in order
+    l.remove(3);
+    CHECK((usedOrder(l) == std::vector<int>{1, 2, 0}));
+    CHECK(!l.contains(3) && l.freeSlot() == 3);
+    l.remove(3);    // Already free
+    CHECK(l.size() == 3);
+
+    // Out-of-range slots are ignored
+    l.touch(-1);
+    l.touch(4);
+    l.remove(9);
+    CHECK(l.size() == 3);
+
+    l.clear();
+    CHECK(l.size() == 0 && l.freeSlot() == 0);
+}
+
+// =============================================================================
+// LRUCACHE
+// =============================================================================
+
+static void testLruCacheEviction() {
+    LruCache<uint32_t, int, 4> c;
+    bool created = false;
+
+    // Free slots first: nothing to evict
+    for (uint32_t k = 10; k < 14; k++) {
+        CHECK(c.victim() == c.NONE);
+        int s = c.acquire(k, &created);
+        CHECK(created);
+        c.at(s) = (int)k * 100;
+    }
+    CHECK(c.full() && c.size() == 4);
+
+    // Re-acquiring an existing key keeps its slot and value
+    int s11 = c.find(11);
+    CHECK(c.acquire(11, &created) == s11 && !created && c.at(s11) == 1100);
+
+    // Recency is now 11, 13, 12, 10: 10 is the victim
+    int s10 = c.find(10);
+    CHECK(c.oldest() == s10);
+    CHECK(c.victim() == s10);
+
+    // acquire() of a new key takes exactly the victim's slot
+    int v = c.victim();
+    CHECK(c.at(v) == 1000);    // Still readable before the overwrite
+    int s = c.acquire(20, &created);
+    CHECK(created && s == v);
+    CHECK(c.find(10) == c.NONE && c.keyAt(s) == 20);
+    CHECK(c.at(s) == 1000);    // acquire() leaves the value to the caller
+    c.at(s) = 2000;
+
+    // find() does not change recency; touch() does
+    int s12 = c.find(12);
+    CHECK(c.victim() == s12);
+    c.touch(s12);
+    CHECK(c.victim() == c.find(13));
+
+    // Eviction order follows recency: 13, 11, 20, 12
+    uint32_t expect[] = {13, 11, 20, 12};
+    for (uint32_t i = 0; i < 4; i++) {
+        int victimSlot = c.victim();
+        CHECK(c.keyAt(victimSlot) == expect[i]);
+        CHECK(c.acquire(100 + i) == victimSlot);
+        CHECK(c.find(expect[i]) == c.NONE);
+    }
+
+    // Erasing frees a slot, which the next new key takes instead of evicting
+    int s101 = c.find(101);
+    c.erase(s101);
+    CHECK(!c.used(s101) && c.size() == 3);
+    CHECK(c.victim() == c.NONE);
+    CHECK(c.acquire(200) == s101);
+    CHECK(c.find(100) != c.NONE);
+
+    c.clear();
+    CHECK(c.size() == 0 && c.find(200) == c.NONE && c.victim() == c.NONE);
+}
+
+static void testLruCacheRandom() {
+    std::mt19937 rng(3);
+    LruCache<uint32_t, int, 8> c;
+    std::list<uint32_t> ref;            // Newest first
+    std::map<uint32_t, int> slots;      // Key -> slot it must keep
+
+    for (int i = 0; i < RANDOM_OPS; i++) {
+        uint32_t k = rng() % 20;
+        int op = rng() % 4;
+        auto it = std::find(ref.begin(), ref.end(), k);
+
+        if (op < 2) {
+            int victim = c.victim();
+            bool created;
+            int s = c.acquire(k, &created);
+            CHECK(created == (it == ref.end()));
+            if (it != ref.end()) {
+                ref.erase(it);
+                CHECK(slots[k] == s);
+            } else if (ref.size() == 8) {
+                uint32_t old = ref.back();
+                ref.pop_back();
+                CHECK(victim == slots[old] && s == victim);
+                slots.erase(old);
+                slots[k] = s;
+            } else {
+                CHECK(victim == c.NONE);
+                slots[k] = s;
+            }
+            ref.push_front(k);
+        } else if (op == 2) {
+            int s = c.find(k);
+            CHECK((s != c.NONE) == (it != ref.end()));
+            if (s != c.NONE) {
+                c.erase(s);
+                ref.erase(it);
+                slots.erase(k);
+            }
+        } else {
+            int s = c.find(k);
+            if (s != c.NONE) {
+                c.touch(s);
+                ref.remove(k);
+                ref.push_front(k);
+            }
+        }
+
+        CHECK(c.size() == ref.size());
+        int s = c.newest();
+        for (uint32_t key : ref) {
+            CHECK(s != c.NONE && c.keyAt(s) == key);
+            if (s == c.NONE) break;
+            s = c.older(s);
+        }
+        CHECK(s == c.NONE);
+    }
+}
+
+// =============================================================================
+// SMALLVECTOR
+// =============================================================================
+
+static void testSmallVector() {
+    SmallVector<int, 4> v;
+    CHECK(v.empty());
+    CHECK(v.push(1) && v.push(2) && v.push(3) && v.push(4));
+    CHECK(v.full() && v.push(5) == nullptr && v.size() == 4);
+
+    // erase() keeps order
+    v.erase(1);
+    CHECK(v.size() == 3 && v[0] == 1 && v[1] == 3 && v[2] == 4);
+    v.erase(7);     // Out of range
+    CHECK(v.size() == 3);
+
+    // swapErase() moves the last element into the hole
+    v.swapErase(0);
+    CHECK(v.size() == 2 && v[0] == 4 && v[1] == 3);
+    v.swapErase(1);
+    CHECK(v.size() == 1 && v.back() == 4);
+
+    int sum = 0;
+    for (int x : v) sum += x;
+    CHECK(sum == 4);
+
+    v.popBack();
+    v.popBack();    // Already empty
+    CHECK(v.empty());
+    CHECK(v.push(9) && v[0] == 9);
+    v.clear();
+    CHECK(v.empty() && v.begin() == v.end());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"FlatHashMap basics",          testFlatHashMapBasics},
+    {"FlatHashMap backward shift",  testFlatHashMapBackwardShift},
+    {"FlatHashMap random",          testFlatHashMapRandom},
+    {"RingBuffer wraparound",       testRingBufferWraparound},
+    {"RingBuffer random",           testRingBufferRandom},
+    {"LruList order",               testLruList},
+    {"LruCache eviction",           testLruCacheEviction},
+    {"LruCache random",             testLruCacheRandom},
+    {"SmallVector",                 testSmallVector},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}
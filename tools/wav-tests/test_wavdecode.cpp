@@ -0,0 +1,433 @@
+/**
+ * MeshBerry WAV decoder tests (host)
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * Copyright (C) 2026 NodakMesh (nodakmesh.org)
+ *
+ * This file is part of MeshBerry.
+ *
+ * Unit tests for src/drivers/wavdecode.cpp, which has no Arduino
+ * dependencies. WAV files are built in memory: PCM directly, IMA-ADPCM
+ * with a reference encoder. ADPCM output must match the encoder's own
+ * reconstruction sample for sample, and is also compared with the source
+ * signal by SNR. Header parsing is checked against malformed files.
+ */
+
+#include "drivers/wavdecode.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static int s_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        s_failures++; \
+    } \
+} while (0)
+
+static const uint32_t RATE = 16000;
+static const double MIN_ADPCM_SNR_DB = 20.0;   // Sanity bound; exactness is checked separately
+
+// =============================================================================
+// WAV BUILDING
+// =============================================================================
+
+typedef std::vector<uint8_t> Bytes;
+
+static void put16(Bytes& b, uint16_t v) {
+    b.push_back(v & 0xFF);
+    b.push_back(v >> 8);
+}
+
+static void put32(Bytes& b, uint32_t v) {
+    for (int i = 0; i < 4; i++) b.push_back((v >> (8 * i)) & 0xFF);
+}
+
+static void putTag(Bytes& b, const char* tag) {
+    b.insert(b.end(), tag, tag + 4);
+}
+
+/**
+ * RIFF/WAVE file with an optional LIST chunk (odd size, so it is padded)
+ * ahead of "fmt "
+ */
+static Bytes makeWav(uint16_t format, uint16_t channels, uint16_t bits, uint16_t blockAlign,
+                     uint16_t samplesPerBlock, const Bytes& data, bool withList) {
+    Bytes fmt;
+    put16(fmt, format);
+    put16(fmt, channels);
+    put32(fmt, RATE);
+    put32(fmt, RATE * blockAlign);
+    put16(fmt, blockAlign);
+    put16(fmt, bits);
+    if (format == Wav::WAV_FORMAT_IMA_ADPCM) {
+        put16(fmt, 2);
+        put16(fmt, samplesPerBlock);
+    }
+
+    Bytes body;
+    putTag(body, "WAVE");
+    if (withList) {
+        putTag(body, "LIST");
+        put32(body, 5);
+        body.insert(body.end(), {'I', 'N', 'F', 'O', 'x', 0});
+    }
+    putTag(body, "fmt ");
+    put32(body, fmt.size());
+    body.insert(body.end(), fmt.begin(), fmt.end());
+    putTag(body, "data");
+    put32(body, data.size());
+    body.insert(body.end(), data.begin(), data.end());
+
+    Bytes wav;
+    putTag(wav, "RIFF");
+    put32(wav, body.size());
+    wav.insert(wav.end(), body.begin(), body.end());
+    return wav;
+}
+
+class MemReader : public Wav::Reader {
+public:
+    explicit MemReader(const Bytes& b) : _b(b) {}
+    size_t read(uint8_t* buf, size_t len) override {
+        size_t n = _pos < _b.size() ? _b.size() - _pos : 0;
+        if (n > len) n = len;
+        memcpy(buf, _b.data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    bool skip(uint32_t len) override {
+        _pos += len;
+        return _pos <= _b.size();
+    }
+    size_t pos() const { return _pos; }
+private:
+    const Bytes& _b;
+    size_t _pos = 0;
+};
+
+/**
+ * Parse and decode a whole file the way the audio driver does: one
+ * inputChunkSize() read at a time, the last one short
+ */
+static bool decodeFile(const Bytes& wav, Wav::Info& info, std::vector<int16_t>& out) {
+    MemReader reader(wav);
+    if (!Wav::parseHeader(reader, info)) return false;
+    if (reader.pos() != info.dataOffset) return false;
+
+    Wav::Decoder dec;
+    dec.begin(info);
+    std::vector<int16_t> buf(Wav::WAV_MAX_CHUNK_SAMPLES);
+    std::vector<uint8_t> raw(dec.inputChunkSize());
+    uint32_t remaining = info.dataSize;
+    while (remaining > 0) {
+        size_t want = remaining < raw.size() ? remaining : raw.size();
+        size_t got = reader.read(raw.data(), want);
+        if (got == 0) break;
+        remaining -= got;
+        size_t n = dec.decode(raw.data(), got, buf.data(), buf.size());
+        out.insert(out.end(), buf.begin(), buf.begin() + n);
+    }
+    return true;
+}
+
+// =============================================================================
+// SIGNALS
+// =============================================================================
+
+static std::vector<int16_t> tone(double hz, size_t count, double amplitude, double phase = 0.0) {
+    std::vector<int16_t> s(count);
+    for (size_t i = 0; i < count; i++) {
+        s[i] = (int16_t)lround(amplitude * sin(2.0 * M_PI * hz * i / RATE + phase));
+    }
+    return s;
+}
+
+static double snrDb(const std::vector<int16_t>& ref, const std::vector<int16_t>& got) {
+    double sig = 0, err = 0;
+    for (size_t i = 0; i < ref.size(); i++) {
+        double d = (double)ref[i] - got[i];
+        sig += (double)ref[i] * ref[i];
+        err += d * d;
+    }
+    return err == 0 ? 200.0 : 10.0 * log10(sig / err);
+}
+
+// =============================================================================
+// REFERENCE IMA-ADPCM ENCODER
+// =============================================================================
+
+static const int INDEX_TABLE[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+static const int STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552,
+    1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484,
+    7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385,
+    24623, 27086, 29794, 32767
+};
+
+struct ImaState {
+    int predictor = 0;
+    int index = 0;
+};
+
+static uint8_t encodeNibble(ImaState& st, int sample) {
+    int step = STEP_TABLE[st.index];
+    int diff = sample - st.predictor;
+    uint8_t nibble = 0;
+    if (diff < 0) { nibble = 8; diff = -diff; }
+
+    int delta = step >> 3;
+    if (diff >= step) { nibble |= 4; diff -= step; delta += step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 2; diff -= step; delta += step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 1; delta += step; }
+
+    st.predictor += (nibble & 8) ? -delta : delta;
+    if (st.predictor > 32767) st.predictor = 32767;
+    if (st.predictor < -32768) st.predictor = -32768;
+    st.index += INDEX_TABLE[nibble];
+    if (st.index < 0) st.index = 0;
+    if (st.index > 88) st.index = 88;
+    return nibble;
+}
+
+/**
+ * Encode interleaved frames into blocks of blockAlign bytes. The last
+ * block holds only the 4-byte groups it needs, so it is short.
+ * @param recon Filled with the encoder's reconstruction, which a correct
+ *              decoder reproduces exactly
+ */
+static Bytes encodeIma(const std::vector<std::vector<int16_t>>& chans, uint16_t blockAlign,
+                       std::vector<std::vector<int16_t>>& recon) {
+    const size_t ch = chans.size();
+    const size_t perBlock = (blockAlign - 4 * ch) * 2 / ch + 1;
+    const size_t total = chans[0].size();
+    std::vector<ImaState> st(ch);
+    recon.assign(ch, std::vector<int16_t>());
+    Bytes out;
+
+    for (size_t start = 0; start < total; start += perBlock) {
+        size_t n = total - start < perBlock ? total - start : perBlock;
+        size_t groups = (n - 1 + 7) / 8;
+
+        for (size_t c = 0; c < ch; c++) {
+            st[c].predictor = chans[c][start];
+            recon[c].push_back(chans[c][start]);
+            put16(out, (uint16_t)(int16_t)st[c].predictor);
+            out.push_back((uint8_t)st[c].index);
+            out.push_back(0);
+        }
+        for (size_t g = 0; g < groups; g++) {
+            for (size_t c = 0; c < ch; c++) {
+                for (int b = 0; b < 4; b++) {
+                    uint8_t byte = 0;
+                    for (int half = 0; half < 2; half++) {
+                        size_t i = start + 1 + g * 8 + b * 2 + half;
+                        int sample = i < start + n ? chans[c][i] : st[c].predictor;
+                        byte |= encodeNibble(st[c], sample) << (4 * half);
+                        if (i < start + n) recon[c].push_back((int16_t)st[c].predictor);
+                    }
+                    out.push_back(byte);
+                }
+            }
+        }
+    }
+    return out;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+static void testPcm16Mono() {
+    std::vector<int16_t> src = tone(440, 3000, 20000);
+    Bytes data;
+    for (int16_t s : src) put16(data, (uint16_t)s);
+
+    Wav::Info info;
+    std::vector<int16_t> out;
+    CHECK(decodeFile(makeWav(Wav::WAV_FORMAT_PCM, 1, 16, 2, 0, data, true), info, out));
+    CHECK(info.channels == 1 && info.bitsPerSample == 16 && info.sampleRate == RATE);
+    CHECK(out == src);
+}
+
+static void testPcm16StereoDownmix() {
+    std::vector<int16_t> l = tone(440, 2500, 16000);
+    std::vector<int16_t> r = tone(660, 2500, 12000);
+    Bytes data;
+    for (size_t i = 0; i < l.size(); i++) {
+        put16(data, (uint16_t)l[i]);
+        put16(data, (uint16_t)r[i]);
+    }
+
+    Wav::Info info;
+    std::vector<int16_t> out;
+    CHECK(decodeFile(makeWav(Wav::WAV_FORMAT_PCM, 2, 16, 4, 0, data, false), info, out));
+    CHECK(out.size() == l.size());
+    bool exact = out.size() == l.size();
+    for (size_t i = 0; exact && i < out.size(); i++) {
+        exact = out[i] == (int16_t)(((int32_t)l[i] + r[i]) / 2);
+    }
+    CHECK(exact);
+}
+
+static void testPcm8() {
+    Bytes data;
+    for (int i = 0; i < 256; i++) data.push_back((uint8_t)i);
+
+    Wav::Info info;
+    std::vector<int16_t> out;
+    CHECK(decodeFile(makeWav(Wav::WAV_FORMAT_PCM, 1, 8, 1, 0, data, false), info, out));
+    CHECK(out.size() == 256);
+    CHECK(out.size() == 256 && out[0] == -32768 && out[128] == 0 && out[255] == 127 * 256);
+}
+
+static void testAdpcmMono() {
+    // 256-byte blocks hold 505 samples; 2000 samples leaves a short last block
+    std::vector<int16_t> src = tone(440, 2000, 12000);
+    std::vector<std::vector<int16_t>> recon;
+    Bytes data = encodeIma({src}, 256, recon);
+
+    Wav::Info info;
+    std::vector<int16_t> out;
+    CHECK(decodeFile(makeWav(Wav::WAV_FORMAT_IMA_ADPCM, 1, 4, 256, 505, data, true), info, out));
+    CHECK(info.samplesPerBlock == 505);
+    CHECK(out.size() >= src.size());
+    if (out.size() >= src.size()) {
+        out.resize(src.size());
+        CHECK(out == recon[0]);
+        double snr = snrDb(src, out);
+        printf("(%.1f dB) ", snr);
+        CHECK(snr >= MIN_ADPCM_SNR_DB);
+    }
+}
+
+static void testAdpcmStereo() {
+    std::vector<int16_t> l = tone(440, 1800, 12000);
+    std::vector<int16_t> r = tone(440, 1800, 12000, 0.3);
+    std::vector<std::vector<int16_t>> recon;
+    Bytes data = encodeIma({l, r}, 256, recon);
+
+    std::vector<int16_t> mix(l.size()), expect(l.size());
+    for (size_t i = 0; i < l.size(); i++) {
+        mix[i] = (int16_t)(((int32_t)l[i] + r[i]) / 2);
+        expect[i] = (int16_t)(((int32_t)recon[0][i] + recon[1][i]) / 2);
+    }
+
+    Wav::Info info;
+    std::vector<int16_t> out;
+    CHECK(decodeFile(makeWav(Wav::WAV_FORMAT_IMA_ADPCM, 2, 4, 256, 249, data, true), info, out));
+    CHECK(info.samplesPerBlock == 249);
+    CHECK(out.size() >= mix.size());
+    if (out.size() >= mix.size()) {
+        out.resize(mix.size());
+        CHECK(out == expect);
+        double snr = snrDb(mix, out);
+        printf("(%.1f dB) ", snr);
+        CHECK(snr >= MIN_ADPCM_SNR_DB);
+    }
+}
+
+static void testChunkSizes() {
+    Wav::Info info;
+    memset(&info, 0, sizeof(info));
+    info.format = Wav::WAV_FORMAT_PCM;
+    info.channels = 2;
+    info.bitsPerSample = 16;
+    info.blockAlign = 4;
+    Wav::Decoder dec;
+    dec.begin(info);
+    CHECK(dec.inputChunkSize() == Wav::WAV_PCM_CHUNK_BYTES);
+
+    info.format = Wav::WAV_FORMAT_IMA_ADPCM;
+    info.bitsPerSample = 4;
+    info.blockAlign = Wav::WAV_MAX_BLOCK_ALIGN;
+    dec.begin(info);
+    CHECK(dec.inputChunkSize() == Wav::WAV_MAX_BLOCK_ALIGN);
+
+    // A full mono block of the largest size fits the output bound exactly
+    info.channels = 1;
+    dec.begin(info);
+    std::vector<uint8_t> block(Wav::WAV_MAX_BLOCK_ALIGN, 0x11);
+    std::vector<int16_t> out(Wav::WAV_MAX_CHUNK_SAMPLES);
+    CHECK(dec.decode(block.data(), block.size(), out.data(), out.size()) == Wav::WAV_MAX_CHUNK_SAMPLES);
+    CHECK(dec.decode(block.data(), block.size(), out.data(), out.size() - 1) == 0);
+}
+
+static void testRejects() {
+    Bytes pcm(64, 0);
+    Wav::Info info;
+
+    Bytes bad = makeWav(Wav::WAV_FORMAT_PCM, 1, 16, 2, 0, pcm, false);
+    memcpy(bad.data(), "RIFX", 4);
+    MemReader r1(bad);
+    CHECK(!Wav::parseHeader(r1, info));
+
+    Bytes threeCh = makeWav(Wav::WAV_FORMAT_PCM, 3, 16, 6, 0, pcm, false);
+    MemReader r2(threeCh);
+    CHECK(!Wav::parseHeader(r2, info));
+
+    Bytes pcm24 = makeWav(Wav::WAV_FORMAT_PCM, 1, 24, 3, 0, pcm, false);
+    MemReader r3(pcm24);
+    CHECK(!Wav::parseHeader(r3, info));
+
+    Bytes bigBlock = makeWav(Wav::WAV_FORMAT_IMA_ADPCM, 1, 4, 4096, 8185, pcm, false);
+    MemReader r4(bigBlock);
+    CHECK(!Wav::parseHeader(r4, info));
+
+    Bytes mp3 = makeWav(0x0055, 1, 16, 2, 0, pcm, false);
+    MemReader r5(mp3);
+    CHECK(!Wav::parseHeader(r5, info));
+
+    // Truncated before the data chunk
+    Bytes cut = makeWav(Wav::WAV_FORMAT_PCM, 1, 16, 2, 0, pcm, false);
+    cut.resize(30);
+    MemReader r6(cut);
+    CHECK(!Wav::parseHeader(r6, info));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase TESTS[] = {
+    {"PCM16 mono",                  testPcm16Mono},
+    {"PCM16 stereo downmix",        testPcm16StereoDownmix},
+    {"PCM8",                        testPcm8},
+    {"IMA-ADPCM mono",              testAdpcmMono},
+    {"IMA-ADPCM stereo",            testAdpcmStereo},
+    {"Chunk sizes",                 testChunkSizes},
+    {"Rejected headers",            testRejects},
+};
+
+int main() {
+    for (const TestCase& t : TESTS) {
+        int before = s_failures;
+        printf("%-30s", t.name);
+        fflush(stdout);
+        t.fn();
+        if (s_failures == before) printf("ok\n");
+        else printf("%s FAILED\n", t.name);
+    }
+
+    if (s_failures) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("All tests passed\n");
+    return EXIT_SUCCESS;
+}